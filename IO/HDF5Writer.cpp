@@ -270,6 +270,378 @@ std::vector<IO::MeshDatabase> writeMeshesHDF5( const std::vector<IO::MeshDataStr
 }
 
 
+
+/****************************************************
+ * Collective writer (one shared file)               *
+ ****************************************************/
+// Block of a shared dataset written by this rank (dimensions are in the order used by Array)
+struct SharedBlock {
+    std::string name;           // Name of the dataset
+    IO::DataType precision;     // Precision of the dataset
+    std::vector<size_t> global; // Size of the shared dataset
+    std::vector<size_t> offset; // Offset of the local block
+    std::vector<size_t> count;  // Size of the local block (taken from the start of data)
+    std::vector<size_t> chunk;  // Chunk size (empty for contiguous storage)
+    Array<double> data;         // Local data
+    SharedBlock( const std::string &name_, IO::DataType precision_ )
+        : name( name_ ), precision( precision_ )
+    {
+    }
+};
+static hid_t getHDF5datatype( IO::DataType precision )
+{
+    if ( precision == IO::DataType::Double ) {
+        return IO::HDF5::getHDF5datatype<double>();
+    } else if ( precision == IO::DataType::Float ) {
+        return IO::HDF5::getHDF5datatype<float>();
+    } else if ( precision == IO::DataType::Int ) {
+        return IO::HDF5::getHDF5datatype<int>();
+    } else {
+        ERROR( "Unsupported format" );
+    }
+    return 0;
+}
+// HDF5 uses C ordered arrays so we need to flip the dimensions
+static std::vector<hsize_t> flip( const std::vector<size_t> &x )
+{
+    return std::vector<hsize_t>( x.rbegin(), x.rend() );
+}
+// Small arrays written by rank 0 only
+static SharedBlock rootBlock(
+    const std::string &name, IO::DataType precision, const std::vector<double> &x, int rank )
+{
+    SharedBlock block( name, precision );
+    block.global = { x.size() };
+    block.offset = { 0 };
+    block.count  = { rank == 0 ? x.size() : 0 };
+    block.data.resize( x.size() );
+    block.data.copy( x.data() );
+    return block;
+}
+// Offsets of each rank in a list that is concatenated across ranks
+static std::vector<double> getOffsets( size_t N, const Utilities::MPI &comm )
+{
+    auto count = comm.allGather( (double) N );
+    std::vector<double> offset( count.size() + 1, 0 );
+    for ( size_t i = 0; i < count.size(); i++ )
+        offset[i + 1] = offset[i] + count[i];
+    return offset;
+}
+// Get the variable data (vector data is permuted to match the xdmf ordering)
+static Array<double> getVariableData( const IO::Variable &var, int ndim )
+{
+    auto data = var.data;
+    if ( data.ndim() == ndim ) {
+        return data;
+    } else if ( data.ndim() == ndim + 1 && data.size( ndim ) == 3 ) {
+        std::vector<uint8_t> order( ndim + 1, 0 );
+        for ( int i = 0; i < ndim; i++ )
+            order[i + 1] = i;
+        order[0] = ndim;
+        return data.permute( order );
+    } else {
+        ERROR( "Unable to determine variable rank: " + to_string( var.data.size() ) );
+    }
+    return data;
+}
+// Add a variable on a list of points/elements that is concatenated across ranks
+static void addListVariable( const IO::Variable &var, const std::string &group,
+    const std::vector<double> &offset, const Utilities::MPI &comm, std::vector<SharedBlock> &blocks,
+    Xdmf::MeshData &domain, const std::string &path )
+{
+    int rank   = comm.getRank();
+    auto data  = getVariableData( var, 1 );
+    size_t N   = offset.back();
+    size_t off = offset[rank];
+    size_t n   = offset[rank + 1] - offset[rank];
+    SharedBlock block( group + "/" + var.name, var.precision );
+    if ( data.ndim() == 1 ) {
+        block.global = { N };
+        block.offset = { off };
+        block.count  = { n };
+    } else {
+        block.global = { 3, N };
+        block.offset = { 0, off };
+        block.count  = { 3, n };
+    }
+    block.data = std::move( data );
+    auto rankType = block.global.size() == 1 ? Xdmf::RankType::Scalar : Xdmf::RankType::Vector;
+    domain.addVariable( group, var.name, ArraySize( block.global ), rankType,
+        getXdmfType( var.type ), path + var.name );
+    blocks.push_back( std::move( block ) );
+}
+static void addCoordinates( const std::string &group, const std::vector<Point> &points,
+    IO::DataType precision, const std::vector<double> &offset, int rank,
+    std::vector<SharedBlock> &blocks )
+{
+    const char *name[3] = { "x", "y", "z" };
+    for ( int d = 0; d < 3; d++ ) {
+        SharedBlock block( group + "/" + name[d], precision );
+        block.global = { (size_t) offset.back() };
+        block.offset = { (size_t) offset[rank] };
+        block.count  = { points.size() };
+        block.data.resize( points.size() );
+        for ( size_t i = 0; i < points.size(); i++ )
+            block.data( i ) = d == 0 ? points[i].x : ( d == 1 ? points[i].y : points[i].z );
+        blocks.push_back( std::move( block ) );
+    }
+}
+// PointList: the points from each rank are concatenated
+static void sharedPointList( const std::string &filename, const IO::MeshDataStruct &meshData,
+    const Utilities::MPI &comm, std::vector<SharedBlock> &blocks, Xdmf &xmf )
+{
+    int rank         = comm.getRank();
+    auto group       = meshData.meshName;
+    auto path        = filename + ":/" + group + "/";
+    const auto &mesh = dynamic_cast<IO::PointList &>( *meshData.mesh );
+    auto offset      = getOffsets( mesh.points.size(), comm );
+    blocks.push_back( rootBlock( group + "/offsets", IO::DataType::Int, offset, rank ) );
+    addCoordinates( group, mesh.points, meshData.precision, offset, rank, blocks );
+    auto domain = Xdmf::createPointMesh(
+        group, 3, offset.back(), path + "x", path + "y", path + "z" );
+    for ( const auto &var : meshData.vars )
+        addListVariable( *var, group, offset, comm, blocks, domain, path );
+    if ( rank == 0 )
+        xmf.addMesh( meshData.meshName, domain );
+}
+// TriMesh/TriList: the points and triangles from each rank are concatenated
+static void sharedTriMesh( const std::string &filename, const IO::MeshDataStruct &meshData,
+    const IO::TriMesh &mesh, const Utilities::MPI &comm, std::vector<SharedBlock> &blocks,
+    Xdmf &xmf )
+{
+    int rank           = comm.getRank();
+    auto group         = meshData.meshName;
+    auto path          = filename + ":/" + group + "/";
+    const auto &points = mesh.vertices->getPoints();
+    auto offset        = getOffsets( points.size(), comm );
+    auto tri_offset    = getOffsets( mesh.A.size(), comm );
+    blocks.push_back( rootBlock( group + "/offsets", IO::DataType::Int, offset, rank ) );
+    blocks.push_back( rootBlock( group + "/tri_offsets", IO::DataType::Int, tri_offset, rank ) );
+    addCoordinates( group, points, meshData.precision, offset, rank, blocks );
+    // Write the connectivity with the global point indices
+    SharedBlock tri( group + "/tri", IO::DataType::Int );
+    tri.global = { 3, (size_t) tri_offset.back() };
+    tri.offset = { 0, (size_t) tri_offset[rank] };
+    tri.count  = { 3, mesh.A.size() };
+    tri.data.resize( 3, mesh.A.size() );
+    for ( size_t i = 0; i < mesh.A.size(); i++ ) {
+        tri.data( 0, i ) = mesh.A[i] + offset[rank];
+        tri.data( 1, i ) = mesh.B[i] + offset[rank];
+        tri.data( 2, i ) = mesh.C[i] + offset[rank];
+    }
+    blocks.push_back( std::move( tri ) );
+    auto domain = Xdmf::createUnstructuredMesh( group, 3, Xdmf::TopologyType::Triangle,
+        tri_offset.back(), path + "tri", offset.back(), path + "x", path + "y", path + "z" );
+    for ( const auto &var : meshData.vars ) {
+        if ( var->type == IO::VariableType::NodeVariable )
+            addListVariable( *var, group, offset, comm, blocks, domain, path );
+        else
+            addListVariable( *var, group, tri_offset, comm, blocks, domain, path );
+    }
+    if ( rank == 0 )
+        xmf.addMesh( meshData.meshName, domain );
+}
+// DomainMesh: each variable is stored as a single array over the global domain
+static void sharedDomainMesh( const std::string &filename, const IO::MeshDataStruct &meshData,
+    const Utilities::MPI &comm, bool chunk, std::vector<SharedBlock> &blocks, Xdmf &xmf )
+{
+    int rank   = comm.getRank();
+    auto &mesh = dynamic_cast<IO::DomainMesh &>( *meshData.mesh );
+    auto group = meshData.meshName;
+    auto path  = filename + ":/" + group + "/";
+    RankInfoStruct info( mesh.rank, mesh.nprocx, mesh.nprocy, mesh.nprocz );
+    std::vector<size_t> n     = { (size_t) mesh.nx, (size_t) mesh.ny, (size_t) mesh.nz };
+    std::vector<size_t> nproc = { (size_t) info.nx, (size_t) info.ny, (size_t) info.nz };
+    std::vector<size_t> iproc = { (size_t) info.ix, (size_t) info.jy, (size_t) info.kz };
+    std::vector<double> range = { 0, mesh.Lx, 0, mesh.Ly, 0, mesh.Lz };
+    blocks.push_back( rootBlock( group + "/range", IO::DataType::Double, range, rank ) );
+    blocks.push_back( rootBlock(
+        group + "/N", IO::DataType::Int, { (double) n[0], (double) n[1], (double) n[2] }, rank ) );
+    blocks.push_back( rootBlock( group + "/nproc", IO::DataType::Int,
+        { (double) nproc[0], (double) nproc[1], (double) nproc[2] }, rank ) );
+    auto domain = Xdmf::createUniformMesh(
+        group, range, ArraySize( n[0] * nproc[0], n[1] * nproc[1], n[2] * nproc[2] ) );
+    for ( const auto &var : meshData.vars ) {
+        SharedBlock block( group + "/" + var->name, var->precision );
+        block.data = getVariableData( *var, 3 );
+        if ( block.data.ndim() == 4 ) {
+            block.global = { 3 };
+            block.offset = { 0 };
+            block.count  = { 3 };
+            block.chunk  = { 3 };
+        }
+        // Nodes on a face shared by two sub-domains are written by the upper sub-domain
+        bool node = var->type == IO::VariableType::NodeVariable;
+        for ( int d = 0; d < 3; d++ ) {
+            bool last = iproc[d] == nproc[d] - 1;
+            block.global.push_back( n[d] * nproc[d] + ( node ? 1 : 0 ) );
+            block.offset.push_back( n[d] * iproc[d] );
+            block.count.push_back( n[d] + ( node && last ? 1 : 0 ) );
+            block.chunk.push_back( n[d] );
+        }
+        if ( !chunk )
+            block.chunk.clear();
+        auto rankType = block.data.ndim() == 3 ? Xdmf::RankType::Scalar : Xdmf::RankType::Vector;
+        domain.addVariable( group, var->name, ArraySize( block.global ), rankType,
+            getXdmfType( var->type ), path + var->name );
+        blocks.push_back( std::move( block ) );
+    }
+    if ( rank == 0 )
+        xmf.addMesh( meshData.meshName, domain );
+}
+// Create the datasets for the blocks (collective)
+static void createSharedDatasets(
+    hid_t fid, const std::vector<SharedBlock> &blocks, IO::HDF5::Compression compress )
+{
+    std::set<std::string> groups;
+    for ( const auto &block : blocks ) {
+        auto group = block.name.substr( 0, block.name.rfind( '/' ) );
+        if ( groups.insert( group ).second )
+            IO::HDF5::closeGroup( IO::HDF5::createGroup( fid, group ) );
+        auto dims       = flip( block.global );
+        hid_t dataspace = H5Screate_simple( dims.size(), dims.data(), nullptr );
+        hid_t datatype  = getHDF5datatype( block.precision );
+        hid_t plist     = H5Pcreate( H5P_DATASET_CREATE );
+        if ( !block.chunk.empty() ) {
+            auto chunk  = flip( block.chunk );
+            auto status = H5Pset_chunk( plist, chunk.size(), chunk.data() );
+            ASSERT( status == 0 );
+            if ( compress == IO::HDF5::Compression::GZIP ) {
+                status = H5Pset_deflate( plist, 7 );
+                ASSERT( status == 0 );
+            } else if ( compress == IO::HDF5::Compression::SZIP ) {
+                status = H5Pset_szip( plist, H5_SZIP_NN_OPTION_MASK, 16 );
+                ASSERT( status == 0 );
+            }
+        }
+        hid_t dataset = H5Dcreate2(
+            fid, block.name.data(), datatype, dataspace, H5P_DEFAULT, plist, H5P_DEFAULT );
+        H5Dclose( dataset );
+        H5Pclose( plist );
+        H5Tclose( datatype );
+        H5Sclose( dataspace );
+    }
+}
+// Write the local part of each block (collective if xfer is collective)
+template<class TYPE>
+static void writeSharedBlock( hid_t dataset, const SharedBlock &block, hid_t xfer )
+{
+    auto data       = block.data.cloneTo<TYPE>();
+    hid_t filespace = H5Dget_space( dataset );
+    std::vector<size_t> size( block.count.size() );
+    for ( size_t d = 0; d < size.size(); d++ )
+        size[d] = data.size( d );
+    auto local     = flip( size );
+    hid_t memspace = H5Screate_simple( local.size(), local.data(), nullptr );
+    auto start      = flip( block.offset );
+    auto count      = flip( block.count );
+    std::vector<hsize_t> zero( count.size(), 0 );
+    bool empty = false;
+    for ( auto c : count )
+        empty = empty || c == 0;
+    if ( empty ) {
+        H5Sselect_none( filespace );
+        H5Sselect_none( memspace );
+    } else {
+        H5Sselect_hyperslab(
+            filespace, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr );
+        H5Sselect_hyperslab( memspace, H5S_SELECT_SET, zero.data(), nullptr, count.data(), nullptr );
+    }
+    hid_t datatype  = IO::HDF5::getHDF5datatype<TYPE>();
+    const void *ptr = data.empty() ? ( (void *) 1 ) : data.data();
+    H5Dwrite( dataset, datatype, memspace, filespace, xfer, ptr );
+    H5Tclose( datatype );
+    H5Sclose( memspace );
+    H5Sclose( filespace );
+}
+static void writeSharedBlocks( hid_t fid, const std::vector<SharedBlock> &blocks, hid_t xfer )
+{
+    for ( const auto &block : blocks ) {
+        hid_t dataset = H5Dopen2( fid, block.name.data(), H5P_DEFAULT );
+        // Convert the data before writing (type conversion would disable collective I/O)
+        if ( block.precision == IO::DataType::Double )
+            writeSharedBlock<double>( dataset, block, xfer );
+        else if ( block.precision == IO::DataType::Float )
+            writeSharedBlock<float>( dataset, block, xfer );
+        else
+            writeSharedBlock<int>( dataset, block, xfer );
+        H5Dclose( dataset );
+    }
+}
+// Write the mesh data to a single hdf5 file shared by all ranks
+std::vector<IO::MeshDatabase> writeMeshesHDF5Collective(
+    const std::vector<IO::MeshDataStruct> &meshData, const std::string &path,
+    IO::FileFormat format, const Utilities::MPI &comm, bool chunk,
+    IO::HDF5::Compression compress, Xdmf &xmf )
+{
+    int rank = comm.getRank();
+    INSIST( comm.minReduce( (int) meshData.size() ) == comm.maxReduce( (int) meshData.size() ),
+        "All ranks must write the same meshes with hdf5-collective" );
+    std::string filename = "LBM.h5";
+    std::string fullpath = path + "/" + filename;
+    // Get the blocks written by this rank
+    std::vector<IO::MeshDatabase> meshes_written;
+    std::vector<SharedBlock> blocks;
+    if ( compress != IO::HDF5::Compression::None )
+        chunk = true;
+    for ( const auto &mesh : meshData ) {
+        auto database = getDatabase( filename, mesh, format, rank );
+        // The offset holds the rank (the index of the block in the shared arrays)
+        database.domains[0].offset = rank;
+        for ( auto &tmp : database.variable_data )
+            tmp.second.offset = rank;
+        if ( database.meshClass == "PointList" ) {
+            sharedPointList( filename, mesh, comm, blocks, xmf );
+        } else if ( database.meshClass == "TriMesh" ) {
+            const auto &trimesh = dynamic_cast<IO::TriMesh &>( *mesh.mesh );
+            sharedTriMesh( filename, mesh, trimesh, comm, blocks, xmf );
+        } else if ( database.meshClass == "TriList" ) {
+            auto trimesh = getTriMesh( mesh.mesh );
+            sharedTriMesh( filename, mesh, *trimesh, comm, blocks, xmf );
+        } else if ( database.meshClass == "DomainMesh" ) {
+            sharedDomainMesh( filename, mesh, comm, chunk, blocks, xmf );
+        } else {
+            ERROR( "Unknown mesh class" );
+        }
+        meshes_written.push_back( database );
+    }
+#ifdef H5_HAVE_PARALLEL
+    // Create the file and datasets collectively and write the blocks with MPI-IO
+    hid_t fapl = H5Pcreate( H5P_FILE_ACCESS );
+    H5Pset_fapl_mpio( fapl, comm.getCommunicator(), MPI_INFO_NULL );
+#if H5_VERSION_GE( 1, 10, 0 )
+    H5Pset_all_coll_metadata_ops( fapl, true );
+    H5Pset_coll_metadata_write( fapl, true );
+#endif
+    hid_t fid = H5Fcreate( fullpath.data(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl );
+    H5Pclose( fapl );
+    createSharedDatasets( fid, blocks, compress );
+    hid_t xfer = H5Pcreate( H5P_DATASET_XFER );
+    H5Pset_dxpl_mpio( xfer, H5FD_MPIO_COLLECTIVE );
+    writeSharedBlocks( fid, blocks, xfer );
+    H5Pclose( xfer );
+    IO::HDF5::closeHDF5( fid );
+#else
+    // Without parallel hdf5, rank 0 creates the datasets and the ranks take turns writing
+    if ( rank == 0 ) {
+        auto fid = IO::HDF5::openHDF5( fullpath, "w" );
+        createSharedDatasets( fid, blocks, compress );
+        IO::HDF5::closeHDF5( fid );
+    }
+    for ( int i = 0; i < comm.getSize(); i++ ) {
+        comm.barrier();
+        if ( i == rank ) {
+            auto fid = IO::HDF5::openHDF5( fullpath, "rw" );
+            writeSharedBlocks( fid, blocks, H5P_DEFAULT );
+            IO::HDF5::closeHDF5( fid );
+        }
+    }
+    comm.barrier();
+#endif
+    return meshes_written;
+}
+
+
 #else
 
 
@@ -278,6 +650,12 @@ std::vector<IO::MeshDatabase> writeMeshesHDF5(
 {
     return std::vector<IO::MeshDatabase>();
 }
+std::vector<IO::MeshDatabase> writeMeshesHDF5Collective( const std::vector<IO::MeshDataStruct> &,
+    const std::string &, IO::FileFormat, const Utilities::MPI &, bool, IO::HDF5::Compression,
+    Xdmf & )
+{
+    return std::vector<IO::MeshDatabase>();
+}
 
 
 #endif
@@ -514,6 +514,44 @@ void writeHDF5<Array<std::string>>(
 }
 
 
+/************************************************************************
+ * Read a block of an array                                              *
+ ************************************************************************/
+template<class T>
+void readHDF5Block( hid_t fid, const std::string &name, const std::vector<size_t> &offset,
+    const std::vector<size_t> &count, Array<T> &data )
+{
+    INSIST( H5Dexists( fid, name ), "Dataset " + name + " does not exist" );
+    ASSERT( offset.size() == count.size() );
+    hid_t dataset   = H5Dopen2( fid, name.data(), H5P_DEFAULT );
+    hid_t dataspace = H5Dget_space( dataset );
+    int ndim        = H5Sget_simple_extent_ndims( dataspace );
+    INSIST( ndim == (int) count.size(), "Block does not match the dimensions of " + name );
+    // HDF5 uses C ordered arrays so we need to flip the dimensions
+    std::vector<hsize_t> start( ndim ), size( ndim );
+    for ( int i = 0; i < ndim; i++ ) {
+        start[ndim - i - 1] = offset[i];
+        size[ndim - i - 1]  = count[i];
+    }
+    data.resize( count );
+    if ( !data.empty() ) {
+        H5Sselect_hyperslab(
+            dataspace, H5S_SELECT_SET, start.data(), nullptr, size.data(), nullptr );
+        hid_t memspace = H5Screate_simple( ndim, size.data(), nullptr );
+        hid_t datatype = getHDF5datatype<T>();
+        H5Dread( dataset, datatype, memspace, dataspace, H5P_DEFAULT, data.data() );
+        H5Tclose( datatype );
+        H5Sclose( memspace );
+    }
+    H5Sclose( dataspace );
+    H5Dclose( dataset );
+}
+template void readHDF5Block<int>(
+    hid_t, const std::string &, const std::vector<size_t> &, const std::vector<size_t> &, Array<int> & );
+template void readHDF5Block<double>( hid_t, const std::string &, const std::vector<size_t> &,
+    const std::vector<size_t> &, Array<double> & );
+
+
 /************************************************************************
  * Specializations for std::vector                                       *
  ************************************************************************/
@@ -6,6 +6,7 @@
 
 #include <cstring>
 #include <string>
+#include <vector>
 
 
 // Include the headers and define some basic types
@@ -98,6 +99,22 @@ template<class T>
 void readHDF5( hid_t fid, const std::string &name, T &data );
 
 
+/**
+ * \brief Read part of an array from HDF5
+ * \details This function reads a block (hyperslab) of a dataset into an Array.
+ *    The offset and count are given in the (column-major) order used by Array,
+ *    and the data is converted to the type of the Array if needed.
+ * @param[in] fid       File or group to read from
+ * @param[in] name      The name of the variable
+ * @param[in] offset    The offset of the block in each dimension
+ * @param[in] count     The size of the block in each dimension
+ * @param[out] data     The block that was read
+ */
+template<class T>
+void readHDF5Block( hid_t fid, const std::string &name, const std::vector<size_t> &offset,
+    const std::vector<size_t> &count, Array<T> &data );
+
+
 /**
  * \brief Check if group exists
  * \details This function checks if an HDF5 group exists in the file
@@ -157,6 +174,7 @@ template<class T> void readHDF5( hid_t, const std::string&, T& ) {}
 template<class T> void writeHDF5( hid_t, const std::string&, const T& ) {}
 template<class T> void readHDF5Array( hid_t, const std::string&, Array<T>& ) {}
 template<class T> void writeHDF5Array( hid_t, const std::string&, const Array<T>& ) {}
+template<class T> void readHDF5Block( hid_t, const std::string&, const std::vector<size_t>&, const std::vector<size_t>&, Array<T>& ) {}
 template<class T> hid_t getHDF5datatype() { return 0; }
 #endif
 // clang-format on
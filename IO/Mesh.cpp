@@ -628,6 +628,8 @@ std::string getString( FileFormat type )
         return "silo";
     else if ( type == FileFormat::HDF5 )
         return "hdf5";
+    else if ( type == FileFormat::HDF5_COLLECTIVE )
+        return "hdf5-collective";
     else
         ERROR( "Invalid type" );
     return "";
@@ -645,6 +647,8 @@ FileFormat getFileFormat( const std::string &type_in )
         return FileFormat::SILO;
     else if ( type == "hdf5" || type == "5" )
         return FileFormat::HDF5;
+    else if ( type == "hdf5-collective" || type == "6" )
+        return FileFormat::HDF5_COLLECTIVE;
     else
         ERROR( "Invalid type: " + type );
     return FileFormat::SILO;
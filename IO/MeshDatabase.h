@@ -64,7 +64,7 @@ struct MeshDatabase {
     std::string name;                   //!< Name of the mesh
     MeshType type;                      //!< Mesh type
     std::string meshClass;              //!< Mesh class
-    FileFormat format;                  //!< Data format (1: old, 2: new, 3: new (single), 4: silo)
+    FileFormat format;                  //!< Data format (1: old, 2: new, 3: new (single), 4: silo, 5: hdf5, 6: hdf5 (collective))
     std::vector<DatabaseEntry> domains; //!< List of the domains
     std::vector<VariableDatabase> variables;            //!< List of the variables
     std::map<variable_id, DatabaseEntry> variable_data; //!< Data for the variables
@@ -74,7 +74,7 @@ std::vector<std::string> IO::readTimesteps( const std::string &path, const std::
         filename += "summary.LBM";
     } else if ( format == "silo" ) {
         filename += "LBM.visit";
-    } else if ( format == "hdf5" ) {
+    } else if ( format == "hdf5" || format == "hdf5-collective" ) {
         filename += "LBM.visit";
     } else if ( format == "auto" ) {
         bool test_old = fileExists( path + "/summary.LBM" );
@@ -372,6 +372,67 @@ std::shared_ptr<IO::Mesh> IO::getMesh( const std::string &path, const std::strin
         IO::HDF5::closeHDF5( fid );
 #else
         ERROR( "Build without hdf5 support" );
+#endif
+    } else if ( meshDatabase.format == FileFormat::HDF5_COLLECTIVE ) {
+        // Reading the block for the domain from an hdf5 file shared by all ranks
+#ifdef USE_HDF5
+        auto &database = meshDatabase.domains[domain];
+        auto filename  = path + "/" + timestep + "/" + database.file;
+        size_t rank    = database.offset;
+        auto fid       = IO::HDF5::openHDF5( filename, "r" );
+        auto gid       = IO::HDF5::openGroup( fid, meshDatabase.name );
+        if ( meshDatabase.meshClass == "PointList" || meshDatabase.meshClass == "TriMesh" ||
+             meshDatabase.meshClass == "TriList" ) {
+            // Read the points
+            std::vector<size_t> offset;
+            IO::HDF5::readHDF5( gid, "offsets", offset );
+            size_t N_point = offset[rank + 1] - offset[rank];
+            Array<double> x, y, z;
+            IO::HDF5::readHDF5Block( gid, "x", { offset[rank] }, { N_point }, x );
+            IO::HDF5::readHDF5Block( gid, "y", { offset[rank] }, { N_point }, y );
+            IO::HDF5::readHDF5Block( gid, "z", { offset[rank] }, { N_point }, z );
+            auto points = std::make_shared<IO::PointList>( N_point );
+            for ( size_t i = 0; i < N_point; i++ ) {
+                points->points[i].x = x( i );
+                points->points[i].y = y( i );
+                points->points[i].z = z( i );
+            }
+            if ( meshDatabase.meshClass == "PointList" ) {
+                mesh = points;
+            } else {
+                // Read the triangles (stored with the global point indices)
+                std::vector<size_t> tri_offset;
+                IO::HDF5::readHDF5( gid, "tri_offsets", tri_offset );
+                size_t N_tri = tri_offset[rank + 1] - tri_offset[rank];
+                Array<int> tri;
+                IO::HDF5::readHDF5Block( gid, "tri", { 0, tri_offset[rank] }, { 3, N_tri }, tri );
+                auto mesh2 = std::make_shared<IO::TriMesh>( N_tri, points );
+                for ( size_t i = 0; i < N_tri; i++ ) {
+                    mesh2->A[i] = tri( 0, i ) - offset[rank];
+                    mesh2->B[i] = tri( 1, i ) - offset[rank];
+                    mesh2->C[i] = tri( 2, i ) - offset[rank];
+                }
+                if ( meshDatabase.meshClass == "TriMesh" )
+                    mesh = mesh2;
+                else
+                    mesh = IO::getTriList( std::dynamic_pointer_cast<IO::Mesh>( mesh2 ) );
+            }
+        } else if ( meshDatabase.meshClass == "DomainMesh" ) {
+            std::vector<double> range;
+            std::vector<int> N, nproc;
+            IO::HDF5::readHDF5( gid, "range", range );
+            IO::HDF5::readHDF5( gid, "N", N );
+            IO::HDF5::readHDF5( gid, "nproc", nproc );
+            RankInfoStruct rank_data( rank, nproc[0], nproc[1], nproc[2] );
+            mesh = std::make_shared<IO::DomainMesh>( rank_data, N[0], N[1], N[2],
+                range[1] - range[0], range[3] - range[2], range[5] - range[4] );
+        } else {
+            ERROR( "Unknown mesh class" );
+        }
+        IO::HDF5::closeGroup( gid );
+        IO::HDF5::closeHDF5( fid );
+#else
+        ERROR( "Build without hdf5 support" );
 #endif
     } else {
         ERROR( "Unknown format" );
@@ -462,6 +523,55 @@ std::shared_ptr<IO::Variable> IO::getVariable( const std::string &path, const st
         }
 #else
         ERROR( "Build without silo support" );
+#endif
+    } else if ( meshDatabase.format == FileFormat::HDF5_COLLECTIVE ) {
+        // Reading the block for the domain from an hdf5 file shared by all ranks
+#ifdef USE_HDF5
+        auto &database   = meshDatabase.domains[domain];
+        auto varDatabase = meshDatabase.getVariableDatabase( variable );
+        auto filename    = path + "/" + timestep + "/" + database.file;
+        size_t rank      = database.offset;
+        var      = std::make_shared<Variable>( varDatabase.dim, varDatabase.type, variable );
+        auto fid = IO::HDF5::openHDF5( filename, "r" );
+        auto gid = IO::HDF5::openGroup( fid, meshDatabase.name );
+        std::vector<size_t> offset, count;
+        if ( varDatabase.dim != 1 ) {
+            offset.push_back( 0 );
+            count.push_back( varDatabase.dim );
+        }
+        if ( meshDatabase.meshClass == "PointList" || meshDatabase.meshClass == "TriMesh" ||
+             meshDatabase.meshClass == "TriList" ) {
+            std::vector<size_t> list;
+            if ( varDatabase.type == VariableType::NodeVariable )
+                IO::HDF5::readHDF5( gid, "offsets", list );
+            else
+                IO::HDF5::readHDF5( gid, "tri_offsets", list );
+            offset.push_back( list[rank] );
+            count.push_back( list[rank + 1] - list[rank] );
+            IO::HDF5::readHDF5Block( gid, var->name, offset, count, var->data );
+            if ( var->data.ndim() == 2 && var->data.size( 0 ) == 3 )
+                var->data = var->data.permute( { 1, 0 } );
+        } else if ( meshDatabase.meshClass == "DomainMesh" ) {
+            std::vector<int> N, nproc;
+            IO::HDF5::readHDF5( gid, "N", N );
+            IO::HDF5::readHDF5( gid, "nproc", nproc );
+            RankInfoStruct info( rank, nproc[0], nproc[1], nproc[2] );
+            int iproc[3] = { info.ix, info.jy, info.kz };
+            int node     = varDatabase.type == VariableType::NodeVariable ? 1 : 0;
+            for ( int d = 0; d < 3; d++ ) {
+                offset.push_back( iproc[d] * N[d] );
+                count.push_back( N[d] + node );
+            }
+            IO::HDF5::readHDF5Block( gid, var->name, offset, count, var->data );
+            if ( var->data.ndim() == 4 && var->data.size( 0 ) == 3 )
+                var->data = var->data.permute( { 1, 2, 3, 0 } );
+        } else {
+            ERROR( "Unknown mesh class" );
+        }
+        IO::HDF5::closeGroup( gid );
+        IO::HDF5::closeHDF5( fid );
+#else
+        ERROR( "Build without hdf5 support" );
 #endif
     } else {
         ERROR( "Unknown format" );
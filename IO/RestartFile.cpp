@@ -0,0 +1,568 @@
+#include "IO/RestartFile.h"
+#include "common/Utilities.h"
+
+#include "ProfilerApp.h"
+#include "zlib.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+namespace IO {
+
+
+// Identifier at the start of each file
+static const char restart_magic[8] = { 'L', 'B', 'P', 'M', '-', 'R', 'S', 'T' };
+static const int32_t restart_version = 1;
+
+// Maximum number of values to send in a single message
+static const size_t max_message = 1 << 26;
+
+
+/****************************************************
+ * Helper functions                                  *
+ ****************************************************/
+static std::string restartFilename( const std::string &prefix, int file )
+{
+    char tmp[20];
+    sprintf( tmp, ".agg.%05d", file );
+    return prefix + tmp;
+}
+static inline int restartFile( int rank, int nprocs, int nfiles )
+{
+    return static_cast<int>( static_cast<int64_t>( rank ) * nfiles / nprocs );
+}
+static void sendValues(
+    const double *x, size_t N, int dest, int tag, const Utilities::MPI &comm )
+{
+    for ( size_t i = 0; i < N; i += max_message )
+        comm.send( &x[i], static_cast<int>( std::min( max_message, N - i ) ), dest, tag );
+}
+static void recvValues( double *x, size_t N, int src, int tag, const Utilities::MPI &comm )
+{
+    for ( size_t i = 0; i < N; i += max_message )
+        comm.recv( &x[i], static_cast<int>( std::min( max_message, N - i ) ), src, tag );
+}
+template<class TYPE>
+static void writeValue( FILE *fid, const TYPE &x )
+{
+    size_t N = fwrite( &x, sizeof( TYPE ), 1, fid );
+    INSIST( N == 1, "Error writing restart file" );
+}
+template<class TYPE>
+static void readValue( FILE *fid, TYPE &x )
+{
+    size_t N = fread( &x, sizeof( TYPE ), 1, fid );
+    INSIST( N == 1, "Error reading restart file" );
+}
+static size_t headerSize( int nfields, int nranks )
+{
+    return sizeof( restart_magic ) + 6 * sizeof( int32_t ) + nfields * sizeof( int32_t ) +
+           nranks * sizeof( RestartIndex );
+}
+
+
+/****************************************************
+ * Hash the local layout (FNV-1a)                    *
+ ****************************************************/
+uint64_t layoutHash( const int *map, size_t N )
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    auto add      = [&hash]( uint64_t x ) {
+        for ( int i = 0; i < 8; i++ ) {
+            hash ^= ( x >> ( 8 * i ) ) & 0xFF;
+            hash *= 0x100000001b3;
+        }
+    };
+    add( N );
+    for ( size_t i = 0; i < N; i++ )
+        add( static_cast<uint32_t>( map[i] ) );
+    return hash;
+}
+
+
+/****************************************************
+ * Write the restart file                            *
+ ****************************************************/
+void writeRestart( const std::string &prefix, size_t Np, uint64_t hash,
+    const std::vector<const double *> &fields, const std::vector<int> &components, int nfiles,
+    const Utilities::MPI &comm )
+{
+    PROFILE_START( "writeRestart" );
+    ASSERT( fields.size() == components.size() );
+    int rank   = comm.getRank();
+    int nprocs = comm.getSize();
+    nfiles     = std::max( 1, std::min( nfiles, nprocs ) );
+    int file   = restartFile( rank, nprocs, nfiles );
+    auto group = comm.split( file, rank );
+    // Gather the index for the group
+    RestartIndex local;
+    local.rank   = rank;
+    local.offset = 0;
+    local.Np     = Np;
+    local.hash   = hash;
+    auto index   = group.allGather( local );
+    int Nc       = 0;
+    for ( auto c : components )
+        Nc += c;
+    if ( group.getRank() != 0 ) {
+        // Send the data to the writer
+        for ( size_t i = 0; i < fields.size(); i++ )
+            sendValues( fields[i], components[i] * Np, 0, i, group );
+    } else {
+        // Compute the offsets
+        uint64_t offset = headerSize( fields.size(), index.size() );
+        for ( auto &entry : index ) {
+            entry.offset = offset;
+            offset += Nc * entry.Np * sizeof( double );
+        }
+        // Write the header and index
+        auto filename = restartFilename( prefix, file );
+        FILE *fid     = fopen( filename.c_str(), "wb" );
+        INSIST( fid, "Unable to open " + filename );
+        size_t N = fwrite( restart_magic, 1, sizeof( restart_magic ), fid );
+        INSIST( N == sizeof( restart_magic ), "Error writing " + filename );
+        writeValue<int32_t>( fid, restart_version );
+        writeValue<int32_t>( fid, nprocs );
+        writeValue<int32_t>( fid, nfiles );
+        writeValue<int32_t>( fid, file );
+        writeValue<int32_t>( fid, index.size() );
+        writeValue<int32_t>( fid, fields.size() );
+        for ( auto c : components )
+            writeValue<int32_t>( fid, c );
+        for ( auto &entry : index )
+            writeValue( fid, entry );
+        // Write the local data
+        for ( size_t i = 0; i < fields.size(); i++ ) {
+            N = fwrite( fields[i], sizeof( double ), components[i] * Np, fid );
+            INSIST( N == components[i] * Np, "Error writing " + filename );
+        }
+        // Recieve and write the data for the other ranks in the group
+        std::vector<double> buffer;
+        for ( size_t p = 1; p < index.size(); p++ ) {
+            buffer.resize( Nc * index[p].Np );
+            double *ptr = buffer.data();
+            for ( size_t i = 0; i < fields.size(); i++ ) {
+                recvValues( ptr, components[i] * index[p].Np, p, i, group );
+                ptr += components[i] * index[p].Np;
+            }
+            N = fwrite( buffer.data(), sizeof( double ), buffer.size(), fid );
+            INSIST( N == buffer.size(), "Error writing " + filename );
+        }
+        fclose( fid );
+    }
+    PROFILE_STOP( "writeRestart" );
+}
+
+
+/****************************************************
+ * Read the restart file                             *
+ ****************************************************/
+static RestartInfo readRestartInfo( FILE *fid, const std::string &filename )
+{
+    char magic[sizeof( restart_magic )];
+    size_t N = fread( magic, 1, sizeof( magic ), fid );
+    if ( N != sizeof( magic ) || memcmp( magic, restart_magic, sizeof( magic ) ) != 0 )
+        ERROR( filename + " is not an aggregated restart file" );
+    int32_t version, nprocs, nfiles, file, nranks, nfields;
+    readValue( fid, version );
+    INSIST( version == restart_version, "Unknown version of " + filename );
+    readValue( fid, nprocs );
+    readValue( fid, nfiles );
+    readValue( fid, file );
+    readValue( fid, nranks );
+    readValue( fid, nfields );
+    RestartInfo info;
+    info.nprocs = nprocs;
+    info.nfiles = nfiles;
+    info.file   = file;
+    info.components.resize( nfields );
+    for ( auto &c : info.components ) {
+        int32_t tmp;
+        readValue( fid, tmp );
+        c = tmp;
+    }
+    info.index.resize( nranks );
+    for ( auto &entry : info.index )
+        readValue( fid, entry );
+    return info;
+}
+RestartInfo readRestartInfo( const std::string &prefix, int file )
+{
+    auto filename = restartFilename( prefix, file );
+    FILE *fid     = fopen( filename.c_str(), "rb" );
+    INSIST( fid, "Unable to open " + filename );
+    auto info = readRestartInfo( fid, filename );
+    fclose( fid );
+    return info;
+}
+void readRestart( const std::string &prefix, int rank, size_t Np, uint64_t hash,
+    const std::vector<double *> &fields, const std::vector<int> &components )
+{
+    PROFILE_START( "readRestart" );
+    ASSERT( fields.size() == components.size() );
+    // Find the file that contains the rank
+    auto info = readRestartInfo( prefix, 0 );
+    if ( rank < 0 || rank >= info.nprocs )
+        ERROR( "Rank " + std::to_string( rank ) + " was not written to the restart file" );
+    int file = restartFile( rank, info.nprocs, info.nfiles );
+    if ( file != 0 )
+        info = readRestartInfo( prefix, file );
+    auto filename = restartFilename( prefix, file );
+    if ( info.components != components )
+        ERROR( "The fields in " + filename + " do not match" );
+    auto it = std::find_if( info.index.begin(), info.index.end(),
+        [rank]( const RestartIndex &entry ) { return entry.rank == rank; } );
+    INSIST( it != info.index.end(), "Rank not found in " + filename );
+    if ( it->Np != Np )
+        ERROR( "The number of sites in " + filename + " does not match" );
+    if ( it->hash != hash )
+        ERROR( "The layout in " + filename + " does not match" );
+    // Read the data
+    FILE *fid = fopen( filename.c_str(), "rb" );
+    INSIST( fid, "Unable to open " + filename );
+    fseeko( fid, it->offset, SEEK_SET );
+    for ( size_t i = 0; i < fields.size(); i++ ) {
+        size_t N = fread( fields[i], sizeof( double ), components[i] * Np, fid );
+        INSIST( N == components[i] * Np, "Error reading " + filename );
+    }
+    fclose( fid );
+    PROFILE_STOP( "readRestart" );
+}
+
+
+/****************************************************
+ * Compressed restart files                          *
+ ****************************************************/
+static const char compressed_magic[8] = { 'L', 'B', 'P', 'M', '-', 'C', 'R', 'S' };
+static inline void appendBytes( std::vector<char> &out, const void *data, size_t bytes )
+{
+    auto ptr = reinterpret_cast<const char *>( data );
+    out.insert( out.end(), ptr, ptr + bytes );
+}
+static size_t deflateBytes( const char *in, size_t N, int level, char *out, size_t N_out )
+{
+    uLongf bytes = N_out;
+    int err      = compress2( reinterpret_cast<Bytef *>( out ), &bytes,
+        reinterpret_cast<const Bytef *>( in ), N, level );
+    INSIST( err == Z_OK, "Error compressing restart data" );
+    return bytes;
+}
+std::vector<char> compressValues( const double *x, size_t N, int level )
+{
+    // Predict each value from the previous one (xor) and shuffle the bytes
+    const size_t size = sizeof( double );
+    std::vector<char> tmp( N * size );
+    uint64_t last = 0;
+    for ( size_t i = 0; i < N; i++ ) {
+        uint64_t value;
+        memcpy( &value, &x[i], size );
+        uint64_t delta = value ^ last;
+        last           = value;
+        for ( size_t b = 0; b < size; b++ )
+            tmp[b * N + i] = ( delta >> ( 8 * b ) ) & 0xFF;
+    }
+    // Compress each byte plane, storing the planes that do not compress (the
+    //    low mantissa bytes) without compression.  Compressing a sample of the
+    //    plane first avoids spending time on the planes that will not compress.
+    std::vector<char> out, buffer( compressBound( N ) );
+    const size_t sample = std::min<size_t>( N, 16384 );
+    for ( size_t b = 0; b < size; b++ ) {
+        const char *plane = &tmp[b * N];
+        uint64_t bytes    = 0;
+        if ( deflateBytes( plane, sample, level, buffer.data(), buffer.size() ) < 0.9 * sample )
+            bytes = deflateBytes( plane, N, level, buffer.data(), buffer.size() );
+        uint8_t compressed = bytes > 0 && bytes < N;
+        if ( !compressed )
+            bytes = N;
+        appendBytes( out, &compressed, sizeof( compressed ) );
+        appendBytes( out, &bytes, sizeof( bytes ) );
+        appendBytes( out, compressed ? buffer.data() : plane, bytes );
+    }
+    return out;
+}
+void decompressValues( const char *data, size_t bytes, double *x, size_t N )
+{
+    // Decompress each byte plane
+    const size_t size = sizeof( double );
+    std::vector<char> tmp( N * size );
+    size_t pos = 0;
+    for ( size_t b = 0; b < size; b++ ) {
+        uint8_t compressed;
+        uint64_t bytes2;
+        INSIST( pos + sizeof( compressed ) + sizeof( bytes2 ) <= bytes,
+            "Error decompressing restart data" );
+        memcpy( &compressed, &data[pos], sizeof( compressed ) );
+        memcpy( &bytes2, &data[pos + sizeof( compressed )], sizeof( bytes2 ) );
+        pos += sizeof( compressed ) + sizeof( bytes2 );
+        INSIST( pos + bytes2 <= bytes, "Error decompressing restart data" );
+        if ( compressed ) {
+            uLongf N2 = N;
+            int err   = uncompress( reinterpret_cast<Bytef *>( &tmp[b * N] ), &N2,
+                reinterpret_cast<const Bytef *>( &data[pos] ), bytes2 );
+            INSIST( err == Z_OK && N2 == N, "Error decompressing restart data" );
+        } else {
+            INSIST( bytes2 == N, "Error decompressing restart data" );
+            memcpy( &tmp[b * N], &data[pos], N );
+        }
+        pos += bytes2;
+    }
+    // Unshuffle the bytes and undo the prediction
+    uint64_t last = 0;
+    for ( size_t i = 0; i < N; i++ ) {
+        uint64_t delta = 0;
+        for ( size_t b = 0; b < size; b++ )
+            delta |= static_cast<uint64_t>( static_cast<uint8_t>( tmp[b * N + i] ) ) << ( 8 * b );
+        last ^= delta;
+        memcpy( &x[i], &last, size );
+    }
+}
+void writeCompressedRestart( const std::string &filename, size_t Np,
+    const std::vector<int> &components, const std::vector<std::vector<char>> &blocks )
+{
+    PROFILE_START( "writeCompressedRestart" );
+    int Nc = 0;
+    for ( auto c : components )
+        Nc += c;
+    ASSERT( (int) blocks.size() == Nc );
+    FILE *fid = fopen( filename.c_str(), "wb" );
+    INSIST( fid, "Unable to open " + filename );
+    size_t N = fwrite( compressed_magic, 1, sizeof( compressed_magic ), fid );
+    INSIST( N == sizeof( compressed_magic ), "Error writing " + filename );
+    writeValue<int32_t>( fid, restart_version );
+    writeValue<uint64_t>( fid, Np );
+    writeValue<int32_t>( fid, components.size() );
+    for ( auto c : components )
+        writeValue<int32_t>( fid, c );
+    for ( auto &block : blocks ) {
+        writeValue<uint64_t>( fid, block.size() );
+        N = fwrite( block.data(), 1, block.size(), fid );
+        INSIST( N == block.size(), "Error writing " + filename );
+    }
+    fclose( fid );
+    PROFILE_STOP( "writeCompressedRestart" );
+}
+bool isCompressedRestart( const std::string &filename )
+{
+    FILE *fid = fopen( filename.c_str(), "rb" );
+    if ( !fid )
+        return false;
+    char magic[sizeof( compressed_magic )];
+    size_t N = fread( magic, 1, sizeof( magic ), fid );
+    fclose( fid );
+    return N == sizeof( magic ) && memcmp( magic, compressed_magic, sizeof( magic ) ) == 0;
+}
+void readCompressedRestart( const std::string &filename, size_t Np,
+    const std::vector<double *> &fields, const std::vector<int> &components )
+{
+    PROFILE_START( "readCompressedRestart" );
+    ASSERT( fields.size() == components.size() );
+    FILE *fid = fopen( filename.c_str(), "rb" );
+    INSIST( fid, "Unable to open " + filename );
+    char magic[sizeof( compressed_magic )];
+    size_t N = fread( magic, 1, sizeof( magic ), fid );
+    if ( N != sizeof( magic ) || memcmp( magic, compressed_magic, sizeof( magic ) ) != 0 )
+        ERROR( filename + " is not a compressed restart file" );
+    int32_t version, nfields;
+    uint64_t Np2;
+    readValue( fid, version );
+    INSIST( version == restart_version, "Unknown version of " + filename );
+    readValue( fid, Np2 );
+    if ( Np2 != Np )
+        ERROR( "The number of sites in " + filename + " does not match" );
+    readValue( fid, nfields );
+    std::vector<int> components2( nfields );
+    for ( auto &c : components2 ) {
+        int32_t tmp;
+        readValue( fid, tmp );
+        c = tmp;
+    }
+    if ( components2 != components )
+        ERROR( "The fields in " + filename + " do not match" );
+    std::vector<char> block;
+    for ( size_t f = 0; f < fields.size(); f++ ) {
+        for ( int q = 0; q < components[f]; q++ ) {
+            uint64_t bytes;
+            readValue( fid, bytes );
+            block.resize( bytes );
+            N = fread( block.data(), 1, bytes, fid );
+            INSIST( N == bytes, "Error reading " + filename );
+            decompressValues( block.data(), bytes, &fields[f][q * Np], Np );
+        }
+    }
+    fclose( fid );
+    PROFILE_STOP( "readCompressedRestart" );
+}
+
+
+/****************************************************
+ * Decomposition independent restart files           *
+ ****************************************************/
+static const char global_magic[8] = { 'L', 'B', 'P', 'M', '-', 'G', 'R', 'S' };
+static size_t globalHeaderSize( int nfields )
+{
+    return sizeof( global_magic ) + 5 * sizeof( int32_t ) + nfields * sizeof( int32_t );
+}
+// Offset of the first value of row (j,k) of the local block for the global component c
+static inline int64_t globalOffset( size_t header, const int64_t N[3], const int n[3],
+    const RankInfoStruct &info, int64_t c, int j, int k )
+{
+    int64_t x = static_cast<int64_t>( info.ix ) * n[0];
+    int64_t y = static_cast<int64_t>( info.jy ) * n[1] + j - 1;
+    int64_t z = static_cast<int64_t>( info.kz ) * n[2] + k - 1;
+    return header + sizeof( double ) * ( ( ( c * N[2] + z ) * N[1] + y ) * N[0] + x );
+}
+void writeGlobalRestart( const std::string &filename, const IntArray &map,
+    const RankInfoStruct &info, size_t Np, const std::vector<const double *> &fields,
+    const std::vector<int> &components, const Utilities::MPI &comm )
+{
+    PROFILE_START( "writeGlobalRestart" );
+    ASSERT( fields.size() == components.size() );
+    int n[3]      = { (int) map.size( 0 ) - 2, (int) map.size( 1 ) - 2, (int) map.size( 2 ) - 2 };
+    int64_t N[3]  = { (int64_t) n[0] * info.nx, (int64_t) n[1] * info.ny, (int64_t) n[2] * info.nz };
+    size_t header = globalHeaderSize( fields.size() );
+    // Write the header
+    if ( comm.getRank() == 0 ) {
+        FILE *fid = fopen( filename.c_str(), "wb" );
+        INSIST( fid, "Unable to open " + filename );
+        size_t count = fwrite( global_magic, 1, sizeof( global_magic ), fid );
+        INSIST( count == sizeof( global_magic ), "Error writing " + filename );
+        writeValue<int32_t>( fid, restart_version );
+        for ( int d = 0; d < 3; d++ )
+            writeValue<int32_t>( fid, N[d] );
+        writeValue<int32_t>( fid, fields.size() );
+        for ( auto c : components )
+            writeValue<int32_t>( fid, c );
+        fclose( fid );
+    }
+    comm.barrier();
+#ifdef USE_MPI
+    // Write the local block of each component collectively through a subarray view
+    int gsize[3] = { (int) N[2], (int) N[1], (int) N[0] };
+    int lsize[3] = { n[2], n[1], n[0] };
+    int start[3] = { info.kz * n[2], info.jy * n[1], info.ix * n[0] };
+    MPI_Datatype filetype;
+    MPI_Type_create_subarray( 3, gsize, lsize, start, MPI_ORDER_C, MPI_DOUBLE, &filetype );
+    MPI_Type_commit( &filetype );
+    MPI_File fh;
+    int err = MPI_File_open( comm.getCommunicator(), filename.c_str(), MPI_MODE_WRONLY,
+        MPI_INFO_NULL, &fh );
+    INSIST( err == MPI_SUCCESS, "Unable to open " + filename );
+    int count = n[0] * n[1] * n[2];
+    std::vector<double> buffer( count );
+    int64_t c = 0;
+    for ( size_t f = 0; f < fields.size(); f++ ) {
+        for ( int q = 0; q < components[f]; q++, c++ ) {
+            const double *data = &fields[f][q * Np];
+            for ( int k = 1; k <= n[2]; k++ ) {
+                for ( int j = 1; j <= n[1]; j++ ) {
+                    for ( int i = 1; i <= n[0]; i++ ) {
+                        int idx = map( i, j, k );
+                        buffer[( ( k - 1 ) * n[1] + j - 1 ) * n[0] + i - 1] =
+                            idx < 0 ? 0.0 : data[idx];
+                    }
+                }
+            }
+            MPI_Offset disp = header + sizeof( double ) * c * N[0] * N[1] * N[2];
+            MPI_File_set_view( fh, disp, MPI_DOUBLE, filetype, "native", MPI_INFO_NULL );
+            MPI_Status status;
+            err = MPI_File_write_at_all( fh, 0, buffer.data(), count, MPI_DOUBLE, &status );
+            INSIST( err == MPI_SUCCESS, "Error writing " + filename );
+        }
+    }
+    MPI_File_close( &fh );
+    MPI_Type_free( &filetype );
+#else
+    // Write the local block (rows are contiguous across y if there is one rank in x)
+    FILE *fid = fopen( filename.c_str(), "r+b" );
+    INSIST( fid, "Unable to open " + filename );
+    int rows = info.nx == 1 ? n[1] : 1;
+    std::vector<double> buffer( rows * n[0] );
+    int64_t c = 0;
+    for ( size_t f = 0; f < fields.size(); f++ ) {
+        for ( int q = 0; q < components[f]; q++, c++ ) {
+            const double *data = &fields[f][q * Np];
+            for ( int k = 1; k <= n[2]; k++ ) {
+                for ( int j = 1; j <= n[1]; j += rows ) {
+                    for ( int jj = 0; jj < rows; jj++ ) {
+                        for ( int i = 0; i < n[0]; i++ ) {
+                            int idx = map( i + 1, j + jj, k );
+                            buffer[jj * n[0] + i] = idx < 0 ? 0.0 : data[idx];
+                        }
+                    }
+                    fseeko( fid, globalOffset( header, N, n, info, c, j, k ), SEEK_SET );
+                    size_t N2 = fwrite( buffer.data(), sizeof( double ), buffer.size(), fid );
+                    INSIST( N2 == buffer.size(), "Error writing " + filename );
+                }
+            }
+        }
+    }
+    fclose( fid );
+    comm.barrier();
+#endif
+    PROFILE_STOP( "writeGlobalRestart" );
+}
+void readGlobalRestart( const std::string &filename, const IntArray &map,
+    const RankInfoStruct &info, size_t Np, const std::vector<double *> &fields,
+    const std::vector<int> &components )
+{
+    PROFILE_START( "readGlobalRestart" );
+    ASSERT( fields.size() == components.size() );
+    int n[3]     = { (int) map.size( 0 ) - 2, (int) map.size( 1 ) - 2, (int) map.size( 2 ) - 2 };
+    int64_t N[3] = { (int64_t) n[0] * info.nx, (int64_t) n[1] * info.ny, (int64_t) n[2] * info.nz };
+    FILE *fid    = fopen( filename.c_str(), "rb" );
+    INSIST( fid, "Unable to open " + filename );
+    // Read and check the header
+    char magic[sizeof( global_magic )];
+    size_t N2 = fread( magic, 1, sizeof( magic ), fid );
+    if ( N2 != sizeof( magic ) || memcmp( magic, global_magic, sizeof( magic ) ) != 0 )
+        ERROR( filename + " is not a global restart file" );
+    int32_t version, size[3], nfields;
+    readValue( fid, version );
+    INSIST( version == restart_version, "Unknown version of " + filename );
+    for ( int d = 0; d < 3; d++ )
+        readValue( fid, size[d] );
+    if ( size[0] != N[0] || size[1] != N[1] || size[2] != N[2] )
+        ERROR( "The domain size in " + filename + " does not match" );
+    readValue( fid, nfields );
+    std::vector<int> components2( nfields );
+    for ( auto &c : components2 ) {
+        int32_t tmp;
+        readValue( fid, tmp );
+        c = tmp;
+    }
+    if ( components2 != components )
+        ERROR( "The fields in " + filename + " do not match" );
+    // Read the local block (sites that are not in the map are set to zero)
+    for ( size_t f = 0; f < fields.size(); f++ )
+        std::fill( fields[f], fields[f] + components[f] * Np, 0.0 );
+    size_t header = globalHeaderSize( fields.size() );
+    int rows      = info.nx == 1 ? n[1] : 1;
+    std::vector<double> buffer( rows * n[0] );
+    int64_t c = 0;
+    for ( size_t f = 0; f < fields.size(); f++ ) {
+        for ( int q = 0; q < components[f]; q++, c++ ) {
+            double *data = &fields[f][q * Np];
+            for ( int k = 1; k <= n[2]; k++ ) {
+                for ( int j = 1; j <= n[1]; j += rows ) {
+                    fseeko( fid, globalOffset( header, N, n, info, c, j, k ), SEEK_SET );
+                    N2 = fread( buffer.data(), sizeof( double ), buffer.size(), fid );
+                    INSIST( N2 == buffer.size(), "Error reading " + filename );
+                    for ( int jj = 0; jj < rows; jj++ ) {
+                        for ( int i = 0; i < n[0]; i++ ) {
+                            int idx = map( i + 1, j + jj, k );
+                            if ( idx >= 0 )
+                                data[idx] = buffer[jj * n[0] + i];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    fclose( fid );
+    PROFILE_STOP( "readGlobalRestart" );
+}
+
+
+} // namespace IO
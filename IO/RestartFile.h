@@ -0,0 +1,197 @@
+// This file contains functions to read/write aggregated restart files
+#ifndef included_RestartFile
+#define included_RestartFile
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/Array.h"
+#include "common/Communication.h"
+#include "common/MPI.h"
+
+
+namespace IO {
+
+
+//! Index entry for the data of one rank in an aggregated restart file
+struct RestartIndex {
+    int64_t rank;    //!< Rank that wrote the data
+    uint64_t offset; //!< Offset of the data in the file (bytes)
+    uint64_t Np;     //!< Number of lattice sites
+    uint64_t hash;   //!< Hash of the local layout (see layoutHash)
+};
+
+
+//! Header of an aggregated restart file
+struct RestartInfo {
+    int nprocs = 0;                //!< Number of ranks that wrote the restart
+    int nfiles = 0;                //!< Number of files (writer ranks)
+    int file = 0;                  //!< Index of this file
+    std::vector<int> components;   //!< Number of components for each field
+    std::vector<RestartIndex> index; //!< Index of the ranks stored in this file
+};
+
+
+/*!
+ * @brief  Hash the local layout
+ * @details  This function returns a hash of the map from the regular (i,j,k) layout
+ *    to the sparse layout used by the distributions.  Data written for one layout
+ *    can only be read back into the same layout.
+ * @param[in] map           The map (-1 for sites that are not stored)
+ * @param[in] N             The number of entries in the map
+ */
+uint64_t layoutHash( const int *map, size_t N );
+
+
+/*!
+ * @brief  Write an aggregated restart file
+ * @details  This function writes the restart data for all ranks to a smaller number of files.
+ *    The ranks are split into nfiles contiguous groups, and each group sends its data
+ *    to the first rank of the group which writes "<prefix>.agg.%05d".  Each file contains
+ *    a header, an index with the offset, size and layout hash for each rank, and the data.
+ *    Each field has components*Np values which are stored contiguously.
+ *    This is a collective call over comm.
+ * @param[in] prefix        The base name of the restart files
+ * @param[in] Np            The number of lattice sites on this rank
+ * @param[in] hash          The hash of the local layout
+ * @param[in] fields        The fields to write
+ * @param[in] components    The number of components in each field
+ * @param[in] nfiles        The number of files to write (writer ranks)
+ * @param[in] comm          The communicator to use
+ */
+void writeRestart( const std::string &prefix, size_t Np, uint64_t hash,
+    const std::vector<const double *> &fields, const std::vector<int> &components, int nfiles,
+    const Utilities::MPI &comm );
+
+
+/*!
+ * @brief  Read the header of an aggregated restart file
+ * @details  This function reads the header and the index of "<prefix>.agg.%05d".
+ * @param[in] prefix        The base name of the restart files
+ * @param[in] file          The index of the file to read
+ */
+RestartInfo readRestartInfo( const std::string &prefix, int file = 0 );
+
+
+/*!
+ * @brief  Read the data for one rank from an aggregated restart file
+ * @details  This function reads the data that was written by the given rank.
+ *    It does not require the same number of ranks that wrote the file and is not collective,
+ *    so a single rank may read the data for several of the original ranks.
+ *    The number of sites, the layout hash and the fields must match the data that was written.
+ * @param[in] prefix        The base name of the restart files
+ * @param[in] rank          The rank that wrote the data
+ * @param[in] Np            The number of lattice sites
+ * @param[in] hash          The hash of the local layout
+ * @param[out] fields       The fields to read (preallocated with components*Np values)
+ * @param[in] components    The number of components in each field
+ */
+void readRestart( const std::string &prefix, int rank, size_t Np, uint64_t hash,
+    const std::vector<double *> &fields, const std::vector<int> &components );
+
+
+/*!
+ * @brief  Compress a block of values
+ * @details  This function compresses the values for the restart files.  Each value is
+ *    predicted from the previous one (the bits are xor-ed), and the bytes are shuffled so
+ *    that the i-th byte of every value is stored together.  For smooth fields the sign,
+ *    exponent and leading mantissa bytes then compress well with zlib, while the byte
+ *    planes that do not compress are stored directly.
+ * @param[in] x             The values to compress
+ * @param[in] N             The number of values
+ * @param[in] level         The zlib compression level (1 is the fastest)
+ * @return                  The compressed data
+ */
+std::vector<char> compressValues( const double *x, size_t N, int level = 1 );
+
+
+/*!
+ * @brief  Decompress a block of values
+ * @details  This function reverses compressValues
+ * @param[in] data          The compressed data
+ * @param[in] bytes         The size of the compressed data
+ * @param[out] x            The values (preallocated with N values)
+ * @param[in] N             The number of values
+ */
+void decompressValues( const char *data, size_t bytes, double *x, size_t N );
+
+
+/*!
+ * @brief  Write a compressed restart file
+ * @details  This function writes a restart file for the local rank where each component of
+ *    each field (Np values) has been compressed with compressValues.  The components are
+ *    compressed seperately so that they can be compressed in parallel by the caller.
+ * @param[in] filename      The name of the restart file
+ * @param[in] Np            The number of lattice sites
+ * @param[in] components    The number of components in each field
+ * @param[in] blocks        The compressed data for each component of each field
+ */
+void writeCompressedRestart( const std::string &filename, size_t Np,
+    const std::vector<int> &components, const std::vector<std::vector<char>> &blocks );
+
+
+/*!
+ * @brief  Check if a restart file is compressed
+ * @details  This function checks if the file was written by writeCompressedRestart
+ * @param[in] filename      The name of the restart file
+ */
+bool isCompressedRestart( const std::string &filename );
+
+
+/*!
+ * @brief  Read a compressed restart file
+ * @details  This function reads a file written by writeCompressedRestart.
+ *    The number of sites and the fields must match the data that was written.
+ * @param[in] filename      The name of the restart file
+ * @param[in] Np            The number of lattice sites
+ * @param[out] fields       The fields to read (preallocated with components*Np values)
+ * @param[in] components    The number of components in each field
+ */
+void readCompressedRestart( const std::string &filename, size_t Np,
+    const std::vector<double *> &fields, const std::vector<int> &components );
+
+
+/*!
+ * @brief  Write a decomposition independent restart file
+ * @details  This function writes the restart data in the global regular (i,j,k) layout
+ *    so that it can be read back with a different processor grid.
+ *    The map is used to convert each component from the sparse layout to the interior
+ *    of the local sub-domain.  Rank 0 writes the header, and the blocks of all ranks are
+ *    written to the shared file with MPI-IO (a subarray file view and a collective write).
+ *    Sites that are not stored (map<0) are written as zero.
+ *    This is a collective call over comm.
+ * @param[in] filename      The name of the restart file
+ * @param[in] map           The map from the regular layout (with ghosts) to the sparse layout
+ * @param[in] info          The rank info for the local sub-domain
+ * @param[in] Np            The number of lattice sites on this rank
+ * @param[in] fields        The fields to write
+ * @param[in] components    The number of components in each field
+ * @param[in] comm          The communicator to use
+ */
+void writeGlobalRestart( const std::string &filename, const IntArray &map,
+    const RankInfoStruct &info, size_t Np, const std::vector<const double *> &fields,
+    const std::vector<int> &components, const Utilities::MPI &comm );
+
+
+/*!
+ * @brief  Read a decomposition independent restart file
+ * @details  This function reads the block of the global restart file that belongs to the
+ *    local sub-domain and converts it to the sparse layout with the map.
+ *    The processor grid does not need to match the one that wrote the file,
+ *    but the global domain size and the fields must match.  This call is not collective.
+ * @param[in] filename      The name of the restart file
+ * @param[in] map           The map from the regular layout (with ghosts) to the sparse layout
+ * @param[in] info          The rank info for the local sub-domain
+ * @param[in] Np            The number of lattice sites on this rank
+ * @param[out] fields       The fields to read (preallocated with components*Np values)
+ * @param[in] components    The number of components in each field
+ */
+void readGlobalRestart( const std::string &filename, const IntArray &map,
+    const RankInfoStruct &info, size_t Np, const std::vector<double *> &fields,
+    const std::vector<int> &components );
+
+
+} // namespace IO
+
+#endif
@@ -30,7 +30,7 @@
 #include <vector>
 
 
-enum class Format { OLD, NEW, SILO, HDF5, UNKNOWN };
+enum class Format { OLD, NEW, SILO, HDF5, HDF5_COLLECTIVE, UNKNOWN };
 
 
 /****************************************************
@@ -41,6 +41,9 @@ std::vector<IO::MeshDatabase> writeMeshesSilo(
 void writeSiloSummary( const std::vector<IO::MeshDatabase> &, const std::string & );
 std::vector<IO::MeshDatabase> writeMeshesHDF5(
     const std::vector<IO::MeshDataStruct> &, const std::string &, IO::FileFormat, int, Xdmf & );
+std::vector<IO::MeshDatabase> writeMeshesHDF5Collective( const std::vector<IO::MeshDataStruct> &,
+    const std::string &, IO::FileFormat, const Utilities::MPI &, bool, IO::HDF5::Compression,
+    Xdmf & );
 
 
 /****************************************************
@@ -91,6 +94,8 @@ static void recursiveMkdir( const std::string &path, mode_t mode )
  ****************************************************/
 static std::string global_IO_path;
 static Format global_IO_format = Format::UNKNOWN;
+static bool global_IO_chunk    = false;
+static auto global_IO_compress = IO::HDF5::Compression::None;
 void IO::initialize( const std::string &path, const std::string &format, bool append )
 {
     if ( path.empty() )
@@ -105,6 +110,8 @@ void IO::initialize( const std::string &path, const std::string &format, bool ap
         global_IO_format = Format::SILO;
     else if ( format == "hdf5" )
         global_IO_format = Format::HDF5;
+    else if ( format == "hdf5-collective" )
+        global_IO_format = Format::HDF5_COLLECTIVE;
     else
         ERROR( "Unknown format" );
     int rank = Utilities::MPI( MPI_COMM_WORLD ).getRank();
@@ -113,7 +120,8 @@ void IO::initialize( const std::string &path, const std::string &format, bool ap
         std::string filename;
         if ( global_IO_format == Format::OLD || global_IO_format == Format::NEW )
             filename = global_IO_path + "/summary.LBM";
-        else if ( global_IO_format == Format::SILO || global_IO_format == Format::HDF5 )
+        else if ( global_IO_format == Format::SILO || global_IO_format == Format::HDF5 ||
+                  global_IO_format == Format::HDF5_COLLECTIVE )
             filename = global_IO_path + "/LBM.visit";
         else
             ERROR( "Unknown format" );
@@ -123,6 +131,20 @@ void IO::initialize( const std::string &path, const std::string &format, bool ap
 }
 
 
+void IO::setHDF5Options( bool chunk, const std::string &compression )
+{
+    global_IO_chunk = chunk;
+    if ( compression == "none" )
+        global_IO_compress = IO::HDF5::Compression::None;
+    else if ( compression == "gzip" )
+        global_IO_compress = IO::HDF5::Compression::GZIP;
+    else if ( compression == "szip" )
+        global_IO_compress = IO::HDF5::Compression::SZIP;
+    else
+        ERROR( "Unknown compression: " + compression );
+}
+
+
 // Write the mesh data in the original format
 static std::vector<IO::MeshDatabase> writeMeshesOrigFormat(
     const std::vector<IO::MeshDataStruct> &meshData, const std::string &path, int rank )
@@ -303,7 +325,7 @@ void IO::writeData( const std::string &subdir, const std::vector<IO::MeshDataStr
     if ( global_IO_path.empty() )
         IO::initialize();
     PROFILE_START( "writeData" );
-    int rank = Utilities::MPI( MPI_COMM_WORLD ).getRank();
+    int rank = comm.getRank();
     // Check the meshData before writing
     for ( const auto &data : meshData )
         ASSERT( data.check() );
@@ -325,13 +347,17 @@ void IO::writeData( const std::string &subdir, const std::vector<IO::MeshDataStr
     } else if ( global_IO_format == Format::HDF5 ) {
         // Write hdf5
         meshes_written = writeMeshesHDF5( meshData, path, IO::FileFormat::HDF5, rank, xmf );
+    } else if ( global_IO_format == Format::HDF5_COLLECTIVE ) {
+        // Write hdf5 (single file shared by all ranks)
+        meshes_written = writeMeshesHDF5Collective( meshData, path,
+            IO::FileFormat::HDF5_COLLECTIVE, comm, global_IO_chunk, global_IO_compress, xmf );
     } else {
         ERROR( "Unknown format" );
     }
     // Gather a complete list of files on rank 0
     meshes_written = gatherAll( meshes_written, comm );
     // Gather xmf file (if applicable)
-    if ( global_IO_format == Format::HDF5 ) {
+    if ( global_IO_format == Format::HDF5 || global_IO_format == Format::HDF5_COLLECTIVE ) {
         xmf.gather( comm );
     }
     // Write the summary files
@@ -341,7 +367,8 @@ void IO::writeData( const std::string &subdir, const std::vector<IO::MeshDataStr
         // Write summary file if needed
         if ( global_IO_format == Format::SILO ) {
             writeSiloSummary( meshes_written, path + "/summary.silo" );
-        } else if ( global_IO_format == Format::HDF5 ) {
+        } else if ( global_IO_format == Format::HDF5 ||
+                    global_IO_format == Format::HDF5_COLLECTIVE ) {
             xmf.write( path + "/summary.xmf" );
         }
         // Add the timestep to the global summary file
@@ -355,7 +382,8 @@ void IO::writeData( const std::string &subdir, const std::vector<IO::MeshDataStr
             FILE *fid     = fopen( filename.c_str(), "ab" );
             fprintf( fid, "%s/summary.silo\n", subdir.c_str() );
             fclose( fid );
-        } else if ( global_IO_format == Format::HDF5 ) {
+        } else if ( global_IO_format == Format::HDF5 ||
+                    global_IO_format == Format::HDF5_COLLECTIVE ) {
             auto filename = global_IO_path + "/LBM.visit";
             FILE *fid     = fopen( filename.c_str(), "ab" );
             fprintf( fid, "%s/summary.xmf\n", subdir.c_str() );
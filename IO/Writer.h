@@ -39,12 +39,24 @@ namespace IO {
  *                              new - New format, 1 file/process
  *                              silo - Silo
  *                              hdf5 - HDF5 + XMDF
+ *                              hdf5-collective - HDF5 + XMDF, 1 file shared by all processes
  * @param[in] append        Append any existing data (default is false)
  */
 void initialize(
     const std::string &path = "", const std::string &format = "hdf5", bool append = false );
 
 
+/*!
+ * @brief  Set the options for the shared hdf5 file
+ * @details  This function sets the storage used by the hdf5-collective format.
+ *    Each variable on a DomainMesh is stored as a single dataset over the global domain
+ *    that is written collectively.  Compression requires chunked storage.
+ * @param[in] chunk         Store the DomainMesh variables in chunks of one sub-domain
+ * @param[in] compression   Compression to use for the chunks: none, gzip, szip
+ */
+void setHDF5Options( bool chunk, const std::string &compression = "none" );
+
+
 /*!
  * @brief  Write the data for the timestep
  * @details  This function writes the mesh and variable data provided for the current timestep
@@ -246,17 +246,18 @@ static void writeMeshGrid( FILE *fid, const Xdmf::MeshData &mesh, const std::str
     case Xdmf::TopologyType::UniformMesh3D:
         // Write a uniform 3d mesh
         fprintf( fid, "%s<Grid Name=\"%s\" GridType=\"Uniform\">\n", s, mesh.name.data() );
+        // Note: the dimensions, origin and spacing are given in z, y, x order
         fprintf( fid,
-            "%s  <Topology TopologyType=\"3DCoRectMesh\" NumberOfElements=\"%lu %lu\"/>\n", s,
-            mesh.size[1] + 1, mesh.size[0] + 1 );
+            "%s  <Topology TopologyType=\"3DCoRectMesh\" NumberOfElements=\"%lu %lu %lu\"/>\n",
+            s, mesh.size[2] + 1, mesh.size[1] + 1, mesh.size[0] + 1 );
         fprintf( fid, "%s  <Geometry GeometryType=\"ORIGIN_DXDYDZ\">\n", s );
         fprintf(
             fid, "%s    <DataItem  Format=\"XML\" NumberType=\"float\" Dimensions=\"3\">\n", s );
-        fprintf( fid, "%s      %0.12e  %0.12e  %0.12e\n", s, x0[0], x0[1], x0[2] );
+        fprintf( fid, "%s      %0.12e  %0.12e  %0.12e\n", s, x0[2], x0[1], x0[0] );
         fprintf( fid, "%s    </DataItem>\n", s );
         fprintf(
             fid, "%s    <DataItem  Format=\"XML\" NumberType=\"float\" Dimensions=\"3\">\n", s );
-        fprintf( fid, "%s       %0.12e  %0.12e  %0.12e\n", s, dx[0], dx[1], dx[2] );
+        fprintf( fid, "%s       %0.12e  %0.12e  %0.12e\n", s, dx[2], dx[1], dx[0] );
         fprintf( fid, "%s    </DataItem>\n", s );
         fprintf( fid, "%s  </Geometry>\n", s );
         break;
@@ -4,6 +4,9 @@
 #include "analysis/distance.h"
 #include "analysis/morphology.h"
 
+#include <algorithm>
+#include <chrono>
+
 FlowAdaptor::FlowAdaptor(ScaLBL_ColorModel &M) {
     Nx = M.Dm->Nx;
     Ny = M.Dm->Ny;
@@ -34,10 +37,13 @@ double FlowAdaptor::ImageInit(ScaLBL_ColorModel &M, std::string Filename) {
     for (int i = 0; i < Nx * Ny * Nz; i++)
         M.Dm->id[i] = M.Mask->id[i]; // save what was read
 
-    double *PhaseLabel;
-    PhaseLabel = new double[Nx * Ny * Nz];
-    M.AssignComponentLabels(PhaseLabel);
+    return LabelInit(M);
+}
 
+static double ImageSaturation(ScaLBL_ColorModel &M) {
+    int Nx = M.Nx;
+    int Ny = M.Ny;
+    int Nz = M.Nz;
     double Count = 0.0;
     double PoreCount = 0.0;
     for (int k = 1; k < Nz - 1; k++) {
@@ -56,25 +62,245 @@ double FlowAdaptor::ImageInit(ScaLBL_ColorModel &M, std::string Filename) {
     Count = M.Dm->Comm.sumReduce(Count);
     PoreCount = M.Dm->Comm.sumReduce(PoreCount);
 
-    if (rank == 0)
+    if (M.rank == 0)
         printf("   new saturation: %f (%f / %f) \n", Count / PoreCount, Count,
                PoreCount);
-    ScaLBL_CopyToDevice(M.Phi, PhaseLabel, Nx * Ny * Nz * sizeof(double));
+    return Count / PoreCount;
+}
+
+double FlowAdaptor::LabelInit(ScaLBL_ColorModel &M) {
+    int Nx = M.Nx;
+    int Ny = M.Ny;
+    int Nz = M.Nz;
+
+    double *PhaseLabel;
+    PhaseLabel = new double[Nx * Ny * Nz];
+    M.AssignComponentLabels(PhaseLabel);
+
+    double saturation = ImageSaturation(M);
+
+    M.CopyPhaseToDevice(PhaseLabel);
     M.Dm->Comm.barrier();
 
     ScaLBL_D3Q19_Init(M.fq, M.Np);
-    ScaLBL_PhaseField_Init(M.dvcMap, M.Phi, M.Den, M.Aq, M.Bq, 0,
+    ScaLBL_PhaseField_Init(M.dvcPhiMap, M.Phi, M.Den, M.Aq, M.Bq, 0,
                            M.ScaLBL_Comm->LastExterior(), M.Np);
-    ScaLBL_PhaseField_Init(M.dvcMap, M.Phi, M.Den, M.Aq, M.Bq,
+    ScaLBL_PhaseField_Init(M.dvcPhiMap, M.Phi, M.Den, M.Aq, M.Bq,
                            M.ScaLBL_Comm->FirstInterior(),
                            M.ScaLBL_Comm->LastInterior(), M.Np);
     M.Dm->Comm.barrier();
 
-    ScaLBL_CopyToHost(M.Averages->Phi.data(), M.Phi,
-                      Nx * Ny * Nz * sizeof(double));
+    M.CopyPhaseToHost(M.Averages->Phi.data());
 
     delete PhaseLabel;
-    double saturation = Count / PoreCount;
+    return saturation;
+}
+
+/* local indices (including the halo) that hold the voxel at index x of the
+   simulation domain along one axis; as in Domain::ReadSubdomain the local index i
+   reads the image at start + p*n + i - 1 - shift, clamped to [start, size-1] */
+static void LocalIndex(int64_t x, int64_t start, int64_t size, int64_t shift,
+                       int p, int n, std::vector<int> &list) {
+    list.clear();
+    for (int i = 0; i < n + 2; i++) {
+        int64_t v = start + p * n + i - 1 - shift;
+        v = std::max(start, std::min(v, size - 1));
+        if (v == start + x)
+            list.push_back(i);
+    }
+}
+
+static void ReadDelta(ScaLBL_ColorModel &M, std::string Filename,
+                      signed char *labels) {
+    int Nx = M.Nx;
+    int Ny = M.Ny;
+    int Nz = M.Nz;
+    auto &Comm = M.Dm->Comm;
+    std::vector<int> delta;
+    int count = 0;
+    if (M.rank == 0) {
+        FILE *DELTA = fopen(Filename.c_str(), "rb");
+        if (DELTA == NULL)
+            ERROR("FlowAdaptor: could not open delta file " + Filename);
+        fseek(DELTA, 0, SEEK_END);
+        count = ftell(DELTA) / (4 * sizeof(int));
+        fseek(DELTA, 0, SEEK_SET);
+        delta.resize(4 * count);
+        size_t readsize = fread(delta.data(), sizeof(int), 4 * count, DELTA);
+        fclose(DELTA);
+        if (readsize != 4 * (size_t)count)
+            ERROR("FlowAdaptor: failed to read delta file " + Filename);
+    }
+    count = Comm.bcast(count, 0);
+    delta.resize(4 * count);
+    if (count > 0)
+        Comm.bcast(delta.data(), 4 * count, 0);
+
+    // The image layout used by Domain::Decomp for the first image
+    auto Dm = M.Mask;
+    if (Dm->inlet_layers_x > 0 || Dm->inlet_layers_y > 0 ||
+        Dm->inlet_layers_z > 0 || Dm->outlet_layers_x > 0 ||
+        Dm->outlet_layers_y > 0 || Dm->outlet_layers_z > 0)
+        ERROR("FlowAdaptor: delta images are not supported with InletLayers "
+              "or OutletLayers");
+    int64_t start[3] = {Dm->offset_x, Dm->offset_y, Dm->offset_z};
+    auto SIZE = Dm->database->getVector<int>("N");
+    int64_t size[3] = {SIZE[0], SIZE[1], SIZE[2]};
+    // number of sites used for the periodic transition zone in z
+    int64_t shift = (M.nprocz * (Nz - 2) - (size[2] - start[2])) / 2;
+    if (shift < 0)
+        shift = 0;
+
+    std::vector<int> ilist, jlist, klist;
+    for (int idx = 0; idx < count; idx++) {
+        int x = delta[4 * idx], y = delta[4 * idx + 1], z = delta[4 * idx + 2];
+        if (x < 0 || y < 0 || z < 0 || !(start[0] + x < size[0]) ||
+            !(start[1] + y < size[1]) || !(start[2] + z < size[2]))
+            ERROR("FlowAdaptor: voxel in delta file " + Filename +
+                  " is outside the image");
+        LocalIndex(x, start[0], size[0], 0, Dm->iproc(), Nx - 2, ilist);
+        LocalIndex(y, start[1], size[1], 0, Dm->jproc(), Ny - 2, jlist);
+        LocalIndex(z, start[2], size[2], shift, Dm->kproc(), Nz - 2, klist);
+        for (int k : klist) {
+            for (int j : jlist) {
+                for (int i : ilist) {
+                    int n = k * Nx * Ny + j * Nx + i;
+                    labels[n] = (signed char)delta[4 * idx + 3];
+                }
+            }
+        }
+    }
+}
+
+double FlowAdaptor::ImageUpdate(ScaLBL_ColorModel &M, std::string Filename) {
+    int rank = M.rank;
+    int Nx = M.Nx;
+    int Ny = M.Ny;
+    int Nz = M.Nz;
+    int N = Nx * Ny * Nz;
+    if (rank == 0)
+        printf("Updating fluids from file: %s \n", Filename.c_str());
+
+    auto t0 = std::chrono::system_clock::now();
+    /* new labels are read into Mask->id */
+    bool DELTA = Filename.size() > 6 &&
+                 Filename.compare(Filename.size() - 6, 6, ".delta") == 0;
+    if (DELTA) {
+        for (int n = 0; n < N; n++)
+            M.Mask->id[n] = M.id[n];
+        ReadDelta(M, Filename, M.Mask->id.data());
+    } else {
+        M.Mask->Decomp(Filename);
+    }
+    auto t1 = std::chrono::system_clock::now();
+
+    /* find the sites that changed */
+    std::vector<int> ChangedSites;
+    double SolidChange = 0.0;
+    double ChangedCount = 0.0;
+    for (int k = 0; k < Nz; k++) {
+        for (int j = 0; j < Ny; j++) {
+            for (int i = 0; i < Nx; i++) {
+                int n = k * Nx * Ny + j * Nx + i;
+                signed char label = M.Mask->id[n];
+                if (label != M.id[n]) {
+                    ChangedSites.push_back(n);
+                    if ((label > 0) != (M.id[n] > 0))
+                        SolidChange = 1.0;
+                    if (i > 0 && j > 0 && k > 0 && i < Nx - 1 &&
+                        j < Ny - 1 && k < Nz - 1)
+                        ChangedCount++;
+                }
+            }
+        }
+    }
+    SolidChange = M.Dm->Comm.maxReduce(SolidChange);
+    ChangedCount = M.Dm->Comm.sumReduce(ChangedCount);
+    for (auto n : ChangedSites) {
+        M.id[n] = M.Mask->id[n];
+        M.Dm->id[n] = M.Mask->id[n];
+    }
+    auto t2 = std::chrono::system_clock::now();
+
+    double saturation;
+    if (SolidChange > 0.0) {
+        /* the pore structure changed, so all sites are re-initialized */
+        if (rank == 0)
+            printf("   solid labels changed, re-initializing all sites \n");
+        saturation = LabelInit(M);
+    } else {
+        auto LabelList = M.color_db->getVector<int>("ComponentLabels");
+        auto AffinityList = M.color_db->getVector<double>("ComponentAffinity");
+        auto WettingConvention =
+            M.color_db->getWithDefault<std::string>("WettingConvention", "none");
+        if (WettingConvention == "SCAL") {
+            for (size_t idx = 0; idx < AffinityList.size(); idx++)
+                AffinityList[idx] *= -1.0;
+        }
+
+        std::vector<int> PhaseList, SiteList;
+        std::vector<double> PhaseValue;
+        for (auto n : ChangedSites) {
+            signed char VALUE = M.id[n];
+            double AFFINITY = 0.0;
+            for (size_t idx = 0; idx < LabelList.size(); idx++) {
+                if (VALUE == LabelList[idx])
+                    AFFINITY = AffinityList[idx];
+            }
+            // fluid labels are reserved
+            if (VALUE == 1)
+                AFFINITY = 1.0;
+            else if (VALUE == 2)
+                AFFINITY = -1.0;
+            M.Averages->Phi(n) = AFFINITY;
+            if (M.PhiMap(n) >= 0) {
+                PhaseList.push_back(M.PhiMap(n));
+                PhaseValue.push_back(AFFINITY);
+            }
+            if (M.Map(n) >= 0)
+                SiteList.push_back(M.Map(n));
+        }
+
+        int count = PhaseList.size();
+        if (count > 0) {
+            int *dvcList;
+            double *dvcValue;
+            ScaLBL_AllocateDeviceMemory((void **)&dvcList, sizeof(int) * count);
+            ScaLBL_AllocateDeviceMemory((void **)&dvcValue,
+                                        sizeof(double) * count);
+            ScaLBL_CopyToDevice(dvcList, PhaseList.data(), sizeof(int) * count);
+            ScaLBL_CopyToDevice(dvcValue, PhaseValue.data(),
+                                sizeof(double) * count);
+            ScaLBL_Scalar_Unpack(dvcList, count, dvcValue, M.Phi, M.NPhi);
+            ScaLBL_DeviceBarrier();
+            ScaLBL_FreeDeviceMemory(dvcList);
+            ScaLBL_FreeDeviceMemory(dvcValue);
+        }
+        count = SiteList.size();
+        if (count > 0) {
+            int *dvcList;
+            ScaLBL_AllocateDeviceMemory((void **)&dvcList, sizeof(int) * count);
+            ScaLBL_CopyToDevice(dvcList, SiteList.data(), sizeof(int) * count);
+            ScaLBL_PhaseField_InitList(dvcList, M.dvcPhiMap, M.Phi, M.Den,
+                                       M.Aq, M.Bq, count, M.Np);
+            ScaLBL_DeviceBarrier();
+            ScaLBL_FreeDeviceMemory(dvcList);
+        }
+        saturation = ImageSaturation(M);
+    }
+    M.Dm->Comm.barrier();
+    auto t3 = std::chrono::system_clock::now();
+
+    double read_time = std::chrono::duration<double>(t1 - t0).count();
+    double diff_time = std::chrono::duration<double>(t2 - t1).count();
+    double update_time = std::chrono::duration<double>(t3 - t2).count();
+    read_time = M.Dm->Comm.maxReduce(read_time);
+    diff_time = M.Dm->Comm.maxReduce(diff_time);
+    update_time = M.Dm->Comm.maxReduce(update_time);
+    if (rank == 0)
+        printf("   changed sites: %.0f, read: %f s, diff: %f s, update: %f s \n",
+               ChangedCount, read_time, diff_time, update_time);
+
     return saturation;
 }
 
@@ -251,9 +477,9 @@ double FlowAdaptor::UpdateFractionalFlow(ScaLBL_ColorModel &M) {
 void FlowAdaptor::Flatten(ScaLBL_ColorModel &M) {
 
     ScaLBL_D3Q19_Init(M.fq, M.Np);
-    ScaLBL_PhaseField_Init(M.dvcMap, M.Phi, M.Den, M.Aq, M.Bq, 0,
+    ScaLBL_PhaseField_Init(M.dvcPhiMap, M.Phi, M.Den, M.Aq, M.Bq, 0,
                            M.ScaLBL_Comm->LastExterior(), M.Np);
-    ScaLBL_PhaseField_Init(M.dvcMap, M.Phi, M.Den, M.Aq, M.Bq,
+    ScaLBL_PhaseField_Init(M.dvcPhiMap, M.Phi, M.Den, M.Aq, M.Bq,
                            M.ScaLBL_Comm->FirstInterior(),
                            M.ScaLBL_Comm->LastInterior(), M.Np);
 }
@@ -265,7 +491,7 @@ double FlowAdaptor::MoveInterface(ScaLBL_ColorModel &M) {
     double MOVE_INTERFACE_FACTOR =
         M.color_db->getWithDefault<double>("move_interface_factor", 10.0);
 
-    ScaLBL_CopyToHost(phi.data(), M.Phi, Nx * Ny * Nz * sizeof(double));
+    M.CopyPhaseToHost(phi.data());
     /* compute the local derivative of phase indicator field */
     double beta = M.beta;
     double factor = 0.5 / beta;
@@ -292,7 +518,7 @@ double FlowAdaptor::MoveInterface(ScaLBL_ColorModel &M) {
             total_interface_sites += 1.0;
         }
     }
-    ScaLBL_CopyToDevice(M.Phi, phi_t.data(), Nx * Ny * Nz * sizeof(double));
+    M.CopyPhaseToDevice(phi_t.data());
     return total_interface_sites;
 }
 
@@ -304,7 +530,6 @@ double FlowAdaptor::ShellAggregation(ScaLBL_ColorModel &M,
     auto Nx = M.Nx;
     auto Ny = M.Ny;
     auto Nz = M.Nz;
-    auto N = Nx * Ny * Nz;
     double vF = 0.f;
     double vS = 0.f;
     double delta_volume;
@@ -321,7 +546,7 @@ double FlowAdaptor::ShellAggregation(ScaLBL_ColorModel &M,
 
     // Basic algorithm to
     // 1. Copy phase field to CPU
-    ScaLBL_CopyToHost(phase.data(), M.Phi, N * sizeof(double));
+    M.CopyPhaseToHost(phase.data());
 
     double count = 0.f;
     for (int k = 1; k < Nz - 1; k++) {
@@ -486,26 +711,26 @@ double FlowAdaptor::ShellAggregation(ScaLBL_ColorModel &M,
 
     // 6. copy back to the device
     //if (rank==0)  printf("MorphInit: copy data  back to device\n");
-    ScaLBL_CopyToDevice(M.Phi, phase.data(), N * sizeof(double));
+    M.CopyPhaseToDevice(phase.data());
 
     // 7. Re-initialize phase field and density
-    ScaLBL_PhaseField_Init(M.dvcMap, M.Phi, M.Den, M.Aq, M.Bq, 0,
+    ScaLBL_PhaseField_Init(M.dvcPhiMap, M.Phi, M.Den, M.Aq, M.Bq, 0,
                            M.ScaLBL_Comm->LastExterior(), M.Np);
-    ScaLBL_PhaseField_Init(M.dvcMap, M.Phi, M.Den, M.Aq, M.Bq,
+    ScaLBL_PhaseField_Init(M.dvcPhiMap, M.Phi, M.Den, M.Aq, M.Bq,
                            M.ScaLBL_Comm->FirstInterior(),
                            M.ScaLBL_Comm->LastInterior(), M.Np);
     auto BoundaryCondition = M.BoundaryCondition;
     if (BoundaryCondition == 1 || BoundaryCondition == 2 ||
         BoundaryCondition == 3 || BoundaryCondition == 4) {
         if (M.Dm->kproc() == 0) {
-            ScaLBL_SetSlice_z(M.Phi, 1.0, Nx, Ny, Nz, 0);
-            ScaLBL_SetSlice_z(M.Phi, 1.0, Nx, Ny, Nz, 1);
-            ScaLBL_SetSlice_z(M.Phi, 1.0, Nx, Ny, Nz, 2);
+            M.SetPhaseSlice_z(1.0, 0);
+            M.SetPhaseSlice_z(1.0, 1);
+            M.SetPhaseSlice_z(1.0, 2);
         }
         if (M.Dm->kproc() == M.nprocz - 1) {
-            ScaLBL_SetSlice_z(M.Phi, -1.0, Nx, Ny, Nz, Nz - 1);
-            ScaLBL_SetSlice_z(M.Phi, -1.0, Nx, Ny, Nz, Nz - 2);
-            ScaLBL_SetSlice_z(M.Phi, -1.0, Nx, Ny, Nz, Nz - 3);
+            M.SetPhaseSlice_z(-1.0, Nz - 1);
+            M.SetPhaseSlice_z(-1.0, Nz - 2);
+            M.SetPhaseSlice_z(-1.0, Nz - 3);
         }
     }
     return delta_volume;
@@ -50,6 +50,19 @@ public:
     */
     double ImageInit(ScaLBL_ColorModel &M, std::string Filename);
 
+    /**
+     * \brief Incremental image update
+     * \details Update the LB simulation for the voxels that differ from the current labels.
+     *       Only the phase field and D3Q7 distributions of the changed sites are re-initialized,
+     *       and the D3Q19 distributions are kept. If any voxel changes between solid and fluid
+     *       the simulation is re-initialized as in ImageInit. Filenames ending in ``.delta''
+     *       list the changed voxels as binary int32 records (x, y, z, label) in global
+     *       coordinates of the simulation domain, and are used instead of a full image.
+     * @param M        ScaLBL_ColorModel 
+     * @param Filename    name of input file with the image or the list of changed voxels 
+    */
+    double ImageUpdate(ScaLBL_ColorModel &M, std::string Filename);
+
     /**
      * \details Update volume fraction based on morphological algorithm. Dilation / erosion algorithm will be applied to 
      * grow / shrink the phase regions
@@ -82,6 +95,7 @@ public:
     DoubleArray phi_t;
 
 private:
+    double LabelInit(ScaLBL_ColorModel &M);
     int Nx, Ny, Nz;
     int timestep;
     int timestep_previous;
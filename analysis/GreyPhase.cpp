@@ -1,4 +1,5 @@
 #include "analysis/GreyPhase.h"
+#include "common/BatchedReduction.h"
 
 // Constructor
 GreyPhaseAnalysis::GreyPhaseAnalysis(std::shared_ptr<Domain> dm) : Dm(dm) {
@@ -128,26 +129,30 @@ void GreyPhaseAnalysis::Basic() {
             }
         }
     }
-    Oil.M = Dm->Comm.sumReduce(Oil_local.M);
-    Oil.Px = Dm->Comm.sumReduce(Oil_local.Px);
-    Oil.Py = Dm->Comm.sumReduce(Oil_local.Py);
-    Oil.Pz = Dm->Comm.sumReduce(Oil_local.Pz);
+    BatchedReduction reduction(Dm->Comm);
+    reduction.sum(Oil_local.M, Oil.M);
+    reduction.sum(Oil_local.Px, Oil.Px);
+    reduction.sum(Oil_local.Py, Oil.Py);
+    reduction.sum(Oil_local.Pz, Oil.Pz);
 
-    Water.M = Dm->Comm.sumReduce(Water_local.M);
-    Water.Px = Dm->Comm.sumReduce(Water_local.Px);
-    Water.Py = Dm->Comm.sumReduce(Water_local.Py);
-    Water.Pz = Dm->Comm.sumReduce(Water_local.Pz);
+    reduction.sum(Water_local.M, Water.M);
+    reduction.sum(Water_local.Px, Water.Px);
+    reduction.sum(Water_local.Py, Water.Py);
+    reduction.sum(Water_local.Pz, Water.Pz);
 
     //Oil.p /= Oil.M;
     //Water.p /= Water.M;
-    count_w = Dm->Comm.sumReduce(count_w);
-    count_n = Dm->Comm.sumReduce(count_n);
+    reduction.sum(count_w, count_w);
+    reduction.sum(count_n, count_n);
+    reduction.sum(Water_local.p, Water.p);
+    reduction.sum(Oil_local.p, Oil.p);
+    reduction.reduce();
     if (count_w > 0.0)
-        Water.p = Dm->Comm.sumReduce(Water_local.p) / count_w;
+        Water.p /= count_w;
     else
         Water.p = 0.0;
     if (count_n > 0.0)
-        Oil.p = Dm->Comm.sumReduce(Oil_local.p) / count_n;
+        Oil.p /= count_n;
     else
         Oil.p = 0.0;
 
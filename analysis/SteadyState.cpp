@@ -0,0 +1,184 @@
+/* Statistical steady-state detection for time series of averaged quantities */
+
+#include "analysis/SteadyState.h"
+#include "common/Utilities.h"
+
+#include <math.h>
+#include <stdio.h>
+
+// Regularized incomplete beta function I_x(a,b) (continued fraction, modified Lentz)
+static double incompleteBeta(double a, double b, double x) {
+    if (x <= 0.0)
+        return 0.0;
+    if (x >= 1.0)
+        return 1.0;
+    if (x > (a + 1.0) / (a + b + 2.0))
+        return 1.0 - incompleteBeta(b, a, 1.0 - x);
+    const double tiny = 1.0e-300;
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) +
+                       b * log(1.0 - x)) / a;
+    double c = 1.0, d = 1.0 - (a + b) * x / (a + 1.0);
+    if (fabs(d) < tiny)
+        d = tiny;
+    d = 1.0 / d;
+    double h = d;
+    for (int m = 1; m < 300; m++) {
+        for (int step = 0; step < 2; step++) {
+            double num = (step == 0)
+                             ? m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+                             : -(a + m) * (a + b + m) * x /
+                                   ((a + 2 * m) * (a + 2 * m + 1));
+            d = 1.0 + num * d;
+            if (fabs(d) < tiny)
+                d = tiny;
+            c = 1.0 + num / c;
+            if (fabs(c) < tiny)
+                c = tiny;
+            d = 1.0 / d;
+            h *= d * c;
+        }
+        if (fabs(d * c - 1.0) < 1.0e-15)
+            break;
+    }
+    return front * h;
+}
+
+// Two-sided critical value of Student's t distribution with dof degrees of freedom
+static double studentCritical(double confidence, int dof) {
+    // P(|T| < t) = 1 - I_{dof/(dof+t^2)}(dof/2, 1/2)
+    auto probability = [dof](double t) {
+        return 1.0 - incompleteBeta(0.5 * dof, 0.5, dof / (dof + t * t));
+    };
+    double lower = 0.0, upper = 1.0;
+    while (probability(upper) < confidence)
+        upper *= 2.0;
+    for (int iter = 0; iter < 100; iter++) {
+        double t = 0.5 * (lower + upper);
+        if (probability(t) < confidence)
+            lower = t;
+        else
+            upper = t;
+    }
+    return 0.5 * (lower + upper);
+}
+
+SteadyState::SteadyState(const std::vector<std::string> &names_, int window_,
+                         double tolerance_, double confidence_)
+    : names(names_), window(window_), tolerance(tolerance_),
+      confidence(confidence_) {
+    if (window < 3)
+        ERROR("SteadyState: window must contain at least 3 samples");
+    if (confidence <= 0.0 || confidence >= 1.0)
+        ERROR("SteadyState: confidence must be between 0 and 1");
+    // the slope of the fit has window-2 degrees of freedom, the mean window-1
+    d_slope_critical = studentCritical(confidence, window - 2);
+    d_mean_critical = studentCritical(confidence, window - 1);
+    d_values.resize(names.size());
+    d_scales.resize(names.size());
+    drift.resize(names.size(), 0.0);
+    halfwidth.resize(names.size(), 0.0);
+    tstat.resize(names.size(), 0.0);
+    d_reason = "not enough samples";
+}
+
+void SteadyState::add(const std::vector<double> &values,
+                      const std::vector<double> &scales) {
+    if (values.size() != names.size() || scales.size() != names.size())
+        ERROR("SteadyState: wrong number of values");
+    for (size_t s = 0; s < names.size(); s++) {
+        d_values[s].push_back(values[s]);
+        d_scales[s].push_back(fabs(scales[s]));
+        if ((int)d_values[s].size() > window) {
+            d_values[s].erase(d_values[s].begin());
+            d_scales[s].erase(d_scales[s].begin());
+        }
+    }
+}
+
+int SteadyState::samples() const {
+    return names.empty() ? 0 : d_values[0].size();
+}
+
+void SteadyState::reset() {
+    for (size_t s = 0; s < names.size(); s++) {
+        d_values[s].clear();
+        d_scales[s].clear();
+        drift[s] = halfwidth[s] = tstat[s] = 0.0;
+    }
+    d_reason = "not enough samples";
+}
+
+bool SteadyState::steady() {
+    char message[256];
+    int n = samples();
+    if (n < window) {
+        snprintf(message, sizeof(message), "not enough samples (%i of %i)", n,
+                 window);
+        d_reason = message;
+        return false;
+    }
+    bool isSteady = true;
+    double maxdrift = 0.0, maxwidth = 0.0;
+    int drift_series = 0, width_series = 0;
+    for (size_t s = 0; s < names.size(); s++) {
+        const auto &y = d_values[s];
+        double xmean = 0.5 * (n - 1);
+        double ymean = 0.0, scale = 0.0;
+        for (int i = 0; i < n; i++) {
+            ymean += y[i];
+            scale += d_scales[s][i];
+        }
+        ymean /= n;
+        scale /= n;
+        if (scale == 0.0)
+            scale = 1.0;
+        // least-squares slope and its standard error
+        double Sxx = 0.0, Sxy = 0.0, Syy = 0.0;
+        for (int i = 0; i < n; i++) {
+            Sxx += (i - xmean) * (i - xmean);
+            Sxy += (i - xmean) * (y[i] - ymean);
+            Syy += (y[i] - ymean) * (y[i] - ymean);
+        }
+        double slope = Sxy / Sxx;
+        double residual = Syy - slope * Sxy;
+        if (residual < 0.0)
+            residual = 0.0;
+        double slope_error = sqrt(residual / (n - 2) / Sxx);
+        double std_dev = sqrt(Syy / (n - 1));
+
+        drift[s] = fabs(slope) * (n - 1) / scale;
+        halfwidth[s] = d_mean_critical * std_dev / sqrt(double(n)) / scale;
+        if (slope_error > 0.0)
+            tstat[s] = fabs(slope) / slope_error;
+        else
+            tstat[s] = (slope == 0.0) ? 0.0 : 1.0e300;
+
+        bool trend = drift[s] < tolerance || tstat[s] < d_slope_critical;
+        bool variance = halfwidth[s] < tolerance;
+        if (!trend || !variance)
+            isSteady = false;
+        if (!trend && drift[s] >= maxdrift) {
+            maxdrift = drift[s];
+            drift_series = s;
+        }
+        if (!variance && halfwidth[s] >= maxwidth) {
+            maxwidth = halfwidth[s];
+            width_series = s;
+        }
+    }
+    if (isSteady) {
+        snprintf(message, sizeof(message),
+                 "steady at confidence %g over %i samples (tolerance %g)",
+                 confidence, n, tolerance);
+    } else if (maxdrift > 0.0) {
+        snprintf(message, sizeof(message),
+                 "%s is drifting (drift %g, t = %g)",
+                 names[drift_series].c_str(), maxdrift, tstat[drift_series]);
+    } else {
+        snprintf(message, sizeof(message),
+                 "%s is fluctuating (confidence interval %g)",
+                 names[width_series].c_str(), maxwidth);
+    }
+    d_reason = message;
+    return isSteady;
+}
@@ -0,0 +1,82 @@
+/*
+ * Statistical steady-state detection for time series of averaged quantities
+ */
+
+#ifndef SteadyState_INC
+#define SteadyState_INC
+
+#include <string>
+#include <vector>
+
+/**
+ * \class SteadyState
+ * @brief
+ * The SteadyState class collects samples of several averaged quantities (e.g. saturation,
+ * flow rates and pressure) and decides if the time series has reached a steady state.
+ * Over a window of the most recent samples each series must pass two tests
+ *    trend     -- the drift of the least-squares fit over the window is below the tolerance,
+ *                 or the slope is not significant at the confidence level
+ *    variance  -- the confidence interval for the mean is narrower than the tolerance
+ * Both tests are relative to a scale that is provided with each sample.
+ * The critical values are quantiles of Student's t distribution. The tests assume independent
+ * samples; correlated samples make them optimistic.
+ */
+class SteadyState {
+public:
+    /**
+     * \brief Create a steady-state detector
+     * @param names         names of the series (used to report the outcome)
+     * @param window        number of samples used for the tests
+     * @param tolerance     relative tolerance for the drift and the confidence interval
+     * @param confidence    confidence level for the tests (e.g. 0.95)
+     */
+    SteadyState(const std::vector<std::string> &names, int window,
+                double tolerance, double confidence);
+
+    /**
+     * \brief Add a sample for each series
+     * @param values        value of each series
+     * @param scales        scale used to normalize the drift and confidence interval of each series
+     */
+    void add(const std::vector<double> &values,
+             const std::vector<double> &scales);
+
+    /**
+     * \brief Test if all series are steady over the most recent window
+     */
+    bool steady();
+
+    /**
+     * \brief Describe the outcome of the last call to steady()
+     */
+    const std::string &reason() const { return d_reason; }
+
+    /**
+     * \brief Discard all samples (e.g. when the driving force changes)
+     */
+    void reset();
+
+    //! Number of samples in the current window
+    int samples() const;
+
+    //! Relative drift of each series over the window (from the last call to steady)
+    std::vector<double> drift;
+    //! Relative half-width of the confidence interval for the mean of each series
+    std::vector<double> halfwidth;
+    //! t-statistic for the slope of each series
+    std::vector<double> tstat;
+
+    std::vector<std::string> names;
+    int window;
+    double tolerance;
+    double confidence;
+
+private:
+    double d_slope_critical; // two-sided Student-t critical value for the slope (window-2 dof)
+    double d_mean_critical;  // two-sided Student-t critical value for the mean (window-1 dof)
+    std::vector<std::vector<double>> d_values;
+    std::vector<std::vector<double>> d_scales;
+    std::string d_reason;
+};
+
+#endif
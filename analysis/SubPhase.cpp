@@ -1,4 +1,29 @@
 #include "analysis/SubPhase.h"
+#include "common/BatchedReduction.h"
+
+// Magnitude of the gradient of Phi using central differences.  The interior
+// sites do not depend on the halo and can be computed while the halo exchange
+// is in progress; the remaining layer of sites is computed once it completes.
+static void ComputeDelPhi(const DoubleArray &Phi, DoubleArray &DelPhi,
+                          bool interior) {
+    int Nx = Phi.size(0), Ny = Phi.size(1), Nz = Phi.size(2);
+    for (int k = 1; k < Nz - 1; k++) {
+        for (int j = 1; j < Ny - 1; j++) {
+            bool inner = k > 1 && k < Nz - 2 && j > 1 && j < Ny - 2;
+            if (interior && !inner)
+                continue;
+            int imin = interior ? 2 : 1;
+            int imax = interior ? Nx - 3 : Nx - 2;
+            int step = (interior || !inner) ? 1 : std::max(Nx - 3, 1);
+            for (int i = imin; i <= imax; i += step) {
+                double fx = 0.5 * (Phi(i + 1, j, k) - Phi(i - 1, j, k));
+                double fy = 0.5 * (Phi(i, j + 1, k) - Phi(i, j - 1, k));
+                double fz = 0.5 * (Phi(i, j, k + 1) - Phi(i, j, k - 1));
+                DelPhi(i, j, k) = sqrt(fx * fx + fy * fy + fz * fz);
+            }
+        }
+    }
+}
 
 // Constructor
 SubPhase::SubPhase(std::shared_ptr<Domain> dm) : Dm(dm) {
@@ -210,42 +235,6 @@ void SubPhase::Basic() {
     double count_w = 0.0;
     double count_n = 0.0;
 
-    /* compute the laplacian */
-    Dm->CommunicateMeshHalo(Phi);
-    for (int k = 1; k < Nz - 1; k++) {
-        for (int j = 1; j < Ny - 1; j++) {
-            for (int i = 1; i < Nx - 1; i++) {
-                // Compute all of the derivatives using finite differences
-                double fx = 0.5 * (Phi(i + 1, j, k) - Phi(i - 1, j, k));
-                double fy = 0.5 * (Phi(i, j + 1, k) - Phi(i, j - 1, k));
-                double fz = 0.5 * (Phi(i, j, k + 1) - Phi(i, j, k - 1));
-                DelPhi(i, j, k) = sqrt(fx * fx + fy * fy + fz * fz);
-            }
-        }
-    }
-    Dm->CommunicateMeshHalo(DelPhi);
-
-    for (k = 0; k < Nz; k++) {
-        for (j = 0; j < Ny; j++) {
-            for (i = 0; i < Nx; i++) {
-                n = k * Nx * Ny + j * Nx + i;
-                // Compute volume averages
-                if (Dm->id[n] > 0) {
-                    // compute density
-                    double nA = Rho_n(n);
-                    double nB = Rho_w(n);
-                    double phi = (nA - nB) / (nA + nB);
-                    Phi(n) = phi;
-                }
-                if (Phi(n) != Phi(n)) {
-                    // check for NaN
-                    Phi(n) = 0.0;
-                    //printf("Nan at %i %i %i \n",i,j,k);
-                }
-            }
-        }
-    }
-
     for (k = kmin; k < kmax; k++) {
         for (j = jmin; j < Ny - 1; j++) {
             for (i = imin; i < Nx - 1; i++) {
@@ -306,6 +295,64 @@ void SubPhase::Basic() {
         }
     }
 
+    // The phase averages do not depend on the laplacian, so their reduction
+    // is overlapped with the computation of the wetting interaction
+    BatchedReduction reduction(Dm->Comm);
+    reduction.sum(wb.V, gwb.V);
+    reduction.sum(nb.V, gnb.V);
+    reduction.sum(wb.M, gwb.M);
+    reduction.sum(nb.M, gnb.M);
+    reduction.sum(wb.Px, gwb.Px);
+    reduction.sum(wb.Py, gwb.Py);
+    reduction.sum(wb.Pz, gwb.Pz);
+    reduction.sum(nb.Px, gnb.Px);
+    reduction.sum(nb.Py, gnb.Py);
+    reduction.sum(nb.Pz, gnb.Pz);
+
+    reduction.sum(iwn.Mw, giwn.Mw);
+    reduction.sum(iwn.Pwx, giwn.Pwx);
+    reduction.sum(iwn.Pwy, giwn.Pwy);
+    reduction.sum(iwn.Pwz, giwn.Pwz);
+
+    reduction.sum(iwn.Mn, giwn.Mn);
+    reduction.sum(iwn.Pnx, giwn.Pnx);
+    reduction.sum(iwn.Pny, giwn.Pny);
+    reduction.sum(iwn.Pnz, giwn.Pnz);
+
+    reduction.sum(count_w, count_w);
+    reduction.sum(count_n, count_n);
+    reduction.sum(wb.p, gwb.p);
+    reduction.sum(nb.p, gnb.p);
+    reduction.start();
+
+    /* compute the laplacian */
+    auto halo = Dm->CommunicateMeshHaloStart({&Phi});
+    ComputeDelPhi(Phi, DelPhi, true);
+    halo.finish();
+    ComputeDelPhi(Phi, DelPhi, false);
+    Dm->CommunicateMeshHalo(DelPhi);
+
+    for (k = 0; k < Nz; k++) {
+        for (j = 0; j < Ny; j++) {
+            for (i = 0; i < Nx; i++) {
+                n = k * Nx * Ny + j * Nx + i;
+                // Compute volume averages
+                if (Dm->id[n] > 0) {
+                    // compute density
+                    double nA = Rho_n(n);
+                    double nB = Rho_w(n);
+                    double phi = (nA - nB) / (nA + nB);
+                    Phi(n) = phi;
+                }
+                if (Phi(n) != Phi(n)) {
+                    // check for NaN
+                    Phi(n) = 0.0;
+                    //printf("Nan at %i %i %i \n",i,j,k);
+                }
+            }
+        }
+    }
+
     total_wetting_interaction = count_wetting_interaction = 0.0;
     total_wetting_interaction_global = count_wetting_interaction_global = 0.0;
     for (k = kmin; k < kmax; k++) {
@@ -321,40 +368,16 @@ void SubPhase::Basic() {
         }
     }
 
-    total_wetting_interaction_global =
-        Dm->Comm.sumReduce(total_wetting_interaction);
-    count_wetting_interaction_global =
-        Dm->Comm.sumReduce(count_wetting_interaction);
-
-    gwb.V = Dm->Comm.sumReduce(wb.V);
-    gnb.V = Dm->Comm.sumReduce(nb.V);
-    gwb.M = Dm->Comm.sumReduce(wb.M);
-    gnb.M = Dm->Comm.sumReduce(nb.M);
-    gwb.Px = Dm->Comm.sumReduce(wb.Px);
-    gwb.Py = Dm->Comm.sumReduce(wb.Py);
-    gwb.Pz = Dm->Comm.sumReduce(wb.Pz);
-    gnb.Px = Dm->Comm.sumReduce(nb.Px);
-    gnb.Py = Dm->Comm.sumReduce(nb.Py);
-    gnb.Pz = Dm->Comm.sumReduce(nb.Pz);
-
-    giwn.Mw = Dm->Comm.sumReduce(iwn.Mw);
-    giwn.Pwx = Dm->Comm.sumReduce(iwn.Pwx);
-    giwn.Pwy = Dm->Comm.sumReduce(iwn.Pwy);
-    giwn.Pwz = Dm->Comm.sumReduce(iwn.Pwz);
-
-    giwn.Mn = Dm->Comm.sumReduce(iwn.Mn);
-    giwn.Pnx = Dm->Comm.sumReduce(iwn.Pnx);
-    giwn.Pny = Dm->Comm.sumReduce(iwn.Pny);
-    giwn.Pnz = Dm->Comm.sumReduce(iwn.Pnz);
-
-    count_w = Dm->Comm.sumReduce(count_w);
-    count_n = Dm->Comm.sumReduce(count_n);
+    reduction.finish();
+    reduction.sum(total_wetting_interaction, total_wetting_interaction_global);
+    reduction.sum(count_wetting_interaction, count_wetting_interaction_global);
+    reduction.reduce();
     if (count_w > 0.0)
-        gwb.p = Dm->Comm.sumReduce(wb.p) / count_w;
+        gwb.p /= count_w;
     else
         gwb.p = 0.0;
     if (count_n > 0.0)
-        gnb.p = Dm->Comm.sumReduce(nb.p) / count_n;
+        gnb.p /= count_n;
     else
         gnb.p = 0.0;
 
@@ -545,23 +568,13 @@ void SubPhase::Full() {
     iwnc.reset();
     ifs.reset();
 
-    Dm->CommunicateMeshHalo(Phi);
-    for (int k = 1; k < Nz - 1; k++) {
-        for (int j = 1; j < Ny - 1; j++) {
-            for (int i = 1; i < Nx - 1; i++) {
-                // Compute all of the derivatives using finite differences
-                double fx = 0.5 * (Phi(i + 1, j, k) - Phi(i - 1, j, k));
-                double fy = 0.5 * (Phi(i, j + 1, k) - Phi(i, j - 1, k));
-                double fz = 0.5 * (Phi(i, j, k + 1) - Phi(i, j, k - 1));
-                DelPhi(i, j, k) = sqrt(fx * fx + fy * fy + fz * fz);
-            }
-        }
-    }
+    // The velocity halo is exchanged along with Phi
+    auto halo = Dm->CommunicateMeshHaloStart({&Phi, &Vel_x, &Vel_y, &Vel_z});
+    ComputeDelPhi(Phi, DelPhi, true);
+    halo.finish();
+    ComputeDelPhi(Phi, DelPhi, false);
     Dm->CommunicateMeshHalo(DelPhi);
 
-    Dm->CommunicateMeshHalo(Vel_x);
-    Dm->CommunicateMeshHalo(Vel_y);
-    Dm->CommunicateMeshHalo(Vel_z);
     for (int k = 1; k < Nz - 1; k++) {
         for (int j = 1; j < Ny - 1; j++) {
             for (int i = 1; i < Nx - 1; i++) {
@@ -629,14 +642,15 @@ void SubPhase::Full() {
     nd.X -= nc.X;
 
     // compute global entities
-    gnc.V = Dm->Comm.sumReduce(nc.V);
-    gnc.A = Dm->Comm.sumReduce(nc.A);
-    gnc.H = Dm->Comm.sumReduce(nc.H);
-    gnc.X = Dm->Comm.sumReduce(nc.X);
-    gnd.V = Dm->Comm.sumReduce(nd.V);
-    gnd.A = Dm->Comm.sumReduce(nd.A);
-    gnd.H = Dm->Comm.sumReduce(nd.H);
-    gnd.X = Dm->Comm.sumReduce(nd.X);
+    BatchedReduction reduction(Dm->Comm);
+    reduction.sum(nc.V, gnc.V);
+    reduction.sum(nc.A, gnc.A);
+    reduction.sum(nc.H, gnc.H);
+    reduction.sum(nc.X, gnc.X);
+    reduction.sum(nd.V, gnd.V);
+    reduction.sum(nd.A, gnd.A);
+    reduction.sum(nd.H, gnd.H);
+    reduction.sum(nd.X, gnd.X);
     gnd.Nc = nd.Nc;
     // wetting
     for (k = 0; k < Nz; k++) {
@@ -674,14 +688,14 @@ void SubPhase::Full() {
     wd.H -= wc.H;
     wd.X -= wc.X;
     // compute global entities
-    gwc.V = Dm->Comm.sumReduce(wc.V);
-    gwc.A = Dm->Comm.sumReduce(wc.A);
-    gwc.H = Dm->Comm.sumReduce(wc.H);
-    gwc.X = Dm->Comm.sumReduce(wc.X);
-    gwd.V = Dm->Comm.sumReduce(wd.V);
-    gwd.A = Dm->Comm.sumReduce(wd.A);
-    gwd.H = Dm->Comm.sumReduce(wd.H);
-    gwd.X = Dm->Comm.sumReduce(wd.X);
+    reduction.sum(wc.V, gwc.V);
+    reduction.sum(wc.A, gwc.A);
+    reduction.sum(wc.H, gwc.H);
+    reduction.sum(wc.X, gwc.X);
+    reduction.sum(wd.V, gwd.V);
+    reduction.sum(wd.A, gwd.A);
+    reduction.sum(wd.H, gwd.H);
+    reduction.sum(wd.X, gwd.X);
     gwd.Nc = wd.Nc;
 
     /*  Set up geometric analysis of interface region */
@@ -707,20 +721,20 @@ void SubPhase::Full() {
     iwn.A = morph_i->A();
     iwn.H = morph_i->H();
     iwn.X = morph_i->X();
-    giwn.V = Dm->Comm.sumReduce(iwn.V);
-    giwn.A = Dm->Comm.sumReduce(iwn.A);
-    giwn.H = Dm->Comm.sumReduce(iwn.H);
-    giwn.X = Dm->Comm.sumReduce(iwn.X);
+    reduction.sum(iwn.V, giwn.V);
+    reduction.sum(iwn.A, giwn.A);
+    reduction.sum(iwn.H, giwn.H);
+    reduction.sum(iwn.X, giwn.X);
     // measure only the connected part
     iwnc.Nc = morph_i->MeasureConnectedPathway();
     iwnc.V = morph_i->V();
     iwnc.A = morph_i->A();
     iwnc.H = morph_i->H();
     iwnc.X = morph_i->X();
-    giwnc.V = Dm->Comm.sumReduce(iwnc.V);
-    giwnc.A = Dm->Comm.sumReduce(iwnc.A);
-    giwnc.H = Dm->Comm.sumReduce(iwnc.H);
-    giwnc.X = Dm->Comm.sumReduce(iwnc.X);
+    reduction.sum(iwnc.V, giwnc.V);
+    reduction.sum(iwnc.A, giwnc.A);
+    reduction.sum(iwnc.H, giwnc.H);
+    reduction.sum(iwnc.X, giwnc.X);
     giwnc.Nc = iwnc.Nc;
 
     double vol_nc_bulk = 0.0;
@@ -829,59 +843,59 @@ void SubPhase::Full() {
         }
     }
 
-    gnd.M = Dm->Comm.sumReduce(nd.M);
-    gnd.Px = Dm->Comm.sumReduce(nd.Px);
-    gnd.Py = Dm->Comm.sumReduce(nd.Py);
-    gnd.Pz = Dm->Comm.sumReduce(nd.Pz);
-    gnd.K = Dm->Comm.sumReduce(nd.K);
-    gnd.visc = Dm->Comm.sumReduce(nd.visc);
-
-    gwd.M = Dm->Comm.sumReduce(wd.M);
-    gwd.Px = Dm->Comm.sumReduce(wd.Px);
-    gwd.Py = Dm->Comm.sumReduce(wd.Py);
-    gwd.Pz = Dm->Comm.sumReduce(wd.Pz);
-    gwd.K = Dm->Comm.sumReduce(wd.K);
-    gwd.visc = Dm->Comm.sumReduce(wd.visc);
-
-    gnc.M = Dm->Comm.sumReduce(nc.M);
-    gnc.Px = Dm->Comm.sumReduce(nc.Px);
-    gnc.Py = Dm->Comm.sumReduce(nc.Py);
-    gnc.Pz = Dm->Comm.sumReduce(nc.Pz);
-    gnc.K = Dm->Comm.sumReduce(nc.K);
-    gnc.visc = Dm->Comm.sumReduce(nc.visc);
-
-    gwc.M = Dm->Comm.sumReduce(wc.M);
-    gwc.Px = Dm->Comm.sumReduce(wc.Px);
-    gwc.Py = Dm->Comm.sumReduce(wc.Py);
-    gwc.Pz = Dm->Comm.sumReduce(wc.Pz);
-    gwc.K = Dm->Comm.sumReduce(wc.K);
-    gwc.visc = Dm->Comm.sumReduce(wc.visc);
-
-    giwn.Mn = Dm->Comm.sumReduce(iwn.Mn);
-    giwn.Pnx = Dm->Comm.sumReduce(iwn.Pnx);
-    giwn.Pny = Dm->Comm.sumReduce(iwn.Pny);
-    giwn.Pnz = Dm->Comm.sumReduce(iwn.Pnz);
-    giwn.Kn = Dm->Comm.sumReduce(iwn.Kn);
-    giwn.Mw = Dm->Comm.sumReduce(iwn.Mw);
-    giwn.Pwx = Dm->Comm.sumReduce(iwn.Pwx);
-    giwn.Pwy = Dm->Comm.sumReduce(iwn.Pwy);
-    giwn.Pwz = Dm->Comm.sumReduce(iwn.Pwz);
-    giwn.Kw = Dm->Comm.sumReduce(iwn.Kw);
-
-    gifs.Mn = Dm->Comm.sumReduce(ifs.Mn);
-    gifs.Pnx = Dm->Comm.sumReduce(ifs.Pnx);
-    gifs.Pny = Dm->Comm.sumReduce(ifs.Pny);
-    gifs.Pnz = Dm->Comm.sumReduce(ifs.Pnz);
-    gifs.Mw = Dm->Comm.sumReduce(ifs.Mw);
-    gifs.Pwx = Dm->Comm.sumReduce(ifs.Pwx);
-    gifs.Pwy = Dm->Comm.sumReduce(ifs.Pwy);
-    gifs.Pwz = Dm->Comm.sumReduce(ifs.Pwz);
+    reduction.sum(nd.M, gnd.M);
+    reduction.sum(nd.Px, gnd.Px);
+    reduction.sum(nd.Py, gnd.Py);
+    reduction.sum(nd.Pz, gnd.Pz);
+    reduction.sum(nd.K, gnd.K);
+    reduction.sum(nd.visc, gnd.visc);
+
+    reduction.sum(wd.M, gwd.M);
+    reduction.sum(wd.Px, gwd.Px);
+    reduction.sum(wd.Py, gwd.Py);
+    reduction.sum(wd.Pz, gwd.Pz);
+    reduction.sum(wd.K, gwd.K);
+    reduction.sum(wd.visc, gwd.visc);
+
+    reduction.sum(nc.M, gnc.M);
+    reduction.sum(nc.Px, gnc.Px);
+    reduction.sum(nc.Py, gnc.Py);
+    reduction.sum(nc.Pz, gnc.Pz);
+    reduction.sum(nc.K, gnc.K);
+    reduction.sum(nc.visc, gnc.visc);
+
+    reduction.sum(wc.M, gwc.M);
+    reduction.sum(wc.Px, gwc.Px);
+    reduction.sum(wc.Py, gwc.Py);
+    reduction.sum(wc.Pz, gwc.Pz);
+    reduction.sum(wc.K, gwc.K);
+    reduction.sum(wc.visc, gwc.visc);
+
+    reduction.sum(iwn.Mn, giwn.Mn);
+    reduction.sum(iwn.Pnx, giwn.Pnx);
+    reduction.sum(iwn.Pny, giwn.Pny);
+    reduction.sum(iwn.Pnz, giwn.Pnz);
+    reduction.sum(iwn.Kn, giwn.Kn);
+    reduction.sum(iwn.Mw, giwn.Mw);
+    reduction.sum(iwn.Pwx, giwn.Pwx);
+    reduction.sum(iwn.Pwy, giwn.Pwy);
+    reduction.sum(iwn.Pwz, giwn.Pwz);
+    reduction.sum(iwn.Kw, giwn.Kw);
+
+    reduction.sum(ifs.Mn, gifs.Mn);
+    reduction.sum(ifs.Pnx, gifs.Pnx);
+    reduction.sum(ifs.Pny, gifs.Pny);
+    reduction.sum(ifs.Pnz, gifs.Pnz);
+    reduction.sum(ifs.Mw, gifs.Mw);
+    reduction.sum(ifs.Pwx, gifs.Pwx);
+    reduction.sum(ifs.Pwy, gifs.Pwy);
+    reduction.sum(ifs.Pwz, gifs.Pwz);
 
     // pressure averaging
-    gnc.p = Dm->Comm.sumReduce(nc.p);
-    gnd.p = Dm->Comm.sumReduce(nd.p);
-    gwc.p = Dm->Comm.sumReduce(wc.p);
-    gwd.p = Dm->Comm.sumReduce(wd.p);
+    reduction.sum(nc.p, gnc.p);
+    reduction.sum(nd.p, gnd.p);
+    reduction.sum(wc.p, gwc.p);
+    reduction.sum(wd.p, gwd.p);
 
     if (vol_wc_bulk > 0.0)
         wc.p = wc.p / vol_wc_bulk;
@@ -892,10 +906,11 @@ void SubPhase::Full() {
     if (vol_nd_bulk > 0.0)
         nd.p = nd.p / vol_nd_bulk;
 
-    vol_wc_bulk = Dm->Comm.sumReduce(vol_wc_bulk);
-    vol_wd_bulk = Dm->Comm.sumReduce(vol_wd_bulk);
-    vol_nc_bulk = Dm->Comm.sumReduce(vol_nc_bulk);
-    vol_nd_bulk = Dm->Comm.sumReduce(vol_nd_bulk);
+    reduction.sum(vol_wc_bulk, vol_wc_bulk);
+    reduction.sum(vol_wd_bulk, vol_wd_bulk);
+    reduction.sum(vol_nc_bulk, vol_nc_bulk);
+    reduction.sum(vol_nd_bulk, vol_nd_bulk);
+    reduction.reduce();
 
     if (vol_wc_bulk > 0.0)
         gwc.p = gwc.p / vol_wc_bulk;
@@ -22,6 +22,7 @@
 #include "common/Communication.h"
 #include "common/Utilities.h"
 #include "common/MPI.h"
+#include "common/BatchedReduction.h"
 #include "IO/MeshDatabase.h"
 #include "IO/Reader.h"
 #include "IO/Writer.h"
@@ -407,11 +408,7 @@ void TwoPhase::UpdateSolid() {
     //...........................................................................
     pmmc_MeshGradient(SDs, SDs_x, SDs_y, SDs_z, Nx, Ny, Nz);
     //...........................................................................
-    Dm->CommunicateMeshHalo(SDs_x);
-    //...........................................................................
-    Dm->CommunicateMeshHalo(SDs_y);
-    //...........................................................................
-    Dm->CommunicateMeshHalo(SDs_z);
+    Dm->CommunicateMeshHalo({&SDs_x, &SDs_y, &SDs_z});
     //...........................................................................
 }
 
@@ -419,6 +416,9 @@ void TwoPhase::UpdateMeshValues() {
     int i, j, k, n;
     fillHalo<double> fillData(Dm->Comm, Dm->rank_info, {Nx-2,Ny-2,Nz-2}, {1, 1, 1}, 0, 1);
 
+    // The pressure, velocity and DelPhi halos are exchanged while the gradients are computed
+    auto halo = Dm->CommunicateMeshHaloStart({&Press, &Vel_x, &Vel_y, &Vel_z, &DelPhi});
+
     //...........................................................................
     //Dm->CommunicateMeshHalo(SDn);
     fillData.fill(SDn);
@@ -458,19 +458,9 @@ void TwoPhase::UpdateMeshValues() {
     for (int n = 0; n < Nx * Ny * Nz; n++)
         dPdt(n) = 0.125 * (Phase_tplus(n) - Phase_tminus(n));
     //...........................................................................
-    Dm->CommunicateMeshHalo(Press);
-    //...........................................................................
-    Dm->CommunicateMeshHalo(Vel_x);
-    //...........................................................................
-    Dm->CommunicateMeshHalo(Vel_y);
-    //...........................................................................
-    Dm->CommunicateMeshHalo(Vel_z);
+    halo.finish();
     //...........................................................................
-    Dm->CommunicateMeshHalo(MeanCurvature);
-    //...........................................................................
-    Dm->CommunicateMeshHalo(GaussCurvature);
-    //...........................................................................
-    Dm->CommunicateMeshHalo(DelPhi);
+    Dm->CommunicateMeshHalo({&MeanCurvature, &GaussCurvature});
     //...........................................................................
     // Initializing the blob ID
     for (k = 0; k < Nz; k++) {
@@ -1341,13 +1331,13 @@ void TwoPhase::ComponentAverages() {
         printf("reduce WP averages... \n");
     }
 
-    // reduce the wetting phase averages
+    // reduce the wetting phase averages (all components in one reduction)
+    RecvBuffer.resize(BLOB_AVG_COUNT, NumberComponents_WP);
+    Dm->Comm.sumReduce(ComponentAverages_WP.data(), RecvBuffer.data(),
+                       BLOB_AVG_COUNT * NumberComponents_WP);
     for (int b = 0; b < NumberComponents_WP; b++) {
-        Dm->Comm.barrier();
-        Dm->Comm.sumReduce(&ComponentAverages_WP(0, b), RecvBuffer.data(),
-                           BLOB_AVG_COUNT);
         for (int idx = 0; idx < BLOB_AVG_COUNT; idx++)
-            ComponentAverages_WP(idx, b) = RecvBuffer(idx);
+            ComponentAverages_WP(idx, b) = RecvBuffer(idx, b);
     }
 
     for (int b = 0; b < NumberComponents_WP; b++) {
@@ -1430,52 +1420,51 @@ void TwoPhase::Reduce() {
     int i;
     //double iVol_global = 1.0 / Volume;
     //...........................................................................
-    Dm->Comm.barrier();
-    nwp_volume_global = Dm->Comm.sumReduce(nwp_volume);
-    wp_volume_global = Dm->Comm.sumReduce(wp_volume);
-    awn_global = Dm->Comm.sumReduce(awn);
-    ans_global = Dm->Comm.sumReduce(ans);
-    aws_global = Dm->Comm.sumReduce(aws);
-    lwns_global = Dm->Comm.sumReduce(lwns);
-    As_global = Dm->Comm.sumReduce(As);
-    Jwn_global = Dm->Comm.sumReduce(Jwn);
-    Kwn_global = Dm->Comm.sumReduce(Kwn);
-    KGwns_global = Dm->Comm.sumReduce(KGwns);
-    KNwns_global = Dm->Comm.sumReduce(KNwns);
-    efawns_global = Dm->Comm.sumReduce(efawns);
-    wwndnw_global = Dm->Comm.sumReduce(wwndnw);
-    wwnsdnwn_global = Dm->Comm.sumReduce(wwnsdnwn);
-    Jwnwwndnw_global = Dm->Comm.sumReduce(Jwnwwndnw);
+    BatchedReduction reduction(Dm->Comm);
+    reduction.sum(nwp_volume, nwp_volume_global);
+    reduction.sum(wp_volume, wp_volume_global);
+    reduction.sum(awn, awn_global);
+    reduction.sum(ans, ans_global);
+    reduction.sum(aws, aws_global);
+    reduction.sum(lwns, lwns_global);
+    reduction.sum(As, As_global);
+    reduction.sum(Jwn, Jwn_global);
+    reduction.sum(Kwn, Kwn_global);
+    reduction.sum(KGwns, KGwns_global);
+    reduction.sum(KNwns, KNwns_global);
+    reduction.sum(efawns, efawns_global);
+    reduction.sum(wwndnw, wwndnw_global);
+    reduction.sum(wwnsdnwn, wwnsdnwn_global);
+    reduction.sum(Jwnwwndnw, Jwnwwndnw_global);
     // Phase averages
-    vol_w_global = Dm->Comm.sumReduce(vol_w);
-    vol_n_global = Dm->Comm.sumReduce(vol_n);
-    paw_global = Dm->Comm.sumReduce(paw);
-    pan_global = Dm->Comm.sumReduce(pan);
+    reduction.sum(vol_w, vol_w_global);
+    reduction.sum(vol_n, vol_n_global);
+    reduction.sum(paw, paw_global);
+    reduction.sum(pan, pan_global);
     for (int idx = 0; idx < 3; idx++)
-        vaw_global(idx) = Dm->Comm.sumReduce(vaw(idx));
+        reduction.sum(vaw(idx), vaw_global(idx));
     for (int idx = 0; idx < 3; idx++)
-        van_global(idx) = Dm->Comm.sumReduce(van(idx));
+        reduction.sum(van(idx), van_global(idx));
     for (int idx = 0; idx < 3; idx++)
-        vawn_global(idx) = Dm->Comm.sumReduce(vawn(idx));
+        reduction.sum(vawn(idx), vawn_global(idx));
     for (int idx = 0; idx < 3; idx++)
-        vawns_global(idx) = Dm->Comm.sumReduce(vawns(idx));
+        reduction.sum(vawns(idx), vawns_global(idx));
     for (int idx = 0; idx < 6; idx++) {
-        Gwn_global(idx) = Dm->Comm.sumReduce(Gwn(idx));
-        Gns_global(idx) = Dm->Comm.sumReduce(Gns(idx));
-        Gws_global(idx) = Dm->Comm.sumReduce(Gws(idx));
+        reduction.sum(Gwn(idx), Gwn_global(idx));
+        reduction.sum(Gns(idx), Gns_global(idx));
+        reduction.sum(Gws(idx), Gws_global(idx));
     }
-    trawn_global = Dm->Comm.sumReduce(trawn);
-    trJwn_global = Dm->Comm.sumReduce(trJwn);
-    trRwn_global = Dm->Comm.sumReduce(trRwn);
-    Xwn_global = Dm->Comm.sumReduce(Xwn);
-    Xws_global = Dm->Comm.sumReduce(Xws);
-    Xns_global = Dm->Comm.sumReduce(Xns);
-    An_global = Dm->Comm.sumReduce(An);
-    Jn_global = Dm->Comm.sumReduce(Jn);
-    Kn_global = Dm->Comm.sumReduce(Kn);
-    euler_global = Dm->Comm.sumReduce(euler);
-
-    Dm->Comm.barrier();
+    reduction.sum(trawn, trawn_global);
+    reduction.sum(trJwn, trJwn_global);
+    reduction.sum(trRwn, trRwn_global);
+    reduction.sum(Xwn, Xwn_global);
+    reduction.sum(Xws, Xws_global);
+    reduction.sum(Xns, Xns_global);
+    reduction.sum(An, An_global);
+    reduction.sum(Jn, Jn_global);
+    reduction.sum(Kn, Kn_global);
+    reduction.sum(euler, euler_global);
+    reduction.reduce();
 
     // Normalize the phase averages
     // (density of both components = 1.0)
@@ -823,8 +823,8 @@ void renumberIDs(const std::vector<BlobIDType> &new_ids, BlobIDArray &IDs) {
 * Write the id map for the given timestep                         *
 ******************************************************************/
 void writeIDMap(const ID_map_struct &map, long long int timestep,
-                const std::string &filename) {
-    int rank = Utilities::MPI(MPI_COMM_WORLD).getRank();
+                const std::string &filename, const Utilities::MPI &comm) {
+    int rank = comm.getRank();
     if (rank != 0)
         return;
     bool empty = map.created.empty() && map.destroyed.empty() &&
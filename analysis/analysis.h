@@ -177,8 +177,10 @@ void renumberIDs(const std::vector<BlobIDType> &new_ids, BlobIDArray &IDs);
  * @param[in] map           The timestep mapping for the ids
  * @param[in] timestep      The current timestep (timestep 0 creates the file)
  * @param[in] filename      The filename to write/append
+ * @param[in] comm          Communicator for the domain
  */
 void writeIDMap(const ID_map_struct &map, long long int timestep,
-                const std::string &filename);
+                const std::string &filename,
+                const Utilities::MPI &comm = MPI_COMM_WORLD);
 
 #endif
@@ -15,6 +15,185 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "analysis/distance.h"
+#include "ProfilerApp.h"
+
+#include <limits>
+#include <vector>
+
+/******************************************************************
+* Exact Euclidean distance transform                              *
+* Lower envelope of parabolas along a line                        *
+* (Felzenszwalb and Huttenlocher, 2012)                           *
+* The parabola for site q is centered at q + shift                *
+******************************************************************/
+static void edtLine(const double *f, double *d, int L, double h2,
+                    double shift, bool periodic, std::vector<double> &pos,
+                    std::vector<double> &val, std::vector<double> &z) {
+    const double inf = std::numeric_limits<double>::infinity();
+    // Periodic images within half a period can be the nearest site
+    int ext = periodic ? L / 2 + 1 : 0;
+    int k = -1;
+    int index = ((-ext % L) + L) % L;
+    for (int q = -ext; q < L + ext; q++, index++) {
+        if (index == L)
+            index = 0;
+        double fq = f[index];
+        if (fq == inf)
+            continue;
+        double p = q + shift;
+        double s = -inf;
+        while (k >= 0) {
+            s = ((fq + h2 * p * p) - (val[k] + h2 * pos[k] * pos[k])) /
+                (2.0 * h2 * (p - pos[k]));
+            if (s > z[k])
+                break;
+            k--;
+        }
+        k++;
+        pos[k] = p;
+        val[k] = fq;
+        z[k] = k == 0 ? -inf : s;
+        z[k + 1] = inf;
+    }
+    if (k < 0) {
+        // No sites on this line
+        for (int x = 0; x < L; x++)
+            d[x] = inf;
+        return;
+    }
+    k = 0;
+    for (int x = 0; x < L; x++) {
+        while (z[k + 1] < x)
+            k++;
+        d[x] = h2 * (x - pos[k]) * (x - pos[k]) + val[k];
+    }
+}
+
+/******************************************************************
+* Exact Euclidean distance transform                              *
+* Squared distance along a line to the nearest face of a site     *
+* For q < x the distance is (x - q - 1/2) h and for q > x it is   *
+* (q - x - 1/2) h, so the result is the lower of the transforms   *
+* with the parabolas shifted by +1/2 and -1/2 (each of which      *
+* overestimates the distance on the other side)                   *
+******************************************************************/
+static void edtLineFace(const double *f, double *d, int L, double h2,
+                        bool periodic, std::vector<double> &pos,
+                        std::vector<double> &val, std::vector<double> &z,
+                        std::vector<double> &tmp) {
+    edtLine(f, d, L, h2, 0.5, periodic, pos, val, z);
+    edtLine(f, tmp.data(), L, h2, -0.5, periodic, pos, val, z);
+    for (int x = 0; x < L; x++)
+        d[x] = std::min(std::min(d[x], tmp[x]), f[x]);
+}
+
+/******************************************************************
+* Exact Euclidean distance transform                              *
+* Transform the lines along one axis of the global domain         *
+* The lines are transposed across the processors along the axis   *
+* so that each processor transforms complete lines                *
+******************************************************************/
+static void edtAxis(std::vector<Array<double>> &f, int axis,
+                    const Utilities::MPI &comm, double h, bool periodic) {
+    int n[3] = {(int)f[0].size(0), (int)f[0].size(1), (int)f[0].size(2)};
+    int nf = f.size();
+    int na = n[axis];
+    int stride = axis == 0 ? 1 : (axis == 1 ? n[0] : n[0] * n[1]);
+    int M = n[0] * n[1] * n[2] / na; // number of local lines
+    int P = comm.getSize();
+    int L = P * na;
+    auto base = [stride, na](int m) {
+        return (m % stride) + (m / stride) * stride * na;
+    };
+    // Each processor transforms a contiguous chunk of the lines
+    auto first = [M, P](int q) { return (int)(((int64_t)M * q) / P); };
+    int rank = comm.getRank();
+    int m0 = first(rank);
+    int m1 = first(rank + 1);
+    std::vector<int> send_cnt(P), send_disp(P), recv_cnt(P), recv_disp(P);
+    for (int q = 0; q < P; q++) {
+        send_cnt[q] = nf * (first(q + 1) - first(q)) * na;
+        send_disp[q] = nf * first(q) * na;
+        recv_cnt[q] = nf * (m1 - m0) * na;
+        recv_disp[q] = q * recv_cnt[q];
+    }
+    // Pack the local segments of each line
+    std::vector<double> send(nf * M * na), recv(nf * (m1 - m0) * L);
+    for (int q = 0, p = 0; q < P; q++) {
+        for (int m = first(q); m < first(q + 1); m++) {
+            for (int v = 0; v < nf; v++) {
+                const double *data = f[v].data() + base(m);
+                for (int t = 0; t < na; t++)
+                    send[p++] = data[t * stride];
+            }
+        }
+    }
+    if (P > 1)
+        comm.allToAll(send.data(), send_cnt.data(), send_disp.data(),
+                      recv.data(), recv_cnt.data(), recv_disp.data(), true);
+    else
+        recv.swap(send);
+    // Transform the complete lines
+    std::vector<double> line(L), result(L), tmp(L);
+    std::vector<double> pos(L + 2 * (L / 2 + 1)), val(pos.size()),
+        z(pos.size() + 1);
+    for (int m = 0; m < m1 - m0; m++) {
+        for (int v = 0; v < nf; v++) {
+            for (int q = 0; q < P; q++) {
+                double *segment =
+                    &recv[recv_disp[q] + (m * nf + v) * na];
+                for (int t = 0; t < na; t++)
+                    line[q * na + t] = segment[t];
+            }
+            edtLineFace(line.data(), result.data(), L, h * h, periodic, pos,
+                        val, z, tmp);
+            for (int q = 0; q < P; q++) {
+                double *segment =
+                    &recv[recv_disp[q] + (m * nf + v) * na];
+                for (int t = 0; t < na; t++)
+                    segment[t] = result[q * na + t];
+            }
+        }
+    }
+    // Return the transformed segments
+    if (P > 1)
+        comm.allToAll(recv.data(), recv_cnt.data(), recv_disp.data(),
+                      send.data(), send_cnt.data(), send_disp.data(), true);
+    else
+        send.swap(recv);
+    for (int q = 0, p = 0; q < P; q++) {
+        for (int m = first(q); m < first(q + 1); m++) {
+            for (int v = 0; v < nf; v++) {
+                double *data = f[v].data() + base(m);
+                for (int t = 0; t < na; t++)
+                    data[t * stride] = send[p++];
+            }
+        }
+    }
+}
+
+/******************************************************************
+* Exact Euclidean distance transform                              *
+******************************************************************/
+static void edtTransform(std::vector<Array<double>> &f, const Domain &Dm,
+                         const std::array<bool, 3> &periodic,
+                         const std::array<double, 3> &dx) {
+    int nproc[3] = {Dm.nprocx(), Dm.nprocy(), Dm.nprocz()};
+    int iproc[3] = {Dm.iproc(), Dm.jproc(), Dm.kproc()};
+    for (int axis = 0; axis < 3; axis++) {
+        // Processors that share the lines along the axis
+        int a = (axis + 1) % 3;
+        int b = (axis + 2) % 3;
+        if (nproc[axis] > 1) {
+            auto comm = Dm.Comm.split(iproc[a] + iproc[b] * nproc[a],
+                                      iproc[axis]);
+            edtAxis(f, axis, comm, dx[axis], periodic[axis]);
+        } else {
+            edtAxis(f, axis, Utilities::MPI(MPI_COMM_SELF), dx[axis],
+                    periodic[axis]);
+        }
+    }
+}
 
 /******************************************************************
 * A fast distance calculation                                     *
@@ -24,6 +203,54 @@ void CalcDist(Array<TYPE> &Distance, const Array<char> &ID, const Domain &Dm,
               const std::array<bool, 3> &periodic,
               const std::array<double, 3> &dx) {
     ASSERT(Distance.size() == ID.size());
+    PROFILE_START("CalcDist");
+    int Nx = Dm.Nx, Ny = Dm.Ny, Nz = Dm.Nz;
+    const double inf = std::numeric_limits<double>::infinity();
+    // Squared distance to the nearest face of a cell in the solid (0) and
+    // of a cell in the pore space (1)
+    std::vector<Array<double>> f(2, Array<double>(Nx - 2, Ny - 2, Nz - 2));
+    for (int k = 1; k < Nz - 1; k++) {
+        for (int j = 1; j < Ny - 1; j++) {
+            for (int i = 1; i < Nx - 1; i++) {
+                bool solid = ID(i, j, k) == 0;
+                f[0](i - 1, j - 1, k - 1) = solid ? 0 : inf;
+                f[1](i - 1, j - 1, k - 1) = solid ? inf : 0;
+            }
+        }
+    }
+    edtTransform(f, Dm, periodic, dx);
+    const TYPE big = std::numeric_limits<TYPE>::max();
+    for (int k = 0; k < Nz; k++) {
+        for (int j = 0; j < Ny; j++) {
+            for (int i = 0; i < Nx; i++) {
+                // Ghost cells take the value of the nearest interior cell
+                int i0 = std::min(std::max(i, 1), Nx - 2) - 1;
+                int j0 = std::min(std::max(j, 1), Ny - 2) - 1;
+                int k0 = std::min(std::max(k, 1), Nz - 2) - 1;
+                double d0 = f[0](i0, j0, k0);
+                double d1 = f[1](i0, j0, k0);
+                if (d0 == 0)
+                    Distance(i, j, k) = d1 == inf ? -big : -sqrt(d1);
+                else
+                    Distance(i, j, k) = d0 == inf ? big : sqrt(d0);
+            }
+        }
+    }
+    std::array<int, 3> n = {Nx - 2, Ny - 2, Nz - 2};
+    fillHalo<TYPE> fillData(Dm.Comm, Dm.rank_info, n, {1, 1, 1}, 50, 1,
+                            {true, true, true}, periodic);
+    fillData.fill(Distance);
+    PROFILE_STOP("CalcDist");
+}
+
+/******************************************************************
+* An iterative distance calculation                               *
+******************************************************************/
+template <class TYPE>
+void CalcDistIterative(Array<TYPE> &Distance, const Array<char> &ID,
+                       const Domain &Dm, const std::array<bool, 3> &periodic,
+                       const std::array<double, 3> &dx) {
+    ASSERT(Distance.size() == ID.size());
     std::array<int, 3> n = {Dm.Nx - 2, Dm.Ny - 2, Dm.Nz - 2};
     fillHalo<int> fillData(Dm.Comm, Dm.rank_info, n, {1, 1, 1}, 50, 1,
                            {true, false, false}, periodic);
@@ -208,3 +435,11 @@ template void CalcDist<float>(Array<float> &, const Array<char> &,
 template void CalcDist<double>(Array<double> &, const Array<char> &,
                                const Domain &, const std::array<bool, 3> &,
                                const std::array<double, 3> &);
+template void CalcDistIterative<float>(Array<float> &, const Array<char> &,
+                                       const Domain &,
+                                       const std::array<bool, 3> &,
+                                       const std::array<double, 3> &);
+template void CalcDistIterative<double>(Array<double> &, const Array<char> &,
+                                        const Domain &,
+                                        const std::array<bool, 3> &,
+                                        const std::array<double, 3> &);
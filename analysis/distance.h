@@ -35,8 +35,14 @@ inline bool operator<(const Vec &l, const Vec &r) {
 }
 
 /*!
- * @brief  Calculate the distance using a simple method
- * @details  This routine calculates the vector distance to the nearest domain surface.
+ * @brief  Calculate the signed distance using an exact transform
+ * @details  This routine calculates the signed distance to the nearest domain surface
+ *    (positive where ID is non-zero).  The distance is measured from the cell center to
+ *    the nearest face of a cell of the other phase: 0.5*dx across a face,
+ *    sqrt(0.25*dx^2+0.25*dy^2) across an edge, and so on.  It is computed exactly with a
+ *    separable transform, exchanging whole lines between the processors along each axis.
+ *    Cells with no cell of the other phase in the domain are set to
+ *    +/- std::numeric_limits<TYPE>::max().
  * @param[out] Distance     Distance function
  * @param[in] ID            Segmentation id
  * @param[in] Dm            Domain information
@@ -48,6 +54,21 @@ void CalcDist(Array<TYPE> &Distance, const Array<char> &ID, const Domain &Dm,
               const std::array<bool, 3> &periodic = {true, true, true},
               const std::array<double, 3> &dx = {1, 1, 1});
 
+/*!
+ * @brief  Calculate the distance using a simple method
+ * @details  This routine calculates the vector distance to the nearest domain surface
+ *    by repeated sweeps, exchanging the halo until the distance converges.
+ * @param[out] Distance     Distance function
+ * @param[in] ID            Segmentation id
+ * @param[in] Dm            Domain information
+ * @param[in] periodic      Directions that are periodic
+ * @param[in] dx            Cell size
+ */
+template <class TYPE>
+void CalcDistIterative(Array<TYPE> &Distance, const Array<char> &ID, const Domain &Dm,
+              const std::array<bool, 3> &periodic = {true, true, true},
+              const std::array<double, 3> &dx = {1, 1, 1});
+
 /*!
  * @brief  Calculate the distance using a simple method
  * @details  This routine calculates the vector distance to the nearest domain surface.
@@ -1,6 +1,10 @@
 #include <analysis/morphology.h>
 // Implementation of morphological opening routine
 
+#include <functional>
+#include <map>
+#include <queue>
+
 inline void PackID(const int *list, int count, signed char *sendbuf,
                    signed char *ID) {
     // Fill in the phase ID values from neighboring processors
@@ -700,7 +704,7 @@ double MorphDrain(DoubleArray &SignDist, signed char *id,
     Dm->Comm.barrier();
 
     FILE *DRAIN = fopen("morphdrain.csv", "w");
-    fprintf(DRAIN, "sw radius\n");
+    fprintf(DRAIN, "sw,radius\n");
 
     while (void_fraction_new > VoidFraction && Rcrit_new > 0.5) {
         void_fraction_diff_old = void_fraction_diff_new;
@@ -805,7 +809,7 @@ double MorphDrain(DoubleArray &SignDist, signed char *id,
         void_fraction_new = countGlobal / totalGlobal;
         void_fraction_diff_new = abs(void_fraction_new - VoidFraction);
         if (rank == 0) {
-            fprintf(DRAIN, "%f ", void_fraction_new);
+            fprintf(DRAIN, "%f,", void_fraction_new);
             fprintf(DRAIN, "%f\n", Rcrit_new);
             printf("     %f ", void_fraction_new);
             printf("     %f\n", Rcrit_new);
@@ -954,3 +958,343 @@ double MorphGrow(DoubleArray &BoundaryDist, DoubleArray &Dist, Array<char> &id,
 
     return count;
 }
+
+//***************************************************************************************
+MorphologyCurve::MorphologyCurve() {}
+
+MorphologyCurve::~MorphologyCurve() {}
+
+void MorphologyCurve::Open(std::shared_ptr<Domain> Dm,
+                           const DoubleArray &SignDist, const signed char *id,
+                           signed char ErodeLabel) {
+    d_Dm = Dm;
+    int Nx = Dm->Nx;
+    int Ny = Dm->Ny;
+    int Nz = Dm->Nz;
+    d_mask.resize(Nx, Ny, Nz);
+    for (int n = 0; n < Nx * Ny * Nz; n++)
+        d_mask(n) = id[n] == ErodeLabel ? 1 : 0;
+    // Sites within the critical radius of any site further than the critical radius from the boundary
+    LocalThickness(SignDist, 0.0, 1e100);
+    ComputeCurve();
+}
+
+void MorphologyCurve::Drain(std::shared_ptr<Domain> Dm,
+                            const DoubleArray &SignDist, double MaxRadius) {
+    d_Dm = Dm;
+    int Nx = Dm->Nx;
+    int Ny = Dm->Ny;
+    int Nz = Dm->Nz;
+    d_mask.resize(Nx, Ny, Nz);
+    for (int n = 0; n < Nx * Ny * Nz; n++)
+        d_mask(n) = SignDist(n) > 0.0 ? 1 : 0;
+    // MorphDrain grows the spheres by one voxel
+    LocalThickness(SignDist, 1.0, MaxRadius);
+    Connect();
+    ComputeCurve();
+}
+
+/*
+ * Largest critical radius that erodes each site.  A site is eroded at critical radius R if it is
+ * inside the sphere (with radius SignDist+reach) centered on any site with SignDist > R, so the
+ * critical radius is the largest SignDist of any sphere that contains the site.  The spheres are
+ * sent to every sub-domain that they overlap.
+ */
+void MorphologyCurve::LocalThickness(const DoubleArray &SignDist, double reach,
+                                     double MaxRadius) {
+    int Nx = d_Dm->Nx;
+    int Ny = d_Dm->Ny;
+    int Nz = d_Dm->Nz;
+    int n[3] = {Nx - 2, Ny - 2, Nz - 2};
+    int nproc[3] = {d_Dm->nprocx(), d_Dm->nprocy(), d_Dm->nprocz()};
+    int iproc[3] = {d_Dm->iproc(), d_Dm->jproc(), d_Dm->kproc()};
+    int nprocs = d_Dm->Comm.getSize();
+    auto radius = [&SignDist, MaxRadius](int i, int j, int k) {
+        return std::min(SignDist(i, j, k), MaxRadius);
+    };
+
+    // Find the spheres that are not contained in the sphere of a neighbor
+    std::vector<std::vector<double>> sendList(nprocs);
+    for (int k = 1; k < Nz - 1; k++) {
+        for (int j = 1; j < Ny - 1; j++) {
+            for (int i = 1; i < Nx - 1; i++) {
+                double d = radius(i, j, k);
+                if (d <= 0.0)
+                    continue;
+                bool contained = false;
+                for (int q = 0; q < 27 && !contained; q++) {
+                    int di = q % 3 - 1;
+                    int dj = (q / 3) % 3 - 1;
+                    int dk = q / 9 - 1;
+                    if (q == 13)
+                        continue;
+                    double dist = sqrt(double(di * di + dj * dj + dk * dk));
+                    contained = radius(i + di, j + dj, k + dk) >= d + dist;
+                }
+                if (contained)
+                    continue;
+                // Send the sphere to the sub-domains that it overlaps
+                double g[3] = {double(iproc[0] * n[0] + i - 1),
+                               double(iproc[1] * n[1] + j - 1),
+                               double(iproc[2] * n[2] + k - 1)};
+                double r = d + reach;
+                int lo[3], hi[3];
+                for (int a = 0; a < 3; a++) {
+                    lo[a] = (int)floor((g[a] - r) / n[a]);
+                    hi[a] = (int)floor((g[a] + r) / n[a]);
+                    if (hi[a] - lo[a] + 1 >= nproc[a]) {
+                        lo[a] = 0;
+                        hi[a] = nproc[a] - 1;
+                    }
+                }
+                for (int pk = lo[2]; pk <= hi[2]; pk++) {
+                    for (int pj = lo[1]; pj <= hi[1]; pj++) {
+                        for (int pi = lo[0]; pi <= hi[0]; pi++) {
+                            int rank = d_Dm->rank_info.getRankForBlock(
+                                (pi % nproc[0] + nproc[0]) % nproc[0],
+                                (pj % nproc[1] + nproc[1]) % nproc[1],
+                                (pk % nproc[2] + nproc[2]) % nproc[2]);
+                            auto &list = sendList[rank];
+                            list.insert(list.end(), {g[0], g[1], g[2], d});
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::vector<int> send_cnt(nprocs), send_disp(nprocs), recv_cnt(nprocs),
+        recv_disp(nprocs);
+    for (int p = 0; p < nprocs; p++)
+        send_cnt[p] = sendList[p].size();
+    d_Dm->Comm.allToAll(1, send_cnt.data(), recv_cnt.data());
+    std::vector<double> sendbuf;
+    int recvSize = 0;
+    for (int p = 0; p < nprocs; p++) {
+        send_disp[p] = sendbuf.size();
+        sendbuf.insert(sendbuf.end(), sendList[p].begin(), sendList[p].end());
+        recv_disp[p] = recvSize;
+        recvSize += recv_cnt[p];
+    }
+    std::vector<double> recvbuf(recvSize);
+    d_Dm->Comm.allToAll(sendbuf.data(), send_cnt.data(), send_disp.data(),
+                        recvbuf.data(), recv_cnt.data(), recv_disp.data(),
+                        true);
+
+    // Paint the spheres (including periodic images) on the local sites
+    InvasionRadius.resize(Nx, Ny, Nz);
+    InvasionRadius.fill(0.0);
+    struct Range {
+        double c;
+        int lo, hi;
+    };
+    std::vector<Range> range[3];
+    for (int s = 0; s < recvSize; s += 4) {
+        double d = recvbuf[s + 3];
+        double r = d + reach;
+        for (int a = 0; a < 3; a++) {
+            range[a].clear();
+            int G = nproc[a] * n[a];
+            for (int shift = -G; shift <= G; shift += G) {
+                double c = recvbuf[s + a] + shift - iproc[a] * n[a] + 1;
+                int lo = std::max(1, (int)ceil(c - r));
+                int hi = std::min(n[a], (int)floor(c + r));
+                if (lo <= hi)
+                    range[a].push_back({c, lo, hi});
+            }
+        }
+        for (const auto &rz : range[2]) {
+            for (const auto &ry : range[1]) {
+                for (const auto &rx : range[0]) {
+                    for (int k = rz.lo; k <= rz.hi; k++) {
+                        for (int j = ry.lo; j <= ry.hi; j++) {
+                            for (int i = rx.lo; i <= rx.hi; i++) {
+                                double dsq = (i - rx.c) * (i - rx.c) +
+                                             (j - ry.c) * (j - ry.c) +
+                                             (k - rz.c) * (k - rz.c);
+                                if (dsq < r * r && d_mask(i, j, k) &&
+                                    InvasionRadius(i, j, k) < d)
+                                    InvasionRadius(i, j, k) = d;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Restrict the invasion to sites connected to the inlet.  A site is invaded at critical radius R
+ * if there is a path from the inlet through sites with InvasionRadius > R, so the invasion radius
+ * is the largest minimum along any path.  This is computed with a priority flood on each
+ * sub-domain, exchanging the halo until no sub-domain changes.
+ */
+void MorphologyCurve::Connect() {
+    int Nx = d_Dm->Nx;
+    int Ny = d_Dm->Ny;
+    int Nz = d_Dm->Nz;
+    const DoubleArray &T = InvasionRadius;
+    DoubleArray I(Nx, Ny, Nz);
+    I.fill(0.0);
+    std::priority_queue<std::pair<double, int>> queue;
+    auto relax = [&](int n, double value) {
+        value = std::min(value, T(n));
+        if (value > I(n)) {
+            I(n) = value;
+            queue.push(std::make_pair(value, n));
+            return true;
+        }
+        return false;
+    };
+    auto flood = [&]() {
+        while (!queue.empty()) {
+            auto top = queue.top();
+            queue.pop();
+            int n = top.second;
+            if (top.first < I(n))
+                continue;
+            int i = n % Nx;
+            int j = (n / Nx) % Ny;
+            int k = n / (Nx * Ny);
+            if (i > 1)
+                relax(n - 1, top.first);
+            if (i < Nx - 2)
+                relax(n + 1, top.first);
+            if (j > 1)
+                relax(n - Nx, top.first);
+            if (j < Ny - 2)
+                relax(n + Nx, top.first);
+            if (k > 1)
+                relax(n - Nx * Ny, top.first);
+            if (k < Nz - 2)
+                relax(n + Nx * Ny, top.first);
+        }
+    };
+    // The inlet is the source
+    if (d_Dm->kproc() == 0) {
+        for (int j = 1; j < Ny - 1; j++) {
+            for (int i = 1; i < Nx - 1; i++)
+                relax(Nx * Ny + j * Nx + i, 1e100);
+        }
+    }
+    flood();
+    fillHalo<double> fillData(d_Dm->Comm, d_Dm->rank_info,
+                              {Nx - 2, Ny - 2, Nz - 2}, {1, 1, 1}, 0, 1,
+                              {true, false, false}, {true, true, false});
+    while (true) {
+        fillData.fill(I);
+        int changed = 0;
+        for (int k = 1; k < Nz - 1; k++) {
+            for (int j = 1; j < Ny - 1; j++) {
+                for (int i = 1; i < Nx - 1; i++) {
+                    int n = k * Nx * Ny + j * Nx + i;
+                    if (i == 1)
+                        changed += relax(n, I(n - 1));
+                    if (i == Nx - 2)
+                        changed += relax(n, I(n + 1));
+                    if (j == 1)
+                        changed += relax(n, I(n - Nx));
+                    if (j == Ny - 2)
+                        changed += relax(n, I(n + Nx));
+                    if (k == 1)
+                        changed += relax(n, I(n - Nx * Ny));
+                    if (k == Nz - 2)
+                        changed += relax(n, I(n + Nx * Ny));
+                }
+            }
+        }
+        changed = d_Dm->Comm.sumReduce(changed);
+        if (changed == 0)
+            break;
+        flood();
+    }
+    InvasionRadius = I;
+}
+
+void MorphologyCurve::ComputeCurve() {
+    int Nx = d_Dm->Nx;
+    int Ny = d_Dm->Ny;
+    int Nz = d_Dm->Nz;
+    // Count the sites eroded at each critical radius
+    std::map<double, double> localCount;
+    double count = 0.0;
+    for (int k = 1; k < Nz - 1; k++) {
+        for (int j = 1; j < Ny - 1; j++) {
+            for (int i = 1; i < Nx - 1; i++) {
+                if (!d_mask(i, j, k))
+                    continue;
+                count += 1.0;
+                if (InvasionRadius(i, j, k) > 0.0)
+                    localCount[InvasionRadius(i, j, k)] += 1.0;
+            }
+        }
+    }
+    double total = d_Dm->Comm.sumReduce(count);
+    std::vector<double> values, counts;
+    for (const auto &tmp : localCount) {
+        values.push_back(tmp.first);
+        counts.push_back(tmp.second);
+    }
+    values = d_Dm->Comm.allGather(values);
+    counts = d_Dm->Comm.allGather(counts);
+    std::map<double, double, std::greater<double>> globalCount;
+    for (size_t p = 0; p < values.size(); p++)
+        globalCount[values[p]] += counts[p];
+    // Void fraction as the critical radius decreases
+    radius.clear();
+    void_fraction.clear();
+    double eroded = 0.0;
+    for (const auto &tmp : globalCount) {
+        eroded += tmp.second;
+        radius.push_back(tmp.first);
+        void_fraction.push_back(1.0 - eroded / total);
+    }
+}
+
+double MorphologyCurve::Apply(signed char *id, double VoidFraction,
+                              signed char NewLabel) const {
+    // Decrease the critical radius until the target is met (as in MorphOpen),
+    // then choose the closer of the last two points
+    double Rcrit = 1e100;
+    double void_fraction_new = 1.0;
+    for (size_t p = 0; p < radius.size(); p++) {
+        double Rcrit_old = Rcrit;
+        double void_fraction_old = void_fraction_new;
+        Rcrit = radius[p];
+        void_fraction_new = void_fraction[p];
+        if (void_fraction_new < VoidFraction) {
+            if (fabs(void_fraction_old - VoidFraction) <=
+                fabs(void_fraction_new - VoidFraction)) {
+                Rcrit = Rcrit_old;
+                void_fraction_new = void_fraction_old;
+            }
+            break;
+        }
+    }
+    int Nx = d_Dm->Nx;
+    int Ny = d_Dm->Ny;
+    int Nz = d_Dm->Nz;
+    for (int k = 1; k < Nz - 1; k++) {
+        for (int j = 1; j < Ny - 1; j++) {
+            for (int i = 1; i < Nx - 1; i++) {
+                if (d_mask(i, j, k) && InvasionRadius(i, j, k) >= Rcrit)
+                    id[k * Nx * Ny + j * Nx + i] = NewLabel;
+            }
+        }
+    }
+    if (d_Dm->rank() == 0) {
+        printf("Final void fraction=%f\n", void_fraction_new);
+        printf("Final critical radius=%f\n", Rcrit);
+    }
+    return void_fraction_new;
+}
+
+void MorphologyCurve::Write(const std::string &filename) const {
+    if (d_Dm->rank() != 0)
+        return;
+    FILE *fid = fopen(filename.c_str(), "w");
+    fprintf(fid, "sw,radius\n");
+    for (size_t p = 0; p < radius.size(); p++)
+        fprintf(fid, "%f,%f\n", void_fraction[p], radius[p]);
+    fclose(fid);
+}
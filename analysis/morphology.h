@@ -119,4 +119,75 @@ private:
         *recvID_XZ;
 };
 
+/**
+ * \class MorphologyCurve
+ * @brief 
+ * The MorphologyCurve class computes the complete curve for morphological opening
+ * and drainage in a single pass. The largest critical radius that invades each site
+ * is computed once, so that the configuration for any void fraction can be extracted
+ * without repeating the morphological operation.
+ * 
+ */
+class MorphologyCurve {
+public:
+    /**
+	* \brief Create an empty curve
+	*/
+    MorphologyCurve();
+
+    /**
+	* \brief Destructor
+	*/
+    ~MorphologyCurve();
+
+    /**
+	* \brief Compute the curve for morphological opening (see MorphOpen)
+	* @param Dm         Domain structure 
+	* @param SignDist   Signed distance to boundary of structure
+	* @param id         image labels
+	* @param ErodeLabel label to erode based on morphological operation
+	*/
+    void Open(std::shared_ptr<Domain> Dm, const DoubleArray &SignDist,
+              const signed char *id, signed char ErodeLabel);
+
+    /**
+	* \brief Compute the curve for morphological drainage (see MorphDrain)
+	* @details Only sites that are connected to the inlet (z=0) are drained
+	* @param Dm         Domain structure 
+	* @param SignDist   Signed distance to boundary of structure
+	* @param MaxRadius  largest critical radius to consider
+	*/
+    void Drain(std::shared_ptr<Domain> Dm, const DoubleArray &SignDist,
+               double MaxRadius = 1e100);
+
+    /**
+	* \brief Label the sites for the point on the curve closest to a void fraction
+	* @param id           image labels (sites that are eroded are relabeled)
+	* @param VoidFraction target fraction of the eroded sites that remain
+	* @param NewLabel     label to assign to the eroded sites
+	* @return             void fraction for the selected point on the curve
+	*/
+    double Apply(signed char *id, double VoidFraction,
+                 signed char NewLabel) const;
+
+    /**
+	* \brief Write the curve to a space-delimited file (rank 0)
+	* @param filename   name of the file
+	*/
+    void Write(const std::string &filename) const;
+
+    std::vector<double> radius;        // critical radius for each point on the curve
+    std::vector<double> void_fraction; // fraction of the sites that remain (not eroded)
+    DoubleArray InvasionRadius; // largest critical radius that erodes each site
+
+private:
+    void LocalThickness(const DoubleArray &SignDist, double reach,
+                        double MaxRadius);
+    void Connect();
+    void ComputeCurve();
+
+    std::shared_ptr<Domain> d_Dm;
+    Array<char> d_mask; // sites that can be eroded
+};
+
 #endif
\ No newline at end of file
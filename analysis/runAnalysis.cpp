@@ -24,6 +24,7 @@
 #include "models/ColorModel.h"
 
 #include "IO/MeshDatabase.h"
+#include "IO/RestartFile.h"
 #include "threadpool/thread_pool.h"
 
 #include "ProfilerApp.h"
@@ -51,10 +52,12 @@ class WriteRestartWorkItem : public ThreadPool::WorkItemRet<void> {
 public:
     WriteRestartWorkItem(const std::string &filename_,
                          std::shared_ptr<double> cDen_,
-                         std::shared_ptr<double> cfq_, int N_)
-        : filename(filename_), cfq(cfq_), cDen(cDen_), N(N_) {}
+                         std::shared_ptr<double> cfq_, int N_,
+                         bool print_ = false)
+        : filename(filename_), cfq(cfq_), cDen(cDen_), N(N_), print(print_) {}
     virtual void run() {
         PROFILE_START("Save Checkpoint", 1);
+        double t0 = Utilities::MPI::time();
         double value;
         ofstream File(filename, ios::binary);
         for (int n = 0; n < N; n++) {
@@ -72,6 +75,12 @@ public:
             }
         }
         File.close();
+        if (print) {
+            double MB = 21.0 * N * sizeof(double) / 1048576.0;
+            double t = Utilities::MPI::time() - t0;
+            printf("Checkpoint (rank 0): wrote %0.1f MB in %0.3f s (%0.1f MB/s) \n",
+                   MB, t, MB / t);
+        }
         PROFILE_STOP("Save Checkpoint", 1);
     };
 
@@ -80,6 +89,132 @@ private:
     const std::string filename;
     std::shared_ptr<double> cfq, cDen;
     const int N;
+    const bool print;
+};
+
+// Compressed restart data shared between the work items
+struct CompressedRestart {
+    std::vector<std::vector<char>> blocks; // Compressed data for each component
+    std::vector<double> start, stop;       // Time to compress each component
+    CompressedRestart(int N) : blocks(N), start(N, 0), stop(N, 0) {}
+};
+
+// Helper class to compress one component of the restart data from a seperate thread
+class CompressRestartWorkItem : public ThreadPool::WorkItemRet<void> {
+public:
+    CompressRestartWorkItem(std::shared_ptr<double> data_, int N_, int q_,
+                            int level_,
+                            std::shared_ptr<CompressedRestart> restart_,
+                            int index_)
+        : data(data_), N(N_), q(q_), level(level_), restart(restart_),
+          index(index_) {}
+    virtual void run() {
+        PROFILE_START("Compress Checkpoint", 1);
+        restart->start[index] = Utilities::MPI::time();
+        restart->blocks[index] =
+            IO::compressValues(&data.get()[q * N], N, level);
+        restart->stop[index] = Utilities::MPI::time();
+        PROFILE_STOP("Compress Checkpoint", 1);
+    };
+
+private:
+    CompressRestartWorkItem();
+    std::shared_ptr<double> data;
+    const int N, q, level;
+    std::shared_ptr<CompressedRestart> restart;
+    const int index;
+};
+
+// Helper class to write the compressed restart file from a seperate thread
+class WriteCompressedRestartWorkItem : public ThreadPool::WorkItemRet<void> {
+public:
+    WriteCompressedRestartWorkItem(const std::string &filename_, int N_,
+                                   std::shared_ptr<CompressedRestart> restart_,
+                                   bool print_)
+        : filename(filename_), N(N_), restart(restart_), print(print_) {}
+    virtual void run() {
+        PROFILE_START("Save Checkpoint", 1);
+        double t0 = Utilities::MPI::time();
+        IO::writeCompressedRestart(filename, N, {2, 19}, restart->blocks);
+        double t1 = Utilities::MPI::time();
+        if (print) {
+            double start = t0, compress = 0, bytes = 0;
+            for (size_t i = 0; i < restart->blocks.size(); i++) {
+                start = std::min(start, restart->start[i]);
+                compress += restart->stop[i] - restart->start[i];
+                bytes += restart->blocks[i].size();
+            }
+            double MB = 21.0 * N * sizeof(double) / 1048576.0;
+            printf("Checkpoint (rank 0): compressed %0.1f MB to %0.1f MB "
+                   "(ratio %0.2f), compress %0.3f s (all threads), write "
+                   "%0.3f s, %0.1f MB/s \n",
+                   MB, bytes / 1048576.0, 1048576.0 * MB / bytes, compress,
+                   t1 - t0, MB / (t1 - start));
+        }
+        PROFILE_STOP("Save Checkpoint", 1);
+    };
+
+private:
+    WriteCompressedRestartWorkItem();
+    const std::string filename;
+    const int N;
+    std::shared_ptr<CompressedRestart> restart;
+    const bool print;
+};
+
+// Helper class to write an aggregated restart file from a seperate thread
+class WriteAggregatedRestartWorkItem : public ThreadPool::WorkItemRet<void> {
+public:
+    WriteAggregatedRestartWorkItem(const std::string &prefix_,
+                                   std::shared_ptr<double> cDen_,
+                                   std::shared_ptr<double> cfq_, int N_,
+                                   uint64_t hash_, int nfiles_,
+                                   runAnalysis::commWrapper &&comm_)
+        : prefix(prefix_), cfq(cfq_), cDen(cDen_), N(N_), hash(hash_),
+          nfiles(nfiles_), comm(std::move(comm_)) {}
+    virtual void run() {
+        PROFILE_START("Save Checkpoint", 1);
+        IO::writeRestart(prefix, N, hash, {cDen.get(), cfq.get()}, {2, 19},
+                         nfiles, comm.comm);
+        PROFILE_STOP("Save Checkpoint", 1);
+    };
+
+private:
+    WriteAggregatedRestartWorkItem();
+    const std::string prefix;
+    std::shared_ptr<double> cfq, cDen;
+    const int N;
+    const uint64_t hash;
+    const int nfiles;
+    runAnalysis::commWrapper comm;
+};
+
+// Helper class to write a decomposition independent restart file from a seperate thread
+class WriteGlobalRestartWorkItem : public ThreadPool::WorkItemRet<void> {
+public:
+    WriteGlobalRestartWorkItem(const std::string &filename_,
+                               std::shared_ptr<double> cDen_,
+                               std::shared_ptr<double> cfq_, int N_,
+                               const IntArray &map_,
+                               const RankInfoStruct &rank_info_,
+                               runAnalysis::commWrapper &&comm_)
+        : filename(filename_), cfq(cfq_), cDen(cDen_), N(N_), map(map_),
+          rank_info(rank_info_), comm(std::move(comm_)) {}
+    virtual void run() {
+        PROFILE_START("Save Checkpoint", 1);
+        IO::writeGlobalRestart(filename, map, rank_info, N,
+                               {cDen.get(), cfq.get()}, {2, 19}, comm.comm);
+        PROFILE_STOP("Save Checkpoint", 1);
+    };
+
+private:
+    WriteGlobalRestartWorkItem();
+    const std::string filename;
+    std::shared_ptr<double> cfq, cDen;
+    const int N;
+    const IntArray &map;
+    const RankInfoStruct rank_info;
+    runAnalysis::commWrapper comm;
 };
 
 // Helper class to compute the blob ids
@@ -150,12 +285,12 @@ public:
             // Renumber the current timestep's ids
             getNewIDs(map, max_id, *new_list);
             renumberIDs(*new_list, new_id->second);
-            writeIDMap(map, timestep, id_map_filename);
+            writeIDMap(map, timestep, id_map_filename, comm.comm);
         } else {
             max_id = -1;
             ID_map_struct map(new_id->first);
             getNewIDs(map, max_id, *new_list);
-            writeIDMap(map, timestep, id_map_filename);
+            writeIDMap(map, timestep, id_map_filename, comm.comm);
         }
         PROFILE_STOP("Identify blobs maps", 1);
     }
@@ -474,6 +609,51 @@ private:
     double beta;
 };
 
+/******************************************************************
+ *  Host snapshot of the simulation state                          *
+ ******************************************************************/
+struct runAnalysis::SnapshotBuffer {
+    SnapshotBuffer(int Nx, int Ny, int Nz)
+        : Phi(Nx, Ny, Nz), Pressure(Nx, Ny, Nz), Rho_n(Nx, Ny, Nz),
+          Rho_w(Nx, Ny, Nz), Vel_x(Nx, Ny, Nz), Vel_y(Nx, Ny, Nz),
+          Vel_z(Nx, Ny, Nz) {}
+    DoubleArray Phi;
+    DoubleArray Pressure;
+    DoubleArray Rho_n;
+    DoubleArray Rho_w;
+    DoubleArray Vel_x;
+    DoubleArray Vel_y;
+    DoubleArray Vel_z;
+    // Work item that releases the buffer
+    ThreadPool::thread_id_t wait;
+};
+
+// Helper class to move a snapshot into the analysis arrays from within a thread
+// Note: the snapshot buffer can be reused as soon as this has finished
+class SnapshotWorkItem : public ThreadPool::WorkItemRet<void> {
+public:
+    SnapshotWorkItem(std::shared_ptr<runAnalysis::SnapshotBuffer> snapshot_,
+                     SubPhase &Averages_)
+        : snapshot(snapshot_), Averages(Averages_) {}
+    ~SnapshotWorkItem() {}
+    virtual void run() {
+        PROFILE_START("Copy snapshot", 1);
+        Averages.Phi.copy(snapshot->Phi.data());
+        Averages.Pressure.copy(snapshot->Pressure.data());
+        Averages.Rho_n.copy(snapshot->Rho_n.data());
+        Averages.Rho_w.copy(snapshot->Rho_w.data());
+        Averages.Vel_x.copy(snapshot->Vel_x.data());
+        Averages.Vel_y.copy(snapshot->Vel_y.data());
+        Averages.Vel_z.copy(snapshot->Vel_z.data());
+        PROFILE_STOP("Copy snapshot", 1);
+    }
+
+private:
+    SnapshotWorkItem();
+    std::shared_ptr<runAnalysis::SnapshotBuffer> snapshot;
+    SubPhase &Averages;
+};
+
 class SubphaseWorkItem : public ThreadPool::WorkItemRet<void> {
 public:
     SubphaseWorkItem(AnalysisType type_, int timestep_, SubPhase &Averages_)
@@ -540,7 +720,7 @@ runAnalysis::runAnalysis(std::shared_ptr<Database> input_db,
                          std::shared_ptr<Domain> Dm, int Np, bool Regular,
                          IntArray Map)
     : d_Np(Np), d_regular(Regular), d_rank_info(rank_info), d_Map(Map),
-      d_comm(Dm->Comm.dup()), d_ScaLBL_Comm(ScaLBL_Comm) {
+      d_NPhi(0), d_comm(Dm->Comm.dup()), d_ScaLBL_Comm(ScaLBL_Comm) {
 
     auto db = input_db->getDatabase("Analysis");
     auto vis_db = input_db->getDatabase("Visualization");
@@ -579,19 +759,43 @@ runAnalysis::runAnalysis(std::shared_ptr<Database> input_db,
         d_subphase_analysis_interval =
             db->getScalar<int>("subphase_analysis_interval");
     }
+    d_snapshot_depth = db->getWithDefault<int>("snapshot_buffers", 2);
+    d_snapshot_policy =
+        db->getWithDefault<std::string>("snapshot_policy", "wait");
+    d_snapshot_count = 0;
+    if (d_snapshot_depth < 1)
+        ERROR("snapshot_buffers must be at least 1");
+    if (d_snapshot_policy != "wait" && d_snapshot_policy != "skip")
+        ERROR("Unknown snapshot_policy (expected wait or skip)");
 
     auto restart_file =
         db->getWithDefault<std::string>("restart_file", "Restart");
     d_restartFile = restart_file + "." + rankString;
+    d_restartPrefix = restart_file;
+    d_restart_writers = db->getWithDefault<int>("restart_writers", 0);
+    d_restart_global = db->getWithDefault<bool>("restart_global", false);
+    d_restart_compression =
+        db->getWithDefault<std::string>("restart_compression", "none");
+    d_restart_compression_level =
+        db->getWithDefault<int>("restart_compression_level", 1);
+    if (d_restart_compression != "none" && d_restart_compression != "zlib")
+        ERROR("Unknown restart_compression (expected none or zlib)");
+    if (d_restart_compression != "none" &&
+        (d_restart_global || d_restart_writers > 0))
+        ERROR("restart_compression is only supported for the per-rank "
+              "restart files");
+    d_restart_hash = IO::layoutHash(d_Map.data(), d_Map.length());
 
     d_rank = d_comm.getRank();
-    writeIDMap(ID_map_struct(), 0, id_map_filename);
+    writeIDMap(ID_map_struct(), 0, id_map_filename, d_comm);
 
     // Initialize IO for silo
     //std::string  format = "silo";
     format = vis_db->getWithDefault<string>("format", "silo");
 
     IO::initialize("", format, "false");
+    IO::setHDF5Options(vis_db->getWithDefault<bool>("hdf5_chunk", false),
+                       vis_db->getWithDefault<std::string>("hdf5_compression", "none"));
     // Create the MeshDataStruct
     d_meshData.resize(1);
 
@@ -688,6 +892,9 @@ runAnalysis::runAnalysis(ScaLBL_ColorModel &ColorModel)
 
     d_comm = ColorModel.Dm->Comm.dup();
     d_Np = ColorModel.Np;
+    d_NPhi = 0;
+    if (ColorModel.SparsePhi)
+        setPhaseLayout(ColorModel.PhiMap, ColorModel.NPhi);
 
     auto input_db = ColorModel.db;
     auto db = input_db->getDatabase("Analysis");
@@ -724,19 +931,43 @@ runAnalysis::runAnalysis(ScaLBL_ColorModel &ColorModel)
         d_subphase_analysis_interval =
             db->getScalar<int>("subphase_analysis_interval");
     }
+    d_snapshot_depth = db->getWithDefault<int>("snapshot_buffers", 2);
+    d_snapshot_policy =
+        db->getWithDefault<std::string>("snapshot_policy", "wait");
+    d_snapshot_count = 0;
+    if (d_snapshot_depth < 1)
+        ERROR("snapshot_buffers must be at least 1");
+    if (d_snapshot_policy != "wait" && d_snapshot_policy != "skip")
+        ERROR("Unknown snapshot_policy (expected wait or skip)");
 
     auto restart_file =
         db->getWithDefault<std::string>("restart_file", "Restart");
     d_restartFile = restart_file + "." + rankString;
+    d_restartPrefix = restart_file;
+    d_restart_writers = db->getWithDefault<int>("restart_writers", 0);
+    d_restart_global = db->getWithDefault<bool>("restart_global", false);
+    d_restart_compression =
+        db->getWithDefault<std::string>("restart_compression", "none");
+    d_restart_compression_level =
+        db->getWithDefault<int>("restart_compression_level", 1);
+    if (d_restart_compression != "none" && d_restart_compression != "zlib")
+        ERROR("Unknown restart_compression (expected none or zlib)");
+    if (d_restart_compression != "none" &&
+        (d_restart_global || d_restart_writers > 0))
+        ERROR("restart_compression is only supported for the per-rank "
+              "restart files");
+    d_restart_hash = IO::layoutHash(d_Map.data(), d_Map.length());
 
     d_rank = d_comm.getRank();
-    writeIDMap(ID_map_struct(), 0, id_map_filename);
+    writeIDMap(ID_map_struct(), 0, id_map_filename, d_comm);
     // Initialize IO for silo
     //std::string  format = "silo";
 
     format = vis_db->getWithDefault<string>("format", "silo");
 
     IO::initialize("", format, "false");
+    IO::setHDF5Options(vis_db->getWithDefault<bool>("hdf5_chunk", false),
+                       vis_db->getWithDefault<std::string>("hdf5_compression", "none"));
     // Create the MeshDataStruct
     d_meshData.resize(1);
 
@@ -824,11 +1055,35 @@ void runAnalysis::finish() {
     d_wait_vis.reset();
     d_wait_subphase.reset();
     d_wait_restart.reset();
+    for (auto &snapshot : d_snapshots)
+        snapshot->wait.reset();
     // Syncronize
     d_comm.barrier();
     PROFILE_STOP("finish");
 }
 
+/******************************************************************
+ *  Compress the restart data                                      *
+ ******************************************************************/
+ThreadPool::WorkItem *
+runAnalysis::compressRestart(std::shared_ptr<double> cDen,
+                             std::shared_ptr<double> cfq) {
+    // Compress each component in a seperate work item and return the
+    //    work item that writes the file once they have finished
+    auto restart = std::make_shared<CompressedRestart>(21);
+    std::vector<ThreadPool::thread_id_t> ids(21);
+    for (int q = 0; q < 2; q++)
+        ids[q] = d_tpool.add_work(new CompressRestartWorkItem(
+            cDen, d_Np, q, d_restart_compression_level, restart, q));
+    for (int q = 0; q < 19; q++)
+        ids[q + 2] = d_tpool.add_work(new CompressRestartWorkItem(
+            cfq, d_Np, q, d_restart_compression_level, restart, q + 2));
+    auto work = new WriteCompressedRestartWorkItem(d_restartFile, d_Np,
+                                                   restart, d_rank == 0);
+    work->add_dependencies(ids);
+    return work;
+}
+
 /******************************************************************
  *  Set the thread affinities                                      *
  ******************************************************************/
@@ -840,6 +1095,11 @@ void print(const std::vector<int> &ids) {
         printf(", %i", ids[i]);
     printf("\n");
 }
+void runAnalysis::setPhaseLayout(const IntArray &map, int count) {
+    d_PhiMap = map;
+    d_NPhi = count;
+}
+
 void runAnalysis::createThreads(const std::string &method, int N_threads) {
     // Check if we are not using analysis threads
     if (method == "none")
@@ -1090,8 +1350,20 @@ void runAnalysis::run(int timestep, std::shared_ptr<Database> input_db,
             OutStream.close();
         }
         // Write the restart file (using a seperate thread)
-        auto work =
-            new WriteRestartWorkItem(d_restartFile.c_str(), cDen, cfq, d_Np);
+        ThreadPool::WorkItem *work;
+        if (d_restart_global)
+            work = new WriteGlobalRestartWorkItem(
+                d_restartPrefix + ".global", cDen, cfq, d_Np, d_Map,
+                d_rank_info, getComm());
+        else if (d_restart_writers > 0)
+            work = new WriteAggregatedRestartWorkItem(
+                d_restartPrefix, cDen, cfq, d_Np, d_restart_hash,
+                d_restart_writers, getComm());
+        else if (d_restart_compression != "none")
+            work = compressRestart(cDen, cfq);
+        else
+            work = new WriteRestartWorkItem(d_restartFile.c_str(), cDen, cfq,
+                                           d_Np, d_rank == 0);
         work->add_dependency(d_wait_restart);
         d_wait_restart = d_tpool.add_work(work);
     }
@@ -1110,12 +1382,44 @@ void runAnalysis::run(int timestep, std::shared_ptr<Database> input_db,
     PROFILE_STOP("run");
 }
 
+/******************************************************************
+ *  Get the next snapshot buffer                                   *
+ ******************************************************************/
+std::shared_ptr<runAnalysis::SnapshotBuffer> runAnalysis::nextSnapshot() {
+    if (d_snapshots.empty()) {
+        for (int i = 0; i < d_snapshot_depth; i++)
+            d_snapshots.push_back(
+                std::make_shared<SnapshotBuffer>(d_N[0], d_N[1], d_N[2]));
+    }
+    // The oldest snapshot is reused once it has been moved into the analysis
+    auto snapshot = d_snapshots[d_snapshot_count % d_snapshot_depth];
+    if (!snapshot->wait.isNull()) {
+        if (d_snapshot_policy == "skip") {
+            // All ranks must agree, since the analysis is collective
+            int busy = d_tpool.isFinished(snapshot->wait) ? 0 : 1;
+            if (d_comm.maxReduce(busy) > 0) {
+                if (d_rank == 0)
+                    printf("Analysis is falling behind, skipping snapshot\n");
+                return nullptr;
+            }
+        } else {
+            PROFILE_START("Snapshot-Wait", 1);
+            d_tpool.wait(snapshot->wait);
+            PROFILE_STOP("Snapshot-Wait", 1);
+        }
+        snapshot->wait.reset();
+    }
+    d_snapshot_count++;
+    return snapshot;
+}
+
 /******************************************************************
  *  Run the analysis                                               *
  ******************************************************************/
+template <class TYPE>
 void runAnalysis::basic(int timestep, std::shared_ptr<Database> input_db,
                         SubPhase &Averages, const double *Phi, double *Pressure,
-                        double *Velocity, double *fq, double *Den) {
+                        double *Velocity, TYPE *fq, double *Den) {
     int Nx = d_N[0];
     int Ny = d_N[1];
     int Nz = d_N[2];
@@ -1143,29 +1447,37 @@ void runAnalysis::basic(int timestep, std::shared_ptr<Database> input_db,
     PROFILE_START("Copy data to host", 1);
 
     // if ( matches(type,AnalysisType::CopySimState) ) {
-    if (timestep % d_analysis_interval == 0) {
-        finish(); // can't copy if threads are still working on data
-        // Copy the members of Averages to the cpu (phase was copied above)
+    // Copy into a free snapshot buffer, so that we do not have to wait for
+    // the threads that are still working on the previous analysis
+    std::shared_ptr<SnapshotBuffer> snapshot;
+    if (timestep % d_analysis_interval == 0)
+        snapshot = nextSnapshot();
+    // The subphase and vis work use the fields in Averages, so they are
+    // skipped together with the snapshot
+    bool skipped = (timestep % d_analysis_interval == 0) && !snapshot;
+    if (snapshot) {
+        // Copy the simulation state into the snapshot buffer
         PROFILE_START("Copy-Pressure", 1);
         ScaLBL_D3Q19_Pressure(fq, Pressure, d_Np);
         // ScaLBL_D3Q19_Momentum(fq,Velocity,d_Np);
         ScaLBL_DeviceBarrier();
         PROFILE_STOP("Copy-Pressure", 1);
-        PROFILE_START("Copy-Wait", 1);
-        PROFILE_STOP("Copy-Wait", 1);
         PROFILE_START("Copy-State", 1);
         /*if (d_regular)
-            d_ScaLBL_Comm->RegularLayout(d_Map,Phi,Averages.Phi);
+            d_ScaLBL_Comm->RegularLayout(d_Map,Phi,snapshot->Phi);
         else */
-        ScaLBL_CopyToHost(Averages.Phi.data(), Phi, N * sizeof(double));
+        if (d_PhiMap.length() > 0)
+            d_ScaLBL_Comm->RegularLayout(d_PhiMap, Phi, d_NPhi, snapshot->Phi);
+        else
+            ScaLBL_CopyToHost(snapshot->Phi.data(), Phi, N * sizeof(double));
         // copy other variables
-        d_ScaLBL_Comm->RegularLayout(d_Map, Pressure, Averages.Pressure);
-        d_ScaLBL_Comm->RegularLayout(d_Map, &Den[0], Averages.Rho_n);
-        d_ScaLBL_Comm->RegularLayout(d_Map, &Den[d_Np], Averages.Rho_w);
-        d_ScaLBL_Comm->RegularLayout(d_Map, &Velocity[0], Averages.Vel_x);
-        d_ScaLBL_Comm->RegularLayout(d_Map, &Velocity[d_Np], Averages.Vel_y);
+        d_ScaLBL_Comm->RegularLayout(d_Map, Pressure, snapshot->Pressure);
+        d_ScaLBL_Comm->RegularLayout(d_Map, &Den[0], snapshot->Rho_n);
+        d_ScaLBL_Comm->RegularLayout(d_Map, &Den[d_Np], snapshot->Rho_w);
+        d_ScaLBL_Comm->RegularLayout(d_Map, &Velocity[0], snapshot->Vel_x);
+        d_ScaLBL_Comm->RegularLayout(d_Map, &Velocity[d_Np], snapshot->Vel_y);
         d_ScaLBL_Comm->RegularLayout(d_Map, &Velocity[2 * d_Np],
-                                     Averages.Vel_z);
+                                     snapshot->Vel_z);
         PROFILE_STOP("Copy-State", 1);
     }
     PROFILE_STOP("Copy data to host");
@@ -1173,7 +1485,15 @@ void runAnalysis::basic(int timestep, std::shared_ptr<Database> input_db,
     // Spawn threads to do the analysis work
     // if (timestep%d_restart_interval==0){
     // if ( matches(type,AnalysisType::ComputeAverages) ) {
-    if (timestep % d_analysis_interval == 0) {
+    if (snapshot) {
+        // Move the snapshot into Averages once nothing else is using it
+        auto copy = new SnapshotWorkItem(snapshot, Averages);
+        copy->add_dependency(d_wait_subphase);
+        copy->add_dependency(d_wait_analysis);
+        copy->add_dependency(d_wait_vis);
+        d_wait_analysis = d_tpool.add_work(copy);
+        snapshot->wait = d_wait_analysis;
+
         auto work = new BasicWorkItem(type, timestep, Averages);
         work->add_dependency(
             d_wait_subphase); // Make sure we are done using analysis before modifying
@@ -1182,7 +1502,7 @@ void runAnalysis::basic(int timestep, std::shared_ptr<Database> input_db,
         d_wait_analysis = d_tpool.add_work(work);
     }
 
-    if (timestep % d_subphase_analysis_interval == 0) {
+    if (timestep % d_subphase_analysis_interval == 0 && !skipped) {
         auto work = new SubphaseWorkItem(type, timestep, Averages);
         work->add_dependency(
             d_wait_subphase); // Make sure we are done using analysis before modifying
@@ -1196,7 +1516,7 @@ void runAnalysis::basic(int timestep, std::shared_ptr<Database> input_db,
         // Copy restart data to the CPU
         cDen = make_shared_array<double>(2 * d_Np);
         cfq = make_shared_array<double>(19 * d_Np);
-        ScaLBL_CopyToHost(cfq.get(), fq, 19 * d_Np * sizeof(double));
+        ScaLBL_D3Q19_CopyToHost(cfq.get(), fq, d_Np);
         ScaLBL_CopyToHost(cDen.get(), Den, 2 * d_Np * sizeof(double));
 
         if (d_rank == 0) {
@@ -1208,13 +1528,25 @@ void runAnalysis::basic(int timestep, std::shared_ptr<Database> input_db,
             OutStream.close();
         }
         // Write the restart file (using a seperate thread)
-        auto work1 =
-            new WriteRestartWorkItem(d_restartFile.c_str(), cDen, cfq, d_Np);
+        ThreadPool::WorkItem *work1;
+        if (d_restart_global)
+            work1 = new WriteGlobalRestartWorkItem(
+                d_restartPrefix + ".global", cDen, cfq, d_Np, d_Map,
+                d_rank_info, getComm());
+        else if (d_restart_writers > 0)
+            work1 = new WriteAggregatedRestartWorkItem(
+                d_restartPrefix, cDen, cfq, d_Np, d_restart_hash,
+                d_restart_writers, getComm());
+        else if (d_restart_compression != "none")
+            work1 = compressRestart(cDen, cfq);
+        else
+            work1 = new WriteRestartWorkItem(d_restartFile.c_str(), cDen, cfq,
+                                            d_Np, d_rank == 0);
         work1->add_dependency(d_wait_restart);
         d_wait_restart = d_tpool.add_work(work1);
     }
 
-    if (timestep % d_visualization_interval == 0) {
+    if (timestep % d_visualization_interval == 0 && !skipped) {
         // Write the vis files
         auto work = new IOWorkItem(timestep, input_db, d_meshData, Averages,
                                    d_n, d_rank_info, getComm());
@@ -1227,6 +1559,15 @@ void runAnalysis::basic(int timestep, std::shared_ptr<Database> input_db,
     PROFILE_STOP("basic");
 }
 
+template void runAnalysis::basic<double>(int, std::shared_ptr<Database>,
+                                         SubPhase &, const double *, double *,
+                                         double *, double *, double *);
+#ifdef SCALBL_FLOAT_STORAGE
+template void runAnalysis::basic<float>(int, std::shared_ptr<Database>,
+                                        SubPhase &, const double *, double *,
+                                        double *, float *, double *);
+#endif
+
 void runAnalysis::WriteVisData(int timestep, std::shared_ptr<Database> input_db,
                                SubPhase &Averages, const double *Phi,
                                double *Pressure, double *Velocity, double *fq,
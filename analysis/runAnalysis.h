@@ -41,6 +41,9 @@ enum class AnalysisType : uint64_t {
 //! Class to run the analysis in multiple threads
 class runAnalysis {
 public:
+    // Host copy of the simulation state used by basic()
+    struct SnapshotBuffer;
+
     //! Constructor
     runAnalysis(std::shared_ptr<Database> db, const RankInfoStruct &rank_info,
                 std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm,
@@ -56,9 +59,11 @@ public:
              const double *Phi, double *Pressure, double *Velocity, double *fq,
              double *Den);
 
+    //! Run the basic analysis (fq may be stored as double or float)
+    template <class TYPE>
     void basic(int timestep, std::shared_ptr<Database> db, SubPhase &Averages,
                const double *Phi, double *Pressure, double *Velocity,
-               double *fq, double *Den);
+               TYPE *fq, double *Den);
     void WriteVisData(int timestep, std::shared_ptr<Database> vis_db,
                       SubPhase &Averages, const double *Phi, double *Pressure,
                       double *Velocity, double *fq, double *Den);
@@ -83,12 +88,29 @@ public:
     void createThreads(const std::string &method = "default",
                        int N_threads = 4);
 
+    /*!
+     *  \brief    Set the layout of the phase field passed to basic()
+     *  \details  By default Phi is stored in the regular layout.  For a compact
+     *      phase field (e.g. sparse_phi in the color model), map gives the index
+     *      in Phi for each site (<0 if not stored)
+     * @param[in] map       Index in Phi for each site of the regular layout
+     * @param[in] count     Number of entries in Phi
+     */
+    void setPhaseLayout(const IntArray &map, int count);
+
 private:
     runAnalysis();
 
     // Determine the analysis to perform
     AnalysisType computeAnalysisType(int timestep);
 
+    // Get the next free snapshot buffer (returns nullptr if the snapshot is skipped)
+    std::shared_ptr<SnapshotBuffer> nextSnapshot();
+
+    // Compress the restart data using the thread pool and return the work item to write it
+    ThreadPool::WorkItem *compressRestart(std::shared_ptr<double> cDen,
+                                          std::shared_ptr<double> cfq);
+
 public:
     class commWrapper {
     public:
@@ -121,11 +143,19 @@ private:
     ThreadPool d_tpool;
     RankInfoStruct d_rank_info;
     IntArray d_Map;
+    IntArray d_PhiMap; // Layout of the phase field (empty for regular)
+    int d_NPhi;
     std::shared_ptr<std::pair<int, IntArray>> d_last_ids;
     std::shared_ptr<std::pair<int, IntArray>> d_last_index;
     std::shared_ptr<std::vector<BlobIDType>> d_last_id_map;
     std::vector<IO::MeshDataStruct> d_meshData;
     std::string d_restartFile;
+    std::string d_restartPrefix; // Base name of the aggregated restart files
+    int d_restart_writers;       // Number of aggregated restart files (0 for 1 file/rank)
+    bool d_restart_global;       // Write the restart in the global regular layout
+    std::string d_restart_compression; // Compression for the restart files (none, zlib)
+    int d_restart_compression_level;   // zlib compression level
+    uint64_t d_restart_hash;     // Hash of the local layout
     Utilities::MPI d_comm;
     Utilities::MPI d_comms[1024];
     volatile bool d_comm_used[1024];
@@ -138,6 +168,12 @@ private:
     ThreadPool::thread_id_t d_wait_vis;
     ThreadPool::thread_id_t d_wait_restart;
 
+    // Ring of host buffers holding the state copied by basic()
+    int d_snapshot_depth;
+    int d_snapshot_count;
+    std::string d_snapshot_policy; // "wait" or "skip" when the ring is full
+    std::vector<std::shared_ptr<SnapshotBuffer>> d_snapshots;
+
     // Friends
     friend commWrapper::~commWrapper();
 };
@@ -38,6 +38,23 @@ MACRO( CONFIGURE_MIC )
 ENDMACRO()
 
 
+# Macro to configure the OpenMP threaded CPU kernels
+MACRO( CONFIGURE_OPENMP )
+    CHECK_ENABLE_FLAG( USE_OPENMP 0 )
+    IF ( USE_OPENMP AND ( USE_CUDA OR USE_HIP ) )
+        MESSAGE( FATAL_ERROR "USE_OPENMP is only supported with the cpu kernels" )
+    ENDIF()
+    IF ( USE_OPENMP )
+        FIND_PACKAGE( OpenMP REQUIRED )
+        ADD_DEFINITIONS( -DUSE_OPENMP )
+        SET( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${OpenMP_C_FLAGS}" )
+        SET( CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${OpenMP_CXX_FLAGS}" )
+        SET( EXTERNAL_LIBS ${EXTERNAL_LIBS} ${OpenMP_CXX_LIBRARIES} )
+        MESSAGE( "Using OpenMP" )
+    ENDIF()
+ENDMACRO()
+
+
 # Macro to find and configure the MPI libraries
 MACRO( CONFIGURE_MPI )
     # Determine if we want to use MPI
@@ -278,6 +295,9 @@ MACRO ( CONFIGURE_LBPM )
     # Suppress some common warnings
     IF ( USING_GCC )
         SET( CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wno-reorder -Wno-unused-parameter")
+        IF ( NOT USE_OPENMP )
+            SET( CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wno-unknown-pragmas")
+        ENDIF()
         SET( CMAKE_CUDA_FLAGS "${CMAKE_CUDA_FLAGS} --compiler-options -Wno-reorder,-Wno-unused-parameter")
     ENDIF()
 ENDMACRO ()
@@ -0,0 +1,87 @@
+/*
+This class batches scalar all-reduce operations
+ */
+#include "common/BatchedReduction.h"
+#include "common/Utilities.h"
+
+BatchedReduction::BatchedReduction(const Utilities::MPI &comm_)
+    : comm(comm_), pending(false) {
+    for (int op = 0; op < N_OPS; op++)
+        request[op] = MPI_REQUEST_NULL;
+}
+
+BatchedReduction::~BatchedReduction() {
+    if (pending)
+        finish();
+}
+
+void BatchedReduction::sum(double local, double &global) {
+    add(SUM, local, global);
+}
+
+void BatchedReduction::min(double local, double &global) {
+    add(MIN, local, global);
+}
+
+void BatchedReduction::max(double local, double &global) {
+    add(MAX, local, global);
+}
+
+void BatchedReduction::add(int op, double local, double &global) {
+    if (pending)
+        ERROR("BatchedReduction: cannot register values while a reduction is "
+              "in progress");
+    sendbuf[op].push_back(local);
+    result[op].push_back(&global);
+}
+
+size_t BatchedReduction::size() const {
+    return sendbuf[SUM].size() + sendbuf[MIN].size() + sendbuf[MAX].size();
+}
+
+void BatchedReduction::reduce() {
+    start();
+    finish();
+}
+
+void BatchedReduction::start() {
+    if (pending)
+        ERROR("BatchedReduction: reduction already in progress");
+    pending = true;
+    for (int op = 0; op < N_OPS; op++) {
+        int count = sendbuf[op].size();
+        recvbuf[op].resize(count);
+        if (count == 0)
+            continue;
+#ifdef USE_MPI
+        MPI_Op mpi_op = MPI_SUM;
+        if (op == MIN)
+            mpi_op = MPI_MIN;
+        else if (op == MAX)
+            mpi_op = MPI_MAX;
+        MPI_Iallreduce(sendbuf[op].data(), recvbuf[op].data(), count,
+                       MPI_DOUBLE, mpi_op, comm.getCommunicator(),
+                       &request[op]);
+#else
+        recvbuf[op] = sendbuf[op];
+#endif
+    }
+}
+
+void BatchedReduction::finish() {
+    if (!pending)
+        ERROR("BatchedReduction: finish called without start");
+    for (int op = 0; op < N_OPS; op++) {
+        if (sendbuf[op].empty())
+            continue;
+#ifdef USE_MPI
+        MPI_Wait(&request[op], MPI_STATUS_IGNORE);
+#endif
+        for (size_t i = 0; i < result[op].size(); i++)
+            *result[op][i] = recvbuf[op][i];
+        sendbuf[op].clear();
+        recvbuf[op].clear();
+        result[op].clear();
+    }
+    pending = false;
+}
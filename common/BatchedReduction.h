@@ -0,0 +1,82 @@
+/*
+This class batches scalar all-reduce operations
+ */
+#ifndef BatchedReduction_H
+#define BatchedReduction_H
+#include "common/MPI.h"
+
+#include <vector>
+
+/**
+ * \class BatchedReduction
+ * \brief Pack many scalar reductions into one allreduce per operation
+ * \details  The analysis routines compute dozens of local accumulators that
+ *   must be summed (or min/max reduced) over all processors.  Rather than
+ *   issuing a separate allreduce for each value, the values are registered
+ *   with sum/min/max and packed into one contiguous buffer per operation.
+ *   reduce() then performs at most three allreduce calls and writes each
+ *   global value to the location supplied when it was registered.
+ *   start()/finish() split the same work into a non-blocking allreduce so
+ *   that the communication can be overlapped with other work.
+ *   All processors must register the same sequence of values.
+ */
+class BatchedReduction {
+public:
+    //! Constructor
+    BatchedReduction(const Utilities::MPI &comm);
+
+    //! Destructor (completes any outstanding reduction)
+    ~BatchedReduction();
+
+    /**
+     * \brief Register a value for a sum reduction
+     * \param local   Local contribution (copied when registered)
+     * \param global  Receives the sum over all processors
+     */
+    void sum(double local, double &global);
+
+    /**
+     * \brief Register a value for a min reduction
+     * \param local   Local contribution (copied when registered)
+     * \param global  Receives the minimum over all processors
+     */
+    void min(double local, double &global);
+
+    /**
+     * \brief Register a value for a max reduction
+     * \param local   Local contribution (copied when registered)
+     * \param global  Receives the maximum over all processors
+     */
+    void max(double local, double &global);
+
+    //! Perform all registered reductions and clear the batch (blocking)
+    void reduce();
+
+    //! Begin all registered reductions (non-blocking)
+    void start();
+
+    //! Complete the reductions begun by start() and clear the batch
+    void finish();
+
+    //! Returns true between start() and finish()
+    bool active() const { return pending; }
+
+    //! Number of values currently registered
+    size_t size() const;
+
+private:
+    BatchedReduction(const BatchedReduction &) = delete;
+    BatchedReduction &operator=(const BatchedReduction &) = delete;
+
+    enum { SUM = 0, MIN = 1, MAX = 2, N_OPS = 3 };
+    void add(int op, double local, double &global);
+
+    Utilities::MPI comm;
+    bool pending;
+    std::vector<double> sendbuf[N_OPS];
+    std::vector<double> recvbuf[N_OPS];
+    std::vector<double *> result[N_OPS];
+    MPI_Request request[N_OPS];
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+This class schedules the convergence checks of an iterative solver
+ */
+#include "common/ConvergenceMonitor.h"
+#include "common/Utilities.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Number of checks used to fit the convergence rate
+static const size_t history_length = 4;
+
+// Fraction of the predicted remaining time steps to skip before the next check
+static const double safety_factor = 0.5;
+
+ConvergenceMonitor::ConvergenceMonitor(double tolerance_, int interval_,
+                                       int max_interval_, bool adaptive_)
+    : tolerance(tolerance_), interval(std::max(interval_, 1)),
+      max_interval(std::max(max_interval_, interval_)), adaptive(adaptive_),
+      next_check(0), count(0), decay_rate(0) {
+    if (tolerance <= 0)
+        ERROR("ConvergenceMonitor: tolerance must be positive");
+    reset();
+}
+
+void ConvergenceMonitor::reset() {
+    next_check = interval;
+    count = 0;
+    history_t.clear();
+    history_log.clear();
+}
+
+void ConvergenceMonitor::update(int timestep, double error) {
+    count++;
+    next_check = timestep + interval;
+    if (!(error > 0) || !std::isfinite(error))
+        return;
+    history_t.push_back(timestep);
+    history_log.push_back(log(error));
+    if (history_t.size() > history_length) {
+        history_t.erase(history_t.begin());
+        history_log.erase(history_log.begin());
+    }
+    // Least squares fit of log(error) against the time step
+    size_t N = history_t.size();
+    if (N > 1) {
+        double t_mean = 0, e_mean = 0;
+        for (size_t i = 0; i < N; i++) {
+            t_mean += history_t[i] / N;
+            e_mean += history_log[i] / N;
+        }
+        double Stt = 0, Ste = 0;
+        for (size_t i = 0; i < N; i++) {
+            Stt += (history_t[i] - t_mean) * (history_t[i] - t_mean);
+            Ste += (history_t[i] - t_mean) * (history_log[i] - e_mean);
+        }
+        decay_rate = Stt > 0 ? -Ste / Stt : 0;
+    }
+    int predicted = remaining();
+    if (adaptive && predicted > 0) {
+        int step = static_cast<int>(safety_factor * predicted);
+        next_check = timestep + std::min(std::max(step, interval), max_interval);
+    }
+}
+
+int ConvergenceMonitor::remaining() const {
+    if (history_log.empty() || !(decay_rate > 0))
+        return -1;
+    double excess = history_log.back() - log(tolerance);
+    if (excess <= 0)
+        return 0;
+    return static_cast<int>(std::min(excess / decay_rate, 1e9));
+}
@@ -0,0 +1,71 @@
+/*
+This class schedules the convergence checks of an iterative solver
+ */
+#ifndef ConvergenceMonitor_H
+#define ConvergenceMonitor_H
+
+#include <vector>
+
+/**
+ * \class ConvergenceMonitor
+ * \brief Decide when an iterative solver should compute its global error
+ * \details  Checking convergence requires a global reduction, so solvers that
+ *   iterate to steady state (e.g. the LB-Poisson solver) only check every
+ *   interval time steps.  The monitor records the global error at each check
+ *   and fits the convergence rate (the decay of log(error) per time step) to
+ *   the recent history.  The next check is scheduled at a fraction of the
+ *   predicted number of remaining time steps, but never sooner than interval
+ *   or later than max_interval time steps after the last one.  Without a rate
+ *   estimate (or if the error is not decreasing) the fixed interval is used.
+ *   The rate is kept when reset() is called so that a solver that is re-run
+ *   from the previous solution (a warm start) can predict from its first check.
+ */
+class ConvergenceMonitor {
+public:
+    /**
+     * \brief Constructor
+     * \param tolerance     Convergence tolerance for the error
+     * \param interval      Minimum number of time steps between checks
+     * \param max_interval  Maximum number of time steps between checks
+     * \param adaptive      Schedule the checks from the convergence rate
+     *                      (otherwise check every interval time steps)
+     */
+    ConvergenceMonitor(double tolerance, int interval, int max_interval,
+                       bool adaptive = false);
+
+    //! Start a new solve at time step 0 (the rate estimate is kept)
+    void reset();
+
+    //! Returns true if the error should be computed at this time step
+    bool check(int timestep) const { return timestep >= next_check; }
+
+    //! The time step of the next check
+    int next() const { return next_check; }
+
+    /**
+     * \brief Record the global error and schedule the next check
+     * \param timestep  Time step at which the error was measured
+     * \param error     Global error
+     */
+    void update(int timestep, double error);
+
+    //! Estimated decay rate of log(error) per time step (0 if unknown)
+    double rate() const { return decay_rate; }
+
+    //! Predicted number of time steps to reach the tolerance (-1 if unknown)
+    int remaining() const;
+
+    //! Number of checks since the last reset
+    int checks() const { return count; }
+
+private:
+    double tolerance;
+    int interval, max_interval;
+    bool adaptive;
+    int next_check;
+    int count;
+    double decay_rate;
+    std::vector<double> history_t, history_log;
+};
+
+#endif
@@ -494,6 +494,7 @@ void Domain::Decomp(const std::string &Filename) {
     int64_t xStart, yStart, zStart;
     int checkerSize;
     bool USE_CHECKER = false;
+    bool ParallelRead = false;
     //int inlet_layers_x, inlet_layers_y, inlet_layers_z;
     //int outlet_layers_x, outlet_layers_y, outlet_layers_z;
     xStart = yStart = zStart = 0;
@@ -546,6 +547,9 @@ void Domain::Decomp(const std::string &Filename) {
     if (database->keyExists("OutletLayersPhase")) {
         outlet_layers_phase = database->getScalar<int>("OutletLayersPhase");
     }
+    if (database->keyExists("ParallelRead")) {
+        ParallelRead = database->getScalar<bool>("ParallelRead");
+    }
     auto ReadValues = database->getVector<int>("ReadValues");
     auto WriteValues = database->getVector<int>("WriteValues");
     auto ReadType = database->getScalar<std::string>("ReadType");
@@ -562,6 +566,11 @@ void Domain::Decomp(const std::string &Filename) {
     if (ReadType == "swc") {
     	read_swc(Filename);
     }
+    else if (ParallelRead) {
+        /* each rank reads the part of the image that it needs */
+        ReadSubdomain(Filename, ReadType, ReadValues, WriteValues, USE_CHECKER,
+                      checkerSize);
+    }
     else {
     	nx = size[0];
     	ny = size[1];
@@ -911,6 +920,281 @@ void Domain::Decomp(const std::string &Filename) {
     ComputePorosity();
 }
 
+// Read columns x0 to x1 of rows y0 to y1 of plane z from a raw image and
+// convert to 8-bit
+static void ReadImageRows(FILE *SEGDAT, const std::string &ReadType, int64_t z,
+                          int64_t y0, int64_t y1, int64_t x0, int64_t x1,
+                          int64_t global_Nx, int64_t global_Ny, char *SegData) {
+    int64_t width = x1 - x0 + 1;
+    int64_t bytes = (ReadType == "16bit") ? 2 : 1;
+    // read whole rows at once when they are contiguous in the file
+    int64_t rows = (width == global_Nx) ? 1 : y1 - y0 + 1;
+    int64_t count = (width == global_Nx) ? (y1 - y0 + 1) * global_Nx : width;
+    std::vector<short int> InputData(bytes == 2 ? count : 0);
+    for (int64_t r = 0; r < rows; r++) {
+        int64_t offset = (z * global_Ny + y0 + r) * global_Nx + x0;
+        char *dst = &SegData[r * width];
+        size_t ReadSeg;
+        fseeko(SEGDAT, bytes * offset, SEEK_SET);
+        if (bytes == 2) {
+            ReadSeg = fread(InputData.data(), 2, count, SEGDAT);
+            for (int64_t n = 0; n < count; n++)
+                dst[n] = char(InputData[n]);
+        } else {
+            ReadSeg = fread(dst, 1, count, SEGDAT);
+        }
+        if (ReadSeg != size_t(count))
+            ERROR("Domain.cpp: Error reading segmented data");
+    }
+}
+
+// Replace each value in ReadValues with the matching value in WriteValues
+static void RelabelImage(char *SegData, int64_t count,
+                         const std::vector<int> &ReadValues,
+                         const std::vector<int> &WriteValues) {
+    for (int64_t n = 0; n < count; n++) {
+        signed char locval = SegData[n];
+        for (size_t idx = 0; idx < ReadValues.size(); idx++) {
+            signed char oldvalue = ReadValues[idx];
+            signed char newvalue = WriteValues[idx];
+            if (locval == oldvalue) {
+                SegData[n] = newvalue;
+                idx = ReadValues.size();
+            }
+        }
+    }
+}
+
+void Domain::ReadSubdomain(const std::string &Filename,
+                           const std::string &ReadType,
+                           const std::vector<int> &ReadValues,
+                           const std::vector<int> &WriteValues,
+                           bool USE_CHECKER, int checkerSize) {
+    int RANK = rank();
+    auto SIZE = database->getVector<int>("N");
+    int64_t global_Nx = SIZE[0];
+    int64_t global_Ny = SIZE[1];
+    int64_t global_Nz = SIZE[2];
+    int64_t nx = Nx - 2;
+    int64_t ny = Ny - 2;
+    int64_t nz = Nz - 2;
+    int64_t xStart = offset_x;
+    int64_t yStart = offset_y;
+    int64_t zStart = offset_z;
+    int64_t xEnd = xStart + nx * nprocx();
+    int64_t yEnd = yStart + ny * nprocy();
+    int64_t zEnd = zStart + nz * nprocz();
+    int64_t ip = iproc();
+    int64_t jp = jproc();
+    int64_t kp = kproc();
+
+    if (RANK == 0) {
+        printf("Input media: %s\n", Filename.c_str());
+        printf("Relabeling %lu values\n", ReadValues.size());
+        for (size_t idx = 0; idx < ReadValues.size(); idx++) {
+            int oldvalue = ReadValues[idx];
+            int newvalue = WriteValues[idx];
+            printf("oldvalue=%d, newvalue =%d \n", oldvalue, newvalue);
+        }
+        printf("Dimensions of segmented image: %ld x %ld x %ld \n", global_Nx,
+               global_Ny, global_Nz);
+        printf("Reading %s input data in parallel \n", ReadType.c_str());
+    }
+
+    // number of sites to use for periodic boundary condition transition zone
+    int64_t z_transition_size = (nprocz() * nz - (global_Nz - zStart)) / 2;
+    if (z_transition_size < 0)
+        z_transition_size = 0;
+
+    // Part of the image covered by this sub-domain (including the halo)
+    auto clamp = [](int64_t v, int64_t lo, int64_t hi) {
+        return (v < lo) ? lo : ((v > hi) ? hi : v);
+    };
+    int64_t x0 = clamp(xStart + ip * nx - 1, xStart, global_Nx - 1);
+    int64_t x1 = clamp(xStart + ip * nx + nx, xStart, global_Nx - 1);
+    int64_t y0 = clamp(yStart + jp * ny - 1, yStart, global_Ny - 1);
+    int64_t y1 = clamp(yStart + jp * ny + ny, yStart, global_Ny - 1);
+    int64_t z0 = clamp(zStart + kp * nz - 1 - z_transition_size, zStart,
+                       global_Nz - 1);
+    int64_t z1 = clamp(zStart + kp * nz + nz - z_transition_size, zStart,
+                       global_Nz - 1);
+    int64_t width = x1 - x0 + 1;
+    int64_t plane_size = (y1 - y0 + 1) * width;
+    std::vector<char> SegData((z1 - z0 + 1) * plane_size);
+
+    // The mixed inlet / outlet layers reflect the opposite end of the image
+    bool InletReflection = !USE_CHECKER && inlet_layers_z > 0 &&
+                           z0 < zStart + inlet_layers_z;
+    bool OutletReflection = !USE_CHECKER && outlet_layers_z > 0 &&
+                            !(z1 < zEnd - outlet_layers_z);
+    std::vector<char> InletPlane, OutletPlane;
+
+    FILE *SEGDAT = fopen(Filename.c_str(), "rb");
+    if (SEGDAT == NULL)
+        ERROR("Domain.cpp: Error reading segmented data");
+    for (int64_t z = z0; z <= z1; z++)
+        ReadImageRows(SEGDAT, ReadType, z, y0, y1, x0, x1, global_Nx,
+                      global_Ny, &SegData[(z - z0) * plane_size]);
+    if (InletReflection || (OutletReflection && inlet_layers_z > 0)) {
+        // the inlet layers are mixed with the last plane of the domain
+        if (!(zEnd - 1 < global_Nz))
+            ERROR("Domain.cpp: the last plane of the domain used to mix the "
+                  "inlet layers is outside the image");
+        InletPlane.resize(plane_size);
+        ReadImageRows(SEGDAT, ReadType, zEnd - 1, y0, y1, x0, x1, global_Nx,
+                      global_Ny, InletPlane.data());
+        RelabelImage(InletPlane.data(), plane_size, ReadValues, WriteValues);
+    }
+    if (OutletReflection) {
+        // the outlet layers are mixed with the first plane (after mixing the inlet)
+        OutletPlane.resize(plane_size);
+        ReadImageRows(SEGDAT, ReadType, zStart, y0, y1, x0, x1, global_Nx,
+                      global_Ny, OutletPlane.data());
+        RelabelImage(OutletPlane.data(), plane_size, ReadValues, WriteValues);
+        for (int64_t n = 0; n < plane_size && inlet_layers_z > 0; n++) {
+            signed char local_id = OutletPlane[n];
+            signed char reflection_id = InletPlane[n];
+            if (local_id < 1 && reflection_id > 0)
+                OutletPlane[n] = reflection_id;
+        }
+    }
+    fclose(SEGDAT);
+
+    // count the labels in the part of the image owned by this sub-domain
+    std::vector<long int> LabelCount(ReadValues.size(), 0);
+    for (int64_t k = 1; k < nz + 1; k++) {
+        for (int64_t j = 1; j < ny + 1; j++) {
+            for (int64_t i = 1; i < nx + 1; i++) {
+                int64_t x = xStart + ip * nx + i - 1;
+                int64_t y = yStart + jp * ny + j - 1;
+                int64_t z = zStart + kp * nz + k - 1 - z_transition_size;
+                if (x < xStart || !(x < global_Nx) || y < yStart ||
+                    !(y < global_Ny) || z < zStart || !(z < global_Nz))
+                    continue;
+                signed char locval =
+                    SegData[(z - z0) * plane_size + (y - y0) * width + x - x0];
+                for (size_t idx = 0; idx < ReadValues.size(); idx++) {
+                    if (locval == (signed char)ReadValues[idx]) {
+                        LabelCount[idx]++;
+                        idx = ReadValues.size();
+                    }
+                }
+            }
+        }
+    }
+    RelabelImage(SegData.data(), SegData.size(), ReadValues, WriteValues);
+    if (ReadValues.size() > 0)
+        Comm.sumReduce(LabelCount.data(), ReadValues.size());
+    if (RANK == 0) {
+        for (size_t idx = 0; idx < ReadValues.size(); idx++) {
+            long int label = ReadValues[idx];
+            long int count = LabelCount[idx];
+            printf("Label=%ld, Count=%ld \n", label, count);
+        }
+    }
+
+    if (RANK == 0) {
+        if (USE_CHECKER) {
+            if (inlet_layers_x > 0)
+                printf("Checkerboard pattern at x inlet for %i layers \n",
+                       inlet_layers_x);
+            if (inlet_layers_y > 0)
+                printf("Checkerboard pattern at y inlet for %i layers \n",
+                       inlet_layers_y);
+            if (inlet_layers_z > 0)
+                printf("Checkerboard pattern at z inlet for %i layers, "
+                       "saturated with phase label=%i \n",
+                       inlet_layers_z, inlet_layers_phase);
+            if (outlet_layers_x > 0)
+                printf("Checkerboard pattern at x outlet for %i layers \n",
+                       outlet_layers_x);
+            if (outlet_layers_y > 0)
+                printf("Checkerboard pattern at y outlet for %i layers \n",
+                       outlet_layers_y);
+            if (outlet_layers_z > 0)
+                printf("Checkerboard pattern at z outlet for %i layers, "
+                       "saturated with phase label=%i \n",
+                       outlet_layers_z, outlet_layers_phase);
+        } else {
+            if (inlet_layers_z > 0)
+                printf("Mixed reflection pattern at z inlet for %i layers, "
+                       "saturated with phase label=%i \n",
+                       inlet_layers_z, inlet_layers_phase);
+            if (outlet_layers_z > 0)
+                printf("Mixed reflection pattern at z outlet for %i layers, "
+                       "saturated with phase label=%i \n",
+                       outlet_layers_z, outlet_layers_phase);
+        }
+    }
+
+    // inlet and outlet layers (same order as the serial decomposition)
+    for (int64_t z = z0; z <= z1; z++) {
+        for (int64_t y = y0; y <= y1; y++) {
+            for (int64_t x = x0; x <= x1; x++) {
+                char &value =
+                    SegData[(z - z0) * plane_size + (y - y0) * width + x - x0];
+                if (USE_CHECKER) {
+                    if (!(x < xStart) && x < xStart + inlet_layers_x)
+                        value = ((y / checkerSize + z / checkerSize) % 2 == 0) ? 2 : 0;
+                    if (!(y < yStart) && y < yStart + inlet_layers_y)
+                        value = ((x / checkerSize + z / checkerSize) % 2 == 0) ? 2 : 0;
+                    if (!(z < zStart) && z < zStart + inlet_layers_z)
+                        value = ((x / checkerSize + y / checkerSize) % 2 == 0)
+                                    ? inlet_layers_phase
+                                    : 0;
+                    if (!(x < xEnd - outlet_layers_x) && x < xEnd)
+                        value = ((y / checkerSize + z / checkerSize) % 2 == 0) ? 2 : 0;
+                    if (!(y < yEnd - outlet_layers_y) && y < yEnd)
+                        value = ((x / checkerSize + z / checkerSize) % 2 == 0) ? 2 : 0;
+                    if (!(z < zEnd - outlet_layers_z) && z < zEnd)
+                        value = ((x / checkerSize + y / checkerSize) % 2 == 0)
+                                    ? outlet_layers_phase
+                                    : 0;
+                } else {
+                    int64_t n = (y - y0) * width + x - x0;
+                    if (InletReflection && !(z < zStart) &&
+                        z < zStart + inlet_layers_z) {
+                        signed char local_id = value;
+                        signed char reflection_id = InletPlane[n];
+                        if (local_id < 1 && reflection_id > 0)
+                            value = reflection_id;
+                    }
+                    if (OutletReflection && !(z < zEnd - outlet_layers_z) &&
+                        z < zEnd) {
+                        signed char local_id = value;
+                        signed char reflection_id = OutletPlane[n];
+                        if (local_id < 1 && reflection_id > 0)
+                            value = reflection_id;
+                    }
+                }
+            }
+        }
+    }
+
+    // Copy into the local sub-domain
+    for (int64_t k = 0; k < nz + 2; k++) {
+        for (int64_t j = 0; j < ny + 2; j++) {
+            for (int64_t i = 0; i < nx + 2; i++) {
+                int64_t x = clamp(xStart + ip * nx + i - 1, xStart, global_Nx - 1);
+                int64_t y = clamp(yStart + jp * ny + j - 1, yStart, global_Ny - 1);
+                int64_t z = clamp(zStart + kp * nz + k - 1 - z_transition_size,
+                                  zStart, global_Nz - 1);
+                id[k * Nx * Ny + j * Nx + i] =
+                    SegData[(z - z0) * plane_size + (y - y0) * width + x - x0];
+            }
+        }
+    }
+    if (RANK == 0)
+        printf("Read segmented data from %s \n", Filename.c_str());
+
+    // Write the data for this rank
+    char LocalRankFilename[40];
+    sprintf(LocalRankFilename, "ID.%05i", RANK);
+    FILE *ID = fopen(LocalRankFilename, "wb");
+    fwrite(id.data(), 1, N, ID);
+    fclose(ID);
+}
+
 void Domain::ComputePorosity() {
 	// Compute the porosity
 	double sum;
@@ -1416,163 +1700,90 @@ int Domain::PoreCount() {
     return Npore;
 }
 
+// Directions used by the mesh halo exchange (the opposite of direction d is d^1)
+static const char *haloDir[18] = {"x",  "X",  "y",  "Y",  "z",  "Z",
+                                  "xy", "XY", "xY", "Xy", "xz", "XZ",
+                                  "xZ", "Xz", "yz", "YZ", "yZ", "Yz"};
+static const int haloOffset[18][3] = {
+    {-1, 0, 0},  {1, 0, 0},  {0, -1, 0}, {0, 1, 0},  {0, 0, -1}, {0, 0, 1},
+    {-1, -1, 0}, {1, 1, 0},  {-1, 1, 0}, {1, -1, 0}, {-1, 0, -1}, {1, 0, 1},
+    {-1, 0, 1},  {1, 0, -1}, {0, -1, -1}, {0, 1, 1}, {0, -1, 1}, {0, 1, -1}};
+
 void Domain::CommunicateMeshHalo(DoubleArray &Mesh) {
-    int sendtag, recvtag;
-    sendtag = recvtag = 7;
-    double *MeshData = Mesh.data();
-    // send buffers
-    auto sendData_x = new double[sendCount("x")];
-    auto sendData_y = new double[sendCount("y")];
-    auto sendData_z = new double[sendCount("z")];
-    auto sendData_X = new double[sendCount("X")];
-    auto sendData_Y = new double[sendCount("Y")];
-    auto sendData_Z = new double[sendCount("Z")];
-    auto sendData_xy = new double[sendCount("xy")];
-    auto sendData_yz = new double[sendCount("yz")];
-    auto sendData_xz = new double[sendCount("xz")];
-    auto sendData_Xy = new double[sendCount("Xy")];
-    auto sendData_Yz = new double[sendCount("Yz")];
-    auto sendData_xZ = new double[sendCount("xZ")];
-    auto sendData_xY = new double[sendCount("xY")];
-    auto sendData_yZ = new double[sendCount("yZ")];
-    auto sendData_Xz = new double[sendCount("Xz")];
-    auto sendData_XY = new double[sendCount("XY")];
-    auto sendData_YZ = new double[sendCount("YZ")];
-    auto sendData_XZ = new double[sendCount("XZ")];
-    // recv buffers
-    auto recvData_x = new double[recvCount("x")];
-    auto recvData_y = new double[recvCount("y")];
-    auto recvData_z = new double[recvCount("z")];
-    auto recvData_X = new double[recvCount("X")];
-    auto recvData_Y = new double[recvCount("Y")];
-    auto recvData_Z = new double[recvCount("Z")];
-    auto recvData_xy = new double[recvCount("xy")];
-    auto recvData_yz = new double[recvCount("yz")];
-    auto recvData_xz = new double[recvCount("xz")];
-    auto recvData_Xy = new double[recvCount("Xy")];
-    auto recvData_xZ = new double[recvCount("xZ")];
-    auto recvData_xY = new double[recvCount("xY")];
-    auto recvData_yZ = new double[recvCount("yZ")];
-    auto recvData_Yz = new double[recvCount("Yz")];
-    auto recvData_Xz = new double[recvCount("Xz")];
-    auto recvData_XY = new double[recvCount("XY")];
-    auto recvData_YZ = new double[recvCount("YZ")];
-    auto recvData_XZ = new double[recvCount("XZ")];
-    // Pack data
-    PackMeshData(sendList("x"), sendCount("x"), sendData_x, MeshData);
-    PackMeshData(sendList("X"), sendCount("X"), sendData_X, MeshData);
-    PackMeshData(sendList("y"), sendCount("y"), sendData_y, MeshData);
-    PackMeshData(sendList("Y"), sendCount("Y"), sendData_Y, MeshData);
-    PackMeshData(sendList("z"), sendCount("z"), sendData_z, MeshData);
-    PackMeshData(sendList("Z"), sendCount("Z"), sendData_Z, MeshData);
-    PackMeshData(sendList("xy"), sendCount("xy"), sendData_xy, MeshData);
-    PackMeshData(sendList("Xy"), sendCount("Xy"), sendData_Xy, MeshData);
-    PackMeshData(sendList("xY"), sendCount("xY"), sendData_xY, MeshData);
-    PackMeshData(sendList("XY"), sendCount("XY"), sendData_XY, MeshData);
-    PackMeshData(sendList("xz"), sendCount("xz"), sendData_xz, MeshData);
-    PackMeshData(sendList("Xz"), sendCount("Xz"), sendData_Xz, MeshData);
-    PackMeshData(sendList("xZ"), sendCount("xZ"), sendData_xZ, MeshData);
-    PackMeshData(sendList("XZ"), sendCount("XZ"), sendData_XZ, MeshData);
-    PackMeshData(sendList("yz"), sendCount("yz"), sendData_yz, MeshData);
-    PackMeshData(sendList("Yz"), sendCount("Yz"), sendData_Yz, MeshData);
-    PackMeshData(sendList("yZ"), sendCount("yZ"), sendData_yZ, MeshData);
-    PackMeshData(sendList("YZ"), sendCount("YZ"), sendData_YZ, MeshData);
-    // send/recv
-    Comm.sendrecv(sendData_x, sendCount("x"), rank_x(), sendtag, recvData_X,
-                  recvCount("X"), rank_X(), recvtag);
-    Comm.sendrecv(sendData_X, sendCount("X"), rank_X(), sendtag, recvData_x,
-                  recvCount("x"), rank_x(), recvtag);
-    Comm.sendrecv(sendData_y, sendCount("y"), rank_y(), sendtag, recvData_Y,
-                  recvCount("Y"), rank_Y(), recvtag);
-    Comm.sendrecv(sendData_Y, sendCount("Y"), rank_Y(), sendtag, recvData_y,
-                  recvCount("y"), rank_y(), recvtag);
-    Comm.sendrecv(sendData_z, sendCount("z"), rank_z(), sendtag, recvData_Z,
-                  recvCount("Z"), rank_Z(), recvtag);
-    Comm.sendrecv(sendData_Z, sendCount("Z"), rank_Z(), sendtag, recvData_z,
-                  recvCount("z"), rank_z(), recvtag);
-    Comm.sendrecv(sendData_xy, sendCount("xy"), rank_xy(), sendtag, recvData_XY,
-                  recvCount("XY"), rank_XY(), recvtag);
-    Comm.sendrecv(sendData_XY, sendCount("XY"), rank_XY(), sendtag, recvData_xy,
-                  recvCount("xy"), rank_xy(), recvtag);
-    Comm.sendrecv(sendData_Xy, sendCount("Xy"), rank_Xy(), sendtag, recvData_xY,
-                  recvCount("xY"), rank_xY(), recvtag);
-    Comm.sendrecv(sendData_xY, sendCount("xY"), rank_xY(), sendtag, recvData_Xy,
-                  recvCount("Xy"), rank_Xy(), recvtag);
-    Comm.sendrecv(sendData_xz, sendCount("xz"), rank_xz(), sendtag, recvData_XZ,
-                  recvCount("XZ"), rank_XZ(), recvtag);
-    Comm.sendrecv(sendData_XZ, sendCount("XZ"), rank_XZ(), sendtag, recvData_xz,
-                  recvCount("xz"), rank_xz(), recvtag);
-    Comm.sendrecv(sendData_Xz, sendCount("Xz"), rank_Xz(), sendtag, recvData_xZ,
-                  recvCount("xZ"), rank_xZ(), recvtag);
-    Comm.sendrecv(sendData_xZ, sendCount("xZ"), rank_xZ(), sendtag, recvData_Xz,
-                  recvCount("Xz"), rank_Xz(), recvtag);
-    Comm.sendrecv(sendData_yz, sendCount("yz"), rank_yz(), sendtag, recvData_YZ,
-                  recvCount("YZ"), rank_YZ(), recvtag);
-    Comm.sendrecv(sendData_YZ, sendCount("YZ"), rank_YZ(), sendtag, recvData_yz,
-                  recvCount("yz"), rank_yz(), recvtag);
-    Comm.sendrecv(sendData_Yz, sendCount("Yz"), rank_Yz(), sendtag, recvData_yZ,
-                  recvCount("yZ"), rank_yZ(), recvtag);
-    Comm.sendrecv(sendData_yZ, sendCount("yZ"), rank_yZ(), sendtag, recvData_Yz,
-                  recvCount("Yz"), rank_Yz(), recvtag);
-    // unpack data
-    UnpackMeshData(recvList("x"), recvCount("x"), recvData_x, MeshData);
-    UnpackMeshData(recvList("X"), recvCount("X"), recvData_X, MeshData);
-    UnpackMeshData(recvList("y"), recvCount("y"), recvData_y, MeshData);
-    UnpackMeshData(recvList("Y"), recvCount("Y"), recvData_Y, MeshData);
-    UnpackMeshData(recvList("z"), recvCount("z"), recvData_z, MeshData);
-    UnpackMeshData(recvList("Z"), recvCount("Z"), recvData_Z, MeshData);
-    UnpackMeshData(recvList("xy"), recvCount("xy"), recvData_xy, MeshData);
-    UnpackMeshData(recvList("Xy"), recvCount("Xy"), recvData_Xy, MeshData);
-    UnpackMeshData(recvList("xY"), recvCount("xY"), recvData_xY, MeshData);
-    UnpackMeshData(recvList("XY"), recvCount("XY"), recvData_XY, MeshData);
-    UnpackMeshData(recvList("xz"), recvCount("xz"), recvData_xz, MeshData);
-    UnpackMeshData(recvList("Xz"), recvCount("Xz"), recvData_Xz, MeshData);
-    UnpackMeshData(recvList("xZ"), recvCount("xZ"), recvData_xZ, MeshData);
-    UnpackMeshData(recvList("XZ"), recvCount("XZ"), recvData_XZ, MeshData);
-    UnpackMeshData(recvList("yz"), recvCount("yz"), recvData_yz, MeshData);
-    UnpackMeshData(recvList("Yz"), recvCount("Yz"), recvData_Yz, MeshData);
-    UnpackMeshData(recvList("yZ"), recvCount("yZ"), recvData_yZ, MeshData);
-    UnpackMeshData(recvList("YZ"), recvCount("YZ"), recvData_YZ, MeshData);
-    // Free sendData
-    delete[] sendData_x;
-    delete[] sendData_y;
-    delete[] sendData_z;
-    delete[] sendData_X;
-    delete[] sendData_Y;
-    delete[] sendData_Z;
-    delete[] sendData_xy;
-    delete[] sendData_xY;
-    delete[] sendData_Xy;
-    delete[] sendData_XY;
-    delete[] sendData_xz;
-    delete[] sendData_xZ;
-    delete[] sendData_Xz;
-    delete[] sendData_XZ;
-    delete[] sendData_yz;
-    delete[] sendData_yZ;
-    delete[] sendData_Yz;
-    delete[] sendData_YZ;
-    // Free recvData
-    delete[] recvData_x;
-    delete[] recvData_y;
-    delete[] recvData_z;
-    delete[] recvData_X;
-    delete[] recvData_Y;
-    delete[] recvData_Z;
-    delete[] recvData_xy;
-    delete[] recvData_xY;
-    delete[] recvData_Xy;
-    delete[] recvData_XY;
-    delete[] recvData_xz;
-    delete[] recvData_xZ;
-    delete[] recvData_Xz;
-    delete[] recvData_XZ;
-    delete[] recvData_yz;
-    delete[] recvData_yZ;
-    delete[] recvData_Yz;
-    delete[] recvData_YZ;
+    auto exchange = CommunicateMeshHaloStart({&Mesh});
+    CommunicateMeshHaloFinish(exchange);
+}
+
+void Domain::CommunicateMeshHalo(const std::vector<DoubleArray *> &Mesh) {
+    auto exchange = CommunicateMeshHaloStart(Mesh);
+    CommunicateMeshHaloFinish(exchange);
+}
+
+MeshHaloExchange
+Domain::CommunicateMeshHaloStart(const std::vector<DoubleArray *> &Mesh) const {
+    for (auto mesh : Mesh) {
+        if ((int)mesh->length() != Nx * Ny * Nz)
+            ERROR("CommunicateMeshHaloStart: array does not match the domain");
+    }
+    MeshHaloExchange exchange;
+    if (Mesh.empty())
+        return exchange;
+    exchange.d_domain = this;
+    exchange.d_mesh = Mesh;
+    int nfields = Mesh.size();
+    // Use a tag range that does not overlap fillHalo so both may be active at once
+    // (overlapping mesh exchanges are matched by the MPI message ordering)
+    const int tag = 1200;
+    for (int d = 0; d < 18; d++) {
+        // Data for direction d is sent to rank(d) and received from rank(opposite)
+        int opp = d ^ 1;
+        int send_rank = rank_info.rank[1 + haloOffset[d][0]][1 + haloOffset[d][1]]
+                                      [1 + haloOffset[d][2]];
+        int recv_rank = rank_info.rank[1 + haloOffset[opp][0]]
+                                      [1 + haloOffset[opp][1]]
+                                      [1 + haloOffset[opp][2]];
+        int send_count = sendCount(haloDir[d]);
+        int recv_count = recvCount(haloDir[opp]);
+        auto &sendbuf = exchange.d_send[d];
+        auto &recvbuf = exchange.d_recv[d];
+        sendbuf.resize(nfields * send_count);
+        recvbuf.resize(nfields * recv_count);
+        for (int f = 0; f < nfields; f++)
+            PackMeshData(sendList(haloDir[d]), send_count,
+                         &sendbuf[f * send_count], Mesh[f]->data());
+        exchange.d_req[2 * d] =
+            Comm.Irecv(recvbuf.data(), nfields * recv_count, recv_rank, tag + d);
+        exchange.d_req[2 * d + 1] =
+            Comm.Isend(sendbuf.data(), nfields * send_count, send_rank, tag + d);
+    }
+    return exchange;
+}
+
+void Domain::CommunicateMeshHaloFinish(MeshHaloExchange &exchange) const {
+    if (!exchange.active())
+        return;
+    if (exchange.d_domain != this)
+        ERROR("CommunicateMeshHaloFinish: exchange was started by another domain");
+    Utilities::MPI::waitAll(36, exchange.d_req);
+    int nfields = exchange.d_mesh.size();
+    for (int d = 0; d < 18; d++) {
+        int opp = d ^ 1;
+        int recv_count = recvCount(haloDir[opp]);
+        for (int f = 0; f < nfields; f++)
+            UnpackMeshData(recvList(haloDir[opp]), recv_count,
+                           &exchange.d_recv[d][f * recv_count],
+                           exchange.d_mesh[f]->data());
+    }
+    exchange.d_mesh.clear();
+}
+
+void MeshHaloExchange::finish() {
+    if (active())
+        d_domain->CommunicateMeshHaloFinish(*this);
 }
 
+MeshHaloExchange::~MeshHaloExchange() { finish(); }
+
 // Ideally stuff below here should be moved somewhere else -- doesn't really belong here
 void WriteCheckpoint(const char *FILENAME, const double *cDen,
                      const double *cfq, size_t Np) {
@@ -50,6 +50,39 @@ public:
 };
 
 class Patch;
+class Domain;
+
+/**
+ * \class MeshHaloExchange
+ *
+ * @details
+ * Handle for a split-phase mesh halo exchange returned by Domain::CommunicateMeshHaloStart.
+ * The handle owns the message buffers and requests, so several exchanges may be in flight at once
+ * (they must be started in the same order on every rank).  The exchange is completed by finish()
+ * or, if it is still active, when the handle is destroyed.
+ */
+class MeshHaloExchange {
+public:
+    MeshHaloExchange() = default;
+    MeshHaloExchange(MeshHaloExchange &&) = default;
+    MeshHaloExchange(const MeshHaloExchange &) = delete;
+    MeshHaloExchange &operator=(const MeshHaloExchange &) = delete;
+    MeshHaloExchange &operator=(MeshHaloExchange &&) = delete;
+    ~MeshHaloExchange();
+
+    //! Wait for the messages and unpack the halo values (does nothing if the exchange is not active)
+    void finish();
+
+    //! Check if the exchange has been started and not yet finished
+    inline bool active() const { return !d_mesh.empty(); }
+
+private:
+    friend class Domain;
+    const Domain *d_domain = nullptr;
+    std::vector<DoubleArray *> d_mesh;
+    std::vector<double> d_send[18], d_recv[18];
+    MPI_Request d_req[36];
+};
 
 /**
  * \class Domain
@@ -226,6 +259,31 @@ public: // Public variables (need to create accessors instead)
     */
     void CommunicateMeshHalo(DoubleArray &Mesh);
 
+    /** 
+     * \brief Perform a halo exchange for several arrays using MPI
+     * @details The arrays are packed into one message per neighbor
+     * @param Mesh - arrays that hold scalar values (each of size [Nx, Ny, Nz])
+    */
+    void CommunicateMeshHalo(const std::vector<DoubleArray *> &Mesh);
+
+    /** 
+     * \brief Start a halo exchange for several arrays
+     * @details Packs the arrays and posts the non-blocking sends and receives.
+     *     The interior of the arrays may be used while the exchange is in progress,
+     *     but the arrays must not be modified or destroyed until the exchange is finished.
+     *     Each call returns its own handle, so independent exchanges may overlap.
+     * @param Mesh - arrays that hold scalar values (each of size [Nx, Ny, Nz])
+     * @return handle that completes the exchange (see MeshHaloExchange::finish)
+    */
+    MeshHaloExchange CommunicateMeshHaloStart(const std::vector<DoubleArray *> &Mesh) const;
+
+    /** 
+     * \brief Finish a halo exchange started with CommunicateMeshHaloStart
+     * @details Waits for the messages and unpacks the halo values
+     * @param exchange - handle returned by CommunicateMeshHaloStart
+    */
+    void CommunicateMeshHaloFinish(MeshHaloExchange &exchange) const;
+
     /** 
      * \brief Initialize communication data structures within Domain object. 
      * This routine needs to be called before the communication functionality will work
@@ -259,6 +317,20 @@ public: // Public variables (need to create accessors instead)
     void AggregateLabels(const std::string &filename, DoubleArray &UserData);
 
 private:
+    /**
+     * \brief Read the part of a segmented image needed by this process (ParallelRead mode of Decomp)
+     * @param Filename - name of the 8-bit or 16-bit raw image
+     * @param ReadType - 8bit or 16bit
+     * @param ReadValues - labels to replace
+     * @param WriteValues - new values for the labels
+     * @param USE_CHECKER - use a checkerboard pattern for the inlet / outlet layers
+     * @param checkerSize - size of the checkers
+     */
+    void ReadSubdomain(const std::string &Filename, const std::string &ReadType,
+                       const std::vector<int> &ReadValues,
+                       const std::vector<int> &WriteValues, bool USE_CHECKER,
+                       int checkerSize);
+
     /**
      * \brief Pack halo data for 8-bit integer
      * @param list - list of values in the halo
@@ -3710,6 +3710,20 @@ std::shared_ptr<MPI_Request> MPI::Irecv_init<double>(double *buf, int N, int pro
     MPI_Recv_init( buf, N, MPI_DOUBLE, proc, tag, communicator, obj.get() );
     return obj;
 }
+template <>
+std::shared_ptr<MPI_Request> MPI::Isend_init<float>(const float *buf, int N, int proc, int tag) const
+{
+    std::shared_ptr<MPI_Request> obj( new MPI_Request, []( MPI_Request *req ) { MPI_Request_free( req ); delete req; } );
+    MPI_Send_init( buf, N, MPI_FLOAT, proc, tag, communicator, obj.get() );
+    return obj;
+}
+template<>
+std::shared_ptr<MPI_Request> MPI::Irecv_init<float>(float *buf, int N, int proc, int tag) const
+{
+    std::shared_ptr<MPI_Request> obj( new MPI_Request, []( MPI_Request *req ) { MPI_Request_free( req ); delete req; } );
+    MPI_Recv_init( buf, N, MPI_FLOAT, proc, tag, communicator, obj.get() );
+    return obj;
+}
 void MPI::Start( MPI_Request &request )
 {
     MPI_Start( &request );
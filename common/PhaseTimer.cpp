@@ -0,0 +1,93 @@
+/*
+This class accumulates the time spent in each phase of a time step
+ */
+#include "common/PhaseTimer.h"
+#include "common/ScaLBL.h"
+#include "common/Utilities.h"
+
+#include <stdio.h>
+
+static const char *PhaseNames[PhaseTimer::N_PHASES] = {
+    "interior", "exterior", "pack", "wait", "bc", "analysis"};
+
+PhaseTimer::PhaseTimer(const Utilities::MPI &comm_)
+    : comm(comm_), enabled(false), depth(0), tic(0) {
+    reset();
+}
+
+const char *PhaseTimer::name(Phase phase) { return PhaseNames[phase]; }
+
+void PhaseTimer::reset() {
+    for (int p = 0; p < N_PHASES; p++) {
+        time[p] = 0.0;
+        count[p] = 0;
+    }
+    start_time = Utilities::MPI::time();
+    tic = start_time;
+}
+
+void PhaseTimer::push(Phase phase) {
+    if (depth == MAX_DEPTH)
+        ERROR("PhaseTimer: phases nested too deeply");
+    ScaLBL_DeviceBarrier();
+    double toc = Utilities::MPI::time();
+    if (depth > 0)
+        time[stack[depth - 1]] += toc - tic;
+    stack[depth++] = phase;
+    count[phase]++;
+    tic = toc;
+}
+
+void PhaseTimer::pop() {
+    if (depth == 0)
+        ERROR("PhaseTimer: stop() called without a matching start()");
+    ScaLBL_DeviceBarrier();
+    double toc = Utilities::MPI::time();
+    time[stack[--depth]] += toc - tic;
+    tic = toc;
+}
+
+void PhaseTimer::write(int timestep, const std::string &prefix) {
+    if (!enabled)
+        return;
+    // the last entry holds the total elapsed time since the last reset
+    const int N = N_PHASES + 1;
+    double local[N], tmin[N], tmax[N], tsum[N];
+    int rank_of_max[N];
+    for (int p = 0; p < N_PHASES; p++)
+        local[p] = time[p];
+    local[N_PHASES] = Utilities::MPI::time() - start_time;
+    comm.minReduce(local, tmin, N);
+    comm.maxReduce(local, tmax, N, rank_of_max);
+    comm.sumReduce(local, tsum, N);
+    int nprocs = comm.getSize();
+
+    if (comm.getRank() == 0) {
+        std::string csv_name = prefix + ".csv";
+        FILE *csv = fopen(csv_name.c_str(), "r");
+        bool WriteHeader = (csv == NULL);
+        if (csv != NULL)
+            fclose(csv);
+        csv = fopen(csv_name.c_str(), "a");
+        if (WriteHeader)
+            fprintf(csv, "timestep phase min max mean max_rank\n");
+        FILE *json = fopen((prefix + ".json").c_str(), "a");
+        fprintf(json, "{\"timestep\": %i, \"ranks\": %i, \"phases\": {",
+                timestep, nprocs);
+        for (int p = 0; p < N; p++) {
+            const char *label = (p < N_PHASES) ? PhaseNames[p] : "total";
+            double mean = tsum[p] / nprocs;
+            fprintf(csv, "%i %s %.6g %.6g %.6g %i\n", timestep, label, tmin[p],
+                    tmax[p], mean, rank_of_max[p]);
+            fprintf(json,
+                    "%s\"%s\": {\"min\": %.6g, \"max\": %.6g, \"mean\": %.6g, "
+                    "\"max_rank\": %i}",
+                    (p > 0) ? ", " : "", label, tmin[p], tmax[p], mean,
+                    rank_of_max[p]);
+        }
+        fprintf(json, "}}\n");
+        fclose(csv);
+        fclose(json);
+    }
+    reset();
+}
@@ -0,0 +1,112 @@
+/*
+This class accumulates the time spent in each phase of a time step
+ */
+#ifndef PhaseTimer_H
+#define PhaseTimer_H
+#include "common/MPI.h"
+
+#include <string>
+
+/**
+ * \class PhaseTimer
+ * \brief Per-rank timers for the phases of the lattice Boltzmann time loop
+ * \details  The models and ScaLBL_Communicator bracket each part of a time
+ *   step with start()/stop().  Phases may be nested (e.g. a halo exchange
+ *   issued from within a boundary condition routine); the time of the inner
+ *   phase is excluded from the outer one, so the phase times on each rank add
+ *   up to the elapsed time.  When the timer is disabled start()/stop() return
+ *   immediately.  When enabled the device is synchronized at each phase
+ *   boundary so that asynchronous kernels are charged to the right phase.
+ *   write() reduces the accumulated times over all ranks (min/max/mean and
+ *   the rank holding the maximum), appends them to <prefix>.csv and
+ *   <prefix>.json on rank 0, and resets the timers.
+ */
+class PhaseTimer {
+public:
+    enum Phase {
+        INTERIOR = 0, //!< collision / streaming for interior sites
+        EXTERIOR,     //!< collision / streaming for exterior sites
+        PACK,         //!< packing and unpacking halo buffers
+        WAIT,         //!< waiting for MPI communication
+        BC,           //!< boundary conditions
+        ANALYSIS,     //!< in-situ analysis and I/O
+        N_PHASES
+    };
+
+    //! Constructor
+    PhaseTimer(const Utilities::MPI &comm);
+
+    //! Enable or disable timing
+    void enable(bool value) { enabled = value; }
+
+    //! Returns true if timing is enabled
+    bool isEnabled() const { return enabled; }
+
+    //! Begin a phase (pauses the enclosing phase)
+    inline void start(Phase phase) {
+        if (enabled)
+            push(phase);
+    }
+
+    //! End the current phase (resumes the enclosing phase)
+    inline void stop() {
+        if (enabled)
+            pop();
+    }
+
+    //! Time accumulated in a phase since the last reset (seconds)
+    double elapsed(Phase phase) const { return time[phase]; }
+
+    //! Number of times a phase was started since the last reset
+    int calls(Phase phase) const { return count[phase]; }
+
+    //! Reset the accumulated times
+    void reset();
+
+    /**
+     * \brief Reduce and write the accumulated times (collective)
+     * \param timestep  Time step to record
+     * \param prefix    Output files are <prefix>.csv and <prefix>.json
+     */
+    void write(int timestep, const std::string &prefix = "timing");
+
+    //! Name of a phase
+    static const char *name(Phase phase);
+
+    /**
+     * \class Scope
+     * \brief Start a phase for the lifetime of the object
+     */
+    class Scope {
+    public:
+        Scope(PhaseTimer *timer_, Phase phase) : timer(timer_) {
+            if (timer)
+                timer->start(phase);
+        }
+        ~Scope() {
+            if (timer)
+                timer->stop();
+        }
+
+    private:
+        PhaseTimer *timer;
+    };
+
+private:
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    enum { MAX_DEPTH = 8 };
+    void push(Phase phase);
+    void pop();
+
+    Utilities::MPI comm;
+    bool enabled;
+    int depth;
+    Phase stack[MAX_DEPTH];
+    double tic, start_time;
+    double time[N_PHASES];
+    int count[N_PHASES];
+};
+
+#endif
@@ -15,11 +15,103 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "common/ScaLBL.h"
+#include <algorithm>
 #include <chrono>
+#include <stdint.h>
+
+// Interleave the bits of (i,j,k) to get the position along a Morton (z-order) curve
+static uint64_t MortonIndex(uint32_t i, uint32_t j, uint32_t k, int bits){
+	uint64_t index = 0;
+	for (int b=0; b<bits; b++){
+		index |= (uint64_t)((i >> b) & 1) << (3*b);
+		index |= (uint64_t)((j >> b) & 1) << (3*b+1);
+		index |= (uint64_t)((k >> b) & 1) << (3*b+2);
+	}
+	return index;
+}
+
+// Position along a Hilbert curve (Skilling, AIP Conf. Proc. 707, 2004)
+static uint64_t HilbertIndex(uint32_t i, uint32_t j, uint32_t k, int bits){
+	uint32_t X[3] = {i, j, k};
+	uint32_t M = 1u << (bits-1);
+	// inverse undo excess work
+	for (uint32_t Q=M; Q>1; Q>>=1){
+		uint32_t P = Q-1;
+		for (int d=0; d<3; d++){
+			if (X[d] & Q) X[0] ^= P;
+			else {
+				uint32_t t = (X[0] ^ X[d]) & P;
+				X[0] ^= t;
+				X[d] ^= t;
+			}
+		}
+	}
+	// Gray encode
+	for (int d=1; d<3; d++) X[d] ^= X[d-1];
+	uint32_t t = 0;
+	for (uint32_t Q=M; Q>1; Q>>=1){
+		if (X[2] & Q) t ^= Q-1;
+	}
+	for (int d=0; d<3; d++) X[d] ^= t;
+	// interleave the transposed bits
+	uint64_t index = 0;
+	for (int b=bits-1; b>=0; b--){
+		for (int d=0; d<3; d++)
+			index = (index << 1) | ((X[d] >> b) & 1);
+	}
+	return index;
+}
+
+// Lattice weight of D3Q19 direction q (float storage is shifted by the weight)
+static double D3Q19_Weight(int q){
+	if (q == 0) return 1.0/3.0;
+	if (q < 7) return 1.0/18.0;
+	return 1.0/36.0;
+}
+
+void ScaLBL_D3Q19_CopyToDevice(double *dist, const double *host, int Np){
+	ScaLBL_CopyToDevice(dist, host, 19*Np*sizeof(double));
+}
+
+void ScaLBL_D3Q19_CopyToDevice(float *dist, const double *host, int Np){
+	std::vector<float> tmp(19*Np);
+	for (int q=0; q<19; q++){
+		double w = D3Q19_Weight(q);
+		for (int n=0; n<Np; n++)
+			tmp[q*Np+n] = host[q*Np+n] - w;
+	}
+	ScaLBL_CopyToDevice(dist, tmp.data(), 19*Np*sizeof(float));
+}
+
+void ScaLBL_D3Q19_CopyToHost(double *host, const double *dist, int Np){
+	ScaLBL_CopyToHost(host, dist, 19*Np*sizeof(double));
+}
+
+void ScaLBL_D3Q19_CopyToHost(double *host, const float *dist, int Np){
+	std::vector<float> tmp(19*Np);
+	ScaLBL_CopyToHost(tmp.data(), dist, 19*Np*sizeof(float));
+	for (int q=0; q<19; q++){
+		double w = D3Q19_Weight(q);
+		for (int n=0; n<Np; n++)
+			host[q*Np+n] = tmp[q*Np+n] + w;
+	}
+}
 
 ScaLBL_Communicator::ScaLBL_Communicator(std::shared_ptr <Domain> Dm){
 	//......................................................................................
 	Lock=false; // unlock the communicator
+	BarrierFree=true; // time stepping does not need global barriers
+	LayoutOrdering = "lexicographic";
+	LayoutTileSize = 8;
+	if (Dm->database){
+		LayoutOrdering = Dm->database->getWithDefault<std::string>( "LayoutOrdering", "lexicographic" );
+		LayoutTileSize = Dm->database->getWithDefault<int>( "LayoutTileSize", 8 );
+	}
+	if (LayoutOrdering != "lexicographic" && LayoutOrdering != "tiled" &&
+	    LayoutOrdering != "morton" && LayoutOrdering != "hilbert")
+		ERROR("ScaLBL_Communicator: unknown LayoutOrdering " + LayoutOrdering);
+	if (LayoutTileSize < 1)
+		ERROR("ScaLBL_Communicator: LayoutTileSize must be positive");
 	//......................................................................................
 	// Create a separate copy of the communicator for the device
     MPI_COMM_SCALBL = Dm->Comm.dup();
@@ -30,6 +122,7 @@ ScaLBL_Communicator::ScaLBL_Communicator(std::shared_ptr <Domain> Dm){
 	Nz = Dm->Nz;
 	N = Nx*Ny*Nz;
 	next=0;
+	interior_span=0;
 	rank=Dm->rank();
 	rank_x=Dm->rank_x();
 	rank_y=Dm->rank_y();
@@ -132,6 +225,11 @@ ScaLBL_Communicator::ScaLBL_Communicator(std::shared_ptr <Domain> Dm){
 	ScaLBL_AllocateZeroCopy((void **) &recvbuf_yZ, 2*recvCount_yZ*sizeof(double));	// Allocate device memory
 	ScaLBL_AllocateZeroCopy((void **) &recvbuf_Yz, 2*recvCount_Yz*sizeof(double));	// Allocate device memory
 	ScaLBL_AllocateZeroCopy((void **) &recvbuf_YZ, 2*recvCount_YZ*sizeof(double));	// Allocate device memory
+	for (int face=0; face<6; face++){
+		MultiSendBuf[face] = NULL;
+		MultiRecvBuf[face] = NULL;
+	}
+	MultiComponents = 0;
 	//......................................................................................
 	ScaLBL_AllocateZeroCopy((void **) &dvcSendList_x, sendCount_x*sizeof(int));	// Allocate device memory
 	ScaLBL_AllocateZeroCopy((void **) &dvcSendList_X, sendCount_X*sizeof(int));	// Allocate device memory
@@ -230,6 +328,17 @@ ScaLBL_Communicator::ScaLBL_Communicator(std::shared_ptr <Domain> Dm){
 	ScaLBL_CopyToZeroCopy(dvcRecvList_yZ,Dm->recvList("yZ"),recvCount_yZ*sizeof(int));
 	ScaLBL_CopyToZeroCopy(dvcRecvList_Yz,Dm->recvList("Yz"),recvCount_Yz*sizeof(int));
 	//......................................................................................
+	// Keep the send lists in the regular layout for the aggregated halo exchange
+	// (dvcSendList_* are re-indexed by MemoryOptimizedLayoutAA)
+	const char *HaloDir[18] = {"x","X","y","Y","z","Z","xy","XY","xY","Xy","xz","XZ","xZ","Xz","yz","YZ","yZ","Yz"};
+	for (int d=0; d<18; d++){
+		int count = Dm->sendCount(HaloDir[d]);
+		ScaLBL_AllocateZeroCopy((void **) &dvcSendListRegular[d], count*sizeof(int));
+		ScaLBL_CopyToZeroCopy(dvcSendListRegular[d],Dm->sendList(HaloDir[d]),count*sizeof(int));
+		HaloSendBuf[d] = HaloRecvBuf[d] = NULL;
+		HaloSendSize[d] = HaloRecvSize[d] = 0;
+	}
+	//......................................................................................
 
 	MPI_COMM_SCALBL.barrier();
 
@@ -362,10 +471,58 @@ ScaLBL_Communicator::ScaLBL_Communicator(std::shared_ptr <Domain> Dm){
 	req_D3Q19AA.push_back( MPI_COMM_SCALBL.Isend_init( sendbuf_YZ, sendCount_YZ, rank_YZ, 145 ) );
 	req_D3Q19AA.push_back( MPI_COMM_SCALBL.Irecv_init( recvbuf_yz, recvCount_yz, rank_yz, 145 ) );
 
+	//...................................................................................
+	// Same pattern for D3Q19 distributions stored in single precision (reuses the buffers)
+	//...................................................................................
+    req_D3Q19AA_float.clear();
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_x, 5*sendCount_x, rank_x, 130 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_X, 5*recvCount_X, rank_X, 130 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_X, 5*sendCount_X, rank_X, 131 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_x, 5*recvCount_x, rank_x, 131 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_y, 5*sendCount_y, rank_y, 132 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_Y, 5*recvCount_Y, rank_Y, 132 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_Y, 5*sendCount_Y, rank_Y, 133 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_y, 5*recvCount_y, rank_y, 133 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_z, 5*sendCount_z, rank_z, 134 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_Z, 5*recvCount_Z, rank_Z, 134 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_Z, 5*sendCount_Z, rank_Z, 135 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_z, 5*recvCount_z, rank_z, 135 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_xy, sendCount_xy, rank_xy, 136 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_XY, recvCount_XY, rank_XY, 136 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_XY, sendCount_XY, rank_XY, 137 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_xy, recvCount_xy, rank_xy, 137 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_Xy, sendCount_Xy, rank_Xy, 138 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_xY, recvCount_xY, rank_xY, 138 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_xY, sendCount_xY, rank_xY, 139 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_Xy, recvCount_Xy, rank_Xy, 139 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_xz, sendCount_xz, rank_xz, 140 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_XZ, recvCount_XZ, rank_XZ, 140 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_xZ, sendCount_xZ, rank_xZ, 143 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_Xz, recvCount_Xz, rank_Xz, 143 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_Xz, sendCount_Xz, rank_Xz, 142 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_xZ, recvCount_xZ, rank_xZ, 142 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_XZ, sendCount_XZ, rank_XZ, 141 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_xz, recvCount_xz, rank_xz, 141 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_yz, sendCount_yz, rank_yz, 144 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_YZ, recvCount_YZ, rank_YZ, 144 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_yZ, sendCount_yZ, rank_yZ, 147 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_Yz, recvCount_Yz, rank_Yz, 147 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_Yz, sendCount_Yz, rank_Yz, 146 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_yZ, recvCount_yZ, rank_yZ, 146 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Isend_init( (float*) sendbuf_YZ, sendCount_YZ, rank_YZ, 145 ) );
+	req_D3Q19AA_float.push_back( MPI_COMM_SCALBL.Irecv_init( (float*) recvbuf_yz, recvCount_yz, rank_yz, 145 ) );
+
 }
 
 ScaLBL_Communicator::~ScaLBL_Communicator()
 {
+	for (int d=0; d<18; d++){
+		ScaLBL_FreeDeviceMemory( dvcSendListRegular[d] );
+		if (HaloSendBuf[d] != NULL){
+			ScaLBL_FreeDeviceMemory( HaloSendBuf[d] );
+			ScaLBL_FreeDeviceMemory( HaloRecvBuf[d] );
+		}
+	}
 
 	ScaLBL_FreeDeviceMemory( sendbuf_x );
 	ScaLBL_FreeDeviceMemory( sendbuf_X );
@@ -403,6 +560,10 @@ ScaLBL_Communicator::~ScaLBL_Communicator()
 	ScaLBL_FreeDeviceMemory( recvbuf_yZ );
 	ScaLBL_FreeDeviceMemory( recvbuf_Yz );
 	ScaLBL_FreeDeviceMemory( recvbuf_YZ );
+	for (int face=0; face<6 && MultiComponents>0; face++){
+		ScaLBL_FreeDeviceMemory( MultiSendBuf[face] );
+		ScaLBL_FreeDeviceMemory( MultiRecvBuf[face] );
+	}
 	ScaLBL_FreeDeviceMemory( dvcSendList_x );
 	ScaLBL_FreeDeviceMemory( dvcSendList_X );
 	ScaLBL_FreeDeviceMemory( dvcSendList_y );
@@ -467,6 +628,7 @@ void ScaLBL_Communicator::start( std::vector<std::shared_ptr<MPI_Request>>& requ
 }
 void ScaLBL_Communicator::wait( std::vector<std::shared_ptr<MPI_Request>>& requests )
 {
+    PhaseTimer::Scope wait_timer( Timer.get(), PhaseTimer::WAIT );
     std::vector<MPI_Request> request2;
     for ( auto& req : requests )
         request2.push_back( *req );
@@ -661,6 +823,38 @@ double ScaLBL_Communicator::GetPerformance(int *NeighborList, double *fq, int Np
 	return MLUPS;
 
 }	
+#ifdef SCALBL_FLOAT_STORAGE
+double ScaLBL_Communicator::GetPerformance(int *NeighborList, float *fq, int Np){
+	/* EACH MPI PROCESS GETS ITS OWN MEASUREMENT*/
+	/* use MRT kernels to check performance without communication / synchronization */
+	int TIMESTEPS=500;
+	double RLX_SETA=1.0;
+	double RLX_SETB = 8.f*(2.f-RLX_SETA)/(8.f-RLX_SETA);
+	double FX = 0.0;
+	double FY = 0.0;
+	double FZ = 0.0;
+    ScaLBL_D3Q19_Init_float(fq, Np);
+	//.......create and start timer............
+	Barrier();
+    auto t1 = std::chrono::system_clock::now();
+	for (int t=0; t<TIMESTEPS; t++){
+		ScaLBL_D3Q19_AAodd_MRT_float(NeighborList, fq,  FirstInterior(), LastInterior(), Np, RLX_SETA, RLX_SETB, FX, FY, FZ);
+		ScaLBL_D3Q19_AAodd_MRT_float(NeighborList, fq, 0, LastExterior(), Np, RLX_SETA, RLX_SETB, FX, FY, FZ);
+		ScaLBL_D3Q19_AAeven_MRT_float(fq, FirstInterior(), LastInterior(), Np, RLX_SETA, RLX_SETB, FX, FY, FZ);
+		ScaLBL_D3Q19_AAeven_MRT_float(fq, 0, LastExterior(), Np, RLX_SETA, RLX_SETB, FX, FY, FZ);
+	}
+    auto t2 = std::chrono::system_clock::now();
+	Barrier();
+	// Compute the walltime per timestep
+    double diff = std::chrono::duration<double>( t2 - t1 ).count();
+	double cputime = 0.5*diff/TIMESTEPS;
+	// Performance obtained from each node
+	double MLUPS = double(Np)/cputime/1000000;
+	return MLUPS;
+
+}
+#endif
+
 int ScaLBL_Communicator::LastExterior(){
 	return next;
 }
@@ -670,6 +864,9 @@ int ScaLBL_Communicator::FirstInterior(){
 int ScaLBL_Communicator::LastInterior(){
 	return last_interior;
 }
+int ScaLBL_Communicator::InteriorSpan(){
+	return interior_span;
+}
 
 void ScaLBL_Communicator::D3Q19_MapRecv(int Cqx, int Cqy, int Cqz, const int *list,  int start, int count,
 		int *d3q19_recvlist){
@@ -761,20 +958,82 @@ int ScaLBL_Communicator::MemoryOptimizedLayoutAA(IntArray &Map, int *neighborLis
 	// align the next read
 	first_interior=(next/16 + 1)*16;
 	idx = first_interior;
-	// Step 2/2: Next loop over the domain interior in block-cyclic fashion
+	// Step 2/2: Next loop over the domain interior
+	if (LayoutOrdering == "lexicographic"){
+		for (k=width+1; k<Nz-width-1; k++){
+			for (j=width+1; j<Ny-width-1; j++){
+				for (i=width+1; i<Nx-width-1; i++){
+					// Local index (regular layout)
+					n = k*Nx*Ny + j*Nx + i;
+					if (id[n] > 0 ){
+						Map(n) = idx++;
+						//neighborList[idx++] = n; // index of self in regular layout
+					}
+				}
+			}
+		}
+	}
+	else {
+		// Sort the interior sites by their position along the requested traversal
+		int nx = Nx-2*width-2;
+		int ny = Ny-2*width-2;
+		int nz = Nz-2*width-2;
+		int bits = 1;
+		while ((1 << bits) < std::max(nx,std::max(ny,nz))) bits++;
+		int tile = LayoutTileSize;
+		int tx = (nx + tile - 1)/tile;
+		int ty = (ny + tile - 1)/tile;
+		std::vector<std::pair<uint64_t,int>> interior;
+		for (k=width+1; k<Nz-width-1; k++){
+			for (j=width+1; j<Ny-width-1; j++){
+				for (i=width+1; i<Nx-width-1; i++){
+					n = k*Nx*Ny + j*Nx + i;
+					if (id[n] > 0 ){
+						int ii = i-width-1;
+						int jj = j-width-1;
+						int kk = k-width-1;
+						uint64_t key;
+						if (LayoutOrdering == "tiled"){
+							// tiles in lexicographic order, sites within a tile in lexicographic order
+							uint64_t block = (uint64_t)(kk/tile)*tx*ty + (jj/tile)*tx + ii/tile;
+							uint64_t local = ((kk%tile)*tile + jj%tile)*tile + ii%tile;
+							key = block*tile*tile*tile + local;
+						}
+						else if (LayoutOrdering == "morton")
+							key = MortonIndex(ii,jj,kk,bits);
+						else
+							key = HilbertIndex(ii,jj,kk,bits);
+						interior.push_back(std::make_pair(key,n));
+					}
+				}
+			}
+		}
+		std::sort(interior.begin(),interior.end());
+		for (size_t m=0; m<interior.size(); m++)
+			Map(interior[m].second) = idx++;
+	}
+	last_interior=idx;
+
+	// Largest forward offset from an interior site to an interior neighbor
+	//   - the phase field must run this far ahead of the fused color kernel
+	interior_span=0;
 	for (k=width+1; k<Nz-width-1; k++){
 		for (j=width+1; j<Ny-width-1; j++){
 			for (i=width+1; i<Nx-width-1; i++){
-				// Local index (regular layout)
-				n = k*Nx*Ny + j*Nx + i;
-				if (id[n] > 0 ){
-					Map(n) = idx++;
-					//neighborList[idx++] = n; // index of self in regular layout
+				idx=Map(i,j,k);
+				if (idx<0) continue;
+				for (int kk=-1; kk<2; kk++){
+					for (int jj=-1; jj<2; jj++){
+						for (int ii=-1; ii<2; ii++){
+							int neighbor=Map(i+ii,j+jj,k+kk);
+							if (!(neighbor<first_interior) && neighbor-idx > interior_span)
+								interior_span = neighbor-idx;
+						}
+					}
 				}
 			}
 		}
 	}
-	last_interior=idx;
 	
 	Np = (last_interior/16 + 1)*16;
 	//printf("    Np=%i \n",Np);
@@ -1610,6 +1869,7 @@ void ScaLBL_Communicator::SolidSlippingVelocityBCD3Q19(double *fq, double *zeta_
 }
 
 void ScaLBL_Communicator::SendD3Q19AA(double *dist){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	if (Lock==true){
 		ERROR("ScaLBL Error (SendD3Q19): ScaLBL_Communicator is locked -- did you forget to match Send/Recv calls?");
@@ -1696,6 +1956,7 @@ void ScaLBL_Communicator::SendD3Q19AA(double *dist){
 }
 
 void ScaLBL_Communicator::RecvD3Q19AA(double *dist){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	// NOTE: the center distribution f0 must NOT be at the start of feven, provide offset to start of f2
 	//...................................................................................
@@ -1778,13 +2039,190 @@ void ScaLBL_Communicator::RecvD3Q19AA(double *dist){
 
 }
 
+#ifdef SCALBL_FLOAT_STORAGE
+void ScaLBL_Communicator::SendD3Q19AA(float *dist){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
+
+	if (Lock==true){
+		ERROR("ScaLBL Error (SendD3Q19): ScaLBL_Communicator is locked -- did you forget to match Send/Recv calls?");
+	}
+	else{
+		Lock=true;
+	}
+	ScaLBL_DeviceBarrier();
+	// Pack the distributions
+	//...Packing for x face(2,8,10,12,14)................................
+	ScaLBL_D3Q19_Pack_float(2,dvcSendList_x,0,sendCount_x,(float*)sendbuf_x,dist,N);
+	ScaLBL_D3Q19_Pack_float(8,dvcSendList_x,sendCount_x,sendCount_x,(float*)sendbuf_x,dist,N);
+	ScaLBL_D3Q19_Pack_float(10,dvcSendList_x,2*sendCount_x,sendCount_x,(float*)sendbuf_x,dist,N);
+	ScaLBL_D3Q19_Pack_float(12,dvcSendList_x,3*sendCount_x,sendCount_x,(float*)sendbuf_x,dist,N);
+	ScaLBL_D3Q19_Pack_float(14,dvcSendList_x,4*sendCount_x,sendCount_x,(float*)sendbuf_x,dist,N);
+	
+	//...Packing for X face(1,7,9,11,13)................................
+	ScaLBL_D3Q19_Pack_float(1,dvcSendList_X,0,sendCount_X,(float*)sendbuf_X,dist,N);
+	ScaLBL_D3Q19_Pack_float(7,dvcSendList_X,sendCount_X,sendCount_X,(float*)sendbuf_X,dist,N);
+	ScaLBL_D3Q19_Pack_float(9,dvcSendList_X,2*sendCount_X,sendCount_X,(float*)sendbuf_X,dist,N);
+	ScaLBL_D3Q19_Pack_float(11,dvcSendList_X,3*sendCount_X,sendCount_X,(float*)sendbuf_X,dist,N);
+	ScaLBL_D3Q19_Pack_float(13,dvcSendList_X,4*sendCount_X,sendCount_X,(float*)sendbuf_X,dist,N);
+	
+	//...Packing for y face(4,8,9,16,18).................................
+	ScaLBL_D3Q19_Pack_float(4,dvcSendList_y,0,sendCount_y,(float*)sendbuf_y,dist,N);
+	ScaLBL_D3Q19_Pack_float(8,dvcSendList_y,sendCount_y,sendCount_y,(float*)sendbuf_y,dist,N);
+	ScaLBL_D3Q19_Pack_float(9,dvcSendList_y,2*sendCount_y,sendCount_y,(float*)sendbuf_y,dist,N);
+	ScaLBL_D3Q19_Pack_float(16,dvcSendList_y,3*sendCount_y,sendCount_y,(float*)sendbuf_y,dist,N);
+	ScaLBL_D3Q19_Pack_float(18,dvcSendList_y,4*sendCount_y,sendCount_y,(float*)sendbuf_y,dist,N);
+	
+	//...Packing for Y face(3,7,10,15,17).................................
+	ScaLBL_D3Q19_Pack_float(3,dvcSendList_Y,0,sendCount_Y,(float*)sendbuf_Y,dist,N);
+	ScaLBL_D3Q19_Pack_float(7,dvcSendList_Y,sendCount_Y,sendCount_Y,(float*)sendbuf_Y,dist,N);
+	ScaLBL_D3Q19_Pack_float(10,dvcSendList_Y,2*sendCount_Y,sendCount_Y,(float*)sendbuf_Y,dist,N);
+	ScaLBL_D3Q19_Pack_float(15,dvcSendList_Y,3*sendCount_Y,sendCount_Y,(float*)sendbuf_Y,dist,N);
+	ScaLBL_D3Q19_Pack_float(17,dvcSendList_Y,4*sendCount_Y,sendCount_Y,(float*)sendbuf_Y,dist,N);
+	
+	//...Packing for z face(6,12,13,16,17)................................
+	ScaLBL_D3Q19_Pack_float(6,dvcSendList_z,0,sendCount_z,(float*)sendbuf_z,dist,N);
+	ScaLBL_D3Q19_Pack_float(12,dvcSendList_z,sendCount_z,sendCount_z,(float*)sendbuf_z,dist,N);
+	ScaLBL_D3Q19_Pack_float(13,dvcSendList_z,2*sendCount_z,sendCount_z,(float*)sendbuf_z,dist,N);
+	ScaLBL_D3Q19_Pack_float(16,dvcSendList_z,3*sendCount_z,sendCount_z,(float*)sendbuf_z,dist,N);
+	ScaLBL_D3Q19_Pack_float(17,dvcSendList_z,4*sendCount_z,sendCount_z,(float*)sendbuf_z,dist,N);
+		
+	//...Packing for Z face(5,11,14,15,18)................................
+	ScaLBL_D3Q19_Pack_float(5,dvcSendList_Z,0,sendCount_Z,(float*)sendbuf_Z,dist,N);
+	ScaLBL_D3Q19_Pack_float(11,dvcSendList_Z,sendCount_Z,sendCount_Z,(float*)sendbuf_Z,dist,N);
+	ScaLBL_D3Q19_Pack_float(14,dvcSendList_Z,2*sendCount_Z,sendCount_Z,(float*)sendbuf_Z,dist,N);
+	ScaLBL_D3Q19_Pack_float(15,dvcSendList_Z,3*sendCount_Z,sendCount_Z,(float*)sendbuf_Z,dist,N);
+	ScaLBL_D3Q19_Pack_float(18,dvcSendList_Z,4*sendCount_Z,sendCount_Z,(float*)sendbuf_Z,dist,N);
+
+      	//...Pack the xy edge (8)................................
+	ScaLBL_D3Q19_Pack_float(8,dvcSendList_xy,0,sendCount_xy,(float*)sendbuf_xy,dist,N);
+	//...Pack the Xy edge (9)................................
+	ScaLBL_D3Q19_Pack_float(9,dvcSendList_Xy,0,sendCount_Xy,(float*)sendbuf_Xy,dist,N);
+	//...Pack the xY edge (10)................................
+	ScaLBL_D3Q19_Pack_float(10,dvcSendList_xY,0,sendCount_xY,(float*)sendbuf_xY,dist,N);
+	//...Pack the XY edge (7)................................
+	ScaLBL_D3Q19_Pack_float(7,dvcSendList_XY,0,sendCount_XY,(float*)sendbuf_XY,dist,N);
+	//...Pack the xz edge (12)................................
+	ScaLBL_D3Q19_Pack_float(12,dvcSendList_xz,0,sendCount_xz,(float*)sendbuf_xz,dist,N);
+	
+	//...Pack the xZ edge (14)................................
+	ScaLBL_D3Q19_Pack_float(14,dvcSendList_xZ,0,sendCount_xZ,(float*)sendbuf_xZ,dist,N);
+	//...Pack the Xz edge (13)................................
+	ScaLBL_D3Q19_Pack_float(13,dvcSendList_Xz,0,sendCount_Xz,(float*)sendbuf_Xz,dist,N);
+
+	//...Pack the XZ edge (11)................................
+	ScaLBL_D3Q19_Pack_float(11,dvcSendList_XZ,0,sendCount_XZ,(float*)sendbuf_XZ,dist,N);
+	//...Pack the yz edge (16)................................
+	ScaLBL_D3Q19_Pack_float(16,dvcSendList_yz,0,sendCount_yz,(float*)sendbuf_yz,dist,N);
+	//...Pack the yZ edge (18)................................
+	ScaLBL_D3Q19_Pack_float(18,dvcSendList_yZ,0,sendCount_yZ,(float*)sendbuf_yZ,dist,N);
+	//...Pack the Yz edge (17)................................
+	ScaLBL_D3Q19_Pack_float(17,dvcSendList_Yz,0,sendCount_Yz,(float*)sendbuf_Yz,dist,N);
+	//...Pack the YZ edge (15)................................
+	ScaLBL_D3Q19_Pack_float(15,dvcSendList_YZ,0,sendCount_YZ,(float*)sendbuf_YZ,dist,N);
+
+	//...................................................................................
+
+	ScaLBL_DeviceBarrier();
+    start( req_D3Q19AA_float );
+
+}
+
+void ScaLBL_Communicator::RecvD3Q19AA(float *dist){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
+
+	// NOTE: the center distribution f0 must NOT be at the start of feven, provide offset to start of f2
+	//...................................................................................
+	// Wait for completion of D3Q19 communication
+    wait( req_D3Q19AA_float );
+	ScaLBL_DeviceBarrier();
+
+	//...................................................................................
+	// NOTE: AA Routine writes to opposite 
+	// Unpack the distributions on the device
+	//...................................................................................
+	//...Unpacking for x face(2,8,10,12,14)................................
+	ScaLBL_D3Q19_Unpack_float(2,dvcRecvDist_x,0,recvCount_x,(float*)recvbuf_x,dist,N);
+	ScaLBL_D3Q19_Unpack_float(8,dvcRecvDist_x,recvCount_x,recvCount_x,(float*)recvbuf_x,dist,N);
+	ScaLBL_D3Q19_Unpack_float(10,dvcRecvDist_x,2*recvCount_x,recvCount_x,(float*)recvbuf_x,dist,N);
+	ScaLBL_D3Q19_Unpack_float(12,dvcRecvDist_x,3*recvCount_x,recvCount_x,(float*)recvbuf_x,dist,N);
+	ScaLBL_D3Q19_Unpack_float(14,dvcRecvDist_x,4*recvCount_x,recvCount_x,(float*)recvbuf_x,dist,N);
+	//...................................................................................
+	//...Packing for X face(1,7,9,11,13)................................
+	ScaLBL_D3Q19_Unpack_float(1,dvcRecvDist_X,0,recvCount_X,(float*)recvbuf_X,dist,N);
+	ScaLBL_D3Q19_Unpack_float(7,dvcRecvDist_X,recvCount_X,recvCount_X,(float*)recvbuf_X,dist,N);
+	ScaLBL_D3Q19_Unpack_float(9,dvcRecvDist_X,2*recvCount_X,recvCount_X,(float*)recvbuf_X,dist,N);
+	ScaLBL_D3Q19_Unpack_float(11,dvcRecvDist_X,3*recvCount_X,recvCount_X,(float*)recvbuf_X,dist,N);
+	ScaLBL_D3Q19_Unpack_float(13,dvcRecvDist_X,4*recvCount_X,recvCount_X,(float*)recvbuf_X,dist,N);
+	//...................................................................................
+	//...Packing for y face(4,8,9,16,18).................................
+	ScaLBL_D3Q19_Unpack_float(4,dvcRecvDist_y,0,recvCount_y,(float*)recvbuf_y,dist,N);
+	ScaLBL_D3Q19_Unpack_float(8,dvcRecvDist_y,recvCount_y,recvCount_y,(float*)recvbuf_y,dist,N);
+	ScaLBL_D3Q19_Unpack_float(9,dvcRecvDist_y,2*recvCount_y,recvCount_y,(float*)recvbuf_y,dist,N);
+	ScaLBL_D3Q19_Unpack_float(16,dvcRecvDist_y,3*recvCount_y,recvCount_y,(float*)recvbuf_y,dist,N);
+	ScaLBL_D3Q19_Unpack_float(18,dvcRecvDist_y,4*recvCount_y,recvCount_y,(float*)recvbuf_y,dist,N);
+	//...................................................................................
+	//...Packing for Y face(3,7,10,15,17).................................
+	ScaLBL_D3Q19_Unpack_float(3,dvcRecvDist_Y,0,recvCount_Y,(float*)recvbuf_Y,dist,N);
+	ScaLBL_D3Q19_Unpack_float(7,dvcRecvDist_Y,recvCount_Y,recvCount_Y,(float*)recvbuf_Y,dist,N);
+	ScaLBL_D3Q19_Unpack_float(10,dvcRecvDist_Y,2*recvCount_Y,recvCount_Y,(float*)recvbuf_Y,dist,N);
+	ScaLBL_D3Q19_Unpack_float(15,dvcRecvDist_Y,3*recvCount_Y,recvCount_Y,(float*)recvbuf_Y,dist,N);
+	ScaLBL_D3Q19_Unpack_float(17,dvcRecvDist_Y,4*recvCount_Y,recvCount_Y,(float*)recvbuf_Y,dist,N);
+	//...................................................................................
+	//...Packing for z face(6,12,13,16,17)................................
+	ScaLBL_D3Q19_Unpack_float(6,dvcRecvDist_z,0,recvCount_z,(float*)recvbuf_z,dist,N);
+	ScaLBL_D3Q19_Unpack_float(12,dvcRecvDist_z,recvCount_z,recvCount_z,(float*)recvbuf_z,dist,N);
+	ScaLBL_D3Q19_Unpack_float(13,dvcRecvDist_z,2*recvCount_z,recvCount_z,(float*)recvbuf_z,dist,N);
+	ScaLBL_D3Q19_Unpack_float(16,dvcRecvDist_z,3*recvCount_z,recvCount_z,(float*)recvbuf_z,dist,N);
+	ScaLBL_D3Q19_Unpack_float(17,dvcRecvDist_z,4*recvCount_z,recvCount_z,(float*)recvbuf_z,dist,N);
+	//...Packing for Z face(5,11,14,15,18)................................
+	ScaLBL_D3Q19_Unpack_float(5,dvcRecvDist_Z,0,recvCount_Z,(float*)recvbuf_Z,dist,N);
+	ScaLBL_D3Q19_Unpack_float(11,dvcRecvDist_Z,recvCount_Z,recvCount_Z,(float*)recvbuf_Z,dist,N);
+	ScaLBL_D3Q19_Unpack_float(14,dvcRecvDist_Z,2*recvCount_Z,recvCount_Z,(float*)recvbuf_Z,dist,N);
+	ScaLBL_D3Q19_Unpack_float(15,dvcRecvDist_Z,3*recvCount_Z,recvCount_Z,(float*)recvbuf_Z,dist,N);
+	ScaLBL_D3Q19_Unpack_float(18,dvcRecvDist_Z,4*recvCount_Z,recvCount_Z,(float*)recvbuf_Z,dist,N);
+	//..................................................................................
+	//...Pack the xy edge (8)................................
+	ScaLBL_D3Q19_Unpack_float(8,dvcRecvDist_xy,0,recvCount_xy,(float*)recvbuf_xy,dist,N);
+	//...Pack the Xy edge (9)................................
+	ScaLBL_D3Q19_Unpack_float(9,dvcRecvDist_Xy,0,recvCount_Xy,(float*)recvbuf_Xy,dist,N);
+	//...Pack the xY edge (10)................................
+	ScaLBL_D3Q19_Unpack_float(10,dvcRecvDist_xY,0,recvCount_xY,(float*)recvbuf_xY,dist,N);
+	//...Pack the XY edge (7)................................
+	ScaLBL_D3Q19_Unpack_float(7,dvcRecvDist_XY,0,recvCount_XY,(float*)recvbuf_XY,dist,N);
+	//...Pack the xz edge (12)................................
+	ScaLBL_D3Q19_Unpack_float(12,dvcRecvDist_xz,0,recvCount_xz,(float*)recvbuf_xz,dist,N);
+	//...Pack the xZ edge (14)................................
+	ScaLBL_D3Q19_Unpack_float(14,dvcRecvDist_xZ,0,recvCount_xZ,(float*)recvbuf_xZ,dist,N);
+	//...Pack the Xz edge (13)................................
+	ScaLBL_D3Q19_Unpack_float(13,dvcRecvDist_Xz,0,recvCount_Xz,(float*)recvbuf_Xz,dist,N);
+	//...Pack the XZ edge (11)................................
+	ScaLBL_D3Q19_Unpack_float(11,dvcRecvDist_XZ,0,recvCount_XZ,(float*)recvbuf_XZ,dist,N);
+	//...Pack the yz edge (16)................................
+	ScaLBL_D3Q19_Unpack_float(16,dvcRecvDist_yz,0,recvCount_yz,(float*)recvbuf_yz,dist,N);
+	//...Pack the yZ edge (18)................................
+	ScaLBL_D3Q19_Unpack_float(18,dvcRecvDist_yZ,0,recvCount_yZ,(float*)recvbuf_yZ,dist,N);
+	//...Pack the Yz edge (17)................................
+	ScaLBL_D3Q19_Unpack_float(17,dvcRecvDist_Yz,0,recvCount_Yz,(float*)recvbuf_Yz,dist,N);
+	//...Pack the YZ edge (15)................................
+	ScaLBL_D3Q19_Unpack_float(15,dvcRecvDist_YZ,0,recvCount_YZ,(float*)recvbuf_YZ,dist,N);
+	//...................................................................................
+	Lock=false; // unlock the communicator after communications complete
+	//...................................................................................
+
+}
+#endif
+
 void ScaLBL_Communicator::RecvGrad(double *phi, double *grad){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	// Recieves halo and incorporates into D3Q19 based stencil gradient computation
 	//...................................................................................
 	// Wait for completion of D3Q19 communication
-	MPI_COMM_SCALBL.waitAll(18,req1);
-	MPI_COMM_SCALBL.waitAll(18,req2);
+	{
+		PhaseTimer::Scope wait_timer(Timer.get(), PhaseTimer::WAIT);
+		MPI_COMM_SCALBL.waitAll(18,req1);
+		MPI_COMM_SCALBL.waitAll(18,req2);
+	}
 	ScaLBL_DeviceBarrier();
 
 	//...................................................................................
@@ -1860,7 +2298,9 @@ void ScaLBL_Communicator::RecvGrad(double *phi, double *grad){
 
 }
 
-void ScaLBL_Communicator::BiSendD3Q7AA(double *Aq, double *Bq){
+template <class TYPE>
+void ScaLBL_Communicator::BiSendD3Q7AA(TYPE *Aq, TYPE *Bq){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	// NOTE: the center distribution f0 must NOT be at the start of feven, provide offset to start of f2
 	if (Lock==true){
@@ -1874,59 +2314,64 @@ void ScaLBL_Communicator::BiSendD3Q7AA(double *Aq, double *Bq){
 	ScaLBL_DeviceBarrier();
 	// Pack the distributions
 	//...Packing for x face(2,8,10,12,14)................................
-	ScaLBL_D3Q19_Pack(2,dvcSendList_x,0,sendCount_x,sendbuf_x,Aq,N);
-	ScaLBL_D3Q19_Pack(2,dvcSendList_x,sendCount_x,sendCount_x,sendbuf_x,Bq,N);
+	ScaLBL_D3Q19_Pack(2,dvcSendList_x,0,sendCount_x,(TYPE*)sendbuf_x,Aq,N);
+	ScaLBL_D3Q19_Pack(2,dvcSendList_x,sendCount_x,sendCount_x,(TYPE*)sendbuf_x,Bq,N);
 
-	req1[0] = MPI_COMM_SCALBL.Isend(sendbuf_x, 2*sendCount_x, rank_x,sendtag+0);
-	req2[0] = MPI_COMM_SCALBL.Irecv(recvbuf_X, 2*recvCount_X, rank_X,recvtag+0);
+	req1[0] = MPI_COMM_SCALBL.Isend((TYPE*)sendbuf_x, 2*sendCount_x, rank_x,sendtag+0);
+	req2[0] = MPI_COMM_SCALBL.Irecv((TYPE*)recvbuf_X, 2*recvCount_X, rank_X,recvtag+0);
 	
 	//...Packing for X face(1,7,9,11,13)................................
-	ScaLBL_D3Q19_Pack(1,dvcSendList_X,0,sendCount_X,sendbuf_X,Aq,N);
-	ScaLBL_D3Q19_Pack(1,dvcSendList_X,sendCount_X,sendCount_X,sendbuf_X,Bq,N);
+	ScaLBL_D3Q19_Pack(1,dvcSendList_X,0,sendCount_X,(TYPE*)sendbuf_X,Aq,N);
+	ScaLBL_D3Q19_Pack(1,dvcSendList_X,sendCount_X,sendCount_X,(TYPE*)sendbuf_X,Bq,N);
 	
-	req1[1] = MPI_COMM_SCALBL.Isend(sendbuf_X, 2*sendCount_X, rank_X,sendtag+1);
-	req2[1] = MPI_COMM_SCALBL.Irecv(recvbuf_x, 2*recvCount_x, rank_x,recvtag+1);
+	req1[1] = MPI_COMM_SCALBL.Isend((TYPE*)sendbuf_X, 2*sendCount_X, rank_X,sendtag+1);
+	req2[1] = MPI_COMM_SCALBL.Irecv((TYPE*)recvbuf_x, 2*recvCount_x, rank_x,recvtag+1);
 
 	//...Packing for y face(4,8,9,16,18).................................
-	ScaLBL_D3Q19_Pack(4,dvcSendList_y,0,sendCount_y,sendbuf_y,Aq,N);
-	ScaLBL_D3Q19_Pack(4,dvcSendList_y,sendCount_y,sendCount_y,sendbuf_y,Bq,N);
+	ScaLBL_D3Q19_Pack(4,dvcSendList_y,0,sendCount_y,(TYPE*)sendbuf_y,Aq,N);
+	ScaLBL_D3Q19_Pack(4,dvcSendList_y,sendCount_y,sendCount_y,(TYPE*)sendbuf_y,Bq,N);
 
-	req1[2] = MPI_COMM_SCALBL.Isend(sendbuf_y, 2*sendCount_y, rank_y,sendtag+2);
-	req2[2] = MPI_COMM_SCALBL.Irecv(recvbuf_Y, 2*recvCount_Y, rank_Y,recvtag+2);
+	req1[2] = MPI_COMM_SCALBL.Isend((TYPE*)sendbuf_y, 2*sendCount_y, rank_y,sendtag+2);
+	req2[2] = MPI_COMM_SCALBL.Irecv((TYPE*)recvbuf_Y, 2*recvCount_Y, rank_Y,recvtag+2);
 	
 	//...Packing for Y face(3,7,10,15,17).................................
-	ScaLBL_D3Q19_Pack(3,dvcSendList_Y,0,sendCount_Y,sendbuf_Y,Aq,N);
-	ScaLBL_D3Q19_Pack(3,dvcSendList_Y,sendCount_Y,sendCount_Y,sendbuf_Y,Bq,N);
+	ScaLBL_D3Q19_Pack(3,dvcSendList_Y,0,sendCount_Y,(TYPE*)sendbuf_Y,Aq,N);
+	ScaLBL_D3Q19_Pack(3,dvcSendList_Y,sendCount_Y,sendCount_Y,(TYPE*)sendbuf_Y,Bq,N);
 
-	req1[3] = MPI_COMM_SCALBL.Isend(sendbuf_Y, 2*sendCount_Y, rank_Y,sendtag+3);
-	req2[3] = MPI_COMM_SCALBL.Irecv(recvbuf_y, 2*recvCount_y, rank_y,recvtag+3);
+	req1[3] = MPI_COMM_SCALBL.Isend((TYPE*)sendbuf_Y, 2*sendCount_Y, rank_Y,sendtag+3);
+	req2[3] = MPI_COMM_SCALBL.Irecv((TYPE*)recvbuf_y, 2*recvCount_y, rank_y,recvtag+3);
 	
 	//...Packing for z face(6,12,13,16,17)................................
-	ScaLBL_D3Q19_Pack(6,dvcSendList_z,0,sendCount_z,sendbuf_z,Aq,N);
-	ScaLBL_D3Q19_Pack(6,dvcSendList_z,sendCount_z,sendCount_z,sendbuf_z,Bq,N);
+	ScaLBL_D3Q19_Pack(6,dvcSendList_z,0,sendCount_z,(TYPE*)sendbuf_z,Aq,N);
+	ScaLBL_D3Q19_Pack(6,dvcSendList_z,sendCount_z,sendCount_z,(TYPE*)sendbuf_z,Bq,N);
 	
-	req1[4] = MPI_COMM_SCALBL.Isend(sendbuf_z, 2*sendCount_z, rank_z,sendtag+4);
-	req2[4] = MPI_COMM_SCALBL.Irecv(recvbuf_Z, 2*recvCount_Z, rank_Z,recvtag+4);
+	req1[4] = MPI_COMM_SCALBL.Isend((TYPE*)sendbuf_z, 2*sendCount_z, rank_z,sendtag+4);
+	req2[4] = MPI_COMM_SCALBL.Irecv((TYPE*)recvbuf_Z, 2*recvCount_Z, rank_Z,recvtag+4);
 	
 	//...Packing for Z face(5,11,14,15,18)................................
-	ScaLBL_D3Q19_Pack(5,dvcSendList_Z,0,sendCount_Z,sendbuf_Z,Aq,N);
-	ScaLBL_D3Q19_Pack(5,dvcSendList_Z,sendCount_Z,sendCount_Z,sendbuf_Z,Bq,N);
+	ScaLBL_D3Q19_Pack(5,dvcSendList_Z,0,sendCount_Z,(TYPE*)sendbuf_Z,Aq,N);
+	ScaLBL_D3Q19_Pack(5,dvcSendList_Z,sendCount_Z,sendCount_Z,(TYPE*)sendbuf_Z,Bq,N);
 
 	//...................................................................................
 	// Send all the distributions
-	req1[5] = MPI_COMM_SCALBL.Isend(sendbuf_Z, 2*sendCount_Z, rank_Z,sendtag+5);
-	req2[5] = MPI_COMM_SCALBL.Irecv(recvbuf_z, 2*recvCount_z, rank_z,recvtag+5);
+	req1[5] = MPI_COMM_SCALBL.Isend((TYPE*)sendbuf_Z, 2*sendCount_Z, rank_Z,sendtag+5);
+	req2[5] = MPI_COMM_SCALBL.Irecv((TYPE*)recvbuf_z, 2*recvCount_z, rank_z,recvtag+5);
 
 }
 
 
-void ScaLBL_Communicator::BiRecvD3Q7AA(double *Aq, double *Bq){
+template <class TYPE>
+void ScaLBL_Communicator::BiRecvD3Q7AA(TYPE *Aq, TYPE *Bq){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	// NOTE: the center distribution f0 must NOT be at the start of feven, provide offset to start of f2
 	//...................................................................................
 	// Wait for completion of D3Q19 communication
-	MPI_COMM_SCALBL.waitAll(6,req1);
-	MPI_COMM_SCALBL.waitAll(6,req2);
+	{
+		PhaseTimer::Scope wait_timer(Timer.get(), PhaseTimer::WAIT);
+		MPI_COMM_SCALBL.waitAll(6,req1);
+		MPI_COMM_SCALBL.waitAll(6,req2);
+	}
 	ScaLBL_DeviceBarrier();
 
 	//...................................................................................
@@ -1934,41 +2379,41 @@ void ScaLBL_Communicator::BiRecvD3Q7AA(double *Aq, double *Bq){
 	// Unpack the distributions on the device
 	//...................................................................................
 	//...Unpacking for x face(2,8,10,12,14)................................
-	ScaLBL_D3Q7_Unpack(2,dvcRecvDist_x,0,recvCount_x,recvbuf_x,Aq,N);
-	ScaLBL_D3Q7_Unpack(2,dvcRecvDist_x,recvCount_x,recvCount_x,recvbuf_x,Bq,N);
+	ScaLBL_D3Q7_Unpack(2,dvcRecvDist_x,0,recvCount_x,(TYPE*)recvbuf_x,Aq,N);
+	ScaLBL_D3Q7_Unpack(2,dvcRecvDist_x,recvCount_x,recvCount_x,(TYPE*)recvbuf_x,Bq,N);
 	//...................................................................................
 	//...Packing for X face(1,7,9,11,13)................................
-	ScaLBL_D3Q7_Unpack(1,dvcRecvDist_X,0,recvCount_X,recvbuf_X,Aq,N);
-	ScaLBL_D3Q7_Unpack(1,dvcRecvDist_X,recvCount_X,recvCount_X,recvbuf_X,Bq,N);
+	ScaLBL_D3Q7_Unpack(1,dvcRecvDist_X,0,recvCount_X,(TYPE*)recvbuf_X,Aq,N);
+	ScaLBL_D3Q7_Unpack(1,dvcRecvDist_X,recvCount_X,recvCount_X,(TYPE*)recvbuf_X,Bq,N);
 	//...................................................................................
 	//...Packing for y face(4,8,9,16,18).................................
-	ScaLBL_D3Q7_Unpack(4,dvcRecvDist_y,0,recvCount_y,recvbuf_y,Aq,N);
-	ScaLBL_D3Q7_Unpack(4,dvcRecvDist_y,recvCount_y,recvCount_y,recvbuf_y,Bq,N);
+	ScaLBL_D3Q7_Unpack(4,dvcRecvDist_y,0,recvCount_y,(TYPE*)recvbuf_y,Aq,N);
+	ScaLBL_D3Q7_Unpack(4,dvcRecvDist_y,recvCount_y,recvCount_y,(TYPE*)recvbuf_y,Bq,N);
 	//...................................................................................
 	//...Packing for Y face(3,7,10,15,17).................................
-	ScaLBL_D3Q7_Unpack(3,dvcRecvDist_Y,0,recvCount_Y,recvbuf_Y,Aq,N);
-	ScaLBL_D3Q7_Unpack(3,dvcRecvDist_Y,recvCount_Y,recvCount_Y,recvbuf_Y,Bq,N);
+	ScaLBL_D3Q7_Unpack(3,dvcRecvDist_Y,0,recvCount_Y,(TYPE*)recvbuf_Y,Aq,N);
+	ScaLBL_D3Q7_Unpack(3,dvcRecvDist_Y,recvCount_Y,recvCount_Y,(TYPE*)recvbuf_Y,Bq,N);
 	//...................................................................................
 	
 	if (BoundaryCondition > 0 && kproc == 0){
 		// don't unpack little z
 		//...Packing for Z face(5,11,14,15,18)................................
-		ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,0,recvCount_Z,recvbuf_Z,Aq,N);
-		ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,recvCount_Z,recvCount_Z,recvbuf_Z,Bq,N);
+		ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,0,recvCount_Z,(TYPE*)recvbuf_Z,Aq,N);
+		ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,recvCount_Z,recvCount_Z,(TYPE*)recvbuf_Z,Bq,N);
 	}
 	else if (BoundaryCondition > 0 && kproc == nprocz-1){
 		// don't unpack big z
 		//...Packing for z face(6,12,13,16,17)................................
-		ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,0,recvCount_z,recvbuf_z,Aq,N);
-		ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,recvCount_z,recvCount_z,recvbuf_z,Bq,N);
+		ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,0,recvCount_z,(TYPE*)recvbuf_z,Aq,N);
+		ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,recvCount_z,recvCount_z,(TYPE*)recvbuf_z,Bq,N);
 	}
 	else {
 		//...Packing for z face(6,12,13,16,17)................................
-		ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,0,recvCount_z,recvbuf_z,Aq,N);
-		ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,recvCount_z,recvCount_z,recvbuf_z,Bq,N);
+		ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,0,recvCount_z,(TYPE*)recvbuf_z,Aq,N);
+		ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,recvCount_z,recvCount_z,(TYPE*)recvbuf_z,Bq,N);
 		//...Packing for Z face(5,11,14,15,18)................................
-		ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,0,recvCount_Z,recvbuf_Z,Aq,N);
-		ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,recvCount_Z,recvCount_Z,recvbuf_Z,Bq,N);
+		ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,0,recvCount_Z,(TYPE*)recvbuf_Z,Aq,N);
+		ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,recvCount_Z,recvCount_Z,(TYPE*)recvbuf_Z,Bq,N);
 	}
 	
 	//...................................................................................
@@ -1977,7 +2422,15 @@ void ScaLBL_Communicator::BiRecvD3Q7AA(double *Aq, double *Bq){
 
 }
 
+template void ScaLBL_Communicator::BiSendD3Q7AA<double>(double *Aq, double *Bq);
+template void ScaLBL_Communicator::BiRecvD3Q7AA<double>(double *Aq, double *Bq);
+#ifdef SCALBL_FLOAT_STORAGE
+template void ScaLBL_Communicator::BiSendD3Q7AA<float>(float *Aq, float *Bq);
+template void ScaLBL_Communicator::BiRecvD3Q7AA<float>(float *Aq, float *Bq);
+#endif
+
 void ScaLBL_Communicator::SendD3Q7AA(double *Aq, int Component){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	// NOTE: the center distribution f0 must NOT be at the start of feven, provide offset to start of f2
 	if (Lock==true){
@@ -2023,12 +2476,16 @@ void ScaLBL_Communicator::SendD3Q7AA(double *Aq, int Component){
 
 
 void ScaLBL_Communicator::RecvD3Q7AA(double *Aq, int Component){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	// NOTE: the center distribution f0 must NOT be at the start of feven, provide offset to start of f2
 	//...................................................................................
 	// Wait for completion of D3Q19 communication
-	MPI_COMM_SCALBL.waitAll(6,req1);
-	MPI_COMM_SCALBL.waitAll(6,req2);
+	{
+		PhaseTimer::Scope wait_timer(Timer.get(), PhaseTimer::WAIT);
+		MPI_COMM_SCALBL.waitAll(6,req1);
+		MPI_COMM_SCALBL.waitAll(6,req2);
+	}
 	ScaLBL_DeviceBarrier();
 
 	//...................................................................................
@@ -2072,6 +2529,7 @@ void ScaLBL_Communicator::RecvD3Q7AA(double *Aq, int Component){
 }
 
 void ScaLBL_Communicator::TriSendD3Q7AA(double *Aq, double *Bq, double *Cq){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	// NOTE: the center distribution f0 must NOT be at the start of feven, provide offset to start of f2
 	if (Lock==true){
@@ -2128,12 +2586,16 @@ void ScaLBL_Communicator::TriSendD3Q7AA(double *Aq, double *Bq, double *Cq){
 
 
 void ScaLBL_Communicator::TriRecvD3Q7AA(double *Aq, double *Bq, double *Cq){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	// NOTE: the center distribution f0 must NOT be at the start of feven, provide offset to start of f2
 	//...................................................................................
 	// Wait for completion of D3Q19 communication
-	MPI_COMM_SCALBL.waitAll(6,req1);
-	MPI_COMM_SCALBL.waitAll(6,req2);
+	{
+		PhaseTimer::Scope wait_timer(Timer.get(), PhaseTimer::WAIT);
+		MPI_COMM_SCALBL.waitAll(6,req1);
+		MPI_COMM_SCALBL.waitAll(6,req2);
+	}
 	ScaLBL_DeviceBarrier();
 
 	//...................................................................................
@@ -2193,7 +2655,100 @@ void ScaLBL_Communicator::TriRecvD3Q7AA(double *Aq, double *Bq, double *Cq){
 }
 
 
+void ScaLBL_Communicator::ReserveMultiBuffers(int Ncomponents){
+	if (Ncomponents <= MultiComponents) return;
+	int sendCount[6] = { sendCount_x, sendCount_X, sendCount_y, sendCount_Y, sendCount_z, sendCount_Z };
+	int recvCount[6] = { recvCount_x, recvCount_X, recvCount_y, recvCount_Y, recvCount_z, recvCount_Z };
+	ScaLBL_DeviceBarrier();
+	for (int face=0; face<6; face++){
+		if (MultiComponents > 0){
+			ScaLBL_FreeDeviceMemory( MultiSendBuf[face] );
+			ScaLBL_FreeDeviceMemory( MultiRecvBuf[face] );
+		}
+		ScaLBL_AllocateZeroCopy((void **) &MultiSendBuf[face], Ncomponents*sendCount[face]*sizeof(double));
+		ScaLBL_AllocateZeroCopy((void **) &MultiRecvBuf[face], Ncomponents*recvCount[face]*sizeof(double));
+	}
+	MultiComponents = Ncomponents;
+}
+
+void ScaLBL_Communicator::MultiSendD3Q7AA(double *fq, const std::vector<int> &Components){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
+
+	if (Lock==true){
+		ERROR("ScaLBL Error (MultiSendD3Q7AA): ScaLBL_Communicator is locked -- did you forget to match Send/Recv calls?");
+	}
+	else{
+		Lock=true;
+	}
+	int Nc = Components.size();
+	ReserveMultiBuffers(Nc);
+	// assign tag of 174 to the multi-component D3Q7 communication
+	sendtag = recvtag = 174;
+	ScaLBL_DeviceBarrier();
+	// Pack the distributions for each component one after the other
+	for (int c=0; c<Nc; c++){
+		double *Aq = &fq[Components[c]*7*N];
+		ScaLBL_D3Q19_Pack(2,dvcSendList_x,c*sendCount_x,sendCount_x,MultiSendBuf[0],Aq,N);
+		ScaLBL_D3Q19_Pack(1,dvcSendList_X,c*sendCount_X,sendCount_X,MultiSendBuf[1],Aq,N);
+		ScaLBL_D3Q19_Pack(4,dvcSendList_y,c*sendCount_y,sendCount_y,MultiSendBuf[2],Aq,N);
+		ScaLBL_D3Q19_Pack(3,dvcSendList_Y,c*sendCount_Y,sendCount_Y,MultiSendBuf[3],Aq,N);
+		ScaLBL_D3Q19_Pack(6,dvcSendList_z,c*sendCount_z,sendCount_z,MultiSendBuf[4],Aq,N);
+		ScaLBL_D3Q19_Pack(5,dvcSendList_Z,c*sendCount_Z,sendCount_Z,MultiSendBuf[5],Aq,N);
+	}
+	ScaLBL_DeviceBarrier();
+	//...................................................................................
+	// Send all the distributions
+	req1[0] = MPI_COMM_SCALBL.Isend(MultiSendBuf[0], Nc*sendCount_x, rank_x,sendtag+0);
+	req2[0] = MPI_COMM_SCALBL.Irecv(MultiRecvBuf[1], Nc*recvCount_X, rank_X,recvtag+0);
+	req1[1] = MPI_COMM_SCALBL.Isend(MultiSendBuf[1], Nc*sendCount_X, rank_X,sendtag+1);
+	req2[1] = MPI_COMM_SCALBL.Irecv(MultiRecvBuf[0], Nc*recvCount_x, rank_x,recvtag+1);
+	req1[2] = MPI_COMM_SCALBL.Isend(MultiSendBuf[2], Nc*sendCount_y, rank_y,sendtag+2);
+	req2[2] = MPI_COMM_SCALBL.Irecv(MultiRecvBuf[3], Nc*recvCount_Y, rank_Y,recvtag+2);
+	req1[3] = MPI_COMM_SCALBL.Isend(MultiSendBuf[3], Nc*sendCount_Y, rank_Y,sendtag+3);
+	req2[3] = MPI_COMM_SCALBL.Irecv(MultiRecvBuf[2], Nc*recvCount_y, rank_y,recvtag+3);
+	req1[4] = MPI_COMM_SCALBL.Isend(MultiSendBuf[4], Nc*sendCount_z, rank_z,sendtag+4);
+	req2[4] = MPI_COMM_SCALBL.Irecv(MultiRecvBuf[5], Nc*recvCount_Z, rank_Z,recvtag+4);
+	req1[5] = MPI_COMM_SCALBL.Isend(MultiSendBuf[5], Nc*sendCount_Z, rank_Z,sendtag+5);
+	req2[5] = MPI_COMM_SCALBL.Irecv(MultiRecvBuf[4], Nc*recvCount_z, rank_z,recvtag+5);
+}
+
+void ScaLBL_Communicator::MultiRecvD3Q7AA(double *fq, const std::vector<int> &Components){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
+
+	//...................................................................................
+	// Wait for completion of D3Q7 communication
+	{
+		PhaseTimer::Scope wait_timer(Timer.get(), PhaseTimer::WAIT);
+		MPI_COMM_SCALBL.waitAll(6,req1);
+		MPI_COMM_SCALBL.waitAll(6,req2);
+	}
+	ScaLBL_DeviceBarrier();
+
+	//...................................................................................
+	// NOTE: AA Routine writes to opposite
+	// Unpack the distributions on the device
+	//...................................................................................
+	int Nc = Components.size();
+	for (int c=0; c<Nc; c++){
+		double *Aq = &fq[Components[c]*7*N];
+		ScaLBL_D3Q7_Unpack(2,dvcRecvDist_x,c*recvCount_x,recvCount_x,MultiRecvBuf[0],Aq,N);
+		ScaLBL_D3Q7_Unpack(1,dvcRecvDist_X,c*recvCount_X,recvCount_X,MultiRecvBuf[1],Aq,N);
+		ScaLBL_D3Q7_Unpack(4,dvcRecvDist_y,c*recvCount_y,recvCount_y,MultiRecvBuf[2],Aq,N);
+		ScaLBL_D3Q7_Unpack(3,dvcRecvDist_Y,c*recvCount_Y,recvCount_Y,MultiRecvBuf[3],Aq,N);
+		// the z faces are not unpacked at the inlet / outlet when boundary conditions are set
+		if (BoundaryCondition == 0 || kproc != 0)
+			ScaLBL_D3Q7_Unpack(6,dvcRecvDist_z,c*recvCount_z,recvCount_z,MultiRecvBuf[4],Aq,N);
+		if (BoundaryCondition == 0 || kproc != nprocz-1)
+			ScaLBL_D3Q7_Unpack(5,dvcRecvDist_Z,c*recvCount_Z,recvCount_Z,MultiRecvBuf[5],Aq,N);
+	}
+	//...................................................................................
+	Lock=false; // unlock the communicator after communications complete
+	//...................................................................................
+}
+
+
 void ScaLBL_Communicator::SendHalo(double *data){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 	//...................................................................................
 	if (Lock==true){
 		ERROR("ScaLBL Error (SendHalo): ScaLBL_Communicator is locked -- did you forget to match Send/Recv calls?");
@@ -2266,10 +2821,14 @@ void ScaLBL_Communicator::SendHalo(double *data){
 	//...................................................................................
 }
 void ScaLBL_Communicator::RecvHalo(double *data){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
 
 	//...................................................................................
-	MPI_COMM_SCALBL.waitAll(18,req1);
-	MPI_COMM_SCALBL.waitAll(18,req2);
+	{
+		PhaseTimer::Scope wait_timer(Timer.get(), PhaseTimer::WAIT);
+		MPI_COMM_SCALBL.waitAll(18,req1);
+		MPI_COMM_SCALBL.waitAll(18,req2);
+	}
 	ScaLBL_DeviceBarrier();
 	//...................................................................................
 	//...................................................................................
@@ -2296,7 +2855,156 @@ void ScaLBL_Communicator::RecvHalo(double *data){
 	//...................................................................................
 }
 
+/********************************************************
+ * Aggregated halo exchange                              *
+ ********************************************************/
+// Neighbors are ordered x,X,y,Y,z,Z,xy,XY,xY,Xy,xz,XZ,xZ,Xz,yz,YZ,yZ,Yz (opposite of d is d^1)
+static const int HaloD3Q19_Count[18] = {5,5,5,5,5,5,1,1,1,1,1,1,1,1,1,1,1,1};
+static const int HaloD3Q19_q[18][5] = {
+		{2,8,10,12,14},{1,7,9,11,13},{4,8,9,16,18},{3,7,10,15,17},{6,12,13,16,17},{5,11,14,15,18},
+		{8},{7},{10},{9},{12},{11},{14},{13},{16},{15},{18},{17}};
+static const int HaloD3Q7_q[6] = {2,1,4,3,6,5};
+
+static int HaloFieldCount(int type, int d){
+	if (type == ScaLBL_Communicator::HALO_D3Q19) return HaloD3Q19_Count[d];
+	else if (type == ScaLBL_Communicator::HALO_D3Q7) return (d < 6) ? 1 : 0;
+	return 1;
+}
+
+void ScaLBL_Communicator::RegisterHaloAA(int type, double *data){
+	if (!req_HaloAA.empty()){
+		ERROR("ScaLBL Error (RegisterHaloAA): fields must be registered before the first SendHaloAA");
+	}
+	if (type != HALO_D3Q19 && type != HALO_D3Q7 && type != HALO_SCALAR){
+		ERROR("ScaLBL Error (RegisterHaloAA): unknown field type");
+	}
+	HaloFields.push_back(std::make_pair(type,data));
+}
+
+void ScaLBL_Communicator::SetupHaloAA(){
+	int rank_d[18] = {rank_x,rank_X,rank_y,rank_Y,rank_z,rank_Z,rank_xy,rank_XY,rank_xY,rank_Xy,
+			rank_xz,rank_XZ,rank_xZ,rank_Xz,rank_yz,rank_YZ,rank_yZ,rank_Yz};
+	int sendCount_d[18] = {sendCount_x,sendCount_X,sendCount_y,sendCount_Y,sendCount_z,sendCount_Z,
+			sendCount_xy,sendCount_XY,sendCount_xY,sendCount_Xy,sendCount_xz,sendCount_XZ,
+			sendCount_xZ,sendCount_Xz,sendCount_yz,sendCount_YZ,sendCount_yZ,sendCount_Yz};
+	int recvCount_d[18] = {recvCount_x,recvCount_X,recvCount_y,recvCount_Y,recvCount_z,recvCount_Z,
+			recvCount_xy,recvCount_XY,recvCount_xY,recvCount_Xy,recvCount_xz,recvCount_XZ,
+			recvCount_xZ,recvCount_Xz,recvCount_yz,recvCount_YZ,recvCount_yZ,recvCount_Yz};
+	// one message per neighbor holding every registered field (use tags 192-209)
+	req_HaloAA.clear();
+	for (int d=0; d<18; d++){
+		HaloSendSize[d] = HaloRecvSize[d] = 0;
+		for (size_t f=0; f<HaloFields.size(); f++){
+			HaloSendSize[d] += HaloFieldCount(HaloFields[f].first,d)*sendCount_d[d];
+			HaloRecvSize[d] += HaloFieldCount(HaloFields[f].first,d)*recvCount_d[d];
+		}
+		ScaLBL_AllocateZeroCopy((void **) &HaloSendBuf[d], HaloSendSize[d]*sizeof(double));
+		ScaLBL_AllocateZeroCopy((void **) &HaloRecvBuf[d], HaloRecvSize[d]*sizeof(double));
+		// the message from neighbor d was sent in the opposite direction
+		req_HaloAA.push_back( MPI_COMM_SCALBL.Isend_init( HaloSendBuf[d], HaloSendSize[d], rank_d[d], 192+d ) );
+		req_HaloAA.push_back( MPI_COMM_SCALBL.Irecv_init( HaloRecvBuf[d], HaloRecvSize[d], rank_d[d], 192+(d^1) ) );
+	}
+}
+
+void ScaLBL_Communicator::SendHaloAA(){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
+	if (Lock==true){
+		ERROR("ScaLBL Error (SendHaloAA): ScaLBL_Communicator is locked -- did you forget to match Send/Recv calls?");
+	}
+	else{
+		Lock=true;
+	}
+	if (req_HaloAA.empty())
+		SetupHaloAA();
+
+	int *sendList_d[18] = {dvcSendList_x,dvcSendList_X,dvcSendList_y,dvcSendList_Y,dvcSendList_z,dvcSendList_Z,
+			dvcSendList_xy,dvcSendList_XY,dvcSendList_xY,dvcSendList_Xy,dvcSendList_xz,dvcSendList_XZ,
+			dvcSendList_xZ,dvcSendList_Xz,dvcSendList_yz,dvcSendList_YZ,dvcSendList_yZ,dvcSendList_Yz};
+	int sendCount_d[18] = {sendCount_x,sendCount_X,sendCount_y,sendCount_Y,sendCount_z,sendCount_Z,
+			sendCount_xy,sendCount_XY,sendCount_xY,sendCount_Xy,sendCount_xz,sendCount_XZ,
+			sendCount_xZ,sendCount_Xz,sendCount_yz,sendCount_YZ,sendCount_yZ,sendCount_Yz};
+	ScaLBL_DeviceBarrier();
+	for (int d=0; d<18; d++){
+		int count = sendCount_d[d];
+		int offset = 0;
+		for (size_t f=0; f<HaloFields.size(); f++){
+			int type = HaloFields[f].first;
+			double *data = HaloFields[f].second;
+			if (type == HALO_D3Q19){
+				for (int m=0; m<HaloD3Q19_Count[d]; m++){
+					ScaLBL_D3Q19_Pack(HaloD3Q19_q[d][m],sendList_d[d],offset,count,HaloSendBuf[d],data,N);
+					offset += count;
+				}
+			}
+			else if (type == HALO_D3Q7 && d < 6){
+				ScaLBL_D3Q19_Pack(HaloD3Q7_q[d],sendList_d[d],offset,count,HaloSendBuf[d],data,N);
+				offset += count;
+			}
+			else if (type == HALO_SCALAR){
+				ScaLBL_Scalar_Pack(dvcSendListRegular[d],count,&HaloSendBuf[d][offset],data,N);
+				offset += count;
+			}
+		}
+	}
+	ScaLBL_DeviceBarrier();
+	start( req_HaloAA );
+}
+
+void ScaLBL_Communicator::RecvHaloAA(){
+	PhaseTimer::Scope pack_timer(Timer.get(), PhaseTimer::PACK);
+	wait( req_HaloAA );
+	ScaLBL_DeviceBarrier();
+
+	int *recvList_d[18] = {dvcRecvList_x,dvcRecvList_X,dvcRecvList_y,dvcRecvList_Y,dvcRecvList_z,dvcRecvList_Z,
+			dvcRecvList_xy,dvcRecvList_XY,dvcRecvList_xY,dvcRecvList_Xy,dvcRecvList_xz,dvcRecvList_XZ,
+			dvcRecvList_xZ,dvcRecvList_Xz,dvcRecvList_yz,dvcRecvList_YZ,dvcRecvList_yZ,dvcRecvList_Yz};
+	int *recvDist_d[18] = {dvcRecvDist_x,dvcRecvDist_X,dvcRecvDist_y,dvcRecvDist_Y,dvcRecvDist_z,dvcRecvDist_Z,
+			dvcRecvDist_xy,dvcRecvDist_XY,dvcRecvDist_xY,dvcRecvDist_Xy,dvcRecvDist_xz,dvcRecvDist_XZ,
+			dvcRecvDist_xZ,dvcRecvDist_Xz,dvcRecvDist_yz,dvcRecvDist_YZ,dvcRecvDist_yZ,dvcRecvDist_Yz};
+	int recvCount_d[18] = {recvCount_x,recvCount_X,recvCount_y,recvCount_Y,recvCount_z,recvCount_Z,
+			recvCount_xy,recvCount_XY,recvCount_xY,recvCount_Xy,recvCount_xz,recvCount_XZ,
+			recvCount_xZ,recvCount_Xz,recvCount_yz,recvCount_YZ,recvCount_yZ,recvCount_Yz};
+	for (int d=0; d<18; d++){
+		int count = recvCount_d[d];
+		int offset = 0;
+		for (size_t f=0; f<HaloFields.size(); f++){
+			int type = HaloFields[f].first;
+			double *data = HaloFields[f].second;
+			if (type == HALO_D3Q19){
+				// NOTE: AA Routine writes to opposite
+				for (int m=0; m<HaloD3Q19_Count[d]; m++){
+					ScaLBL_D3Q7_Unpack(HaloD3Q19_q[d][m],&recvDist_d[d][m*count],offset,count,HaloRecvBuf[d],data,N);
+					offset += count;
+				}
+			}
+			else if (type == HALO_D3Q7 && d < 6){
+				// as in BiRecvD3Q7AA: with BC > 0 the inlet rank skips the z face, otherwise
+				// the outlet rank skips the Z face (a single z rank still unpacks Z)
+				bool skip = false;
+				if (BoundaryCondition > 0 && kproc == 0)
+					skip = (d == 4);
+				else if (BoundaryCondition > 0 && kproc == nprocz-1)
+					skip = (d == 5);
+				if (!skip)
+					ScaLBL_D3Q7_Unpack(HaloD3Q7_q[d],recvDist_d[d],offset,count,HaloRecvBuf[d],data,N);
+				offset += count;
+			}
+			else if (type == HALO_SCALAR){
+				ScaLBL_Scalar_Unpack(recvList_d[d],count,&HaloRecvBuf[d][offset],data,N);
+				offset += count;
+			}
+		}
+	}
+	//...................................................................................
+	Lock=false; // unlock the communicator after communications complete
+	//...................................................................................
+}
+
 void ScaLBL_Communicator::RegularLayout(IntArray map, const double *data, DoubleArray &regdata){
+	RegularLayout(map, data, N, regdata);
+}
+
+void ScaLBL_Communicator::RegularLayout(IntArray map, const double *data, int count, DoubleArray &regdata){
 	// Gets data from the device and stores in regular layout
 	int i,j,k,idx;
 	int Nx = map.size(0);
@@ -2308,14 +3016,14 @@ void ScaLBL_Communicator::RegularLayout(IntArray map, const double *data, Double
 	
 	double *TmpDat;
 	double value;
-	TmpDat = new double [N];
-	ScaLBL_CopyToHost(&TmpDat[0],&data[0], N*sizeof(double));
+	TmpDat = new double [count];
+	ScaLBL_CopyToHost(&TmpDat[0],&data[0], count*sizeof(double));
 	for (k=0; k<Nz; k++){
 		for (j=0; j<Ny; j++){
 			for (i=0; i<Nx; i++){
 				n=k*Nx*Ny+j*Nx+i;
 				idx=map(i,j,k);
-				if (!(idx<0)){
+				if (!(idx<0) && idx<count){
 					value=TmpDat[idx];
 					regdata(i,j,k)=value;
 				}
@@ -2327,6 +3035,83 @@ void ScaLBL_Communicator::RegularLayout(IntArray map, const double *data, Double
 	delete [] TmpDat;
 }
 
+int ScaLBL_Communicator::SparseLayout(const IntArray &Map, int Np, IntArray &PhiMap,
+		std::vector<int> &ringOffset, std::vector<int> &ringIndex){
+	// neighbors in the same order as NeighborList (see MemoryOptimizedLayoutAA)
+	const int D3Q19[18][3] = {{-1,0,0},{1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1},
+			{-1,-1,0},{1,1,0},{-1,1,0},{1,-1,0},{-1,0,-1},{1,0,1},
+			{-1,0,1},{1,0,-1},{0,-1,-1},{0,1,1},{0,-1,1},{0,1,-1}};
+	int Nx = Map.size(0);
+	int Ny = Map.size(1);
+	int Nz = Map.size(2);
+	// fluid sites use the same index as the sparse layout
+	PhiMap.resize(Nx,Ny,Nz);
+	PhiMap.fill(-1);
+	for (size_t n=0; n<Map.length(); n++){
+		if (!(Map(n)<0)) PhiMap(n) = Map(n);
+	}
+	int count = Np;
+	// solid and halo neighbors of each fluid site
+	ringOffset.assign(Np+1,0);
+	ringIndex.clear();
+	for (int pass=0; pass<2; pass++){
+		for (int k=1; k<Nz-1; k++){
+			for (int j=1; j<Ny-1; j++){
+				for (int i=1; i<Nx-1; i++){
+					int idx = Map(i,j,k);
+					if (idx<0) continue;
+					int r = ringOffset[idx];
+					for (int q=0; q<18; q++){
+						int ii = i+D3Q19[q][0];
+						int jj = j+D3Q19[q][1];
+						int kk = k+D3Q19[q][2];
+						if (!(Map(ii,jj,kk)<0)) continue;
+						if (pass==0){
+							ringOffset[idx+1]++;
+						}
+						else {
+							if (PhiMap(ii,jj,kk)<0) PhiMap(ii,jj,kk) = count++;
+							ringIndex[r++] = PhiMap(ii,jj,kk);
+						}
+					}
+				}
+			}
+		}
+		if (pass==0){
+			for (int n=0; n<Np; n++) ringOffset[n+1] += ringOffset[n];
+			ringIndex.resize(ringOffset[Np]);
+		}
+	}
+	int dummy = count++;
+
+	// Re-index the regular send and recv lists
+	int *SendList[18] = {dvcSendList_x,dvcSendList_y,dvcSendList_z,dvcSendList_X,dvcSendList_Y,dvcSendList_Z,
+			dvcSendList_xy,dvcSendList_yz,dvcSendList_xz,dvcSendList_Xy,dvcSendList_Yz,dvcSendList_xZ,
+			dvcSendList_xY,dvcSendList_yZ,dvcSendList_Xz,dvcSendList_XY,dvcSendList_YZ,dvcSendList_XZ};
+	int *RecvList[18] = {dvcRecvList_x,dvcRecvList_y,dvcRecvList_z,dvcRecvList_X,dvcRecvList_Y,dvcRecvList_Z,
+			dvcRecvList_xy,dvcRecvList_yz,dvcRecvList_xz,dvcRecvList_Xy,dvcRecvList_Yz,dvcRecvList_xZ,
+			dvcRecvList_xY,dvcRecvList_yZ,dvcRecvList_Xz,dvcRecvList_XY,dvcRecvList_YZ,dvcRecvList_XZ};
+	int SendCount[18] = {sendCount_x,sendCount_y,sendCount_z,sendCount_X,sendCount_Y,sendCount_Z,
+			sendCount_xy,sendCount_yz,sendCount_xz,sendCount_Xy,sendCount_Yz,sendCount_xZ,
+			sendCount_xY,sendCount_yZ,sendCount_Xz,sendCount_XY,sendCount_YZ,sendCount_XZ};
+	int RecvCount[18] = {recvCount_x,recvCount_y,recvCount_z,recvCount_X,recvCount_Y,recvCount_Z,
+			recvCount_xy,recvCount_yz,recvCount_xz,recvCount_Xy,recvCount_Yz,recvCount_xZ,
+			recvCount_xY,recvCount_yZ,recvCount_Xz,recvCount_XY,recvCount_YZ,recvCount_XZ};
+	std::vector<int> TempBuffer;
+	for (int d=0; d<36; d++){
+		int *list = d<18 ? SendList[d] : RecvList[d-18];
+		int n = d<18 ? SendCount[d] : RecvCount[d-18];
+		TempBuffer.resize(n);
+		ScaLBL_CopyToHost(TempBuffer.data(),list,n*sizeof(int));
+		for (int i=0; i<n; i++){
+			int idx = PhiMap(TempBuffer[i]);
+			TempBuffer[i] = idx<0 ? dummy : idx;
+		}
+		ScaLBL_CopyToDevice(list,TempBuffer.data(),n*sizeof(int));
+	}
+	return count;
+}
+
 void ScaLBL_Communicator::Color_BC_z(int *Map, double *Phi, double *Den, double vA, double vB){
 	if (kproc == 0) {
 		if (BoundaryCondition == 5){
@@ -2353,7 +3138,8 @@ void ScaLBL_Communicator::Color_BC_Z(int *Map, double *Phi, double *Den, double
 
 }
 
-void ScaLBL_Communicator::D3Q19_Pressure_BC_z(int *neighborList, double *fq, double din, int time){
+template <class TYPE>
+void ScaLBL_Communicator::D3Q19_Pressure_BC_z(int *neighborList, TYPE *fq, double din, int time){
     //ScaLBL_D3Q19_Pressure_BC_z(int *LIST,fq,din,Nx,Ny,Nz);
 	if (kproc == 0) {
 		if (time%2==0){
@@ -2365,7 +3151,8 @@ void ScaLBL_Communicator::D3Q19_Pressure_BC_z(int *neighborList, double *fq, dou
 	}
 }
 
-void ScaLBL_Communicator::D3Q19_Pressure_BC_Z(int *neighborList, double *fq, double dout, int time){
+template <class TYPE>
+void ScaLBL_Communicator::D3Q19_Pressure_BC_Z(int *neighborList, TYPE *fq, double dout, int time){
     //ScaLBL_D3Q19_Pressure_BC_Z(int *LIST,fq,dout,Nx,Ny,Nz);
 	if (kproc == nprocz-1){
 		if (time%2==0){
@@ -2377,7 +3164,8 @@ void ScaLBL_Communicator::D3Q19_Pressure_BC_Z(int *neighborList, double *fq, dou
 	}
 }
 
-double ScaLBL_Communicator::D3Q19_Flux_BC_z(int *neighborList, double *fq, double flux, int time){
+template <class TYPE>
+double ScaLBL_Communicator::D3Q19_Flux_BC_z(int *neighborList, TYPE *fq, double flux, int time){
 	double sum, locsum, din;
 	double LocInletArea, InletArea;
 	
@@ -2419,17 +3207,32 @@ double ScaLBL_Communicator::D3Q19_Flux_BC_z(int *neighborList, double *fq, doubl
 	return din;
 }
 
-void ScaLBL_Communicator::D3Q19_Reflection_BC_z(double *fq){
+template <class TYPE>
+void ScaLBL_Communicator::D3Q19_Reflection_BC_z(TYPE *fq){
 	if (kproc == 0)
 		ScaLBL_D3Q19_Reflection_BC_z(dvcSendList_z, fq, sendCount_z, N);
 	
 }
 
-void ScaLBL_Communicator::D3Q19_Reflection_BC_Z(double *fq){
+template <class TYPE>
+void ScaLBL_Communicator::D3Q19_Reflection_BC_Z(TYPE *fq){
 	if (kproc == nprocz-1)
 		ScaLBL_D3Q19_Reflection_BC_Z(dvcSendList_Z, fq, sendCount_Z, N);
 }
 
+template void ScaLBL_Communicator::D3Q19_Pressure_BC_z<double>(int *neighborList, double *fq, double din, int time);
+template void ScaLBL_Communicator::D3Q19_Pressure_BC_Z<double>(int *neighborList, double *fq, double dout, int time);
+template double ScaLBL_Communicator::D3Q19_Flux_BC_z<double>(int *neighborList, double *fq, double flux, int time);
+template void ScaLBL_Communicator::D3Q19_Reflection_BC_z<double>(double *fq);
+template void ScaLBL_Communicator::D3Q19_Reflection_BC_Z<double>(double *fq);
+#ifdef SCALBL_FLOAT_STORAGE
+template void ScaLBL_Communicator::D3Q19_Pressure_BC_z<float>(int *neighborList, float *fq, double din, int time);
+template void ScaLBL_Communicator::D3Q19_Pressure_BC_Z<float>(int *neighborList, float *fq, double dout, int time);
+template double ScaLBL_Communicator::D3Q19_Flux_BC_z<float>(int *neighborList, float *fq, double flux, int time);
+template void ScaLBL_Communicator::D3Q19_Reflection_BC_z<float>(float *fq);
+template void ScaLBL_Communicator::D3Q19_Reflection_BC_Z<float>(float *fq);
+#endif
+
 void ScaLBL_Communicator::PrintD3Q19(){
 	printf("Printing D3Q19 communication buffer contents \n");
 
@@ -26,6 +26,13 @@
 #ifndef ScalLBL_H
 #define ScalLBL_H
 #include "common/Domain.h"
+#include "common/PhaseTimer.h"
+
+// Distributions stored in single precision (precision = "single") use the _float
+// kernels, which are only implemented for the cpu backend
+#if !defined(USE_CUDA) && !defined(USE_HIP)
+#define SCALBL_FLOAT_STORAGE
+#endif
 
 /**
 * \brief Set compute device
@@ -40,6 +47,16 @@ extern "C" int ScaLBL_SetDevice(int rank);
 */
 extern "C" void ScaLBL_AllocateDeviceMemory(void** address, size_t size);
 
+/**
+* \brief Allocate memory for a distribution stored as Nq contiguous planes (e.g. fq[q*Np+n])
+* With OpenMP each plane is first touched using the static partition of the kernels,
+* so that memory is placed on the NUMA domain of the thread that updates it
+* @param address      memory address
+* @param size         size in bytes
+* @param Nq           number of planes (e.g. 19 for D3Q19)
+*/
+extern "C" void ScaLBL_AllocateDistributionMemory(void** address, size_t size, int Nq);
+
 /**
 * \brief Free memory
 * @param pointer         pointer to memory to free
@@ -116,6 +133,31 @@ extern "C" void ScaLBL_D3Q19_Pack(int q, int *list, int start, int count, double
 */
 extern "C" void ScaLBL_D3Q19_Unpack(int q, int *list, int start, int count, double *recvbuf, double *dist, int N);
 
+/**
+* \brief  Pack D3Q19 distributions stored in single precision for communication
+*         - values are copied as stored (see ScaLBL_D3Q19_Init_float)
+* @param q  - index for distribution based on D3Q19 discrete velocity structure
+* @param list - list of distributions to communicate
+* @param start -  index to start parsing the list 
+* @param count -  number of values to pack 
+* @param sendbuf - memory buffer to hold values that will be sent
+* @param dist - memory buffer to hold the distributions
+* @param N - size of the distributions (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q19_Pack_float(int q, int *list, int start, int count, float *sendbuf, float *dist, int N);
+
+/**
+* \brief  Unpack D3Q19 distributions stored in single precision after communication
+* @param q  - index for distribution based on D3Q19 discrete velocity structure
+* @param list - list of distributions to communicate
+* @param start -  index to start parsing the list 
+* @param count -  number of values to unppack 
+* @param recvbuf - memory buffer where recieved values have been stored
+* @param dist - memory buffer to hold the distributions
+* @param N - size of the distributions (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q19_Unpack_float(int q, int *list, int start, int count, float *recvbuf, float *dist, int N);
+
 /**
 * \brief Unpack D3Q7 distributions after communication
 * @param q  - index for distribution based on D3Q19 discrete velocity structure
@@ -128,6 +170,18 @@ extern "C" void ScaLBL_D3Q19_Unpack(int q, int *list, int start, int count, doub
 */
 extern "C" void ScaLBL_D3Q7_Unpack(int q, int *list,  int start, int count, double *recvbuf, double *dist, int N);
 
+/**
+* \brief Unpack D3Q7 distributions stored in single precision after communication
+* @param q  - index for distribution based on D3Q19 discrete velocity structure
+* @param list - list of distributions to communicate
+* @param start -  index to start parsing the list 
+* @param count -  number of values to unppack 
+* @param recvbuf - memory buffer where recieved values have been stored
+* @param dist - memory buffer to hold the distributions
+* @param N - size of the distributions (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q7_Unpack_float(int q, int *list,  int start, int count, float *recvbuf, float *dist, int N);
+
 /**
 * \brief  Pack halo for scalar field to be prepare for communication
 * @param list - list of distributions to communicate
@@ -181,6 +235,23 @@ extern "C" void ScaLBL_D3Q19_Init(double *Dist, int Np);
 */
 extern "C" void ScaLBL_D3Q19_Momentum(double *dist, double *vel, int Np);
 
+/**
+* \brief Initialize D3Q19 distributions stored in single precision
+*        - distributions are stored shifted by the lattice weight, f_q - w_q,
+*          so that the float mantissa resolves the deviation from the rest state
+* @param Dist - D3Q19 distributions
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q19_Init_float(float *Dist, int Np);
+
+/**
+* \brief Compute momentum from D3Q19 distribution stored in single precision
+* @param dist - D3Q19 distributions (shifted storage)
+* @param vel - memory buffer to store the momentum that is computed
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q19_Momentum_float(float *dist, double *vel, int Np);
+
 /**
 * \brief compute pressure from D3Q19 distribution
 * @param dist - D3Q19 distributions
@@ -189,6 +260,14 @@ extern "C" void ScaLBL_D3Q19_Momentum(double *dist, double *vel, int Np);
 */
 extern "C" void ScaLBL_D3Q19_Pressure(double *dist, double *press, int Np);
 
+/**
+* \brief compute pressure from D3Q19 distribution stored in single precision
+* @param dist - D3Q19 distributions (shifted storage)
+* @param press - memory buffer to store the pressure field that is computed
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q19_Pressure_float(float *dist, double *press, int Np);
+
 // BGK MODEL
 /**
 * \brief BGK collision based on AA even access pattern for D3Q19 
@@ -297,6 +376,14 @@ extern "C" void ScaLBL_D3Q7_AAodd_Ion_v0(int *neighborList, double *dist, double
 extern "C" void ScaLBL_D3Q7_AAeven_Ion_v0(double *dist, double *Den, double *FluxDiffusive, double *FluxAdvective, double *FluxElectrical, double *Velocity, double *ElectricField, 
                                        double Di, int zi, double rlx, double Vt, int start, int finish, int Np);
 
+// Fused update for several ion species (concentration, fluxes and collision in one sweep)
+// IonCoef holds (diffusivity, valence, 1/tau) for each species, Species lists the species to update
+extern "C" void ScaLBL_D3Q7_AAodd_Ion_Multi(int *neighborList, double *dist, double *Den, double *FluxDiffusive, double *FluxAdvective, double *FluxElectrical, double *Velocity, double *ElectricField, 
+                                         double *IonCoef, int *Species, int Nspecies, double Vt, int start, int finish, int Np);
+
+extern "C" void ScaLBL_D3Q7_AAeven_Ion_Multi(double *dist, double *Den, double *FluxDiffusive, double *FluxAdvective, double *FluxElectrical, double *Velocity, double *ElectricField, 
+                                          double *IonCoef, int *Species, int Nspecies, double Vt, int start, int finish, int Np);
+
 extern "C" void ScaLBL_D3Q7_AAodd_Ion(int *neighborList, double *dist, double *Den, double *FluxDiffusive, double *FluxAdvective, double *FluxElectrical, double *Velocity, double *ElectricField, 
                                       double Di, int zi, double rlx, double Vt, int start, int finish, int Np);
 
@@ -443,6 +530,39 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish, int
 extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist, int start, int finish, int Np,
 		double rlx_setA, double rlx_setB, double Fx, double Fy, double Fz);
 
+/**
+* \brief MRT collision based on AA even access pattern for D3Q19 (single precision storage)
+*        - distributions are loaded / stored as float (shifted by the lattice weight),
+*          moments and collision are computed in double precision
+* @param dist - D3Q19 distributions
+* @param start - lattice node to start loop
+* @param finish - lattice node to finish loop
+* @param Np - size of local sub-domain (derived from Domain structure)
+* @param rlx_setA - relaxation parameter for viscous modes
+* @param rlx_setB - relaxation parameter for non-viscous modes
+* @param Fx - force in x direction
+* @param Fy - force in y direction
+* @param Fz - force in z direction
+*/
+extern "C" void ScaLBL_D3Q19_AAeven_MRT_float(float *dist, int start, int finish, int Np, double rlx_setA, double rlx_setB, double Fx,
+		double Fy, double Fz);
+
+/**
+* \brief MRT collision based on AA odd access pattern for D3Q19 (single precision storage)
+* @param neighborList - index of neighbors based on D3Q19 lattice structure
+* @param dist - D3Q19 distributions
+* @param start - lattice node to start loop
+* @param finish - lattice node to finish loop
+* @param Np - size of local sub-domain (derived from Domain structure)
+* @param rlx_setA - relaxation parameter for viscous modes
+* @param rlx_setB - relaxation parameter for non-viscous modes
+* @param Fx - force in x direction
+* @param Fy - force in y direction
+* @param Fz - force in z direction
+*/
+extern "C" void ScaLBL_D3Q19_AAodd_MRT_float(int *neighborList, float *dist, int start, int finish, int Np,
+		double rlx_setA, double rlx_setB, double Fx, double Fy, double Fz);
+
 // COLOR MODEL
 /**
 * \brief Color model collision based on AA even access pattern for D3Q19 
@@ -501,6 +621,111 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(int *NeighborList, int *Map, double *di
 		double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
 		double Fx, double Fy, double Fz, int strideY, int strideZ, int start, int finish, int Np);
 
+/**
+* \brief Fused phase field and color model collision based on AA even access pattern for D3Q19
+*        - equivalent to ScaLBL_D3Q7_AAeven_PhaseField followed by ScaLBL_D3Q19_AAeven_Color
+*        - the phase field is computed in blocks that run span sites ahead of the collision,
+*          so that Aq, Bq and Den are re-used from cache
+*        - Phi must already be up to date for all sites outside [start,finish)
+* @param Map - mapping between sparse and dense data structures
+* @param dist - D3Q19 distributions
+* @param Aq - D3Q7 distribution for component A
+* @param Bq - D3Q7 distribution for component B
+* @param Den - density field
+* @param Phi - phase indicator field
+* @param Vel - velocity field
+* @param rhoA - density of component A
+* @param rhoB - density of component B
+* @param tauA - relaxation time for component A
+* @param tauB - relaxation time for component B
+* @param alpha - parameter to control interfacial tension
+* @param beta - parameter to control interface width
+* @param Fx - force in x direction
+* @param Fy - force in y direction
+* @param Fz - force in z direction
+* @param strideY - stride in y-direction for gradient computation
+* @param strideZ - stride in z-direction for gradient computation
+* @param span - maximum forward offset to a neighbor within [start,finish) (see ScaLBL_Communicator::InteriorSpan)
+* @param start - lattice node to start loop
+* @param finish - lattice node to finish loop
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Fused(int *Map, double *dist, double *Aq, double *Bq, double *Den, double *Phi,
+		double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int span, int start, int finish, int Np);
+
+/**
+* \brief Fused phase field and color model collision based on AA odd access pattern for D3Q19
+*        - equivalent to ScaLBL_D3Q7_AAodd_PhaseField followed by ScaLBL_D3Q19_AAodd_Color
+*        - see ScaLBL_D3Q19_AAeven_Color_Fused
+* @param NeighborList - neighbors based on D3Q19 lattice structure
+* @param Map - mapping between sparse and dense data structures
+* @param dist - D3Q19 distributions
+* @param Aq - D3Q7 distribution for component A
+* @param Bq - D3Q7 distribution for component B
+* @param Den - density field
+* @param Phi - phase indicator field
+* @param Vel - velocity field
+* @param rhoA - density of component A
+* @param rhoB - density of component B
+* @param tauA - relaxation time for component A
+* @param tauB - relaxation time for component B
+* @param alpha - parameter to control interfacial tension
+* @param beta - parameter to control interface width
+* @param Fx - force in x direction
+* @param Fy - force in y direction
+* @param Fz - force in z direction
+* @param strideY - stride in y-direction for gradient computation
+* @param strideZ - stride in z-direction for gradient computation
+* @param span - maximum forward offset to a neighbor within [start,finish) (see ScaLBL_Communicator::InteriorSpan)
+* @param start - lattice node to start loop
+* @param finish - lattice node to finish loop
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Fused(int *NeighborList, int *Map, double *dist, double *Aq, double *Bq, double *Den, 
+		double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int span, int start, int finish, int Np);
+
+/**
+* \brief Color model collision based on AA even access pattern for D3Q19 with a compact phase field
+*        - equivalent to ScaLBL_D3Q19_AAeven_Color, but Phi is stored for the Np fluid sites
+*          followed by the solid and halo sites that are neighbors of a fluid site (the ring)
+*        - fluid neighbors are found from NeighborList; the other neighbors of site n are
+*          Phi[ringIndex[ringOffset[n]...ringOffset[n+1]-1]] in the order of the D3Q19 directions
+* @param NeighborList - neighbors based on D3Q19 lattice structure
+* @param ringOffset - first ring entry for each site (size Np+1)
+* @param ringIndex - index in Phi for the solid and halo neighbors of each site
+* @param dist - D3Q19 distributions
+* @param Aq - D3Q7 distribution for component A
+* @param Bq - D3Q7 distribution for component B
+* @param Den - density field
+* @param Phi - phase indicator field (compact layout)
+* @param Vel - velocity field
+* @param rhoA - density of component A
+* @param rhoB - density of component B
+* @param tauA - relaxation time for component A
+* @param tauB - relaxation time for component B
+* @param alpha - parameter to control interfacial tension
+* @param beta - parameter to control interface width
+* @param Fx - force in x direction
+* @param Fy - force in y direction
+* @param Fz - force in z direction
+* @param start - lattice node to start loop
+* @param finish - lattice node to finish loop
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Sparse(int *NeighborList, int *ringOffset, int *ringIndex, double *dist,
+		double *Aq, double *Bq, double *Den, double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+		double alpha, double beta, double Fx, double Fy, double Fz, int start, int finish, int Np);
+
+/**
+* \brief Color model collision based on AA odd access pattern for D3Q19 with a compact phase field
+*        - see ScaLBL_D3Q19_AAeven_Color_Sparse
+*/
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Sparse(int *NeighborList, int *ringOffset, int *ringIndex, double *dist,
+		double *Aq, double *Bq, double *Den, double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+		double alpha, double beta, double Fx, double Fy, double Fz, int start, int finish, int Np);
+
 /**
 * \brief Compute phase field based on AA odd access pattern for D3Q19 
 * @param NeighborList - neighbors based on D3Q19 lattice structure
@@ -543,6 +768,58 @@ extern "C" void ScaLBL_D3Q7_AAeven_PhaseField(int *Map, double *Aq, double *Bq,
 */
 extern "C" void ScaLBL_PhaseField_Init(int *Map, double *Phi, double *Den, double *Aq, double *Bq, int start, int finish, int Np);
 
+/**
+* \brief Initialize phase field for color model on a list of lattice sites
+* @param list - lattice sites to initialize (sparse index)
+* @param Map - mapping between sparse and dense data structures
+* @param Phi - phase indicator field
+* @param Den - density field
+* @param Aq - D3Q7 distribution for component A
+* @param Bq - D3Q7 distribution for component B
+* @param count - number of lattice sites in the list
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+extern "C" void ScaLBL_PhaseField_InitList(int *list, int *Map, double *Phi, double *Den, double *Aq, double *Bq, int count, int Np);
+
+/**
+* \brief Color model kernels for distributions stored in single precision
+*        - dist is stored shifted by the lattice weight (see ScaLBL_D3Q19_Init_float)
+*        - Aq and Bq lie between zero and the D3Q7 lattice weight and are stored as they are
+*        - all arithmetic is done in double precision; the arguments are the same as
+*          for the double precision kernels
+*/
+extern "C" void ScaLBL_D3Q19_AAeven_Color_float(int *Map, float *dist, float *Aq, float *Bq, double *Den, double *Phi,
+		double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int start, int finish, int Np);
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_float(int *NeighborList, int *Map, float *dist, float *Aq, float *Bq, double *Den, 
+		double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int start, int finish, int Np);
+
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Fused_float(int *Map, float *dist, float *Aq, float *Bq, double *Den, double *Phi,
+		double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int span, int start, int finish, int Np);
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Fused_float(int *NeighborList, int *Map, float *dist, float *Aq, float *Bq, double *Den, 
+		double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int span, int start, int finish, int Np);
+
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Sparse_float(int *NeighborList, int *ringOffset, int *ringIndex, float *dist,
+		float *Aq, float *Bq, double *Den, double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+		double alpha, double beta, double Fx, double Fy, double Fz, int start, int finish, int Np);
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Sparse_float(int *NeighborList, int *ringOffset, int *ringIndex, float *dist,
+		float *Aq, float *Bq, double *Den, double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+		double alpha, double beta, double Fx, double Fy, double Fz, int start, int finish, int Np);
+
+extern "C" void ScaLBL_D3Q7_AAodd_PhaseField_float(int *NeighborList, int *Map, float *Aq, float *Bq, 
+			double *Den, double *Phi, int start, int finish, int Np);
+
+extern "C" void ScaLBL_D3Q7_AAeven_PhaseField_float(int *Map, float *Aq, float *Bq, double *Den, double *Phi, 
+			int start, int finish, int Np);
+
+extern "C" void ScaLBL_PhaseField_Init_float(int *Map, double *Phi, double *Den, float *Aq, float *Bq, int start, int finish, int Np);
+
 
 extern "C" void ScaLBL_D3Q7_AAodd_Color(int *neighborList, int *Map, double *Aq, double *Bq, double *Den, 
 		double *Phi, double *ColorGrad, double *Vel, double rhoA, double rhoB, double beta, int start, int finish, int Np);
@@ -643,6 +920,21 @@ extern "C" double ScaLBL_D3Q19_AAodd_Flux_BC_z(int *neighborList, int *list, dou
 extern "C" double ScaLBL_D3Q19_AAeven_Flux_BC_z(int *list, double *dist, double flux, double area, 
 		 int count, int N);
 
+// pressure and flux boundary conditions for distributions stored in single precision
+extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_z_float(int *neighborList, int *list, float *dist, double din, int count, int Np);
+
+extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_Z_float(int *neighborList, int *list, float *dist, double dout, int count, int Np);
+
+extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_z_float(int *list, float *dist, double din, int count, int Np);
+
+extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_Z_float(int *list, float *dist, double dout, int count, int Np);
+
+extern "C" double ScaLBL_D3Q19_AAodd_Flux_BC_z_float(int *neighborList, int *list, float *dist, double flux, 
+		double area, int count, int N);
+
+extern "C" double ScaLBL_D3Q19_AAeven_Flux_BC_z_float(int *list, float *dist, double flux, double area, 
+		 int count, int N);
+
 extern "C" void ScaLBL_Color_BC_z(int *list, int *Map, double *Phi, double *Den, double vA, double vB, int count, int Np);
 
 extern "C" void ScaLBL_Color_BC_Z(int *list, int *Map, double *Phi, double *Den, double vA, double vB, int count, int Np);
@@ -651,6 +943,10 @@ extern "C" void ScaLBL_D3Q19_Reflection_BC_z(int *list, double *dist, int count,
 
 extern "C" void ScaLBL_D3Q19_Reflection_BC_Z(int *list, double *dist, int count, int Np);
 
+extern "C" void ScaLBL_D3Q19_Reflection_BC_z_float(int *list, float *dist, int count, int Np);
+
+extern "C" void ScaLBL_D3Q19_Reflection_BC_Z_float(int *list, float *dist, int count, int Np);
+
 extern "C" void ScaLBL_D3Q7_Reflection_BC_z(int *list, double *dist, int count, int Np);
 
 extern "C" void ScaLBL_D3Q7_Reflection_BC_Z(int *list, double *dist, int count, int Np);
@@ -706,6 +1002,124 @@ extern "C" void ScaLBL_D3Q7_AAeven_Ion_Flux_DiffAdvcElec_BC_Z(int *list, double
 extern "C" void ScaLBL_D3Q7_AAodd_Ion_Flux_DiffAdvcElec_BC_z(int *d_neighborList, int *list, double *dist, double Cin, double tau, double *VelocityZ,double *ElectricField,double Di,double zi,double Vt, int count, int Np);
 extern "C" void ScaLBL_D3Q7_AAodd_Ion_Flux_DiffAdvcElec_BC_Z(int *d_neighborList, int *list, double *dist, double Cout, double tau, double *VelocityZ,double *ElectricField,double Di,double zi,double Vt, int count, int Np);
 
+// Overloads on the storage type of the distributions, so that code templated on the
+// storage type (e.g. ScaLBL_ColorModel::Step) calls the matching kernel
+inline void ScaLBL_D3Q19_Pack(int q, int *list, int start, int count, float *sendbuf, float *dist, int N){
+	ScaLBL_D3Q19_Pack_float(q, list, start, count, sendbuf, dist, N);
+}
+inline void ScaLBL_D3Q7_Unpack(int q, int *list, int start, int count, float *recvbuf, float *dist, int N){
+	ScaLBL_D3Q7_Unpack_float(q, list, start, count, recvbuf, dist, N);
+}
+inline void ScaLBL_D3Q19_Init(float *dist, int Np){
+	ScaLBL_D3Q19_Init_float(dist, Np);
+}
+inline void ScaLBL_D3Q19_Momentum(float *dist, double *vel, int Np){
+	ScaLBL_D3Q19_Momentum_float(dist, vel, Np);
+}
+inline void ScaLBL_D3Q19_Pressure(float *dist, double *press, int Np){
+	ScaLBL_D3Q19_Pressure_float(dist, press, Np);
+}
+inline void ScaLBL_D3Q19_AAeven_MRT(float *dist, int start, int finish, int Np, double rlx_setA, double rlx_setB,
+		double Fx, double Fy, double Fz){
+	ScaLBL_D3Q19_AAeven_MRT_float(dist, start, finish, Np, rlx_setA, rlx_setB, Fx, Fy, Fz);
+}
+inline void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, float *dist, int start, int finish, int Np, double rlx_setA,
+		double rlx_setB, double Fx, double Fy, double Fz){
+	ScaLBL_D3Q19_AAodd_MRT_float(neighborList, dist, start, finish, Np, rlx_setA, rlx_setB, Fx, Fy, Fz);
+}
+inline void ScaLBL_D3Q19_AAeven_Color(int *Map, float *dist, float *Aq, float *Bq, double *Den, double *Phi,
+		double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int start, int finish, int Np){
+	ScaLBL_D3Q19_AAeven_Color_float(Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+			Fx, Fy, Fz, strideY, strideZ, start, finish, Np);
+}
+inline void ScaLBL_D3Q19_AAodd_Color(int *NeighborList, int *Map, float *dist, float *Aq, float *Bq, double *Den,
+		double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int start, int finish, int Np){
+	ScaLBL_D3Q19_AAodd_Color_float(NeighborList, Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+			Fx, Fy, Fz, strideY, strideZ, start, finish, Np);
+}
+inline void ScaLBL_D3Q19_AAeven_Color_Fused(int *Map, float *dist, float *Aq, float *Bq, double *Den, double *Phi,
+		double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int span, int start, int finish, int Np){
+	ScaLBL_D3Q19_AAeven_Color_Fused_float(Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+			Fx, Fy, Fz, strideY, strideZ, span, start, finish, Np);
+}
+inline void ScaLBL_D3Q19_AAodd_Color_Fused(int *NeighborList, int *Map, float *dist, float *Aq, float *Bq, double *Den,
+		double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int span, int start, int finish, int Np){
+	ScaLBL_D3Q19_AAodd_Color_Fused_float(NeighborList, Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB,
+			alpha, beta, Fx, Fy, Fz, strideY, strideZ, span, start, finish, Np);
+}
+inline void ScaLBL_D3Q19_AAeven_Color_Sparse(int *NeighborList, int *ringOffset, int *ringIndex, float *dist,
+		float *Aq, float *Bq, double *Den, double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+		double alpha, double beta, double Fx, double Fy, double Fz, int start, int finish, int Np){
+	ScaLBL_D3Q19_AAeven_Color_Sparse_float(NeighborList, ringOffset, ringIndex, dist, Aq, Bq, Den, Phi, Vel,
+			rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, start, finish, Np);
+}
+inline void ScaLBL_D3Q19_AAodd_Color_Sparse(int *NeighborList, int *ringOffset, int *ringIndex, float *dist,
+		float *Aq, float *Bq, double *Den, double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+		double alpha, double beta, double Fx, double Fy, double Fz, int start, int finish, int Np){
+	ScaLBL_D3Q19_AAodd_Color_Sparse_float(NeighborList, ringOffset, ringIndex, dist, Aq, Bq, Den, Phi, Vel,
+			rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, start, finish, Np);
+}
+inline void ScaLBL_D3Q7_AAodd_PhaseField(int *NeighborList, int *Map, float *Aq, float *Bq,
+		double *Den, double *Phi, int start, int finish, int Np){
+	ScaLBL_D3Q7_AAodd_PhaseField_float(NeighborList, Map, Aq, Bq, Den, Phi, start, finish, Np);
+}
+inline void ScaLBL_D3Q7_AAeven_PhaseField(int *Map, float *Aq, float *Bq, double *Den, double *Phi,
+		int start, int finish, int Np){
+	ScaLBL_D3Q7_AAeven_PhaseField_float(Map, Aq, Bq, Den, Phi, start, finish, Np);
+}
+inline void ScaLBL_PhaseField_Init(int *Map, double *Phi, double *Den, float *Aq, float *Bq, int start, int finish, int Np){
+	ScaLBL_PhaseField_Init_float(Map, Phi, Den, Aq, Bq, start, finish, Np);
+}
+inline void ScaLBL_D3Q19_AAodd_Pressure_BC_z(int *neighborList, int *list, float *dist, double din, int count, int Np){
+	ScaLBL_D3Q19_AAodd_Pressure_BC_z_float(neighborList, list, dist, din, count, Np);
+}
+inline void ScaLBL_D3Q19_AAodd_Pressure_BC_Z(int *neighborList, int *list, float *dist, double dout, int count, int Np){
+	ScaLBL_D3Q19_AAodd_Pressure_BC_Z_float(neighborList, list, dist, dout, count, Np);
+}
+inline void ScaLBL_D3Q19_AAeven_Pressure_BC_z(int *list, float *dist, double din, int count, int Np){
+	ScaLBL_D3Q19_AAeven_Pressure_BC_z_float(list, dist, din, count, Np);
+}
+inline void ScaLBL_D3Q19_AAeven_Pressure_BC_Z(int *list, float *dist, double dout, int count, int Np){
+	ScaLBL_D3Q19_AAeven_Pressure_BC_Z_float(list, dist, dout, count, Np);
+}
+inline double ScaLBL_D3Q19_AAodd_Flux_BC_z(int *neighborList, int *list, float *dist, double flux,
+		double area, int count, int N){
+	return ScaLBL_D3Q19_AAodd_Flux_BC_z_float(neighborList, list, dist, flux, area, count, N);
+}
+inline double ScaLBL_D3Q19_AAeven_Flux_BC_z(int *list, float *dist, double flux, double area,
+		int count, int N){
+	return ScaLBL_D3Q19_AAeven_Flux_BC_z_float(list, dist, flux, area, count, N);
+}
+inline void ScaLBL_D3Q19_Reflection_BC_z(int *list, float *dist, int count, int Np){
+	ScaLBL_D3Q19_Reflection_BC_z_float(list, dist, count, Np);
+}
+inline void ScaLBL_D3Q19_Reflection_BC_Z(int *list, float *dist, int count, int Np){
+	ScaLBL_D3Q19_Reflection_BC_Z_float(list, dist, count, Np);
+}
+
+/**
+* \brief Copy D3Q19 distributions from the host (double precision) to the device
+*        - float storage is shifted by the lattice weight (see ScaLBL_D3Q19_Init_float)
+* @param dist - D3Q19 distributions on the device
+* @param host - host buffer with 19*Np values
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+void ScaLBL_D3Q19_CopyToDevice(double *dist, const double *host, int Np);
+void ScaLBL_D3Q19_CopyToDevice(float *dist, const double *host, int Np);
+
+/**
+* \brief Copy D3Q19 distributions from the device to the host (double precision)
+* @param host - host buffer with 19*Np values
+* @param dist - D3Q19 distributions on the device
+* @param Np - size of local sub-domain (derived from Domain structure)
+*/
+void ScaLBL_D3Q19_CopyToHost(double *host, const double *dist, int Np);
+void ScaLBL_D3Q19_CopyToHost(double *host, const float *dist, int Np);
+
 /**
  * \class ScaLBL_Communicator
  *
@@ -749,6 +1163,13 @@ public:
 	
 	int next;
 	int first_interior,last_interior;
+	int interior_span;
+	//......................................................................................
+	// Order used to number the interior sites in MemoryOptimizedLayoutAA
+	//    - "lexicographic" (default), "tiled", "morton" or "hilbert"
+	//    - set from the Domain database keys LayoutOrdering and LayoutTileSize
+	std::string LayoutOrdering;
+	int LayoutTileSize;
 	//......................................................................................
 	//  Set up for D319 distributions
 	// 		- determines how much memory is allocated
@@ -766,10 +1187,33 @@ public:
 	int LastExterior();
 	int FirstInterior();
 	int LastInterior();
+	// maximum forward index offset from an interior site to an interior neighbor
+	int InteriorSpan();
 	int copySendList(const char *dir, int *buffer);
 	int copyRecvList(const char *dir, int *buffer);
 	
+	/**
+	* \brief Measure the performance of the D3Q19 MRT kernels for the current layout
+	*        - each MPI process gets its own measurement (no communication)
+	* @param NeighborList - neighbor list generated by MemoryOptimizedLayoutAA
+	* @param fq - D3Q19 distributions (overwritten)
+	* @param Np - number of lattice sites
+	* @returns MLUPS for this process
+	*/
 	double GetPerformance(int *NeighborList, double *fq, int Np);
+	// same measurement for distributions stored in single precision
+	double GetPerformance(int *NeighborList, float *fq, int Np);
+	/**
+	* \brief Generate the sparse layout used by the AA kernels
+	*        - exterior sites are numbered first, followed by the interior sites
+	*        - interior sites are numbered in the order given by LayoutOrdering
+	* @param Map - on return Map(i,j,k) is the index of site (i,j,k) in the sparse layout
+	* @param neighborList - D3Q19 neighbor list for the sparse layout
+	* @param id - labels for the regular layout (id <= 0 is ignored)
+	* @param Np - number of lattice sites
+	* @param width - halo width for the model
+	* @returns number of lattice sites (padded)
+	*/
 	int MemoryOptimizedLayoutAA(IntArray &Map, int *neighborList, signed char *id, int Np, int width);
     /**
     * \brief Create membrane data structure
@@ -783,18 +1227,88 @@ public:
 		ScaLBL_DeviceBarrier();
 		MPI_COMM_SCALBL.barrier();
 	};
+	/**
+	* \brief Synchronize between the stages of a time step
+	* \details The send / recv routines already complete the neighbor requests and
+	*   synchronize the device before the buffers are touched, and kernels are ordered
+	*   on the device stream, so no global barrier is needed within a time step.
+	*   This only calls Barrier() if BarrierFree has been set to false (debugging)
+	*/
+	void StepBarrier(){
+		if (!BarrierFree) Barrier();
+	};
+	bool BarrierFree;	// skip the global barriers in StepBarrier (default true)
+	/**
+	* \brief Attach a timer to the halo exchanges
+	* \details Packing / unpacking is charged to PhaseTimer::PACK and the MPI wait to PhaseTimer::WAIT
+	* @param timer - timer shared with the model (null to disable)
+	*/
+	void SetTimer(std::shared_ptr<PhaseTimer> timer){
+		Timer = timer;
+	};
 	void SendD3Q19AA(double *dist);
 	void RecvD3Q19AA(double *dist);
+	// halo exchange for D3Q19 distributions stored in single precision (half the message volume)
+	void SendD3Q19AA(float *dist);
+	void RecvD3Q19AA(float *dist);
 	void SendD3Q7AA(double *fq, int Component);
 	void RecvD3Q7AA(double *fq, int Component);
-	void BiSendD3Q7AA(double *Aq, double *Bq);
-	void BiRecvD3Q7AA(double *Aq, double *Bq);
+	// TYPE is the storage type of the distributions (double or float)
+	template <class TYPE> void BiSendD3Q7AA(TYPE *Aq, TYPE *Bq);
+	template <class TYPE> void BiRecvD3Q7AA(TYPE *Aq, TYPE *Bq);
 	void TriSendD3Q7AA(double *Aq, double *Bq, double *Cq);
 	void TriRecvD3Q7AA(double *Aq, double *Bq, double *Cq);
+	/**
+	* \brief Send the D3Q7 distributions for several components with one message per neighbor
+	* \details Generalizes BiSendD3Q7AA / TriSendD3Q7AA to any number of components.
+	*   Component c is stored at fq[c*7*N], as for SendD3Q7AA
+	* @param fq - D3Q7 distributions for all components
+	* @param Components - components to exchange
+	*/
+	void MultiSendD3Q7AA(double *fq, const std::vector<int> &Components);
+	void MultiRecvD3Q7AA(double *fq, const std::vector<int> &Components);
 	void SendHalo(double *data);
 	void RecvHalo(double *data);
+	/**
+	* \brief Register a field for the aggregated halo exchange (SendHaloAA / RecvHaloAA)
+	* \details All registered fields are packed into a single message for each of the
+	*   18 neighbors, which is exchanged with one persistent request per neighbor.
+	*   Each kind of field sends its own subset of directions
+	*   - HALO_D3Q19: distributions crossing each face (5) and edge (1), sparse layout
+	*   - HALO_D3Q7: distribution crossing each face, sparse layout
+	*   - HALO_SCALAR: value at each halo site for all neighbors, regular layout
+	*   The pointer must remain valid; fields cannot be added after the first SendHaloAA
+	* @param type - HALO_D3Q19, HALO_D3Q7 or HALO_SCALAR
+	* @param data - field to exchange (device memory)
+	*/
+	void RegisterHaloAA(int type, double *data);
+	void SendHaloAA();
+	void RecvHaloAA();
+	enum { HALO_D3Q19 = 0, HALO_D3Q7 = 1, HALO_SCALAR = 2 };
 	void RecvGrad(double *Phi, double *Gradient);
 	void RegularLayout(IntArray map, const double *data, DoubleArray &regdata);
+	/**
+	* \brief Copy a field with count entries from the device to the regular layout
+	* \details Sites with map<0 are set to zero
+	*/
+	void RegularLayout(IntArray map, const double *data, int count, DoubleArray &regdata);
+	/**
+	* \brief Set up a compact layout for a scalar field used in the D3Q19 gradient stencil
+	* \details The field is stored for the Np sites of the sparse layout (same index),
+	*   followed by the solid and halo sites that neighbor a fluid site (the ring) and one
+	*   dummy entry. The ring neighbors of site n are ringIndex[ringOffset[n]...ringOffset[n+1]-1]
+	*   in the order of the D3Q19 directions (see ScaLBL_D3Q19_AAeven_Color_Sparse).
+	*   The halo lists of this communicator (regular layout) are re-indexed for use with
+	*   SendHalo / RecvHalo; halo sites that are not stored are received into the dummy entry
+	* @param Map - sparse layout (see MemoryOptimizedLayoutAA)
+	* @param Np - number of sites in the sparse layout
+	* @param PhiMap - index in the compact layout for each site (<0 if not stored)
+	* @param ringOffset - first ring entry for each site (size Np+1)
+	* @param ringIndex - index in the compact layout for each ring entry
+	* @return number of entries in the compact layout
+	*/
+	int SparseLayout(const IntArray &Map, int Np, IntArray &PhiMap,
+			std::vector<int> &ringOffset, std::vector<int> &ringIndex);
 	void SetupBounceBackList(IntArray &Map, signed char *id, int Np, bool SlippingVelBC=false);
     void SolidDirichletD3Q7(double *fq, double *BoundaryValue);
     void SolidNeumannD3Q7(double *fq, double *BoundaryValue);
@@ -805,11 +1319,12 @@ public:
     // Routines to set boundary conditions
     void Color_BC_z(int *Map, double *Phi, double *Den, double vA, double vB);
     void Color_BC_Z(int *Map, double *Phi, double *Den, double vA, double vB);
-    void D3Q19_Pressure_BC_z(int *neighborList, double *fq, double din, int time);
-    void D3Q19_Pressure_BC_Z(int *neighborList, double *fq, double dout, int time);
-    void D3Q19_Reflection_BC_z(double *fq);
-    void D3Q19_Reflection_BC_Z(double *fq);
-    double D3Q19_Flux_BC_z(int *neighborList, double *fq, double flux, int time);
+    // the D3Q19 boundary conditions accept distributions stored as double or float
+    template <class TYPE> void D3Q19_Pressure_BC_z(int *neighborList, TYPE *fq, double din, int time);
+    template <class TYPE> void D3Q19_Pressure_BC_Z(int *neighborList, TYPE *fq, double dout, int time);
+    template <class TYPE> void D3Q19_Reflection_BC_z(TYPE *fq);
+    template <class TYPE> void D3Q19_Reflection_BC_Z(TYPE *fq);
+    template <class TYPE> double D3Q19_Flux_BC_z(int *neighborList, TYPE *fq, double flux, int time);
     void D3Q7_Poisson_Potential_BC_z(int *neighborList, double *fq, double Vin, int time);
     void D3Q7_Poisson_Potential_BC_Z(int *neighborList, double *fq, double Vout, int time);
     void D3Q19_Poisson_Potential_BC_z(int *neighborList, double *fq, double Vin, int time);
@@ -865,10 +1380,27 @@ private:
 
     // MPI requests for persistent communications
     std::vector<std::shared_ptr<MPI_Request>> req_D3Q19AA;
+    std::vector<std::shared_ptr<MPI_Request>> req_D3Q19AA_float;
     std::vector<std::shared_ptr<MPI_Request>> req_BiD3Q19AA;
     std::vector<std::shared_ptr<MPI_Request>> req_TriD3Q19AA;
+    std::vector<std::shared_ptr<MPI_Request>> req_HaloAA;
+    std::shared_ptr<PhaseTimer> Timer;
     void start( std::vector<std::shared_ptr<MPI_Request>>& requests );
     void wait( std::vector<std::shared_ptr<MPI_Request>>& requests );
+	//......................................................................................
+	//......................................................................................
+	// Aggregated halo exchange, indexed by neighbor (x,X,y,Y,z,Z,xy,XY,xY,Xy,xz,XZ,xZ,Xz,yz,YZ,yZ,Yz)
+	void SetupHaloAA();
+	std::vector<std::pair<int,double*>> HaloFields;
+	int *dvcSendListRegular[18];	// send lists in the regular layout (for HALO_SCALAR)
+	double *HaloSendBuf[18], *HaloRecvBuf[18];
+	int HaloSendSize[18], HaloRecvSize[18];
+	//......................................................................................
+	// Face buffers for MultiSendD3Q7AA, indexed by neighbor (x,X,y,Y,z,Z) and grown to fit
+	// the number of components (the D3Q19 buffers are bound to persistent requests)
+	void ReserveMultiBuffers(int Ncomponents);
+	double *MultiSendBuf[6], *MultiRecvBuf[6];
+	int MultiComponents;
 	//......................................................................................
 	int *bb_dist;
 	int *bb_interactions;
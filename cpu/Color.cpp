@@ -15,6 +15,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <math.h>
+#include "cpu/D3Q19_helpers.h"
 
 #define STOKES
 
@@ -1425,16 +1426,35 @@ extern "C" void ScaLBL_SetSlice_z(double *Phi, double value, int Nx, int Ny,
     }
 }
 
+// The D3Q7 distributions for the components range from zero to the lattice
+// weight and are stored as they are (see cpu/D3Q19_helpers.h for D3Q19).
 //extern "C" void ScaLBL_D3Q19_AAeven_Color(double *dist, double *Aq, double *Bq, double *Den, double *Velocity,
 //		double *ColorGrad, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
 //		double Fx, double Fy, double Fz, int start, int finish, int Np){
-extern "C" void ScaLBL_D3Q19_AAeven_Color(
-    int *Map, double *dist, double *Aq, double *Bq, double *Den, double *Phi,
+// Phase field value of the neighbor in direction q for the compact layout
+//   - neighbors in the fluid are read from the D3Q19 streaming list
+//   - other neighbors (solid or halo) are listed in order in ringIndex
+static inline double SparsePhi(const int *neighborList, const int *ringIndex,
+                               const double *Phi, int q, int n, int Np,
+                               int &r) {
+    int nn = neighborList[(q - 1) * Np + n] - q * Np;
+    if (nn >= 0 && nn < Np)
+        return Phi[nn];
+    return Phi[ringIndex[r++]];
+}
+
+// The color and phase field sweeps share their loop among the threads of the
+// enclosing parallel region (opened by the extern "C" wrappers), so that the
+// fused kernels can run all of their blocks within a single region
+template <class TYPE>
+static void D3Q19_AAeven_Color(
+    int *neighborList, int *ringOffset, int *ringIndex, int *Map,
+    TYPE *dist, TYPE *Aq, TYPE *Bq, double *Den, double *Phi,
     double *Vel, double rhoA, double rhoB, double tauA, double tauB,
     double alpha, double beta, double Fx, double Fy, double Fz, int strideY,
     int strideZ, int start, int finish, int Np) {
 
-    int ijk, nn;
+    int ijk, nn, r;
     double fq;
     // conserved momemnts
     double rho, jx, jy, jz;
@@ -1460,6 +1480,10 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp for schedule(static) private(ijk, nn, r, fq, rho, \
+        jx, jy, jz, m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, \
+        m17, m18, m3, m5, m7, nA, nB, a1, b1, a2, b2, nAB, delta, C, nx, ny, \
+        nz, ux, uy, uz, phi, tau, rho0, rlx_setA, rlx_setB)
     for (int n = start; n < finish; n++) {
 
         // read the component number densities
@@ -1476,65 +1500,88 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         rlx_setA = 1.f / tau;
         rlx_setB = 8.f * (2.f - rlx_setA) / (8.f - rlx_setA);
 
-        // Get the 1D index based on regular data layout
-        ijk = Map[n];
-        //					COMPUTE THE COLOR GRADIENT
-        //........................................................................
-        //.................Read Phase Indicator Values............................
-        //........................................................................
-        nn = ijk - 1; // neighbor index (get convention)
-        m1 = Phi[nn]; // get neighbor for phi - 1
-        //........................................................................
-        nn = ijk + 1; // neighbor index (get convention)
-        m2 = Phi[nn]; // get neighbor for phi - 2
-        //........................................................................
-        nn = ijk - strideY; // neighbor index (get convention)
-        m3 = Phi[nn];       // get neighbor for phi - 3
-        //........................................................................
-        nn = ijk + strideY; // neighbor index (get convention)
-        m4 = Phi[nn];       // get neighbor for phi - 4
-        //........................................................................
-        nn = ijk - strideZ; // neighbor index (get convention)
-        m5 = Phi[nn];       // get neighbor for phi - 5
-        //........................................................................
-        nn = ijk + strideZ; // neighbor index (get convention)
-        m6 = Phi[nn];       // get neighbor for phi - 6
-        //........................................................................
-        nn = ijk - strideY - 1; // neighbor index (get convention)
-        m7 = Phi[nn];           // get neighbor for phi - 7
-        //........................................................................
-        nn = ijk + strideY + 1; // neighbor index (get convention)
-        m8 = Phi[nn];           // get neighbor for phi - 8
-        //........................................................................
-        nn = ijk + strideY - 1; // neighbor index (get convention)
-        m9 = Phi[nn];           // get neighbor for phi - 9
-        //........................................................................
-        nn = ijk - strideY + 1; // neighbor index (get convention)
-        m10 = Phi[nn];          // get neighbor for phi - 10
-        //........................................................................
-        nn = ijk - strideZ - 1; // neighbor index (get convention)
-        m11 = Phi[nn];          // get neighbor for phi - 11
-        //........................................................................
-        nn = ijk + strideZ + 1; // neighbor index (get convention)
-        m12 = Phi[nn];          // get neighbor for phi - 12
-        //........................................................................
-        nn = ijk + strideZ - 1; // neighbor index (get convention)
-        m13 = Phi[nn];          // get neighbor for phi - 13
-        //........................................................................
-        nn = ijk - strideZ + 1; // neighbor index (get convention)
-        m14 = Phi[nn];          // get neighbor for phi - 14
-        //........................................................................
-        nn = ijk - strideZ - strideY; // neighbor index (get convention)
-        m15 = Phi[nn];                // get neighbor for phi - 15
-        //........................................................................
-        nn = ijk + strideZ + strideY; // neighbor index (get convention)
-        m16 = Phi[nn];                // get neighbor for phi - 16
-        //........................................................................
-        nn = ijk + strideZ - strideY; // neighbor index (get convention)
-        m17 = Phi[nn];                // get neighbor for phi - 17
-        //........................................................................
-        nn = ijk - strideZ + strideY; // neighbor index (get convention)
-        m18 = Phi[nn];                // get neighbor for phi - 18
+        if (ringOffset != nullptr) {
+            // Compact phase field (see ScaLBL_D3Q19_AAeven_Color_Sparse)
+            r = ringOffset[n];
+            m1 = SparsePhi(neighborList, ringIndex, Phi, 1, n, Np, r);
+            m2 = SparsePhi(neighborList, ringIndex, Phi, 2, n, Np, r);
+            m3 = SparsePhi(neighborList, ringIndex, Phi, 3, n, Np, r);
+            m4 = SparsePhi(neighborList, ringIndex, Phi, 4, n, Np, r);
+            m5 = SparsePhi(neighborList, ringIndex, Phi, 5, n, Np, r);
+            m6 = SparsePhi(neighborList, ringIndex, Phi, 6, n, Np, r);
+            m7 = SparsePhi(neighborList, ringIndex, Phi, 7, n, Np, r);
+            m8 = SparsePhi(neighborList, ringIndex, Phi, 8, n, Np, r);
+            m9 = SparsePhi(neighborList, ringIndex, Phi, 9, n, Np, r);
+            m10 = SparsePhi(neighborList, ringIndex, Phi, 10, n, Np, r);
+            m11 = SparsePhi(neighborList, ringIndex, Phi, 11, n, Np, r);
+            m12 = SparsePhi(neighborList, ringIndex, Phi, 12, n, Np, r);
+            m13 = SparsePhi(neighborList, ringIndex, Phi, 13, n, Np, r);
+            m14 = SparsePhi(neighborList, ringIndex, Phi, 14, n, Np, r);
+            m15 = SparsePhi(neighborList, ringIndex, Phi, 15, n, Np, r);
+            m16 = SparsePhi(neighborList, ringIndex, Phi, 16, n, Np, r);
+            m17 = SparsePhi(neighborList, ringIndex, Phi, 17, n, Np, r);
+            m18 = SparsePhi(neighborList, ringIndex, Phi, 18, n, Np, r);
+        } else {
+            // Get the 1D index based on regular data layout
+            ijk = Map[n];
+            //					COMPUTE THE COLOR GRADIENT
+            //........................................................................
+            //.................Read Phase Indicator Values............................
+            //........................................................................
+            nn = ijk - 1; // neighbor index (get convention)
+            m1 = Phi[nn]; // get neighbor for phi - 1
+            //........................................................................
+            nn = ijk + 1; // neighbor index (get convention)
+            m2 = Phi[nn]; // get neighbor for phi - 2
+            //........................................................................
+            nn = ijk - strideY; // neighbor index (get convention)
+            m3 = Phi[nn];       // get neighbor for phi - 3
+            //........................................................................
+            nn = ijk + strideY; // neighbor index (get convention)
+            m4 = Phi[nn];       // get neighbor for phi - 4
+            //........................................................................
+            nn = ijk - strideZ; // neighbor index (get convention)
+            m5 = Phi[nn];       // get neighbor for phi - 5
+            //........................................................................
+            nn = ijk + strideZ; // neighbor index (get convention)
+            m6 = Phi[nn];       // get neighbor for phi - 6
+            //........................................................................
+            nn = ijk - strideY - 1; // neighbor index (get convention)
+            m7 = Phi[nn];           // get neighbor for phi - 7
+            //........................................................................
+            nn = ijk + strideY + 1; // neighbor index (get convention)
+            m8 = Phi[nn];           // get neighbor for phi - 8
+            //........................................................................
+            nn = ijk + strideY - 1; // neighbor index (get convention)
+            m9 = Phi[nn];           // get neighbor for phi - 9
+            //........................................................................
+            nn = ijk - strideY + 1; // neighbor index (get convention)
+            m10 = Phi[nn];          // get neighbor for phi - 10
+            //........................................................................
+            nn = ijk - strideZ - 1; // neighbor index (get convention)
+            m11 = Phi[nn];          // get neighbor for phi - 11
+            //........................................................................
+            nn = ijk + strideZ + 1; // neighbor index (get convention)
+            m12 = Phi[nn];          // get neighbor for phi - 12
+            //........................................................................
+            nn = ijk + strideZ - 1; // neighbor index (get convention)
+            m13 = Phi[nn];          // get neighbor for phi - 13
+            //........................................................................
+            nn = ijk - strideZ + 1; // neighbor index (get convention)
+            m14 = Phi[nn];          // get neighbor for phi - 14
+            //........................................................................
+            nn = ijk - strideZ - strideY; // neighbor index (get convention)
+            m15 = Phi[nn];                // get neighbor for phi - 15
+            //........................................................................
+            nn = ijk + strideZ + strideY; // neighbor index (get convention)
+            m16 = Phi[nn];                // get neighbor for phi - 16
+            //........................................................................
+            nn = ijk + strideZ - strideY; // neighbor index (get convention)
+            m17 = Phi[nn];                // get neighbor for phi - 17
+            //........................................................................
+            nn = ijk - strideZ + strideY; // neighbor index (get convention)
+            m18 = Phi[nn];                // get neighbor for phi - 18
+        }
         //............Compute the Color Gradient...................................
         nx = -(m1 - m2 + 0.5 * (m7 - m8 + m9 - m10 + m11 - m12 + m13 - m14));
         ny = -(m3 - m4 + 0.5 * (m7 - m8 - m9 + m10 + m15 - m16 + m17 - m18));
@@ -1550,13 +1597,13 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         nz = nz / ColorMag;
 
         // q=0
-        fq = dist[n];
+        fq = LoadDist(dist, n, D3Q19_W0);
         rho = fq;
         m1 = -30.0 * fq;
         m2 = 12.0 * fq;
 
         // q=1
-        fq = dist[2 * Np + n];
+        fq = LoadDist(dist, 2 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1566,7 +1613,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m10 = -4.0 * fq;
 
         // f2 = dist[10*Np+n];
-        fq = dist[1 * Np + n];
+        fq = LoadDist(dist, 1 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * (fq);
         m2 -= 4.0 * (fq);
@@ -1576,7 +1623,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m10 -= 4.0 * (fq);
 
         // q=3
-        fq = dist[4 * Np + n];
+        fq = LoadDist(dist, 4 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1588,7 +1635,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m12 = -2.0 * fq;
 
         // q = 4
-        fq = dist[3 * Np + n];
+        fq = LoadDist(dist, 3 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1600,7 +1647,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m12 -= 2.0 * fq;
 
         // q=5
-        fq = dist[6 * Np + n];
+        fq = LoadDist(dist, 6 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1612,7 +1659,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m12 += 2.0 * fq;
 
         // q = 6
-        fq = dist[5 * Np + n];
+        fq = LoadDist(dist, 5 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1624,7 +1671,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m12 += 2.0 * fq;
 
         // q=7
-        fq = dist[8 * Np + n];
+        fq = LoadDist(dist, 8 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1641,7 +1688,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m17 = -fq;
 
         // q = 8
-        fq = dist[7 * Np + n];
+        fq = LoadDist(dist, 7 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1658,7 +1705,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m17 += fq;
 
         // q=9
-        fq = dist[10 * Np + n];
+        fq = LoadDist(dist, 10 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1675,7 +1722,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m17 += fq;
 
         // q = 10
-        fq = dist[9 * Np + n];
+        fq = LoadDist(dist, 9 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1692,7 +1739,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m17 -= fq;
 
         // q=11
-        fq = dist[12 * Np + n];
+        fq = LoadDist(dist, 12 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1709,7 +1756,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m18 = fq;
 
         // q=12
-        fq = dist[11 * Np + n];
+        fq = LoadDist(dist, 11 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1726,7 +1773,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m18 -= fq;
 
         // q=13
-        fq = dist[14 * Np + n];
+        fq = LoadDist(dist, 14 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1743,7 +1790,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m18 -= fq;
 
         // q=14
-        fq = dist[13 * Np + n];
+        fq = LoadDist(dist, 13 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1760,7 +1807,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m18 += fq;
 
         // q=15
-        fq = dist[16 * Np + n];
+        fq = LoadDist(dist, 16 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1775,7 +1822,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m18 -= fq;
 
         // q=16
-        fq = dist[15 * Np + n];
+        fq = LoadDist(dist, 15 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1790,7 +1837,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m18 += fq;
 
         // q=17
-        fq = dist[18 * Np + n];
+        fq = LoadDist(dist, 18 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1805,7 +1852,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
         m18 += fq;
 
         // q=18
-        fq = dist[17 * Np + n];
+        fq = LoadDist(dist, 17 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1856,86 +1903,86 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
 
         // q=0
         fq = mrt_V1 * rho - mrt_V2 * m1 + mrt_V3 * m2;
-        dist[n] = fq;
+        StoreDist(dist, n, fq, D3Q19_W0);
 
         // q = 1
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jx - m4) +
              mrt_V6 * (m9 - m10) + 0.16666666 * Fx;
-        dist[1 * Np + n] = fq;
+        StoreDist(dist, 1 * Np + n, fq, D3Q19_W1);
 
         // q=2
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m4 - jx) +
              mrt_V6 * (m9 - m10) - 0.16666666 * Fx;
-        dist[2 * Np + n] = fq;
+        StoreDist(dist, 2 * Np + n, fq, D3Q19_W1);
 
         // q = 3
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jy - m6) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m11 - m12) + 0.16666666 * Fy;
-        dist[3 * Np + n] = fq;
+        StoreDist(dist, 3 * Np + n, fq, D3Q19_W1);
 
         // q = 4
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m6 - jy) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m11 - m12) - 0.16666666 * Fy;
-        dist[4 * Np + n] = fq;
+        StoreDist(dist, 4 * Np + n, fq, D3Q19_W1);
 
         // q = 5
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jz - m8) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m12 - m11) + 0.16666666 * Fz;
-        dist[5 * Np + n] = fq;
+        StoreDist(dist, 5 * Np + n, fq, D3Q19_W1);
 
         // q = 6
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m8 - jz) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m12 - m11) - 0.16666666 * Fz;
-        dist[6 * Np + n] = fq;
+        StoreDist(dist, 6 * Np + n, fq, D3Q19_W1);
 
         // q = 7
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx + jy) +
              0.025 * (m4 + m6) + mrt_V7 * m9 + mrt_V11 * m10 + mrt_V8 * m11 +
              mrt_V12 * m12 + 0.25 * m13 + 0.125 * (m16 - m17) +
              0.08333333333 * (Fx + Fy);
-        dist[7 * Np + n] = fq;
+        StoreDist(dist, 7 * Np + n, fq, D3Q19_W2);
 
         // q = 8
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jx + jy) -
              0.025 * (m4 + m6) + mrt_V7 * m9 + mrt_V11 * m10 + mrt_V8 * m11 +
              mrt_V12 * m12 + 0.25 * m13 + 0.125 * (m17 - m16) -
              0.08333333333 * (Fx + Fy);
-        dist[8 * Np + n] = fq;
+        StoreDist(dist, 8 * Np + n, fq, D3Q19_W2);
 
         // q = 9
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx - jy) +
              0.025 * (m4 - m6) + mrt_V7 * m9 + mrt_V11 * m10 + mrt_V8 * m11 +
              mrt_V12 * m12 - 0.25 * m13 + 0.125 * (m16 + m17) +
              0.08333333333 * (Fx - Fy);
-        dist[9 * Np + n] = fq;
+        StoreDist(dist, 9 * Np + n, fq, D3Q19_W2);
 
         // q = 10
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy - jx) +
              0.025 * (m6 - m4) + mrt_V7 * m9 + mrt_V11 * m10 + mrt_V8 * m11 +
              mrt_V12 * m12 - 0.25 * m13 - 0.125 * (m16 + m17) -
              0.08333333333 * (Fx - Fy);
-        dist[10 * Np + n] = fq;
+        StoreDist(dist, 10 * Np + n, fq, D3Q19_W2);
 
         // q = 11
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx + jz) +
              0.025 * (m4 + m8) + mrt_V7 * m9 + mrt_V11 * m10 - mrt_V8 * m11 -
              mrt_V12 * m12 + 0.25 * m15 + 0.125 * (m18 - m16) +
              0.08333333333 * (Fx + Fz);
-        dist[11 * Np + n] = fq;
+        StoreDist(dist, 11 * Np + n, fq, D3Q19_W2);
 
         // q = 12
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jx + jz) -
              0.025 * (m4 + m8) + mrt_V7 * m9 + mrt_V11 * m10 - mrt_V8 * m11 -
              mrt_V12 * m12 + 0.25 * m15 + 0.125 * (m16 - m18) -
              0.08333333333 * (Fx + Fz);
-        dist[12 * Np + n] = fq;
+        StoreDist(dist, 12 * Np + n, fq, D3Q19_W2);
 
         // q = 13
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx - jz) +
              0.025 * (m4 - m8) + mrt_V7 * m9 + mrt_V11 * m10 - mrt_V8 * m11 -
              mrt_V12 * m12 - 0.25 * m15 - 0.125 * (m16 + m18) +
              0.08333333333 * (Fx - Fz);
-        dist[13 * Np + n] = fq;
+        StoreDist(dist, 13 * Np + n, fq, D3Q19_W2);
 
         // q= 14
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jz - jx) +
@@ -1943,31 +1990,31 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
              mrt_V12 * m12 - 0.25 * m15 + 0.125 * (m16 + m18) -
              0.08333333333 * (Fx - Fz);
 
-        dist[14 * Np + n] = fq;
+        StoreDist(dist, 14 * Np + n, fq, D3Q19_W2);
 
         // q = 15
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy + jz) +
              0.025 * (m6 + m8) - mrt_V6 * m9 - mrt_V7 * m10 + 0.25 * m14 +
              0.125 * (m17 - m18) + 0.08333333333 * (Fy + Fz);
-        dist[15 * Np + n] = fq;
+        StoreDist(dist, 15 * Np + n, fq, D3Q19_W2);
 
         // q = 16
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jy + jz) -
              0.025 * (m6 + m8) - mrt_V6 * m9 - mrt_V7 * m10 + 0.25 * m14 +
              0.125 * (m18 - m17) - 0.08333333333 * (Fy + Fz);
-        dist[16 * Np + n] = fq;
+        StoreDist(dist, 16 * Np + n, fq, D3Q19_W2);
 
         // q = 17
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy - jz) +
              0.025 * (m6 - m8) - mrt_V6 * m9 - mrt_V7 * m10 - 0.25 * m14 +
              0.125 * (m17 + m18) + 0.08333333333 * (Fy - Fz);
-        dist[17 * Np + n] = fq;
+        StoreDist(dist, 17 * Np + n, fq, D3Q19_W2);
 
         // q = 18
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jz - jy) +
              0.025 * (m8 - m6) - mrt_V6 * m9 - mrt_V7 * m10 - 0.25 * m14 -
              0.125 * (m17 + m18) - 0.08333333333 * (Fy - Fz);
-        dist[18 * Np + n] = fq;
+        StoreDist(dist, 18 * Np + n, fq, D3Q19_W2);
 
         //........................................................................
 
@@ -2036,16 +2083,62 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(
     }
 }
 
+extern "C" void ScaLBL_D3Q19_AAeven_Color(
+    int *Map, double *dist, double *Aq, double *Bq, double *Den, double *Phi,
+    double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+    double alpha, double beta, double Fx, double Fy, double Fz, int strideY,
+    int strideZ, int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q19_AAeven_Color(nullptr, nullptr, nullptr, Map, dist, Aq, Bq, Den, Phi,
+                       Vel, rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz,
+                       strideY, strideZ, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Sparse(
+    int *neighborList, int *ringOffset, int *ringIndex, double *dist,
+    double *Aq, double *Bq, double *Den, double *Phi, double *Vel, double rhoA,
+    double rhoB, double tauA, double tauB, double alpha, double beta,
+    double Fx, double Fy, double Fz, int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q19_AAeven_Color(neighborList, ringOffset, ringIndex, nullptr, dist, Aq,
+                       Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+                       Fx, Fy, Fz, 0, 0, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAeven_Color_float(
+    int *Map, float *dist, float *Aq, float *Bq, double *Den, double *Phi,
+    double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+    double alpha, double beta, double Fx, double Fy, double Fz, int strideY,
+    int strideZ, int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q19_AAeven_Color(nullptr, nullptr, nullptr, Map, dist, Aq, Bq, Den, Phi,
+                       Vel, rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz,
+                       strideY, strideZ, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Sparse_float(
+    int *neighborList, int *ringOffset, int *ringIndex, float *dist, float *Aq,
+    float *Bq, double *Den, double *Phi, double *Vel, double rhoA, double rhoB,
+    double tauA, double tauB, double alpha, double beta, double Fx, double Fy,
+    double Fz, int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q19_AAeven_Color(neighborList, ringOffset, ringIndex, nullptr, dist, Aq,
+                       Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+                       Fx, Fy, Fz, 0, 0, start, finish, Np);
+}
+
 //extern "C" void ScaLBL_D3Q19_AAodd_Color(int *neighborList, double *dist, double *Aq, double *Bq, double *Den, double *Velocity,
 //		double *ColorGrad, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
 //		double Fx, double Fy, double Fz, int start, int finish, int Np){
-extern "C" void ScaLBL_D3Q19_AAodd_Color(
-    int *neighborList, int *Map, double *dist, double *Aq, double *Bq,
-    double *Den, double *Phi, double *Vel, double rhoA, double rhoB,
-    double tauA, double tauB, double alpha, double beta, double Fx, double Fy,
-    double Fz, int strideY, int strideZ, int start, int finish, int Np) {
+template <class TYPE>
+static void D3Q19_AAodd_Color(
+    int *neighborList, int *ringOffset, int *ringIndex, int *Map,
+    TYPE *dist, TYPE *Aq, TYPE *Bq, double *Den, double *Phi,
+    double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+    double alpha, double beta, double Fx, double Fy, double Fz, int strideY,
+    int strideZ, int start, int finish, int Np) {
 
-    int nn, ijk, nread;
+    int nn, ijk, nread, r;
     int nr1, nr2, nr3, nr4, nr5, nr6;
     int nr7, nr8, nr9, nr10;
     int nr11, nr12, nr13, nr14;
@@ -2075,6 +2168,11 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp for schedule(static) private(nn, ijk, nread, r, nr1, \
+        nr2, nr3, nr4, nr5, nr6, nr7, nr8, nr9, nr10, nr11, nr12, nr13, nr14, \
+        fq, rho, jx, jy, jz, m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, \
+        m15, m16, m17, m18, m3, m5, m7, nA, nB, a1, b1, a2, b2, nAB, delta, C, \
+        nx, ny, nz, ux, uy, uz, phi, tau, rho0, rlx_setA, rlx_setB)
     for (int n = start; n < finish; n++) {
 
         // read the component number densities
@@ -2091,65 +2189,88 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         rlx_setA = 1.f / tau;
         rlx_setB = 8.f * (2.f - rlx_setA) / (8.f - rlx_setA);
 
-        // Get the 1D index based on regular data layout
-        ijk = Map[n];
-        //					COMPUTE THE COLOR GRADIENT
-        //........................................................................
-        //.................Read Phase Indicator Values............................
-        //........................................................................
-        nn = ijk - 1; // neighbor index (get convention)
-        m1 = Phi[nn]; // get neighbor for phi - 1
-        //........................................................................
-        nn = ijk + 1; // neighbor index (get convention)
-        m2 = Phi[nn]; // get neighbor for phi - 2
-        //........................................................................
-        nn = ijk - strideY; // neighbor index (get convention)
-        m3 = Phi[nn];       // get neighbor for phi - 3
-        //........................................................................
-        nn = ijk + strideY; // neighbor index (get convention)
-        m4 = Phi[nn];       // get neighbor for phi - 4
-        //........................................................................
-        nn = ijk - strideZ; // neighbor index (get convention)
-        m5 = Phi[nn];       // get neighbor for phi - 5
-        //........................................................................
-        nn = ijk + strideZ; // neighbor index (get convention)
-        m6 = Phi[nn];       // get neighbor for phi - 6
-        //........................................................................
-        nn = ijk - strideY - 1; // neighbor index (get convention)
-        m7 = Phi[nn];           // get neighbor for phi - 7
-        //........................................................................
-        nn = ijk + strideY + 1; // neighbor index (get convention)
-        m8 = Phi[nn];           // get neighbor for phi - 8
-        //........................................................................
-        nn = ijk + strideY - 1; // neighbor index (get convention)
-        m9 = Phi[nn];           // get neighbor for phi - 9
-        //........................................................................
-        nn = ijk - strideY + 1; // neighbor index (get convention)
-        m10 = Phi[nn];          // get neighbor for phi - 10
-        //........................................................................
-        nn = ijk - strideZ - 1; // neighbor index (get convention)
-        m11 = Phi[nn];          // get neighbor for phi - 11
-        //........................................................................
-        nn = ijk + strideZ + 1; // neighbor index (get convention)
-        m12 = Phi[nn];          // get neighbor for phi - 12
-        //........................................................................
-        nn = ijk + strideZ - 1; // neighbor index (get convention)
-        m13 = Phi[nn];          // get neighbor for phi - 13
-        //........................................................................
-        nn = ijk - strideZ + 1; // neighbor index (get convention)
-        m14 = Phi[nn];          // get neighbor for phi - 14
-        //........................................................................
-        nn = ijk - strideZ - strideY; // neighbor index (get convention)
-        m15 = Phi[nn];                // get neighbor for phi - 15
-        //........................................................................
-        nn = ijk + strideZ + strideY; // neighbor index (get convention)
-        m16 = Phi[nn];                // get neighbor for phi - 16
-        //........................................................................
-        nn = ijk + strideZ - strideY; // neighbor index (get convention)
-        m17 = Phi[nn];                // get neighbor for phi - 17
-        //........................................................................
-        nn = ijk - strideZ + strideY; // neighbor index (get convention)
-        m18 = Phi[nn];                // get neighbor for phi - 18
+        if (ringOffset != nullptr) {
+            // Compact phase field (see ScaLBL_D3Q19_AAeven_Color_Sparse)
+            r = ringOffset[n];
+            m1 = SparsePhi(neighborList, ringIndex, Phi, 1, n, Np, r);
+            m2 = SparsePhi(neighborList, ringIndex, Phi, 2, n, Np, r);
+            m3 = SparsePhi(neighborList, ringIndex, Phi, 3, n, Np, r);
+            m4 = SparsePhi(neighborList, ringIndex, Phi, 4, n, Np, r);
+            m5 = SparsePhi(neighborList, ringIndex, Phi, 5, n, Np, r);
+            m6 = SparsePhi(neighborList, ringIndex, Phi, 6, n, Np, r);
+            m7 = SparsePhi(neighborList, ringIndex, Phi, 7, n, Np, r);
+            m8 = SparsePhi(neighborList, ringIndex, Phi, 8, n, Np, r);
+            m9 = SparsePhi(neighborList, ringIndex, Phi, 9, n, Np, r);
+            m10 = SparsePhi(neighborList, ringIndex, Phi, 10, n, Np, r);
+            m11 = SparsePhi(neighborList, ringIndex, Phi, 11, n, Np, r);
+            m12 = SparsePhi(neighborList, ringIndex, Phi, 12, n, Np, r);
+            m13 = SparsePhi(neighborList, ringIndex, Phi, 13, n, Np, r);
+            m14 = SparsePhi(neighborList, ringIndex, Phi, 14, n, Np, r);
+            m15 = SparsePhi(neighborList, ringIndex, Phi, 15, n, Np, r);
+            m16 = SparsePhi(neighborList, ringIndex, Phi, 16, n, Np, r);
+            m17 = SparsePhi(neighborList, ringIndex, Phi, 17, n, Np, r);
+            m18 = SparsePhi(neighborList, ringIndex, Phi, 18, n, Np, r);
+        } else {
+            // Get the 1D index based on regular data layout
+            ijk = Map[n];
+            //					COMPUTE THE COLOR GRADIENT
+            //........................................................................
+            //.................Read Phase Indicator Values............................
+            //........................................................................
+            nn = ijk - 1; // neighbor index (get convention)
+            m1 = Phi[nn]; // get neighbor for phi - 1
+            //........................................................................
+            nn = ijk + 1; // neighbor index (get convention)
+            m2 = Phi[nn]; // get neighbor for phi - 2
+            //........................................................................
+            nn = ijk - strideY; // neighbor index (get convention)
+            m3 = Phi[nn];       // get neighbor for phi - 3
+            //........................................................................
+            nn = ijk + strideY; // neighbor index (get convention)
+            m4 = Phi[nn];       // get neighbor for phi - 4
+            //........................................................................
+            nn = ijk - strideZ; // neighbor index (get convention)
+            m5 = Phi[nn];       // get neighbor for phi - 5
+            //........................................................................
+            nn = ijk + strideZ; // neighbor index (get convention)
+            m6 = Phi[nn];       // get neighbor for phi - 6
+            //........................................................................
+            nn = ijk - strideY - 1; // neighbor index (get convention)
+            m7 = Phi[nn];           // get neighbor for phi - 7
+            //........................................................................
+            nn = ijk + strideY + 1; // neighbor index (get convention)
+            m8 = Phi[nn];           // get neighbor for phi - 8
+            //........................................................................
+            nn = ijk + strideY - 1; // neighbor index (get convention)
+            m9 = Phi[nn];           // get neighbor for phi - 9
+            //........................................................................
+            nn = ijk - strideY + 1; // neighbor index (get convention)
+            m10 = Phi[nn];          // get neighbor for phi - 10
+            //........................................................................
+            nn = ijk - strideZ - 1; // neighbor index (get convention)
+            m11 = Phi[nn];          // get neighbor for phi - 11
+            //........................................................................
+            nn = ijk + strideZ + 1; // neighbor index (get convention)
+            m12 = Phi[nn];          // get neighbor for phi - 12
+            //........................................................................
+            nn = ijk + strideZ - 1; // neighbor index (get convention)
+            m13 = Phi[nn];          // get neighbor for phi - 13
+            //........................................................................
+            nn = ijk - strideZ + 1; // neighbor index (get convention)
+            m14 = Phi[nn];          // get neighbor for phi - 14
+            //........................................................................
+            nn = ijk - strideZ - strideY; // neighbor index (get convention)
+            m15 = Phi[nn];                // get neighbor for phi - 15
+            //........................................................................
+            nn = ijk + strideZ + strideY; // neighbor index (get convention)
+            m16 = Phi[nn];                // get neighbor for phi - 16
+            //........................................................................
+            nn = ijk + strideZ - strideY; // neighbor index (get convention)
+            m17 = Phi[nn];                // get neighbor for phi - 17
+            //........................................................................
+            nn = ijk - strideZ + strideY; // neighbor index (get convention)
+            m18 = Phi[nn];                // get neighbor for phi - 18
+        }
         //............Compute the Color Gradient...................................
         nx = -(m1 - m2 + 0.5 * (m7 - m8 + m9 - m10 + m11 - m12 + m13 - m14));
         ny = -(m3 - m4 + 0.5 * (m7 - m8 - m9 + m10 + m15 - m16 + m17 - m18));
@@ -2165,7 +2286,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         nz = nz / ColorMag;
 
         // q=0
-        fq = dist[n];
+        fq = LoadDist(dist, n, D3Q19_W0);
         rho = fq;
         m1 = -30.0 * fq;
         m2 = 12.0 * fq;
@@ -2174,7 +2295,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n]; // neighbor 2
         //fq = dist[nread]; // reading the f1 data into register fq
         nr1 = neighborList[n];
-        fq = dist[nr1]; // reading the f1 data into register fq
+        fq = LoadDist(dist, nr1, D3Q19_W1); // reading the f1 data into register fq
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -2187,7 +2308,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+Np]; // neighbor 1 ( < 10Np => even part of dist)
         //fq = dist[nread];  // reading the f2 data into register fq
         nr2 = neighborList[n + Np]; // neighbor 1 ( < 10Np => even part of dist)
-        fq = dist[nr2];             // reading the f2 data into register fq
+        fq = LoadDist(dist, nr2, D3Q19_W1);             // reading the f2 data into register fq
         rho += fq;
         m1 -= 11.0 * (fq);
         m2 -= 4.0 * (fq);
@@ -2200,7 +2321,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+2*Np]; // neighbor 4
         //fq = dist[nread];
         nr3 = neighborList[n + 2 * Np]; // neighbor 4
-        fq = dist[nr3];
+        fq = LoadDist(dist, nr3, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -2215,7 +2336,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+3*Np]; // neighbor 3
         //fq = dist[nread];
         nr4 = neighborList[n + 3 * Np]; // neighbor 3
-        fq = dist[nr4];
+        fq = LoadDist(dist, nr4, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -2230,7 +2351,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+4*Np];
         //fq = dist[nread];
         nr5 = neighborList[n + 4 * Np];
-        fq = dist[nr5];
+        fq = LoadDist(dist, nr5, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -2245,7 +2366,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+5*Np];
         //fq = dist[nread];
         nr6 = neighborList[n + 5 * Np];
-        fq = dist[nr6];
+        fq = LoadDist(dist, nr6, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -2260,7 +2381,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+6*Np];
         //fq = dist[nread];
         nr7 = neighborList[n + 6 * Np];
-        fq = dist[nr7];
+        fq = LoadDist(dist, nr7, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2280,7 +2401,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+7*Np];
         //fq = dist[nread];
         nr8 = neighborList[n + 7 * Np];
-        fq = dist[nr8];
+        fq = LoadDist(dist, nr8, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2300,7 +2421,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+8*Np];
         //fq = dist[nread];
         nr9 = neighborList[n + 8 * Np];
-        fq = dist[nr9];
+        fq = LoadDist(dist, nr9, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2320,7 +2441,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+9*Np];
         //fq = dist[nread];
         nr10 = neighborList[n + 9 * Np];
-        fq = dist[nr10];
+        fq = LoadDist(dist, nr10, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2340,7 +2461,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+10*Np];
         //fq = dist[nread];
         nr11 = neighborList[n + 10 * Np];
-        fq = dist[nr11];
+        fq = LoadDist(dist, nr11, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2360,7 +2481,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+11*Np];
         //fq = dist[nread];
         nr12 = neighborList[n + 11 * Np];
-        fq = dist[nr12];
+        fq = LoadDist(dist, nr12, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2380,7 +2501,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+12*Np];
         //fq = dist[nread];
         nr13 = neighborList[n + 12 * Np];
-        fq = dist[nr13];
+        fq = LoadDist(dist, nr13, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2400,7 +2521,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         //nread = neighborList[n+13*Np];
         //fq = dist[nread];
         nr14 = neighborList[n + 13 * Np];
-        fq = dist[nr14];
+        fq = LoadDist(dist, nr14, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2418,7 +2539,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
 
         // q=15
         nread = neighborList[n + 14 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[17*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -2435,7 +2556,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
 
         // q=16
         nread = neighborList[n + 15 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[8*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -2453,7 +2574,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
         // q=17
         //fq = dist[18*Np+n];
         nread = neighborList[n + 16 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -2469,7 +2590,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
 
         // q=18
         nread = neighborList[n + 17 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[9*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -2519,43 +2640,43 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
 
         // q=0
         fq = mrt_V1 * rho - mrt_V2 * m1 + mrt_V3 * m2;
-        dist[n] = fq;
+        StoreDist(dist, n, fq, D3Q19_W0);
 
         // q = 1
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jx - m4) +
              mrt_V6 * (m9 - m10) + 0.16666666 * Fx;
         //nread = neighborList[n+Np];
-        dist[nr2] = fq;
+        StoreDist(dist, nr2, fq, D3Q19_W1);
 
         // q=2
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m4 - jx) +
              mrt_V6 * (m9 - m10) - 0.16666666 * Fx;
         //nread = neighborList[n];
-        dist[nr1] = fq;
+        StoreDist(dist, nr1, fq, D3Q19_W1);
 
         // q = 3
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jy - m6) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m11 - m12) + 0.16666666 * Fy;
         //nread = neighborList[n+3*Np];
-        dist[nr4] = fq;
+        StoreDist(dist, nr4, fq, D3Q19_W1);
 
         // q = 4
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m6 - jy) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m11 - m12) - 0.16666666 * Fy;
         //nread = neighborList[n+2*Np];
-        dist[nr3] = fq;
+        StoreDist(dist, nr3, fq, D3Q19_W1);
 
         // q = 5
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jz - m8) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m12 - m11) + 0.16666666 * Fz;
         //nread = neighborList[n+5*Np];
-        dist[nr6] = fq;
+        StoreDist(dist, nr6, fq, D3Q19_W1);
 
         // q = 6
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m8 - jz) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m12 - m11) - 0.16666666 * Fz;
         //nread = neighborList[n+4*Np];
-        dist[nr5] = fq;
+        StoreDist(dist, nr5, fq, D3Q19_W1);
 
         // q = 7
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx + jy) +
@@ -2563,7 +2684,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
              mrt_V12 * m12 + 0.25 * m13 + 0.125 * (m16 - m17) +
              0.08333333333 * (Fx + Fy);
         //nread = neighborList[n+7*Np];
-        dist[nr8] = fq;
+        StoreDist(dist, nr8, fq, D3Q19_W2);
 
         // q = 8
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jx + jy) -
@@ -2571,7 +2692,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
              mrt_V12 * m12 + 0.25 * m13 + 0.125 * (m17 - m16) -
              0.08333333333 * (Fx + Fy);
         //nread = neighborList[n+6*Np];
-        dist[nr7] = fq;
+        StoreDist(dist, nr7, fq, D3Q19_W2);
 
         // q = 9
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx - jy) +
@@ -2579,7 +2700,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
              mrt_V12 * m12 - 0.25 * m13 + 0.125 * (m16 + m17) +
              0.08333333333 * (Fx - Fy);
         //nread = neighborList[n+9*Np];
-        dist[nr10] = fq;
+        StoreDist(dist, nr10, fq, D3Q19_W2);
 
         // q = 10
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy - jx) +
@@ -2587,7 +2708,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
              mrt_V12 * m12 - 0.25 * m13 - 0.125 * (m16 + m17) -
              0.08333333333 * (Fx - Fy);
         //nread = neighborList[n+8*Np];
-        dist[nr9] = fq;
+        StoreDist(dist, nr9, fq, D3Q19_W2);
 
         // q = 11
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx + jz) +
@@ -2595,7 +2716,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
              mrt_V12 * m12 + 0.25 * m15 + 0.125 * (m18 - m16) +
              0.08333333333 * (Fx + Fz);
         //nread = neighborList[n+11*Np];
-        dist[nr12] = fq;
+        StoreDist(dist, nr12, fq, D3Q19_W2);
 
         // q = 12
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jx + jz) -
@@ -2603,7 +2724,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
              mrt_V12 * m12 + 0.25 * m15 + 0.125 * (m16 - m18) -
              0.08333333333 * (Fx + Fz);
         //nread = neighborList[n+10*Np];
-        dist[nr11] = fq;
+        StoreDist(dist, nr11, fq, D3Q19_W2);
 
         // q = 13
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx - jz) +
@@ -2611,7 +2732,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
              mrt_V12 * m12 - 0.25 * m15 - 0.125 * (m16 + m18) +
              0.08333333333 * (Fx - Fz);
         //nread = neighborList[n+13*Np];
-        dist[nr14] = fq;
+        StoreDist(dist, nr14, fq, D3Q19_W2);
 
         // q= 14
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jz - jx) +
@@ -2619,35 +2740,35 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
              mrt_V12 * m12 - 0.25 * m15 + 0.125 * (m16 + m18) -
              0.08333333333 * (Fx - Fz);
         //nread = neighborList[n+12*Np];
-        dist[nr13] = fq;
+        StoreDist(dist, nr13, fq, D3Q19_W2);
 
         // q = 15
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy + jz) +
              0.025 * (m6 + m8) - mrt_V6 * m9 - mrt_V7 * m10 + 0.25 * m14 +
              0.125 * (m17 - m18) + 0.08333333333 * (Fy + Fz);
         nread = neighborList[n + 15 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 16
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jy + jz) -
              0.025 * (m6 + m8) - mrt_V6 * m9 - mrt_V7 * m10 + 0.25 * m14 +
              0.125 * (m18 - m17) - 0.08333333333 * (Fy + Fz);
         nread = neighborList[n + 14 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 17
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy - jz) +
              0.025 * (m6 - m8) - mrt_V6 * m9 - mrt_V7 * m10 - 0.25 * m14 +
              0.125 * (m17 + m18) + 0.08333333333 * (Fy - Fz);
         nread = neighborList[n + 17 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 18
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jz - jy) +
              0.025 * (m8 - m6) - mrt_V6 * m9 - mrt_V7 * m10 - 0.25 * m14 -
              0.125 * (m17 + m18) - 0.08333333333 * (Fy - Fz);
         nread = neighborList[n + 16 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // write the velocity
         ux = jx / rho0;
@@ -2725,6 +2846,50 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(
     }
 }
 
+extern "C" void ScaLBL_D3Q19_AAodd_Color(
+    int *neighborList, int *Map, double *dist, double *Aq, double *Bq,
+    double *Den, double *Phi, double *Vel, double rhoA, double rhoB,
+    double tauA, double tauB, double alpha, double beta, double Fx, double Fy,
+    double Fz, int strideY, int strideZ, int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q19_AAodd_Color(neighborList, nullptr, nullptr, Map, dist, Aq, Bq, Den,
+                      Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy,
+                      Fz, strideY, strideZ, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Sparse(
+    int *neighborList, int *ringOffset, int *ringIndex, double *dist,
+    double *Aq, double *Bq, double *Den, double *Phi, double *Vel, double rhoA,
+    double rhoB, double tauA, double tauB, double alpha, double beta,
+    double Fx, double Fy, double Fz, int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q19_AAodd_Color(neighborList, ringOffset, ringIndex, nullptr, dist, Aq,
+                      Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+                      Fx, Fy, Fz, 0, 0, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_float(
+    int *neighborList, int *Map, float *dist, float *Aq, float *Bq, double *Den,
+    double *Phi, double *Vel, double rhoA, double rhoB, double tauA,
+    double tauB, double alpha, double beta, double Fx, double Fy, double Fz,
+    int strideY, int strideZ, int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q19_AAodd_Color(neighborList, nullptr, nullptr, Map, dist, Aq, Bq, Den,
+                      Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy,
+                      Fz, strideY, strideZ, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Sparse_float(
+    int *neighborList, int *ringOffset, int *ringIndex, float *dist, float *Aq,
+    float *Bq, double *Den, double *Phi, double *Vel, double rhoA, double rhoB,
+    double tauA, double tauB, double alpha, double beta, double Fx, double Fy,
+    double Fz, int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q19_AAodd_Color(neighborList, ringOffset, ringIndex, nullptr, dist, Aq,
+                      Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+                      Fx, Fy, Fz, 0, 0, start, finish, Np);
+}
+
 extern "C" void ScaLBL_D3Q7_AAodd_Color(int *neighborList, int *Map, double *Aq,
                                         double *Bq, double *Den, double *Phi,
                                         double *ColorGrad, double *Vel,
@@ -2738,6 +2903,8 @@ extern "C" void ScaLBL_D3Q7_AAodd_Color(int *neighborList, int *Map, double *Aq,
     double ux, uy, uz;
     // Instantiate mass transport distributions
     // Stationary value - distribution 0
+    #pragma omp parallel for schedule(static) private(nr1, nr2, nr3, nr4, nr5, \
+        nr6, nA, nB, a1, b1, a2, b2, nAB, delta, C, nx, ny, nz, ux, uy, uz)
     for (int n = start; n < finish; n++) {
         /* neighbors */
         nr1 = neighborList[n + 0 * Np];
@@ -2847,6 +3014,8 @@ extern "C" void ScaLBL_D3Q7_AAeven_Color(int *Map, double *Aq, double *Bq,
     double ux, uy, uz;
     // Instantiate mass transport distributions
     // Stationary value - distribution 0
+    #pragma omp parallel for schedule(static) private(nA, nB, a1, b1, a2, b2, \
+        nAB, delta, C, nx, ny, nz, ux, uy, uz)
     for (int n = start; n < finish; n++) {
         /* load velocity */
         ux = Vel[n];
@@ -2923,14 +3092,15 @@ extern "C" void ScaLBL_D3Q7_AAeven_Color(int *Map, double *Aq, double *Bq,
     }
 }
 
-extern "C" void ScaLBL_D3Q7_AAodd_PhaseField(int *neighborList, int *Map,
-                                             double *Aq, double *Bq,
-                                             double *Den, double *Phi,
-                                             int start, int finish, int Np) {
+template <class TYPE>
+static void D3Q7_AAodd_PhaseField(int *neighborList, int *Map, TYPE *Aq,
+                                  TYPE *Bq, double *Den, double *Phi, int start,
+                                  int finish, int Np) {
 
     int idx, nread;
     double fq, nA, nB;
 
+    #pragma omp for schedule(static) private(idx, nread, fq, nA, nB)
     for (int n = start; n < finish; n++) {
 
         //..........Compute the number density for component A............
@@ -3013,11 +3183,31 @@ extern "C" void ScaLBL_D3Q7_AAodd_PhaseField(int *neighborList, int *Map,
     }
 }
 
-extern "C" void ScaLBL_D3Q7_AAeven_PhaseField(int *Map, double *Aq, double *Bq,
-                                              double *Den, double *Phi,
-                                              int start, int finish, int Np) {
+extern "C" void ScaLBL_D3Q7_AAodd_PhaseField(int *neighborList, int *Map,
+                                             double *Aq, double *Bq,
+                                             double *Den, double *Phi,
+                                             int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q7_AAodd_PhaseField(neighborList, Map, Aq, Bq, Den, Phi, start, finish,
+                          Np);
+}
+
+extern "C" void ScaLBL_D3Q7_AAodd_PhaseField_float(int *neighborList, int *Map,
+                                                   float *Aq, float *Bq,
+                                                   double *Den, double *Phi,
+                                                   int start, int finish,
+                                                   int Np) {
+    #pragma omp parallel
+    D3Q7_AAodd_PhaseField(neighborList, Map, Aq, Bq, Den, Phi, start, finish,
+                          Np);
+}
+
+template <class TYPE>
+static void D3Q7_AAeven_PhaseField(int *Map, TYPE *Aq, TYPE *Bq, double *Den,
+                                   double *Phi, int start, int finish, int Np) {
     int idx;
     double fq, nA, nB;
+    #pragma omp for schedule(static) private(idx, fq, nA, nB)
     for (int n = start; n < finish; n++) {
 
         // compute number density for component A
@@ -3088,6 +3278,140 @@ extern "C" void ScaLBL_D3Q7_AAeven_PhaseField(int *Map, double *Aq, double *Bq,
     }
 }
 
+extern "C" void ScaLBL_D3Q7_AAeven_PhaseField(int *Map, double *Aq, double *Bq,
+                                              double *Den, double *Phi,
+                                              int start, int finish, int Np) {
+    #pragma omp parallel
+    D3Q7_AAeven_PhaseField(Map, Aq, Bq, Den, Phi, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q7_AAeven_PhaseField_float(int *Map, float *Aq,
+                                                    float *Bq, double *Den,
+                                                    double *Phi, int start,
+                                                    int finish, int Np) {
+    #pragma omp parallel
+    D3Q7_AAeven_PhaseField(Map, Aq, Bq, Den, Phi, start, finish, Np);
+}
+
+template <class TYPE>
+static void D3Q19_AAeven_Color_Fused(
+    int *Map, TYPE *dist, TYPE *Aq, TYPE *Bq, double *Den, double *Phi,
+    double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+    double alpha, double beta, double Fx, double Fy, double Fz, int strideY,
+    int strideZ, int span, int start, int finish, int Np) {
+    // Each site reads and writes its own set of Aq, Bq and Den values, so the
+    // collision for a block can run as soon as the phase field is known for
+    // every neighbor of the block, i.e. up to span sites past the block.
+    // When the neighbors are not local in the list (e.g. space filling curve
+    // orderings) the sweeps are not fused
+    const int block = 1024;
+    if (span > block) {
+        #pragma omp parallel
+        {
+            D3Q7_AAeven_PhaseField(Map, Aq, Bq, Den, Phi, start, finish, Np);
+            D3Q19_AAeven_Color(nullptr, nullptr, nullptr, Map, dist, Aq, Bq,
+                               Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha,
+                               beta, Fx, Fy, Fz, strideY, strideZ, start,
+                               finish, Np);
+        }
+        return;
+    }
+    #pragma omp parallel
+    {
+        int ahead = start;
+        for (int n = start; n < finish; n += block) {
+            int end = n + block < finish ? n + block : finish;
+            int lead = end + span < finish ? end + span : finish;
+            if (lead > ahead) {
+                D3Q7_AAeven_PhaseField(Map, Aq, Bq, Den, Phi, ahead, lead, Np);
+                ahead = lead;
+            }
+            D3Q19_AAeven_Color(nullptr, nullptr, nullptr, Map, dist, Aq, Bq,
+                               Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha,
+                               beta, Fx, Fy, Fz, strideY, strideZ, n, end, Np);
+        }
+    }
+}
+
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Fused(
+    int *Map, double *dist, double *Aq, double *Bq, double *Den, double *Phi,
+    double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+    double alpha, double beta, double Fx, double Fy, double Fz, int strideY,
+    int strideZ, int span, int start, int finish, int Np) {
+    D3Q19_AAeven_Color_Fused(Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA,
+                             tauB, alpha, beta, Fx, Fy, Fz, strideY, strideZ,
+                             span, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Fused_float(
+    int *Map, float *dist, float *Aq, float *Bq, double *Den, double *Phi,
+    double *Vel, double rhoA, double rhoB, double tauA, double tauB,
+    double alpha, double beta, double Fx, double Fy, double Fz, int strideY,
+    int strideZ, int span, int start, int finish, int Np) {
+    D3Q19_AAeven_Color_Fused(Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA,
+                             tauB, alpha, beta, Fx, Fy, Fz, strideY, strideZ,
+                             span, start, finish, Np);
+}
+
+template <class TYPE>
+static void D3Q19_AAodd_Color_Fused(
+    int *neighborList, int *Map, TYPE *dist, TYPE *Aq, TYPE *Bq, double *Den,
+    double *Phi, double *Vel, double rhoA, double rhoB, double tauA,
+    double tauB, double alpha, double beta, double Fx, double Fy, double Fz,
+    int strideY, int strideZ, int span, int start, int finish, int Np) {
+    // see D3Q19_AAeven_Color_Fused
+    const int block = 1024;
+    if (span > block) {
+        #pragma omp parallel
+        {
+            D3Q7_AAodd_PhaseField(neighborList, Map, Aq, Bq, Den, Phi, start,
+                                  finish, Np);
+            D3Q19_AAodd_Color(neighborList, nullptr, nullptr, Map, dist, Aq,
+                              Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha,
+                              beta, Fx, Fy, Fz, strideY, strideZ, start, finish,
+                              Np);
+        }
+        return;
+    }
+    #pragma omp parallel
+    {
+        int ahead = start;
+        for (int n = start; n < finish; n += block) {
+            int end = n + block < finish ? n + block : finish;
+            int lead = end + span < finish ? end + span : finish;
+            if (lead > ahead) {
+                D3Q7_AAodd_PhaseField(neighborList, Map, Aq, Bq, Den, Phi,
+                                      ahead, lead, Np);
+                ahead = lead;
+            }
+            D3Q19_AAodd_Color(neighborList, nullptr, nullptr, Map, dist, Aq,
+                              Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha,
+                              beta, Fx, Fy, Fz, strideY, strideZ, n, end, Np);
+        }
+    }
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Fused(
+    int *neighborList, int *Map, double *dist, double *Aq, double *Bq,
+    double *Den, double *Phi, double *Vel, double rhoA, double rhoB,
+    double tauA, double tauB, double alpha, double beta, double Fx, double Fy,
+    double Fz, int strideY, int strideZ, int span, int start, int finish,
+    int Np) {
+    D3Q19_AAodd_Color_Fused(neighborList, Map, dist, Aq, Bq, Den, Phi, Vel,
+                            rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz,
+                            strideY, strideZ, span, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Fused_float(
+    int *neighborList, int *Map, float *dist, float *Aq, float *Bq, double *Den,
+    double *Phi, double *Vel, double rhoA, double rhoB, double tauA,
+    double tauB, double alpha, double beta, double Fx, double Fy, double Fz,
+    int strideY, int strideZ, int span, int start, int finish, int Np) {
+    D3Q19_AAodd_Color_Fused(neighborList, Map, dist, Aq, Bq, Den, Phi, Vel,
+                            rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz,
+                            strideY, strideZ, span, start, finish, Np);
+}
+
 extern "C" void ScaLBL_D3Q19_Gradient(int *Map, double *phi, double *ColorGrad,
                                       int start, int finish, int Np, int Nx,
                                       int Ny, int Nz) {
@@ -3240,14 +3564,70 @@ extern "C" void ScaLBL_D3Q19_Gradient(int *Map, double *phi, double *ColorGrad,
     }
 }
 
+template <class TYPE>
+static void PhaseField_Init(int *Map, double *Phi, double *Den, TYPE *Aq,
+                            TYPE *Bq, int start, int finish, int Np) {
+    int idx, n;
+    double phi, nA, nB;
+
+    #pragma omp parallel for schedule(static) private(n, phi, nA, nB)
+    for (idx = start; idx < finish; idx++) {
+
+        n = Map[idx];
+        phi = Phi[n];
+        if (phi > 1.f) {
+            nA = 1.0;
+            nB = 0.f;
+        } else if (phi < -1.f) {
+            nB = 1.0;
+            nA = 0.f;
+        } else {
+            nA = 0.5 * (phi + 1.f);
+            nB = 0.5 * (1.f - phi);
+        }
+        Den[idx] = nA;
+        Den[Np + idx] = nB;
+
+        Aq[idx] = 0.3333333333333333 * nA;
+        Aq[Np + idx] = 0.1111111111111111 * nA;
+        Aq[2 * Np + idx] = 0.1111111111111111 * nA;
+        Aq[3 * Np + idx] = 0.1111111111111111 * nA;
+        Aq[4 * Np + idx] = 0.1111111111111111 * nA;
+        Aq[5 * Np + idx] = 0.1111111111111111 * nA;
+        Aq[6 * Np + idx] = 0.1111111111111111 * nA;
+
+        Bq[idx] = 0.3333333333333333 * nB;
+        Bq[Np + idx] = 0.1111111111111111 * nB;
+        Bq[2 * Np + idx] = 0.1111111111111111 * nB;
+        Bq[3 * Np + idx] = 0.1111111111111111 * nB;
+        Bq[4 * Np + idx] = 0.1111111111111111 * nB;
+        Bq[5 * Np + idx] = 0.1111111111111111 * nB;
+        Bq[6 * Np + idx] = 0.1111111111111111 * nB;
+    }
+}
+
 extern "C" void ScaLBL_PhaseField_Init(int *Map, double *Phi, double *Den,
                                        double *Aq, double *Bq, int start,
                                        int finish, int Np) {
-    int idx, n;
+    PhaseField_Init(Map, Phi, Den, Aq, Bq, start, finish, Np);
+}
+
+extern "C" void ScaLBL_PhaseField_Init_float(int *Map, double *Phi, double *Den,
+                                             float *Aq, float *Bq, int start,
+                                             int finish, int Np) {
+    PhaseField_Init(Map, Phi, Den, Aq, Bq, start, finish, Np);
+}
+
+extern "C" void ScaLBL_PhaseField_InitList(int *list, int *Map, double *Phi,
+                                           double *Den, double *Aq, double *Bq,
+                                           int count, int Np) {
+    int i, idx, n;
     double phi, nA, nB;
 
-    for (idx = start; idx < finish; idx++) {
+    #pragma omp parallel for schedule(static) private(idx, n, phi, nA, nB)
+    for (i = 0; i < count; i++) {
 
+        idx = list[i];
         n = Map[idx];
         phi = Phi[n];
         if (phi > 1.f) {
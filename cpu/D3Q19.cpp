@@ -15,6 +15,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <stdio.h>
+#include "cpu/D3Q19_helpers.h"
 
 extern "C" void ScaLBL_D3Q19_Pack(int q, int *list, int start, int count,
                                   double *sendbuf, double *dist, int N) {
@@ -48,6 +49,32 @@ extern "C" void ScaLBL_D3Q19_Unpack(int q, int *list, int start, int count,
     }
 }
 
+extern "C" void ScaLBL_D3Q19_Pack_float(int q, int *list, int start, int count,
+                                        float *sendbuf, float *dist, int N) {
+    //....................................................................................
+    // Pack distribution q stored as (shifted) float -- the halo carries the
+    // stored values so the message volume is half that of ScaLBL_D3Q19_Pack
+    //....................................................................................
+    int idx, n;
+    for (idx = 0; idx < count; idx++) {
+        n = list[idx];
+        sendbuf[start + idx] = dist[q * N + n];
+    }
+}
+
+extern "C" void ScaLBL_D3Q19_Unpack_float(int q, int *list, int start,
+                                          int count, float *recvbuf,
+                                          float *dist, int N) {
+    //....................................................................................
+    // Unpack distribution q stored as (shifted) float (see ScaLBL_D3Q19_Unpack)
+    //....................................................................................
+    int n, idx;
+    for (idx = 0; idx < count; idx++) {
+        n = list[start + idx];
+        if (!(n < 0))
+            dist[q * N + n] = recvbuf[start + idx];
+    }
+}
 
 extern "C" void ScaLBL_D3Q19_AA_Init(double *f_even, double *f_odd, int Np) {
     int n;
@@ -314,9 +341,10 @@ extern "C" double ScaLBL_D3Q19_Flux_BC_z(double *disteven, double *distodd,
     return din;
 }
 
-extern "C" double ScaLBL_D3Q19_AAodd_Flux_BC_z(int *d_neighborList, int *list,
-                                               double *dist, double flux,
-                                               double area, int count, int Np) {
+template <class TYPE>
+static double D3Q19_AAodd_Flux_BC_z(int *d_neighborList, int *list, TYPE *dist,
+                                    double flux, double area, int count,
+                                    int Np) {
     int idx, n;
     int nread;
 
@@ -327,46 +355,46 @@ extern "C" double ScaLBL_D3Q19_AAodd_Flux_BC_z(int *d_neighborList, int *list,
     for (idx = 0; idx < count; idx++) {
         n = list[idx];
 
-        double f0 = dist[n];
+        double f0 = LoadDist(dist, n, D3Q19_W0);
 
         nread = d_neighborList[n];
-        double f1 = dist[nread];
+        double f1 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 2 * Np];
-        double f3 = dist[nread];
+        double f3 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 6 * Np];
-        double f7 = dist[nread];
+        double f7 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 8 * Np];
-        double f9 = dist[nread];
+        double f9 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 12 * Np];
-        double f13 = dist[nread];
+        double f13 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 16 * Np];
-        double f17 = dist[nread];
+        double f17 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + Np];
-        double f2 = dist[nread];
+        double f2 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 3 * Np];
-        double f4 = dist[nread];
+        double f4 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 5 * Np];
-        double f6 = dist[nread];
+        double f6 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 7 * Np];
-        double f8 = dist[nread];
+        double f8 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 9 * Np];
-        double f10 = dist[nread];
+        double f10 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 11 * Np];
-        double f12 = dist[nread];
+        double f12 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 15 * Np];
-        double f16 = dist[nread];
+        double f16 = LoadDist(dist, nread, D3Q19_W2);
 
         sum += factor * (f0 + f1 + f2 + f3 + f4 + f7 + f8 + f9 + f10 +
                          2 * (f6 + f12 + f13 + f16 + f17));
@@ -375,9 +403,24 @@ extern "C" double ScaLBL_D3Q19_AAodd_Flux_BC_z(int *d_neighborList, int *list,
     return sum;
 }
 
-extern "C" double ScaLBL_D3Q19_AAeven_Flux_BC_z(int *list, double *dist,
-                                                double flux, double area,
-                                                int count, int Np) {
+extern "C" double ScaLBL_D3Q19_AAodd_Flux_BC_z(int *d_neighborList, int *list,
+                                               double *dist, double flux,
+                                               double area, int count, int Np) {
+    return D3Q19_AAodd_Flux_BC_z(d_neighborList, list, dist, flux, area, count,
+                                 Np);
+}
+
+extern "C" double ScaLBL_D3Q19_AAodd_Flux_BC_z_float(int *d_neighborList,
+                                                     int *list, float *dist,
+                                                     double flux, double area,
+                                                     int count, int Np) {
+    return D3Q19_AAodd_Flux_BC_z(d_neighborList, list, dist, flux, area, count,
+                                 Np);
+}
+
+template <class TYPE>
+static double D3Q19_AAeven_Flux_BC_z(int *list, TYPE *dist, double flux,
+                                     double area, int count, int Np) {
     int idx, n;
     // distributions
     double factor = 1.f / (area);
@@ -385,26 +428,38 @@ extern "C" double ScaLBL_D3Q19_AAeven_Flux_BC_z(int *list, double *dist,
 
     for (idx = 0; idx < count; idx++) {
         n = list[idx];
-        double f0 = dist[n];
-        double f1 = dist[2 * Np + n];
-        double f2 = dist[1 * Np + n];
-        double f3 = dist[4 * Np + n];
-        double f4 = dist[3 * Np + n];
-        double f6 = dist[5 * Np + n];
-        double f7 = dist[8 * Np + n];
-        double f8 = dist[7 * Np + n];
-        double f9 = dist[10 * Np + n];
-        double f10 = dist[9 * Np + n];
-        double f12 = dist[11 * Np + n];
-        double f13 = dist[14 * Np + n];
-        double f16 = dist[15 * Np + n];
-        double f17 = dist[18 * Np + n];
+        double f0 = LoadDist(dist, n, D3Q19_W0);
+        double f1 = LoadDist(dist, 2 * Np + n, D3Q19_W1);
+        double f2 = LoadDist(dist, 1 * Np + n, D3Q19_W1);
+        double f3 = LoadDist(dist, 4 * Np + n, D3Q19_W1);
+        double f4 = LoadDist(dist, 3 * Np + n, D3Q19_W1);
+        double f6 = LoadDist(dist, 5 * Np + n, D3Q19_W1);
+        double f7 = LoadDist(dist, 8 * Np + n, D3Q19_W2);
+        double f8 = LoadDist(dist, 7 * Np + n, D3Q19_W2);
+        double f9 = LoadDist(dist, 10 * Np + n, D3Q19_W2);
+        double f10 = LoadDist(dist, 9 * Np + n, D3Q19_W2);
+        double f12 = LoadDist(dist, 11 * Np + n, D3Q19_W2);
+        double f13 = LoadDist(dist, 14 * Np + n, D3Q19_W2);
+        double f16 = LoadDist(dist, 15 * Np + n, D3Q19_W2);
+        double f17 = LoadDist(dist, 18 * Np + n, D3Q19_W2);
         sum += factor * (f0 + f1 + f2 + f3 + f4 + f7 + f8 + f9 + f10 +
                          2 * (f6 + f12 + f13 + f16 + f17));
     }
     return sum;
 }
 
+extern "C" double ScaLBL_D3Q19_AAeven_Flux_BC_z(int *list, double *dist,
+                                                double flux, double area,
+                                                int count, int Np) {
+    return D3Q19_AAeven_Flux_BC_z(list, dist, flux, area, count, Np);
+}
+
+extern "C" double ScaLBL_D3Q19_AAeven_Flux_BC_z_float(int *list, float *dist,
+                                                      double flux, double area,
+                                                      int count, int Np) {
+    return D3Q19_AAeven_Flux_BC_z(list, dist, flux, area, count, Np);
+}
+
 extern "C" double ScaLBL_D3Q19_Flux_BC_Z(double *disteven, double *distodd,
                                          double flux, int Nx, int Ny, int Nz,
                                          int outlet) {
@@ -452,66 +507,96 @@ extern "C" double ScaLBL_D3Q19_Flux_BC_Z(double *disteven, double *distodd,
     return dout;
 }
 
-extern "C" void ScaLBL_D3Q19_Reflection_BC_z(int *list, double *dist, int count,
-                                             int Np) {
+template <class TYPE>
+static void D3Q19_Reflection_BC_z(int *list, TYPE *dist, int count, int Np) {
     for (int idx = 0; idx < count; idx++) {
         int n = list[idx];
 
-        double f5 = 0.111111111111111111111111 - dist[6 * Np + n];
-        double f11 = 0.05555555555555555555556 - dist[12 * Np + n];
-        double f14 = 0.05555555555555555555556 - dist[13 * Np + n];
-        double f15 = 0.05555555555555555555556 - dist[16 * Np + n];
-        double f18 = 0.05555555555555555555556 - dist[17 * Np + n];
-
-        dist[6 * Np + n] = f5;
-        dist[12 * Np + n] = f11;
-        dist[13 * Np + n] = f14;
-        dist[16 * Np + n] = f15;
-        dist[17 * Np + n] = f18;
+        double f5 =
+            0.111111111111111111111111 - LoadDist(dist, 6 * Np + n, D3Q19_W1);
+        double f11 =
+            0.05555555555555555555556 - LoadDist(dist, 12 * Np + n, D3Q19_W2);
+        double f14 =
+            0.05555555555555555555556 - LoadDist(dist, 13 * Np + n, D3Q19_W2);
+        double f15 =
+            0.05555555555555555555556 - LoadDist(dist, 16 * Np + n, D3Q19_W2);
+        double f18 =
+            0.05555555555555555555556 - LoadDist(dist, 17 * Np + n, D3Q19_W2);
+
+        StoreDist(dist, 6 * Np + n, f5, D3Q19_W1);
+        StoreDist(dist, 12 * Np + n, f11, D3Q19_W2);
+        StoreDist(dist, 13 * Np + n, f14, D3Q19_W2);
+        StoreDist(dist, 16 * Np + n, f15, D3Q19_W2);
+        StoreDist(dist, 17 * Np + n, f18, D3Q19_W2);
     }
 }
 
-extern "C" void ScaLBL_D3Q19_Reflection_BC_Z(int *list, double *dist, int count,
+extern "C" void ScaLBL_D3Q19_Reflection_BC_z(int *list, double *dist, int count,
                                              int Np) {
+    D3Q19_Reflection_BC_z(list, dist, count, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_Reflection_BC_z_float(int *list, float *dist,
+                                                   int count, int Np) {
+    D3Q19_Reflection_BC_z(list, dist, count, Np);
+}
+
+template <class TYPE>
+static void D3Q19_Reflection_BC_Z(int *list, TYPE *dist, int count, int Np) {
     for (int idx = 0; idx < count; idx++) {
         int n = list[idx];
 
-        double f6 = 0.111111111111111111111111 - dist[5 * Np + n];
-        double f12 = 0.05555555555555555555556 - dist[11 * Np + n];
-        double f13 = 0.05555555555555555555556 - dist[14 * Np + n];
-        double f16 = 0.05555555555555555555556 - dist[15 * Np + n];
-        double f17 = 0.05555555555555555555556 - dist[18 * Np + n];
-
-        dist[5 * Np + n] = f6;
-        dist[11 * Np + n] = f12;
-        dist[14 * Np + n] = f13;
-        dist[15 * Np + n] = f16;
-        dist[18 * Np + n] = f17;
+        double f6 =
+            0.111111111111111111111111 - LoadDist(dist, 5 * Np + n, D3Q19_W1);
+        double f12 =
+            0.05555555555555555555556 - LoadDist(dist, 11 * Np + n, D3Q19_W2);
+        double f13 =
+            0.05555555555555555555556 - LoadDist(dist, 14 * Np + n, D3Q19_W2);
+        double f16 =
+            0.05555555555555555555556 - LoadDist(dist, 15 * Np + n, D3Q19_W2);
+        double f17 =
+            0.05555555555555555555556 - LoadDist(dist, 18 * Np + n, D3Q19_W2);
+
+        StoreDist(dist, 5 * Np + n, f6, D3Q19_W1);
+        StoreDist(dist, 11 * Np + n, f12, D3Q19_W2);
+        StoreDist(dist, 14 * Np + n, f13, D3Q19_W2);
+        StoreDist(dist, 15 * Np + n, f16, D3Q19_W2);
+        StoreDist(dist, 18 * Np + n, f17, D3Q19_W2);
     }
 }
 
-extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_z(int *list, double *dist,
-                                                  double din, int count,
-                                                  int Np) {
+extern "C" void ScaLBL_D3Q19_Reflection_BC_Z(int *list, double *dist, int count,
+                                             int Np) {
+    D3Q19_Reflection_BC_Z(list, dist, count, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_Reflection_BC_Z_float(int *list, float *dist,
+                                                   int count, int Np) {
+    D3Q19_Reflection_BC_Z(list, dist, count, Np);
+}
+
+template <class TYPE>
+static void D3Q19_AAeven_Pressure_BC_z(int *list, TYPE *dist, double din,
+                                       int count, int Np) {
     // distributions
     double ux, uy, uz, Cyz, Cxz;
     ux = uy = 0.0;
     for (int idx = 0; idx < count; idx++) {
         int n = list[idx];
-        double f0 = dist[n];
-        double f1 = dist[2 * Np + n];
-        double f2 = dist[1 * Np + n];
-        double f3 = dist[4 * Np + n];
-        double f4 = dist[3 * Np + n];
-        double f6 = dist[5 * Np + n];
-        double f7 = dist[8 * Np + n];
-        double f8 = dist[7 * Np + n];
-        double f9 = dist[10 * Np + n];
-        double f10 = dist[9 * Np + n];
-        double f12 = dist[11 * Np + n];
-        double f13 = dist[14 * Np + n];
-        double f16 = dist[15 * Np + n];
-        double f17 = dist[18 * Np + n];
+        double f0 = LoadDist(dist, n, D3Q19_W0);
+        double f1 = LoadDist(dist, 2 * Np + n, D3Q19_W1);
+        double f2 = LoadDist(dist, 1 * Np + n, D3Q19_W1);
+        double f3 = LoadDist(dist, 4 * Np + n, D3Q19_W1);
+        double f4 = LoadDist(dist, 3 * Np + n, D3Q19_W1);
+        double f6 = LoadDist(dist, 5 * Np + n, D3Q19_W1);
+        double f7 = LoadDist(dist, 8 * Np + n, D3Q19_W2);
+        double f8 = LoadDist(dist, 7 * Np + n, D3Q19_W2);
+        double f9 = LoadDist(dist, 10 * Np + n, D3Q19_W2);
+        double f10 = LoadDist(dist, 9 * Np + n, D3Q19_W2);
+        double f12 = LoadDist(dist, 11 * Np + n, D3Q19_W2);
+        double f13 = LoadDist(dist, 14 * Np + n, D3Q19_W2);
+        double f16 = LoadDist(dist, 15 * Np + n, D3Q19_W2);
+        double f17 = LoadDist(dist, 18 * Np + n, D3Q19_W2);
         //...................................................
         // Determine the inlet flow velocity
         //ux = (f1-f2+f7-f8+f9-f10+f11-f12+f13-f14);
@@ -528,17 +613,29 @@ extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_z(int *list, double *dist,
         double f15 = f16 + 0.16666666666666678 * (uy + uz) - Cyz;
         double f18 = f17 + 0.16666666666666678 * (uz - uy) + Cyz;
 
-        dist[6 * Np + n] = f5;
-        dist[12 * Np + n] = f11;
-        dist[13 * Np + n] = f14;
-        dist[16 * Np + n] = f15;
-        dist[17 * Np + n] = f18;
+        StoreDist(dist, 6 * Np + n, f5, D3Q19_W1);
+        StoreDist(dist, 12 * Np + n, f11, D3Q19_W2);
+        StoreDist(dist, 13 * Np + n, f14, D3Q19_W2);
+        StoreDist(dist, 16 * Np + n, f15, D3Q19_W2);
+        StoreDist(dist, 17 * Np + n, f18, D3Q19_W2);
     }
 }
 
-extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_Z(int *list, double *dist,
-                                                  double dout, int count,
+extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_z(int *list, double *dist,
+                                                  double din, int count,
                                                   int Np) {
+    D3Q19_AAeven_Pressure_BC_z(list, dist, din, count, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_z_float(int *list, float *dist,
+                                                        double din, int count,
+                                                        int Np) {
+    D3Q19_AAeven_Pressure_BC_z(list, dist, din, count, Np);
+}
+
+template <class TYPE>
+static void D3Q19_AAeven_Pressure_BC_Z(int *list, TYPE *dist, double dout,
+                                       int count, int Np) {
     // distributions
     double ux, uy, uz, Cyz, Cxz;
     ux = uy = 0.0;
@@ -547,20 +644,20 @@ extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_Z(int *list, double *dist,
         //........................................................................
         // Read distributions
         //........................................................................
-        double f0 = dist[n];
-        double f1 = dist[2 * Np + n];
-        double f2 = dist[1 * Np + n];
-        double f3 = dist[4 * Np + n];
-        double f4 = dist[3 * Np + n];
-        double f5 = dist[6 * Np + n];
-        double f7 = dist[8 * Np + n];
-        double f8 = dist[7 * Np + n];
-        double f9 = dist[10 * Np + n];
-        double f10 = dist[9 * Np + n];
-        double f11 = dist[12 * Np + n];
-        double f14 = dist[13 * Np + n];
-        double f15 = dist[16 * Np + n];
-        double f18 = dist[17 * Np + n];
+        double f0 = LoadDist(dist, n, D3Q19_W0);
+        double f1 = LoadDist(dist, 2 * Np + n, D3Q19_W1);
+        double f2 = LoadDist(dist, 1 * Np + n, D3Q19_W1);
+        double f3 = LoadDist(dist, 4 * Np + n, D3Q19_W1);
+        double f4 = LoadDist(dist, 3 * Np + n, D3Q19_W1);
+        double f5 = LoadDist(dist, 6 * Np + n, D3Q19_W1);
+        double f7 = LoadDist(dist, 8 * Np + n, D3Q19_W2);
+        double f8 = LoadDist(dist, 7 * Np + n, D3Q19_W2);
+        double f9 = LoadDist(dist, 10 * Np + n, D3Q19_W2);
+        double f10 = LoadDist(dist, 9 * Np + n, D3Q19_W2);
+        double f11 = LoadDist(dist, 12 * Np + n, D3Q19_W2);
+        double f14 = LoadDist(dist, 13 * Np + n, D3Q19_W2);
+        double f15 = LoadDist(dist, 16 * Np + n, D3Q19_W2);
+        double f18 = LoadDist(dist, 17 * Np + n, D3Q19_W2);
 
         // Determine the outlet flow velocity
         //ux = f1-f2+f7-f8+f9-f10+f11-f12+f13-f14;
@@ -577,18 +674,31 @@ extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_Z(int *list, double *dist,
         double f16 = f15 - 0.16666666666666678 * (uy + uz) + Cyz;
         double f17 = f18 - 0.16666666666666678 * (uz - uy) - Cyz;
 
-        dist[5 * Np + n] = f6;
-        dist[11 * Np + n] = f12;
-        dist[14 * Np + n] = f13;
-        dist[15 * Np + n] = f16;
-        dist[18 * Np + n] = f17;
+        StoreDist(dist, 5 * Np + n, f6, D3Q19_W1);
+        StoreDist(dist, 11 * Np + n, f12, D3Q19_W2);
+        StoreDist(dist, 14 * Np + n, f13, D3Q19_W2);
+        StoreDist(dist, 15 * Np + n, f16, D3Q19_W2);
+        StoreDist(dist, 18 * Np + n, f17, D3Q19_W2);
         //...................................................
     }
 }
 
-extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_z(int *d_neighborList, int *list,
-                                                 double *dist, double din,
-                                                 int count, int Np) {
+extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_Z(int *list, double *dist,
+                                                  double dout, int count,
+                                                  int Np) {
+    D3Q19_AAeven_Pressure_BC_Z(list, dist, dout, count, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAeven_Pressure_BC_Z_float(int *list, float *dist,
+                                                        double dout, int count,
+                                                        int Np) {
+    D3Q19_AAeven_Pressure_BC_Z(list, dist, dout, count, Np);
+}
+
+template <class TYPE>
+static void D3Q19_AAodd_Pressure_BC_z(int *d_neighborList, int *list,
+                                      TYPE *dist, double din, int count,
+                                      int Np) {
     int nread;
     int nr5, nr11, nr14, nr15, nr18;
     // distributions
@@ -597,46 +707,46 @@ extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_z(int *d_neighborList, int *list,
 
     for (int idx = 0; idx < count; idx++) {
         int n = list[idx];
-        double f0 = dist[n];
+        double f0 = LoadDist(dist, n, D3Q19_W0);
 
         nread = d_neighborList[n];
-        double f1 = dist[nread];
+        double f1 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 2 * Np];
-        double f3 = dist[nread];
+        double f3 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 6 * Np];
-        double f7 = dist[nread];
+        double f7 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 8 * Np];
-        double f9 = dist[nread];
+        double f9 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 12 * Np];
-        double f13 = dist[nread];
+        double f13 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 16 * Np];
-        double f17 = dist[nread];
+        double f17 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + Np];
-        double f2 = dist[nread];
+        double f2 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 3 * Np];
-        double f4 = dist[nread];
+        double f4 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 5 * Np];
-        double f6 = dist[nread];
+        double f6 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 7 * Np];
-        double f8 = dist[nread];
+        double f8 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 9 * Np];
-        double f10 = dist[nread];
+        double f10 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 11 * Np];
-        double f12 = dist[nread];
+        double f12 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 15 * Np];
-        double f16 = dist[nread];
+        double f16 = LoadDist(dist, nread, D3Q19_W2);
 
         // Unknown distributions
         nr5 = d_neighborList[n + 4 * Np];
@@ -661,17 +771,31 @@ extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_z(int *d_neighborList, int *list,
         double f15 = f16 + 0.16666666666666678 * (uy + uz) - Cyz;
         double f18 = f17 + 0.16666666666666678 * (uz - uy) + Cyz;
 
-        dist[nr5] = f5;
-        dist[nr11] = f11;
-        dist[nr14] = f14;
-        dist[nr15] = f15;
-        dist[nr18] = f18;
+        StoreDist(dist, nr5, f5, D3Q19_W1);
+        StoreDist(dist, nr11, f11, D3Q19_W2);
+        StoreDist(dist, nr14, f14, D3Q19_W2);
+        StoreDist(dist, nr15, f15, D3Q19_W2);
+        StoreDist(dist, nr18, f18, D3Q19_W2);
     }
 }
 
-extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_Z(int *d_neighborList, int *list,
-                                                 double *dist, double dout,
+extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_z(int *d_neighborList, int *list,
+                                                 double *dist, double din,
                                                  int count, int Np) {
+    D3Q19_AAodd_Pressure_BC_z(d_neighborList, list, dist, din, count, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_z_float(int *d_neighborList,
+                                                       int *list, float *dist,
+                                                       double din, int count,
+                                                       int Np) {
+    D3Q19_AAodd_Pressure_BC_z(d_neighborList, list, dist, din, count, Np);
+}
+
+template <class TYPE>
+static void D3Q19_AAodd_Pressure_BC_Z(int *d_neighborList, int *list,
+                                      TYPE *dist, double dout, int count,
+                                      int Np) {
     int nread;
     int nr6, nr12, nr13, nr16, nr17;
     // distributions
@@ -683,46 +807,46 @@ extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_Z(int *d_neighborList, int *list,
         //........................................................................
         // Read distributions
         //........................................................................
-        double f0 = dist[n];
+        double f0 = LoadDist(dist, n, D3Q19_W0);
 
         nread = d_neighborList[n];
-        double f1 = dist[nread];
+        double f1 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 2 * Np];
-        double f3 = dist[nread];
+        double f3 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 4 * Np];
-        double f5 = dist[nread];
+        double f5 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 6 * Np];
-        double f7 = dist[nread];
+        double f7 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 8 * Np];
-        double f9 = dist[nread];
+        double f9 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 10 * Np];
-        double f11 = dist[nread];
+        double f11 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 14 * Np];
-        double f15 = dist[nread];
+        double f15 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + Np];
-        double f2 = dist[nread];
+        double f2 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 3 * Np];
-        double f4 = dist[nread];
+        double f4 = LoadDist(dist, nread, D3Q19_W1);
 
         nread = d_neighborList[n + 7 * Np];
-        double f8 = dist[nread];
+        double f8 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 9 * Np];
-        double f10 = dist[nread];
+        double f10 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 13 * Np];
-        double f14 = dist[nread];
+        double f14 = LoadDist(dist, nread, D3Q19_W2);
 
         nread = d_neighborList[n + 17 * Np];
-        double f18 = dist[nread];
+        double f18 = LoadDist(dist, nread, D3Q19_W2);
 
         // unknown distributions
         nr6 = d_neighborList[n + 5 * Np];
@@ -747,15 +871,28 @@ extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_Z(int *d_neighborList, int *list,
         double f17 = f18 - 0.16666666666666678 * (uz - uy) - Cyz;
 
         //........Store in "opposite" memory location..........
-        dist[nr6] = f6;
-        dist[nr12] = f12;
-        dist[nr13] = f13;
-        dist[nr16] = f16;
-        dist[nr17] = f17;
+        StoreDist(dist, nr6, f6, D3Q19_W1);
+        StoreDist(dist, nr12, f12, D3Q19_W2);
+        StoreDist(dist, nr13, f13, D3Q19_W2);
+        StoreDist(dist, nr16, f16, D3Q19_W2);
+        StoreDist(dist, nr17, f17, D3Q19_W2);
         //...................................................
     }
 }
 
+extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_Z(int *d_neighborList, int *list,
+                                                 double *dist, double dout,
+                                                 int count, int Np) {
+    D3Q19_AAodd_Pressure_BC_Z(d_neighborList, list, dist, dout, count, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Pressure_BC_Z_float(int *d_neighborList,
+                                                       int *list, float *dist,
+                                                       double dout, int count,
+                                                       int Np) {
+    D3Q19_AAodd_Pressure_BC_Z(d_neighborList, list, dist, dout, count, Np);
+}
+
 extern "C" void ScaLBL_D3Q19_Velocity_BC_z(double *disteven, double *distodd,
                                            double uz, int Nx, int Ny, int Nz) {
     int n, N;
@@ -876,6 +1013,51 @@ extern "C" void ScaLBL_D3Q19_Velocity_BC_Z(double *disteven, double *distodd,
     }
 }
 
+extern "C" void ScaLBL_D3Q19_Init_float(float *dist, int Np) {
+    // shifted storage: the rest state is stored as zero
+    for (int n = 0; n < 19 * Np; n++)
+        dist[n] = 0.f;
+}
+
+extern "C" void ScaLBL_D3Q19_Pressure_float(float *dist, double *Pressure,
+                                           int Np) {
+    // the lattice weights sum to one in the shifted storage
+    for (int n = 0; n < Np; n++) {
+        double sum = 1.0;
+        for (int q = 0; q < 19; q++)
+            sum += dist[q * Np + n];
+        Pressure[n] = 0.3333333333333333 * sum;
+    }
+}
+
+extern "C" void ScaLBL_D3Q19_Momentum_float(float *dist, double *vel, int Np) {
+    // the lattice weights cancel for opposite directions in the shifted storage
+    int N = Np;
+    for (int n = 0; n < N; n++) {
+        double f1 = dist[N + n];
+        double f2 = dist[2 * N + n];
+        double f3 = dist[3 * N + n];
+        double f4 = dist[4 * N + n];
+        double f5 = dist[5 * N + n];
+        double f6 = dist[6 * N + n];
+        double f7 = dist[7 * N + n];
+        double f8 = dist[8 * N + n];
+        double f9 = dist[9 * N + n];
+        double f10 = dist[10 * N + n];
+        double f11 = dist[11 * N + n];
+        double f12 = dist[12 * N + n];
+        double f13 = dist[13 * N + n];
+        double f14 = dist[14 * N + n];
+        double f15 = dist[15 * N + n];
+        double f16 = dist[16 * N + n];
+        double f17 = dist[17 * N + n];
+        double f18 = dist[18 * N + n];
+        vel[n] = f1 - f2 + f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14;
+        vel[N + n] = f3 - f4 + f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18;
+        vel[2 * N + n] = f5 - f6 + f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18;
+    }
+}
+
 extern "C" void ScaLBL_D3Q19_Momentum(double *dist, double *vel, int Np) {
     int n;
     int N = Np;
@@ -951,10 +1133,10 @@ extern "C" void ScaLBL_D3Q19_Pressure(double *dist, double *Pressure, int N) {
     }
 }
 
-extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
-                                        int Np, double rlx_setA,
-                                        double rlx_setB, double Fx, double Fy,
-                                        double Fz) {
+template <class TYPE>
+static void D3Q19_AAeven_MRT(TYPE *dist, int start, int finish, int Np,
+                             double rlx_setA, double rlx_setB, double Fx,
+                             double Fy, double Fz) {
     // conserved momemnts
     double rho, jx, jy, jz;
     // non-conserved moments
@@ -973,15 +1155,17 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
     constexpr double mrt_V11 = 0.01388888888888889;
     constexpr double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(rho, jx, jy, jz, m1, m2, \
+        m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18)
     for (int n = start; n < finish; n++) {
         // q=0
-        double fq = dist[n];
+        double fq = LoadDist(dist, n, D3Q19_W0);
         rho = fq;
         m1 = -30.0 * fq;
         m2 = 12.0 * fq;
 
         // q=1
-        fq = dist[2 * Np + n];
+        fq = LoadDist(dist, 2 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -991,7 +1175,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m10 = -4.0 * fq;
 
         // f2 = dist[10*Np+n];
-        fq = dist[1 * Np + n];
+        fq = LoadDist(dist, 1 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * (fq);
         m2 -= 4.0 * (fq);
@@ -1001,7 +1185,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m10 -= 4.0 * (fq);
 
         // q=3
-        fq = dist[4 * Np + n];
+        fq = LoadDist(dist, 4 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1013,7 +1197,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m12 = -2.0 * fq;
 
         // q = 4
-        fq = dist[3 * Np + n];
+        fq = LoadDist(dist, 3 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1025,7 +1209,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m12 -= 2.0 * fq;
 
         // q=5
-        fq = dist[6 * Np + n];
+        fq = LoadDist(dist, 6 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1037,7 +1221,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m12 += 2.0 * fq;
 
         // q = 6
-        fq = dist[5 * Np + n];
+        fq = LoadDist(dist, 5 * Np + n, D3Q19_W1);
         rho += fq;
         m1 -= 11.0 * fq;
         m2 -= 4.0 * fq;
@@ -1049,7 +1233,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m12 += 2.0 * fq;
 
         // q=7
-        fq = dist[8 * Np + n];
+        fq = LoadDist(dist, 8 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1066,7 +1250,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m17 = -fq;
 
         // q = 8
-        fq = dist[7 * Np + n];
+        fq = LoadDist(dist, 7 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1083,7 +1267,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m17 += fq;
 
         // q=9
-        fq = dist[10 * Np + n];
+        fq = LoadDist(dist, 10 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1100,7 +1284,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m17 += fq;
 
         // q = 10
-        fq = dist[9 * Np + n];
+        fq = LoadDist(dist, 9 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1117,7 +1301,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m17 -= fq;
 
         // q=11
-        fq = dist[12 * Np + n];
+        fq = LoadDist(dist, 12 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1134,7 +1318,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m18 = fq;
 
         // q=12
-        fq = dist[11 * Np + n];
+        fq = LoadDist(dist, 11 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1151,7 +1335,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m18 -= fq;
 
         // q=13
-        fq = dist[14 * Np + n];
+        fq = LoadDist(dist, 14 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1168,7 +1352,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m18 -= fq;
 
         // q=14
-        fq = dist[13 * Np + n];
+        fq = LoadDist(dist, 13 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1185,7 +1369,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m18 += fq;
 
         // q=15
-        fq = dist[16 * Np + n];
+        fq = LoadDist(dist, 16 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1200,7 +1384,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m18 -= fq;
 
         // q=16
-        fq = dist[15 * Np + n];
+        fq = LoadDist(dist, 15 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1215,7 +1399,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m18 += fq;
 
         // q=17
-        fq = dist[18 * Np + n];
+        fq = LoadDist(dist, 18 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1230,7 +1414,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
         m18 += fq;
 
         // q=18
-        fq = dist[17 * Np + n];
+        fq = LoadDist(dist, 17 * Np + n, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1277,86 +1461,86 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
 
         // q=0
         fq = mrt_V1 * rho - mrt_V2 * m1 + mrt_V3 * m2;
-        dist[n] = fq;
+        StoreDist(dist, n, fq, D3Q19_W0);
 
         // q = 1
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jx - m4) +
              mrt_V6 * (m9 - m10) + 0.16666666 * Fx;
-        dist[1 * Np + n] = fq;
+        StoreDist(dist, 1 * Np + n, fq, D3Q19_W1);
 
         // q=2
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m4 - jx) +
              mrt_V6 * (m9 - m10) - 0.16666666 * Fx;
-        dist[2 * Np + n] = fq;
+        StoreDist(dist, 2 * Np + n, fq, D3Q19_W1);
 
         // q = 3
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jy - m6) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m11 - m12) + 0.16666666 * Fy;
-        dist[3 * Np + n] = fq;
+        StoreDist(dist, 3 * Np + n, fq, D3Q19_W1);
 
         // q = 4
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m6 - jy) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m11 - m12) - 0.16666666 * Fy;
-        dist[4 * Np + n] = fq;
+        StoreDist(dist, 4 * Np + n, fq, D3Q19_W1);
 
         // q = 5
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jz - m8) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m12 - m11) + 0.16666666 * Fz;
-        dist[5 * Np + n] = fq;
+        StoreDist(dist, 5 * Np + n, fq, D3Q19_W1);
 
         // q = 6
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m8 - jz) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m12 - m11) - 0.16666666 * Fz;
-        dist[6 * Np + n] = fq;
+        StoreDist(dist, 6 * Np + n, fq, D3Q19_W1);
 
         // q = 7
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx + jy) +
              0.025 * (m4 + m6) + mrt_V7 * m9 + mrt_V11 * m10 + mrt_V8 * m11 +
              mrt_V12 * m12 + 0.25 * m13 + 0.125 * (m16 - m17) +
              0.08333333333 * (Fx + Fy);
-        dist[7 * Np + n] = fq;
+        StoreDist(dist, 7 * Np + n, fq, D3Q19_W2);
 
         // q = 8
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jx + jy) -
              0.025 * (m4 + m6) + mrt_V7 * m9 + mrt_V11 * m10 + mrt_V8 * m11 +
              mrt_V12 * m12 + 0.25 * m13 + 0.125 * (m17 - m16) -
              0.08333333333 * (Fx + Fy);
-        dist[8 * Np + n] = fq;
+        StoreDist(dist, 8 * Np + n, fq, D3Q19_W2);
 
         // q = 9
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx - jy) +
              0.025 * (m4 - m6) + mrt_V7 * m9 + mrt_V11 * m10 + mrt_V8 * m11 +
              mrt_V12 * m12 - 0.25 * m13 + 0.125 * (m16 + m17) +
              0.08333333333 * (Fx - Fy);
-        dist[9 * Np + n] = fq;
+        StoreDist(dist, 9 * Np + n, fq, D3Q19_W2);
 
         // q = 10
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy - jx) +
              0.025 * (m6 - m4) + mrt_V7 * m9 + mrt_V11 * m10 + mrt_V8 * m11 +
              mrt_V12 * m12 - 0.25 * m13 - 0.125 * (m16 + m17) -
              0.08333333333 * (Fx - Fy);
-        dist[10 * Np + n] = fq;
+        StoreDist(dist, 10 * Np + n, fq, D3Q19_W2);
 
         // q = 11
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx + jz) +
              0.025 * (m4 + m8) + mrt_V7 * m9 + mrt_V11 * m10 - mrt_V8 * m11 -
              mrt_V12 * m12 + 0.25 * m15 + 0.125 * (m18 - m16) +
              0.08333333333 * (Fx + Fz);
-        dist[11 * Np + n] = fq;
+        StoreDist(dist, 11 * Np + n, fq, D3Q19_W2);
 
         // q = 12
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jx + jz) -
              0.025 * (m4 + m8) + mrt_V7 * m9 + mrt_V11 * m10 - mrt_V8 * m11 -
              mrt_V12 * m12 + 0.25 * m15 + 0.125 * (m16 - m18) -
              0.08333333333 * (Fx + Fz);
-        dist[12 * Np + n] = fq;
+        StoreDist(dist, 12 * Np + n, fq, D3Q19_W2);
 
         // q = 13
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx - jz) +
              0.025 * (m4 - m8) + mrt_V7 * m9 + mrt_V11 * m10 - mrt_V8 * m11 -
              mrt_V12 * m12 - 0.25 * m15 - 0.125 * (m16 + m18) +
              0.08333333333 * (Fx - Fz);
-        dist[13 * Np + n] = fq;
+        StoreDist(dist, 13 * Np + n, fq, D3Q19_W2);
 
         // q= 14
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jz - jx) +
@@ -1364,40 +1548,40 @@ extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
              mrt_V12 * m12 - 0.25 * m15 + 0.125 * (m16 + m18) -
              0.08333333333 * (Fx - Fz);
 
-        dist[14 * Np + n] = fq;
+        StoreDist(dist, 14 * Np + n, fq, D3Q19_W2);
 
         // q = 15
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy + jz) +
              0.025 * (m6 + m8) - mrt_V6 * m9 - mrt_V7 * m10 + 0.25 * m14 +
              0.125 * (m17 - m18) + 0.08333333333 * (Fy + Fz);
-        dist[15 * Np + n] = fq;
+        StoreDist(dist, 15 * Np + n, fq, D3Q19_W2);
 
         // q = 16
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jy + jz) -
              0.025 * (m6 + m8) - mrt_V6 * m9 - mrt_V7 * m10 + 0.25 * m14 +
              0.125 * (m18 - m17) - 0.08333333333 * (Fy + Fz);
-        dist[16 * Np + n] = fq;
+        StoreDist(dist, 16 * Np + n, fq, D3Q19_W2);
 
         // q = 17
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy - jz) +
              0.025 * (m6 - m8) - mrt_V6 * m9 - mrt_V7 * m10 - 0.25 * m14 +
              0.125 * (m17 + m18) + 0.08333333333 * (Fy - Fz);
-        dist[17 * Np + n] = fq;
+        StoreDist(dist, 17 * Np + n, fq, D3Q19_W2);
 
         // q = 18
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jz - jy) +
              0.025 * (m8 - m6) - mrt_V6 * m9 - mrt_V7 * m10 - 0.25 * m14 -
              0.125 * (m17 + m18) - 0.08333333333 * (Fy - Fz);
-        dist[18 * Np + n] = fq;
+        StoreDist(dist, 18 * Np + n, fq, D3Q19_W2);
 
         //........................................................................
     }
 }
 
-extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
-                                       int start, int finish, int Np,
-                                       double rlx_setA, double rlx_setB,
-                                       double Fx, double Fy, double Fz) {
+template <class TYPE>
+static void D3Q19_AAodd_MRT(int *neighborList, TYPE *dist, int start,
+                            int finish, int Np, double rlx_setA,
+                            double rlx_setB, double Fx, double Fy, double Fz) {
     // conserved momemnts
     double rho, jx, jy, jz;
     // non-conserved moments
@@ -1416,16 +1600,18 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
     constexpr double mrt_V12 = 0.04166666666666666;
 
     int nread;
+    #pragma omp parallel for schedule(static) private(rho, jx, jy, jz, m1, m2, \
+        m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, nread)
     for (int n = start; n < finish; n++) {
         // q=0
-        double fq = dist[n];
+        double fq = LoadDist(dist, n, D3Q19_W0);
         rho = fq;
         m1 = -30.0 * fq;
         m2 = 12.0 * fq;
 
         // q=1
         nread = neighborList[n]; // neighbor 2 ( > 10Np => odd part of dist)
-        fq = dist[nread];        // reading the f1 data into register fq
+        fq = LoadDist(dist, nread, D3Q19_W1);        // reading the f1 data into register fq
         //fp = dist[10*Np+n];
         rho += fq;
         m1 -= 11.0 * fq;
@@ -1438,7 +1624,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
         // f2 = dist[10*Np+n];
         nread =
             neighborList[n + Np]; // neighbor 1 ( < 10Np => even part of dist)
-        fq = dist[nread];         // reading the f2 data into register fq
+        fq = LoadDist(dist, nread, D3Q19_W1);         // reading the f2 data into register fq
         //fq = dist[Np+n];
         rho += fq;
         m1 -= 11.0 * (fq);
@@ -1450,7 +1636,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=3
         nread = neighborList[n + 2 * Np]; // neighbor 4
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W1);
         //fq = dist[11*Np+n];
         rho += fq;
         m1 -= 11.0 * fq;
@@ -1464,7 +1650,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q = 4
         nread = neighborList[n + 3 * Np]; // neighbor 3
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W1);
         //fq = dist[2*Np+n];
         rho += fq;
         m1 -= 11.0 * fq;
@@ -1478,7 +1664,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=5
         nread = neighborList[n + 4 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W1);
         //fq = dist[12*Np+n];
         rho += fq;
         m1 -= 11.0 * fq;
@@ -1492,7 +1678,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q = 6
         nread = neighborList[n + 5 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W1);
         //fq = dist[3*Np+n];
         rho += fq;
         m1 -= 11.0 * fq;
@@ -1506,7 +1692,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=7
         nread = neighborList[n + 6 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[13*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1525,7 +1711,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q = 8
         nread = neighborList[n + 7 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[4*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1544,7 +1730,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=9
         nread = neighborList[n + 8 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[14*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1563,7 +1749,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q = 10
         nread = neighborList[n + 9 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[5*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1582,7 +1768,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=11
         nread = neighborList[n + 10 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[15*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1601,7 +1787,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=12
         nread = neighborList[n + 11 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[6*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1620,7 +1806,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=13
         nread = neighborList[n + 12 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[16*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1639,7 +1825,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=14
         nread = neighborList[n + 13 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[7*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1658,7 +1844,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=15
         nread = neighborList[n + 14 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[17*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1675,7 +1861,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=16
         nread = neighborList[n + 15 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[8*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1693,7 +1879,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
         // q=17
         //fq = dist[18*Np+n];
         nread = neighborList[n + 16 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         rho += fq;
         m1 += 8.0 * fq;
         m2 += fq;
@@ -1709,7 +1895,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=18
         nread = neighborList[n + 17 * Np];
-        fq = dist[nread];
+        fq = LoadDist(dist, nread, D3Q19_W2);
         //fq = dist[9*Np+n];
         rho += fq;
         m1 += 8.0 * fq;
@@ -1752,43 +1938,43 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
 
         // q=0
         fq = mrt_V1 * rho - mrt_V2 * m1 + mrt_V3 * m2;
-        dist[n] = fq;
+        StoreDist(dist, n, fq, D3Q19_W0);
 
         // q = 1
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jx - m4) +
              mrt_V6 * (m9 - m10) + 0.16666666 * Fx;
         nread = neighborList[n + Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W1);
 
         // q=2
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m4 - jx) +
              mrt_V6 * (m9 - m10) - 0.16666666 * Fx;
         nread = neighborList[n];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W1);
 
         // q = 3
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jy - m6) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m11 - m12) + 0.16666666 * Fy;
         nread = neighborList[n + 3 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W1);
 
         // q = 4
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m6 - jy) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m11 - m12) - 0.16666666 * Fy;
         nread = neighborList[n + 2 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W1);
 
         // q = 5
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (jz - m8) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m12 - m11) + 0.16666666 * Fz;
         nread = neighborList[n + 5 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W1);
 
         // q = 6
         fq = mrt_V1 * rho - mrt_V4 * m1 - mrt_V5 * m2 + 0.1 * (m8 - jz) +
              mrt_V7 * (m10 - m9) + mrt_V8 * (m12 - m11) - 0.16666666 * Fz;
         nread = neighborList[n + 4 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W1);
 
         // q = 7
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx + jy) +
@@ -1796,7 +1982,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
              mrt_V12 * m12 + 0.25 * m13 + 0.125 * (m16 - m17) +
              0.08333333333 * (Fx + Fy);
         nread = neighborList[n + 7 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 8
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jx + jy) -
@@ -1804,7 +1990,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
              mrt_V12 * m12 + 0.25 * m13 + 0.125 * (m17 - m16) -
              0.08333333333 * (Fx + Fy);
         nread = neighborList[n + 6 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 9
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx - jy) +
@@ -1812,7 +1998,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
              mrt_V12 * m12 - 0.25 * m13 + 0.125 * (m16 + m17) +
              0.08333333333 * (Fx - Fy);
         nread = neighborList[n + 9 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 10
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy - jx) +
@@ -1820,7 +2006,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
              mrt_V12 * m12 - 0.25 * m13 - 0.125 * (m16 + m17) -
              0.08333333333 * (Fx - Fy);
         nread = neighborList[n + 8 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 11
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx + jz) +
@@ -1828,7 +2014,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
              mrt_V12 * m12 + 0.25 * m15 + 0.125 * (m18 - m16) +
              0.08333333333 * (Fx + Fz);
         nread = neighborList[n + 11 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 12
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jx + jz) -
@@ -1836,7 +2022,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
              mrt_V12 * m12 + 0.25 * m15 + 0.125 * (m16 - m18) -
              0.08333333333 * (Fx + Fz);
         nread = neighborList[n + 10 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 13
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jx - jz) +
@@ -1844,7 +2030,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
              mrt_V12 * m12 - 0.25 * m15 - 0.125 * (m16 + m18) +
              0.08333333333 * (Fx - Fz);
         nread = neighborList[n + 13 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q= 14
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jz - jx) +
@@ -1852,38 +2038,68 @@ extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
              mrt_V12 * m12 - 0.25 * m15 + 0.125 * (m16 + m18) -
              0.08333333333 * (Fx - Fz);
         nread = neighborList[n + 12 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 15
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy + jz) +
              0.025 * (m6 + m8) - mrt_V6 * m9 - mrt_V7 * m10 + 0.25 * m14 +
              0.125 * (m17 - m18) + 0.08333333333 * (Fy + Fz);
         nread = neighborList[n + 15 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 16
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 - 0.1 * (jy + jz) -
              0.025 * (m6 + m8) - mrt_V6 * m9 - mrt_V7 * m10 + 0.25 * m14 +
              0.125 * (m18 - m17) - 0.08333333333 * (Fy + Fz);
         nread = neighborList[n + 14 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 17
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jy - jz) +
              0.025 * (m6 - m8) - mrt_V6 * m9 - mrt_V7 * m10 - 0.25 * m14 +
              0.125 * (m17 + m18) + 0.08333333333 * (Fy - Fz);
         nread = neighborList[n + 17 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
 
         // q = 18
         fq = mrt_V1 * rho + mrt_V9 * m1 + mrt_V10 * m2 + 0.1 * (jz - jy) +
              0.025 * (m8 - m6) - mrt_V6 * m9 - mrt_V7 * m10 - 0.25 * m14 -
              0.125 * (m17 + m18) - 0.08333333333 * (Fy - Fz);
         nread = neighborList[n + 16 * Np];
-        dist[nread] = fq;
+        StoreDist(dist, nread, fq, D3Q19_W2);
     }
 }
 
+extern "C" void ScaLBL_D3Q19_AAeven_MRT(double *dist, int start, int finish,
+                                        int Np, double rlx_setA,
+                                        double rlx_setB, double Fx, double Fy,
+                                        double Fz) {
+    D3Q19_AAeven_MRT(dist, start, finish, Np, rlx_setA, rlx_setB, Fx, Fy, Fz);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_MRT(int *neighborList, double *dist,
+                                       int start, int finish, int Np,
+                                       double rlx_setA, double rlx_setB,
+                                       double Fx, double Fy, double Fz) {
+    D3Q19_AAodd_MRT(neighborList, dist, start, finish, Np, rlx_setA, rlx_setB,
+                    Fx, Fy, Fz);
+}
+
+extern "C" void ScaLBL_D3Q19_AAeven_MRT_float(float *dist, int start,
+                                              int finish, int Np,
+                                              double rlx_setA, double rlx_setB,
+                                              double Fx, double Fy, double Fz) {
+    D3Q19_AAeven_MRT(dist, start, finish, Np, rlx_setA, rlx_setB, Fx, Fy, Fz);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_MRT_float(int *neighborList, float *dist,
+                                             int start, int finish, int Np,
+                                             double rlx_setA, double rlx_setB,
+                                             double Fx, double Fy, double Fz) {
+    D3Q19_AAodd_MRT(neighborList, dist, start, finish, Np, rlx_setA, rlx_setB,
+                    Fx, Fy, Fz);
+}
+
 extern "C" void ScaLBL_D3Q19_AAeven_Compact(double *dist, int Np) {
 
     for (int n = 0; n < Np; n++) {
@@ -0,0 +1,41 @@
+/*
+  Copyright 2013--2018 James E. McClure, Virginia Polytechnic & State University
+  Copyright Equnior ASA
+
+  This file is part of the Open Porous Media project (OPM).
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef D3Q19_helpers_H
+#define D3Q19_helpers_H
+
+// Distributions are stored either as double or as float shifted by the
+// lattice weight (f_q - w_q, see ScaLBL_D3Q19_Init_float), which keeps the
+// float mantissa for the small deviations from the rest state. Moments are
+// always computed in double.
+constexpr double D3Q19_W0 = 0.3333333333333333;
+constexpr double D3Q19_W1 = 0.05555555555555555;
+constexpr double D3Q19_W2 = 0.02777777777777778;
+
+static inline double LoadDist(const double *dist, int idx, double) {
+    return dist[idx];
+}
+static inline double LoadDist(const float *dist, int idx, double w) {
+    return dist[idx] + w;
+}
+static inline void StoreDist(double *dist, int idx, double fq, double) {
+    dist[idx] = fq;
+}
+static inline void StoreDist(float *dist, int idx, double fq, double w) {
+    dist[idx] = fq - w;
+}
+
+#endif
@@ -60,6 +60,20 @@ extern "C" void ScaLBL_D3Q7_Unpack(int q, int *list, int start, int count,
     }
 }
 
+extern "C" void ScaLBL_D3Q7_Unpack_float(int q, int *list, int start,
+                                         int count, float *recvbuf, float *dist,
+                                         int N) {
+    //....................................................................................
+    // Unpack distribution q stored as float (see ScaLBL_D3Q7_Unpack)
+    //....................................................................................
+    int n, idx;
+    for (idx = 0; idx < count; idx++) {
+        n = list[idx];
+        if (!(n < 0))
+            dist[q * N + n] = recvbuf[start + idx];
+    }
+}
+
 extern "C" void ScaLBL_PackDenD3Q7(int *list, int count, double *sendbuf,
                                    int number, double *Data, int N) {
     //....................................................................................
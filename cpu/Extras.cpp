@@ -41,6 +41,28 @@ extern "C" void ScaLBL_AllocateDeviceMemory(void **address, size_t size) {
     }
 }
 
+extern "C" void ScaLBL_AllocateDistributionMemory(void **address, size_t size,
+                                                  int Nq) {
+    (*address) = _mm_malloc(size, 64);
+    if (*address == NULL) {
+        printf("Memory allocation failed! \n");
+        return;
+    }
+    // Zero each of the Nq planes with the same static partition used by the
+    // kernels so that pages are first touched by the thread that updates them
+    char *data = (char *)(*address);
+    size_t plane = size / Nq;
+    #pragma omp parallel
+    for (int q = 0; q < Nq; q++) {
+        char *ptr = &data[q * plane];
+        #pragma omp for schedule(static)
+        for (size_t i = 0; i < plane; i++) {
+            ptr[i] = 0;
+        }
+    }
+    memset(&data[Nq * plane], 0, size - Nq * plane);
+}
+
 extern "C" void ScaLBL_FreeDeviceMemory(void *pointer) { _mm_free(pointer); }
 
 extern "C" void ScaLBL_CopyToDevice(void *dest, const void *source,
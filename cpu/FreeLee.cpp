@@ -140,6 +140,8 @@ ScaLBL_FreeLeeModel_PhaseField_Init(int *Map, double *Phi, double *Den,
     double cs2_inv = 4.5; //inverse of speed of sound for D3Q7
     double M = 1.0 / cs2_inv * (tauM - 0.5); //diffusivity (or mobility)
 
+    #pragma omp parallel for schedule(static) private(n, phi, nx, ny, nz, \
+        cg_mag, theta)
     for (idx = start; idx < finish; idx++) {
 
         n = Map[idx];
@@ -181,6 +183,7 @@ extern "C" void ScaLBL_D3Q7_AAodd_FreeLeeModel_PhaseField(
     int idx, nread;
     double fq, phi;
 
+    #pragma omp parallel for schedule(static) private(idx, nread, fq, phi)
     for (int n = start; n < finish; n++) {
 
         // q=0
@@ -231,6 +234,7 @@ extern "C" void ScaLBL_D3Q7_AAeven_FreeLeeModel_PhaseField(
     int start, int finish, int Np) {
     int idx;
     double fq, phi;
+    #pragma omp parallel for schedule(static) private(idx, fq, phi)
     for (int n = start; n < finish; n++) {
 
         // q=0
@@ -285,6 +289,9 @@ extern "C" void ScaLBL_D3Q7_AAodd_FreeLee_PhaseField(
         (tauM - 0.5); //diffusivity (or mobility) for the phase field D3Q7
     double theta;
 
+    #pragma omp parallel for schedule(static) private(idx, nr1, nr2, nr3, nr4, \
+        nr5, nr6, h0, h1, h2, h3, h4, h5, h6, nx, ny, nz, C, ux, uy, uz, phi, \
+        theta)
     for (int n = start; n < finish; n++) {
 
         /* load phase indicator field */
@@ -384,6 +391,8 @@ extern "C" void ScaLBL_D3Q7_AAeven_FreeLee_PhaseField(
         (tauM - 0.5); //diffusivity (or mobility) for the phase field D3Q7
     double theta;
 
+    #pragma omp parallel for schedule(static) private(idx, h0, h1, h2, h3, h4, \
+        h5, h6, nx, ny, nz, C, ux, uy, uz, phi, theta)
     for (int n = start; n < finish; n++) {
 
         /* load phase indicator field */
@@ -460,6 +469,8 @@ extern "C" void ScaLBL_D3Q7_ComputePhaseField(int *Map, double *hq, double *Den,
     double h0, h1, h2, h3, h4, h5, h6;
     double phi;
 
+    #pragma omp parallel for schedule(static) private(idx, h0, h1, h2, h3, h4, \
+        h5, h6, phi)
     for (int n = start; n < finish; n++) {
 
         h0 = hq[n];
@@ -513,6 +524,14 @@ extern "C" void ScaLBL_D3Q19_AAodd_FreeLeeModel(
     //double C,theta;
     // double M = 2.0/9.0*(tauM-0.5);//diffusivity (or mobility) for the phase field D3Q7
 
+    #pragma omp parallel for schedule(static) private(nn, nn2x, ijk, nr1, nr2, \
+        nr3, nr4, nr5, nr6, nr7, nr8, nr9, nr10, nr11, nr12, nr13, nr14, nr15, \
+        nr16, nr17, nr18, ux, uy, uz, p, chem, phi, rho0, m1, m2, m4, m6, m8, \
+        m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m0, m3, m5, m7, mm1, \
+        mm2, mm4, mm6, mm8, mm9, mm10, mm11, mm12, mm13, mm14, mm15, mm16, \
+        mm17, mm18, mm3, mm5, mm7, feq0, feq1, feq2, feq3, feq4, feq5, feq6, \
+        feq7, feq8, feq9, feq10, feq11, feq12, feq13, feq14, feq15, feq16, \
+        feq17, feq18, nx, ny, nz, mgx, mgy, mgz, tau)
     for (int n = start; n < finish; n++) {
 
         rho0 = Den[n]; //load density
@@ -1511,6 +1530,13 @@ extern "C" void ScaLBL_D3Q19_AAeven_FreeLeeModel(
     //double C,theta;
     //double M = 2.0/9.0*(tauM-0.5);//diffusivity (or mobility) for the phase field D3Q7
 
+    #pragma omp parallel for schedule(static) private(nn, nn2x, ijk, ux, uy, \
+        uz, p, chem, phi, rho0, m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, \
+        m14, m15, m16, m17, m18, m0, m3, m5, m7, mm1, mm2, mm4, mm6, mm8, mm9, \
+        mm10, mm11, mm12, mm13, mm14, mm15, mm16, mm17, mm18, mm3, mm5, mm7, \
+        feq0, feq1, feq2, feq3, feq4, feq5, feq6, feq7, feq8, feq9, feq10, \
+        feq11, feq12, feq13, feq14, feq15, feq16, feq17, feq18, nx, ny, nz, \
+        mgx, mgy, mgz, tau)
     for (int n = start; n < finish; n++) {
 
         rho0 = Den[n]; //load density
@@ -2503,6 +2529,20 @@ extern "C" void ScaLBL_D3Q19_AAodd_FreeLeeModel_Combined(
         (tauM - 0.5); //diffusivity (or mobility) for the phase field D3Q7
     double phi_temp;
 
+    #pragma omp parallel for schedule(static) private(nn, nn2x, ijk, nr1, nr2, \
+        nr3, nr4, nr5, nr6, nr7, nr8, nr9, nr10, nr11, nr12, nr13, nr14, nr15, \
+        nr16, nr17, nr18, ux, uy, uz, p, chem, phi, rho0, m1, m2, m4, m6, m8, \
+        m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m0, m3, m5, m7, feq0, \
+        feq1, feq2, feq3, feq4, feq5, feq6, feq7, feq8, feq9, feq10, feq11, \
+        feq12, feq13, feq14, feq15, feq16, feq17, feq18, nx, ny, nz, mgx, mgy, \
+        mgz, dirGradC1, dirGradC2, dirGradC3, dirGradC4, dirGradC5, dirGradC6, \
+        dirGradC7, dirGradC8, dirGradC9, dirGradC10, dirGradC11, dirGradC12, \
+        dirGradC13, dirGradC14, dirGradC15, dirGradC16, dirGradC17, \
+        dirGradC18, dirGradM1, dirGradM2, dirGradM3, dirGradM4, dirGradM5, \
+        dirGradM6, dirGradM7, dirGradM8, dirGradM9, dirGradM10, dirGradM11, \
+        dirGradM12, dirGradM13, dirGradM14, dirGradM15, dirGradM16, \
+        dirGradM17, dirGradM18, h0, h1, h2, h3, h4, h5, h6, tau, C, theta, \
+        phi_temp)
     for (int n = start; n < finish; n++) {
 
         rho0 = Den[n]; //load density
@@ -3613,6 +3653,18 @@ extern "C" void ScaLBL_D3Q19_AAeven_FreeLeeModel_Combined(
         (tauM - 0.5); //diffusivity (or mobility) for the phase field D3Q7
     double phi_temp;
 
+    #pragma omp parallel for schedule(static) private(nn, nn2x, ijk, ux, uy, \
+        uz, p, chem, phi, rho0, m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, \
+        m14, m15, m16, m17, m18, m0, m3, m5, m7, feq0, feq1, feq2, feq3, feq4, \
+        feq5, feq6, feq7, feq8, feq9, feq10, feq11, feq12, feq13, feq14, \
+        feq15, feq16, feq17, feq18, nx, ny, nz, mgx, mgy, mgz, dirGradC1, \
+        dirGradC2, dirGradC3, dirGradC4, dirGradC5, dirGradC6, dirGradC7, \
+        dirGradC8, dirGradC9, dirGradC10, dirGradC11, dirGradC12, dirGradC13, \
+        dirGradC14, dirGradC15, dirGradC16, dirGradC17, dirGradC18, dirGradM1, \
+        dirGradM2, dirGradM3, dirGradM4, dirGradM5, dirGradM6, dirGradM7, \
+        dirGradM8, dirGradM9, dirGradM10, dirGradM11, dirGradM12, dirGradM13, \
+        dirGradM14, dirGradM15, dirGradM16, dirGradM17, dirGradM18, h0, h1, \
+        h2, h3, h4, h5, h6, tau, C, theta, phi_temp)
     for (int n = start; n < finish; n++) {
 
         rho0 = Den[n]; //load density
@@ -6210,6 +6262,10 @@ extern "C" void ScaLBL_D3Q19_AAodd_FreeLeeModel_SingleFluid_BGK(
     double m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18;
     double m0, m3, m5, m7;
 
+    #pragma omp parallel for schedule(static) private(nr1, nr2, nr3, nr4, nr5, \
+        nr6, nr7, nr8, nr9, nr10, nr11, nr12, nr13, nr14, nr15, nr16, nr17, \
+        nr18, ux, uy, uz, p, m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, \
+        m15, m16, m17, m18, m0, m3, m5, m7)
     for (int n = start; n < finish; n++) {
 
         // q=0
@@ -6642,6 +6698,9 @@ extern "C" void ScaLBL_D3Q19_AAeven_FreeLeeModel_SingleFluid_BGK(
     double m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18;
     double m0, m3, m5, m7;
 
+    #pragma omp parallel for schedule(static) private(ux, uy, uz, p, m1, m2, \
+        m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m0, m3, \
+        m5, m7)
     for (int n = start; n < finish; n++) {
 
         // q=0
@@ -7071,6 +7130,10 @@ extern "C" void ScaLBL_D3Q9_MGTest(int *Map, double *Phi, double *ColorGrad,
     double mgx, mgy, mgz; //mixed gradient reaching secondary neighbor
     double phi;
 
+    #pragma omp parallel for schedule(static) private(nn, nn2x, ijk, m1, m2, \
+        m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m3, m5, \
+        m7, mm1, mm2, mm4, mm6, mm8, mm9, mm10, mm11, mm12, mm13, mm14, mm15, \
+        mm16, mm17, mm18, mm3, mm5, mm7, mgx, mgy, mgz, phi)
     for (int n = start; n < finish; n++) {
 
         // Get the 1D index based on regular data layout
@@ -36,6 +36,10 @@ ScaLBL_D3Q19_AAeven_Greyscale(double *dist, int start, int finish, int Np,
     double Fx, Fy,
         Fz; //The total body force including Brinkman force and user-specified (Gx,Gy,Gz)
 
+    #pragma omp parallel for schedule(static) private(rho, vx, vy, vz, v_mag, \
+        ux, uy, uz, u_mag, pressure, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, \
+        f10, f11, f12, f13, f14, f15, f16, f17, f18, GeoFun, porosity, perm, \
+        c0, c1, Fx, Fy, Fz)
     for (int n = start; n < finish; n++) {
         // q=0
         f0 = dist[n];
@@ -388,6 +392,11 @@ ScaLBL_D3Q19_AAodd_Greyscale(int *neighborList, double *dist, int start,
     double Fx, Fy,
         Fz; //The total body force including Brinkman force and user-specified (Gx,Gy,Gz)
 
+    #pragma omp parallel for schedule(static) private(rho, vx, vy, vz, v_mag, \
+        ux, uy, uz, u_mag, pressure, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, \
+        f10, f11, f12, f13, f14, f15, f16, f17, f18, nr1, nr2, nr3, nr4, nr5, \
+        nr6, nr7, nr8, nr9, nr10, nr11, nr12, nr13, nr14, nr15, nr16, nr17, \
+        nr18, GeoFun, porosity, perm, c0, c1, Fx, Fy, Fz)
     for (int n = start; n < finish; n++) {
 
         // q=0
@@ -795,6 +804,10 @@ extern "C" void ScaLBL_D3Q19_AAeven_Greyscale_IMRT(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(vx, vy, vz, v_mag, ux, \
+        uy, uz, u_mag, pressure, jx, jy, jz, m1, m2, m4, m6, m8, m9, m10, m11, \
+        m12, m13, m14, m15, m16, m17, m18, fq, GeoFun, porosity, perm, c0, c1, \
+        Fx, Fy, Fz)
     for (int n = start; n < finish; n++) {
 
         //........................................................................
@@ -1338,6 +1351,10 @@ extern "C" void ScaLBL_D3Q19_AAodd_Greyscale_IMRT(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(nread, vx, vy, vz, \
+        v_mag, ux, uy, uz, u_mag, pressure, jx, jy, jz, m1, m2, m4, m6, m8, \
+        m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, fq, GeoFun, porosity, \
+        perm, c0, c1, Fx, Fy, Fz)
     for (int n = start; n < finish; n++) {
 
         //........................................................................
@@ -1923,6 +1940,11 @@ extern "C" void ScaLBL_D3Q19_AAodd_Greyscale_MRT(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(nread, nr1, nr2, nr3, \
+        nr4, nr5, nr6, nr7, nr8, nr9, nr10, nr11, nr12, nr13, nr14, vx, vy, \
+        vz, v_mag, ux, uy, uz, u_mag, pressure, rho, jx, jy, jz, m1, m2, m4, \
+        m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, fq, GeoFun, \
+        porosity, perm, c0, c1, Fx, Fy, Fz)
     for (int n = start; n < finish; n++) {
         //........................................................................
         //					READ THE DISTRIBUTIONS
@@ -2496,6 +2518,10 @@ extern "C" void ScaLBL_D3Q19_AAeven_Greyscale_MRT(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(vx, vy, vz, v_mag, ux, \
+        uy, uz, u_mag, pressure, rho, jx, jy, jz, m1, m2, m4, m6, m8, m9, m10, \
+        m11, m12, m13, m14, m15, m16, m17, m18, fq, GeoFun, porosity, perm, \
+        c0, c1, Fx, Fy, Fz)
     for (int n = start; n < finish; n++) {
         //........................................................................
         //					READ THE DISTRIBUTIONS
@@ -48,6 +48,13 @@ extern "C" void ScaLBL_D3Q19_AAodd_GreyscaleColor(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(nn, ijk, nread, nr1, \
+        nr2, nr3, nr4, nr5, nr6, nr7, nr8, nr9, nr10, nr11, nr12, nr13, nr14, \
+        fq, rho, jx, jy, jz, vx, vy, vz, v_mag, ux, uy, uz, u_mag, m1, m2, m4, \
+        m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m3, m5, m7, \
+        nA, nB, a1, b1, a2, b2, nAB, delta, C, nx, ny, nz, phi, tau, rho0, \
+        rlx_setA, rlx_setB, porosity, perm, c0, c1, tau_eff, mu_eff, nx_gs, \
+        ny_gs, nz_gs, Fx, Fy, Fz)
     for (n = start; n < finish; n++) {
         // read the component number densities
         nA = Den[n];
@@ -787,6 +794,12 @@ extern "C" void ScaLBL_D3Q19_AAeven_GreyscaleColor(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(ijk, nn, fq, rho, jx, \
+        jy, jz, vx, vy, vz, v_mag, ux, uy, uz, u_mag, m1, m2, m4, m6, m8, m9, \
+        m10, m11, m12, m13, m14, m15, m16, m17, m18, m3, m5, m7, nA, nB, a1, \
+        b1, a2, b2, nAB, delta, C, nx, ny, nz, phi, tau, rho0, rlx_setA, \
+        rlx_setB, porosity, perm, c0, c1, tau_eff, mu_eff, nx_gs, ny_gs, \
+        nz_gs, Fx, Fy, Fz)
     for (n = start; n < finish; n++) {
 
         // read the component number densities
@@ -1464,6 +1477,14 @@ extern "C" void ScaLBL_D3Q19_AAodd_GreyscaleColor_CP(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(nn, ijk, nread, nr1, \
+        nr2, nr3, nr4, nr5, nr6, nr7, nr8, nr9, nr10, nr11, nr12, nr13, nr14, \
+        fq, rho, jx, jy, jz, ux, uy, uz, m1, m2, m4, m6, m8, m9, m10, m11, \
+        m12, m13, m14, m15, m16, m17, m18, m3, m5, m7, nA, nB, a1, b1, a2, b2, \
+        nAB, delta, C, nx, ny, nz, phi, tau, rho0, rlx_setA, rlx_setB, \
+        porosity, perm, tau_eff, mu_eff, Fx, Fy, Fz, Fcpx, Fcpy, Fcpz, W, \
+        Sn_grey, Sw_grey, Kn_grey, Kw_grey, Swn, Krn_grey, Krw_grey, \
+        mobility_ratio, jA, jB)
     for (n = start; n < finish; n++) {
         // read the component number densities
         nA = Den[n];
@@ -2360,6 +2381,12 @@ extern "C" void ScaLBL_D3Q19_AAeven_GreyscaleColor_CP(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(ijk, nn, fq, rho, jx, \
+        jy, jz, ux, uy, uz, m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, \
+        m15, m16, m17, m18, m3, m5, m7, nA, nB, a1, b1, a2, b2, nAB, delta, C, \
+        nx, ny, nz, phi, tau, rho0, rlx_setA, rlx_setB, W, Sn_grey, Sw_grey, \
+        Kn_grey, Kw_grey, Swn, Krn_grey, Krw_grey, mobility_ratio, jA, jB, \
+        porosity, perm, tau_eff, mu_eff, Fx, Fy, Fz, Fcpx, Fcpy, Fcpz)
     for (n = start; n < finish; n++) {
         // read the component number densities
         nA = Den[n];
@@ -3130,6 +3157,7 @@ extern "C" void ScaLBL_PhaseField_InitFromRestart(double *Den, double *Aq,
     int idx;
     double nA, nB;
 
+    #pragma omp parallel for schedule(static) private(nA, nB)
     for (idx = start; idx < finish; idx++) {
 
         nA = Den[idx];
@@ -146,6 +146,7 @@ extern "C" void ScaLBL_D3Q7_AAodd_IonConcentration(int *neighborList,
                                                    int Np) {
     int n, nread;
     double fq, Ci;
+    #pragma omp parallel for schedule(static) private(nread, fq, Ci)
     for (n = start; n < finish; n++) {
 
         // q=0
@@ -191,6 +192,7 @@ extern "C" void ScaLBL_D3Q7_AAeven_IonConcentration(double *dist, double *Den,
                                                     int Np) {
     int n;
     double fq, Ci;
+    #pragma omp parallel for schedule(static) private(fq, Ci)
     for (n = start; n < finish; n++) {
 
         // q=0
@@ -242,6 +244,10 @@ extern "C" void ScaLBL_D3Q7_AAodd_Ion_v0(int *neighborList, double *dist,
     //double X,Y,Z,factor_x, factor_y, factor_z;
     int nr1, nr2, nr3, nr4, nr5, nr6;
 
+    #pragma omp parallel for schedule(static) private(Ci, ux, uy, uz, uEPx, \
+        uEPy, uEPz, Ex, Ey, Ez, flux_diffusive_x, flux_diffusive_y, \
+        flux_diffusive_z, f0, f1, f2, f3, f4, f5, f6, nr1, nr2, nr3, nr4, nr5, \
+        nr6)
     for (n = start; n < finish; n++) {
 
         //Load data
@@ -352,6 +358,9 @@ extern "C" void ScaLBL_D3Q7_AAeven_Ion_v0(
     double f0, f1, f2, f3, f4, f5, f6;
     //double X,Y,Z, factor_x, factor_y, factor_z;
 
+    #pragma omp parallel for schedule(static) private(Ci, ux, uy, uz, uEPx, \
+        uEPy, uEPz, Ex, Ey, Ez, flux_diffusive_x, flux_diffusive_y, \
+        flux_diffusive_z, f0, f1, f2, f3, f4, f5, f6)
     for (n = start; n < finish; n++) {
 
         //Load data
@@ -434,6 +443,149 @@ extern "C" void ScaLBL_D3Q7_AAeven_Ion_v0(
     }
 }
 
+extern "C" void ScaLBL_D3Q7_AAodd_Ion_Multi(
+    int *neighborList, double *dist, double *Den, double *FluxDiffusive,
+    double *FluxAdvective, double *FluxElectrical, double *Velocity,
+    double *ElectricField, double *IonCoef, int *Species, int Nspecies,
+    double Vt, int start, int finish, int Np) {
+    // Same update as ScaLBL_D3Q7_AAodd_IonConcentration + ScaLBL_D3Q7_AAodd_Ion_v0
+    // for several ion species: the neighbor list, velocity and electric field
+    // are loaded once per site and reused for every species
+    int n, s, ic;
+    double Ci, Di, zi, rlx;
+    double ux, uy, uz;
+    double uEPx, uEPy, uEPz; //electrochemical induced velocity
+    double Ex, Ey, Ez;       //electrical field
+    double f0, f1, f2, f3, f4, f5, f6;
+    int nr1, nr2, nr3, nr4, nr5, nr6;
+    double *fq;
+
+    #pragma omp parallel for schedule(static) private(s, ic, Ci, Di, zi, rlx, \
+        ux, uy, uz, uEPx, uEPy, uEPz, Ex, Ey, Ez, f0, f1, f2, f3, f4, f5, f6, \
+        nr1, nr2, nr3, nr4, nr5, nr6, fq)
+    for (n = start; n < finish; n++) {
+
+        //Load data
+        Ex = ElectricField[n + 0 * Np];
+        Ey = ElectricField[n + 1 * Np];
+        Ez = ElectricField[n + 2 * Np];
+        ux = Velocity[n + 0 * Np];
+        uy = Velocity[n + 1 * Np];
+        uz = Velocity[n + 2 * Np];
+        nr1 = neighborList[n];
+        nr2 = neighborList[n + Np];
+        nr3 = neighborList[n + 2 * Np];
+        nr4 = neighborList[n + 3 * Np];
+        nr5 = neighborList[n + 4 * Np];
+        nr6 = neighborList[n + 5 * Np];
+
+        for (s = 0; s < Nspecies; s++) {
+            ic = Species[s];
+            Di = IonCoef[3 * ic];
+            zi = IonCoef[3 * ic + 1];
+            rlx = IonCoef[3 * ic + 2];
+            uEPx = zi * Di / Vt * Ex;
+            uEPy = zi * Di / Vt * Ey;
+            uEPz = zi * Di / Vt * Ez;
+            fq = &dist[ic * 7 * Np];
+
+            f0 = fq[n];
+            f1 = fq[nr1];
+            f2 = fq[nr2];
+            f3 = fq[nr3];
+            f4 = fq[nr4];
+            f5 = fq[nr5];
+            f6 = fq[nr6];
+            Ci = f0 + f1 + f2 + f3 + f4 + f5 + f6;
+            Den[ic * Np + n] = Ci;
+
+            FluxDiffusive[3 * ic * Np + n + 0 * Np] = (1.0 - 0.5 * rlx) * ((f1 - f2) - ux * Ci);
+            FluxDiffusive[3 * ic * Np + n + 1 * Np] = (1.0 - 0.5 * rlx) * ((f3 - f4) - uy * Ci);
+            FluxDiffusive[3 * ic * Np + n + 2 * Np] = (1.0 - 0.5 * rlx) * ((f5 - f6) - uz * Ci);
+            FluxAdvective[3 * ic * Np + n + 0 * Np] = ux * Ci;
+            FluxAdvective[3 * ic * Np + n + 1 * Np] = uy * Ci;
+            FluxAdvective[3 * ic * Np + n + 2 * Np] = uz * Ci;
+            FluxElectrical[3 * ic * Np + n + 0 * Np] = uEPx * Ci;
+            FluxElectrical[3 * ic * Np + n + 1 * Np] = uEPy * Ci;
+            FluxElectrical[3 * ic * Np + n + 2 * Np] = uEPz * Ci;
+
+            fq[n] = f0 * (1.0 - rlx) + rlx * 0.25 * Ci;
+            fq[nr2] = f1 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 + 4.0 * (ux + uEPx));
+            fq[nr1] = f2 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 - 4.0 * (ux + uEPx));
+            fq[nr4] = f3 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 + 4.0 * (uy + uEPy));
+            fq[nr3] = f4 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 - 4.0 * (uy + uEPy));
+            fq[nr6] = f5 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 + 4.0 * (uz + uEPz));
+            fq[nr5] = f6 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 - 4.0 * (uz + uEPz));
+        }
+    }
+}
+
+extern "C" void ScaLBL_D3Q7_AAeven_Ion_Multi(
+    double *dist, double *Den, double *FluxDiffusive, double *FluxAdvective,
+    double *FluxElectrical, double *Velocity, double *ElectricField,
+    double *IonCoef, int *Species, int Nspecies, double Vt, int start,
+    int finish, int Np) {
+    int n, s, ic;
+    double Ci, Di, zi, rlx;
+    double ux, uy, uz;
+    double uEPx, uEPy, uEPz; //electrochemical induced velocity
+    double Ex, Ey, Ez;       //electrical field
+    double f0, f1, f2, f3, f4, f5, f6;
+    double *fq;
+
+    #pragma omp parallel for schedule(static) private(s, ic, Ci, Di, zi, rlx, \
+        ux, uy, uz, uEPx, uEPy, uEPz, Ex, Ey, Ez, f0, f1, f2, f3, f4, f5, f6, fq)
+    for (n = start; n < finish; n++) {
+
+        //Load data
+        Ex = ElectricField[n + 0 * Np];
+        Ey = ElectricField[n + 1 * Np];
+        Ez = ElectricField[n + 2 * Np];
+        ux = Velocity[n + 0 * Np];
+        uy = Velocity[n + 1 * Np];
+        uz = Velocity[n + 2 * Np];
+
+        for (s = 0; s < Nspecies; s++) {
+            ic = Species[s];
+            Di = IonCoef[3 * ic];
+            zi = IonCoef[3 * ic + 1];
+            rlx = IonCoef[3 * ic + 2];
+            uEPx = zi * Di / Vt * Ex;
+            uEPy = zi * Di / Vt * Ey;
+            uEPz = zi * Di / Vt * Ez;
+            fq = &dist[ic * 7 * Np];
+
+            f0 = fq[n];
+            f1 = fq[2 * Np + n];
+            f2 = fq[1 * Np + n];
+            f3 = fq[4 * Np + n];
+            f4 = fq[3 * Np + n];
+            f5 = fq[6 * Np + n];
+            f6 = fq[5 * Np + n];
+            Ci = f0 + f1 + f2 + f3 + f4 + f5 + f6;
+            Den[ic * Np + n] = Ci;
+
+            FluxDiffusive[3 * ic * Np + n + 0 * Np] = (1.0 - 0.5 * rlx) * ((f1 - f2) - ux * Ci);
+            FluxDiffusive[3 * ic * Np + n + 1 * Np] = (1.0 - 0.5 * rlx) * ((f3 - f4) - uy * Ci);
+            FluxDiffusive[3 * ic * Np + n + 2 * Np] = (1.0 - 0.5 * rlx) * ((f5 - f6) - uz * Ci);
+            FluxAdvective[3 * ic * Np + n + 0 * Np] = ux * Ci;
+            FluxAdvective[3 * ic * Np + n + 1 * Np] = uy * Ci;
+            FluxAdvective[3 * ic * Np + n + 2 * Np] = uz * Ci;
+            FluxElectrical[3 * ic * Np + n + 0 * Np] = uEPx * Ci;
+            FluxElectrical[3 * ic * Np + n + 1 * Np] = uEPy * Ci;
+            FluxElectrical[3 * ic * Np + n + 2 * Np] = uEPz * Ci;
+
+            fq[n] = f0 * (1.0 - rlx) + rlx * 0.25 * Ci;
+            fq[1 * Np + n] = f1 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 + 4.0 * (ux + uEPx));
+            fq[2 * Np + n] = f2 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 - 4.0 * (ux + uEPx));
+            fq[3 * Np + n] = f3 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 + 4.0 * (uy + uEPy));
+            fq[4 * Np + n] = f4 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 - 4.0 * (uy + uEPy));
+            fq[5 * Np + n] = f5 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 + 4.0 * (uz + uEPz));
+            fq[6 * Np + n] = f6 * (1.0 - rlx) + rlx * 0.125 * Ci * (1.0 - 4.0 * (uz + uEPz));
+        }
+    }
+}
+
 extern "C" void ScaLBL_D3Q7_AAodd_Ion(int *neighborList, double *dist,
                                       double *Den, double *FluxDiffusive,
                                       double *FluxAdvective,
@@ -451,6 +603,10 @@ extern "C" void ScaLBL_D3Q7_AAodd_Ion(int *neighborList, double *dist,
     //double X,Y,Z,factor_x, factor_y, factor_z;
     int nr1, nr2, nr3, nr4, nr5, nr6;
 
+    #pragma omp parallel for schedule(static) private(Ci, ux, uy, uz, uEPx, \
+        uEPy, uEPz, Ex, Ey, Ez, flux_diffusive_x, flux_diffusive_y, \
+        flux_diffusive_z, f0, f1, f2, f3, f4, f5, f6, nr1, nr2, nr3, nr4, nr5, \
+        nr6)
     for (n = start; n < finish; n++) {
 
         //Load data
@@ -561,6 +717,9 @@ extern "C" void ScaLBL_D3Q7_AAeven_Ion(
     double f0, f1, f2, f3, f4, f5, f6;
     //double X,Y,Z, factor_x, factor_y, factor_z;
 
+    #pragma omp parallel for schedule(static) private(Ci, ux, uy, uz, uEPx, \
+        uEPy, uEPz, Ex, Ey, Ez, flux_diffusive_x, flux_diffusive_y, \
+        flux_diffusive_z, f0, f1, f2, f3, f4, f5, f6)
     for (n = start; n < finish; n++) {
 
         //Load data
@@ -686,6 +845,7 @@ extern "C" void ScaLBL_D3Q7_Ion_ChargeDensity(double *Den,
     double F =
         96485.0; //Faraday's constant; unit[C/mol]; F=e*Na, where Na is the Avogadro constant
 
+    #pragma omp parallel for schedule(static) private(Ci, CD, CD_tmp)
     for (n = start; n < finish; n++) {
         Ci = Den[n + ion_component * Np];
         CD = ChargeDensity[n];
@@ -14,6 +14,8 @@ extern "C" void ScaLBL_D3Q19_MixedGradient(int *Map, double *Phi,
     int np, np2, nm;       // neighbors
     double v, vp, vp2, vm; // values at neighbors
     double grad;
+    #pragma omp parallel for schedule(static) private(i, j, k, n, np, np2, nm, \
+        v, vp, vp2, vm, grad)
     for (int idx = start; idx < finish; idx++) {
         n = Map[idx]; // layout in regular array
         //.......Back out the 3-D indices for node n..............
@@ -10,6 +10,7 @@ ScaLBL_D3Q7_AAodd_Poisson_ElectricPotential(int *neighborList, int *Map,
     int nread;
     int idx;
 
+    #pragma omp parallel for schedule(static) private(psi, fq, nread, idx)
     for (n = start; n < finish; n++) {
 
         // q=0
@@ -58,6 +59,7 @@ extern "C" void ScaLBL_D3Q7_AAeven_Poisson_ElectricPotential(
     double fq;
     int idx;
 
+    #pragma omp parallel for schedule(static) private(psi, fq, idx)
     for (n = start; n < finish; n++) {
 
         // q=0
@@ -107,6 +109,8 @@ extern "C" void ScaLBL_D3Q7_AAodd_Poisson(int *neighborList, int *Map,
     double rlx = 1.0 / tau;
     int idx;
 
+    #pragma omp parallel for schedule(static) private(psi, Ex, Ey, Ez, rho_e, \
+        f0, f1, f2, f3, f4, f5, f6, nr1, nr2, nr3, nr4, nr5, nr6, idx)
     for (n = start; n < finish; n++) {
 
         //Load data
@@ -187,6 +191,8 @@ extern "C" void ScaLBL_D3Q7_AAeven_Poisson(int *Map, double *dist,
     double rlx = 1.0 / tau;
     int idx;
 
+    #pragma omp parallel for schedule(static) private(psi, Ex, Ey, Ez, rho_e, \
+        f0, f1, f2, f3, f4, f5, f6, idx)
     for (n = start; n < finish; n++) {
 
         //Load data
@@ -241,6 +247,7 @@ extern "C" void ScaLBL_D3Q7_Poisson_Init(int *Map, double *dist, double *Psi,
                                          int start, int finish, int Np) {
     int n;
     int ijk;
+    #pragma omp parallel for schedule(static) private(ijk)
     for (n = start; n < finish; n++) {
         ijk = Map[n];
         dist[0 * Np + n] = 0.25 * Psi[ijk];
@@ -267,6 +274,9 @@ extern "C" void ScaLBL_D3Q7_PoissonResidualError(
     double psi_Laplacian;
     double residual_error;
 
+    #pragma omp parallel for schedule(static) private(nn, ijk, psi, rho_e, m1, \
+        m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m3, \
+        m5, m7, psi_Laplacian, residual_error)
     for (n = start; n < finish; n++) {
 
         //Load data
@@ -501,6 +511,10 @@ ScaLBL_D3Q19_AAodd_Poisson_ElectricPotential(int *neighborList, int *Map,
         nr14, nr15, nr16, nr17, nr18;
     int idx;
 
+    #pragma omp parallel for schedule(static) private(psi, rho_e, f0, f1, f2, \
+        f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, \
+        f18, nr1, nr2, nr3, nr4, nr5, nr6, nr7, nr8, nr9, nr10, nr11, nr12, \
+        nr13, nr14, nr15, nr16, nr17, nr18, idx)
     for (n = start; n < finish; n++) {
         rho_e = (UseSlippingVelBC==1) ? 0.0 : Den_charge[n] / epsilon_LB;
 
@@ -597,6 +611,9 @@ extern "C" void ScaLBL_D3Q19_AAeven_Poisson_ElectricPotential(
     //double Gs;
     int idx;
 
+    #pragma omp parallel for schedule(static) private(psi, rho_e, f0, f1, f2, \
+        f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, \
+        f18, idx)
     for (n = start; n < finish; n++) {
         rho_e = (UseSlippingVelBC==1) ? 0.0 : Den_charge[n] / epsilon_LB;
 
@@ -654,6 +671,10 @@ extern "C" void ScaLBL_D3Q19_AAodd_Poisson(int *neighborList, int *Map,
     double W1 = 1.0/24.0;
     double W2 = 1.0/48.0;
     
+    #pragma omp parallel for schedule(static) private(psi, Ex, Ey, Ez, rho_e, \
+        f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, \
+        f16, f17, f18, nr1, nr2, nr3, nr4, nr5, nr6, nr7, nr8, nr9, nr10, \
+        nr11, nr12, nr13, nr14, nr15, nr16, nr17, nr18, sum_q, idx)
     for (n = start; n < finish; n++) {
 
         //Load data
@@ -743,9 +764,9 @@ extern "C" void ScaLBL_D3Q19_AAodd_Poisson(int *neighborList, int *Map,
          idx = Map[n];
          Psi[idx] = psi;
 
-         Ex = (f1 - f2 + 0.5*(f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14))*4.0; //NOTE the unit of electric field here is V/lu
-         Ey = (f3 - f4 + 0.5*(f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18))*4.0;
-         Ez = (f5 - f6 + 0.5*(f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18))*4.0;
+         Ex = (f1 - f2 + f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14)*4.0; //NOTE the unit of electric field here is V/lu
+         Ey = (f3 - f4 + f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18)*4.0; //factor 4.0 is 1/cs^2 for the weights 1/2, 1/24, 1/48
+         Ez = (f5 - f6 + f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18)*4.0;
          ElectricField[n + 0 * Np] = Ex;
          ElectricField[n + 1 * Np] = Ey;
          ElectricField[n + 2 * Np] = Ez;
@@ -828,6 +849,9 @@ extern "C" void ScaLBL_D3Q19_AAeven_Poisson(int *Map, double *dist,
 	double W1 = 1.0/24.0;
 	double W2 = 1.0/48.0;
 
+	#pragma omp parallel for schedule(static) private(psi, Ex, Ey, Ez, rho_e, f0, \
+	    f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, \
+	    f17, f18, error, sum_q, idx)
 	for (n = start; n < finish; n++) {
 
 		//Load data
@@ -862,9 +886,9 @@ extern "C" void ScaLBL_D3Q19_AAeven_Poisson(int *Map, double *dist,
              4.0; //factor 4.0 is D3Q7 lattice squared speed of sound
         Ez = (f5 - f6) * rlx * 4.0;
 		 */
-		Ex = (f1 - f2 + 0.5*(f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14))*4.0; //NOTE the unit of electric field here is V/lu
-		Ey = (f3 - f4 + 0.5*(f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18))*4.0;
-		Ez = (f5 - f6 + 0.5*(f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18))*4.0;
+		Ex = (f1 - f2 + f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14)*4.0; //NOTE the unit of electric field here is V/lu
+		Ey = (f3 - f4 + f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18)*4.0; //factor 4.0 is 1/cs^2 for the weights 1/2, 1/24, 1/48
+		Ez = (f5 - f6 + f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18)*4.0;
 		ElectricField[n + 0 * Np] = Ex;
 		ElectricField[n + 1 * Np] = Ey;
 		ElectricField[n + 2 * Np] = Ez;
@@ -1010,6 +1034,7 @@ extern "C" void ScaLBL_D3Q19_Poisson_Init(int *Map, double *dist, double *Psi,
 	double W0 = 0.5;
 	double W1 = 1.0/24.0;
 	double W2 = 1.0/48.0;
+	#pragma omp parallel for schedule(static) private(ijk)
 	for (n = start; n < finish; n++) {
 		ijk = Map[n];
 		dist[0 * Np + n] = W0 * Psi[ijk];//3333333333333333* Psi[ijk];
@@ -30,6 +30,9 @@ extern "C" void ScaLBL_D3Q19_AAeven_StokesMRT(
     constexpr double mrt_V11 = 0.01388888888888889;
     constexpr double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(fq, rho, jx, jy, jz, ux, \
+        uy, uz, m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, \
+        m17, m18, rhoE, Ex, Ey, Ez, Fx, Fy, Fz)
     for (int n = start; n < finish; n++) {
 
         //Load data
@@ -504,6 +507,9 @@ extern "C" void ScaLBL_D3Q19_AAodd_StokesMRT(
     constexpr double mrt_V11 = 0.01388888888888889;
     constexpr double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static) private(fq, rho, jx, jy, jz, ux, \
+        uy, uz, m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, \
+        m17, m18, nread, rhoE, Ex, Ey, Ez, Fx, Fy, Fz)
     for (int n = start; n < finish; n++) {
 
         //Load data
@@ -59,6 +59,7 @@ extern "C" void ScaLBL_Gradient_Unpack(double weight, double Cqx, double Cqy,
 
 extern "C" void ScaLBL_DFH_Init(double *Phi, double *Den, double *Aq,
                                 double *Bq, int start, int finish, int Np) {
+    #pragma omp parallel for schedule(static)
     for (int idx = start; idx < finish; idx++) {
         double phi, nA, nB;
         phi = Phi[idx];
@@ -96,18 +97,6 @@ extern "C" void ScaLBL_D3Q19_AAeven_DFH(
     double *Phi, double *Gradient, double *SolidForce, double rhoA, double rhoB,
     double tauA, double tauB, double alpha, double beta, double Fx, double Fy,
     double Fz, int start, int finish, int Np) {
-    double fq;
-    // conserved momemnts
-    double rho, jx, jy, jz;
-    // non-conserved moments
-    double m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18;
-    double nA, nB; // number density
-    double a1, b1, a2, b2, nAB, delta;
-    double C, nx, ny, nz; //color gradient magnitude and direction
-    double ux, uy, uz;
-    double phi, tau, rho0, rlx_setA, rlx_setB;
-    double force_x, force_y, force_z;
-
     const double mrt_V1 = 0.05263157894736842;
     const double mrt_V2 = 0.012531328320802;
     const double mrt_V3 = 0.04761904761904762;
@@ -121,7 +110,19 @@ extern "C" void ScaLBL_D3Q19_AAeven_DFH(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static)
     for (int n = start; n < finish; n++) {
+        double fq;
+        // conserved momemnts
+        double rho, jx, jy, jz;
+        // non-conserved moments
+        double m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18;
+        double nA, nB; // number density
+        double a1, b1, a2, b2, nAB, delta;
+        double C, nx, ny, nz; //color gradient magnitude and direction
+        double ux, uy, uz;
+        double phi, tau, rho0, rlx_setA, rlx_setB;
+        double force_x, force_y, force_z;
 
         // read the component number densities
         nA = Den[n];
@@ -645,23 +646,6 @@ extern "C" void ScaLBL_D3Q19_AAodd_DFH(
     double tauA, double tauB, double alpha, double beta, double Fx, double Fy,
     double Fz, int start, int finish, int Np) {
 
-    int nread;
-    int nr1, nr2, nr3, nr4, nr5, nr6;
-    int nr7, nr8, nr9, nr10;
-    int nr11, nr12, nr13, nr14;
-    //int nr15,nr16,nr17,nr18;
-    double fq;
-    // conserved momemnts
-    double rho, jx, jy, jz;
-    // non-conserved moments
-    double m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18;
-    double nA, nB; // number density
-    double a1, b1, a2, b2, nAB, delta;
-    double C, nx, ny, nz; //color gradient magnitude and direction
-    double ux, uy, uz;
-    double phi, tau, rho0, rlx_setA, rlx_setB;
-    double force_x, force_y, force_z;
-
     const double mrt_V1 = 0.05263157894736842;
     const double mrt_V2 = 0.012531328320802;
     const double mrt_V3 = 0.04761904761904762;
@@ -675,7 +659,24 @@ extern "C" void ScaLBL_D3Q19_AAodd_DFH(
     const double mrt_V11 = 0.01388888888888889;
     const double mrt_V12 = 0.04166666666666666;
 
+    #pragma omp parallel for schedule(static)
     for (int n = start; n < finish; n++) {
+        int nread;
+        int nr1, nr2, nr3, nr4, nr5, nr6;
+        int nr7, nr8, nr9, nr10;
+        int nr11, nr12, nr13, nr14;
+        //int nr15,nr16,nr17,nr18;
+        double fq;
+        // conserved momemnts
+        double rho, jx, jy, jz;
+        // non-conserved moments
+        double m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18;
+        double nA, nB; // number density
+        double a1, b1, a2, b2, nAB, delta;
+        double C, nx, ny, nz; //color gradient magnitude and direction
+        double ux, uy, uz;
+        double phi, tau, rho0, rlx_setA, rlx_setB;
+        double force_x, force_y, force_z;
 
         // read the component number densities
         nA = Den[n];
@@ -1272,6 +1273,7 @@ extern "C" void ScaLBL_D3Q7_AAodd_DFH(int *neighborList, double *Aq, double *Bq,
                                       double *Den, double *Phi, int start,
                                       int finish, int Np) {
 
+    #pragma omp parallel for schedule(static)
     for (int n = start; n < finish; n++) {
         int nread;
         double fq, nA, nB;
@@ -1359,6 +1361,7 @@ extern "C" void ScaLBL_D3Q7_AAodd_DFH(int *neighborList, double *Aq, double *Bq,
 extern "C" void ScaLBL_D3Q7_AAeven_DFH(double *Aq, double *Bq, double *Den,
                                        double *Phi, int start, int finish,
                                        int Np) {
+    #pragma omp parallel for schedule(static)
     for (int n = start; n < finish; n++) {
         double fq, nA, nB;
         // compute number density for component A
@@ -1433,16 +1436,19 @@ extern "C" void ScaLBL_D3Q19_Gradient_DFH(int *neighborList, double *Phi,
                                           double *ColorGrad, int start,
                                           int finish, int Np) {
 
-    int n, nn;
-    // distributions
-    double m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18;
-    double m3, m5, m7;
-    double nx, ny, nz;
+    int n;
 
     // non-conserved moments
     // additional variables needed for computations
 
+    #pragma omp parallel for schedule(static)
     for (n = start; n < finish; n++) {
+        int nn;
+        // distributions
+        double m1, m2, m4, m6, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18;
+        double m3, m5, m7;
+        double nx, ny, nz;
+
         nn = neighborList[n + Np] % Np;
         m1 = Phi[nn];
         nn = neighborList[n] % Np;
@@ -1250,7 +1250,17 @@ __global__  void dvc_ScaLBL_CopySlice_z(double *Phi, int Nx, int Ny, int Nz, int
 }
 
 
-__global__  void dvc_ScaLBL_D3Q19_AAeven_Color(int *Map, double *dist, double *Aq, double *Bq, double *Den, double *Phi,
+// Phase field value of the neighbor in direction q for the compact layout
+//   - neighbors in the fluid are read from the D3Q19 streaming list
+//   - other neighbors (solid or halo) are listed in order in ringIndex
+__device__ inline double dvc_SparsePhi(const int *neighborList, const int *ringIndex,
+		const double *Phi, int q, int n, int Np, int &r){
+	int nn = neighborList[(q-1)*Np+n] - q*Np;
+	if (nn >= 0 && nn < Np) return Phi[nn];
+	return Phi[ringIndex[r++]];
+}
+
+__global__  void dvc_ScaLBL_D3Q19_AAeven_Color(int *neighborList, int *ringOffset, int *ringIndex, int *Map, double *dist, double *Aq, double *Bq, double *Den, double *Phi,
 		double *Velocity, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
 		double Fx, double Fy, double Fz, int strideY, int strideZ, int start, int finish, int Np){
 	int ijk,nn,n;
@@ -1299,65 +1309,89 @@ __global__  void dvc_ScaLBL_D3Q19_AAeven_Color(int *Map, double *dist, double *A
 			rlx_setA = 1.f/tau;
 			rlx_setB = 8.f*(2.f-rlx_setA)/(8.f-rlx_setA);
 
-			// Get the 1D index based on regular data layout
-			ijk = Map[n];
-			//					COMPUTE THE COLOR GRADIENT
-			//........................................................................
-			//.................Read Phase Indicator Values............................
-			//........................................................................
-			nn = ijk-1;							// neighbor index (get convention)
-			m1 = Phi[nn];						// get neighbor for phi - 1
-			//........................................................................
-			nn = ijk+1;							// neighbor index (get convention)
-			m2 = Phi[nn];						// get neighbor for phi - 2
-			//........................................................................
-			nn = ijk-strideY;							// neighbor index (get convention)
-			m3 = Phi[nn];					// get neighbor for phi - 3
-			//........................................................................
-			nn = ijk+strideY;							// neighbor index (get convention)
-			m4 = Phi[nn];					// get neighbor for phi - 4
-			//........................................................................
-			nn = ijk-strideZ;						// neighbor index (get convention)
-			m5 = Phi[nn];					// get neighbor for phi - 5
-			//........................................................................
-			nn = ijk+strideZ;						// neighbor index (get convention)
-			m6 = Phi[nn];					// get neighbor for phi - 6
-			//........................................................................
-			nn = ijk-strideY-1;						// neighbor index (get convention)
-			m7 = Phi[nn];					// get neighbor for phi - 7
-			//........................................................................
-			nn = ijk+strideY+1;						// neighbor index (get convention)
-			m8 = Phi[nn];					// get neighbor for phi - 8
-			//........................................................................
-			nn = ijk+strideY-1;						// neighbor index (get convention)
-			m9 = Phi[nn];					// get neighbor for phi - 9
-			//........................................................................
-			nn = ijk-strideY+1;						// neighbor index (get convention)
-			m10 = Phi[nn];					// get neighbor for phi - 10
-			//........................................................................
-			nn = ijk-strideZ-1;						// neighbor index (get convention)
-			m11 = Phi[nn];					// get neighbor for phi - 11
-			//........................................................................
-			nn = ijk+strideZ+1;						// neighbor index (get convention)
-			m12 = Phi[nn];					// get neighbor for phi - 12
-			//........................................................................
-			nn = ijk+strideZ-1;						// neighbor index (get convention)
-			m13 = Phi[nn];					// get neighbor for phi - 13
-			//........................................................................
-			nn = ijk-strideZ+1;						// neighbor index (get convention)
-			m14 = Phi[nn];					// get neighbor for phi - 14
-			//........................................................................
-			nn = ijk-strideZ-strideY;					// neighbor index (get convention)
-			m15 = Phi[nn];					// get neighbor for phi - 15
-			//........................................................................
-			nn = ijk+strideZ+strideY;					// neighbor index (get convention)
-			m16 = Phi[nn];					// get neighbor for phi - 16
-			//........................................................................
-			nn = ijk+strideZ-strideY;					// neighbor index (get convention)
-			m17 = Phi[nn];					// get neighbor for phi - 17
-			//........................................................................
-			nn = ijk-strideZ+strideY;					// neighbor index (get convention)
-			m18 = Phi[nn];					// get neighbor for phi - 18
+			if (ringOffset != NULL){
+				// Compact phase field (see ScaLBL_D3Q19_AAeven_Color_Sparse)
+				int r = ringOffset[n];
+				m1 = dvc_SparsePhi(neighborList, ringIndex, Phi, 1, n, Np, r);
+				m2 = dvc_SparsePhi(neighborList, ringIndex, Phi, 2, n, Np, r);
+				m3 = dvc_SparsePhi(neighborList, ringIndex, Phi, 3, n, Np, r);
+				m4 = dvc_SparsePhi(neighborList, ringIndex, Phi, 4, n, Np, r);
+				m5 = dvc_SparsePhi(neighborList, ringIndex, Phi, 5, n, Np, r);
+				m6 = dvc_SparsePhi(neighborList, ringIndex, Phi, 6, n, Np, r);
+				m7 = dvc_SparsePhi(neighborList, ringIndex, Phi, 7, n, Np, r);
+				m8 = dvc_SparsePhi(neighborList, ringIndex, Phi, 8, n, Np, r);
+				m9 = dvc_SparsePhi(neighborList, ringIndex, Phi, 9, n, Np, r);
+				m10 = dvc_SparsePhi(neighborList, ringIndex, Phi, 10, n, Np, r);
+				m11 = dvc_SparsePhi(neighborList, ringIndex, Phi, 11, n, Np, r);
+				m12 = dvc_SparsePhi(neighborList, ringIndex, Phi, 12, n, Np, r);
+				m13 = dvc_SparsePhi(neighborList, ringIndex, Phi, 13, n, Np, r);
+				m14 = dvc_SparsePhi(neighborList, ringIndex, Phi, 14, n, Np, r);
+				m15 = dvc_SparsePhi(neighborList, ringIndex, Phi, 15, n, Np, r);
+				m16 = dvc_SparsePhi(neighborList, ringIndex, Phi, 16, n, Np, r);
+				m17 = dvc_SparsePhi(neighborList, ringIndex, Phi, 17, n, Np, r);
+				m18 = dvc_SparsePhi(neighborList, ringIndex, Phi, 18, n, Np, r);
+			}
+			else {
+				// Get the 1D index based on regular data layout
+				ijk = Map[n];
+				//					COMPUTE THE COLOR GRADIENT
+				//........................................................................
+				//.................Read Phase Indicator Values............................
+				//........................................................................
+				nn = ijk-1;							// neighbor index (get convention)
+				m1 = Phi[nn];						// get neighbor for phi - 1
+				//........................................................................
+				nn = ijk+1;							// neighbor index (get convention)
+				m2 = Phi[nn];						// get neighbor for phi - 2
+				//........................................................................
+				nn = ijk-strideY;							// neighbor index (get convention)
+				m3 = Phi[nn];					// get neighbor for phi - 3
+				//........................................................................
+				nn = ijk+strideY;							// neighbor index (get convention)
+				m4 = Phi[nn];					// get neighbor for phi - 4
+				//........................................................................
+				nn = ijk-strideZ;						// neighbor index (get convention)
+				m5 = Phi[nn];					// get neighbor for phi - 5
+				//........................................................................
+				nn = ijk+strideZ;						// neighbor index (get convention)
+				m6 = Phi[nn];					// get neighbor for phi - 6
+				//........................................................................
+				nn = ijk-strideY-1;						// neighbor index (get convention)
+				m7 = Phi[nn];					// get neighbor for phi - 7
+				//........................................................................
+				nn = ijk+strideY+1;						// neighbor index (get convention)
+				m8 = Phi[nn];					// get neighbor for phi - 8
+				//........................................................................
+				nn = ijk+strideY-1;						// neighbor index (get convention)
+				m9 = Phi[nn];					// get neighbor for phi - 9
+				//........................................................................
+				nn = ijk-strideY+1;						// neighbor index (get convention)
+				m10 = Phi[nn];					// get neighbor for phi - 10
+				//........................................................................
+				nn = ijk-strideZ-1;						// neighbor index (get convention)
+				m11 = Phi[nn];					// get neighbor for phi - 11
+				//........................................................................
+				nn = ijk+strideZ+1;						// neighbor index (get convention)
+				m12 = Phi[nn];					// get neighbor for phi - 12
+				//........................................................................
+				nn = ijk+strideZ-1;						// neighbor index (get convention)
+				m13 = Phi[nn];					// get neighbor for phi - 13
+				//........................................................................
+				nn = ijk-strideZ+1;						// neighbor index (get convention)
+				m14 = Phi[nn];					// get neighbor for phi - 14
+				//........................................................................
+				nn = ijk-strideZ-strideY;					// neighbor index (get convention)
+				m15 = Phi[nn];					// get neighbor for phi - 15
+				//........................................................................
+				nn = ijk+strideZ+strideY;					// neighbor index (get convention)
+				m16 = Phi[nn];					// get neighbor for phi - 16
+				//........................................................................
+				nn = ijk+strideZ-strideY;					// neighbor index (get convention)
+				m17 = Phi[nn];					// get neighbor for phi - 17
+				//........................................................................
+				nn = ijk-strideZ+strideY;					// neighbor index (get convention)
+				m18 = Phi[nn];					// get neighbor for phi - 18
+			}
 			//............Compute the Color Gradient...................................
 			nx = -(m1-m2+0.5*(m7-m8+m9-m10+m11-m12+m13-m14));
 			ny = -(m3-m4+0.5*(m7-m8-m9+m10+m15-m16+m17-m18));
@@ -1833,7 +1867,7 @@ __global__  void dvc_ScaLBL_D3Q19_AAeven_Color(int *Map, double *dist, double *A
 }
 
 
-__global__ void dvc_ScaLBL_D3Q19_AAodd_Color(int *neighborList, int *Map, double *dist, double *Aq, double *Bq, double *Den,
+__global__ void dvc_ScaLBL_D3Q19_AAodd_Color(int *neighborList, int *ringOffset, int *ringIndex, int *Map, double *dist, double *Aq, double *Bq, double *Den,
 		 double *Phi, double *Velocity, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
 		double Fx, double Fy, double Fz, int strideY, int strideZ, int start, int finish, int Np){
 
@@ -1886,65 +1920,89 @@ __global__ void dvc_ScaLBL_D3Q19_AAodd_Color(int *neighborList, int *Map, double
 			rlx_setA = 1.f/tau;
 			rlx_setB = 8.f*(2.f-rlx_setA)/(8.f-rlx_setA);
 			
-			// Get the 1D index based on regular data layout
-			ijk = Map[n];
-			//					COMPUTE THE COLOR GRADIENT
-			//........................................................................
-			//.................Read Phase Indicator Values............................
-			//........................................................................
-			nn = ijk-1;							// neighbor index (get convention)
-			m1 = Phi[nn];						// get neighbor for phi - 1
-			//........................................................................
-			nn = ijk+1;							// neighbor index (get convention)
-			m2 = Phi[nn];						// get neighbor for phi - 2
-			//........................................................................
-			nn = ijk-strideY;							// neighbor index (get convention)
-			m3 = Phi[nn];					// get neighbor for phi - 3
-			//........................................................................
-			nn = ijk+strideY;							// neighbor index (get convention)
-			m4 = Phi[nn];					// get neighbor for phi - 4
-			//........................................................................
-			nn = ijk-strideZ;						// neighbor index (get convention)
-			m5 = Phi[nn];					// get neighbor for phi - 5
-			//........................................................................
-			nn = ijk+strideZ;						// neighbor index (get convention)
-			m6 = Phi[nn];					// get neighbor for phi - 6
-			//........................................................................
-			nn = ijk-strideY-1;						// neighbor index (get convention)
-			m7 = Phi[nn];					// get neighbor for phi - 7
-			//........................................................................
-			nn = ijk+strideY+1;						// neighbor index (get convention)
-			m8 = Phi[nn];					// get neighbor for phi - 8
-			//........................................................................
-			nn = ijk+strideY-1;						// neighbor index (get convention)
-			m9 = Phi[nn];					// get neighbor for phi - 9
-			//........................................................................
-			nn = ijk-strideY+1;						// neighbor index (get convention)
-			m10 = Phi[nn];					// get neighbor for phi - 10
-			//........................................................................
-			nn = ijk-strideZ-1;						// neighbor index (get convention)
-			m11 = Phi[nn];					// get neighbor for phi - 11
-			//........................................................................
-			nn = ijk+strideZ+1;						// neighbor index (get convention)
-			m12 = Phi[nn];					// get neighbor for phi - 12
-			//........................................................................
-			nn = ijk+strideZ-1;						// neighbor index (get convention)
-			m13 = Phi[nn];					// get neighbor for phi - 13
-			//........................................................................
-			nn = ijk-strideZ+1;						// neighbor index (get convention)
-			m14 = Phi[nn];					// get neighbor for phi - 14
-			//........................................................................
-			nn = ijk-strideZ-strideY;					// neighbor index (get convention)
-			m15 = Phi[nn];					// get neighbor for phi - 15
-			//........................................................................
-			nn = ijk+strideZ+strideY;					// neighbor index (get convention)
-			m16 = Phi[nn];					// get neighbor for phi - 16
-			//........................................................................
-			nn = ijk+strideZ-strideY;					// neighbor index (get convention)
-			m17 = Phi[nn];					// get neighbor for phi - 17
-			//........................................................................
-			nn = ijk-strideZ+strideY;					// neighbor index (get convention)
-			m18 = Phi[nn];					// get neighbor for phi - 18
+			if (ringOffset != NULL){
+				// Compact phase field (see ScaLBL_D3Q19_AAeven_Color_Sparse)
+				int r = ringOffset[n];
+				m1 = dvc_SparsePhi(neighborList, ringIndex, Phi, 1, n, Np, r);
+				m2 = dvc_SparsePhi(neighborList, ringIndex, Phi, 2, n, Np, r);
+				m3 = dvc_SparsePhi(neighborList, ringIndex, Phi, 3, n, Np, r);
+				m4 = dvc_SparsePhi(neighborList, ringIndex, Phi, 4, n, Np, r);
+				m5 = dvc_SparsePhi(neighborList, ringIndex, Phi, 5, n, Np, r);
+				m6 = dvc_SparsePhi(neighborList, ringIndex, Phi, 6, n, Np, r);
+				m7 = dvc_SparsePhi(neighborList, ringIndex, Phi, 7, n, Np, r);
+				m8 = dvc_SparsePhi(neighborList, ringIndex, Phi, 8, n, Np, r);
+				m9 = dvc_SparsePhi(neighborList, ringIndex, Phi, 9, n, Np, r);
+				m10 = dvc_SparsePhi(neighborList, ringIndex, Phi, 10, n, Np, r);
+				m11 = dvc_SparsePhi(neighborList, ringIndex, Phi, 11, n, Np, r);
+				m12 = dvc_SparsePhi(neighborList, ringIndex, Phi, 12, n, Np, r);
+				m13 = dvc_SparsePhi(neighborList, ringIndex, Phi, 13, n, Np, r);
+				m14 = dvc_SparsePhi(neighborList, ringIndex, Phi, 14, n, Np, r);
+				m15 = dvc_SparsePhi(neighborList, ringIndex, Phi, 15, n, Np, r);
+				m16 = dvc_SparsePhi(neighborList, ringIndex, Phi, 16, n, Np, r);
+				m17 = dvc_SparsePhi(neighborList, ringIndex, Phi, 17, n, Np, r);
+				m18 = dvc_SparsePhi(neighborList, ringIndex, Phi, 18, n, Np, r);
+			}
+			else {
+				// Get the 1D index based on regular data layout
+				ijk = Map[n];
+				//					COMPUTE THE COLOR GRADIENT
+				//........................................................................
+				//.................Read Phase Indicator Values............................
+				//........................................................................
+				nn = ijk-1;							// neighbor index (get convention)
+				m1 = Phi[nn];						// get neighbor for phi - 1
+				//........................................................................
+				nn = ijk+1;							// neighbor index (get convention)
+				m2 = Phi[nn];						// get neighbor for phi - 2
+				//........................................................................
+				nn = ijk-strideY;							// neighbor index (get convention)
+				m3 = Phi[nn];					// get neighbor for phi - 3
+				//........................................................................
+				nn = ijk+strideY;							// neighbor index (get convention)
+				m4 = Phi[nn];					// get neighbor for phi - 4
+				//........................................................................
+				nn = ijk-strideZ;						// neighbor index (get convention)
+				m5 = Phi[nn];					// get neighbor for phi - 5
+				//........................................................................
+				nn = ijk+strideZ;						// neighbor index (get convention)
+				m6 = Phi[nn];					// get neighbor for phi - 6
+				//........................................................................
+				nn = ijk-strideY-1;						// neighbor index (get convention)
+				m7 = Phi[nn];					// get neighbor for phi - 7
+				//........................................................................
+				nn = ijk+strideY+1;						// neighbor index (get convention)
+				m8 = Phi[nn];					// get neighbor for phi - 8
+				//........................................................................
+				nn = ijk+strideY-1;						// neighbor index (get convention)
+				m9 = Phi[nn];					// get neighbor for phi - 9
+				//........................................................................
+				nn = ijk-strideY+1;						// neighbor index (get convention)
+				m10 = Phi[nn];					// get neighbor for phi - 10
+				//........................................................................
+				nn = ijk-strideZ-1;						// neighbor index (get convention)
+				m11 = Phi[nn];					// get neighbor for phi - 11
+				//........................................................................
+				nn = ijk+strideZ+1;						// neighbor index (get convention)
+				m12 = Phi[nn];					// get neighbor for phi - 12
+				//........................................................................
+				nn = ijk+strideZ-1;						// neighbor index (get convention)
+				m13 = Phi[nn];					// get neighbor for phi - 13
+				//........................................................................
+				nn = ijk-strideZ+1;						// neighbor index (get convention)
+				m14 = Phi[nn];					// get neighbor for phi - 14
+				//........................................................................
+				nn = ijk-strideZ-strideY;					// neighbor index (get convention)
+				m15 = Phi[nn];					// get neighbor for phi - 15
+				//........................................................................
+				nn = ijk+strideZ+strideY;					// neighbor index (get convention)
+				m16 = Phi[nn];					// get neighbor for phi - 16
+				//........................................................................
+				nn = ijk+strideZ-strideY;					// neighbor index (get convention)
+				m17 = Phi[nn];					// get neighbor for phi - 17
+				//........................................................................
+				nn = ijk-strideZ+strideY;					// neighbor index (get convention)
+				m18 = Phi[nn];					// get neighbor for phi - 18
+			}
 			//............Compute the Color Gradient...................................
 			nx = -(m1-m2+0.5*(m7-m8+m9-m10+m11-m12+m13-m14));
 			ny = -(m3-m4+0.5*(m7-m8-m9+m10+m15-m16+m17-m18));
@@ -3940,6 +3998,51 @@ __global__ void dvc_ScaLBL_PhaseField_Init(int *Map, double *Phi, double *Den, d
 		}
 	}
 }
+__global__ void dvc_ScaLBL_PhaseField_InitList(int *list, int *Map, double *Phi, double *Den, double *Aq, double *Bq, int count, int Np){
+	int i,idx,n;
+	double phi,nA,nB;
+
+	int S = count/NBLOCKS/NTHREADS + 1;
+	for (int s=0; s<S; s++){
+		//........Get 1-D index for this thread....................
+		i =  S*blockIdx.x*blockDim.x + s*blockDim.x + threadIdx.x;
+		if (i<count) {
+
+			idx = list[i];
+			n = Map[idx];
+			phi = Phi[n];
+            if (phi > 1.f){
+                    nA = 1.0; nB = 0.f;
+            }
+            else if (phi < -1.f){
+                    nB = 1.0; nA = 0.f;
+            }
+            else{
+                    nA=0.5*(phi+1.f);
+                    nB=0.5*(1.f-phi);
+            }
+			Den[idx] = nA;
+			Den[Np+idx] = nB;
+
+			Aq[idx]=0.3333333333333333*nA;
+			Aq[Np+idx]=0.1111111111111111*nA;
+			Aq[2*Np+idx]=0.1111111111111111*nA;
+			Aq[3*Np+idx]=0.1111111111111111*nA;
+			Aq[4*Np+idx]=0.1111111111111111*nA;
+			Aq[5*Np+idx]=0.1111111111111111*nA;
+			Aq[6*Np+idx]=0.1111111111111111*nA;
+
+			Bq[idx]=0.3333333333333333*nB;
+			Bq[Np+idx]=0.1111111111111111*nB;
+			Bq[2*Np+idx]=0.1111111111111111*nB;
+			Bq[3*Np+idx]=0.1111111111111111*nB;
+			Bq[4*Np+idx]=0.1111111111111111*nB;
+			Bq[5*Np+idx]=0.1111111111111111*nB;
+			Bq[6*Np+idx]=0.1111111111111111*nB;
+		}
+	}
+}
+
 
 extern "C" void ScaLBL_SetSlice_z(double *Phi, double value, int Nx, int Ny, int Nz, int Slice){
 	int GRID = Nx*Ny / 512 + 1;
@@ -3998,7 +4101,7 @@ extern "C" void ScaLBL_D3Q19_AAeven_Color(int *Map, double *dist, double *Aq, do
 	cudaProfilerStart();
 	cudaFuncSetCacheConfig(dvc_ScaLBL_D3Q19_AAeven_Color, cudaFuncCachePreferL1);
 
-	dvc_ScaLBL_D3Q19_AAeven_Color<<<NBLOCKS,NTHREADS >>>(Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, 
+	dvc_ScaLBL_D3Q19_AAeven_Color<<<NBLOCKS,NTHREADS >>>(NULL, NULL, NULL, Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB,
 			alpha, beta, Fx, Fy, Fz, strideY, strideZ, start, finish, Np);
 	cudaError_t err = cudaGetLastError();
 	if (cudaSuccess != err){
@@ -4015,7 +4118,7 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(int *d_neighborList, int *Map, double *
 	cudaProfilerStart();
 	cudaFuncSetCacheConfig(dvc_ScaLBL_D3Q19_AAodd_Color, cudaFuncCachePreferL1);
 	
-	dvc_ScaLBL_D3Q19_AAodd_Color<<<NBLOCKS,NTHREADS >>>(d_neighborList, Map, dist, Aq, Bq, Den, Phi, Vel, 
+	dvc_ScaLBL_D3Q19_AAodd_Color<<<NBLOCKS,NTHREADS >>>(d_neighborList, NULL, NULL, Map, dist, Aq, Bq, Den, Phi, Vel,
 			rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, strideY, strideZ, start, finish, Np);
 
 	cudaError_t err = cudaGetLastError();
@@ -4025,6 +4128,30 @@ extern "C" void ScaLBL_D3Q19_AAodd_Color(int *d_neighborList, int *Map, double *
 	cudaProfilerStop();
 }
 
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Sparse(int *neighborList, int *ringOffset, int *ringIndex, double *dist, double *Aq, double *Bq,
+		double *Den, double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int start, int finish, int Np){
+
+	dvc_ScaLBL_D3Q19_AAeven_Color<<<NBLOCKS,NTHREADS >>>(neighborList, ringOffset, ringIndex, NULL, dist, Aq, Bq, Den, Phi, Vel,
+			rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, 0, 0, start, finish, Np);
+	cudaError_t err = cudaGetLastError();
+	if (cudaSuccess != err){
+		printf("CUDA error in ScaLBL_D3Q19_AAeven_Color_Sparse: %s \n",cudaGetErrorString(err));
+	}
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Sparse(int *neighborList, int *ringOffset, int *ringIndex, double *dist, double *Aq, double *Bq,
+		double *Den, double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int start, int finish, int Np){
+
+	dvc_ScaLBL_D3Q19_AAodd_Color<<<NBLOCKS,NTHREADS >>>(neighborList, ringOffset, ringIndex, NULL, dist, Aq, Bq, Den, Phi, Vel,
+			rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, 0, 0, start, finish, Np);
+	cudaError_t err = cudaGetLastError();
+	if (cudaSuccess != err){
+		printf("CUDA error in ScaLBL_D3Q19_AAodd_Color_Sparse: %s \n",cudaGetErrorString(err));
+	}
+}
+
 extern "C" void ScaLBL_D3Q7_AAodd_PhaseField(int *NeighborList, int *Map, double *Aq, double *Bq, 
 		double *Den, double *Phi, int start, int finish, int Np){
 
@@ -4051,6 +4178,26 @@ extern "C" void ScaLBL_D3Q7_AAeven_PhaseField(int *Map, double *Aq, double *Bq,
 
 }
 
+// On the device the fused sweep launches the phase field and collision kernels back to
+// back over [start,finish); the launches are ordered on the default stream
+extern "C" void ScaLBL_D3Q19_AAeven_Color_Fused(int *Map, double *dist, double *Aq, double *Bq, double *Den, double *Phi,
+		double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int span, int start, int finish, int Np){
+
+	ScaLBL_D3Q7_AAeven_PhaseField(Map, Aq, Bq, Den, Phi, start, finish, Np);
+	ScaLBL_D3Q19_AAeven_Color(Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+			Fx, Fy, Fz, strideY, strideZ, start, finish, Np);
+}
+
+extern "C" void ScaLBL_D3Q19_AAodd_Color_Fused(int *d_neighborList, int *Map, double *dist, double *Aq, double *Bq, double *Den, 
+		double *Phi, double *Vel, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
+		double Fx, double Fy, double Fz, int strideY, int strideZ, int span, int start, int finish, int Np){
+
+	ScaLBL_D3Q7_AAodd_PhaseField(d_neighborList, Map, Aq, Bq, Den, Phi, start, finish, Np);
+	ScaLBL_D3Q19_AAodd_Color(d_neighborList, Map, dist, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB, alpha, beta,
+			Fx, Fy, Fz, strideY, strideZ, start, finish, Np);
+}
+
 extern "C" void ScaLBL_D3Q19_Gradient(int *Map, double *Phi, double *ColorGrad, int start, int finish, int Np,
 		int Nx, int Ny, int Nz){
 
@@ -4072,6 +4219,14 @@ extern "C" void ScaLBL_PhaseField_Init(int *Map, double *Phi, double *Den, doubl
 	}
 }
 
+extern "C" void ScaLBL_PhaseField_InitList(int *list, int *Map, double *Phi, double *Den, double *Aq, double *Bq, int count, int Np){
+	dvc_ScaLBL_PhaseField_InitList<<<NBLOCKS,NTHREADS >>>(list, Map, Phi, Den, Aq, Bq, count, Np); 
+	cudaError_t err = cudaGetLastError();
+	if (cudaSuccess != err){
+		printf("CUDA error in ScaLBL_PhaseField_InitList: %s \n",cudaGetErrorString(err));
+	}
+}
+
 extern "C" void ScaLBL_D3Q19_AAeven_ColorMomentum(double *dist, double *Den, double *Vel,
 		double *ColorGrad, double rhoA, double rhoB, double tauA, double tauB, double alpha, double beta,
 		double Fx, double Fy, double Fz, int start, int finish, int Np){
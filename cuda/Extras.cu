@@ -36,6 +36,11 @@ extern "C" void ScaLBL_AllocateDeviceMemory(void** address, size_t size){
 	}	
 }
 
+extern "C" void ScaLBL_AllocateDistributionMemory(void** address, size_t size, int Nq){
+	// device memory has no NUMA placement to manage
+	ScaLBL_AllocateDeviceMemory(address,size);
+}
+
 extern "C" void ScaLBL_FreeDeviceMemory(void* pointer){
        cudaFree(pointer);
 }
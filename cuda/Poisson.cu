@@ -428,9 +428,9 @@ __global__  void dvc_ScaLBL_D3Q19_AAodd_Poisson(int *neighborList, int *Map,
 			idx = Map[n];
 			Psi[idx] = psi;
 
-			Ex = (f1 - f2 + 0.5*(f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14))*4.0; //NOTE the unit of electric field here is V/lu
-			Ey = (f3 - f4 + 0.5*(f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18))*4.0;
-			Ez = (f5 - f6 + 0.5*(f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18))*4.0;
+			Ex = (f1 - f2 + f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14)*4.0; //NOTE the unit of electric field here is V/lu
+			Ey = (f3 - f4 + f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18)*4.0; //factor 4.0 is 1/cs^2 for the weights 1/2, 1/24, 1/48
+			Ez = (f5 - f6 + f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18)*4.0;
 			ElectricField[n + 0 * Np] = Ex;
 			ElectricField[n + 1 * Np] = Ey;
 			ElectricField[n + 2 * Np] = Ez;
@@ -551,9 +551,9 @@ __global__  void dvc_ScaLBL_D3Q19_AAeven_Poisson(int *Map, double *dist,
 	             4.0; //factor 4.0 is D3Q7 lattice squared speed of sound
 	        Ez = (f5 - f6) * rlx * 4.0;
 			 */
-			Ex = (f1 - f2 + 0.5*(f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14))*4.0; //NOTE the unit of electric field here is V/lu
-			Ey = (f3 - f4 + 0.5*(f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18))*4.0;
-			Ez = (f5 - f6 + 0.5*(f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18))*4.0;
+			Ex = (f1 - f2 + f7 - f8 + f9 - f10 + f11 - f12 + f13 - f14)*4.0; //NOTE the unit of electric field here is V/lu
+			Ey = (f3 - f4 + f7 - f8 - f9 + f10 + f15 - f16 + f17 - f18)*4.0; //factor 4.0 is 1/cs^2 for the weights 1/2, 1/24, 1/48
+			Ez = (f5 - f6 + f11 - f12 - f13 + f14 + f15 - f16 - f17 + f18)*4.0;
 			ElectricField[n + 0 * Np] = Ex;
 			ElectricField[n + 1 * Np] = Ey;
 			ElectricField[n + 2 * Np] = Ez;
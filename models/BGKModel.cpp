@@ -197,6 +197,10 @@ void ScaLBL_BGKModel::Create() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // timing = true writes the time spent in each phase to timing.csv / timing.json
+    Timer = std::make_shared<PhaseTimer>(comm);
+    Timer->enable(mrt_db->getWithDefault<bool>("timing", false));
+    ScaLBL_Comm->SetTimer(Timer);
 
     int Npad = (Np / 16 + 2) * 16;
     if (rank == 0)
@@ -218,8 +222,8 @@ void ScaLBL_BGKModel::Create() {
     int dist_mem_size = Np * sizeof(double);
     int neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
-    ScaLBL_AllocateDeviceMemory((void **)&fq, 19 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
+    ScaLBL_AllocateDistributionMemory((void **)&fq, 19 * dist_mem_size, 19);
     ScaLBL_AllocateDeviceMemory((void **)&Pressure, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Velocity, 3 * sizeof(double) * Np);
     //...........................................................................
@@ -230,7 +234,8 @@ void ScaLBL_BGKModel::Create() {
     ScaLBL_CopyToDevice(NeighborList, neighborList, neighborSize);
     comm.barrier();
     double MLUPS = ScaLBL_Comm->GetPerformance(NeighborList, fq, Np);
-    printf("  MLPUS=%f from rank %i\n", MLUPS, rank);
+    printf("  MLPUS=%f from rank %i (%s layout)\n", MLUPS, rank,
+           ScaLBL_Comm->LayoutOrdering.c_str());
 }
 
 void ScaLBL_BGKModel::Initialize() {
@@ -291,10 +296,13 @@ void ScaLBL_BGKModel::Run() {
       */					  
         timestep++;
         ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAodd_BGK(NeighborList, fq, ScaLBL_Comm->FirstInterior(),
                                ScaLBL_Comm->LastInterior(), Np, rlx, Fx, Fy, Fz);
+        Timer->stop();
         ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
         // Set boundary conditions
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
             ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
@@ -306,16 +314,22 @@ void ScaLBL_BGKModel::Run() {
             ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
             ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
         }
+        Timer->stop();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAodd_BGK(NeighborList, fq, 0, ScaLBL_Comm->LastExterior(),
                                Np, rlx, Fx, Fy, Fz);
+        Timer->stop();
         ScaLBL_DeviceBarrier();
         comm.barrier();
         timestep++;
         ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAeven_BGK(fq, ScaLBL_Comm->FirstInterior(),
                                 ScaLBL_Comm->LastInterior(), Np, rlx, Fx, Fy, Fz);
+        Timer->stop();
         ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
         // Set boundary conditions
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
             ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
@@ -327,13 +341,17 @@ void ScaLBL_BGKModel::Run() {
             ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
             ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
         }
+        Timer->stop();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAeven_BGK(fq, 0, ScaLBL_Comm->LastExterior(), Np,
                                 rlx, Fx, Fy, Fz);
+        Timer->stop();
         ScaLBL_DeviceBarrier();
         comm.barrier();
         //************************************************************************/
 
         if (timestep % ANALYSIS_INTERVAL == 0) {
+            Timer->start(PhaseTimer::ANALYSIS);
             ScaLBL_D3Q19_Momentum(fq, Velocity, Np);
             ScaLBL_DeviceBarrier();
             comm.barrier();
@@ -409,6 +427,8 @@ void ScaLBL_BGKModel::Run() {
                         h * Hs, Xs, vax, vay, vaz, absperm);
                 fclose(log_file);
             }
+            Timer->stop();
+            Timer->write(timestep);
         }
     }
     //************************************************************************/
@@ -62,6 +62,7 @@ public:
     std::shared_ptr<Domain> Dm;   // this domain is for analysis
     std::shared_ptr<Domain> Mask; // this domain is for lbm
     std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm;
+    std::shared_ptr<PhaseTimer> Timer;
     // input database
     std::shared_ptr<Database> db;
     std::shared_ptr<Database> domain_db;
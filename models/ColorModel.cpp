@@ -21,8 +21,10 @@ color lattice boltzmann model
 #include "models/ColorModel.h"
 #include "analysis/distance.h"
 #include "analysis/morphology.h"
+#include "analysis/SteadyState.h"
 #include "common/Communication.h"
 #include "common/ReadMicroCT.h"
+#include "IO/RestartFile.h"
 #include <stdlib.h>
 #include <time.h>
 
@@ -34,9 +36,15 @@ ScaLBL_ColorModel::ScaLBL_ColorModel(int RANK, int NP,
       Nx(0), Ny(0), Nz(0), N(0), Np(0), nprocx(0), nprocy(0), nprocz(0),
       BoundaryCondition(0), Lx(0), Ly(0), Lz(0), id(nullptr),
       NeighborList(nullptr), dvcMap(nullptr), fq(nullptr), Aq(nullptr),
-      Bq(nullptr), Den(nullptr), Phi(nullptr), ColorGrad(nullptr),
+      Bq(nullptr), fq_float(nullptr), Aq_float(nullptr), Bq_float(nullptr),
+      Den(nullptr), Phi(nullptr), NPhi(0), dvcPhiMap(nullptr),
+      dvcRingOffset(nullptr), dvcRingIndex(nullptr), ColorGrad(nullptr),
       Velocity(nullptr), Pressure(nullptr), comm(COMM) {
     REVERSE_FLOW_DIRECTION = false;
+    SinglePrecision = false;
+    FusedKernels = false;
+    AggregateHalo = false;
+    SparsePhi = false;
 }
 ScaLBL_ColorModel::~ScaLBL_ColorModel() {
     delete[] id;
@@ -45,8 +53,16 @@ ScaLBL_ColorModel::~ScaLBL_ColorModel() {
     ScaLBL_FreeDeviceMemory(fq);
     ScaLBL_FreeDeviceMemory(Aq);
     ScaLBL_FreeDeviceMemory(Bq);
+    ScaLBL_FreeDeviceMemory(fq_float);
+    ScaLBL_FreeDeviceMemory(Aq_float);
+    ScaLBL_FreeDeviceMemory(Bq_float);
     ScaLBL_FreeDeviceMemory(Den);
     ScaLBL_FreeDeviceMemory(Phi);
+    if (SparsePhi) {
+        ScaLBL_FreeDeviceMemory(dvcPhiMap);
+        ScaLBL_FreeDeviceMemory(dvcRingOffset);
+        ScaLBL_FreeDeviceMemory(dvcRingIndex);
+    }
     ScaLBL_FreeDeviceMemory(Pressure);
     ScaLBL_FreeDeviceMemory(Velocity);
     ScaLBL_FreeDeviceMemory(ColorGrad);
@@ -55,7 +71,11 @@ ScaLBL_ColorModel::~ScaLBL_ColorModel() {
 
 void ScaLBL_ColorModel::ReadParams(string filename) {
     // read the input database
-    db = std::make_shared<Database>(filename);
+    ReadParams(std::make_shared<Database>(filename));
+}
+
+void ScaLBL_ColorModel::ReadParams(std::shared_ptr<Database> db0) {
+    db = db0;
     domain_db = db->getDatabase("Domain");
     color_db = db->getDatabase("Color");
     analysis_db = db->getDatabase("Analysis");
@@ -111,6 +131,38 @@ void ScaLBL_ColorModel::ReadParams(string filename) {
     if (color_db->keyExists("flux")) {
         flux = color_db->getScalar<double>("flux");
     }
+    // precision used to store the distributions ("double" or "single")
+    auto precision =
+        color_db->getWithDefault<std::string>("precision", "double");
+    if (precision == "single")
+        SinglePrecision = true;
+    else if (precision != "double")
+        ERROR("Error: unknown Color precision " + precision + " \n");
+#ifndef SCALBL_FLOAT_STORAGE
+    if (SinglePrecision)
+        ERROR("Error: precision = single is only implemented for the cpu "
+              "backend \n");
+#endif
+    // fused_kernels = true computes the phase field inside the collision sweep
+    if (color_db->keyExists("fused_kernels")) {
+        FusedKernels = color_db->getScalar<bool>("fused_kernels");
+    }
+    // aggregate_halo = true exchanges Aq, Bq and fq with one message per neighbor
+    if (color_db->keyExists("aggregate_halo")) {
+        AggregateHalo = color_db->getScalar<bool>("aggregate_halo");
+    }
+    // the aggregated halo packs the registered buffers as double
+    if (SinglePrecision && AggregateHalo) {
+        ERROR("Error: precision = single cannot be combined with "
+              "aggregate_halo \n");
+    }
+    // sparse_phi = true stores the phase field only near the fluid
+    if (color_db->keyExists("sparse_phi")) {
+        SparsePhi = color_db->getScalar<bool>("sparse_phi");
+    }
+    if (SparsePhi && FusedKernels) {
+        ERROR("Error: sparse_phi cannot be combined with fused_kernels \n");
+    }
     inletA = 1.f;
     inletB = 0.f;
     outletA = 0.f;
@@ -191,6 +243,13 @@ void ScaLBL_ColorModel::ReadParams(string filename) {
         }
         domain_db->putScalar<int>("BC", BoundaryCondition);
     }
+    // the flow adaptor edits fq, Aq and Bq on the host as double
+    if (SinglePrecision &&
+        (protocol == "fractional flow" || protocol == "seed water" ||
+         protocol == "shell aggregation" || protocol == "image sequence")) {
+        ERROR("Error: precision = single is not supported by protocol " +
+              protocol + " \n");
+    }
 }
 
 
@@ -223,13 +282,17 @@ void ScaLBL_ColorModel::SetDomain() {
     nprocz = Dm->nprocz();
 }
 
-void ScaLBL_ColorModel::ReadInput() {
+void ScaLBL_ColorModel::ReadInput(const signed char *labels) {
 
     sprintf(LocalRankString, "%05d", rank);
     sprintf(LocalRankFilename, "%s%s", "ID.", LocalRankString);
     sprintf(LocalRestartFile, "%s%s", "Restart.", LocalRankString);
 
-    if (color_db->keyExists("image_sequence")) {
+    if (labels != nullptr) {
+        // labels were already decomposed for this domain
+        for (int i = 0; i < Nx * Ny * Nz; i++)
+            Mask->id[i] = labels[i];
+    } else if (color_db->keyExists("image_sequence")) {
         auto ImageList = color_db->getVector<std::string>("image_sequence");
         int IMAGE_INDEX = color_db->getWithDefault<int>("image_index", 0);
         std::string first_image = ImageList[IMAGE_INDEX];
@@ -237,7 +300,7 @@ void ScaLBL_ColorModel::ReadInput() {
         IMAGE_INDEX++;
     } else if (domain_db->keyExists("GridFile")) {
         // Read the local domain data
-        auto input_id = readMicroCT(*domain_db, MPI_COMM_WORLD);
+        auto input_id = readMicroCT(*domain_db, comm);
         // Fill the halo (assuming GCW of 1)
         array<int, 3> size0 = {(int)input_id.size(0), (int)input_id.size(1),
                                (int)input_id.size(2)};
@@ -245,7 +308,7 @@ void ScaLBL_ColorModel::ReadInput() {
                            (size_t)Mask->Nz};
         ASSERT((int)size1[0] == size0[0] + 2 && (int)size1[1] == size0[1] + 2 &&
                (int)size1[2] == size0[2] + 2);
-        fillHalo<signed char> fill(MPI_COMM_WORLD, Mask->rank_info, size0,
+        fillHalo<signed char> fill(comm, Mask->rank_info, size0,
                                    {1, 1, 1}, 0, 1);
         Array<signed char> id_view;
         id_view.viewRaw(size1, Mask->id.data());
@@ -415,8 +478,16 @@ void ScaLBL_ColorModel::Create() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // barrier_free = false restores the global barriers in the time loop
+    ScaLBL_Comm->BarrierFree =
+        color_db->getWithDefault<bool>("barrier_free", true);
     ScaLBL_Comm_Regular =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    Timer = std::make_shared<PhaseTimer>(comm);
+    // timing = true writes the time spent in each phase to timing.csv / timing.json
+    Timer->enable(color_db->getWithDefault<bool>("timing", false));
+    ScaLBL_Comm->SetTimer(Timer);
+    ScaLBL_Comm_Regular->SetTimer(Timer);
 
     int Npad = (Np / 16 + 2) * 16;
     if (rank == 0)
@@ -438,16 +509,33 @@ void ScaLBL_ColorModel::Create() {
     dist_mem_size = Np * sizeof(double);
     neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
     ScaLBL_AllocateDeviceMemory((void **)&dvcMap, sizeof(int) * Np);
-    ScaLBL_AllocateDeviceMemory((void **)&fq, 19 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Aq, 7 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Bq, 7 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Den, 2 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Phi, sizeof(double) * Nx * Ny * Nz);
+    if (SinglePrecision) {
+        size_t float_mem_size = Np * sizeof(float);
+        ScaLBL_AllocateDistributionMemory((void **)&fq_float,
+                                          19 * float_mem_size, 19);
+        ScaLBL_AllocateDistributionMemory((void **)&Aq_float,
+                                          7 * float_mem_size, 7);
+        ScaLBL_AllocateDistributionMemory((void **)&Bq_float,
+                                          7 * float_mem_size, 7);
+    } else {
+        ScaLBL_AllocateDistributionMemory((void **)&fq, 19 * dist_mem_size,
+                                          19);
+        ScaLBL_AllocateDistributionMemory((void **)&Aq, 7 * dist_mem_size, 7);
+        ScaLBL_AllocateDistributionMemory((void **)&Bq, 7 * dist_mem_size, 7);
+    }
+    ScaLBL_AllocateDistributionMemory((void **)&Den, 2 * dist_mem_size, 2);
+    SetupPhaseLayout();
+    ScaLBL_AllocateDeviceMemory((void **)&Phi, sizeof(double) * NPhi);
     ScaLBL_AllocateDeviceMemory((void **)&Pressure, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Velocity, 3 * sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&ColorGrad, 3 * sizeof(double) * Np);
+    if (AggregateHalo) {
+        ScaLBL_Comm->RegisterHaloAA(ScaLBL_Communicator::HALO_D3Q7, Aq);
+        ScaLBL_Comm->RegisterHaloAA(ScaLBL_Communicator::HALO_D3Q7, Bq);
+        ScaLBL_Comm->RegisterHaloAA(ScaLBL_Communicator::HALO_D3Q19, fq);
+    }
     //...........................................................................
     // Update GPU data structures
     if (rank == 0)
@@ -497,7 +585,7 @@ void ScaLBL_ColorModel::Create() {
     AssignComponentLabels(PhaseLabel);
     ScaLBL_Comm->Barrier();
 
-    ScaLBL_CopyToDevice(Phi, PhaseLabel, Nx*Ny*Nz * sizeof(double));
+    CopyPhaseToDevice(PhaseLabel);
     ScaLBL_Comm->Barrier();
 
     if (rank == 0)
@@ -505,6 +593,84 @@ void ScaLBL_ColorModel::Create() {
     delete[] PhaseLabel;
 }
 
+void ScaLBL_ColorModel::SetupPhaseLayout() {
+    PhiMap.resize(Nx, Ny, Nz);
+    if (!SparsePhi) {
+        for (int n = 0; n < N; n++)
+            PhiMap(n) = n;
+        NPhi = N;
+        dvcPhiMap = dvcMap;
+        return;
+    }
+    // fluid sites followed by the solid and halo sites next to the fluid
+    std::vector<int> ringOffset, ringIndex;
+    NPhi = ScaLBL_Comm_Regular->SparseLayout(Map, Np, PhiMap, ringOffset,
+                                             ringIndex);
+
+    auto *TmpMap = new int[Np];
+    for (int n = 0; n < Np; n++)
+        TmpMap[n] = n;
+    ScaLBL_AllocateDeviceMemory((void **)&dvcPhiMap, sizeof(int) * Np);
+    ScaLBL_CopyToDevice(dvcPhiMap, TmpMap, sizeof(int) * Np);
+    delete[] TmpMap;
+    ScaLBL_AllocateDeviceMemory((void **)&dvcRingOffset,
+                                sizeof(int) * (Np + 1));
+    ScaLBL_CopyToDevice(dvcRingOffset, ringOffset.data(),
+                        sizeof(int) * (Np + 1));
+    ScaLBL_AllocateDeviceMemory((void **)&dvcRingIndex,
+                                sizeof(int) * (ringIndex.size() + 1));
+    ScaLBL_CopyToDevice(dvcRingIndex, ringIndex.data(),
+                        sizeof(int) * ringIndex.size());
+    ScaLBL_Comm->Barrier();
+
+    double ratio = comm.sumReduce(double(NPhi)) /
+                   comm.sumReduce(double(N));
+    if (rank == 0)
+        printf("Sparse phase field: %0.3f of the regular layout \n", ratio);
+}
+
+void ScaLBL_ColorModel::CopyPhaseToHost(double *phase) {
+    if (!SparsePhi) {
+        ScaLBL_CopyToHost(phase, Phi, N * sizeof(double));
+        return;
+    }
+    std::vector<double> TmpPhi(NPhi);
+    ScaLBL_CopyToHost(TmpPhi.data(), Phi, NPhi * sizeof(double));
+    for (int n = 0; n < N; n++) {
+        int idx = PhiMap(n);
+        phase[n] = idx < 0 ? 0.0 : TmpPhi[idx];
+    }
+}
+
+void ScaLBL_ColorModel::CopyPhaseToDevice(const double *phase) {
+    if (!SparsePhi) {
+        ScaLBL_CopyToDevice(Phi, phase, N * sizeof(double));
+        return;
+    }
+    std::vector<double> TmpPhi(NPhi, 0.0);
+    for (int n = 0; n < N; n++) {
+        int idx = PhiMap(n);
+        if (!(idx < 0))
+            TmpPhi[idx] = phase[n];
+    }
+    ScaLBL_CopyToDevice(Phi, TmpPhi.data(), NPhi * sizeof(double));
+}
+
+void ScaLBL_ColorModel::SetPhaseSlice_z(double value, int slice) {
+    if (!SparsePhi) {
+        ScaLBL_SetSlice_z(Phi, value, Nx, Ny, Nz, slice);
+        return;
+    }
+    DoubleArray phase(Nx, Ny, Nz);
+    CopyPhaseToHost(phase.data());
+    for (int j = 0; j < Ny; j++) {
+        for (int i = 0; i < Nx; i++) {
+            phase(i, j, slice) = value;
+        }
+    }
+    CopyPhaseToDevice(phase.data());
+}
+
 /********************************************************
  * AssignComponentLabels                                 *
  ********************************************************/
@@ -530,7 +696,12 @@ void ScaLBL_ColorModel::Initialize() {
 
     if (rank == 0)
         printf("Initializing distributions \n");
-    ScaLBL_D3Q19_Init(fq, Np);
+#ifdef SCALBL_FLOAT_STORAGE
+    if (SinglePrecision)
+        ScaLBL_D3Q19_Init(fq_float, Np);
+    else
+#endif
+        ScaLBL_D3Q19_Init(fq, Np);
     /*
      * This function initializes model
      */
@@ -548,25 +719,44 @@ void ScaLBL_ColorModel::Initialize() {
         cDen = new double[2 * Np];
         cDist = new double[19 * Np];
         ScaLBL_CopyToHost(TmpMap, dvcMap, Np * sizeof(int));
-        ScaLBL_CopyToHost(cPhi, Phi, N * sizeof(double));
+        CopyPhaseToHost(cPhi);
 
-        ifstream File(LocalRestartFile, ios::binary);
         int idx;
         double value, va, vb;
-        for (int n = 0; n < Np; n++) {
-            File.read((char *)&va, sizeof(va));
-            File.read((char *)&vb, sizeof(vb));
-            cDen[n] = va;
-            cDen[Np + n] = vb;
-        }
-        for (int n = 0; n < Np; n++) {
-            // Read the distributions
-            for (int q = 0; q < 19; q++) {
-                File.read((char *)&value, sizeof(value));
-                cDist[q * Np + n] = value;
+        int restart_writers =
+            analysis_db->getWithDefault<int>("restart_writers", 0);
+        auto restart_file =
+            analysis_db->getWithDefault<std::string>("restart_file", "Restart");
+        if (analysis_db->getWithDefault<bool>("restart_global", false)) {
+            // Read the local block of the global restart file
+            IO::readGlobalRestart(restart_file + ".global", Map,
+                                  Mask->rank_info, Np, {cDen, cDist}, {2, 19});
+        } else if (restart_writers > 0) {
+            // Read the aggregated restart file
+            IO::readRestart(restart_file, rank, Np,
+                            IO::layoutHash(Map.data(), Map.length()),
+                            {cDen, cDist}, {2, 19});
+        } else if (IO::isCompressedRestart(LocalRestartFile)) {
+            // Read the compressed restart file
+            IO::readCompressedRestart(LocalRestartFile, Np, {cDen, cDist},
+                                      {2, 19});
+        } else {
+            ifstream File(LocalRestartFile, ios::binary);
+            for (int n = 0; n < Np; n++) {
+                File.read((char *)&va, sizeof(va));
+                File.read((char *)&vb, sizeof(vb));
+                cDen[n] = va;
+                cDen[Np + n] = vb;
+            }
+            for (int n = 0; n < Np; n++) {
+                // Read the distributions
+                for (int q = 0; q < 19; q++) {
+                    File.read((char *)&value, sizeof(value));
+                    cDist[q * Np + n] = value;
+                }
             }
+            File.close();
         }
-        File.close();
 
         for (int n = 0; n < ScaLBL_Comm->LastExterior(); n++) {
             va = cDen[n];
@@ -588,8 +778,13 @@ void ScaLBL_ColorModel::Initialize() {
 
         // Copy the restart data to the GPU
         ScaLBL_CopyToDevice(Den, cDen, 2 * Np * sizeof(double));
-        ScaLBL_CopyToDevice(fq, cDist, 19 * Np * sizeof(double));
-        ScaLBL_CopyToDevice(Phi, cPhi, N * sizeof(double));
+#ifdef SCALBL_FLOAT_STORAGE
+        if (SinglePrecision)
+            ScaLBL_D3Q19_CopyToDevice(fq_float, cDist, Np);
+        else
+#endif
+            ScaLBL_D3Q19_CopyToDevice(fq, cDist, Np);
+        CopyPhaseToDevice(cPhi);
         ScaLBL_Comm->Barrier();
 
         comm.barrier();
@@ -597,27 +792,242 @@ void ScaLBL_ColorModel::Initialize() {
 
     if (rank == 0)
         printf("Initializing phase field \n");
-    ScaLBL_PhaseField_Init(dvcMap, Phi, Den, Aq, Bq, 0,
-                           ScaLBL_Comm->LastExterior(), Np);
-    ScaLBL_PhaseField_Init(dvcMap, Phi, Den, Aq, Bq,
-                           ScaLBL_Comm->FirstInterior(),
-                           ScaLBL_Comm->LastInterior(), Np);
+#ifdef SCALBL_FLOAT_STORAGE
+    if (SinglePrecision) {
+        ScaLBL_PhaseField_Init(dvcPhiMap, Phi, Den, Aq_float, Bq_float, 0,
+                               ScaLBL_Comm->LastExterior(), Np);
+        ScaLBL_PhaseField_Init(dvcPhiMap, Phi, Den, Aq_float, Bq_float,
+                               ScaLBL_Comm->FirstInterior(),
+                               ScaLBL_Comm->LastInterior(), Np);
+    } else
+#endif
+    {
+        ScaLBL_PhaseField_Init(dvcPhiMap, Phi, Den, Aq, Bq, 0,
+                               ScaLBL_Comm->LastExterior(), Np);
+        ScaLBL_PhaseField_Init(dvcPhiMap, Phi, Den, Aq, Bq,
+                               ScaLBL_Comm->FirstInterior(),
+                               ScaLBL_Comm->LastInterior(), Np);
+    }
 
     // establish reservoirs for external bC
     if (BoundaryCondition == 1 || BoundaryCondition == 2 ||
         BoundaryCondition == 3 || BoundaryCondition == 4) {
         if (Dm->kproc() == 0) {
-            ScaLBL_SetSlice_z(Phi, 1.0, Nx, Ny, Nz, 0);
-            ScaLBL_SetSlice_z(Phi, 1.0, Nx, Ny, Nz, 1);
-            ScaLBL_SetSlice_z(Phi, 1.0, Nx, Ny, Nz, 2);
+            SetPhaseSlice_z(1.0, 0);
+            SetPhaseSlice_z(1.0, 1);
+            SetPhaseSlice_z(1.0, 2);
         }
         if (Dm->kproc() == nprocz - 1) {
-            ScaLBL_SetSlice_z(Phi, -1.0, Nx, Ny, Nz, Nz - 1);
-            ScaLBL_SetSlice_z(Phi, -1.0, Nx, Ny, Nz, Nz - 2);
-            ScaLBL_SetSlice_z(Phi, -1.0, Nx, Ny, Nz, Nz - 3);
+            SetPhaseSlice_z(-1.0, Nz - 1);
+            SetPhaseSlice_z(-1.0, Nz - 2);
+            SetPhaseSlice_z(-1.0, Nz - 3);
         }
     }
-    ScaLBL_CopyToHost(Averages->Phi.data(), Phi, N * sizeof(double));
+    CopyPhaseToHost(Averages->Phi.data());
+}
+
+/* log the outcome of the steady-state tests for a relative permeability point */
+static void WriteSteadyState(const SteadyState &Steady, bool detected,
+                             int timesteps, double saturation, int rank) {
+    std::string reason = Steady.reason();
+    if (!detected)
+        reason = "max_steady_timesteps reached, " + reason;
+    if (rank == 0) {
+        printf("   Steady state: %s \n", reason.c_str());
+        bool WriteHeader = false;
+        FILE *steady_log_file = fopen("steady.csv", "r");
+        if (steady_log_file != NULL)
+            fclose(steady_log_file);
+        else
+            WriteHeader = true;
+        steady_log_file = fopen("steady.csv", "a");
+        if (WriteHeader) {
+            fprintf(steady_log_file, "timesteps sat.water ");
+            for (auto &name : Steady.names)
+                fprintf(steady_log_file, "drift.%s ci.%s ", name.c_str(),
+                        name.c_str());
+            fprintf(steady_log_file, "steady reason\n");
+        }
+        fprintf(steady_log_file, "%i %.5g ", timesteps, saturation);
+        for (size_t s = 0; s < Steady.names.size(); s++)
+            fprintf(steady_log_file, "%.5g %.5g ", Steady.drift[s],
+                    Steady.halfwidth[s]);
+        fprintf(steady_log_file, "%i \"%s\"\n", detected ? 1 : 0,
+                reason.c_str());
+        fclose(steady_log_file);
+    }
+}
+
+template <class TYPE>
+void ScaLBL_ColorModel::Step(TYPE *fq, TYPE *Aq, TYPE *Bq) {
+    // *************ODD TIMESTEP*************
+    timestep++;
+    // Compute the Phase indicator field
+    // Read for Aq, Bq happens in this routine (requires communication)
+    if (AggregateHalo)
+        ScaLBL_Comm->SendHaloAA(); // Aq, Bq and fq in one message
+    else
+        ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
+    Timer->start(PhaseTimer::INTERIOR);
+    if (!FusedKernels)
+        ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcPhiMap, Aq, Bq, Den,
+                                     Phi, ScaLBL_Comm->FirstInterior(),
+                                     ScaLBL_Comm->LastInterior(), Np);
+    Timer->stop();
+    if (AggregateHalo)
+        ScaLBL_Comm->RecvHaloAA();
+    else
+        ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
+    ScaLBL_Comm->StepBarrier();
+    Timer->start(PhaseTimer::EXTERIOR);
+    ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcPhiMap, Aq, Bq, Den, Phi, 0,
+                                 ScaLBL_Comm->LastExterior(), Np);
+    Timer->stop();
+
+    // Perform the collision operation
+    if (!AggregateHalo)
+        ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
+    Timer->start(PhaseTimer::BC);
+    if (BoundaryCondition > 0 && BoundaryCondition < 5) {
+        ScaLBL_Comm->Color_BC_z(dvcPhiMap, Phi, Den, inletA, inletB);
+        ScaLBL_Comm->Color_BC_Z(dvcPhiMap, Phi, Den, outletA, outletB);
+    }
+    Timer->stop();
+    // Halo exchange for phase field
+    ScaLBL_Comm_Regular->SendHalo(Phi);
+
+    Timer->start(PhaseTimer::INTERIOR);
+    if (FusedKernels)
+        ScaLBL_D3Q19_AAodd_Color_Fused(
+            NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA,
+            rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, Nx, Nx * Ny,
+            ScaLBL_Comm->InteriorSpan(), ScaLBL_Comm->FirstInterior(),
+            ScaLBL_Comm->LastInterior(), Np);
+    else if (SparsePhi)
+        ScaLBL_D3Q19_AAodd_Color_Sparse(
+            NeighborList, dvcRingOffset, dvcRingIndex, fq, Aq, Bq, Den, Phi,
+            Velocity, rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz,
+            ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+    else
+        ScaLBL_D3Q19_AAodd_Color(
+            NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA,
+            rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, Nx, Nx * Ny,
+            ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+    Timer->stop();
+    ScaLBL_Comm_Regular->RecvHalo(Phi);
+    if (!AggregateHalo)
+        ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
+    ScaLBL_Comm->StepBarrier();
+    // Set BCs
+    Timer->start(PhaseTimer::BC);
+    if (BoundaryCondition == 3) {
+        ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
+        ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
+    }
+    if (BoundaryCondition == 4) {
+        din = ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
+        ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
+    } else if (BoundaryCondition == 5) {
+        ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
+        ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
+    }
+    Timer->stop();
+    Timer->start(PhaseTimer::EXTERIOR);
+    if (SparsePhi)
+        ScaLBL_D3Q19_AAodd_Color_Sparse(
+            NeighborList, dvcRingOffset, dvcRingIndex, fq, Aq, Bq, Den, Phi,
+            Velocity, rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, 0,
+            ScaLBL_Comm->LastExterior(), Np);
+    else
+        ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den,
+                                 Phi, Velocity, rhoA, rhoB, tauA, tauB,
+                                 alpha, beta, Fx, Fy, Fz, Nx, Nx * Ny, 0,
+                                 ScaLBL_Comm->LastExterior(), Np);
+    Timer->stop();
+    ScaLBL_Comm->StepBarrier();
+
+    // *************EVEN TIMESTEP*************
+    timestep++;
+    // Compute the Phase indicator field
+    if (AggregateHalo)
+        ScaLBL_Comm->SendHaloAA(); // Aq, Bq and fq in one message
+    else
+        ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
+    Timer->start(PhaseTimer::INTERIOR);
+    if (!FusedKernels)
+        ScaLBL_D3Q7_AAeven_PhaseField(dvcPhiMap, Aq, Bq, Den, Phi,
+                                      ScaLBL_Comm->FirstInterior(),
+                                      ScaLBL_Comm->LastInterior(), Np);
+    Timer->stop();
+    if (AggregateHalo)
+        ScaLBL_Comm->RecvHaloAA();
+    else
+        ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
+    ScaLBL_Comm->StepBarrier();
+    Timer->start(PhaseTimer::EXTERIOR);
+    ScaLBL_D3Q7_AAeven_PhaseField(dvcPhiMap, Aq, Bq, Den, Phi, 0,
+                                  ScaLBL_Comm->LastExterior(), Np);
+    Timer->stop();
+
+    // Perform the collision operation
+    if (!AggregateHalo)
+        ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
+    // Halo exchange for phase field
+    Timer->start(PhaseTimer::BC);
+    if (BoundaryCondition > 0 && BoundaryCondition < 5) {
+        ScaLBL_Comm->Color_BC_z(dvcPhiMap, Phi, Den, inletA, inletB);
+        ScaLBL_Comm->Color_BC_Z(dvcPhiMap, Phi, Den, outletA, outletB);
+    }
+    Timer->stop();
+    ScaLBL_Comm_Regular->SendHalo(Phi);
+    Timer->start(PhaseTimer::INTERIOR);
+    if (FusedKernels)
+        ScaLBL_D3Q19_AAeven_Color_Fused(
+            dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+            alpha, beta, Fx, Fy, Fz, Nx, Nx * Ny,
+            ScaLBL_Comm->InteriorSpan(), ScaLBL_Comm->FirstInterior(),
+            ScaLBL_Comm->LastInterior(), Np);
+    else if (SparsePhi)
+        ScaLBL_D3Q19_AAeven_Color_Sparse(
+            NeighborList, dvcRingOffset, dvcRingIndex, fq, Aq, Bq, Den, Phi,
+            Velocity, rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz,
+            ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+    else
+        ScaLBL_D3Q19_AAeven_Color(
+            dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+            alpha, beta, Fx, Fy, Fz, Nx, Nx * Ny,
+            ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+    Timer->stop();
+    ScaLBL_Comm_Regular->RecvHalo(Phi);
+    if (!AggregateHalo)
+        ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
+    ScaLBL_Comm->StepBarrier();
+    // Set boundary conditions
+    Timer->start(PhaseTimer::BC);
+    if (BoundaryCondition == 3) {
+        ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
+        ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
+    } else if (BoundaryCondition == 4) {
+        din = ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
+        ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
+    } else if (BoundaryCondition == 5) {
+        ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
+        ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
+    }
+    Timer->stop();
+    Timer->start(PhaseTimer::EXTERIOR);
+    if (SparsePhi)
+        ScaLBL_D3Q19_AAeven_Color_Sparse(
+            NeighborList, dvcRingOffset, dvcRingIndex, fq, Aq, Bq, Den, Phi,
+            Velocity, rhoA, rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, 0,
+            ScaLBL_Comm->LastExterior(), Np);
+    else
+        ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity,
+                                  rhoA, rhoB, tauA, tauB, alpha, beta, Fx,
+                                  Fy, Fz, Nx, Nx * Ny, 0,
+                                  ScaLBL_Comm->LastExterior(), Np);
+    Timer->stop();
+    ScaLBL_Comm->StepBarrier();
 }
 
 double ScaLBL_ColorModel::Run(int returntime) {
@@ -640,6 +1050,18 @@ double ScaLBL_ColorModel::Run(int returntime) {
         flow_db->getWithDefault<int>("max_steady_timesteps", 1000000);
     int RESCALE_FORCE_AFTER_TIMESTEP = MAX_STEADY_TIMESTEPS * 2;
     int INITIAL_TIMESTEP = timestep;
+    /* statistical steady-state detection (disabled if the window is zero) */
+    int STEADY_STATE_WINDOW =
+        flow_db->getWithDefault<int>("steady_state_window", 0);
+    std::shared_ptr<SteadyState> Steady;
+    if (STEADY_STATE_WINDOW > 0) {
+        Steady = std::make_shared<SteadyState>(
+            std::vector<std::string>{"saturation", "flow.rate.oil",
+                                     "flow.rate.water", "cap.pressure"},
+            STEADY_STATE_WINDOW,
+            flow_db->getWithDefault<double>("steady_state_tolerance", 0.01),
+            flow_db->getWithDefault<double>("steady_state_confidence", 0.95));
+    }
 
     double capillary_number = 1.0e-5;
     double Ca_previous = 0.0;
@@ -659,109 +1081,38 @@ double ScaLBL_ColorModel::Run(int returntime) {
     if (analysis_db->keyExists("tolerance")) {
         tolerance = analysis_db->getScalar<double>("tolerance");
     }
-    
+    int analysis_interval =
+        analysis_db->getWithDefault<int>("analysis_interval", 1000);
+
     runAnalysis analysis(current_db, rank_info, ScaLBL_Comm, Dm, Np, Regular,
                          Map);
+    if (SparsePhi)
+        analysis.setPhaseLayout(PhiMap, NPhi);
     auto t1 = std::chrono::system_clock::now();
     int CURRENT_TIMESTEP = 0;
     int EXIT_TIMESTEP = min(timestepMax, returntime);
     while (timestep < EXIT_TIMESTEP) {
       PROFILE_START("Update");
-        // *************ODD TIMESTEP*************
-        timestep++;
-        // Compute the Phase indicator field
-        // Read for Aq, Bq happens in this routine (requires communication)
-        ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
-        ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi,
-                                     ScaLBL_Comm->FirstInterior(),
-                                     ScaLBL_Comm->LastInterior(), Np);
-        ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
-        ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi, 0,
-                                     ScaLBL_Comm->LastExterior(), Np);
-
-        // Perform the collision operation
-        ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
-        if (BoundaryCondition > 0 && BoundaryCondition < 5) {
-            ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
-            ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
-        }
-        // Halo exchange for phase field
-        ScaLBL_Comm_Regular->SendHalo(Phi);
-
-        ScaLBL_D3Q19_AAodd_Color(
-            NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB,
-            tauA, tauB, alpha, beta, Fx, Fy, Fz, Nx, Nx * Ny,
-            ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
-        ScaLBL_Comm_Regular->RecvHalo(Phi);
-        ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
-        // Set BCs
-        if (BoundaryCondition == 3) {
-            ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        }
-        if (BoundaryCondition == 4) {
-            din =
-                ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 5) {
-            ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
-            ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
-        }
-        ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi,
-                                 Velocity, rhoA, rhoB, tauA, tauB, alpha, beta,
-                                 Fx, Fy, Fz, Nx, Nx * Ny, 0,
-                                 ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
-
-        // *************EVEN TIMESTEP*************
-        timestep++;
-        // Compute the Phase indicator field
-        ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
-        ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi,
-                                      ScaLBL_Comm->FirstInterior(),
-                                      ScaLBL_Comm->LastInterior(), Np);
-        ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
-        ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi, 0,
-                                      ScaLBL_Comm->LastExterior(), Np);
-
-        // Perform the collision operation
-        ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
-        // Halo exchange for phase field
-        if (BoundaryCondition > 0 && BoundaryCondition < 5) {
-            ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
-            ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
-        }
-        ScaLBL_Comm_Regular->SendHalo(Phi);
-        ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA,
-                                  rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, Nx,
-                                  Nx * Ny, ScaLBL_Comm->FirstInterior(),
-                                  ScaLBL_Comm->LastInterior(), Np);
-        ScaLBL_Comm_Regular->RecvHalo(Phi);
-        ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
-        // Set boundary conditions
-        if (BoundaryCondition == 3) {
-            ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 4) {
-            din =
-                ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 5) {
-            ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
-            ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
-        }
-        ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA,
-                                  rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, Nx,
-                                  Nx * Ny, 0, ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
+#ifdef SCALBL_FLOAT_STORAGE
+        if (SinglePrecision)
+            Step(fq_float, Aq_float, Bq_float);
+        else
+#endif
+            Step(fq, Aq, Bq);
         //************************************************************************
-        analysis.basic(
-            timestep, current_db, *Averages, Phi, Pressure, Velocity, fq,
-            Den); // allow initial ramp-up to get closer to steady state
+        Timer->start(PhaseTimer::ANALYSIS);
+        // allow initial ramp-up to get closer to steady state
+#ifdef SCALBL_FLOAT_STORAGE
+        if (SinglePrecision)
+            analysis.basic(timestep, current_db, *Averages, Phi, Pressure,
+                           Velocity, fq_float, Den);
+        else
+#endif
+            analysis.basic(timestep, current_db, *Averages, Phi, Pressure,
+                           Velocity, fq, Den);
+        Timer->stop();
+        if (timestep % analysis_interval == 0)
+            Timer->write(timestep);
 
         CURRENT_TIMESTEP += 2;
         if (CURRENT_TIMESTEP > MIN_STEADY_TIMESTEPS && BoundaryCondition == 0) {
@@ -801,8 +1152,24 @@ double ScaLBL_ColorModel::Run(int returntime) {
                 fabs(muA * flow_rate_A + muB * flow_rate_B) / (5.796 * alpha);
 
             bool isSteady = false;
-            if ((fabs((Ca - Ca_previous) / Ca) < tolerance &&
-                 CURRENT_TIMESTEP > MIN_STEADY_TIMESTEPS))
+            bool STEADY_STATE_DETECTED = false;
+            if (Steady) {
+                if (timestep % analysis_interval == 0) {
+                    /* flow rates are relative to the total flow rate, and the
+                       capillary pressure to the viscous pressure drop */
+                    double flow_scale = fabs(flow_rate_A) + fabs(flow_rate_B);
+                    double pressure_scale =
+                        fabs(Averages->gnb.p - Averages->gwb.p) +
+                        (rhoA * volA + rhoB * volB) * force_mag * (Nz - 2) *
+                            nprocz;
+                    Steady->add({current_saturation, flow_rate_A, flow_rate_B,
+                                 Averages->gnb.p - Averages->gwb.p},
+                                {1.0, flow_scale, flow_scale, pressure_scale});
+                    STEADY_STATE_DETECTED = Steady->steady();
+                    isSteady = STEADY_STATE_DETECTED;
+                }
+            } else if ((fabs((Ca - Ca_previous) / Ca) < tolerance &&
+                        CURRENT_TIMESTEP > MIN_STEADY_TIMESTEPS))
                 isSteady = true;
             if (CURRENT_TIMESTEP >= MAX_STEADY_TIMESTEPS)
                 isSteady = true;
@@ -830,6 +1197,8 @@ double ScaLBL_ColorModel::Run(int returntime) {
             if (TRIGGER_FORCE_RESCALE) {
             	RESCALE_FORCE = false;
             	TRIGGER_FORCE_RESCALE = false;
+            	if (Steady)
+            		Steady->reset();
             	double RESCALE_FORCE_FACTOR = capillary_number / Ca;
             	if (RESCALE_FORCE_FACTOR > 2.0)
             		RESCALE_FORCE_FACTOR = 2.0;
@@ -852,6 +1221,10 @@ double ScaLBL_ColorModel::Run(int returntime) {
             	color_db->putVector<double>("F", {Fx, Fy, Fz});
             }
             if (isSteady) {
+                if (Steady)
+                    WriteSteadyState(*Steady, STEADY_STATE_DETECTED,
+                                     CURRENT_TIMESTEP, current_saturation,
+                                     rank);
                 Averages->Full();
                 Averages->Write(timestep);
                 analysis.WriteVisData(timestep, current_db, *Averages, Phi,
@@ -1072,9 +1445,17 @@ double ScaLBL_ColorModel::Run(int returntime) {
                     }
                 }
             }
+            if (isSteady && Steady) {
+                /* the point is finished once the steady state is recorded */
+                break;
+            }
         }
     }
+    Timer->start(PhaseTimer::ANALYSIS);
     analysis.finish();
+    Timer->stop();
+    if (timestep % analysis_interval != 0)
+        Timer->write(timestep);
     PROFILE_STOP("Update");
 
     PROFILE_STOP("Loop");
@@ -1097,6 +1478,155 @@ double ScaLBL_ColorModel::Run(int returntime) {
     MLUPS *= nprocs;
 }
 
+double ScaLBL_ColorModel::RunProtocol() {
+    double MLUPS = 0.0;
+    int timestep = 0;
+    bool ContinueSimulation = true;
+
+    /* Variables for simulation protocols */
+    auto PROTOCOL =
+        color_db->getWithDefault<std::string>("protocol", "default");
+    /* image sequence protocol */
+    int IMAGE_INDEX = 0;
+    int IMAGE_COUNT = 0;
+    std::vector<std::string> ImageList;
+    std::string IMAGE_UPDATE = "full";
+    /* flow adaptor keys to control behavior */
+    int SKIP_TIMESTEPS = 0;
+    int MAX_STEADY_TIME = 1000000;
+    double ENDPOINT_THRESHOLD = 0.1;
+    double FRACTIONAL_FLOW_INCREMENT =
+        0.0; // this will skip the flow adaptor if not enabled
+    double SEED_WATER = 0.0;
+    if (db->keyExists("FlowAdaptor")) {
+        auto flow_db = db->getDatabase("FlowAdaptor");
+        MAX_STEADY_TIME =
+            flow_db->getWithDefault<int>("max_steady_timesteps", 1000000);
+        SKIP_TIMESTEPS = flow_db->getWithDefault<int>("skip_timesteps", 50000);
+        ENDPOINT_THRESHOLD =
+            flow_db->getWithDefault<double>("endpoint_threshold", 0.1);
+        IMAGE_UPDATE =
+            flow_db->getWithDefault<std::string>("image_update", "full");
+        /* protocol specific key values */
+        if (PROTOCOL == "image sequence" || PROTOCOL == "core flooding")
+            SKIP_TIMESTEPS = 0;
+        if (PROTOCOL == "fractional flow")
+            FRACTIONAL_FLOW_INCREMENT = flow_db->getWithDefault<double>(
+                "fractional_flow_increment", 0.05);
+        if (PROTOCOL == "seed water") {
+            SEED_WATER = flow_db->getWithDefault<double>("seed_water", 0.01);
+            FRACTIONAL_FLOW_INCREMENT = flow_db->getWithDefault<double>(
+                "fractional_flow_increment", 0.05);
+        }
+    }
+    if (PROTOCOL == "image sequence") {
+        ImageList = color_db->getVector<std::string>("image_sequence");
+        IMAGE_INDEX = color_db->getWithDefault<int>("image_index", 0);
+        IMAGE_COUNT = ImageList.size();
+    }
+    /* analysis keys*/
+    int ANALYSIS_INTERVAL = timestepMax;
+    if (analysis_db->keyExists("analysis_interval")) {
+        ANALYSIS_INTERVAL = analysis_db->getScalar<int>("analysis_interval");
+    }
+    /* Launch the simulation */
+    FlowAdaptor Adapt(*this);
+    while (ContinueSimulation) {
+        /* this will run steady points */
+        if (PROTOCOL == "fractional flow" || PROTOCOL == "seed water" ||
+            PROTOCOL == "shell aggregation" || PROTOCOL == "image sequence")
+            timestep += MAX_STEADY_TIME;
+        else
+            timestep += timestepMax;
+        /* Run the simulation timesteps*/
+        MLUPS = Run(timestep);
+        if (rank == 0)
+            printf("Lattice update rate (per MPI process)= %f MLUPS \n",
+                   MLUPS);
+        if (this->timestep >= timestepMax) {
+            ContinueSimulation = false;
+        }
+
+        /* Load a new image if image sequence is specified */
+        if (PROTOCOL == "image sequence") {
+            IMAGE_INDEX++;
+            if (IMAGE_INDEX < IMAGE_COUNT) {
+                std::string next_image = ImageList[IMAGE_INDEX];
+                if (rank == 0)
+                    printf("***Loading next image in sequence (%i) ***\n",
+                           IMAGE_INDEX);
+                color_db->putScalar<int>("image_index", IMAGE_INDEX);
+                if (IMAGE_UPDATE == "incremental")
+                    Adapt.ImageUpdate(*this, next_image);
+                else
+                    Adapt.ImageInit(*this, next_image);
+            } else {
+                if (rank == 0)
+                    printf("Finished simulating image sequence \n");
+                this->timestep = timestepMax;
+                ContinueSimulation = false;
+            }
+        }
+        /*********************************************************/
+        /* update the fluid configuration with the flow adapter */
+        int skip_time = 0;
+        timestep = this->timestep;
+        /* get the averaged flow measures computed internally for the last simulation point*/
+        double SaturationChange = 0.0;
+        double volB = Averages->gwb.V;
+        double volA = Averages->gnb.V;
+        double initialSaturation = volB / (volA + volB);
+        double vA_x = Averages->gnb.Px / Averages->gnb.M;
+        double vA_y = Averages->gnb.Py / Averages->gnb.M;
+        double vA_z = Averages->gnb.Pz / Averages->gnb.M;
+        double vB_x = Averages->gwb.Px / Averages->gwb.M;
+        double vB_y = Averages->gwb.Py / Averages->gwb.M;
+        double vB_z = Averages->gwb.Pz / Averages->gwb.M;
+        double speedA = sqrt(vA_x * vA_x + vA_y * vA_y + vA_z * vA_z);
+        double speedB = sqrt(vB_x * vB_x + vB_y * vB_y + vB_z * vB_z);
+        /* stop simulation if previous point was sufficiently close to the endpoint*/
+        if (volA * speedA < ENDPOINT_THRESHOLD * volB * speedB)
+            ContinueSimulation = false;
+        if (ContinueSimulation && SKIP_TIMESTEPS > 0) {
+            while (skip_time < SKIP_TIMESTEPS &&
+                   fabs(SaturationChange) < fabs(FRACTIONAL_FLOW_INCREMENT)) {
+                timestep += ANALYSIS_INTERVAL;
+                if (PROTOCOL == "fractional flow") {
+                    Adapt.UpdateFractionalFlow(*this);
+                } else if (PROTOCOL == "shell aggregation") {
+                    double target_volume_change =
+                        FRACTIONAL_FLOW_INCREMENT * initialSaturation -
+                        SaturationChange;
+                    Adapt.ShellAggregation(*this, target_volume_change);
+                } else if (PROTOCOL == "seed water") {
+                    Adapt.SeedPhaseField(*this, SEED_WATER);
+                }
+                /* Run some LBM timesteps to let the system relax a bit */
+                MLUPS = Run(timestep);
+                /* Recompute the volume fraction now that the system has adjusted */
+                double volB = Averages->gwb.V;
+                double volA = Averages->gnb.V;
+                SaturationChange = volB / (volA + volB) - initialSaturation;
+                skip_time += ANALYSIS_INTERVAL;
+            }
+            if (rank == 0) {
+                printf("  *********************************************************************  \n");
+                printf("   Updated fractional flow with saturation change = %f  \n",
+                       SaturationChange);
+                printf("   Used protocol = %s  \n", PROTOCOL.c_str());
+                printf("  *********************************************************************  \n");
+            }
+        }
+        /*********************************************************/
+        if (rank == 0)
+            printf("   (flatten density field)  \n");
+        if (PROTOCOL == "fractional flow") {
+            Adapt.Flatten(*this);
+        }
+    }
+    return MLUPS;
+}
+
 void ScaLBL_ColorModel::Run() {
     int nprocs = nprocx * nprocy * nprocz;
     const RankInfoStruct rank_info(rank, nprocx, nprocy, nprocz);
@@ -1114,102 +1644,19 @@ void ScaLBL_ColorModel::Run() {
     auto current_db = db->cloneDatabase();
     runAnalysis analysis(current_db, rank_info, ScaLBL_Comm, Dm, Np, Regular,
                          Map);
+    if (SparsePhi)
+        analysis.setPhaseLayout(PhiMap, NPhi);
     //analysis.createThreads( analysis_method, 4 );
     auto t1 = std::chrono::system_clock::now();
     while (timestep < timestepMax) {
         PROFILE_START("Update");
 
-        // *************ODD TIMESTEP*************
-        timestep++;
-        // Compute the Phase indicator field
-        // Read for Aq, Bq happens in this routine (requires communication)
-        ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
-        ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi,
-                                     ScaLBL_Comm->FirstInterior(),
-                                     ScaLBL_Comm->LastInterior(), Np);
-        ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
-        ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi, 0,
-                                     ScaLBL_Comm->LastExterior(), Np);
-
-        // Perform the collision operation
-        ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
-        if (BoundaryCondition > 0 && BoundaryCondition < 5) {
-            ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
-            ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
-        }
-        // Halo exchange for phase field
-        ScaLBL_Comm_Regular->SendHalo(Phi);
-
-        ScaLBL_D3Q19_AAodd_Color(
-            NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB,
-            tauA, tauB, alpha, beta, Fx, Fy, Fz, Nx, Nx * Ny,
-            ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
-        ScaLBL_Comm_Regular->RecvHalo(Phi);
-        ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
-        // Set BCs
-        if (BoundaryCondition == 3) {
-            ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        }
-        if (BoundaryCondition == 4) {
-            din =
-                ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 5) {
-            ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
-            ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
-        }
-        ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi,
-                                 Velocity, rhoA, rhoB, tauA, tauB, alpha, beta,
-                                 Fx, Fy, Fz, Nx, Nx * Ny, 0,
-                                 ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
-
-        // *************EVEN TIMESTEP*************
-        timestep++;
-        // Compute the Phase indicator field
-        ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
-        ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi,
-                                      ScaLBL_Comm->FirstInterior(),
-                                      ScaLBL_Comm->LastInterior(), Np);
-        ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
-        ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi, 0,
-                                      ScaLBL_Comm->LastExterior(), Np);
-
-        // Perform the collision operation
-        ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
-        // Halo exchange for phase field
-        if (BoundaryCondition > 0 && BoundaryCondition < 5) {
-            ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
-            ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
-        }
-        ScaLBL_Comm_Regular->SendHalo(Phi);
-        ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA,
-                                  rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, Nx,
-                                  Nx * Ny, ScaLBL_Comm->FirstInterior(),
-                                  ScaLBL_Comm->LastInterior(), Np);
-        ScaLBL_Comm_Regular->RecvHalo(Phi);
-        ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
-        // Set boundary conditions
-        if (BoundaryCondition == 3) {
-            ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 4) {
-            din =
-                ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 5) {
-            ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
-            ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
-        }
-        ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA,
-                                  rhoB, tauA, tauB, alpha, beta, Fx, Fy, Fz, Nx,
-                                  Nx * Ny, 0, ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
+#ifdef SCALBL_FLOAT_STORAGE
+        if (SinglePrecision)
+            Step(fq_float, Aq_float, Bq_float);
+        else
+#endif
+            Step(fq, Aq, Bq);
         //************************************************************************
         PROFILE_STOP("Update");
 
@@ -1218,10 +1665,24 @@ void ScaLBL_ColorModel::Run() {
             printf("%i %f \n", timestep, din);
         }
         // Run the analysis
-        analysis.basic(timestep, current_db, *Averages, Phi, Pressure, Velocity,
-                       fq, Den);
+        Timer->start(PhaseTimer::ANALYSIS);
+#ifdef SCALBL_FLOAT_STORAGE
+        if (SinglePrecision)
+            analysis.basic(timestep, current_db, *Averages, Phi, Pressure,
+                           Velocity, fq_float, Den);
+        else
+#endif
+            analysis.basic(timestep, current_db, *Averages, Phi, Pressure,
+                           Velocity, fq, Den);
+        Timer->stop();
+        if (timestep % analysis_interval == 0)
+            Timer->write(timestep);
     }
+    Timer->start(PhaseTimer::ANALYSIS);
     analysis.finish();
+    Timer->stop();
+    if (timestep % analysis_interval != 0)
+        Timer->write(timestep);
     PROFILE_STOP("Loop");
     PROFILE_SAVE("lbpm_color_simulator", 1);
     //************************************************************************
@@ -1254,7 +1715,7 @@ void ScaLBL_ColorModel::WriteDebug() {
     // Copy back final phase indicator field and convert to regular layout
     DoubleArray PhaseField(Nx, Ny, Nz);
     //ScaLBL_Comm->RegularLayout(Map,Phi,PhaseField);
-    ScaLBL_CopyToHost(PhaseField.data(), Phi, sizeof(double) * N);
+    CopyPhaseToHost(PhaseField.data());
 
     FILE *OUTFILE;
     sprintf(LocalRankFilename, "Phase.%05i.raw", rank);
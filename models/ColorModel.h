@@ -75,8 +75,10 @@ public:
 
     /**
     * \brief Read image data
+    * @param labels  - optional local labels (N entries) that were already decomposed for the
+    *                  same domain, e.g. by another model in an ensemble; the image is not read
     */
-    void ReadInput();
+    void ReadInput(const signed char *labels = nullptr);
 
     /**
     * \brief Create color model data structures
@@ -99,6 +101,13 @@ public:
     */
     double Run(int returntime);
 
+    /**
+    * \brief Run the simulation protocol from the "Color" section (default, fractional flow, image sequence, ...)
+    * \details Runs one or more steady points and uses the flow adaptor between them
+    * @return lattice update rate (MLUPS) for the last simulation point
+    */
+    double RunProtocol();
+
     /**
     * \brief Debugging function to dump simulation state to disk
     */
@@ -110,8 +119,32 @@ public:
     */
     void getPhaseField(DoubleArray &f);
 
+    /**
+    * \brief Copy the phase field to the host in the regular layout
+    * \details With sparse_phi, sites that are not stored are set to zero
+    * @param phase   - host array with N entries
+    */
+    void CopyPhaseToHost(double *phase);
+
+    /**
+    * \brief Copy a phase field in the regular layout to the device
+    * @param phase   - host array with N entries
+    */
+    void CopyPhaseToDevice(const double *phase);
+
+    /**
+    * \brief Set the phase field on a z slice (see ScaLBL_SetSlice_z)
+    * @param value   - value of the phase field
+    * @param slice   - z index of the slice
+    */
+    void SetPhaseSlice_z(double value, int slice);
+
     bool Restart, pBC;
     bool REVERSE_FLOW_DIRECTION;
+    bool SinglePrecision; // store fq, Aq and Bq as float (precision = "single")
+    bool FusedKernels;
+    bool AggregateHalo;
+    bool SparsePhi;
     int timestep, timestepMax;
     int BoundaryCondition;
     double tauA, tauB, rhoA, rhoB, alpha, beta;
@@ -127,6 +160,7 @@ public:
     std::shared_ptr<Domain> Mask; // this domain is for lbm
     std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm;
     std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm_Regular;
+    std::shared_ptr<PhaseTimer> Timer;
     std::shared_ptr<SubPhase> Averages;
 
     // input database
@@ -141,7 +175,17 @@ public:
     int *NeighborList;
     int *dvcMap;
     double *fq, *Aq, *Bq;
+    // distributions stored in single precision (fq shifted by the lattice weight)
+    float *fq_float, *Aq_float, *Bq_float;
     double *Den, *Phi;
+    // Phase field layout: PhiMap(i,j,k) is the index in Phi (<0 if not stored)
+    //   - regular: N sites, dvcPhiMap is dvcMap
+    //   - sparse_phi: Np fluid sites, then the ring of solid and halo sites
+    //     adjacent to the fluid (dvcRingOffset / dvcRingIndex), then a dummy
+    IntArray PhiMap;
+    int NPhi;
+    int *dvcPhiMap;
+    int *dvcRingOffset, *dvcRingIndex;
     double *ColorGrad;
     double *Velocity;
     double *Pressure;
@@ -162,6 +206,9 @@ private:
     char LocalRestartFile[40];
 
     //int rank,nprocs;
+    // advance two timesteps (odd, then even) for distributions stored as TYPE
+    template <class TYPE> void Step(TYPE *fq, TYPE *Aq, TYPE *Bq);
+    void SetupPhaseLayout();
     void LoadParams(std::shared_ptr<Database> db0);
 };
 
@@ -218,6 +218,13 @@ void ScaLBL_DFHModel::Create() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // barrier_free = false restores the global barriers in the time loop
+    ScaLBL_Comm->BarrierFree =
+        color_db->getWithDefault<bool>("barrier_free", true);
+    // timing = true writes the time spent in each phase to timing.csv / timing.json
+    Timer = std::make_shared<PhaseTimer>(comm);
+    Timer->enable(color_db->getWithDefault<bool>("timing", false));
+    ScaLBL_Comm->SetTimer(Timer);
 
     int Npad = (Np / 16 + 2) * 16;
     if (rank == 0)
@@ -239,12 +246,12 @@ void ScaLBL_DFHModel::Create() {
     neighborSize = 18 * (Np * sizeof(int));
 
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
     ScaLBL_AllocateDeviceMemory((void **)&dvcMap, sizeof(int) * Np);
-    ScaLBL_AllocateDeviceMemory((void **)&fq, 19 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Aq, 7 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Bq, 7 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Den, 2 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&fq, 19 * dist_mem_size, 19);
+    ScaLBL_AllocateDistributionMemory((void **)&Aq, 7 * dist_mem_size, 7);
+    ScaLBL_AllocateDistributionMemory((void **)&Bq, 7 * dist_mem_size, 7);
+    ScaLBL_AllocateDistributionMemory((void **)&Den, 2 * dist_mem_size, 2);
     ScaLBL_AllocateDeviceMemory((void **)&Phi, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Pressure, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Velocity, 3 * sizeof(double) * Np);
@@ -529,6 +536,8 @@ void ScaLBL_DFHModel::Run() {
     PROFILE_START("Loop");
     runAnalysis analysis(analysis_db, rank_info, ScaLBL_Comm, Dm, Np, Regular,
                          Map);
+    int analysis_interval =
+        analysis_db->getWithDefault<int>("analysis_interval", 1000);
     while (timestep < timestepMax) {
         //if ( rank==0 ) { printf("Running timestep %i (%i MB)\n",timestep+1,(int)(Utilities::getMemoryUsage()/1048576)); }
         PROFILE_START("Update");
@@ -537,30 +546,41 @@ void ScaLBL_DFHModel::Run() {
         // Compute the Phase indicator field
         // Read for Aq, Bq happens in this routine (requires communication)
         ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q7_AAodd_DFH(NeighborList, Aq, Bq, Den, Phi,
                               ScaLBL_Comm->FirstInterior(),
                               ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q7_AAodd_DFH(NeighborList, Aq, Bq, Den, Phi, 0,
                               ScaLBL_Comm->LastExterior(), Np);
+        Timer->stop();
 
         // compute the gradient
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_Gradient_DFH(NeighborList, Phi, Gradient,
                                   ScaLBL_Comm->FirstInterior(),
                                   ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->SendHalo(Phi);
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_Gradient_DFH(NeighborList, Phi, Gradient, 0,
                                   ScaLBL_Comm->LastExterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->RecvGrad(Phi, Gradient);
 
         // Perform the collision operation
         ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAodd_DFH(NeighborList, fq, Aq, Bq, Den, Phi, Gradient,
                                SolidPotential, rhoA, rhoB, tauA, tauB, alpha,
                                beta, Fx, Fy, Fz, ScaLBL_Comm->FirstInterior(),
                                ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
         // Set BCs
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition > 0) {
             ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
             ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
@@ -574,40 +594,53 @@ void ScaLBL_DFHModel::Run() {
                 ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
             ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
         }
+        Timer->stop();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAodd_DFH(NeighborList, fq, Aq, Bq, Den, Phi, Gradient,
                                SolidPotential, rhoA, rhoB, tauA, tauB, alpha,
                                beta, Fx, Fy, Fz, 0, ScaLBL_Comm->LastExterior(),
                                Np);
-        ScaLBL_DeviceBarrier();
-        comm.barrier();
+        Timer->stop();
+        ScaLBL_Comm->StepBarrier();
 
         // *************EVEN TIMESTEP*************
         timestep++;
         // Compute the Phase indicator field
         ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q7_AAeven_DFH(Aq, Bq, Den, Phi, ScaLBL_Comm->FirstInterior(),
                                ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q7_AAeven_DFH(Aq, Bq, Den, Phi, 0, ScaLBL_Comm->LastExterior(),
                                Np);
+        Timer->stop();
 
         // compute the gradient
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_Gradient_DFH(NeighborList, Phi, Gradient,
                                   ScaLBL_Comm->FirstInterior(),
                                   ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->SendHalo(Phi);
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_Gradient_DFH(NeighborList, Phi, Gradient, 0,
                                   ScaLBL_Comm->LastExterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->RecvGrad(Phi, Gradient);
 
         // Perform the collision operation
         ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAeven_DFH(NeighborList, fq, Aq, Bq, Den, Phi, Gradient,
                                 SolidPotential, rhoA, rhoB, tauA, tauB, alpha,
                                 beta, Fx, Fy, Fz, ScaLBL_Comm->FirstInterior(),
                                 ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
         // Set boundary conditions
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition > 0) {
             ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
             ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
@@ -620,19 +653,24 @@ void ScaLBL_DFHModel::Run() {
                 ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
             ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
         }
+        Timer->stop();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAeven_DFH(NeighborList, fq, Aq, Bq, Den, Phi, Gradient,
                                 SolidPotential, rhoA, rhoB, tauA, tauB, alpha,
                                 beta, Fx, Fy, Fz, 0,
                                 ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_DeviceBarrier();
-        comm.barrier();
+        Timer->stop();
+        ScaLBL_Comm->StepBarrier();
         //************************************************************************
-        comm.barrier();
         PROFILE_STOP("Update");
 
         // Run the analysis
+        Timer->start(PhaseTimer::ANALYSIS);
         analysis.run(timestep, analysis_db, *Averages, Phi, Pressure, Velocity,
                      fq, Den);
+        Timer->stop();
+        if (timestep % analysis_interval == 0)
+            Timer->write(timestep);
     }
     analysis.finish();
     PROFILE_STOP("Loop");
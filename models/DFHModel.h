@@ -46,6 +46,7 @@ public:
     std::shared_ptr<Domain> Dm;   // this domain is for analysis
     std::shared_ptr<Domain> Mask; // this domain is for lbm
     std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm;
+    std::shared_ptr<PhaseTimer> Timer;
     std::shared_ptr<TwoPhase> Averages;
 
     // input database
@@ -299,6 +299,13 @@ void ScaLBL_FreeLeeModel::Create_TwoFluid() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // barrier_free = false restores the global barriers in the time loop
+    ScaLBL_Comm->BarrierFree =
+        freelee_db->getWithDefault<bool>("barrier_free", true);
+    // timing = true writes the time spent in each phase to timing.csv / timing.json
+    Timer = std::make_shared<PhaseTimer>(comm);
+    Timer->enable(freelee_db->getWithDefault<bool>("timing", false));
+    ScaLBL_Comm->SetTimer(Timer);
     //ScaLBL_Comm_Regular  = std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
     ScaLBL_Comm_WideHalo = std::shared_ptr<ScaLBLWideHalo_Communicator>(
         new ScaLBLWideHalo_Communicator(Mask, 2));
@@ -324,10 +331,10 @@ void ScaLBL_FreeLeeModel::Create_TwoFluid() {
     dist_mem_size = Np * sizeof(double);
     neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
     ScaLBL_AllocateDeviceMemory((void **)&dvcMap, sizeof(int) * Np);
-    ScaLBL_AllocateDeviceMemory((void **)&gqbar, 19 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&hq, 7 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&gqbar, 19 * dist_mem_size, 19);
+    ScaLBL_AllocateDistributionMemory((void **)&hq, 7 * dist_mem_size, 7);
     ScaLBL_AllocateDeviceMemory((void **)&mu_phi, dist_mem_size);
     ScaLBL_AllocateDeviceMemory((void **)&Den, dist_mem_size);
     ScaLBL_AllocateDeviceMemory((void **)&Phi, sizeof(double) * Nh);
@@ -392,6 +399,13 @@ void ScaLBL_FreeLeeModel::Create_SingleFluid() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // barrier_free = false restores the global barriers in the time loop
+    ScaLBL_Comm->BarrierFree =
+        freelee_db->getWithDefault<bool>("barrier_free", true);
+    // timing = true writes the time spent in each phase to timing.csv / timing.json
+    Timer = std::make_shared<PhaseTimer>(comm);
+    Timer->enable(freelee_db->getWithDefault<bool>("timing", false));
+    ScaLBL_Comm->SetTimer(Timer);
 
     // create the layout for the LBM
     int Npad = (Np / 16 + 2) * 16;
@@ -414,8 +428,8 @@ void ScaLBL_FreeLeeModel::Create_SingleFluid() {
     dist_mem_size = Np * sizeof(double);
     neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
-    ScaLBL_AllocateDeviceMemory((void **)&gqbar, 19 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
+    ScaLBL_AllocateDistributionMemory((void **)&gqbar, 19 * dist_mem_size, 19);
     ScaLBL_AllocateDeviceMemory((void **)&Pressure, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Velocity, 3 * sizeof(double) * Np);
     //...........................................................................
@@ -835,15 +849,19 @@ double ScaLBL_FreeLeeModel::Run_TwoFluid(int returntime) {
         // Compute the Phase indicator field
         // Read for hq happens in this routine (requires communication)
         ScaLBL_Comm->SendD3Q7AA(hq, 0); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q7_AAodd_FreeLeeModel_PhaseField(
             NeighborList, dvcMap, hq, Den, Phi, rhoA, rhoB,
             ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         //ScaLBL_D3Q7_AAodd_FreeLee_PhaseField(NeighborList, dvcMap, hq, Den, Phi, ColorGrad, Velocity, rhoA, rhoB, tauM, W, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
         ScaLBL_Comm->RecvD3Q7AA(hq, 0); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q7_AAodd_FreeLeeModel_PhaseField(
             NeighborList, dvcMap, hq, Den, Phi, rhoA, rhoB, 0,
             ScaLBL_Comm->LastExterior(), Np);
+        Timer->stop();
         //ScaLBL_D3Q7_AAodd_FreeLee_PhaseField(NeighborList, dvcMap, hq, Den, Phi, ColorGrad, Velocity, rhoA, rhoB, tauM, W, 0, ScaLBL_Comm->LastExterior(), Np);
 
         // Perform the collision operation
@@ -851,25 +869,30 @@ double ScaLBL_FreeLeeModel::Run_TwoFluid(int returntime) {
         //ScaLBL_Comm_WideHalo->Send(Phi);
         //ScaLBL_Comm_WideHalo->Recv(Phi);
         ScaLBL_Comm->SendD3Q19AA(gqbar); //READ FROM NORMAL
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition > 0 && BoundaryCondition < 5) {
             //TODO to be revised
             // Need to add BC for hq!!!
             ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
             ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
         }
+        Timer->stop();
         // Halo exchange for phase field
         ScaLBL_Comm_WideHalo->Send(Phi);
         //ScaLBL_D3Q19_AAodd_FreeLeeModel(NeighborList, dvcMap, gqbar, Den, Phi, mu_phi, Velocity, Pressure, ColorGrad, rhoA, rhoB, tauA, tauB,
         //		                        kappa, beta, W, Fx, Fy, Fz, Nxh, Nxh*Nyh, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAodd_FreeLeeModel_Combined(
             NeighborList, dvcMap, gqbar, hq, Den, Phi, mu_phi, Velocity,
             Pressure, ColorGrad, rhoA, rhoB, tauA, tauB, tauM, kappa, beta, W,
             Fx, Fy, Fz, Nxh, Nxh * Nyh, ScaLBL_Comm->FirstInterior(),
             ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm_WideHalo->Recv(Phi);
         ScaLBL_Comm->RecvD3Q19AA(gqbar); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
         // Set BCs
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, gqbar, din,
                                              timestep);
@@ -885,28 +908,35 @@ double ScaLBL_FreeLeeModel::Run_TwoFluid(int returntime) {
             ScaLBL_Comm->D3Q19_Reflection_BC_z(gqbar);
             ScaLBL_Comm->D3Q19_Reflection_BC_Z(gqbar);
         }
+        Timer->stop();
 
         //ScaLBL_D3Q19_AAodd_FreeLeeModel(NeighborList, dvcMap, gqbar, Den, Phi, mu_phi, Velocity, Pressure, ColorGrad, rhoA, rhoB, tauA, tauB,
         //		                        kappa, beta, W, Fx, Fy, Fz, Nxh, Nxh*Nyh, 0, ScaLBL_Comm->LastExterior(), Np);
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAodd_FreeLeeModel_Combined(
             NeighborList, dvcMap, gqbar, hq, Den, Phi, mu_phi, Velocity,
             Pressure, ColorGrad, rhoA, rhoB, tauA, tauB, tauM, kappa, beta, W,
             Fx, Fy, Fz, Nxh, Nxh * Nyh, 0, ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
+        Timer->stop();
+        ScaLBL_Comm->StepBarrier();
 
         // *************EVEN TIMESTEP*************
         timestep++;
         // Compute the Phase indicator field
         ScaLBL_Comm->SendD3Q7AA(hq, 0); //READ FROM NORMA
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q7_AAeven_FreeLeeModel_PhaseField(
             dvcMap, hq, Den, Phi, rhoA, rhoB, ScaLBL_Comm->FirstInterior(),
             ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         //ScaLBL_D3Q7_AAeven_FreeLee_PhaseField(dvcMap, hq, Den, Phi, ColorGrad, Velocity, rhoA, rhoB, tauM, W, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
         ScaLBL_Comm->RecvD3Q7AA(hq, 0); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q7_AAeven_FreeLeeModel_PhaseField(
             dvcMap, hq, Den, Phi, rhoA, rhoB, 0, ScaLBL_Comm->LastExterior(),
             Np);
+        Timer->stop();
         //ScaLBL_D3Q7_AAeven_FreeLee_PhaseField(dvcMap, hq, Den, Phi, ColorGrad, Velocity, rhoA, rhoB, tauM, W, 0, ScaLBL_Comm->LastExterior(), Np);
 
         // Perform the collision operation
@@ -914,23 +944,28 @@ double ScaLBL_FreeLeeModel::Run_TwoFluid(int returntime) {
         //ScaLBL_Comm_WideHalo->Send(Phi);
         //ScaLBL_Comm_WideHalo->Recv(Phi);
         ScaLBL_Comm->SendD3Q19AA(gqbar); //READ FORM NORMAL
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition > 0 && BoundaryCondition < 5) {
             ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
             ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
         }
+        Timer->stop();
         // Halo exchange for phase field
         ScaLBL_Comm_WideHalo->Send(Phi);
         //ScaLBL_D3Q19_AAeven_FreeLeeModel(dvcMap, gqbar, Den, Phi, mu_phi, Velocity, Pressure, ColorGrad, rhoA, rhoB, tauA, tauB,
         //		                        kappa, beta, W, Fx, Fy, Fz, Nxh, Nxh*Nyh, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAeven_FreeLeeModel_Combined(
             dvcMap, gqbar, hq, Den, Phi, mu_phi, Velocity, Pressure, ColorGrad,
             rhoA, rhoB, tauA, tauB, tauM, kappa, beta, W, Fx, Fy, Fz, Nxh,
             Nxh * Nyh, ScaLBL_Comm->FirstInterior(),
             ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm_WideHalo->Recv(Phi);
         ScaLBL_Comm->RecvD3Q19AA(gqbar); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
         // Set boundary conditions
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, gqbar, din,
                                              timestep);
@@ -945,18 +980,23 @@ double ScaLBL_FreeLeeModel::Run_TwoFluid(int returntime) {
             ScaLBL_Comm->D3Q19_Reflection_BC_z(gqbar);
             ScaLBL_Comm->D3Q19_Reflection_BC_Z(gqbar);
         }
+        Timer->stop();
         //ScaLBL_D3Q19_AAeven_FreeLeeModel(dvcMap, gqbar, Den, Phi, mu_phi, Velocity, Pressure, ColorGrad, rhoA, rhoB, tauA, tauB,
         //		                        kappa, beta, W, Fx, Fy, Fz, Nxh, Nxh*Nyh, 0, ScaLBL_Comm->LastExterior(), Np);
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAeven_FreeLeeModel_Combined(
             dvcMap, gqbar, hq, Den, Phi, mu_phi, Velocity, Pressure, ColorGrad,
             rhoA, rhoB, tauA, tauB, tauM, kappa, beta, W, Fx, Fy, Fz, Nxh,
             Nxh * Nyh, 0, ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
+        Timer->stop();
+        ScaLBL_Comm->StepBarrier();
         //************************************************************************
         PROFILE_STOP("Update");
     }
     PROFILE_STOP("Loop");
     PROFILE_SAVE("lbpm_color_simulator", 1);
+    // the simulator returns here at each visualization interval
+    Timer->write(timestep);
     //************************************************************************
     if (rank == 0)
         printf("---------------------------------------------------------------"
@@ -986,6 +1026,9 @@ void ScaLBL_FreeLeeModel::Run_SingleFluid() {
     comm.barrier();
     //.........................................
 
+    int analysis_interval =
+        analysis_db->getWithDefault<int>("analysis_interval", 1000);
+
     //************ MAIN ITERATION LOOP ***************************************/
     PROFILE_START("Loop");
     auto t1 = std::chrono::system_clock::now();
@@ -997,13 +1040,16 @@ void ScaLBL_FreeLeeModel::Run_SingleFluid() {
         //-------------------------------------------------------------------------------------------------------------------
         // Perform the collision operation
         ScaLBL_Comm->SendD3Q19AA(gqbar); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAodd_FreeLeeModel_SingleFluid_BGK(
             NeighborList, gqbar, Velocity, Pressure, tau, rho0, Fx, Fy, Fz,
             ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->RecvD3Q19AA(gqbar); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
         // Set boundary conditions
         // TODO to be revised!
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, gqbar, din,
                                              timestep);
@@ -1019,23 +1065,29 @@ void ScaLBL_FreeLeeModel::Run_SingleFluid() {
             ScaLBL_Comm->D3Q19_Reflection_BC_z(gqbar);
             ScaLBL_Comm->D3Q19_Reflection_BC_Z(gqbar);
         }
+        Timer->stop();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAodd_FreeLeeModel_SingleFluid_BGK(
             NeighborList, gqbar, Velocity, Pressure, tau, rho0, Fx, Fy, Fz, 0,
             ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
+        Timer->stop();
+        ScaLBL_Comm->StepBarrier();
 
         // *************EVEN TIMESTEP*************
         timestep++;
         //-------------------------------------------------------------------------------------------------------------------
         // Perform the collision operation
         ScaLBL_Comm->SendD3Q19AA(gqbar); //READ FORM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAeven_FreeLeeModel_SingleFluid_BGK(
             gqbar, Velocity, Pressure, tau, rho0, Fx, Fy, Fz,
             ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm->RecvD3Q19AA(gqbar); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
         // Set boundary conditions
         // TODO to be revised!
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, gqbar, din,
                                              timestep);
@@ -1050,12 +1102,17 @@ void ScaLBL_FreeLeeModel::Run_SingleFluid() {
             ScaLBL_Comm->D3Q19_Reflection_BC_z(gqbar);
             ScaLBL_Comm->D3Q19_Reflection_BC_Z(gqbar);
         }
+        Timer->stop();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAeven_FreeLeeModel_SingleFluid_BGK(
             gqbar, Velocity, Pressure, tau, rho0, Fx, Fy, Fz, 0,
             ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
+        Timer->stop();
+        ScaLBL_Comm->StepBarrier();
         //************************************************************************
         PROFILE_STOP("Update");
+        if (timestep % analysis_interval == 0)
+            Timer->write(timestep);
     }
     PROFILE_STOP("Loop");
     PROFILE_SAVE("lbpm_color_simulator", 1);
@@ -1244,6 +1301,9 @@ void ScaLBL_FreeLeeModel::Create_DummyPhase_MGTest() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // barrier_free = false restores the global barriers in the time loop
+    ScaLBL_Comm->BarrierFree =
+        freelee_db->getWithDefault<bool>("barrier_free", true);
     //ScaLBL_Comm_Regular  = std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
     ScaLBL_Comm_WideHalo = std::shared_ptr<ScaLBLWideHalo_Communicator>(
         new ScaLBLWideHalo_Communicator(Mask, 2));
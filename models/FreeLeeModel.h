@@ -62,6 +62,7 @@ public:
     std::shared_ptr<Domain> Mask; // this domain is for lbm
     std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm;
     std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm_Regular;
+    std::shared_ptr<PhaseTimer> Timer;
     std::shared_ptr<ScaLBLWideHalo_Communicator> ScaLBL_Comm_WideHalo;
 
     // input database
@@ -593,8 +593,16 @@ void ScaLBL_GreyscaleColorModel::Create() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // barrier_free = false restores the global barriers in the time loop
+    ScaLBL_Comm->BarrierFree =
+        greyscaleColor_db->getWithDefault<bool>("barrier_free", true);
     ScaLBL_Comm_Regular =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // timing = true writes the time spent in each phase to timing.csv / timing.json
+    Timer = std::make_shared<PhaseTimer>(comm);
+    Timer->enable(greyscaleColor_db->getWithDefault<bool>("timing", false));
+    ScaLBL_Comm->SetTimer(Timer);
+    ScaLBL_Comm_Regular->SetTimer(Timer);
 
     int Npad = (Np / 16 + 2) * 16;
     if (rank == 0)
@@ -616,12 +624,12 @@ void ScaLBL_GreyscaleColorModel::Create() {
     dist_mem_size = Np * sizeof(double);
     neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
     ScaLBL_AllocateDeviceMemory((void **)&dvcMap, sizeof(int) * Np);
-    ScaLBL_AllocateDeviceMemory((void **)&fq, 19 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Aq, 7 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Bq, 7 * dist_mem_size);
-    ScaLBL_AllocateDeviceMemory((void **)&Den, 2 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&fq, 19 * dist_mem_size, 19);
+    ScaLBL_AllocateDistributionMemory((void **)&Aq, 7 * dist_mem_size, 7);
+    ScaLBL_AllocateDistributionMemory((void **)&Bq, 7 * dist_mem_size, 7);
+    ScaLBL_AllocateDistributionMemory((void **)&Den, 2 * dist_mem_size, 2);
     ScaLBL_AllocateDeviceMemory((void **)&Phi, sizeof(double) * Nx * Ny * Nz);
     //ScaLBL_AllocateDeviceMemory((void **) &Psi, sizeof(double)*Nx*Ny*Nz);//greyscale potential
     ScaLBL_AllocateDeviceMemory((void **)&Pressure, sizeof(double) * Np);
@@ -952,34 +960,43 @@ void ScaLBL_GreyscaleColorModel::Run() {
         // Compute the Phase indicator field
         // Read for Aq, Bq happens in this routine (requires communication)
         ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi,
                                      ScaLBL_Comm->FirstInterior(),
                                      ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         //ScaLBL_Update_GreyscalePotential(dvcMap,Phi,Psi,Porosity_dvc,Permeability_dvc,alpha,W,ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
         ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi, 0,
                                      ScaLBL_Comm->LastExterior(), Np);
+        Timer->stop();
         //ScaLBL_Update_GreyscalePotential(dvcMap,Phi,Psi,Porosity_dvc,Permeability_dvc,alpha,W,0,ScaLBL_Comm->LastExterior(), Np);
 
         // Perform the collision operation
         ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition > 0 && BoundaryCondition < 5) {
             ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
             ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
         }
+        Timer->stop();
         // Halo exchange for phase field
         ScaLBL_Comm_Regular->SendHalo(Phi);
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAodd_GreyscaleColor_CP(
             NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, GreySolidW, GreySn,
             GreySw, GreyKn, GreyKw, Porosity_dvc, Permeability_dvc, Velocity,
             MobilityRatio, Pressure, rhoA, rhoB, tauA, tauB, tauA_eff, tauB_eff,
             alpha, beta, Fx, Fy, Fz, RecoloringOff, Nx, Nx * Ny,
             ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm_Regular->RecvHalo(Phi);
         ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
         // Set BCs
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
             ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
@@ -992,47 +1009,59 @@ void ScaLBL_GreyscaleColorModel::Run() {
             ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
             ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
         }
+        Timer->stop();
 
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAodd_GreyscaleColor_CP(
             NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, GreySolidW, GreySn,
             GreySw, GreyKn, GreyKw, Porosity_dvc, Permeability_dvc, Velocity,
             MobilityRatio, Pressure, rhoA, rhoB, tauA, tauB, tauA_eff, tauB_eff,
             alpha, beta, Fx, Fy, Fz, RecoloringOff, Nx, Nx * Ny, 0,
             ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
+        Timer->stop();
+        ScaLBL_Comm->StepBarrier();
 
         // *************EVEN TIMESTEP*************
         timestep++;
         // Compute the Phase indicator field
         ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi,
                                       ScaLBL_Comm->FirstInterior(),
                                       ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         //ScaLBL_Update_GreyscalePotential(dvcMap,Phi,Psi,Porosity_dvc,Permeability_dvc,alpha,W,ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
         ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi, 0,
                                       ScaLBL_Comm->LastExterior(), Np);
+        Timer->stop();
         //ScaLBL_Update_GreyscalePotential(dvcMap,Phi,Psi,Porosity_dvc,Permeability_dvc,alpha,W,0,ScaLBL_Comm->LastExterior(), Np);
 
         // Perform the collision operation
         ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
         // Halo exchange for phase field
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition > 0 && BoundaryCondition < 5) {
             ScaLBL_Comm->Color_BC_z(dvcMap, Phi, Den, inletA, inletB);
             ScaLBL_Comm->Color_BC_Z(dvcMap, Phi, Den, outletA, outletB);
         }
+        Timer->stop();
         ScaLBL_Comm_Regular->SendHalo(Phi);
+        Timer->start(PhaseTimer::INTERIOR);
         ScaLBL_D3Q19_AAeven_GreyscaleColor_CP(
             dvcMap, fq, Aq, Bq, Den, Phi, GreySolidW, GreySn, GreySw, GreyKn,
             GreyKw, Porosity_dvc, Permeability_dvc, Velocity, MobilityRatio,
             Pressure, rhoA, rhoB, tauA, tauB, tauA_eff, tauB_eff, alpha, beta,
             Fx, Fy, Fz, RecoloringOff, Nx, Nx * Ny,
             ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        Timer->stop();
         ScaLBL_Comm_Regular->RecvHalo(Phi);
         ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
-        ScaLBL_Comm->Barrier();
+        ScaLBL_Comm->StepBarrier();
         // Set boundary conditions
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
             ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
@@ -1044,17 +1073,21 @@ void ScaLBL_GreyscaleColorModel::Run() {
             ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
             ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
         }
+        Timer->stop();
 
+        Timer->start(PhaseTimer::EXTERIOR);
         ScaLBL_D3Q19_AAeven_GreyscaleColor_CP(
             dvcMap, fq, Aq, Bq, Den, Phi, GreySolidW, GreySn, GreySw, GreyKn,
             GreyKw, Porosity_dvc, Permeability_dvc, Velocity, MobilityRatio,
             Pressure, rhoA, rhoB, tauA, tauB, tauA_eff, tauB_eff, alpha, beta,
             Fx, Fy, Fz, RecoloringOff, Nx, Nx * Ny, 0,
             ScaLBL_Comm->LastExterior(), Np);
-        ScaLBL_Comm->Barrier();
+        Timer->stop();
+        ScaLBL_Comm->StepBarrier();
         //************************************************************************
         PROFILE_STOP("Update");
 
+        Timer->start(PhaseTimer::ANALYSIS);
         //TODO For temporary use - writing Restart and Vis files should be included in the analysis framework in the future
         if (timestep % restart_interval == 0) {
             //Use rank=0 write out Restart.db
@@ -1320,7 +1353,10 @@ void ScaLBL_GreyscaleColorModel::Run() {
             }
             morph_timesteps += analysis_interval;
         }
-        ScaLBL_Comm->Barrier();
+        Timer->stop();
+        if (timestep % analysis_interval == 0)
+            Timer->write(timestep);
+        ScaLBL_Comm->StepBarrier();
     }
     //analysis.finish();
     PROFILE_STOP("Loop");
@@ -403,6 +403,10 @@ void ScaLBL_GreyscaleModel::Create() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // timing = true writes the time spent in each phase to timing.csv / timing.json
+    Timer = std::make_shared<PhaseTimer>(comm);
+    Timer->enable(greyscale_db->getWithDefault<bool>("timing", false));
+    ScaLBL_Comm->SetTimer(Timer);
 
     int Npad = (Np / 16 + 2) * 16;
     if (rank == 0)
@@ -424,8 +428,8 @@ void ScaLBL_GreyscaleModel::Create() {
     dist_mem_size = Np * sizeof(double);
     neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
-    ScaLBL_AllocateDeviceMemory((void **)&fq, 19 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
+    ScaLBL_AllocateDistributionMemory((void **)&fq, 19 * dist_mem_size, 19);
     ScaLBL_AllocateDeviceMemory((void **)&Permeability, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Porosity, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Pressure_dvc, sizeof(double) * Np);
@@ -561,6 +565,7 @@ void ScaLBL_GreyscaleModel::Run() {
         // *************ODD TIMESTEP*************//
         timestep++;
         ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         switch (CollisionType) {
         case 1:
             ScaLBL_D3Q19_AAodd_Greyscale_IMRT(
@@ -587,13 +592,17 @@ void ScaLBL_GreyscaleModel::Run() {
                 Porosity, Permeability, Velocity, Den, Pressure_dvc);
             break;
         }
+        Timer->stop();
         ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
         ScaLBL_DeviceBarrier();
         // Set BCs
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
             ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
         }
+        Timer->stop();
+        Timer->start(PhaseTimer::EXTERIOR);
         switch (CollisionType) {
         case 1:
             ScaLBL_D3Q19_AAodd_Greyscale_IMRT(
@@ -620,12 +629,14 @@ void ScaLBL_GreyscaleModel::Run() {
                 Pressure_dvc);
             break;
         }
+        Timer->stop();
         ScaLBL_DeviceBarrier();
         comm.barrier();
 
         // *************EVEN TIMESTEP*************//
         timestep++;
         ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
+        Timer->start(PhaseTimer::INTERIOR);
         switch (CollisionType) {
         case 1:
             ScaLBL_D3Q19_AAeven_Greyscale_IMRT(
@@ -652,13 +663,17 @@ void ScaLBL_GreyscaleModel::Run() {
                 Den, Pressure_dvc);
             break;
         }
+        Timer->stop();
         ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
         ScaLBL_DeviceBarrier();
         // Set BCs
+        Timer->start(PhaseTimer::BC);
         if (BoundaryCondition == 3) {
             ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
             ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
         }
+        Timer->stop();
+        Timer->start(PhaseTimer::EXTERIOR);
         switch (CollisionType) {
         case 1:
             ScaLBL_D3Q19_AAeven_Greyscale_IMRT(
@@ -681,10 +696,12 @@ void ScaLBL_GreyscaleModel::Run() {
                 Fz, Porosity, Permeability, Velocity, Den, Pressure_dvc);
             break;
         }
+        Timer->stop();
         ScaLBL_DeviceBarrier();
         comm.barrier();
         //************************************************************************/
 
+        Timer->start(PhaseTimer::ANALYSIS);
         if (timestep % analysis_interval == 0) {
             ScaLBL_Comm->RegularLayout(Map, &Velocity[0], Velocity_x);
             ScaLBL_Comm->RegularLayout(Map, &Velocity[Np], Velocity_y);
@@ -828,6 +845,9 @@ void ScaLBL_GreyscaleModel::Run() {
             fclose(RESTARTFILE);
             comm.barrier();
         }
+        Timer->stop();
+        if (timestep % analysis_interval == 0)
+            Timer->write(timestep);
     }
 
     PROFILE_STOP("Loop");
@@ -7,12 +7,13 @@
 #include "common/ReadMicroCT.h"
 
 ScaLBL_IonModel::ScaLBL_IonModel(int RANK, int NP, const Utilities::MPI &COMM)
-    : rank(RANK), nprocs(NP), timestep(0), timestepMax(0), time_conv(0), kb(0),
-      electron_charge(0), T(0), Vt(0), k2_inv(0), h(0), tolerance(0),
+    : Restart(false), rank(RANK), nprocs(NP), timestep(0), timestepMax(0),
+      time_conv(0), kb(0), electron_charge(0), T(0), Vt(0), k2_inv(0), h(0), tolerance(0),
       number_ion_species(0), Nx(0), Ny(0), Nz(0), N(0), Np(0), nprocx(0),
       nprocy(0), nprocz(0), fluidVelx_dummy(0), fluidVely_dummy(0),
       fluidVelz_dummy(0), BoundaryConditionInlet(0), BoundaryConditionOutlet(0),
-      BoundaryConditionSolid(0), Lx(0), Ly(0), Lz(0), comm(COMM) {}
+      BoundaryConditionSolid(0), FusedSpecies(false), Lx(0), Ly(0), Lz(0),
+      comm(COMM) {}
 
 ScaLBL_IonModel::~ScaLBL_IonModel() {
     
@@ -24,6 +25,8 @@ ScaLBL_IonModel::~ScaLBL_IonModel() {
 	ScaLBL_FreeDeviceMemory(FluxDiffusive);
 	ScaLBL_FreeDeviceMemory(FluxAdvective);
 	ScaLBL_FreeDeviceMemory(FluxElectrical);
+	ScaLBL_FreeDeviceMemory(IonCoef);
+	ScaLBL_FreeDeviceMemory(dvcSpecies);
 	ScaLBL_FreeDeviceMemory(IonSolid);
 	ScaLBL_FreeDeviceMemory(FluidVelocityDummy);	
 }
@@ -975,6 +978,12 @@ void ScaLBL_IonModel::Create() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // barrier_free = false restores the global barriers in the time loop
+    ScaLBL_Comm->BarrierFree =
+        ion_db->getWithDefault<bool>("barrier_free", true);
+    // fused_species = true advances the species that share a sub-cycle count
+    // together, with one halo exchange and one sweep over the sites per step
+    FusedSpecies = ion_db->getWithDefault<bool>("fused_species", false);
 
     int Npad = (Np / 16 + 2) * 16;
     if (rank == 0)
@@ -996,10 +1005,11 @@ void ScaLBL_IonModel::Create() {
     int dist_mem_size = Np * sizeof(double);
     int neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
     ScaLBL_AllocateDeviceMemory((void **)&dvcMap, sizeof(int) * Np);
-    ScaLBL_AllocateDeviceMemory((void **)&fq,
-                                number_ion_species * 7 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&fq,
+                                      number_ion_species * 7 * dist_mem_size,
+                                      number_ion_species * 7);
     ScaLBL_AllocateDeviceMemory((void **)&Ci,
                                 number_ion_species * sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&ChargeDensity, sizeof(double) * Np);
@@ -1009,6 +1019,7 @@ void ScaLBL_IonModel::Create() {
                                 number_ion_species * 3 * sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&FluxElectrical,
                                 number_ion_species * 3 * sizeof(double) * Np);
+    SetSpeciesGroups();
     //...........................................................................
     // Update GPU data structures
     if (rank == 0)
@@ -1300,6 +1311,149 @@ void ScaLBL_IonModel::Initialize() {
         printf("*****************************************************\n");
 }
 
+void ScaLBL_IonModel::SetSpeciesGroups() {
+    // group the species by the number of internal iterations
+    SpeciesGroups.clear();
+    SpeciesGroupOffset.clear();
+    for (size_t ic = 0; ic < number_ion_species; ic++) {
+        size_t group = 0;
+        while (group < SpeciesGroups.size() &&
+               timestepMax[SpeciesGroups[group][0]] != timestepMax[ic])
+            group++;
+        if (group == SpeciesGroups.size())
+            SpeciesGroups.push_back(vector<int>());
+        SpeciesGroups[group].push_back(ic);
+    }
+    vector<int> species;
+    for (size_t group = 0; group < SpeciesGroups.size(); group++) {
+        SpeciesGroupOffset.push_back(species.size());
+        species.insert(species.end(), SpeciesGroups[group].begin(),
+                       SpeciesGroups[group].end());
+    }
+    vector<double> coef(3 * number_ion_species);
+    for (size_t ic = 0; ic < number_ion_species; ic++) {
+        coef[3 * ic] = IonDiffusivity[ic];
+        coef[3 * ic + 1] = IonValence[ic];
+        coef[3 * ic + 2] = 1.0 / tau[ic];
+    }
+    ScaLBL_AllocateDeviceMemory((void **)&IonCoef,
+                                3 * number_ion_species * sizeof(double));
+    ScaLBL_AllocateDeviceMemory((void **)&dvcSpecies,
+                                number_ion_species * sizeof(int));
+    ScaLBL_CopyToDevice(IonCoef, coef.data(),
+                        3 * number_ion_species * sizeof(double));
+    ScaLBL_CopyToDevice(dvcSpecies, species.data(),
+                        number_ion_species * sizeof(int));
+    if (rank == 0 && FusedSpecies)
+        printf("LB Ion Solver: advancing %zu ion species in %zu fused groups \n",
+               number_ion_species, SpeciesGroups.size());
+}
+
+void ScaLBL_IonModel::SetBoundaryConditions(size_t ic, double *Velocity,
+                                            double *ElectricField) {
+    if (BoundaryConditionInlet[ic] > 0) {
+        switch (BoundaryConditionInlet[ic]) {
+        case 1:
+            ScaLBL_Comm->D3Q7_Ion_Concentration_BC_z(
+                NeighborList, &fq[ic * Np * 7], Cin[ic], timestep);
+            break;
+        case 21:
+            ScaLBL_Comm->D3Q7_Ion_Flux_Diff_BC_z(
+                NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
+                &Velocity[2 * Np], timestep);
+            break;
+        case 22:
+            ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvc_BC_z(
+                NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
+                &Velocity[2 * Np], timestep);
+            break;
+        case 23:
+            ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvcElec_BC_z(
+                NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
+                &Velocity[2 * Np], &ElectricField[2 * Np],
+                IonDiffusivity[ic], IonValence[ic], Vt, timestep);
+            break;
+        }
+    }
+    if (BoundaryConditionOutlet[ic] > 0) {
+        switch (BoundaryConditionOutlet[ic]) {
+        case 1:
+            ScaLBL_Comm->D3Q7_Ion_Concentration_BC_Z(
+                NeighborList, &fq[ic * Np * 7], Cout[ic], timestep);
+            break;
+        case 21:
+            ScaLBL_Comm->D3Q7_Ion_Flux_Diff_BC_Z(
+                NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
+                &Velocity[2 * Np], timestep);
+            break;
+        case 22:
+            ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvc_BC_Z(
+                NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
+                &Velocity[2 * Np], timestep);
+            break;
+        case 23:
+            ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvcElec_BC_Z(
+                NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
+                &Velocity[2 * Np], &ElectricField[2 * Np],
+                IonDiffusivity[ic], IonValence[ic], Vt, timestep);
+            break;
+        }
+    }
+}
+
+void ScaLBL_IonModel::RunSpeciesGroup(size_t group, double *Velocity,
+                                      double *ElectricField) {
+    // advance all of the species in the group with one halo exchange per step
+    const vector<int> &species = SpeciesGroups[group];
+    int *dvcGroup = &dvcSpecies[SpeciesGroupOffset[group]];
+    int count = species.size();
+    timestep = 0;
+    while (timestep < timestepMax[species[0]]) {
+        //************************************************************************/
+        // *************ODD TIMESTEP*************//
+        timestep++;
+        ScaLBL_Comm->MultiSendD3Q7AA(fq, species); //READ FROM NORMAL
+        ScaLBL_D3Q7_AAodd_Ion_Multi(
+            NeighborList, fq, Ci, FluxDiffusive, FluxAdvective, FluxElectrical,
+            Velocity, ElectricField, IonCoef, dvcGroup, count, Vt,
+            ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        ScaLBL_Comm->MultiRecvD3Q7AA(fq, species); //WRITE INTO OPPOSITE
+        ScaLBL_Comm->StepBarrier();
+        for (int ic : species)
+            SetBoundaryConditions(ic, Velocity, ElectricField);
+        ScaLBL_D3Q7_AAodd_Ion_Multi(
+            NeighborList, fq, Ci, FluxDiffusive, FluxAdvective, FluxElectrical,
+            Velocity, ElectricField, IonCoef, dvcGroup, count, Vt, 0,
+            ScaLBL_Comm->LastExterior(), Np);
+        if (BoundaryConditionSolid == 1) {
+            for (int ic : species)
+                ScaLBL_Comm->SolidDirichletD3Q7(&fq[ic * Np * 7], IonSolid);
+        }
+        ScaLBL_Comm->StepBarrier();
+
+        // *************EVEN TIMESTEP*************//
+        timestep++;
+        ScaLBL_Comm->MultiSendD3Q7AA(fq, species); //READ FORM NORMAL
+        ScaLBL_D3Q7_AAeven_Ion_Multi(
+            fq, Ci, FluxDiffusive, FluxAdvective, FluxElectrical, Velocity,
+            ElectricField, IonCoef, dvcGroup, count, Vt,
+            ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+        ScaLBL_Comm->MultiRecvD3Q7AA(fq, species); //WRITE INTO OPPOSITE
+        ScaLBL_Comm->StepBarrier();
+        for (int ic : species)
+            SetBoundaryConditions(ic, Velocity, ElectricField);
+        ScaLBL_D3Q7_AAeven_Ion_Multi(
+            fq, Ci, FluxDiffusive, FluxAdvective, FluxElectrical, Velocity,
+            ElectricField, IonCoef, dvcGroup, count, Vt, 0,
+            ScaLBL_Comm->LastExterior(), Np);
+        if (BoundaryConditionSolid == 1) {
+            for (int ic : species)
+                ScaLBL_Comm->SolidDirichletD3Q7(&fq[ic * Np * 7], IonSolid);
+        }
+        ScaLBL_Comm->StepBarrier();
+    }
+}
+
 void ScaLBL_IonModel::Run(double *Velocity, double *ElectricField) {
 
     //Input parameter:
@@ -1318,7 +1472,9 @@ void ScaLBL_IonModel::Run(double *Velocity, double *ElectricField) {
     //auto t1 = std::chrono::system_clock::now();
 
     auto t1 = std::chrono::system_clock::now();
-    for (size_t ic = 0; ic < number_ion_species; ic++) {
+    for (size_t group = 0; FusedSpecies && group < SpeciesGroups.size(); group++)
+        RunSpeciesGroup(group, Velocity, ElectricField);
+    for (size_t ic = 0; !FusedSpecies && ic < number_ion_species; ic++) {
         timestep = 0;
         while (timestep < timestepMax[ic]) {
             //************************************************************************/
@@ -1330,56 +1486,9 @@ void ScaLBL_IonModel::Run(double *Velocity, double *ElectricField) {
                 NeighborList, &fq[ic * Np * 7], &Ci[ic * Np],
                 ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
             ScaLBL_Comm->RecvD3Q7AA(fq, ic); //WRITE INTO OPPOSITE
-            ScaLBL_Comm->Barrier();
+            ScaLBL_Comm->StepBarrier();
             //--------------------------------------- Set boundary conditions -------------------------------------//
-            if (BoundaryConditionInlet[ic] > 0) {
-                switch (BoundaryConditionInlet[ic]) {
-                case 1:
-                    ScaLBL_Comm->D3Q7_Ion_Concentration_BC_z(
-                        NeighborList, &fq[ic * Np * 7], Cin[ic], timestep);
-                    break;
-                case 21:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_Diff_BC_z(
-                        NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
-                        &Velocity[2 * Np], timestep);
-                    break;
-                case 22:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvc_BC_z(
-                        NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
-                        &Velocity[2 * Np], timestep);
-                    break;
-                case 23:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvcElec_BC_z(
-                        NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
-                        &Velocity[2 * Np], &ElectricField[2 * Np],
-                        IonDiffusivity[ic], IonValence[ic], Vt, timestep);
-                    break;
-                }
-            }
-            if (BoundaryConditionOutlet[ic] > 0) {
-                switch (BoundaryConditionOutlet[ic]) {
-                case 1:
-                    ScaLBL_Comm->D3Q7_Ion_Concentration_BC_Z(
-                        NeighborList, &fq[ic * Np * 7], Cout[ic], timestep);
-                    break;
-                case 21:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_Diff_BC_Z(
-                        NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
-                        &Velocity[2 * Np], timestep);
-                    break;
-                case 22:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvc_BC_Z(
-                        NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
-                        &Velocity[2 * Np], timestep);
-                    break;
-                case 23:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvcElec_BC_Z(
-                        NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
-                        &Velocity[2 * Np], &ElectricField[2 * Np],
-                        IonDiffusivity[ic], IonValence[ic], Vt, timestep);
-                    break;
-                }
-            }
+            SetBoundaryConditions(ic, Velocity, ElectricField);
             //----------------------------------------------------------------------------------------------------//
             ScaLBL_D3Q7_AAodd_IonConcentration(NeighborList, &fq[ic * Np * 7],
                                                &Ci[ic * Np], 0,
@@ -1403,8 +1512,7 @@ void ScaLBL_IonModel::Run(double *Velocity, double *ElectricField) {
                 //TODO IonSolid may also be species-dependent
                 ScaLBL_Comm->SolidDirichletD3Q7(&fq[ic * Np * 7], IonSolid);
             }
-            ScaLBL_Comm->Barrier();
-            comm.barrier();
+            ScaLBL_Comm->StepBarrier();
 
             // *************EVEN TIMESTEP*************//
             timestep++;
@@ -1414,56 +1522,9 @@ void ScaLBL_IonModel::Run(double *Velocity, double *ElectricField) {
                 &fq[ic * Np * 7], &Ci[ic * Np], ScaLBL_Comm->FirstInterior(),
                 ScaLBL_Comm->LastInterior(), Np);
             ScaLBL_Comm->RecvD3Q7AA(fq, ic); //WRITE INTO OPPOSITE
-            ScaLBL_Comm->Barrier();
+            ScaLBL_Comm->StepBarrier();
             //--------------------------------------- Set boundary conditions -------------------------------------//
-            if (BoundaryConditionInlet[ic] > 0) {
-                switch (BoundaryConditionInlet[ic]) {
-                case 1:
-                    ScaLBL_Comm->D3Q7_Ion_Concentration_BC_z(
-                        NeighborList, &fq[ic * Np * 7], Cin[ic], timestep);
-                    break;
-                case 21:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_Diff_BC_z(
-                        NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
-                        &Velocity[2 * Np], timestep);
-                    break;
-                case 22:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvc_BC_z(
-                        NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
-                        &Velocity[2 * Np], timestep);
-                    break;
-                case 23:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvcElec_BC_z(
-                        NeighborList, &fq[ic * Np * 7], Cin[ic], tau[ic],
-                        &Velocity[2 * Np], &ElectricField[2 * Np],
-                        IonDiffusivity[ic], IonValence[ic], Vt, timestep);
-                    break;
-                }
-            }
-            if (BoundaryConditionOutlet[ic] > 0) {
-                switch (BoundaryConditionOutlet[ic]) {
-                case 1:
-                    ScaLBL_Comm->D3Q7_Ion_Concentration_BC_Z(
-                        NeighborList, &fq[ic * Np * 7], Cout[ic], timestep);
-                    break;
-                case 21:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_Diff_BC_Z(
-                        NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
-                        &Velocity[2 * Np], timestep);
-                    break;
-                case 22:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvc_BC_Z(
-                        NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
-                        &Velocity[2 * Np], timestep);
-                    break;
-                case 23:
-                    ScaLBL_Comm->D3Q7_Ion_Flux_DiffAdvcElec_BC_Z(
-                        NeighborList, &fq[ic * Np * 7], Cout[ic], tau[ic],
-                        &Velocity[2 * Np], &ElectricField[2 * Np],
-                        IonDiffusivity[ic], IonValence[ic], Vt, timestep);
-                    break;
-                }
-            }
+            SetBoundaryConditions(ic, Velocity, ElectricField);
             //----------------------------------------------------------------------------------------------------//
             ScaLBL_D3Q7_AAeven_IonConcentration(&fq[ic * Np * 7], &Ci[ic * Np],
                                                 0, ScaLBL_Comm->LastExterior(),
@@ -1486,8 +1547,7 @@ void ScaLBL_IonModel::Run(double *Velocity, double *ElectricField) {
                 //TODO IonSolid may also be species-dependent
                 ScaLBL_Comm->SolidDirichletD3Q7(&fq[ic * Np * 7], IonSolid);
             }
-            ScaLBL_Comm->Barrier();
-            comm.barrier();
+            ScaLBL_Comm->StepBarrier();
         }
     }
 
@@ -1603,8 +1663,7 @@ void ScaLBL_IonModel::RunMembrane(double *Velocity, double *ElectricField, doubl
 
 			IonMembrane->IonTransport(&fq[ic * Np * 7],&Ci[ic * Np]);
 
-			ScaLBL_Comm->Barrier();
-			comm.barrier();
+			ScaLBL_Comm->StepBarrier();
 
 			/*
             if (BoundaryConditionSolid == 1) {
@@ -56,6 +56,7 @@ public:
     int timestep;
     vector<int> timestepMax;
     int BoundaryConditionSolid;
+    bool FusedSpecies; // advance the species with the same timestepMax together
     double h; //domain resolution, unit [um/lu]
     double kb, electron_charge, T, Vt;
     double k2_inv;
@@ -105,6 +106,8 @@ public:
     double *FluxDiffusive;
     double *FluxAdvective;
     double *FluxElectrical;
+    double *IonCoef;  // (diffusivity, valence, 1/tau) for each species
+    int *dvcSpecies;  // species grouped by timestepMax (see SpeciesGroups)
     
     /* these support membrane capabilities      */
     bool USE_MEMBRANE;
@@ -129,6 +132,12 @@ private:
                                          const vector<std::string> &File_ion,
                                          int ic);
     void AssignIonConcentrationMembrane( double *Ci, int ic);
+    void SetSpeciesGroups();
+    void SetBoundaryConditions(size_t ic, double *Velocity, double *ElectricField);
+    void RunSpeciesGroup(size_t group, double *Velocity, double *ElectricField);
+    // species that share a sub-cycle count, stored one after the other in dvcSpecies
+    vector<vector<int>> SpeciesGroups;
+    vector<int> SpeciesGroupOffset;
 
     void IonConcentration_LB_to_Phys(DoubleArray &Den_reg);
     void IonFlux_LB_to_Phys(DoubleArray &Den_reg, const size_t ic);
@@ -26,7 +26,8 @@ ScaLBL_MRTModel::ScaLBL_MRTModel(int RANK, int NP, const Utilities::MPI &COMM)
     : rank(RANK), nprocs(NP), Restart(0), timestep(0), timestepMax(0), tau(0),
       Fx(0), Fy(0), Fz(0), flux(0), din(0), dout(0), mu(0), Nx(0), Ny(0), Nz(0),
       N(0), Np(0), nprocx(0), nprocy(0), nprocz(0), BoundaryCondition(0), Lx(0),
-      Ly(0), Lz(0), comm(COMM) {}
+      Ly(0), Lz(0), SinglePrecision(false), fq(nullptr), fq_float(nullptr),
+      comm(COMM) {}
 
 
 ScaLBL_MRTModel::~ScaLBL_MRTModel() {}
@@ -78,6 +79,16 @@ void ScaLBL_MRTModel::ReadParams(string filename) {
     if (mrt_db->keyExists("flux")) {
         flux = mrt_db->getScalar<double>("flux");
     }
+    // precision used to store the distributions ("double" or "single")
+    auto precision = mrt_db->getWithDefault<std::string>("precision", "double");
+    if (precision == "single")
+        SinglePrecision = true;
+    else if (precision != "double")
+        ERROR("Unknown MRT precision " + precision);
+#ifndef SCALBL_FLOAT_STORAGE
+    if (SinglePrecision)
+        ERROR("MRT: single precision is only implemented for the cpu backend");
+#endif
 
     // Read domain parameters
     if (mrt_db->keyExists("BoundaryCondition")) {
@@ -202,6 +213,10 @@ void ScaLBL_MRTModel::Create() {
     // ScaLBL_Communicator ScaLBL_Comm(Mask); // original
     ScaLBL_Comm =
         std::shared_ptr<ScaLBL_Communicator>(new ScaLBL_Communicator(Mask));
+    // timing = true writes the time spent in each phase to timing.csv / timing.json
+    Timer = std::make_shared<PhaseTimer>(comm);
+    Timer->enable(mrt_db->getWithDefault<bool>("timing", false));
+    ScaLBL_Comm->SetTimer(Timer);
 
     int Npad = (Np / 16 + 2) * 16;
     if (rank == 0)
@@ -223,8 +238,12 @@ void ScaLBL_MRTModel::Create() {
     int dist_mem_size = Np * sizeof(double);
     int neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
-    ScaLBL_AllocateDeviceMemory((void **)&fq, 19 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
+    if (SinglePrecision)
+        ScaLBL_AllocateDistributionMemory((void **)&fq_float,
+                                          19 * Np * sizeof(float), 19);
+    else
+        ScaLBL_AllocateDistributionMemory((void **)&fq, 19 * dist_mem_size, 19);
     ScaLBL_AllocateDeviceMemory((void **)&Pressure, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Velocity, 3 * sizeof(double) * Np);
     //...........................................................................
@@ -234,8 +253,15 @@ void ScaLBL_MRTModel::Create() {
     // copy the neighbor list
     ScaLBL_CopyToDevice(NeighborList, neighborList, neighborSize);
     comm.barrier();
-    double MLUPS = ScaLBL_Comm->GetPerformance(NeighborList, fq, Np);
-    printf("  MLPUS=%f from rank %i\n", MLUPS, rank);
+    double MLUPS;
+#ifdef SCALBL_FLOAT_STORAGE
+    if (SinglePrecision)
+        MLUPS = ScaLBL_Comm->GetPerformance(NeighborList, fq_float, Np);
+    else
+#endif
+        MLUPS = ScaLBL_Comm->GetPerformance(NeighborList, fq, Np);
+    printf("  MLPUS=%f from rank %i (%s layout)\n", MLUPS, rank,
+           ScaLBL_Comm->LayoutOrdering.c_str());
 }
 
 void ScaLBL_MRTModel::Initialize() {
@@ -244,7 +270,70 @@ void ScaLBL_MRTModel::Initialize() {
 	 */
     if (rank == 0)
         printf("Initializing distributions \n");
-    ScaLBL_D3Q19_Init(fq, Np);
+#ifdef SCALBL_FLOAT_STORAGE
+    if (SinglePrecision)
+        ScaLBL_D3Q19_Init_float(fq_float, Np);
+    else
+#endif
+        ScaLBL_D3Q19_Init(fq, Np);
+}
+
+template <class TYPE>
+void ScaLBL_MRTModel::Step(TYPE *fq, double rlx_setA, double rlx_setB) {
+    timestep++;
+    ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
+    Timer->start(PhaseTimer::INTERIOR);
+    ScaLBL_D3Q19_AAodd_MRT(NeighborList, fq, ScaLBL_Comm->FirstInterior(),
+                           ScaLBL_Comm->LastInterior(), Np, rlx_setA,
+                           rlx_setB, Fx, Fy, Fz);
+    Timer->stop();
+    ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
+    // Set boundary conditions
+    Timer->start(PhaseTimer::BC);
+    if (BoundaryCondition == 3) {
+        ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
+        ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
+    } else if (BoundaryCondition == 4) {
+        din = ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
+        ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
+    } else if (BoundaryCondition == 5) {
+        ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
+        ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
+    }
+    Timer->stop();
+    Timer->start(PhaseTimer::EXTERIOR);
+    ScaLBL_D3Q19_AAodd_MRT(NeighborList, fq, 0, ScaLBL_Comm->LastExterior(),
+                           Np, rlx_setA, rlx_setB, Fx, Fy, Fz);
+    Timer->stop();
+    ScaLBL_DeviceBarrier();
+    comm.barrier();
+    timestep++;
+    ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
+    Timer->start(PhaseTimer::INTERIOR);
+    ScaLBL_D3Q19_AAeven_MRT(fq, ScaLBL_Comm->FirstInterior(),
+                            ScaLBL_Comm->LastInterior(), Np, rlx_setA,
+                            rlx_setB, Fx, Fy, Fz);
+    Timer->stop();
+    ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
+    // Set boundary conditions
+    Timer->start(PhaseTimer::BC);
+    if (BoundaryCondition == 3) {
+        ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
+        ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
+    } else if (BoundaryCondition == 4) {
+        din = ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
+        ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
+    } else if (BoundaryCondition == 5) {
+        ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
+        ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
+    }
+    Timer->stop();
+    Timer->start(PhaseTimer::EXTERIOR);
+    ScaLBL_D3Q19_AAeven_MRT(fq, 0, ScaLBL_Comm->LastExterior(), Np,
+                            rlx_setA, rlx_setB, Fx, Fy, Fz);
+    Timer->stop();
+    ScaLBL_DeviceBarrier();
+    comm.barrier();
 }
 
 void ScaLBL_MRTModel::Run() {
@@ -281,54 +370,22 @@ void ScaLBL_MRTModel::Run() {
     auto t1 = std::chrono::system_clock::now();
     while (timestep < timestepMax && error > tolerance) {
         //************************************************************************/
-        timestep++;
-        ScaLBL_Comm->SendD3Q19AA(fq); //READ FROM NORMAL
-        ScaLBL_D3Q19_AAodd_MRT(NeighborList, fq, ScaLBL_Comm->FirstInterior(),
-                               ScaLBL_Comm->LastInterior(), Np, rlx_setA,
-                               rlx_setB, Fx, Fy, Fz);
-        ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
-        // Set boundary conditions
-        if (BoundaryCondition == 3) {
-            ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 4) {
-            din =
-                ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 5) {
-            ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
-            ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
-        }
-        ScaLBL_D3Q19_AAodd_MRT(NeighborList, fq, 0, ScaLBL_Comm->LastExterior(),
-                               Np, rlx_setA, rlx_setB, Fx, Fy, Fz);
-        ScaLBL_DeviceBarrier();
-        comm.barrier();
-        timestep++;
-        ScaLBL_Comm->SendD3Q19AA(fq); //READ FORM NORMAL
-        ScaLBL_D3Q19_AAeven_MRT(fq, ScaLBL_Comm->FirstInterior(),
-                                ScaLBL_Comm->LastInterior(), Np, rlx_setA,
-                                rlx_setB, Fx, Fy, Fz);
-        ScaLBL_Comm->RecvD3Q19AA(fq); //WRITE INTO OPPOSITE
-        // Set boundary conditions
-        if (BoundaryCondition == 3) {
-            ScaLBL_Comm->D3Q19_Pressure_BC_z(NeighborList, fq, din, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 4) {
-            din =
-                ScaLBL_Comm->D3Q19_Flux_BC_z(NeighborList, fq, flux, timestep);
-            ScaLBL_Comm->D3Q19_Pressure_BC_Z(NeighborList, fq, dout, timestep);
-        } else if (BoundaryCondition == 5) {
-            ScaLBL_Comm->D3Q19_Reflection_BC_z(fq);
-            ScaLBL_Comm->D3Q19_Reflection_BC_Z(fq);
-        }
-        ScaLBL_D3Q19_AAeven_MRT(fq, 0, ScaLBL_Comm->LastExterior(), Np,
-                                rlx_setA, rlx_setB, Fx, Fy, Fz);
-        ScaLBL_DeviceBarrier();
-        comm.barrier();
+#ifdef SCALBL_FLOAT_STORAGE
+        if (SinglePrecision)
+            Step(fq_float, rlx_setA, rlx_setB);
+        else
+#endif
+            Step(fq, rlx_setA, rlx_setB);
         //************************************************************************/
 
         if (timestep % ANALYSIS_INTERVAL == 0) {
-            ScaLBL_D3Q19_Momentum(fq, Velocity, Np);
+            Timer->start(PhaseTimer::ANALYSIS);
+#ifdef SCALBL_FLOAT_STORAGE
+            if (SinglePrecision)
+                ScaLBL_D3Q19_Momentum_float(fq_float, Velocity, Np);
+            else
+#endif
+                ScaLBL_D3Q19_Momentum(fq, Velocity, Np);
             ScaLBL_DeviceBarrier();
             comm.barrier();
             ScaLBL_Comm->RegularLayout(Map, &Velocity[0], Velocity_x);
@@ -405,6 +462,8 @@ void ScaLBL_MRTModel::Run() {
                         h * Hs, Xs, vax, vay, vaz, absperm);
                 fclose(log_file);
             }
+            Timer->stop();
+            Timer->write(timestep);
         }
     }
     //************************************************************************/
@@ -47,6 +47,7 @@ public:
     void VelocityField();
 
     bool Restart, pBC;
+    bool SinglePrecision; // store the distributions as (shifted) float
     int timestep, timestepMax;
     int ANALYSIS_INTERVAL;
     int BoundaryCondition;
@@ -62,6 +63,7 @@ public:
     std::shared_ptr<Domain> Dm;   // this domain is for analysis
     std::shared_ptr<Domain> Mask; // this domain is for lbm
     std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm;
+    std::shared_ptr<PhaseTimer> Timer;
     // input database
     std::shared_ptr<Database> db;
     std::shared_ptr<Database> domain_db;
@@ -72,6 +74,7 @@ public:
     DoubleArray Distance;
     int *NeighborList;
     double *fq;
+    float *fq_float;
     double *Velocity;
     double *Pressure;
 
@@ -91,4 +94,7 @@ private:
 
     //int rank,nprocs;
     void LoadParams(std::shared_ptr<Database> db0);
+    // advance two timesteps (odd, then even) for distributions stored as TYPE
+    template <class TYPE>
+    void Step(TYPE *fq, double rlx_setA, double rlx_setB);
 };
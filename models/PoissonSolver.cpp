@@ -15,12 +15,12 @@ static inline bool fileExists( const std::string &filename )
 
 ScaLBL_Poisson::ScaLBL_Poisson(int RANK, int NP, const Utilities::MPI& COMM):
     rank(RANK), TIMELOG(nullptr), nprocs(NP),timestep(0),timestepMax(0),tau(0),k2_inv(0),tolerance(0),h(0),
-    epsilon0(0),epsilon0_LB(0),epsilonR(0),epsilon_LB(0),Vin(0),Vout(0),Nx(0),Ny(0),Nz(0),N(0),Np(0),analysis_interval(0),
+    epsilon0(0),epsilon0_LB(0),epsilonR(0),epsilon_LB(0),Vin(0),Vout(0),Nx(0),Ny(0),Nz(0),N(0),Np(0),analysis_interval(0),max_analysis_interval(0),cg_tolerance(0),adaptive_convergence(0),
     chargeDen_dummy(0),WriteLog(0),nprocx(0),nprocy(0),nprocz(0),
     BoundaryConditionInlet(0),BoundaryConditionOutlet(0),BoundaryConditionSolidList(0),Lx(0),Ly(0),Lz(0),
     Vin0(0),freqIn(0),PhaseShift_In(0),Vout0(0),freqOut(0),PhaseShift_Out(0),
     TestPeriodic(0),TestPeriodicTime(0),TestPeriodicTimeConv(0),TestPeriodicSaveInterval(0),
-    comm(COMM)
+    comm(COMM),error_sum(0),error_count(0),error_max(0)
 {
     if ( rank == 0 ) {
 	    bool WriteHeader = !fileExists( "PoissonSolver_Convergence.csv" );
@@ -46,7 +46,11 @@ ScaLBL_Poisson::~ScaLBL_Poisson()
 
 void ScaLBL_Poisson::ReadParams(string filename){
 	// read the input database 
-	db = std::make_shared<Database>( filename );
+	ReadParams( std::make_shared<Database>( filename ) );
+}
+
+void ScaLBL_Poisson::ReadParams(std::shared_ptr<Database> db0){
+	db = db0;
 	domain_db = db->getDatabase( "Domain" );
 	electric_db = db->getDatabase( "Poisson" );
 	
@@ -87,6 +91,12 @@ void ScaLBL_Poisson::ReadParams(string filename){
     //'tolerance_method' can be {"MSE","MSE_max"}
 	tolerance_method = electric_db->getWithDefault<std::string>( "tolerance_method", "MSE" );
 	lattice_scheme = electric_db->getWithDefault<std::string>( "lattice_scheme", "D3Q19" );
+	// 'solver' can be {"LB","CG"}
+	solver = electric_db->getWithDefault<std::string>( "solver", "LB" );
+	cg_tolerance = electric_db->getWithDefault<double>( "cg_tolerance", 1.0e-8 );
+	// Schedule the convergence checks from the estimated convergence rate
+	adaptive_convergence = electric_db->getWithDefault<bool>( "adaptive_convergence", false );
+	max_analysis_interval = electric_db->getWithDefault<int>( "max_analysis_interval", 10*analysis_interval );
 	if (electric_db->keyExists( "epsilonR" )){
 		epsilonR = electric_db->getScalar<double>( "epsilonR" );
 	}
@@ -139,6 +149,8 @@ void ScaLBL_Poisson::ReadParams(string filename){
     epsilon0_LB = epsilon0*(h*1.0e-6);//unit:[C/(V*lu)]
     epsilon_LB = epsilon0_LB*epsilonR;//electric permittivity 
     
+    monitor = std::make_shared<ConvergenceMonitor>( tolerance, analysis_interval, max_analysis_interval, adaptive_convergence );
+
     /* restart string */
     sprintf(LocalRankString, "%05d", rank);
     sprintf(LocalRestartFile, "%s%s", "Psi.", LocalRankString);
@@ -156,6 +168,15 @@ void ScaLBL_Poisson::ReadParams(string filename){
     else{
         if (rank==0) printf("LB-Poisson Solver: tolerance_method=%s cannot be identified!\n",tolerance_method.c_str());
     }
+    if (solver.compare("CG")==0){
+        if (rank==0) printf("LB-Poisson Solver: Use conjugate gradient solver (relative tolerance = %.3g).\n",cg_tolerance);
+    }
+    else if (solver.compare("LB")!=0){
+        ERROR("Error: LB-Poisson Solver: solver="+solver+" cannot be identified; use LB or CG! \n");
+    }
+    if (adaptive_convergence){
+        if (rank==0) printf("LB-Poisson Solver: Check convergence adaptively every %i-%i time steps.\n",analysis_interval,max_analysis_interval);
+    }
     if (lattice_scheme.compare("D3Q7")==0){
         if (rank==0) printf("LB-Poisson Solver: Use D3Q7 lattice structure.\n");
     }
@@ -379,10 +400,10 @@ void ScaLBL_Poisson::Create(){
 	ScaLBL_AllocateDeviceMemory((void **) &ElectricField, 3*sizeof(double)*Np);
 	ScaLBL_AllocateDeviceMemory((void **) &ResidualError, sizeof(double)*Np);
     if (lattice_scheme.compare("D3Q7")==0){
-	    ScaLBL_AllocateDeviceMemory((void **) &fq, 7*dist_mem_size);  
+	    ScaLBL_AllocateDistributionMemory((void **) &fq, 7*dist_mem_size, 7);  
     }
     else if (lattice_scheme.compare("D3Q19")==0){
-	    ScaLBL_AllocateDeviceMemory((void **) &fq, 19*dist_mem_size);  
+	    ScaLBL_AllocateDistributionMemory((void **) &fq, 19*dist_mem_size, 19);  
     }
 	//...........................................................................
 	
@@ -616,6 +637,13 @@ void ScaLBL_Poisson::Initialize(double time_conv_from_Study){
     psi_BCLabel_host = new int [Nx*Ny*Nz];
     time_conv = time_conv_from_Study;
     AssignSolidBoundary(psi_host,psi_BCLabel_host);//step1
+    if (solver.compare("CG")==0){
+        // keep the solid boundary values for the conjugate gradient solver
+        cg_solid.resize(Nx,Ny,Nz);
+        cg_solid.copy(psi_host);
+        cg_label.resize(Nx,Ny,Nz);
+        cg_label.copy(psi_BCLabel_host);
+    }
     Potential_Init(psi_host);//step2
 	ScaLBL_CopyToDevice(Psi, psi_host, Nx*Ny*Nz*sizeof(double));
 	ScaLBL_CopyToDevice(Psi_BCLabel, psi_BCLabel_host, Nx*Ny*Nz*sizeof(int));
@@ -718,9 +746,17 @@ void ScaLBL_Poisson::Initialize(double time_conv_from_Study){
 
 void ScaLBL_Poisson::Run(double *ChargeDensity, bool UseSlippingVelBC, int timestep_from_Study){
     
+    if (solver.compare("CG")==0){
+        SolvePoissonCG(ChargeDensity, UseSlippingVelBC, timestep_from_Study);
+        return;
+    }
     double error = 1.0;
+    BatchedReduction reduction(Dm->Comm);
+    int check_step = 0;
+    monitor->reset();
     if (lattice_scheme.compare("D3Q7")==0){
         timestep=0;
+        int snapshot_step = 2;
         while (timestep < timestepMax && error > tolerance) {
             //************************************************************************/
             // *************ODD TIMESTEP*************//
@@ -736,61 +772,26 @@ void ScaLBL_Poisson::Run(double *ChargeDensity, bool UseSlippingVelBC, int times
             ScaLBL_Comm->Barrier(); comm.barrier();
             //************************************************************************/
 
-            // Check convergence of steady-state solution
-            if (timestep==2){
-                //save electric potential for convergence check
-                ScaLBL_CopyToHost(Psi_previous.data(),Psi,sizeof(double)*Nx*Ny*Nz);
+            // Complete the convergence check started on the previous iteration
+            if (reduction.active()){
+                error = FinishConvergenceCheck(reduction);
+                monitor->update(check_step, error);
+                snapshot_step = monitor->next() - analysis_interval;
             }
-            if (timestep%analysis_interval==0){
-                if (tolerance_method.compare("MSE")==0){
-                    double count_loc=0;
-                    double count;
-                    double MSE_loc=0.0;
-                    ScaLBL_CopyToHost(Psi_host.data(),Psi,sizeof(double)*Nx*Ny*Nz);
-                    for (int k=1; k<Nz-1; k++){
-                        for (int j=1; j<Ny-1; j++){
-                            for (int i=1; i<Nx-1; i++){
-                                if (Distance(i,j,k) > 0){
-                                    MSE_loc += (Psi_host(i,j,k) - Psi_previous(i,j,k))*(Psi_host(i,j,k) - Psi_previous(i,j,k));
-                                    count_loc+=1.0;
-                                }
-                            }
-                        }
-                    }
-                    error=Dm->Comm.sumReduce(MSE_loc);
-                    count=Dm->Comm.sumReduce(count_loc);
-                    error /= count;
-                }
-                else if (tolerance_method.compare("MSE_max")==0){
-                    vector<double>MSE_loc;
-                    double MSE_loc_max;
-                    ScaLBL_CopyToHost(Psi_host.data(),Psi,sizeof(double)*Nx*Ny*Nz);
-                    for (int k=1; k<Nz-1; k++){
-                        for (int j=1; j<Ny-1; j++){
-                            for (int i=1; i<Nx-1; i++){
-                                if (Distance(i,j,k) > 0){
-                                    MSE_loc.push_back((Psi_host(i,j,k) - Psi_previous(i,j,k))*(Psi_host(i,j,k) - Psi_previous(i,j,k)));
-                                }
-                            }
-                        }
-                    }
-                    vector<double>::iterator it_max = max_element(MSE_loc.begin(),MSE_loc.end());
-                    unsigned int idx_max=distance(MSE_loc.begin(),it_max);
-                    MSE_loc_max=MSE_loc[idx_max];
-                    error=Dm->Comm.maxReduce(MSE_loc_max);
-                }
-                else{
-                    ERROR("Error: user-specified tolerance_method cannot be identified; check you input database! \n");
-                }
+            // Save the electric potential one analysis interval before the next check
+            if (snapshot_step > check_step && timestep >= snapshot_step){
                 ScaLBL_CopyToHost(Psi_previous.data(),Psi,sizeof(double)*Nx*Ny*Nz);
+                snapshot_step = 0;
+            }
+            // Check convergence of steady-state solution
+            if (error > tolerance && monitor->check(timestep)){
+                check_step = timestep;
+                StartConvergenceCheck(reduction);
             }
         }
     }
     else if (lattice_scheme.compare("D3Q19")==0){
 
-        double *host_Error;
-        host_Error = new double [Np];
-
         timestep=0;
         auto t1 = std::chrono::system_clock::now();
         while (timestep < timestepMax && error > tolerance) {
@@ -808,28 +809,15 @@ void ScaLBL_Poisson::Run(double *ChargeDensity, bool UseSlippingVelBC, int times
             ScaLBL_Comm->Barrier(); comm.barrier();
             //************************************************************************/
 
-            // Check convergence of steady-state solution
-            if (timestep==2){
-                //save electric potential for convergence check
+            // Complete the convergence check started on the previous iteration
+            if (reduction.active()){
+                error = FinishConvergenceCheck(reduction);
+                monitor->update(check_step, error);
             }
-            if (timestep%analysis_interval==0){
-          /* get the elecric potential */
-                ScaLBL_CopyToHost(Psi_host.data(),Psi,sizeof(double)*Nx*Ny*Nz);
-                if (rank==0) printf("   ... getting Poisson solver error \n");
-                double err = 0.0;
-                double max_error = 0.0;
-                ScaLBL_CopyToHost(host_Error,ResidualError,sizeof(double)*Np);
-                for (int idx=0; idx<Np; idx++){
-                    err = host_Error[idx]*host_Error[idx];
-                    if (err > max_error ){
-                        max_error = err;
-                    }
-                }
-                error=Dm->Comm.maxReduce(max_error);
-
-                /* compute the eletric field */
-                //ScaLBL_D3Q19_Poisson_getElectricField(fq, ElectricField, tau, Np);
-
+            // Check convergence of steady-state solution
+            if (error > tolerance && monitor->check(timestep)){
+                check_step = timestep;
+                StartConvergenceCheck(reduction);
             }
         }
         if (rank == 0)
@@ -852,9 +840,15 @@ void ScaLBL_Poisson::Run(double *ChargeDensity, bool UseSlippingVelBC, int times
             printf("Lattice update rate (total)= %f MLUPS \n", MLUPS);
         if (rank == 0)
             printf("********************************************************\n");
-        delete [] host_Error;
 
     }
+    if (reduction.active()){
+        error = FinishConvergenceCheck(reduction);
+        monitor->update(check_step, error);
+    }
+    if (rank == 0 && WriteLog)
+        printf("LB-Poisson Solver: %i time steps, %i convergence checks, error = %.5g \n",
+               timestep, monitor->checks(), error);
     //************************************************************************/
 
     if(WriteLog==true){
@@ -864,6 +858,11 @@ void ScaLBL_Poisson::Run(double *ChargeDensity, bool UseSlippingVelBC, int times
 
 void ScaLBL_Poisson::Run(double *ChargeDensity, DoubleArray MembraneDistance, bool UseSlippingVelBC, int timestep_from_Study){
 
+	if (solver.compare("CG")==0){
+		// the far-field rescaling is not needed since CG does not relax in time
+		SolvePoissonCG(ChargeDensity, UseSlippingVelBC, timestep_from_Study);
+		return;
+	}
 	double error = 1.0;
 	double threshold = 10000000.0;
 	bool SET_THRESHOLD = false;
@@ -874,8 +873,9 @@ void ScaLBL_Poisson::Run(double *ChargeDensity, DoubleArray MembraneDistance, bo
 	if (BoundaryConditionInlet > 0)    SET_THRESHOLD = false;
 	if (BoundaryConditionOutlet > 0)   SET_THRESHOLD = false;
 	
-	double *host_Error;
-	host_Error = new double [Np];
+	BatchedReduction reduction(Dm->Comm);
+	int check_step = 0;
+	monitor->reset();
 
 	timestep=0;
 	auto t1 = std::chrono::system_clock::now();
@@ -894,26 +894,14 @@ void ScaLBL_Poisson::Run(double *ChargeDensity, DoubleArray MembraneDistance, bo
 		ScaLBL_Comm->Barrier(); comm.barrier();
 		//************************************************************************/
 
-		// Check convergence of steady-state solution
-		if (timestep==2){
-			//save electric potential for convergence check
-		}
-		if (timestep%analysis_interval==0){
-			/* get the elecric potential */
-			ScaLBL_CopyToHost(Psi_host.data(),Psi,sizeof(double)*Nx*Ny*Nz);
-			if (rank==0) printf("   ... getting Poisson solver error \n");
-			double err = 0.0;
-			double max_error = 0.0;
-			ScaLBL_CopyToHost(host_Error,ResidualError,sizeof(double)*Np);
-			for (int idx=0; idx<Np; idx++){
-				err = host_Error[idx]*host_Error[idx];
-				if (err > max_error ){
-					max_error = err;
-				}
-			}
-			error=Dm->Comm.maxReduce(max_error);
+		// Complete the convergence check started on the previous iteration
+		if (reduction.active()){
+			error = FinishConvergenceCheck(reduction);
+			monitor->update(check_step, error);
 
 			if (error > tolerance && SET_THRESHOLD){
+				/* get the elecric potential */
+				ScaLBL_CopyToHost(Psi_host.data(),Psi,sizeof(double)*Nx*Ny*Nz);
 				/* don't use this with an external BC */
 				// cpompute the far-field electric potential
 				double inside_local = 0.0;
@@ -968,9 +956,16 @@ void ScaLBL_Poisson::Run(double *ChargeDensity, DoubleArray MembraneDistance, bo
 				}				
 				ScaLBL_CopyToDevice(Psi,Psi_host.data(),sizeof(double)*Nx*Ny*Nz);
 			}
-			/* compute the eletric field */
-			//ScaLBL_D3Q19_Poisson_getElectricField(fq, ElectricField, tau, Np);
 		}
+		// Check convergence of steady-state solution
+		if (error > tolerance && monitor->check(timestep)){
+			check_step = timestep;
+			StartConvergenceCheck(reduction);
+		}
+	}
+	if (reduction.active()){
+		error = FinishConvergenceCheck(reduction);
+		monitor->update(check_step, error);
 	}
 	if (rank == 0)
 		printf("---------------------------------------------------------------"
@@ -992,7 +987,9 @@ void ScaLBL_Poisson::Run(double *ChargeDensity, DoubleArray MembraneDistance, bo
 		printf("Lattice update rate (total)= %f MLUPS \n", MLUPS);
 	if (rank == 0)
 		printf("********************************************************\n");
-	delete [] host_Error;
+	if (rank == 0 && WriteLog)
+		printf("LB-Poisson Solver: %i time steps, %i convergence checks, error = %.5g \n",
+		       timestep, monitor->checks(), error);
 
 	//************************************************************************/
 	if(WriteLog==true){
@@ -1007,6 +1004,62 @@ void ScaLBL_Poisson::getConvergenceLog(int timestep,double error){
     }
 }
 
+void ScaLBL_Poisson::StartConvergenceCheck(BatchedReduction &reduction){
+    /*
+     * Compute the local error and begin the global reduction; the reduction
+     * is completed by FinishConvergenceCheck after further time steps
+     */
+    if (lattice_scheme.compare("D3Q7")==0){
+        // Change in the electric potential since the last snapshot
+        double count_loc=0.0;
+        double MSE_loc=0.0;
+        double MSE_loc_max=0.0;
+        ScaLBL_CopyToHost(Psi_host.data(),Psi,sizeof(double)*Nx*Ny*Nz);
+        for (int k=1; k<Nz-1; k++){
+            for (int j=1; j<Ny-1; j++){
+                for (int i=1; i<Nx-1; i++){
+                    if (Distance(i,j,k) > 0){
+                        double diff = Psi_host(i,j,k) - Psi_previous(i,j,k);
+                        MSE_loc += diff*diff;
+                        MSE_loc_max = std::max(MSE_loc_max, diff*diff);
+                        count_loc+=1.0;
+                    }
+                }
+            }
+        }
+        Psi_previous.copy(Psi_host.data());
+        if (tolerance_method.compare("MSE")==0){
+            reduction.sum(MSE_loc, error_sum);
+            reduction.sum(count_loc, error_count);
+        }
+        else if (tolerance_method.compare("MSE_max")==0){
+            reduction.max(MSE_loc_max, error_max);
+        }
+        else{
+            ERROR("Error: user-specified tolerance_method cannot be identified; check you input database! \n");
+        }
+    }
+    else{
+        // Residual of the LB-Poisson solver
+        if (rank==0) printf("   ... getting Poisson solver error \n");
+        std::vector<double> host_Error(Np);
+        ScaLBL_CopyToHost(host_Error.data(),ResidualError,sizeof(double)*Np);
+        double max_error = 0.0;
+        for (int idx=0; idx<Np; idx++){
+            max_error = std::max(max_error, host_Error[idx]*host_Error[idx]);
+        }
+        reduction.max(max_error, error_max);
+    }
+    reduction.start();
+}
+
+double ScaLBL_Poisson::FinishConvergenceCheck(BatchedReduction &reduction){
+    reduction.finish();
+    if (lattice_scheme.compare("D3Q7")==0 && tolerance_method.compare("MSE")==0)
+        return error_count > 0 ? error_sum/error_count : 0.0;
+    return error_max;
+}
+
 void ScaLBL_Poisson::SolveElectricPotentialAAodd(int timestep_from_Study){
 
     if (lattice_scheme.compare("D3Q7")==0){
@@ -1249,6 +1302,229 @@ void ScaLBL_Poisson::SolvePoissonAAeven(double *ChargeDensity, bool UseSlippingV
     }
 }
 
+// Neighbors used by the conjugate gradient solver: the six faces (D3Q7) followed by the twelve edges (D3Q19)
+static const int PoissonStencil[18][3] = {
+    {1,0,0},{-1,0,0},{0,1,0},{0,-1,0},{0,0,1},{0,0,-1},
+    {1,1,0},{-1,-1,0},{1,-1,0},{-1,1,0},{1,0,1},{-1,0,-1},
+    {1,0,-1},{-1,0,1},{0,1,1},{0,-1,-1},{0,1,-1},{0,-1,1}};
+
+void ScaLBL_Poisson::SolvePoissonCG(double *ChargeDensity, bool UseSlippingVelBC, int timestep_from_Study){
+    /*
+     * Solve the steady-state problem of the LB-Poisson solver directly with a
+     * Jacobi preconditioned conjugate gradient method on the regular grid.
+     * The stencil is the steady state of the lattice scheme (Laplacian = -rho_e):
+     *   D3Q7: weight 1 for faces; D3Q19: weight 1/3 for faces and 1/6 for edges
+     * Solid neighbors follow BC_SolidList: Dirichlet values are imposed half-way
+     * along the link, surface charges are added to the adjacent fluid site, and
+     * other solids are zero-flux.  The inlet/outlet potentials are imposed on the
+     * halo layer as in the lattice scheme.  The previous Psi is the initial guess.
+     */
+    auto t1 = std::chrono::system_clock::now();
+    int Q = (lattice_scheme.compare("D3Q7")==0) ? 6 : 18;
+    double weight[18];
+    for (int q=0; q<18; q++) weight[q] = (Q==6) ? 1.0 : ((q<6) ? 1.0/3.0 : 1.0/6.0);
+    int offset[18];
+    for (int q=0; q<18; q++)
+        offset[q] = PoissonStencil[q][0] + PoissonStencil[q][1]*Nx + PoissonStencil[q][2]*Nx*Ny;
+
+    // Boundary voltages
+    if (BoundaryConditionInlet==2)
+        Vin = getBoundaryVoltagefromPeriodicBC(Vin0,freqIn,PhaseShift_In,timestep_from_Study);
+    if (BoundaryConditionOutlet==2)
+        Vout = getBoundaryVoltagefromPeriodicBC(Vout0,freqOut,PhaseShift_Out,timestep_from_Study);
+    bool inlet = BoundaryConditionInlet > 0 && Dm->kproc() == 0;
+    bool outlet = BoundaryConditionOutlet > 0 && Dm->kproc() == nprocz-1;
+    // Returns 0 for an unknown, 1 for a Dirichlet value on the halo layer and 2 for a solid
+    auto neighborType = [&]( int k, int nb ) {
+        if (inlet && k==0) return 1;
+        if (outlet && k==Nz-1) return 1;
+        return (Mask->id[nb] > 0) ? 0 : 2;
+    };
+
+    // Assemble the diagonal and the right hand side
+    cg_rhs.resize(Nx,Ny,Nz);
+    cg_diag.resize(Nx,Ny,Nz);
+    cg_rhs.fill(0);
+    cg_diag.fill(0);
+    if (!UseSlippingVelBC){
+        ScaLBL_Comm->RegularLayout(Map,ChargeDensity,cg_rhs);
+        cg_rhs.scale(1.0/epsilon_LB);
+    }
+    ScaLBL_CopyToHost(Psi_host.data(),Psi,sizeof(double)*Nx*Ny*Nz);
+    for (int k=1; k<Nz-1; k++){
+        for (int j=1; j<Ny-1; j++){
+            for (int i=1; i<Nx-1; i++){
+                int n = k*Nx*Ny + j*Nx + i;
+                if (Mask->id[n] <= 0){
+                    cg_rhs(n) = 0.0;
+                    continue;
+                }
+                double diag = 0.0;
+                double b = cg_rhs(n);
+                for (int q=0; q<Q; q++){
+                    int nb = n + offset[q];
+                    double w = weight[q];
+                    int type = neighborType(k+PoissonStencil[q][2], nb);
+                    if (type == 0){
+                        diag += w;
+                    }
+                    else if (type == 1){
+                        diag += w;
+                        b += w*(k+PoissonStencil[q][2]==0 ? Vin : Vout);
+                    }
+                    else if (cg_label(nb) == 1){
+                        diag += 2.0*w;
+                        b += 2.0*w*cg_solid(nb);
+                    }
+                    else if (cg_label(nb) == 2){
+                        b += w*cg_solid(nb);
+                    }
+                }
+                if (diag == 0.0){
+                    // isolated site: keep the current value
+                    diag = 1.0;
+                    b = Psi_host(n);
+                }
+                cg_diag(n) = diag;
+                cg_rhs(n) = b;
+            }
+        }
+    }
+    // Apply the operator to the unknowns (the halo of x must be current)
+    auto apply = [&]( DoubleArray &x, DoubleArray &y ) {
+        Dm->CommunicateMeshHalo(x);
+        for (int k=1; k<Nz-1; k++){
+            for (int j=1; j<Ny-1; j++){
+                for (int i=1; i<Nx-1; i++){
+                    int n = k*Nx*Ny + j*Nx + i;
+                    if (Mask->id[n] <= 0) continue;
+                    double sum = cg_diag(n)*x(n);
+                    for (int q=0; q<Q; q++){
+                        int nb = n + offset[q];
+                        if (neighborType(k+PoissonStencil[q][2], nb) == 0)
+                            sum -= weight[q]*x(nb);
+                    }
+                    y(n) = sum;
+                }
+            }
+        }
+    };
+
+    // Preconditioned conjugate gradient
+    cg_r.resize(Nx,Ny,Nz);  cg_r.fill(0);
+    cg_z.resize(Nx,Ny,Nz);  cg_z.fill(0);
+    cg_p.resize(Nx,Ny,Nz);  cg_p.fill(0);
+    cg_q.resize(Nx,Ny,Nz);  cg_q.fill(0);
+    DoubleArray &x = Psi_host;
+    apply(x,cg_q);
+    double rr_loc=0.0, rz_loc=0.0, bb_loc=0.0;
+    for (int n=0; n<N; n++){
+        if (cg_diag(n) == 0.0) continue;
+        cg_r(n) = cg_rhs(n) - cg_q(n);
+        cg_z(n) = cg_r(n)/cg_diag(n);
+        cg_p(n) = cg_z(n);
+        rr_loc += cg_r(n)*cg_r(n);
+        rz_loc += cg_r(n)*cg_z(n);
+        bb_loc += cg_rhs(n)*cg_rhs(n);
+    }
+    double rr=0.0, rz=0.0, bb=0.0;
+    BatchedReduction reduction(Dm->Comm);
+    reduction.sum(rr_loc,rr);
+    reduction.sum(rz_loc,rz);
+    reduction.sum(bb_loc,bb);
+    reduction.reduce();
+    double target = cg_tolerance*cg_tolerance*(bb > 0.0 ? bb : 1.0);
+    timestep = 0;
+    while (timestep < timestepMax && rr > target){
+        timestep++;
+        apply(cg_p,cg_q);
+        double pq_loc = 0.0;
+        for (int n=0; n<N; n++){
+            if (cg_diag(n) == 0.0) continue;
+            pq_loc += cg_p(n)*cg_q(n);
+        }
+        double pq = Dm->Comm.sumReduce(pq_loc);
+        if (!(pq > 0.0)) break;
+        double alpha = rz/pq;
+        rr_loc = rz_loc = 0.0;
+        for (int n=0; n<N; n++){
+            if (cg_diag(n) == 0.0) continue;
+            x(n) += alpha*cg_p(n);
+            cg_r(n) -= alpha*cg_q(n);
+            cg_z(n) = cg_r(n)/cg_diag(n);
+            rr_loc += cg_r(n)*cg_r(n);
+            rz_loc += cg_r(n)*cg_z(n);
+        }
+        double rz_new = 0.0;
+        reduction.sum(rr_loc,rr);
+        reduction.sum(rz_loc,rz_new);
+        reduction.reduce();
+        double beta = rz_new/rz;
+        rz = rz_new;
+        for (int n=0; n<N; n++){
+            if (cg_diag(n) == 0.0) continue;
+            cg_p(n) = cg_z(n) + beta*cg_p(n);
+        }
+    }
+    double error = sqrt(rr/(bb > 0.0 ? bb : 1.0));
+
+    // Fill the halo and impose the inlet/outlet potentials
+    Dm->CommunicateMeshHalo(x);
+    for (int j=0; j<Ny; j++){
+        for (int i=0; i<Nx; i++){
+            if (inlet)  x(i,j,0) = Vin;
+            if (outlet) x(i,j,Nz-1) = Vout;
+        }
+    }
+    ScaLBL_CopyToDevice(Psi,x.data(),sizeof(double)*Nx*Ny*Nz);
+
+    // Electric field (V/lu) from the potential gradient
+    std::vector<double> Efield(3*Np,0.0);
+    for (int k=1; k<Nz-1; k++){
+        for (int j=1; j<Ny-1; j++){
+            for (int i=1; i<Nx-1; i++){
+                int idx = Map(i,j,k);
+                if (idx < 0) continue;
+                int n = k*Nx*Ny + j*Nx + i;
+                for (int d=0; d<3; d++){
+                    // value and distance for the neighbor in each direction (0 if unknown)
+                    double value[2] = {0.0,0.0}, dist[2] = {0.0,0.0};
+                    for (int s=0; s<2; s++){
+                        int q = 2*d + s;
+                        int nb = n + offset[q];
+                        int type = neighborType(k+PoissonStencil[q][2], nb);
+                        if (type != 2){
+                            value[s] = x(nb);
+                            dist[s] = 1.0;
+                        }
+                        else if (cg_label(nb) == 1){
+                            value[s] = cg_solid(nb);
+                            dist[s] = 0.5;
+                        }
+                    }
+                    double grad = 0.0;
+                    if (dist[0] > 0.0 && dist[1] > 0.0)
+                        grad = (value[0] - value[1])/(dist[0] + dist[1]);
+                    else if (dist[0] > 0.0)
+                        grad = (value[0] - x(n))/dist[0];
+                    else if (dist[1] > 0.0)
+                        grad = (x(n) - value[1])/dist[1];
+                    Efield[idx + d*Np] = -grad;
+                }
+            }
+        }
+    }
+    ScaLBL_CopyToDevice(ElectricField,Efield.data(),3*sizeof(double)*Np);
+
+    auto t2 = std::chrono::system_clock::now();
+    double cputime = std::chrono::duration<double>(t2 - t1).count();
+    if (rank==0 && WriteLog) printf("LB-Poisson Solver: CG converged in %i iterations, relative residual = %.5g, time = %.3g s \n",
+                        timestep, error, cputime);
+    if(WriteLog==true){
+        getConvergenceLog(timestep,error);
+    }
+}
+
 void ScaLBL_Poisson::Checkpoint(){
 
 	if (rank == 0) {
@@ -15,6 +15,8 @@
 #include "common/ScaLBL.h"
 #include "common/Communication.h"
 #include "common/MPI.h"
+#include "common/BatchedReduction.h"
+#include "common/ConvergenceMonitor.h"
 #include "analysis/Minkowski.h"
 #include "ProfilerApp.h"
 
@@ -51,6 +53,8 @@ public:
     bool Restart;
     int timestep, timestepMax;
     int analysis_interval;
+    int max_analysis_interval;
+    bool adaptive_convergence;
 	int BoundaryConditionInlet;
 	int BoundaryConditionOutlet;
     vector<int> BoundaryConditionSolidList;
@@ -58,6 +62,8 @@ public:
 	double tolerance;
     std::string tolerance_method;
     std::string lattice_scheme;
+    std::string solver;
+    double cg_tolerance;
     double k2_inv;
     double epsilon0, epsilon0_LB, epsilonR, epsilon_LB;
     double Vin, Vout;
@@ -102,6 +108,15 @@ public:
 private:
     Utilities::MPI comm;
 
+    // convergence checks
+    std::shared_ptr<ConvergenceMonitor> monitor;
+    double error_sum, error_count, error_max;
+
+    // conjugate gradient solver (solver = "CG")
+    DoubleArray cg_solid;
+    IntArray cg_label;
+    DoubleArray cg_diag, cg_rhs, cg_r, cg_z, cg_p, cg_q;
+
     FILE *TIMELOG;
 
     // filenames
@@ -120,7 +135,10 @@ private:
     //void SolveElectricField();
     void SolvePoissonAAodd(double *ChargeDensity, bool UseSlippingVelBC, int timestep);
     void SolvePoissonAAeven(double *ChargeDensity, bool UseSlippingVelBC, int timestep);
+    void SolvePoissonCG(double *ChargeDensity, bool UseSlippingVelBC, int timestep_from_Study);
     void getConvergenceLog(int timestep,double error);
+    void StartConvergenceCheck(BatchedReduction &reduction);
+    double FinishConvergenceCheck(BatchedReduction &reduction);
     double getBoundaryVoltagefromPeriodicBC(double V0,double freq,double t0,int time_step);
     
 };
@@ -519,8 +519,8 @@ void ScaLBL_StokesModel::Create() {
     int dist_mem_size = Np * sizeof(double);
     int neighborSize = 18 * (Np * sizeof(int));
     //...........................................................................
-    ScaLBL_AllocateDeviceMemory((void **)&NeighborList, neighborSize);
-    ScaLBL_AllocateDeviceMemory((void **)&fq, 19 * dist_mem_size);
+    ScaLBL_AllocateDistributionMemory((void **)&NeighborList, neighborSize, 18);
+    ScaLBL_AllocateDistributionMemory((void **)&fq, 19 * dist_mem_size, 19);
     ScaLBL_AllocateDeviceMemory((void **)&Pressure, sizeof(double) * Np);
     ScaLBL_AllocateDeviceMemory((void **)&Velocity, 3 * sizeof(double) * Np);
     //...........................................................................
@@ -0,0 +1,65 @@
+// Test batched sum/min/max reductions against the individual reductions
+#include <iostream>
+#include <math.h>
+#include <vector>
+#include "common/MPI.h"
+#include "common/Utilities.h"
+#include "common/BatchedReduction.h"
+
+int main(int argc, char **argv) {
+    Utilities::startup(argc, argv);
+    int error = 0;
+    {
+        Utilities::MPI comm(MPI_COMM_WORLD);
+        int rank = comm.getRank();
+        int nprocs = comm.getSize();
+
+        const int N = 25;
+        std::vector<double> local(N), sum(N), min(N), max(N);
+        for (int i = 0; i < N; i++)
+            local[i] = sin(1.0 + i + 7.0 * rank);
+
+        // blocking reduction
+        BatchedReduction reduction(comm);
+        for (int i = 0; i < N; i++) {
+            reduction.sum(local[i], sum[i]);
+            reduction.min(local[i], min[i]);
+            reduction.max(local[i], max[i]);
+        }
+        if (reduction.size() != 3 * N) {
+            printf("Incorrect number of registered values \n");
+            error++;
+        }
+        reduction.reduce();
+        for (int i = 0; i < N; i++) {
+            if (fabs(sum[i] - comm.sumReduce(local[i])) > 1e-12 ||
+                min[i] != comm.minReduce(local[i]) ||
+                max[i] != comm.maxReduce(local[i]))
+                error++;
+        }
+
+        // non-blocking reduction, reusing the same object
+        double count = 1.0;
+        double total = 0.0;
+        reduction.sum(count, count);
+        reduction.sum(rank, total);
+        reduction.start();
+        if (!reduction.active())
+            error++;
+        reduction.finish();
+        if (count != nprocs || total != 0.5 * nprocs * (nprocs - 1))
+            error++;
+        if (reduction.size() != 0)
+            error++;
+
+        error = comm.maxReduce(error);
+        if (rank == 0) {
+            if (error == 0)
+                printf("All tests passed \n");
+            else
+                printf("Batched reduction failed (%i errors) \n", error);
+        }
+    }
+    Utilities::shutdown();
+    return error;
+}
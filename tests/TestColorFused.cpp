@@ -0,0 +1,219 @@
+//*************************************************************************
+// Check that the fused color kernels reproduce the separate phase field
+// and collision sweeps for a bubble next to a solid sphere
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <math.h>
+#include "common/ScaLBL.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( int nprocs )
+{
+    auto db = std::make_shared<Database>();
+    db->putScalar<int>( "BC", 0 );
+    db->putVector<int>( "nproc", { 1, 1, 1 } );
+    db->putVector<int>( "n", { 24, 24, 24 } );
+    db->putScalar<int>( "nspheres", 1 );
+    db->putVector<double>( "L", { 1, 1, 1 } );
+    return db;
+}
+
+struct ColorState {
+	double *fq, *Aq, *Bq, *Den, *Phi, *Velocity;
+};
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestColorFused	\n");
+			printf("********************************************************\n");
+		}
+
+		auto db = loadInputs( comm.getSize() );
+		auto Dm = std::make_shared<Domain>(db,comm);
+		int Nx = Dm->Nx;
+		int Ny = Dm->Ny;
+		int Nz = Dm->Nz;
+		int N = Nx*Ny*Nz;
+
+		// Solid sphere plus a bubble of component A
+		int Np = 0;
+		DoubleArray PhaseLabel(Nx,Ny,Nz);
+		PhaseLabel.fill(-1.0);
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int n = k*Nx*Ny+j*Nx+i;
+					double x = i - 0.3*Nx;
+					double y = j - 0.3*Ny;
+					double z = k - 0.3*Nz;
+					if (x*x+y*y+z*z < 16.0) Dm->id[n] = 0;
+					else {
+						Dm->id[n] = 1;
+						Np++;
+						x = i - 0.65*Nx;
+						y = j - 0.65*Ny;
+						z = k - 0.6*Nz;
+						if (x*x+y*y+z*z < 36.0) PhaseLabel(i,j,k) = 1.0;
+					}
+				}
+			}
+		}
+		Dm->CommInit();
+
+		double rhoA = 1.0, rhoB = 1.0;
+		double tauA = 0.7, tauB = 1.0;
+		double alpha = 5e-3, beta = 0.95;
+		double Fx = 0.0, Fy = 0.0, Fz = 1.0e-5;
+
+		const char *orderings[2] = { "lexicographic", "hilbert" };
+		for (int ord=0; ord<2; ord++){
+			db->putScalar<std::string>( "LayoutOrdering", orderings[ord] );
+			std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+			std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm_Regular(new ScaLBL_Communicator(Dm));
+
+			IntArray Map(Nx,Ny,Nz);
+			int *neighborList = new int[18*(Np+64)];
+			int Nsites = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+			int span = ScaLBL_Comm->InteriorSpan();
+
+			int *TmpMap = new int[Nsites];
+			for (int idx=0; idx<Nsites; idx++) TmpMap[idx] = -1;
+			for (int k=1;k<Nz-1;k++){
+				for (int j=1;j<Ny-1;j++){
+					for (int i=1;i<Nx-1;i++){
+						int idx = Map(i,j,k);
+						if (!(idx < 0)) TmpMap[idx] = k*Nx*Ny+j*Nx+i;
+					}
+				}
+			}
+			for (int idx=0; idx<Nsites; idx++) if (TmpMap[idx] < 0) TmpMap[idx] = 0;
+
+			int *NeighborList, *dvcMap;
+			ScaLBL_AllocateDeviceMemory((void **) &NeighborList, 18*Nsites*sizeof(int));
+			ScaLBL_AllocateDeviceMemory((void **) &dvcMap, Nsites*sizeof(int));
+			ScaLBL_CopyToDevice(NeighborList, neighborList, 18*Nsites*sizeof(int));
+			ScaLBL_CopyToDevice(dvcMap, TmpMap, Nsites*sizeof(int));
+
+			ColorState state[2];
+			for (int s=0; s<2; s++){
+				ScaLBL_AllocateDeviceMemory((void **) &state[s].fq, 19*Nsites*sizeof(double));
+				ScaLBL_AllocateDeviceMemory((void **) &state[s].Aq, 7*Nsites*sizeof(double));
+				ScaLBL_AllocateDeviceMemory((void **) &state[s].Bq, 7*Nsites*sizeof(double));
+				ScaLBL_AllocateDeviceMemory((void **) &state[s].Den, 2*Nsites*sizeof(double));
+				ScaLBL_AllocateDeviceMemory((void **) &state[s].Phi, N*sizeof(double));
+				ScaLBL_AllocateDeviceMemory((void **) &state[s].Velocity, 3*Nsites*sizeof(double));
+				ScaLBL_CopyToDevice(state[s].Phi, PhaseLabel.data(), N*sizeof(double));
+				ScaLBL_D3Q19_Init(state[s].fq, Nsites);
+				ScaLBL_PhaseField_Init(dvcMap, state[s].Phi, state[s].Den, state[s].Aq, state[s].Bq, 0, ScaLBL_Comm->LastExterior(), Nsites);
+				ScaLBL_PhaseField_Init(dvcMap, state[s].Phi, state[s].Den, state[s].Aq, state[s].Bq, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+			}
+
+			int timestepMax = 20;
+			for (int s=0; s<2; s++){
+				bool fused = (s == 1);
+				double *fq = state[s].fq;
+				double *Aq = state[s].Aq;
+				double *Bq = state[s].Bq;
+				double *Den = state[s].Den;
+				double *Phi = state[s].Phi;
+				double *Velocity = state[s].Velocity;
+				for (int timestep=0; timestep<timestepMax; timestep+=2){
+					// odd timestep
+					ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq);
+					if (!fused)
+						ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+					ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq);
+					ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi, 0, ScaLBL_Comm->LastExterior(), Nsites);
+					ScaLBL_Comm->SendD3Q19AA(fq);
+					ScaLBL_Comm_Regular->SendHalo(Phi);
+					if (fused)
+						ScaLBL_D3Q19_AAodd_Color_Fused(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+								alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, span, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+					else
+						ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+								alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+					ScaLBL_Comm_Regular->RecvHalo(Phi);
+					ScaLBL_Comm->RecvD3Q19AA(fq);
+					ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, 0, ScaLBL_Comm->LastExterior(), Nsites);
+
+					// even timestep
+					ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq);
+					if (!fused)
+						ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+					ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq);
+					ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi, 0, ScaLBL_Comm->LastExterior(), Nsites);
+					ScaLBL_Comm->SendD3Q19AA(fq);
+					ScaLBL_Comm_Regular->SendHalo(Phi);
+					if (fused)
+						ScaLBL_D3Q19_AAeven_Color_Fused(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+								alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, span, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+					else
+						ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+								alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+					ScaLBL_Comm_Regular->RecvHalo(Phi);
+					ScaLBL_Comm->RecvD3Q19AA(fq);
+					ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, 0, ScaLBL_Comm->LastExterior(), Nsites);
+				}
+			}
+			ScaLBL_DeviceBarrier();
+
+			// Compare the distributions and phase field from both schedules
+			double *cfq[2], *cPhi[2];
+			for (int s=0; s<2; s++){
+				cfq[s] = new double[19*Nsites];
+				cPhi[s] = new double[N];
+				ScaLBL_CopyToHost(cfq[s], state[s].fq, 19*Nsites*sizeof(double));
+				ScaLBL_CopyToHost(cPhi[s], state[s].Phi, N*sizeof(double));
+			}
+			double fq_diff = 0.0, phi_diff = 0.0;
+			for (int idx=0; idx<ScaLBL_Comm->LastInterior(); idx++){
+				if (idx >= ScaLBL_Comm->LastExterior() && idx < ScaLBL_Comm->FirstInterior()) continue;
+				for (int q=0; q<19; q++)
+					fq_diff = max(fq_diff, fabs(cfq[0][q*Nsites+idx]-cfq[1][q*Nsites+idx]));
+			}
+			for (int n=0; n<N; n++)
+				phi_diff = max(phi_diff, fabs(cPhi[0][n]-cPhi[1][n]));
+			fq_diff = comm.maxReduce(fq_diff);
+			phi_diff = comm.maxReduce(phi_diff);
+			if (rank==0) printf("  %s ordering (span=%i): max difference fq = %e, phi = %e \n",orderings[ord],span,fq_diff,phi_diff);
+			if (fq_diff > 1.0e-12 || phi_diff > 1.0e-12){
+				printf("Fused color kernel does not match the separate sweeps \n");
+				error++;
+			}
+
+			for (int s=0; s<2; s++){
+				delete [] cfq[s];
+				delete [] cPhi[s];
+				ScaLBL_FreeDeviceMemory(state[s].fq);
+				ScaLBL_FreeDeviceMemory(state[s].Aq);
+				ScaLBL_FreeDeviceMemory(state[s].Bq);
+				ScaLBL_FreeDeviceMemory(state[s].Den);
+				ScaLBL_FreeDeviceMemory(state[s].Phi);
+				ScaLBL_FreeDeviceMemory(state[s].Velocity);
+			}
+			ScaLBL_FreeDeviceMemory(NeighborList);
+			ScaLBL_FreeDeviceMemory(dvcMap);
+			delete [] TmpMap;
+			delete [] neighborList;
+		}
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
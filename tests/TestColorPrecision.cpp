@@ -0,0 +1,137 @@
+//*************************************************************************
+// Compare the color model with fq, Aq and Bq stored in double and single
+// precision (precision = "single") for a bubble next to a solid sphere
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <math.h>
+
+#include "common/Utilities.h"
+#include "models/ColorModel.h"
+
+using namespace std;
+
+// global labels: solid sphere (label 0) and a bubble of component B (label 2) in component A (label 1)
+inline signed char GlobalLabel(int x, int y, int z, int n){
+	double xs = x - 0.3*n, ys = y - 0.3*n, zs = z - 0.3*n;
+	if (xs*xs + ys*ys + zs*zs < 16.0) return 0;
+	double xb = x - 0.65*n, yb = y - 0.65*n, zb = z - 0.6*n;
+	if (xb*xb + yb*yb + zb*zb < 16.0) return 2;
+	return 1;
+}
+
+// Run the color model and return the phase field (regular layout) and the velocity (compact layout)
+void RunColor( const Utilities::MPI &comm, int BC, const std::string &option, const std::string &precision,
+		std::vector<double> &Phase, std::vector<double> &Vel )
+{
+	int rank = comm.getRank();
+	int nprocs = comm.getSize();
+	int n = 24;
+	auto domain_db = std::make_shared<Database>();
+	auto color_db = std::make_shared<Database>();
+	auto db = std::make_shared<Database>();
+	domain_db->putVector<int>( "nproc", { 1, 1, nprocs } );
+	domain_db->putVector<int>( "N", { n, n, n*nprocs } );
+	domain_db->putVector<int>( "n", { n, n, n } );
+	domain_db->putScalar<int>( "BC", BC );
+	color_db->putScalar<double>( "alpha", 0.01 );
+	color_db->putScalar<double>( "tauA", 0.7 );
+	color_db->putScalar<int>( "timestepMax", 20 );
+	color_db->putScalar<double>( "din", 1.001 );
+	color_db->putScalar<double>( "dout", 1.0 );
+	if (BC == 0)
+		color_db->putVector<double>( "F", { 0.0, 0.0, 1.0e-5 } );
+	color_db->putVector<int>( "ComponentLabels", { 0 } );
+	color_db->putVector<double>( "ComponentAffinity", { 0.5 } );
+	color_db->putScalar<std::string>( "precision", precision );
+	if (!option.empty())
+		color_db->putScalar<bool>( option, true );
+	db->putDatabase( "Color", color_db );
+	db->putDatabase( "Domain", domain_db );
+	db->putDatabase( "FlowAdaptor", std::make_shared<Database>() );
+	db->putDatabase( "Visualization", std::make_shared<Database>() );
+	db->putDatabase( "Analysis", std::make_shared<Database>() );
+
+	ScaLBL_ColorModel ColorModel( rank, nprocs, comm );
+	ColorModel.ReadParams( db );
+	ColorModel.SetDomain();
+	int Nx = ColorModel.Dm->Nx;
+	int Ny = ColorModel.Dm->Ny;
+	int Nz = ColorModel.Dm->Nz;
+	int kproc = ColorModel.Dm->kproc();
+	for (int k=0;k<Nz;k++){
+		for (int j=0;j<Ny;j++){
+			for (int i=0;i<Nx;i++){
+				int idx = k*Nx*Ny + j*Nx + i;
+				int z = k - 1 + kproc*(Nz-2);
+				signed char label = GlobalLabel(i-1, j-1, z, n);
+				ColorModel.Mask->id[idx] = label;
+				ColorModel.id[idx] = label;
+				ColorModel.Dm->id[idx] = label;
+				double xs = i - 1 - 0.3*n, ys = j - 1 - 0.3*n, zs = z - 0.3*n;
+				ColorModel.Averages->SDs(i,j,k) = sqrt(xs*xs + ys*ys + zs*zs) - 4.0;
+			}
+		}
+	}
+	ColorModel.Create();
+	ColorModel.Initialize();
+	ColorModel.Run(20);
+
+	Phase.resize(Nx*Ny*Nz);
+	Vel.resize(3*ColorModel.Np);
+	ColorModel.CopyPhaseToHost(Phase.data());
+	ScaLBL_CopyToHost(Vel.data(), ColorModel.Velocity, 3*ColorModel.Np*sizeof(double));
+	comm.barrier();
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestColorPrecision	\n");
+			printf("********************************************************\n");
+		}
+		int device = ScaLBL_SetDevice( rank );
+		NULL_USE( device );
+		ScaLBL_DeviceBarrier();
+		comm.barrier();
+
+		// periodic with a body force, pressure boundary conditions, and the fused and sparse sweeps
+		struct { int BC; const char *option; } cases[4] = {
+			{ 0, "" }, { 3, "" }, { 0, "fused_kernels" }, { 0, "sparse_phi" } };
+		for (int c=0; c<4; c++){
+			std::vector<double> Phase, Vel, Phase_float, Vel_float;
+			RunColor( comm, cases[c].BC, cases[c].option, "double", Phase, Vel );
+			RunColor( comm, cases[c].BC, cases[c].option, "single", Phase_float, Vel_float );
+			double vmax = 0.0, vel_diff = 0.0, phi_diff = 0.0;
+			for (size_t idx=0; idx<Vel.size(); idx++){
+				vmax = max(vmax, fabs(Vel[idx]));
+				vel_diff = max(vel_diff, fabs(Vel[idx]-Vel_float[idx]));
+			}
+			for (size_t idx=0; idx<Phase.size(); idx++)
+				phi_diff = max(phi_diff, fabs(Phase[idx]-Phase_float[idx]));
+			vmax = comm.maxReduce(vmax);
+			vel_diff = comm.maxReduce(vel_diff);
+			phi_diff = comm.maxReduce(phi_diff);
+			if (rank==0) printf("BC = %i %s: maximum velocity = %e, difference (single - double): velocity = %e, phi = %e \n",
+					cases[c].BC,cases[c].option,vmax,vel_diff,phi_diff);
+			if (!(vmax > 0.0) || vel_diff > 1.0e-4*vmax || phi_diff > 1.0e-6){
+				if (rank==0) printf("Single precision color model does not match double precision \n");
+				error++;
+			}
+		}
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	comm.barrier();
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,271 @@
+//*************************************************************************
+// Check that the color kernels with a compact phase field reproduce the
+// regular layout for a bubble next to a solid sphere
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <math.h>
+#include "common/ScaLBL.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( int nprocs )
+{
+    auto db = std::make_shared<Database>();
+    db->putScalar<int>( "BC", 0 );
+    db->putVector<int>( "nproc", { 1, 1, nprocs } );
+    db->putVector<int>( "n", { 24, 24, 24 } );
+    db->putScalar<int>( "nspheres", 1 );
+    db->putVector<double>( "L", { 1, 1, 1 } );
+    return db;
+}
+
+struct ColorState {
+	double *fq, *Aq, *Bq, *Den, *Phi, *Velocity;
+};
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestColorSparse	\n");
+			printf("********************************************************\n");
+		}
+
+		auto db = loadInputs( nprocs );
+		auto Dm = std::make_shared<Domain>(db,comm);
+		int Nx = Dm->Nx;
+		int Ny = Dm->Ny;
+		int Nz = Dm->Nz;
+		int N = Nx*Ny*Nz;
+
+		// Solid sphere in each sub-domain plus a bubble of component A (global coordinates)
+		int Np = 0;
+		DoubleArray PhaseLabel(Nx,Ny,Nz);
+		PhaseLabel.fill(-1.0);
+		for (int k=0;k<Nz;k++){
+			for (int j=0;j<Ny;j++){
+				for (int i=0;i<Nx;i++){
+					int n = k*Nx*Ny+j*Nx+i;
+					double x = i - 0.3*Nx;
+					double y = j - 0.3*Ny;
+					double z = k - 0.3*Nz;
+					if (x*x+y*y+z*z < 16.0){
+						Dm->id[n] = 0;
+						PhaseLabel(i,j,k) = -0.5;
+					}
+					else {
+						Dm->id[n] = 1;
+						if (i>0 && j>0 && k>0 && i<Nx-1 && j<Ny-1 && k<Nz-1) Np++;
+						x = i - 0.65*Nx;
+						y = j - 0.65*Ny;
+						z = k + Dm->kproc()*(Nz-2) - 0.6*Nz;
+						if (x*x+y*y+z*z < 36.0) PhaseLabel(i,j,k) = 1.0;
+					}
+				}
+			}
+		}
+		Dm->CommInit();
+
+		double rhoA = 1.0, rhoB = 1.0;
+		double tauA = 0.7, tauB = 1.0;
+		double alpha = 5e-3, beta = 0.95;
+		double Fx = 0.0, Fy = 0.0, Fz = 1.0e-5;
+
+		std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+		std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm_Regular(new ScaLBL_Communicator(Dm));
+		std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm_Sparse(new ScaLBL_Communicator(Dm));
+
+		IntArray Map(Nx,Ny,Nz);
+		int *neighborList = new int[18*(Np+64)];
+		int Nsites = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+
+		// Compact phase field
+		IntArray PhiMap;
+		std::vector<int> ringOffset, ringIndex;
+		int NPhi = ScaLBL_Comm_Sparse->SparseLayout(Map,Nsites,PhiMap,ringOffset,ringIndex);
+		double ratio = comm.sumReduce(double(NPhi))/comm.sumReduce(double(N));
+		if (rank==0) printf("  compact phase field: %i entries (%f of regular layout) \n",NPhi,ratio);
+		if (!(NPhi < N)){
+			printf("Compact phase field is not smaller than the regular layout \n");
+			error++;
+		}
+
+		int *TmpMap = new int[Nsites];
+		int *TmpPhiMap = new int[Nsites];
+		for (int idx=0; idx<Nsites; idx++){
+			TmpMap[idx] = -1;
+			TmpPhiMap[idx] = idx;
+		}
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int idx = Map(i,j,k);
+					if (!(idx < 0)) TmpMap[idx] = k*Nx*Ny+j*Nx+i;
+				}
+			}
+		}
+		for (int idx=0; idx<Nsites; idx++) if (TmpMap[idx] < 0) TmpMap[idx] = 0;
+
+		int *NeighborList, *dvcMap, *dvcPhiMap, *dvcRingOffset, *dvcRingIndex;
+		ScaLBL_AllocateDeviceMemory((void **) &NeighborList, 18*Nsites*sizeof(int));
+		ScaLBL_AllocateDeviceMemory((void **) &dvcMap, Nsites*sizeof(int));
+		ScaLBL_AllocateDeviceMemory((void **) &dvcPhiMap, Nsites*sizeof(int));
+		ScaLBL_AllocateDeviceMemory((void **) &dvcRingOffset, (Nsites+1)*sizeof(int));
+		ScaLBL_AllocateDeviceMemory((void **) &dvcRingIndex, (ringIndex.size()+1)*sizeof(int));
+		ScaLBL_CopyToDevice(NeighborList, neighborList, 18*Nsites*sizeof(int));
+		ScaLBL_CopyToDevice(dvcMap, TmpMap, Nsites*sizeof(int));
+		ScaLBL_CopyToDevice(dvcPhiMap, TmpPhiMap, Nsites*sizeof(int));
+		ScaLBL_CopyToDevice(dvcRingOffset, ringOffset.data(), (Nsites+1)*sizeof(int));
+		ScaLBL_CopyToDevice(dvcRingIndex, ringIndex.data(), ringIndex.size()*sizeof(int));
+
+		// Initial phase field in the compact layout
+		std::vector<double> PhaseCompact(NPhi,0.0);
+		for (int n=0; n<N; n++){
+			if (!(PhiMap(n) < 0)) PhaseCompact[PhiMap(n)] = PhaseLabel(n);
+		}
+
+		ColorState state[2];
+		for (int s=0; s<2; s++){
+			bool sparse = (s == 1);
+			int *phiMap = sparse ? dvcPhiMap : dvcMap;
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].fq, 19*Nsites*sizeof(double));
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].Aq, 7*Nsites*sizeof(double));
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].Bq, 7*Nsites*sizeof(double));
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].Den, 2*Nsites*sizeof(double));
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].Velocity, 3*Nsites*sizeof(double));
+			if (sparse){
+				ScaLBL_AllocateDeviceMemory((void **) &state[s].Phi, NPhi*sizeof(double));
+				ScaLBL_CopyToDevice(state[s].Phi, PhaseCompact.data(), NPhi*sizeof(double));
+			}
+			else {
+				ScaLBL_AllocateDeviceMemory((void **) &state[s].Phi, N*sizeof(double));
+				ScaLBL_CopyToDevice(state[s].Phi, PhaseLabel.data(), N*sizeof(double));
+			}
+			ScaLBL_D3Q19_Init(state[s].fq, Nsites);
+			ScaLBL_PhaseField_Init(phiMap, state[s].Phi, state[s].Den, state[s].Aq, state[s].Bq, 0, ScaLBL_Comm->LastExterior(), Nsites);
+			ScaLBL_PhaseField_Init(phiMap, state[s].Phi, state[s].Den, state[s].Aq, state[s].Bq, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+		}
+
+		int timestepMax = 20;
+		for (int s=0; s<2; s++){
+			bool sparse = (s == 1);
+			int *phiMap = sparse ? dvcPhiMap : dvcMap;
+			auto PhiComm = sparse ? ScaLBL_Comm_Sparse : ScaLBL_Comm_Regular;
+			double *fq = state[s].fq;
+			double *Aq = state[s].Aq;
+			double *Bq = state[s].Bq;
+			double *Den = state[s].Den;
+			double *Phi = state[s].Phi;
+			double *Velocity = state[s].Velocity;
+			for (int timestep=0; timestep<timestepMax; timestep+=2){
+				// odd timestep
+				ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq);
+				ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, phiMap, Aq, Bq, Den, Phi, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+				ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq);
+				ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, phiMap, Aq, Bq, Den, Phi, 0, ScaLBL_Comm->LastExterior(), Nsites);
+				ScaLBL_Comm->SendD3Q19AA(fq);
+				PhiComm->SendHalo(Phi);
+				if (sparse)
+					ScaLBL_D3Q19_AAodd_Color_Sparse(NeighborList, dvcRingOffset, dvcRingIndex, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+				else
+					ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+				PhiComm->RecvHalo(Phi);
+				ScaLBL_Comm->RecvD3Q19AA(fq);
+				if (sparse)
+					ScaLBL_D3Q19_AAodd_Color_Sparse(NeighborList, dvcRingOffset, dvcRingIndex, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, 0, ScaLBL_Comm->LastExterior(), Nsites);
+				else
+					ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, 0, ScaLBL_Comm->LastExterior(), Nsites);
+
+				// even timestep
+				ScaLBL_Comm->BiSendD3Q7AA(Aq, Bq);
+				ScaLBL_D3Q7_AAeven_PhaseField(phiMap, Aq, Bq, Den, Phi, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+				ScaLBL_Comm->BiRecvD3Q7AA(Aq, Bq);
+				ScaLBL_D3Q7_AAeven_PhaseField(phiMap, Aq, Bq, Den, Phi, 0, ScaLBL_Comm->LastExterior(), Nsites);
+				ScaLBL_Comm->SendD3Q19AA(fq);
+				PhiComm->SendHalo(Phi);
+				if (sparse)
+					ScaLBL_D3Q19_AAeven_Color_Sparse(NeighborList, dvcRingOffset, dvcRingIndex, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+				else
+					ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Nsites);
+				PhiComm->RecvHalo(Phi);
+				ScaLBL_Comm->RecvD3Q19AA(fq);
+				if (sparse)
+					ScaLBL_D3Q19_AAeven_Color_Sparse(NeighborList, dvcRingOffset, dvcRingIndex, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, 0, ScaLBL_Comm->LastExterior(), Nsites);
+				else
+					ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+							alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, 0, ScaLBL_Comm->LastExterior(), Nsites);
+			}
+		}
+		ScaLBL_DeviceBarrier();
+
+		// Compare the distributions and the phase field at the stored sites
+		double *cfq[2];
+		for (int s=0; s<2; s++){
+			cfq[s] = new double[19*Nsites];
+			ScaLBL_CopyToHost(cfq[s], state[s].fq, 19*Nsites*sizeof(double));
+		}
+		double *cPhi = new double[N];
+		double *cPhiCompact = new double[NPhi];
+		ScaLBL_CopyToHost(cPhi, state[0].Phi, N*sizeof(double));
+		ScaLBL_CopyToHost(cPhiCompact, state[1].Phi, NPhi*sizeof(double));
+		double fq_diff = 0.0, phi_diff = 0.0;
+		for (int idx=0; idx<ScaLBL_Comm->LastInterior(); idx++){
+			if (idx >= ScaLBL_Comm->LastExterior() && idx < ScaLBL_Comm->FirstInterior()) continue;
+			for (int q=0; q<19; q++)
+				fq_diff = max(fq_diff, fabs(cfq[0][q*Nsites+idx]-cfq[1][q*Nsites+idx]));
+		}
+		for (int n=0; n<N; n++){
+			if (!(PhiMap(n) < 0))
+				phi_diff = max(phi_diff, fabs(cPhi[n]-cPhiCompact[PhiMap(n)]));
+		}
+		fq_diff = comm.maxReduce(fq_diff);
+		phi_diff = comm.maxReduce(phi_diff);
+		if (rank==0) printf("  max difference fq = %e, phi = %e \n",fq_diff,phi_diff);
+		if (fq_diff > 1.0e-12 || phi_diff > 1.0e-12){
+			printf("Compact phase field does not match the regular layout \n");
+			error++;
+		}
+
+		for (int s=0; s<2; s++){
+			delete [] cfq[s];
+			ScaLBL_FreeDeviceMemory(state[s].fq);
+			ScaLBL_FreeDeviceMemory(state[s].Aq);
+			ScaLBL_FreeDeviceMemory(state[s].Bq);
+			ScaLBL_FreeDeviceMemory(state[s].Den);
+			ScaLBL_FreeDeviceMemory(state[s].Phi);
+			ScaLBL_FreeDeviceMemory(state[s].Velocity);
+		}
+		delete [] cPhi;
+		delete [] cPhiCompact;
+		ScaLBL_FreeDeviceMemory(NeighborList);
+		ScaLBL_FreeDeviceMemory(dvcMap);
+		ScaLBL_FreeDeviceMemory(dvcPhiMap);
+		ScaLBL_FreeDeviceMemory(dvcRingOffset);
+		ScaLBL_FreeDeviceMemory(dvcRingIndex);
+		delete [] TmpMap;
+		delete [] TmpPhiMap;
+		delete [] neighborList;
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
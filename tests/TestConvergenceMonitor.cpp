@@ -0,0 +1,85 @@
+// Test the scheduling of convergence checks for a solver with an exponentially decaying error
+#include <iostream>
+#include <math.h>
+#include <vector>
+#include "common/MPI.h"
+#include "common/Utilities.h"
+#include "common/ConvergenceMonitor.h"
+
+// Iterate (two time steps at a time) until the error reaches the tolerance
+// and return the time step at which convergence is detected
+static int solve(ConvergenceMonitor &monitor, double error0, double rate,
+                 double tolerance, int timestepMax) {
+    monitor.reset();
+    int timestep = 0;
+    double error = 1.0;
+    while (timestep < timestepMax && error > tolerance) {
+        timestep += 2;
+        if (monitor.check(timestep)) {
+            error = error0 * exp(-rate * timestep);
+            monitor.update(timestep, error);
+        }
+    }
+    return timestep;
+}
+
+int main(int argc, char **argv) {
+    Utilities::startup(argc, argv);
+    int error = 0;
+    {
+        const double tolerance = 1e-10;
+        const double rate = 2e-3;
+        const int interval = 100;
+        int exact = (int)ceil(log(1.0 / tolerance) / rate);
+
+        // Fixed schedule
+        ConvergenceMonitor fixed(tolerance, interval, 10 * interval, false);
+        int t_fixed = solve(fixed, 1.0, rate, tolerance, 100000);
+        printf("fixed: converged at %i (exact %i) with %i checks \n", t_fixed,
+               exact, fixed.checks());
+        if (t_fixed < exact || t_fixed >= exact + interval ||
+            fixed.checks() != t_fixed / interval) {
+            printf("Fixed schedule is incorrect \n");
+            error++;
+        }
+
+        // Adaptive schedule: never misses convergence by more than the maximum
+        // interval and needs far fewer checks
+        ConvergenceMonitor adaptive(tolerance, interval, 10 * interval, true);
+        int t_adaptive = solve(adaptive, 1.0, rate, tolerance, 100000);
+        printf("adaptive: converged at %i with %i checks (rate %0.3e) \n",
+               t_adaptive, adaptive.checks(), adaptive.rate());
+        if (t_adaptive < exact || t_adaptive >= exact + interval ||
+            adaptive.checks() >= fixed.checks() / 2) {
+            printf("Adaptive schedule is incorrect \n");
+            error++;
+        }
+        if (fabs(adaptive.rate() - rate) > 1e-6 * rate) {
+            printf("Incorrect rate estimate \n");
+            error++;
+        }
+
+        // Warm start: a smaller initial error is predicted from the first check
+        int checks = adaptive.checks();
+        int t_warm = solve(adaptive, 1e-6, rate, tolerance, 100000);
+        printf("warm start: converged at %i with %i checks \n", t_warm,
+               adaptive.checks());
+        if (adaptive.checks() >= checks || t_warm >= t_adaptive) {
+            printf("Warm start did not reduce the number of checks \n");
+            error++;
+        }
+
+        // A solver that does not converge is checked at the fixed interval
+        ConvergenceMonitor stalled(tolerance, interval, 10 * interval, true);
+        int t_stalled = solve(stalled, 1.0, 0.0, tolerance, 5000);
+        if (t_stalled != 5000 || stalled.checks() != 5000 / interval) {
+            printf("Stalled solver is not checked at the fixed interval \n");
+            error++;
+        }
+
+        if (error == 0)
+            printf("All tests passed \n");
+    }
+    Utilities::shutdown();
+    return error;
+}
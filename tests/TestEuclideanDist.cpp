@@ -0,0 +1,211 @@
+//*************************************************************************
+// Check the exact distance transform against a brute force search and
+// compare the cost with the iterative distance calculation
+//*************************************************************************
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <random>
+#include "common/Domain.h"
+#include "common/MPI.h"
+#include "analysis/distance.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( const std::vector<int> &nproc, const std::vector<int> &n )
+{
+	auto db = std::make_shared<Database>();
+	db->putScalar<int>( "BC", 0 );
+	db->putVector<int>( "nproc", nproc );
+	db->putVector<int>( "n", n );
+	db->putScalar<int>( "nspheres", 0 );
+	db->putVector<double>( "L", { 1, 1, 1 } );
+	return db;
+}
+
+// Random overlapping spheres (the same image on every rank)
+static Array<char> GlobalImage( const std::vector<int> &N, int count, double radius, int seed )
+{
+	std::mt19937 generator( seed );
+	std::uniform_real_distribution<double> position( 0.0, 1.0 );
+	Array<char> image( N[0], N[1], N[2] );
+	image.fill( 1 );
+	for (int s=0; s<count; s++){
+		double cx = position(generator)*N[0];
+		double cy = position(generator)*N[1];
+		double cz = position(generator)*N[2];
+		for (int k=0; k<N[2]; k++){
+			for (int j=0; j<N[1]; j++){
+				for (int i=0; i<N[0]; i++){
+					double r2 = (i-cx)*(i-cx) + (j-cy)*(j-cy) + (k-cz)*(k-cz);
+					if (r2 < radius*radius) image(i,j,k) = 0;
+				}
+			}
+		}
+	}
+	return image;
+}
+
+static void LocalImage( const Array<char> &image, const Domain &Dm, Array<char> &id )
+{
+	int Nx = Dm.Nx, Ny = Dm.Ny, Nz = Dm.Nz;
+	std::vector<int> N = { (int)image.size(0), (int)image.size(1), (int)image.size(2) };
+	for (int k=0; k<Nz; k++){
+		for (int j=0; j<Ny; j++){
+			for (int i=0; i<Nx; i++){
+				int x = ( (Dm.iproc()*(Nx-2) + i - 1) % N[0] + N[0] ) % N[0];
+				int y = ( (Dm.jproc()*(Ny-2) + j - 1) % N[1] + N[1] ) % N[1];
+				int z = ( (Dm.kproc()*(Nz-2) + k - 1) % N[2] + N[2] ) % N[2];
+				id(i,j,k) = image(x,y,z);
+			}
+		}
+	}
+}
+
+// Compare with the distance from a brute force search over the global image
+static int CheckExact( const std::string &name, const std::vector<int> &nproc, const std::vector<int> &n,
+		const std::array<bool,3> &periodic, const Utilities::MPI &comm,
+		const std::array<double,3> &h = { 1, 1, 1 } )
+{
+	auto db = loadInputs( nproc, n );
+	Domain Dm( db, comm );
+	std::vector<int> N = { n[0]*nproc[0], n[1]*nproc[1], n[2]*nproc[2] };
+	auto image = GlobalImage( N, 12, 3.5, 7 );
+	Array<char> id( Dm.Nx, Dm.Ny, Dm.Nz );
+	LocalImage( image, Dm, id );
+	DoubleArray Distance( Dm.Nx, Dm.Ny, Dm.Nz );
+	CalcDist( Distance, id, Dm, periodic, h );
+
+	double error = 0.0;
+	for (int k=1; k<Dm.Nz-1; k++){
+		for (int j=1; j<Dm.Ny-1; j++){
+			for (int i=1; i<Dm.Nx-1; i++){
+				int x = Dm.iproc()*n[0] + i - 1;
+				int y = Dm.jproc()*n[1] + j - 1;
+				int z = Dm.kproc()*n[2] + k - 1;
+				char phase = image(x,y,z);
+				double d2 = 1e100;
+				for (int kk=0; kk<N[2]; kk++){
+					for (int jj=0; jj<N[1]; jj++){
+						for (int ii=0; ii<N[0]; ii++){
+							if (image(ii,jj,kk) == phase) continue;
+							double dx = fabs(ii-x), dy = fabs(jj-y), dz = fabs(kk-z);
+							if (periodic[0]) dx = std::min(dx, N[0]-dx);
+							if (periodic[1]) dy = std::min(dy, N[1]-dy);
+							if (periodic[2]) dz = std::min(dz, N[2]-dz);
+							// distance to the nearest face of the cell
+							dx = h[0]*std::max(dx-0.5, 0.0);
+							dy = h[1]*std::max(dy-0.5, 0.0);
+							dz = h[2]*std::max(dz-0.5, 0.0);
+							d2 = std::min(d2, dx*dx + dy*dy + dz*dz);
+						}
+					}
+				}
+				double exact = sqrt(d2);
+				if (phase == 0) exact = -exact;
+				error = std::max( error, fabs(Distance(i,j,k) - exact) );
+			}
+		}
+	}
+	error = comm.maxReduce( error );
+	if (comm.getRank() == 0)
+		printf("%s: max error = %e \n", name.c_str(), error);
+	return (error > 1e-10) ? 1 : 0;
+}
+
+// Check the distance next to a single solid cell
+static int CheckSubCell( const Utilities::MPI &comm )
+{
+	auto db = loadInputs( { 1, 1, 1 }, { 8, 8, 8 } );
+	auto self = comm.split( comm.getRank() );
+	Domain Dm( db, self );
+	Array<char> id( Dm.Nx, Dm.Ny, Dm.Nz );
+	id.fill( 1 );
+	id(4,4,4) = 0;
+	DoubleArray Distance( Dm.Nx, Dm.Ny, Dm.Nz );
+	CalcDist( Distance, id, Dm, { false, false, false }, { 1.0, 1.0, 2.0 } );
+	double face_x = Distance(5,4,4);
+	double face_z = Distance(4,4,5);
+	double edge = Distance(5,5,4);
+	double corner = Distance(5,5,5);
+	double error = fabs( face_x - 0.5 ) + fabs( face_z - 1.0 ) + fabs( edge - sqrt(0.5) )
+		+ fabs( corner - sqrt(1.5) ) + fabs( Distance(4,4,4) + 0.5 );
+	if (comm.getRank() == 0)
+		printf("sub-cell offsets: face = %f, %f, edge = %f, corner = %f \n", face_x, face_z, edge, corner);
+	return (error > 1e-12) ? 1 : 0;
+}
+
+// Compare the cost and the result with the iterative calculation
+static void Benchmark( const std::vector<int> &nproc, const std::vector<int> &n, const Utilities::MPI &comm )
+{
+	auto db = loadInputs( nproc, n );
+	Domain Dm( db, comm );
+	std::vector<int> N = { n[0]*nproc[0], n[1]*nproc[1], n[2]*nproc[2] };
+	auto image = GlobalImage( N, 60, 8.0, 3 );
+	Array<char> id( Dm.Nx, Dm.Ny, Dm.Nz );
+	LocalImage( image, Dm, id );
+	DoubleArray Exact( Dm.Nx, Dm.Ny, Dm.Nz );
+	DoubleArray Iterative( Dm.Nx, Dm.Ny, Dm.Nz );
+
+	comm.barrier();
+	double t1 = Utilities::MPI::time();
+	CalcDist( Exact, id, Dm );
+	comm.barrier();
+	double t2 = Utilities::MPI::time();
+	CalcDistIterative( Iterative, id, Dm );
+	comm.barrier();
+	double t3 = Utilities::MPI::time();
+
+	double diff = 0.0;
+	for (int k=1; k<Dm.Nz-1; k++)
+		for (int j=1; j<Dm.Ny-1; j++)
+			for (int i=1; i<Dm.Nx-1; i++)
+				diff = std::max( diff, fabs(Exact(i,j,k) - Iterative(i,j,k)) );
+	diff = comm.maxReduce( diff );
+	if (comm.getRank() == 0){
+		printf("Benchmark (%i x %i x %i): \n", N[0], N[1], N[2]);
+		printf("   exact transform:     %f s \n", t2-t1);
+		printf("   iterative transform: %f s \n", t3-t2);
+		printf("   max difference:      %f \n", diff);
+	}
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestEuclideanDist	\n");
+			printf("********************************************************\n");
+		}
+
+		std::vector<int> zslab = { 1, 1, nprocs };
+		std::vector<int> xslab = { nprocs, 1, 1 };
+		std::vector<int> cube = { 1, 1, 1 };
+		if (nprocs == 4) cube = { 2, 2, 1 };
+		else if (nprocs == 8) cube = { 2, 2, 2 };
+		else if (nprocs != 1) cube = zslab;
+		int nz = 24/nprocs;
+		error += CheckExact( "periodic (z slabs)", zslab, { 20, 18, nz }, { true, true, true }, comm );
+		error += CheckExact( "non-periodic (z slabs)", zslab, { 20, 18, nz }, { false, false, false }, comm );
+		error += CheckExact( "mixed (x slabs)", xslab, { 24/nprocs, 18, 16 }, { false, true, false }, comm );
+		std::vector<int> n = { 24/cube[0], 20/cube[1], 16/cube[2] };
+		error += CheckExact( "periodic (blocks)", cube, n, { true, true, true }, comm );
+		error += CheckExact( "anisotropic (blocks)", cube, n, { true, false, true }, comm, { 1.0, 0.5, 2.0 } );
+		error += CheckSubCell( comm );
+
+		Benchmark( cube, { 96/cube[0], 96/cube[1], 96/cube[2] }, comm );
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -145,6 +145,7 @@ int main( int argc, char **argv )
 		int IMAGE_INDEX = 0;
 		int IMAGE_COUNT = 0;
 		std::vector<std::string> ImageList;
+		std::string IMAGE_UPDATE = "full";
 		/* flow adaptor keys to control behavior */			
 		int SKIP_TIMESTEPS = 0;
 		int MAX_STEADY_TIME = 1000000;
@@ -155,6 +156,7 @@ int main( int argc, char **argv )
 		MAX_STEADY_TIME = flow_db->getWithDefault<int>( "max_steady_timesteps", 1000000 );
 		SKIP_TIMESTEPS = flow_db->getWithDefault<int>( "skip_timesteps", 50000 );
 		ENDPOINT_THRESHOLD = flow_db->getWithDefault<double>( "endpoint_threshold", 0.1);
+		IMAGE_UPDATE = flow_db->getWithDefault<std::string>( "image_update", "full" );
 		/* protocol specific key values */
 		if (PROTOCOL == "fractional flow")
 			FRACTIONAL_FLOW_INCREMENT = flow_db->getWithDefault<double>( "fractional_flow_increment", 0.05);
@@ -189,7 +191,10 @@ int main( int argc, char **argv )
 					std::string next_image = ImageList[IMAGE_INDEX];
 					if (rank==0) printf("***Loading next image in sequence (%i) ***\n",IMAGE_INDEX);
 					ColorModel.color_db->putScalar<int>("image_index",IMAGE_INDEX);
-					Adapt.ImageInit(ColorModel, next_image);
+					if (IMAGE_UPDATE == "incremental")
+						Adapt.ImageUpdate(ColorModel, next_image);
+					else
+						Adapt.ImageInit(ColorModel, next_image);
 				}
 				else{
 					if (rank==0) printf("Finished simulating image sequence \n");
@@ -0,0 +1,199 @@
+//*************************************************************************
+// Check that the aggregated halo exchange (SendHaloAA / RecvHaloAA) matches
+// the separate D3Q19, D3Q7 and scalar halo exchanges
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <math.h>
+#include "common/ScaLBL.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( int nprocs, int BC )
+{
+    auto db = std::make_shared<Database>();
+    db->putScalar<int>( "BC", BC );
+    db->putVector<int>( "nproc", { 1, 1, nprocs } );
+    db->putVector<int>( "n", { 16, 16, 16 } );
+    db->putScalar<int>( "nspheres", 1 );
+    db->putVector<double>( "L", { 1, 1, 1 } );
+    return db;
+}
+
+struct HaloState {
+	double *fq, *Aq, *Bq, *Phi;
+};
+
+// Compare the aggregated exchange with the separate exchanges for boundary condition BC
+int TestHalo( const Utilities::MPI &comm, int BC )
+{
+	int rank = comm.getRank();
+	int nprocs = comm.getSize();
+	int error = 0;
+	auto db = loadInputs( nprocs, BC );
+	auto Dm = std::make_shared<Domain>(db,comm);
+	int Nx = Dm->Nx;
+	int Ny = Dm->Ny;
+	int Nz = Dm->Nz;
+	int N = Nx*Ny*Nz;
+
+	// Solid sphere in each sub-domain
+	int Np = 0;
+	for (int k=1;k<Nz-1;k++){
+		for (int j=1;j<Ny-1;j++){
+			for (int i=1;i<Nx-1;i++){
+				int n = k*Nx*Ny+j*Nx+i;
+				double x = i - 0.4*Nx;
+				double y = j - 0.4*Ny;
+				double z = k - 0.4*Nz;
+				if (x*x+y*y+z*z < 9.0) Dm->id[n] = 0;
+				else {
+					Dm->id[n] = 1;
+					Np++;
+				}
+			}
+		}
+	}
+	Dm->CommInit();
+
+	std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+	std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm_Regular(new ScaLBL_Communicator(Dm));
+	IntArray Map(Nx,Ny,Nz);
+	int *neighborList = new int[18*(Np+64)];
+	Np = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+
+	// Distinct values for every distribution and site (the halo is left at zero)
+	double *fq_host = new double[19*Np];
+	double *Aq_host = new double[7*Np];
+	double *Bq_host = new double[7*Np];
+	double *Phi_host = new double[N];
+	for (int idx=0; idx<19*Np; idx++) fq_host[idx] = 0.0;
+	for (int idx=0; idx<7*Np; idx++) Aq_host[idx] = Bq_host[idx] = 0.0;
+	for (int n=0; n<N; n++) Phi_host[n] = 0.0;
+	for (int k=1;k<Nz-1;k++){
+		for (int j=1;j<Ny-1;j++){
+			for (int i=1;i<Nx-1;i++){
+				int n = k*Nx*Ny+j*Nx+i;
+				double label = double(rank*N + n);
+				Phi_host[n] = label;
+				int idx = Map(i,j,k);
+				if (idx < 0) continue;
+				for (int q=0; q<19; q++) fq_host[q*Np+idx] = label + 0.01*q;
+				for (int q=0; q<7; q++){
+					Aq_host[q*Np+idx] = label + 0.02*q;
+					Bq_host[q*Np+idx] = -label - 0.02*q;
+				}
+			}
+		}
+	}
+
+	HaloState state[2];
+	for (int s=0; s<2; s++){
+		ScaLBL_AllocateDeviceMemory((void **) &state[s].fq, 19*Np*sizeof(double));
+		ScaLBL_AllocateDeviceMemory((void **) &state[s].Aq, 7*Np*sizeof(double));
+		ScaLBL_AllocateDeviceMemory((void **) &state[s].Bq, 7*Np*sizeof(double));
+		ScaLBL_AllocateDeviceMemory((void **) &state[s].Phi, N*sizeof(double));
+		ScaLBL_CopyToDevice(state[s].fq, fq_host, 19*Np*sizeof(double));
+		ScaLBL_CopyToDevice(state[s].Aq, Aq_host, 7*Np*sizeof(double));
+		ScaLBL_CopyToDevice(state[s].Bq, Bq_host, 7*Np*sizeof(double));
+		ScaLBL_CopyToDevice(state[s].Phi, Phi_host, N*sizeof(double));
+	}
+
+	// Separate exchanges
+	ScaLBL_Comm->SendD3Q19AA(state[0].fq);
+	ScaLBL_Comm->RecvD3Q19AA(state[0].fq);
+	ScaLBL_Comm->BiSendD3Q7AA(state[0].Aq, state[0].Bq);
+	ScaLBL_Comm->BiRecvD3Q7AA(state[0].Aq, state[0].Bq);
+	ScaLBL_Comm_Regular->SendHalo(state[0].Phi);
+	ScaLBL_Comm_Regular->RecvHalo(state[0].Phi);
+
+	// Aggregated exchange (one message per neighbor)
+	ScaLBL_Comm->RegisterHaloAA(ScaLBL_Communicator::HALO_D3Q19, state[1].fq);
+	ScaLBL_Comm->RegisterHaloAA(ScaLBL_Communicator::HALO_D3Q7, state[1].Aq);
+	ScaLBL_Comm->RegisterHaloAA(ScaLBL_Communicator::HALO_D3Q7, state[1].Bq);
+	ScaLBL_Comm->RegisterHaloAA(ScaLBL_Communicator::HALO_SCALAR, state[1].Phi);
+	ScaLBL_Comm->SendHaloAA();
+	ScaLBL_Comm->RecvHaloAA();
+	ScaLBL_DeviceBarrier();
+
+	double *fq[2], *Aq[2], *Bq[2], *Phi[2];
+	for (int s=0; s<2; s++){
+		fq[s] = new double[19*Np];
+		Aq[s] = new double[7*Np];
+		Bq[s] = new double[7*Np];
+		Phi[s] = new double[N];
+		ScaLBL_CopyToHost(fq[s], state[s].fq, 19*Np*sizeof(double));
+		ScaLBL_CopyToHost(Aq[s], state[s].Aq, 7*Np*sizeof(double));
+		ScaLBL_CopyToHost(Bq[s], state[s].Bq, 7*Np*sizeof(double));
+		ScaLBL_CopyToHost(Phi[s], state[s].Phi, N*sizeof(double));
+	}
+	int fq_diff = 0, D3Q7_diff = 0, phi_diff = 0, phi_changed = 0;
+	for (int idx=0; idx<19*Np; idx++)
+		if (fq[0][idx] != fq[1][idx]) fq_diff++;
+	for (int idx=0; idx<7*Np; idx++){
+		if (Aq[0][idx] != Aq[1][idx]) D3Q7_diff++;
+		if (Bq[0][idx] != Bq[1][idx]) D3Q7_diff++;
+	}
+	for (int n=0; n<N; n++){
+		if (Phi[0][n] != Phi[1][n]) phi_diff++;
+		if (Phi[1][n] != Phi_host[n]) phi_changed++;
+	}
+	fq_diff = comm.sumReduce(fq_diff);
+	D3Q7_diff = comm.sumReduce(D3Q7_diff);
+	phi_diff = comm.sumReduce(phi_diff);
+	phi_changed = comm.sumReduce(phi_changed);
+	if (rank==0) printf("BC = %i: mismatched values: D3Q19 = %i, D3Q7 = %i, scalar = %i (scalar halo values received = %i) \n",
+			BC,fq_diff,D3Q7_diff,phi_diff,phi_changed);
+	if (fq_diff > 0 || D3Q7_diff > 0 || phi_diff > 0){
+		printf("Aggregated halo exchange does not match the separate exchanges \n");
+		error++;
+	}
+	if (phi_changed == 0){
+		printf("Aggregated halo exchange did not update the scalar halo \n");
+		error++;
+	}
+
+	for (int s=0; s<2; s++){
+		delete [] fq[s];
+		delete [] Aq[s];
+		delete [] Bq[s];
+		delete [] Phi[s];
+		ScaLBL_FreeDeviceMemory(state[s].fq);
+		ScaLBL_FreeDeviceMemory(state[s].Aq);
+		ScaLBL_FreeDeviceMemory(state[s].Bq);
+		ScaLBL_FreeDeviceMemory(state[s].Phi);
+	}
+	delete [] fq_host;
+	delete [] Aq_host;
+	delete [] Bq_host;
+	delete [] Phi_host;
+	delete [] neighborList;
+	return error;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestHaloAA	\n");
+			printf("********************************************************\n");
+		}
+
+		// periodic and pressure boundary conditions (the D3Q7 z faces are skipped at the inlet / outlet)
+		error += TestHalo( comm, 0 );
+		error += TestHalo( comm, 3 );
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
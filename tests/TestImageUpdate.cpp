@@ -0,0 +1,282 @@
+//*************************************************************************
+// Check that the incremental image update re-initializes only the sites
+// that change and keeps the momentum distributions, and that a delta image
+// gives the same labels as Domain::Decomp for an offset into a larger image
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <math.h>
+
+#include "common/Utilities.h"
+#include "models/ColorModel.h"
+#include "analysis/FlowAdaptor.h"
+
+using namespace std;
+
+// global labels: solid sphere (label 0) and a bubble of component B (label 2) in component A (label 1)
+inline signed char GlobalLabel(int x, int y, int z, int n){
+	double xs = x - 0.3*n, ys = y - 0.3*n, zs = z - 0.3*n;
+	if (xs*xs + ys*ys + zs*zs < 16.0) return 0;
+	double xb = x - 0.65*n, yb = y - 0.65*n, zb = z - 0.6*n;
+	if (xb*xb + yb*yb + zb*zb < 16.0) return 2;
+	return 1;
+}
+
+// block of voxels that is switched from component A to component B
+inline bool InBlock(int x, int y, int z){
+	return (x >= 2 && x < 6 && y >= 14 && y < 18 && z >= 3 && z < 7);
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestImageUpdate	\n");
+			printf("********************************************************\n");
+		}
+		int device = ScaLBL_SetDevice( rank );
+		NULL_USE( device );
+		ScaLBL_DeviceBarrier();
+		comm.barrier();
+
+		/*  Populate the input database */
+		int n = 24;
+		auto domain_db = std::make_shared<Database>();
+		auto color_db = std::make_shared<Database>();
+		auto vis_db = std::make_shared<Database>();
+		auto flow_db = std::make_shared<Database>();
+		auto analysis_db = std::make_shared<Database>();
+		auto db = std::make_shared<Database>();
+
+		domain_db->putVector<int>( "nproc", { 1, 1, nprocs } );
+		// the simulation domain starts at (1,1,1) in an image that is larger in x
+		std::vector<int> N = { n + 3, n + 2, n*nprocs + 2 };
+		domain_db->putVector<int>( "N", N );
+		domain_db->putVector<int>( "n", { n, n, n } );
+		domain_db->putVector<int>( "offset", { 1, 1, 1 } );
+		domain_db->putScalar<std::string>( "ReadType", "8bit" );
+		domain_db->putVector<int>( "ReadValues", { 0, 1, 2 } );
+		domain_db->putVector<int>( "WriteValues", { 0, 1, 2 } );
+		domain_db->putScalar<int>( "BC", 0 );
+
+		color_db->putScalar<double>("alpha",0.01);
+		color_db->putScalar<int>("timestepMax",20);
+		color_db->putVector<double>("F", { 0.0, 0.0, 1.0e-5 });
+		color_db->putVector<int>( "ComponentLabels", { 0 } );
+		color_db->putVector<double>( "ComponentAffinity", { 0.5 } );
+
+		db->putDatabase("Color",color_db);
+		db->putDatabase("Domain",domain_db);
+		db->putDatabase("FlowAdaptor",flow_db);
+		db->putDatabase("Visualization",vis_db);
+		db->putDatabase("Analysis",analysis_db);
+
+		ScaLBL_ColorModel ColorModel( rank, nprocs, comm );
+		ColorModel.color_db = color_db;
+		ColorModel.domain_db = domain_db;
+		ColorModel.vis_db = vis_db;
+		ColorModel.analysis_db = analysis_db;
+		ColorModel.db = db;
+		ColorModel.SetDomain();
+
+		int Nx = ColorModel.Dm->Nx;
+		int Ny = ColorModel.Dm->Ny;
+		int Nz = ColorModel.Dm->Nz;
+		int kproc = ColorModel.Dm->kproc();
+		for (int k=0;k<Nz;k++){
+			for (int j=0;j<Ny;j++){
+				for (int i=0;i<Nx;i++){
+					int idx = k*Nx*Ny + j*Nx + i;
+					int z = k - 1 + kproc*(Nz-2);
+					signed char label = GlobalLabel(i-1, j-1, z, n);
+					ColorModel.Mask->id[idx] = label;
+					ColorModel.id[idx] = label;
+					ColorModel.Dm->id[idx] = label;
+					double xs = i - 1 - 0.3*n, ys = j - 1 - 0.3*n, zs = z - 0.3*n;
+					ColorModel.Averages->SDs(i,j,k) = sqrt(xs*xs + ys*ys + zs*zs) - 4.0;
+				}
+			}
+		}
+		ColorModel.Create();
+		ColorModel.Initialize();
+		ColorModel.Run(20);
+
+		int Np = ColorModel.Np;
+		double *fq_before = new double[19*Np];
+		double *Aq_before = new double[7*Np];
+		double *fq_after = new double[19*Np];
+		double *Aq_after = new double[7*Np];
+		double *Bq_after = new double[7*Np];
+		ScaLBL_CopyToHost(fq_before, ColorModel.fq, 19*Np*sizeof(double));
+		ScaLBL_CopyToHost(Aq_before, ColorModel.Aq, 7*Np*sizeof(double));
+
+		/* list the voxels in the block that belong to component A, plus one unchanged voxel */
+		if (rank == 0){
+			std::vector<int> delta;
+			for (int z=0; z<n*nprocs; z++){
+				for (int y=0; y<n; y++){
+					for (int x=0; x<n; x++){
+						if (InBlock(x,y,z) && GlobalLabel(x,y,z,n) == 1){
+							delta.insert(delta.end(), { x, y, z, 2 });
+						}
+					}
+				}
+			}
+			delta.insert(delta.end(), { 20, 2, 20, GlobalLabel(20,2,20,n) });
+			FILE *DELTA = fopen("TestImageUpdate.delta","wb");
+			fwrite(delta.data(), sizeof(int), delta.size(), DELTA);
+			fclose(DELTA);
+		}
+		comm.barrier();
+
+		FlowAdaptor Adapt(ColorModel);
+		Adapt.ImageUpdate(ColorModel, "TestImageUpdate.delta");
+		ScaLBL_CopyToHost(fq_after, ColorModel.fq, 19*Np*sizeof(double));
+		ScaLBL_CopyToHost(Aq_after, ColorModel.Aq, 7*Np*sizeof(double));
+		ScaLBL_CopyToHost(Bq_after, ColorModel.Bq, 7*Np*sizeof(double));
+		double *Phase = new double[Nx*Ny*Nz];
+		ColorModel.CopyPhaseToHost(Phase);
+
+		int changed = 0;
+		double fq_diff = 0.0, Aq_diff = 0.0, phi_diff = 0.0;
+		for (int q=0; q<19*Np; q++)
+			fq_diff = max(fq_diff, fabs(fq_after[q] - fq_before[q]));
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int idx = ColorModel.Map(i,j,k);
+					if (idx < 0) continue;
+					int z = k - 1 + kproc*(Nz-2);
+					if (InBlock(i-1,j-1,z) && GlobalLabel(i-1,j-1,z,n) == 1){
+						changed++;
+						if (ColorModel.id[k*Nx*Ny + j*Nx + i] != 2) error++;
+						phi_diff = max(phi_diff, fabs(Phase[k*Nx*Ny + j*Nx + i] + 1.0));
+						// pure component B at rest
+						for (int q=0; q<7; q++){
+							Aq_diff = max(Aq_diff, fabs(Aq_after[q*Np+idx]));
+						}
+						Aq_diff = max(Aq_diff, fabs(Bq_after[idx] - 0.3333333333333333));
+						for (int q=1; q<7; q++){
+							Aq_diff = max(Aq_diff, fabs(Bq_after[q*Np+idx] - 0.1111111111111111));
+						}
+					}
+					else {
+						for (int q=0; q<7; q++){
+							Aq_diff = max(Aq_diff, fabs(Aq_after[q*Np+idx] - Aq_before[q*Np+idx]));
+						}
+					}
+				}
+			}
+		}
+		changed = comm.sumReduce(changed);
+		fq_diff = comm.maxReduce(fq_diff);
+		Aq_diff = comm.maxReduce(Aq_diff);
+		phi_diff = comm.maxReduce(phi_diff);
+		if (rank==0) printf("  updated %i sites: max difference fq = %e, Aq/Bq = %e, phi = %e \n",changed,fq_diff,Aq_diff,phi_diff);
+		if (changed == 0 || fq_diff > 0.0 || Aq_diff > 1e-14 || phi_diff > 1e-14){
+			if (rank==0) printf("Incremental update does not match the expected state \n");
+			error++;
+		}
+
+		/* changing a fluid voxel to solid re-initializes all sites */
+		if (rank == 0){
+			std::vector<int> delta = { 12, 12, 12, 0 };
+			FILE *DELTA = fopen("TestImageUpdate.delta","wb");
+			fwrite(delta.data(), sizeof(int), delta.size(), DELTA);
+			fclose(DELTA);
+		}
+		comm.barrier();
+		Adapt.ImageUpdate(ColorModel, "TestImageUpdate.delta");
+		ScaLBL_CopyToHost(fq_after, ColorModel.fq, 19*Np*sizeof(double));
+		fq_diff = 0.0;
+		for (int idx=0; idx<Np; idx++)
+			fq_diff = max(fq_diff, fabs(fq_after[idx] - 0.3333333333333333));
+		fq_diff = comm.maxReduce(fq_diff);
+		if (fq_diff > 0.0){
+			if (rank==0) printf("Solid change did not re-initialize the simulation \n");
+			error++;
+		}
+
+		/* a delta image matches Decomp of the full image, including the halo */
+		std::vector<char> image( N[0]*N[1]*N[2] );
+		for (int z=0; z<N[2]; z++)
+			for (int y=0; y<N[1]; y++)
+				for (int x=0; x<N[0]; x++)
+					image[(z*N[1] + y)*N[0] + x] = GlobalLabel(x-1, y-1, z-1, n);
+		if (rank == 0){
+			FILE *IMAGE = fopen("TestImageUpdate.raw","wb");
+			fwrite(image.data(), 1, image.size(), IMAGE);
+			fclose(IMAGE);
+		}
+		comm.barrier();
+		ColorModel.Mask->Decomp("TestImageUpdate.raw");
+		for (int idx=0; idx<Nx*Ny*Nz; idx++){
+			ColorModel.id[idx] = ColorModel.Mask->id[idx];
+			ColorModel.Dm->id[idx] = ColorModel.Mask->id[idx];
+		}
+		// change the fluid voxels on the sub-domain faces and in the column of the image past the domain
+		std::vector<int> delta;
+		for (int z=0; z<n*nprocs; z++){
+			for (int y=0; y<n; y++){
+				for (int x=0; x<=n; x++){
+					bool face = x == 0 || x >= n-1 || y == 0 || y == n-1 || z%n == 0 || z%n == n-1;
+					char &label = image[((z+1)*N[1] + y+1)*N[0] + x+1];
+					if (face && label == 1 && (x + y + z)%3 == 0){
+						label = 2;
+						delta.insert(delta.end(), { x, y, z, 2 });
+					}
+				}
+			}
+		}
+		if (rank == 0){
+			FILE *DELTA = fopen("TestImageUpdate.delta","wb");
+			fwrite(delta.data(), sizeof(int), delta.size(), DELTA);
+			fclose(DELTA);
+			FILE *IMAGE = fopen("TestImageUpdate.raw","wb");
+			fwrite(image.data(), 1, image.size(), IMAGE);
+			fclose(IMAGE);
+		}
+		comm.barrier();
+		Adapt.ImageUpdate(ColorModel, "TestImageUpdate.delta");
+		std::vector<signed char> updated( ColorModel.Mask->id.data(), ColorModel.Mask->id.data() + Nx*Ny*Nz );
+		ColorModel.Mask->Decomp("TestImageUpdate.raw");
+		int mismatch = 0;
+		for (int idx=0; idx<Nx*Ny*Nz; idx++){
+			if (updated[idx] != ColorModel.Mask->id[idx]) mismatch++;
+		}
+		mismatch = comm.sumReduce(mismatch);
+		if (rank==0) printf("  delta image with offset: %i voxels changed, %i mismatched labels \n",
+		                    (int) delta.size()/4, mismatch);
+		if (mismatch > 0){
+			if (rank==0) printf("Delta image does not match the decomposition of the full image \n");
+			error++;
+		}
+		if (rank == 0){
+			remove("TestImageUpdate.raw");
+			remove("TestImageUpdate.delta");
+		}
+		char LocalRankFilename[40];
+		sprintf(LocalRankFilename, "ID.%05i", rank);
+		remove(LocalRankFilename);
+
+		delete [] fq_before;
+		delete [] Aq_before;
+		delete [] fq_after;
+		delete [] Aq_after;
+		delete [] Bq_after;
+		delete [] Phase;
+		error = comm.sumReduce(error);
+		if (rank==0 && error==0) printf("TestImageUpdate passed \n");
+	}
+	comm.barrier();
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,247 @@
+//*************************************************************************
+// Check that the fused multi-species ion kernels and the multi-component
+// D3Q7 halo exchange reproduce the per-species update
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <math.h>
+#include "common/ScaLBL.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( int nprocs )
+{
+    auto db = std::make_shared<Database>();
+    db->putScalar<int>( "BC", 0 );
+    db->putVector<int>( "nproc", { 1, 1, nprocs } );
+    db->putVector<int>( "n", { 16, 16, 16 } );
+    db->putScalar<int>( "nspheres", 1 );
+    db->putVector<double>( "L", { 1, 1, 1 } );
+    return db;
+}
+
+struct IonState {
+	double *fq, *Ci, *FluxDiffusive, *FluxAdvective, *FluxElectrical;
+};
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestIonMulti	\n");
+			printf("********************************************************\n");
+		}
+
+		auto db = loadInputs( nprocs );
+		auto Dm = std::make_shared<Domain>(db,comm);
+		int Nx = Dm->Nx;
+		int Ny = Dm->Ny;
+		int Nz = Dm->Nz;
+
+		// Solid sphere in each sub-domain
+		int Np = 0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int n = k*Nx*Ny+j*Nx+i;
+					double x = i - 0.4*Nx;
+					double y = j - 0.4*Ny;
+					double z = k - 0.4*Nz;
+					if (x*x+y*y+z*z < 9.0) Dm->id[n] = 0;
+					else {
+						Dm->id[n] = 1;
+						Np++;
+					}
+				}
+			}
+		}
+		Dm->CommInit();
+
+		std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+		IntArray Map(Nx,Ny,Nz);
+		int *neighborList = new int[18*(Np+64)];
+		Np = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+		int *NeighborList;
+		ScaLBL_AllocateDeviceMemory((void **) &NeighborList, 18*Np*sizeof(int));
+		ScaLBL_CopyToDevice(NeighborList, neighborList, 18*Np*sizeof(int));
+
+		// Three species: (diffusivity, valence, 1/tau)
+		const int Nspecies = 3;
+		double Di[Nspecies] = { 0.1, 0.05, 0.08 };
+		int zi[Nspecies] = { 1, -1, 2 };
+		double tau[Nspecies] = { 0.8, 1.0, 1.2 };
+		double Vt = 1.0;
+		double coef[3*Nspecies];
+		int species[Nspecies];
+		std::vector<int> Components;
+		for (int ic=0; ic<Nspecies; ic++){
+			coef[3*ic] = Di[ic];
+			coef[3*ic+1] = zi[ic];
+			coef[3*ic+2] = 1.0/tau[ic];
+			species[ic] = ic;
+			Components.push_back(ic);
+		}
+		double *IonCoef;
+		int *dvcSpecies;
+		ScaLBL_AllocateDeviceMemory((void **) &IonCoef, 3*Nspecies*sizeof(double));
+		ScaLBL_AllocateDeviceMemory((void **) &dvcSpecies, Nspecies*sizeof(int));
+		ScaLBL_CopyToDevice(IonCoef, coef, 3*Nspecies*sizeof(double));
+		ScaLBL_CopyToDevice(dvcSpecies, species, Nspecies*sizeof(int));
+
+		// Non-uniform concentration, velocity and electric field
+		double *Ci_host = new double[Nspecies*Np];
+		double *Vel_host = new double[3*Np];
+		for (int idx=0; idx<Nspecies*Np; idx++) Ci_host[idx] = 0.0;
+		for (int idx=0; idx<3*Np; idx++) Vel_host[idx] = 0.0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int idx = Map(i,j,k);
+					if (idx < 0) continue;
+					double z = k + rank*(Nz-2);
+					for (int ic=0; ic<Nspecies; ic++)
+						Ci_host[ic*Np+idx] = 1.0 + 0.1*(ic+1)*sin(0.3*i + 0.2*z);
+					Vel_host[idx] = 1.0e-3*cos(0.2*j);
+					Vel_host[Np+idx] = 2.0e-3*sin(0.1*i);
+					Vel_host[2*Np+idx] = 1.0e-3;
+				}
+			}
+		}
+		double *Velocity, *ElectricField;
+		ScaLBL_AllocateDeviceMemory((void **) &Velocity, 3*Np*sizeof(double));
+		ScaLBL_AllocateDeviceMemory((void **) &ElectricField, 3*Np*sizeof(double));
+		ScaLBL_CopyToDevice(Velocity, Vel_host, 3*Np*sizeof(double));
+		for (int idx=0; idx<3*Np; idx++) Vel_host[idx] *= 2.0;
+		ScaLBL_CopyToDevice(ElectricField, Vel_host, 3*Np*sizeof(double));
+
+		IonState state[2];
+		for (int s=0; s<2; s++){
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].fq, 7*Nspecies*Np*sizeof(double));
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].Ci, Nspecies*Np*sizeof(double));
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].FluxDiffusive, 3*Nspecies*Np*sizeof(double));
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].FluxAdvective, 3*Nspecies*Np*sizeof(double));
+			ScaLBL_AllocateDeviceMemory((void **) &state[s].FluxElectrical, 3*Nspecies*Np*sizeof(double));
+			ScaLBL_CopyToDevice(state[s].Ci, Ci_host, Nspecies*Np*sizeof(double));
+			for (int ic=0; ic<Nspecies; ic++)
+				ScaLBL_D3Q7_Ion_Init_FromFile(&state[s].fq[ic*7*Np], &state[s].Ci[ic*Np], Np);
+		}
+
+		int timestepMax = 20;
+		// per-species update, as in ScaLBL_IonModel::Run
+		{
+			double *fq = state[0].fq;
+			double *Ci = state[0].Ci;
+			for (int ic=0; ic<Nspecies; ic++){
+				double *Aq = &fq[ic*7*Np];
+				double *Den = &Ci[ic*Np];
+				double *FluxD = &state[0].FluxDiffusive[3*ic*Np];
+				double *FluxA = &state[0].FluxAdvective[3*ic*Np];
+				double *FluxE = &state[0].FluxElectrical[3*ic*Np];
+				double rlx = 1.0/tau[ic];
+				for (int timestep=0; timestep<timestepMax; timestep+=2){
+					ScaLBL_Comm->SendD3Q7AA(fq, ic);
+					ScaLBL_D3Q7_AAodd_IonConcentration(NeighborList, Aq, Den, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+					ScaLBL_Comm->RecvD3Q7AA(fq, ic);
+					ScaLBL_D3Q7_AAodd_IonConcentration(NeighborList, Aq, Den, 0, ScaLBL_Comm->LastExterior(), Np);
+					ScaLBL_D3Q7_AAodd_Ion_v0(NeighborList, Aq, Den, FluxD, FluxA, FluxE, Velocity, ElectricField,
+							Di[ic], zi[ic], rlx, Vt, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+					ScaLBL_D3Q7_AAodd_Ion_v0(NeighborList, Aq, Den, FluxD, FluxA, FluxE, Velocity, ElectricField,
+							Di[ic], zi[ic], rlx, Vt, 0, ScaLBL_Comm->LastExterior(), Np);
+
+					ScaLBL_Comm->SendD3Q7AA(fq, ic);
+					ScaLBL_D3Q7_AAeven_IonConcentration(Aq, Den, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+					ScaLBL_Comm->RecvD3Q7AA(fq, ic);
+					ScaLBL_D3Q7_AAeven_IonConcentration(Aq, Den, 0, ScaLBL_Comm->LastExterior(), Np);
+					ScaLBL_D3Q7_AAeven_Ion_v0(Aq, Den, FluxD, FluxA, FluxE, Velocity, ElectricField,
+							Di[ic], zi[ic], rlx, Vt, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+					ScaLBL_D3Q7_AAeven_Ion_v0(Aq, Den, FluxD, FluxA, FluxE, Velocity, ElectricField,
+							Di[ic], zi[ic], rlx, Vt, 0, ScaLBL_Comm->LastExterior(), Np);
+				}
+			}
+		}
+		// fused update, as in ScaLBL_IonModel::RunSpeciesGroup
+		{
+			double *fq = state[1].fq;
+			double *Ci = state[1].Ci;
+			for (int timestep=0; timestep<timestepMax; timestep+=2){
+				ScaLBL_Comm->MultiSendD3Q7AA(fq, Components);
+				ScaLBL_D3Q7_AAodd_Ion_Multi(NeighborList, fq, Ci, state[1].FluxDiffusive, state[1].FluxAdvective, state[1].FluxElectrical,
+						Velocity, ElectricField, IonCoef, dvcSpecies, Nspecies, Vt, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+				ScaLBL_Comm->MultiRecvD3Q7AA(fq, Components);
+				ScaLBL_D3Q7_AAodd_Ion_Multi(NeighborList, fq, Ci, state[1].FluxDiffusive, state[1].FluxAdvective, state[1].FluxElectrical,
+						Velocity, ElectricField, IonCoef, dvcSpecies, Nspecies, Vt, 0, ScaLBL_Comm->LastExterior(), Np);
+
+				ScaLBL_Comm->MultiSendD3Q7AA(fq, Components);
+				ScaLBL_D3Q7_AAeven_Ion_Multi(fq, Ci, state[1].FluxDiffusive, state[1].FluxAdvective, state[1].FluxElectrical,
+						Velocity, ElectricField, IonCoef, dvcSpecies, Nspecies, Vt, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+				ScaLBL_Comm->MultiRecvD3Q7AA(fq, Components);
+				ScaLBL_D3Q7_AAeven_Ion_Multi(fq, Ci, state[1].FluxDiffusive, state[1].FluxAdvective, state[1].FluxElectrical,
+						Velocity, ElectricField, IonCoef, dvcSpecies, Nspecies, Vt, 0, ScaLBL_Comm->LastExterior(), Np);
+			}
+		}
+		ScaLBL_DeviceBarrier();
+
+		// Compare the distributions, concentrations and fluxes from both schedules
+		double *cfq[2], *cCi[2], *cFlux[2];
+		for (int s=0; s<2; s++){
+			cfq[s] = new double[7*Nspecies*Np];
+			cCi[s] = new double[Nspecies*Np];
+			cFlux[s] = new double[3*Nspecies*Np];
+			ScaLBL_CopyToHost(cfq[s], state[s].fq, 7*Nspecies*Np*sizeof(double));
+			ScaLBL_CopyToHost(cCi[s], state[s].Ci, Nspecies*Np*sizeof(double));
+			ScaLBL_CopyToHost(cFlux[s], state[s].FluxDiffusive, 3*Nspecies*Np*sizeof(double));
+		}
+		double fq_diff = 0.0, ci_diff = 0.0, flux_diff = 0.0;
+		for (int idx=0; idx<ScaLBL_Comm->LastInterior(); idx++){
+			if (idx >= ScaLBL_Comm->LastExterior() && idx < ScaLBL_Comm->FirstInterior()) continue;
+			for (int ic=0; ic<Nspecies; ic++){
+				for (int q=0; q<7; q++)
+					fq_diff = max(fq_diff, fabs(cfq[0][(ic*7+q)*Np+idx]-cfq[1][(ic*7+q)*Np+idx]));
+				ci_diff = max(ci_diff, fabs(cCi[0][ic*Np+idx]-cCi[1][ic*Np+idx]));
+				for (int d=0; d<3; d++)
+					flux_diff = max(flux_diff, fabs(cFlux[0][(3*ic+d)*Np+idx]-cFlux[1][(3*ic+d)*Np+idx]));
+			}
+		}
+		fq_diff = comm.maxReduce(fq_diff);
+		ci_diff = comm.maxReduce(ci_diff);
+		flux_diff = comm.maxReduce(flux_diff);
+		if (rank==0) printf("  max difference fq = %e, Ci = %e, flux = %e \n",fq_diff,ci_diff,flux_diff);
+		if (fq_diff > 1.0e-12 || ci_diff > 1.0e-12 || flux_diff > 1.0e-12){
+			printf("Fused ion kernels do not match the per-species update \n");
+			error++;
+		}
+
+		for (int s=0; s<2; s++){
+			delete [] cfq[s];
+			delete [] cCi[s];
+			delete [] cFlux[s];
+			ScaLBL_FreeDeviceMemory(state[s].fq);
+			ScaLBL_FreeDeviceMemory(state[s].Ci);
+			ScaLBL_FreeDeviceMemory(state[s].FluxDiffusive);
+			ScaLBL_FreeDeviceMemory(state[s].FluxAdvective);
+			ScaLBL_FreeDeviceMemory(state[s].FluxElectrical);
+		}
+		ScaLBL_FreeDeviceMemory(NeighborList);
+		ScaLBL_FreeDeviceMemory(IonCoef);
+		ScaLBL_FreeDeviceMemory(dvcSpecies);
+		ScaLBL_FreeDeviceMemory(Velocity);
+		ScaLBL_FreeDeviceMemory(ElectricField);
+		delete [] Ci_host;
+		delete [] Vel_host;
+		delete [] neighborList;
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
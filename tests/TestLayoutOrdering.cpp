@@ -0,0 +1,148 @@
+//*************************************************************************
+// Check the interior orderings supported by MemoryOptimizedLayoutAA
+//   - Map must be a permutation of the fluid sites
+//   - neighborList must point to the (i,j,k) neighbors for each ordering
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <vector>
+#include "common/ScaLBL.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( int nprocs )
+{
+    auto db = std::make_shared<Database>();
+    db->putScalar<int>( "BC", 0 );
+    db->putVector<int>( "nproc", { 1, 1, 1 } );
+    db->putVector<int>( "n", { 20, 20, 20 } );
+    db->putScalar<int>( "nspheres", 1 );
+    db->putVector<double>( "L", { 1, 1, 1 } );
+    return db;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		static int D3Q19[18][3]={{1,0,0},{-1,0,0},{0,1,0},{0,-1,0},{0,0,1},{0,0,-1},
+				{1,1,0},{-1,-1,0},{1,-1,0},{-1,1,0},
+				{1,0,1},{-1,0,-1},{1,0,-1},{-1,0,1},
+				{0,1,1},{0,-1,-1},{0,1,-1},{0,-1,1}};
+
+		int rank = comm.getRank();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestLayoutOrdering	\n");
+			printf("********************************************************\n");
+		}
+
+		auto db = loadInputs( comm.getSize() );
+		auto Dm = std::make_shared<Domain>(db,comm);
+		int Nx = Dm->Nx;
+		int Ny = Dm->Ny;
+		int Nz = Dm->Nz;
+
+		// Porous geometry: solid sphere in the center of the domain
+		int Np = 0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int n = k*Nx*Ny+j*Nx+i;
+					double x = i - 0.5*Nx;
+					double y = j - 0.5*Ny;
+					double z = k - 0.5*Nz;
+					if (x*x+y*y+z*z < 36.0) Dm->id[n] = 0;
+					else {
+						Dm->id[n] = 1;
+						Np++;
+					}
+				}
+			}
+		}
+		Dm->CommInit();
+
+		const char *orderings[4] = { "lexicographic", "tiled", "morton", "hilbert" };
+		for (int ord=0; ord<4; ord++){
+			db->putScalar<std::string>( "LayoutOrdering", orderings[ord] );
+			db->putScalar<int>( "LayoutTileSize", 4 );
+			// each layout needs a fresh communicator since the send lists are remapped
+			std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+
+			int Npad=Np+64;
+			IntArray Map(Nx,Ny,Nz);
+			int *neighborList = new int[18*Npad];
+			int Nsites = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+
+			// Map must visit each fluid site exactly once
+			std::vector<int> count(Nsites,0);
+			int nfluid = 0;
+			for (int k=1;k<Nz-1;k++){
+				for (int j=1;j<Ny-1;j++){
+					for (int i=1;i<Nx-1;i++){
+						int idx = Map(i,j,k);
+						if (Dm->id[k*Nx*Ny+j*Nx+i] > 0){
+							nfluid++;
+							if (idx < 0 || idx >= Nsites) error++;
+							else count[idx]++;
+						}
+						else if (!(idx < 0)) error++;
+					}
+				}
+			}
+			for (int idx=0; idx<Nsites; idx++){
+				bool used = idx < ScaLBL_Comm->LastExterior() ||
+					(idx >= ScaLBL_Comm->FirstInterior() && idx < ScaLBL_Comm->LastInterior());
+				if (used && count[idx] != 1) error++;
+				if (!used && count[idx] != 0) error++;
+			}
+			if (nfluid != Np) error++;
+
+			// neighborList must be consistent with the lattice neighbors
+			for (int k=1;k<Nz-1;k++){
+				for (int j=1;j<Ny-1;j++){
+					for (int i=1;i<Nx-1;i++){
+						int idx = Map(i,j,k);
+						if (idx < 0) continue;
+						for (int q=0; q<18; q++){
+							int neighbor = Map(i-D3Q19[q][0],j-D3Q19[q][1],k-D3Q19[q][2]);
+							int expected;
+							if (neighbor < 0) expected = idx + ((q^1)+1)*Nsites;
+							else              expected = neighbor + (q+1)*Nsites;
+							if (neighborList[q*Nsites+idx] != expected){
+								if (error < 10)
+									printf("%s: neighborlist error at (%i,%i,%i), q=%i \n",orderings[ord],i,j,k,q);
+								error++;
+							}
+						}
+					}
+				}
+			}
+
+			// Report the performance for each ordering
+			int *NeighborList;
+			double *fq;
+			ScaLBL_AllocateDeviceMemory((void **) &NeighborList, 18*Nsites*sizeof(int));
+			ScaLBL_AllocateDeviceMemory((void **) &fq, 19*Nsites*sizeof(double));
+			ScaLBL_CopyToDevice(NeighborList, neighborList, 18*Nsites*sizeof(int));
+			double MLUPS = ScaLBL_Comm->GetPerformance(NeighborList, fq, Nsites);
+			if (rank==0) printf("  %s ordering: MLUPS=%f \n",orderings[ord],MLUPS);
+			ScaLBL_FreeDeviceMemory(NeighborList);
+			ScaLBL_FreeDeviceMemory(fq);
+			delete [] neighborList;
+		}
+
+		error = comm.maxReduce(error);
+		if (rank==0){
+			if (error==0) printf("All tests passed \n");
+			else printf("TestLayoutOrdering failed (%i errors) \n",error);
+		}
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,143 @@
+//*************************************************************************
+// Compare the MRT model with distributions stored in double and single
+// precision for force-driven flow between parallel plates
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <math.h>
+#include "common/ScaLBL.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( int nprocs )
+{
+    auto db = std::make_shared<Database>();
+    db->putScalar<int>( "BC", 0 );
+    db->putVector<int>( "nproc", { 1, 1, 1 } );
+    db->putVector<int>( "n", { 16, 16, 16 } );
+    db->putScalar<int>( "nspheres", 1 );
+    db->putVector<double>( "L", { 1, 1, 1 } );
+    return db;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestMRTPrecision	\n");
+			printf("********************************************************\n");
+		}
+
+		auto db = loadInputs( comm.getSize() );
+		auto Dm = std::make_shared<Domain>(db,comm);
+		int Nx = Dm->Nx;
+		int Ny = Dm->Ny;
+		int Nz = Dm->Nz;
+
+		// Parallel plates normal to y
+		int Np = 0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int n = k*Nx*Ny+j*Nx+i;
+					if (j==1 || j==Ny-2) Dm->id[n] = 0;
+					else {
+						Dm->id[n] = 1;
+						Np++;
+					}
+				}
+			}
+		}
+		Dm->CommInit();
+
+		std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+		IntArray Map(Nx,Ny,Nz);
+		int *neighborList = new int[18*(Np+64)];
+		Np = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+
+		int *NeighborList;
+		double *fq, *Velocity;
+		float *fq_float;
+		ScaLBL_AllocateDeviceMemory((void **) &NeighborList, 18*Np*sizeof(int));
+		ScaLBL_AllocateDeviceMemory((void **) &fq, 19*Np*sizeof(double));
+		ScaLBL_AllocateDeviceMemory((void **) &fq_float, 19*Np*sizeof(float));
+		ScaLBL_AllocateDeviceMemory((void **) &Velocity, 3*Np*sizeof(double));
+		ScaLBL_CopyToDevice(NeighborList, neighborList, 18*Np*sizeof(int));
+
+		double rlx_setA = 1.0;
+		double rlx_setB = 8.f*(2.f-rlx_setA)/(8.f-rlx_setA);
+		double Fx = 1.0e-5;
+		int timestepMax = 400;
+
+		ScaLBL_D3Q19_Init(fq, Np);
+		ScaLBL_D3Q19_Init_float(fq_float, Np);
+		for (int timestep=0; timestep<timestepMax; timestep+=2){
+			ScaLBL_Comm->SendD3Q19AA(fq);
+			ScaLBL_D3Q19_AAodd_MRT(NeighborList, fq, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np, rlx_setA, rlx_setB, Fx, 0.0, 0.0);
+			ScaLBL_Comm->RecvD3Q19AA(fq);
+			ScaLBL_D3Q19_AAodd_MRT(NeighborList, fq, 0, ScaLBL_Comm->LastExterior(), Np, rlx_setA, rlx_setB, Fx, 0.0, 0.0);
+			ScaLBL_Comm->SendD3Q19AA(fq);
+			ScaLBL_D3Q19_AAeven_MRT(fq, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np, rlx_setA, rlx_setB, Fx, 0.0, 0.0);
+			ScaLBL_Comm->RecvD3Q19AA(fq);
+			ScaLBL_D3Q19_AAeven_MRT(fq, 0, ScaLBL_Comm->LastExterior(), Np, rlx_setA, rlx_setB, Fx, 0.0, 0.0);
+
+			ScaLBL_Comm->SendD3Q19AA(fq_float);
+			ScaLBL_D3Q19_AAodd_MRT_float(NeighborList, fq_float, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np, rlx_setA, rlx_setB, Fx, 0.0, 0.0);
+			ScaLBL_Comm->RecvD3Q19AA(fq_float);
+			ScaLBL_D3Q19_AAodd_MRT_float(NeighborList, fq_float, 0, ScaLBL_Comm->LastExterior(), Np, rlx_setA, rlx_setB, Fx, 0.0, 0.0);
+			ScaLBL_Comm->SendD3Q19AA(fq_float);
+			ScaLBL_D3Q19_AAeven_MRT_float(fq_float, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np, rlx_setA, rlx_setB, Fx, 0.0, 0.0);
+			ScaLBL_Comm->RecvD3Q19AA(fq_float);
+			ScaLBL_D3Q19_AAeven_MRT_float(fq_float, 0, ScaLBL_Comm->LastExterior(), Np, rlx_setA, rlx_setB, Fx, 0.0, 0.0);
+		}
+		ScaLBL_DeviceBarrier();
+
+		DoubleArray Vx(Nx,Ny,Nz), Vx_float(Nx,Ny,Nz);
+		ScaLBL_D3Q19_Momentum(fq, Velocity, Np);
+		ScaLBL_Comm->RegularLayout(Map, &Velocity[0], Vx);
+		ScaLBL_D3Q19_Momentum_float(fq_float, Velocity, Np);
+		ScaLBL_Comm->RegularLayout(Map, &Velocity[0], Vx_float);
+
+		double vmax = 0.0;
+		double diff = 0.0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					vmax = max(vmax, fabs(Vx(i,j,k)));
+					diff = max(diff, fabs(Vx(i,j,k)-Vx_float(i,j,k)));
+				}
+			}
+		}
+		vmax = comm.maxReduce(vmax);
+		diff = comm.maxReduce(diff);
+		if (rank==0) printf("Maximum velocity = %e, difference (single - double) = %e \n",vmax,diff);
+		if (!(vmax > 0.0) || diff > 1.0e-3*vmax){
+			printf("Single precision velocity does not match double precision \n");
+			error++;
+		}
+
+		// MRT performance with each storage
+		double MLUPS = ScaLBL_Comm->GetPerformance(NeighborList, fq, Np);
+		double MLUPS_float = ScaLBL_Comm->GetPerformance(NeighborList, fq_float, Np);
+		if (rank==0) printf("MLUPS: double = %f, single = %f \n",MLUPS,MLUPS_float);
+
+		ScaLBL_FreeDeviceMemory(NeighborList);
+		ScaLBL_FreeDeviceMemory(fq);
+		ScaLBL_FreeDeviceMemory(fq_float);
+		ScaLBL_FreeDeviceMemory(Velocity);
+		delete [] neighborList;
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,149 @@
+//*************************************************************************
+// Check the single and multi-field mesh halo exchange (including the
+// split-phase start/finish version and overlapping exchanges) against the periodic global values
+//*************************************************************************
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include "common/Domain.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( const std::vector<int> &nproc, const std::vector<int> &n )
+{
+	auto db = std::make_shared<Database>();
+	db->putScalar<int>( "BC", 0 );
+	db->putVector<int>( "nproc", nproc );
+	db->putVector<int>( "n", n );
+	db->putScalar<int>( "nspheres", 0 );
+	db->putVector<double>( "L", { 1, 1, 1 } );
+	return db;
+}
+
+static inline double globalValue( int x, int y, int z, int f )
+{
+	return x + 100*y + 10000*z + 0.125*f;
+}
+
+// Set the interior to the global values and the halo to zero
+static void fill( const Domain &Dm, const std::vector<int> &N, DoubleArray &Mesh, int f )
+{
+	int Nx = Dm.Nx, Ny = Dm.Ny, Nz = Dm.Nz;
+	Mesh.resize( Nx, Ny, Nz );
+	Mesh.fill( 0 );
+	for (int k=1; k<Nz-1; k++){
+		for (int j=1; j<Ny-1; j++){
+			for (int i=1; i<Nx-1; i++){
+				int x = Dm.iproc()*(Nx-2) + i - 1;
+				int y = Dm.jproc()*(Ny-2) + j - 1;
+				int z = Dm.kproc()*(Nz-2) + k - 1;
+				Mesh(i,j,k) = globalValue( x, y, z, f );
+			}
+		}
+	}
+}
+
+// Count the mismatched values (the eight corners are not exchanged)
+static int check( const Domain &Dm, const std::vector<int> &N, const DoubleArray &Mesh, int f )
+{
+	int Nx = Dm.Nx, Ny = Dm.Ny, Nz = Dm.Nz;
+	int error = 0;
+	for (int k=0; k<Nz; k++){
+		for (int j=0; j<Ny; j++){
+			for (int i=0; i<Nx; i++){
+				int faces = (i==0||i==Nx-1) + (j==0||j==Ny-1) + (k==0||k==Nz-1);
+				if (faces == 3) continue;
+				int x = ( Dm.iproc()*(Nx-2) + i - 1 + N[0] ) % N[0];
+				int y = ( Dm.jproc()*(Ny-2) + j - 1 + N[1] ) % N[1];
+				int z = ( Dm.kproc()*(Nz-2) + k - 1 + N[2] ) % N[2];
+				if ( Mesh(i,j,k) != globalValue( x, y, z, f ) ) error++;
+			}
+		}
+	}
+	return error;
+}
+
+static int CheckHalo( const std::string &name, const std::vector<int> &nproc, const Utilities::MPI &comm )
+{
+	std::vector<int> N = { 12, 10, 8 };
+	std::vector<int> n = { N[0]/nproc[0], N[1]/nproc[1], N[2]/nproc[2] };
+	auto db = loadInputs( nproc, n );
+	auto Dm = std::make_shared<Domain>( db, comm );
+	for (int i=0; i<Dm->Nx*Dm->Ny*Dm->Nz; i++)
+		Dm->id[i] = 1;
+	Dm->CommInit();
+
+	int error = 0;
+	// Single field
+	DoubleArray A, B, C;
+	fill( *Dm, N, A, 0 );
+	Dm->CommunicateMeshHalo( A );
+	error += check( *Dm, N, A, 0 );
+
+	// Several fields in one exchange
+	fill( *Dm, N, A, 1 );
+	fill( *Dm, N, B, 2 );
+	fill( *Dm, N, C, 3 );
+	Dm->CommunicateMeshHalo( { &A, &B, &C } );
+	error += check( *Dm, N, A, 1 ) + check( *Dm, N, B, 2 ) + check( *Dm, N, C, 3 );
+
+	// Split-phase exchange with the interior updated in between
+	fill( *Dm, N, A, 4 );
+	fill( *Dm, N, B, 5 );
+	auto halo = Dm->CommunicateMeshHaloStart( { &A, &B } );
+	double sum = 0.0;
+	for (int k=2; k<Dm->Nz-2; k++)
+		for (int j=2; j<Dm->Ny-2; j++)
+			for (int i=2; i<Dm->Nx-2; i++)
+				sum += A(i,j,k) - B(i,j,k);
+	halo.finish();
+	error += check( *Dm, N, A, 4 ) + check( *Dm, N, B, 5 );
+	if ( sum > 0.0 ) error++;
+
+	// Overlapping exchanges finished in the opposite order, with a blocking
+	// exchange of a third field while both are in flight
+	fill( *Dm, N, A, 6 );
+	fill( *Dm, N, B, 7 );
+	fill( *Dm, N, C, 8 );
+	auto haloA = Dm->CommunicateMeshHaloStart( { &A } );
+	auto haloB = Dm->CommunicateMeshHaloStart( { &B } );
+	Dm->CommunicateMeshHalo( C );
+	Dm->CommunicateMeshHaloFinish( haloB );
+	haloA.finish();
+	error += check( *Dm, N, A, 6 ) + check( *Dm, N, B, 7 ) + check( *Dm, N, C, 8 );
+
+	error = comm.sumReduce( error );
+	if ( comm.getRank() == 0 )
+		printf("%s: %i errors \n", name.c_str(), error );
+	return error;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestMeshHalo	\n");
+			printf("********************************************************\n");
+		}
+
+		std::vector<int> zslab = { 1, 1, nprocs };
+		std::vector<int> blocks = zslab;
+		if (nprocs == 4) blocks = { 2, 2, 1 };
+		error += CheckHalo( "z slabs", zslab, comm );
+		error += CheckHalo( "blocks", blocks, comm );
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,232 @@
+//*************************************************************************
+// Check the single-pass opening and drainage curves against a brute force
+// morphological opening at a sequence of critical radii
+//*************************************************************************
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <random>
+#include <queue>
+#include "common/Domain.h"
+#include "common/MPI.h"
+#include "analysis/distance.h"
+#include "analysis/morphology.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( const std::vector<int> &nproc, const std::vector<int> &n )
+{
+	auto db = std::make_shared<Database>();
+	db->putScalar<int>( "BC", 0 );
+	db->putVector<int>( "nproc", nproc );
+	db->putVector<int>( "n", n );
+	db->putScalar<int>( "nspheres", 0 );
+	db->putVector<double>( "L", { 1, 1, 1 } );
+	return db;
+}
+
+// Random overlapping solid spheres (the same image on every rank)
+static Array<char> GlobalImage( const std::vector<int> &N, int count, double radius, int seed )
+{
+	std::mt19937 generator( seed );
+	std::uniform_real_distribution<double> position( 0.0, 1.0 );
+	Array<char> image( N[0], N[1], N[2] );
+	image.fill( 1 );
+	for (int s=0; s<count; s++){
+		double cx = position(generator)*N[0];
+		double cy = position(generator)*N[1];
+		double cz = position(generator)*N[2];
+		for (int k=0; k<N[2]; k++){
+			for (int j=0; j<N[1]; j++){
+				for (int i=0; i<N[0]; i++){
+					double dx = fabs(i-cx), dy = fabs(j-cy), dz = fabs(k-cz);
+					dx = std::min(dx, N[0]-dx);
+					dy = std::min(dy, N[1]-dy);
+					dz = std::min(dz, N[2]-dz);
+					if (dx*dx + dy*dy + dz*dz < radius*radius) image(i,j,k) = 0;
+				}
+			}
+		}
+	}
+	return image;
+}
+
+// Brute force: sites inside the sphere (radius SignDist+reach) of any site with SignDist > R,
+// optionally restricted to the sites connected to the inlet (z=0)
+static Array<char> Reference( const DoubleArray &dist, double R, double reach, bool connected )
+{
+	int Nx = dist.size(0), Ny = dist.size(1), Nz = dist.size(2);
+	Array<char> open( Nx, Ny, Nz );
+	open.fill( 0 );
+	for (int k=0; k<Nz; k++){
+		for (int j=0; j<Ny; j++){
+			for (int i=0; i<Nx; i++){
+				double D = dist(i,j,k);
+				if (D <= R) continue;
+				int W = (int) ceil( D + reach );
+				for (int kk=k-W; kk<=k+W; kk++){
+					for (int jj=j-W; jj<=j+W; jj++){
+						for (int ii=i-W; ii<=i+W; ii++){
+							double dsq = (ii-i)*(ii-i) + (jj-j)*(jj-j) + (kk-k)*(kk-k);
+							if (dsq >= (D+reach)*(D+reach)) continue;
+							int x = (ii+Nx)%Nx, y = (jj+Ny)%Ny, z = (kk+Nz)%Nz;
+							if (dist(x,y,z) > 0.0) open(x,y,z) = 1;
+						}
+					}
+				}
+			}
+		}
+	}
+	if (!connected) return open;
+	Array<char> reached( Nx, Ny, Nz );
+	reached.fill( 0 );
+	std::queue<int> queue;
+	for (int j=0; j<Ny; j++){
+		for (int i=0; i<Nx; i++){
+			if (open(i,j,0)) { reached(i,j,0) = 1; queue.push(j*Nx+i); }
+		}
+	}
+	while (!queue.empty()){
+		int n = queue.front();
+		queue.pop();
+		int i = n%Nx, j = (n/Nx)%Ny, k = n/(Nx*Ny);
+		int nbr[6][3] = { {i-1,j,k}, {i+1,j,k}, {i,j-1,k}, {i,j+1,k}, {i,j,k-1}, {i,j,k+1} };
+		for (auto &p : nbr){
+			if (p[2] < 0 || p[2] >= Nz) continue;
+			int x = (p[0]+Nx)%Nx, y = (p[1]+Ny)%Ny, z = p[2];
+			if (open(x,y,z) && !reached(x,y,z)){
+				reached(x,y,z) = 1;
+				queue.push(z*Nx*Ny+y*Nx+x);
+			}
+		}
+	}
+	return reached;
+}
+
+static int CheckCurve( const std::string &name, const std::vector<int> &nproc, bool drain, const Utilities::MPI &comm )
+{
+	std::vector<int> N = { 24, 24, 24 };
+	std::vector<int> n = { N[0]/nproc[0], N[1]/nproc[1], N[2]/nproc[2] };
+	auto db = loadInputs( nproc, n );
+	auto Dm = std::make_shared<Domain>( db, comm );
+	int Nx = Dm->Nx, Ny = Dm->Ny, Nz = Dm->Nz;
+	auto image = GlobalImage( N, 30, 3.0, 5 );
+
+	// Signed distance for the whole image (on every rank) and the local sub-domain
+	auto serial_db = loadInputs( { 1, 1, 1 }, N );
+	Domain Serial( serial_db, Utilities::MPI( MPI_COMM_SELF ) );
+	Array<char> global_id( N[0]+2, N[1]+2, N[2]+2 );
+	for (int k=0; k<N[2]+2; k++)
+		for (int j=0; j<N[1]+2; j++)
+			for (int i=0; i<N[0]+2; i++)
+				global_id(i,j,k) = image( (i+N[0]-1)%N[0], (j+N[1]-1)%N[1], (k+N[2]-1)%N[2] );
+	DoubleArray global_dist( N[0]+2, N[1]+2, N[2]+2 );
+	CalcDist( global_dist, global_id, Serial );
+	DoubleArray dist( N[0], N[1], N[2] );
+	for (int k=0; k<N[2]; k++)
+		for (int j=0; j<N[1]; j++)
+			for (int i=0; i<N[0]; i++)
+				dist(i,j,k) = global_dist(i+1,j+1,k+1);
+
+	Array<char> local_id( Nx, Ny, Nz );
+	std::vector<signed char> id( Nx*Ny*Nz );
+	for (int k=0; k<Nz; k++){
+		for (int j=0; j<Ny; j++){
+			for (int i=0; i<Nx; i++){
+				int x = (Dm->iproc()*n[0] + i - 1 + N[0]) % N[0];
+				int y = (Dm->jproc()*n[1] + j - 1 + N[1]) % N[1];
+				int z = (Dm->kproc()*n[2] + k - 1 + N[2]) % N[2];
+				local_id(i,j,k) = image(x,y,z);
+				id[k*Nx*Ny+j*Nx+i] = image(x,y,z) == 0 ? 0 : 2;
+			}
+		}
+	}
+	DoubleArray SignDist( Nx, Ny, Nz );
+	CalcDist( SignDist, local_id, *Dm );
+
+	MorphologyCurve Curve;
+	if (drain)
+		Curve.Drain( Dm, SignDist );
+	else
+		Curve.Open( Dm, SignDist, id.data(), 2 );
+
+	// Compare the sites eroded at a few critical radii
+	int mismatch = 0;
+	for (double R : { 0.6, 1.0, 1.5, 2.2, 3.0 }){
+		auto ref = Reference( dist, R, drain ? 1.0 : 0.0, drain );
+		for (int k=1; k<Nz-1; k++){
+			for (int j=1; j<Ny-1; j++){
+				for (int i=1; i<Nx-1; i++){
+					int x = Dm->iproc()*n[0] + i - 1;
+					int y = Dm->jproc()*n[1] + j - 1;
+					int z = Dm->kproc()*n[2] + k - 1;
+					bool eroded = Curve.InvasionRadius(i,j,k) > R;
+					if (eroded != (ref(x,y,z) != 0)) mismatch++;
+				}
+			}
+		}
+	}
+	mismatch = comm.sumReduce( mismatch );
+
+	// The curve must decrease monotonically
+	bool monotone = true;
+	for (size_t p=1; p<Curve.radius.size(); p++){
+		if (Curve.radius[p] >= Curve.radius[p-1] || Curve.void_fraction[p] > Curve.void_fraction[p-1])
+			monotone = false;
+	}
+
+	// Extract a target void fraction without recomputing
+	double target = 0.5;
+	double sw = Curve.Apply( id.data(), target, 1 );
+	double count = 0.0, total = 0.0;
+	for (int k=1; k<Nz-1; k++){
+		for (int j=1; j<Ny-1; j++){
+			for (int i=1; i<Nx-1; i++){
+				signed char label = id[k*Nx*Ny+j*Nx+i];
+				if (label > 0) total += 1.0;
+				if (label == 2) count += 1.0;
+			}
+		}
+	}
+	count = comm.sumReduce( count );
+	total = comm.sumReduce( total );
+	if (comm.getRank() == 0){
+		printf("%s: %i points, %i mismatched sites, sw = %f (labels %f) \n", name.c_str(),
+				(int) Curve.radius.size(), mismatch, sw, count/total);
+	}
+	int error = 0;
+	if (mismatch > 0 || !monotone || Curve.radius.empty() ) error++;
+	if (fabs(sw - count/total) > 1e-12) error++;
+	return error;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestMorphCurve	\n");
+			printf("********************************************************\n");
+		}
+
+		std::vector<int> zslab = { 1, 1, nprocs };
+		std::vector<int> blocks = zslab;
+		if (nprocs == 4) blocks = { 2, 1, 2 };
+		error += CheckCurve( "opening (z slabs)", zslab, false, comm );
+		error += CheckCurve( "drainage (z slabs)", zslab, true, comm );
+		error += CheckCurve( "opening (blocks)", blocks, false, comm );
+		error += CheckCurve( "drainage (blocks)", blocks, true, comm );
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,267 @@
+//*************************************************************************
+// Check that the threaded cpu kernels reproduce the serial result
+//   - the color, MRT and DFH sweeps are run with one thread and with
+//     several threads (USE_OPENMP), and must agree bit for bit
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <math.h>
+#include <vector>
+#include "common/ScaLBL.h"
+#include "common/MPI.h"
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( )
+{
+    auto db = std::make_shared<Database>();
+    db->putScalar<int>( "BC", 0 );
+    db->putVector<int>( "nproc", { 1, 1, 1 } );
+    db->putVector<int>( "n", { 24, 24, 24 } );
+    db->putScalar<int>( "nspheres", 1 );
+    db->putVector<double>( "L", { 1, 1, 1 } );
+    return db;
+}
+
+static void setThreads( int nthreads )
+{
+#ifdef USE_OPENMP
+	omp_set_num_threads( nthreads );
+#else
+	NULL_USE( nthreads );
+#endif
+}
+
+// Run the color model sweeps and return the distributions followed by the phase field
+static std::vector<double> RunColor( int nthreads, int *NeighborList, int *dvcMap,
+		const DoubleArray &PhaseLabel, int Nx, int Ny, const int range[2][2], int Nsites )
+{
+	setThreads( nthreads );
+	int N = PhaseLabel.length();
+	double rhoA = 1.0, rhoB = 1.0;
+	double tauA = 0.7, tauB = 1.0;
+	double alpha = 5e-3, beta = 0.95;
+	double Fx = 0.0, Fy = 0.0, Fz = 1.0e-5;
+	double *fq, *Aq, *Bq, *Den, *Phi, *Velocity;
+	ScaLBL_AllocateDistributionMemory((void **) &fq, 19*Nsites*sizeof(double), 19);
+	ScaLBL_AllocateDistributionMemory((void **) &Aq, 7*Nsites*sizeof(double), 7);
+	ScaLBL_AllocateDistributionMemory((void **) &Bq, 7*Nsites*sizeof(double), 7);
+	ScaLBL_AllocateDistributionMemory((void **) &Den, 2*Nsites*sizeof(double), 2);
+	ScaLBL_AllocateDeviceMemory((void **) &Phi, N*sizeof(double));
+	ScaLBL_AllocateDeviceMemory((void **) &Velocity, 3*Nsites*sizeof(double));
+	ScaLBL_CopyToDevice(Phi, PhaseLabel.data(), N*sizeof(double));
+	ScaLBL_D3Q19_Init(fq, Nsites);
+	for (int r=0; r<2; r++)
+		ScaLBL_PhaseField_Init(dvcMap, Phi, Den, Aq, Bq, range[r][0], range[r][1], Nsites);
+	for (int timestep=0; timestep<10; timestep++){
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi, range[r][0], range[r][1], Nsites);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+					alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, range[r][0], range[r][1], Nsites);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi, range[r][0], range[r][1], Nsites);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Velocity, rhoA, rhoB, tauA, tauB,
+					alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, range[r][0], range[r][1], Nsites);
+	}
+	ScaLBL_DeviceBarrier();
+	std::vector<double> result(19*Nsites+N);
+	ScaLBL_CopyToHost(result.data(), fq, 19*Nsites*sizeof(double));
+	ScaLBL_CopyToHost(&result[19*Nsites], Phi, N*sizeof(double));
+	ScaLBL_FreeDeviceMemory(fq);
+	ScaLBL_FreeDeviceMemory(Aq);
+	ScaLBL_FreeDeviceMemory(Bq);
+	ScaLBL_FreeDeviceMemory(Den);
+	ScaLBL_FreeDeviceMemory(Phi);
+	ScaLBL_FreeDeviceMemory(Velocity);
+	return result;
+}
+
+// Run the MRT sweeps and return the distributions
+static std::vector<double> RunMRT( int nthreads, int *NeighborList, const int range[2][2], int Nsites )
+{
+	setThreads( nthreads );
+	double tau = 0.7;
+	double rlx_setA = 1.0/tau;
+	double rlx_setB = 8.f*(2.f-rlx_setA)/(8.f-rlx_setA);
+	double *fq;
+	ScaLBL_AllocateDistributionMemory((void **) &fq, 19*Nsites*sizeof(double), 19);
+	ScaLBL_D3Q19_Init(fq, Nsites);
+	for (int timestep=0; timestep<10; timestep++){
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q19_AAodd_MRT(NeighborList, fq, range[r][0], range[r][1], Nsites, rlx_setA, rlx_setB, 0.0, 0.0, 1.0e-5);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q19_AAeven_MRT(fq, range[r][0], range[r][1], Nsites, rlx_setA, rlx_setB, 0.0, 0.0, 1.0e-5);
+	}
+	ScaLBL_DeviceBarrier();
+	std::vector<double> result(19*Nsites);
+	ScaLBL_CopyToHost(result.data(), fq, 19*Nsites*sizeof(double));
+	ScaLBL_FreeDeviceMemory(fq);
+	return result;
+}
+
+// Run the DFH sweeps and return the distributions followed by the phase field
+static std::vector<double> RunDFH( int nthreads, int *NeighborList, const std::vector<double> &PhaseInit,
+		const int range[2][2], int Nsites )
+{
+	setThreads( nthreads );
+	double rhoA = 1.0, rhoB = 1.0;
+	double tauA = 0.7, tauB = 1.0;
+	double alpha = 5e-3, beta = 0.95;
+	double *fq, *Aq, *Bq, *Den, *Phi, *Gradient, *SolidForce;
+	ScaLBL_AllocateDistributionMemory((void **) &fq, 19*Nsites*sizeof(double), 19);
+	ScaLBL_AllocateDistributionMemory((void **) &Aq, 7*Nsites*sizeof(double), 7);
+	ScaLBL_AllocateDistributionMemory((void **) &Bq, 7*Nsites*sizeof(double), 7);
+	ScaLBL_AllocateDistributionMemory((void **) &Den, 2*Nsites*sizeof(double), 2);
+	ScaLBL_AllocateDeviceMemory((void **) &Phi, Nsites*sizeof(double));
+	ScaLBL_AllocateDeviceMemory((void **) &Gradient, 3*Nsites*sizeof(double));
+	ScaLBL_AllocateDeviceMemory((void **) &SolidForce, 3*Nsites*sizeof(double));
+	ScaLBL_CopyToDevice(Phi, PhaseInit.data(), Nsites*sizeof(double));
+	ScaLBL_D3Q19_Init(fq, Nsites);
+	for (int r=0; r<2; r++)
+		ScaLBL_DFH_Init(Phi, Den, Aq, Bq, range[r][0], range[r][1], Nsites);
+	for (int timestep=0; timestep<10; timestep++){
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q7_AAodd_DFH(NeighborList, Aq, Bq, Den, Phi, range[r][0], range[r][1], Nsites);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q19_Gradient_DFH(NeighborList, Phi, Gradient, range[r][0], range[r][1], Nsites);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q19_AAodd_DFH(NeighborList, fq, Aq, Bq, Den, Phi, Gradient, SolidForce, rhoA, rhoB, tauA, tauB,
+					alpha, beta, 0.0, 0.0, 1.0e-5, range[r][0], range[r][1], Nsites);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q7_AAeven_DFH(Aq, Bq, Den, Phi, range[r][0], range[r][1], Nsites);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q19_Gradient_DFH(NeighborList, Phi, Gradient, range[r][0], range[r][1], Nsites);
+		for (int r=0; r<2; r++)
+			ScaLBL_D3Q19_AAeven_DFH(NeighborList, fq, Aq, Bq, Den, Phi, Gradient, SolidForce, rhoA, rhoB, tauA, tauB,
+					alpha, beta, 0.0, 0.0, 1.0e-5, range[r][0], range[r][1], Nsites);
+	}
+	ScaLBL_DeviceBarrier();
+	std::vector<double> result(20*Nsites);
+	ScaLBL_CopyToHost(result.data(), fq, 19*Nsites*sizeof(double));
+	ScaLBL_CopyToHost(&result[19*Nsites], Phi, Nsites*sizeof(double));
+	ScaLBL_FreeDeviceMemory(fq);
+	ScaLBL_FreeDeviceMemory(Aq);
+	ScaLBL_FreeDeviceMemory(Bq);
+	ScaLBL_FreeDeviceMemory(Den);
+	ScaLBL_FreeDeviceMemory(Phi);
+	ScaLBL_FreeDeviceMemory(Gradient);
+	ScaLBL_FreeDeviceMemory(SolidForce);
+	return result;
+}
+
+static double maxDiff( const std::vector<double> &a, const std::vector<double> &b )
+{
+	double diff = 0.0;
+	for (size_t i=0; i<a.size(); i++)
+		diff = max(diff, fabs(a[i]-b[i]));
+	return diff;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestOpenMP	\n");
+			printf("********************************************************\n");
+		}
+		int nthreads = 4;
+#ifdef USE_OPENMP
+		if (rank == 0) printf("Comparing 1 and %i OpenMP threads \n",nthreads);
+#else
+		if (rank == 0) printf("Built without USE_OPENMP, the kernels run serially \n");
+#endif
+
+		auto db = loadInputs( );
+		auto Dm = std::make_shared<Domain>(db,comm);
+		int Nx = Dm->Nx;
+		int Ny = Dm->Ny;
+		int Nz = Dm->Nz;
+
+		// Solid sphere plus a bubble of component A
+		int Np = 0;
+		DoubleArray PhaseLabel(Nx,Ny,Nz);
+		PhaseLabel.fill(-1.0);
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int n = k*Nx*Ny+j*Nx+i;
+					double x = i - 0.3*Nx;
+					double y = j - 0.3*Ny;
+					double z = k - 0.3*Nz;
+					if (x*x+y*y+z*z < 16.0) Dm->id[n] = 0;
+					else {
+						Dm->id[n] = 1;
+						Np++;
+						x = i - 0.65*Nx;
+						y = j - 0.65*Ny;
+						z = k - 0.6*Nz;
+						if (x*x+y*y+z*z < 36.0) PhaseLabel(i,j,k) = 1.0;
+					}
+				}
+			}
+		}
+		Dm->CommInit();
+		std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+
+		IntArray Map(Nx,Ny,Nz);
+		int *neighborList = new int[18*(Np+64)];
+		int Nsites = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+
+		int *TmpMap = new int[Nsites];
+		std::vector<double> PhaseInit(Nsites,-1.0);
+		for (int idx=0; idx<Nsites; idx++) TmpMap[idx] = 0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int idx = Map(i,j,k);
+					if (!(idx < 0)){
+						TmpMap[idx] = k*Nx*Ny+j*Nx+i;
+						PhaseInit[idx] = PhaseLabel(i,j,k);
+					}
+				}
+			}
+		}
+
+		int *NeighborList, *dvcMap;
+		ScaLBL_AllocateDeviceMemory((void **) &NeighborList, 18*Nsites*sizeof(int));
+		ScaLBL_AllocateDeviceMemory((void **) &dvcMap, Nsites*sizeof(int));
+		ScaLBL_CopyToDevice(NeighborList, neighborList, 18*Nsites*sizeof(int));
+		ScaLBL_CopyToDevice(dvcMap, TmpMap, Nsites*sizeof(int));
+
+		// the sites between the exterior and interior blocks are padding
+		const int range[2][2] = { { 0, ScaLBL_Comm->LastExterior() },
+			{ ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior() } };
+		double color_diff = maxDiff( RunColor(1, NeighborList, dvcMap, PhaseLabel, Nx, Ny, range, Nsites),
+				RunColor(nthreads, NeighborList, dvcMap, PhaseLabel, Nx, Ny, range, Nsites) );
+		double mrt_diff = maxDiff( RunMRT(1, NeighborList, range, Nsites), RunMRT(nthreads, NeighborList, range, Nsites) );
+		double dfh_diff = maxDiff( RunDFH(1, NeighborList, PhaseInit, range, Nsites),
+				RunDFH(nthreads, NeighborList, PhaseInit, range, Nsites) );
+		if (rank==0) printf("  max difference: color = %e, mrt = %e, dfh = %e \n",color_diff,mrt_diff,dfh_diff);
+		if (color_diff > 0.0 || mrt_diff > 0.0 || dfh_diff > 0.0){
+			printf("Threaded kernels do not match the serial result \n");
+			error++;
+		}
+
+		ScaLBL_FreeDeviceMemory(NeighborList);
+		ScaLBL_FreeDeviceMemory(dvcMap);
+		delete [] TmpMap;
+		delete [] neighborList;
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,127 @@
+//*************************************************************************
+// Check that the parallel read mode of Domain::Decomp matches the
+// decomposition performed by rank 0
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <random>
+#include "common/Domain.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( const std::vector<int> &nproc, const std::vector<int> &n,
+		const std::vector<int> &N, const std::string &ReadType )
+{
+	auto db = std::make_shared<Database>();
+	db->putScalar<int>( "BC", 0 );
+	db->putVector<int>( "nproc", nproc );
+	db->putVector<int>( "n", n );
+	db->putVector<int>( "N", N );
+	db->putVector<double>( "L", { 1, 1, 1 } );
+	db->putScalar<std::string>( "ReadType", ReadType );
+	db->putVector<int>( "ReadValues", { 0, 1, 2, 3 } );
+	db->putVector<int>( "WriteValues", { 0, 1, 2, 2 } );
+	return db;
+}
+
+// Write a random image with labels 0-3 (rank 0)
+static void WriteImage( const std::string &filename, const std::vector<int> &N, bool sixteen_bit, int seed )
+{
+	std::mt19937 generator( seed );
+	std::uniform_int_distribution<int> label( 0, 3 );
+	size_t size = size_t(N[0])*N[1]*N[2];
+	FILE *fid = fopen( filename.c_str(), "wb" );
+	for (size_t n=0; n<size; n++){
+		if (sixteen_bit){
+			short int value = label(generator);
+			fwrite( &value, 2, 1, fid );
+		}
+		else {
+			char value = label(generator);
+			fwrite( &value, 1, 1, fid );
+		}
+	}
+	fclose( fid );
+}
+
+static int CompareDecomp( const std::string &name, const std::string &filename,
+		std::shared_ptr<Database> db, const Utilities::MPI &comm )
+{
+	auto serial_db = db->cloneDatabase();
+	auto parallel_db = db->cloneDatabase();
+	parallel_db->putScalar<bool>( "ParallelRead", true );
+	auto Serial = std::make_shared<Domain>( serial_db, comm );
+	auto Parallel = std::make_shared<Domain>( parallel_db, comm );
+	Serial->Decomp( filename );
+	Parallel->Decomp( filename );
+	int mismatch = 0;
+	for (size_t n=0; n<Serial->id.size(); n++)
+		if (Serial->id[n] != Parallel->id[n]) mismatch++;
+	mismatch = comm.sumReduce( mismatch );
+	if (comm.getRank() == 0)
+		printf("%s: %i mismatched labels \n", name.c_str(), mismatch);
+	return (mismatch > 0) ? 1 : 0;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestParallelDecomp	\n");
+			printf("********************************************************\n");
+		}
+
+		std::vector<int> n = { 12, 10, 8 };
+		std::vector<int> zslab = { 1, 1, nprocs };
+		std::vector<int> xslab = { nprocs, 1, 1 };
+		std::vector<int> N = { 12, 10, 8*nprocs };
+		if (rank == 0){
+			WriteImage( "TestParallelDecomp.8bit.raw", N, false, 1 );
+			WriteImage( "TestParallelDecomp.16bit.raw", N, true, 2 );
+		}
+		comm.barrier();
+
+		// relabel only
+		auto db = loadInputs( zslab, n, N, "8bit" );
+		error += CompareDecomp( "8-bit", "TestParallelDecomp.8bit.raw", db, comm );
+		db = loadInputs( xslab, { 12/nprocs, 10, 8*nprocs }, N, "16bit" );
+		error += CompareDecomp( "16-bit (split in x)", "TestParallelDecomp.16bit.raw", db, comm );
+
+		// mixed reflection at the inlet and outlet
+		db = loadInputs( zslab, n, N, "8bit" );
+		db->putVector<int>( "InletLayers", { 0, 0, 3 } );
+		db->putVector<int>( "OutletLayers", { 0, 0, 3 } );
+		error += CompareDecomp( "mixed layers", "TestParallelDecomp.8bit.raw", db, comm );
+		db = loadInputs( xslab, { 12/nprocs, 10, 8*nprocs }, N, "16bit" );
+		db->putVector<int>( "InletLayers", { 0, 0, 3 } );
+		db->putVector<int>( "OutletLayers", { 0, 0, 3 } );
+		error += CompareDecomp( "mixed layers (split in x)", "TestParallelDecomp.16bit.raw", db, comm );
+
+		// checkerboard layers on every face
+		db = loadInputs( zslab, n, N, "16bit" );
+		db->putVector<int>( "InletLayers", { 2, 2, 2 } );
+		db->putVector<int>( "OutletLayers", { 2, 2, 2 } );
+		db->putScalar<int>( "checkerSize", 3 );
+		db->putScalar<int>( "InletLayersPhase", 2 );
+		error += CompareDecomp( "checkerboard layers", "TestParallelDecomp.16bit.raw", db, comm );
+
+		// offset into the image with a periodic transition zone in z
+		db = loadInputs( zslab, { 10, 8, 8 }, N, "8bit" );
+		db->putVector<int>( "offset", { 1, 2, 3 } );
+		error += CompareDecomp( "offset", "TestParallelDecomp.8bit.raw", db, comm );
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
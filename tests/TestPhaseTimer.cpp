@@ -0,0 +1,150 @@
+//*************************************************************************
+// Check the phase timers used to instrument the time loops
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include "common/ScaLBL.h"
+#include "common/PhaseTimer.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+std::shared_ptr<Database> loadInputs( int nprocs )
+{
+    auto db = std::make_shared<Database>();
+    db->putScalar<int>( "BC", 0 );
+    db->putVector<int>( "nproc", { 1, 1, nprocs } );
+    db->putVector<int>( "n", { 16, 16, 16 } );
+    db->putScalar<int>( "nspheres", 1 );
+    db->putVector<double>( "L", { 1, 1, 1 } );
+    return db;
+}
+
+static void pause( int ms )
+{
+    std::this_thread::sleep_for( std::chrono::milliseconds( ms ) );
+}
+
+static int countLines( const std::string &filename )
+{
+    std::ifstream file( filename );
+    std::string line;
+    int count = 0;
+    while ( std::getline( file, line ) )
+        count++;
+    return count;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestPhaseTimer	\n");
+			printf("********************************************************\n");
+		}
+
+		// A disabled timer records nothing
+		auto Timer = std::make_shared<PhaseTimer>(comm);
+		Timer->start(PhaseTimer::INTERIOR);
+		pause(5);
+		Timer->stop();
+		if (Timer->elapsed(PhaseTimer::INTERIOR) != 0.0 || Timer->calls(PhaseTimer::INTERIOR) != 0){
+			printf("Disabled timer recorded time \n");
+			error++;
+		}
+
+		// Nested phases are excluded from the enclosing phase
+		Timer->enable(true);
+		Timer->start(PhaseTimer::INTERIOR);
+		pause(20);
+		Timer->start(PhaseTimer::WAIT);
+		pause(100);
+		Timer->stop();
+		Timer->stop();
+		double interior = Timer->elapsed(PhaseTimer::INTERIOR);
+		double wait = Timer->elapsed(PhaseTimer::WAIT);
+		if (rank == 0) printf("Nested phases: interior = %f s, wait = %f s \n",interior,wait);
+		if (interior < 0.018 || interior > 0.09 || wait < 0.095){
+			printf("Nested phase times are wrong \n");
+			error++;
+		}
+
+		// The halo exchange charges the communicator phases
+		auto db = loadInputs( nprocs );
+		auto Dm = std::make_shared<Domain>(db,comm);
+		int Nx = Dm->Nx;
+		int Ny = Dm->Ny;
+		int Nz = Dm->Nz;
+		int Np = 0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					Dm->id[k*Nx*Ny+j*Nx+i] = 1;
+					Np++;
+				}
+			}
+		}
+		Dm->CommInit();
+		std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+		IntArray Map(Nx,Ny,Nz);
+		int *neighborList = new int[18*(Np+64)];
+		Np = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+		double *fq;
+		ScaLBL_AllocateDeviceMemory((void **) &fq, 19*Np*sizeof(double));
+		ScaLBL_D3Q19_Init(fq, Np);
+		ScaLBL_Comm->SetTimer(Timer);
+		Timer->reset();
+		for (int timestep=0; timestep<4; timestep++){
+			ScaLBL_Comm->SendD3Q19AA(fq);
+			ScaLBL_Comm->RecvD3Q19AA(fq);
+		}
+		if (Timer->calls(PhaseTimer::PACK) != 8 || Timer->calls(PhaseTimer::WAIT) != 4){
+			printf("Halo exchange phases: pack = %i, wait = %i calls (expected 8, 4) \n",
+					Timer->calls(PhaseTimer::PACK),Timer->calls(PhaseTimer::WAIT));
+			error++;
+		}
+
+		// Reduce over the ranks and write the report
+		if (rank == 0){
+			remove("TestPhaseTimer.csv");
+			remove("TestPhaseTimer.json");
+		}
+		comm.barrier();
+		Timer->write(4, "TestPhaseTimer");
+		Timer->write(8, "TestPhaseTimer");
+		if (Timer->elapsed(PhaseTimer::PACK) != 0.0 || Timer->calls(PhaseTimer::WAIT) != 0){
+			printf("Timers were not reset after write \n");
+			error++;
+		}
+		if (rank == 0){
+			// header plus one line for each phase and the total, twice
+			int csv_lines = countLines("TestPhaseTimer.csv");
+			int json_lines = countLines("TestPhaseTimer.json");
+			printf("Timing report: %i csv lines, %i json lines \n",csv_lines,json_lines);
+			if (csv_lines != 1 + 2*(PhaseTimer::N_PHASES+1) || json_lines != 2){
+				printf("Timing report has the wrong number of lines \n");
+				error++;
+			}
+		}
+
+		ScaLBL_FreeDeviceMemory(fq);
+		delete [] neighborList;
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,307 @@
+//*************************************************************************
+// Check the conjugate gradient solver of the Poisson equation (solver = "CG")
+//   - Dirichlet inlet/outlet without charge: linear potential
+//   - Dirichlet inlet/outlet with uniform charge: parabolic potential
+//   - both Dirichlet cases match the same problem solved on a single rank
+//   - periodic domain with a sinusoidal charge: potential and electric field
+//     compared with the default D3Q19 LB solver
+//*************************************************************************
+#include <stdio.h>
+#include <iostream>
+#include <functional>
+#include <math.h>
+#include "models/PoissonSolver.h"
+#include "common/Utilities.h"
+
+using namespace std;
+
+const int Nglobal = 24;             // lattice sites along z (all ranks)
+const double Vin = 0.0, Vout = 0.5; // inlet / outlet potential (V)
+
+std::shared_ptr<Database> loadInputs( int nprocs, const std::string &solver, int BC )
+{
+    auto db = std::make_shared<Database>();
+    auto domain_db = std::make_shared<Database>();
+    domain_db->putScalar<int>( "BC", 0 );
+    domain_db->putVector<int>( "nproc", { 1, 1, nprocs } );
+    domain_db->putVector<int>( "n", { 8, 8, Nglobal / nprocs } );
+    domain_db->putVector<double>( "L", { 1, 1, 1 } );
+    domain_db->putScalar<double>( "voxel_length", 1.0 );
+    db->putDatabase( "Domain", domain_db );
+    auto poisson_db = std::make_shared<Database>();
+    poisson_db->putScalar<std::string>( "solver", solver );
+    poisson_db->putScalar<std::string>( "lattice_scheme", "D3Q19" );
+    poisson_db->putScalar<bool>( "Restart", false );
+    poisson_db->putScalar<int>( "timestepMax", 100000 );
+    poisson_db->putScalar<int>( "analysis_interval", 100 );
+    poisson_db->putScalar<double>( "tolerance", 1.0e-16 );
+    poisson_db->putScalar<double>( "cg_tolerance", 1.0e-12 );
+    poisson_db->putScalar<int>( "BC_Inlet", BC );
+    poisson_db->putScalar<int>( "BC_Outlet", BC );
+    poisson_db->putScalar<double>( "Vin", Vin );
+    poisson_db->putScalar<double>( "Vout", Vout );
+    poisson_db->putVector<int>( "BC_SolidList", { 1 } );
+    poisson_db->putVector<int>( "SolidLabels", { 0 } );
+    poisson_db->putVector<double>( "SolidValues", { 0.0 } );
+    poisson_db->putVector<int>( "InitialValueLabels", { 1 } );
+    poisson_db->putVector<double>( "InitialValues", { 0.0 } );
+    db->putDatabase( "Poisson", poisson_db );
+    return db;
+}
+
+struct PoissonResult {
+    DoubleArray Psi, Ez;
+};
+
+// Solve in an open channel with the charge density (C/m^3) given as a function of the global z
+// and return the potential (V) and the z component of the electric field (V/lu)
+PoissonResult SolvePoisson( const Utilities::MPI &comm, const std::string &solver, int BC,
+                            std::function<double( double )> charge )
+{
+    int rank = comm.getRank();
+    int nprocs = comm.getSize();
+    auto db = loadInputs( nprocs, solver, BC );
+
+    auto n = db->getDatabase( "Domain" )->getVector<int>( "n" );
+    size_t N = ( n[0] + 2 ) * ( n[1] + 2 ) * ( n[2] + 2 );
+    std::vector<signed char> id( N, 1 );
+    char LocalRankFilename[40];
+    sprintf( LocalRankFilename, "ID.%05i", rank );
+    FILE *IDFILE = fopen( LocalRankFilename, "wb" );
+    fwrite( id.data(), 1, N, IDFILE );
+    fclose( IDFILE );
+
+    ScaLBL_Poisson PoissonSolver( rank, nprocs, comm );
+    PoissonSolver.ReadParams( db );
+    PoissonSolver.SetDomain();
+    PoissonSolver.ReadInput();
+    PoissonSolver.Create();
+    PoissonSolver.Initialize( 0 );
+    remove( LocalRankFilename );
+
+    int Nx = PoissonSolver.Nx;
+    int Ny = PoissonSolver.Ny;
+    int Nz = PoissonSolver.Nz;
+    int Np = PoissonSolver.Np;
+    double h = PoissonSolver.h;
+    std::vector<double> ChargeDensity_host( Np, 0.0 );
+    for ( int k = 1; k < Nz - 1; k++ ) {
+        for ( int j = 1; j < Ny - 1; j++ ) {
+            for ( int i = 1; i < Nx - 1; i++ ) {
+                int idx = PoissonSolver.Map( i, j, k );
+                if ( !( idx < 0 ) )
+                    ChargeDensity_host[idx] = charge( rank * ( Nz - 2 ) + k ) * ( h * h * h * 1.0e-18 );
+            }
+        }
+    }
+    double *ChargeDensity;
+    ScaLBL_AllocateDeviceMemory( (void **) &ChargeDensity, sizeof( double ) * Np );
+    ScaLBL_CopyToDevice( ChargeDensity, ChargeDensity_host.data(), sizeof( double ) * Np );
+    PoissonSolver.Run( ChargeDensity, false, 1 );
+    ScaLBL_FreeDeviceMemory( ChargeDensity );
+
+    PoissonResult result;
+    result.Psi.resize( Nx, Ny, Nz );
+    result.Ez.resize( Nx, Ny, Nz );
+    DoubleArray Ex( Nx, Ny, Nz ), Ey( Nx, Ny, Nz );
+    PoissonSolver.getElectricPotential( result.Psi );
+    PoissonSolver.getElectricField( Ex, Ey, result.Ez );
+    result.Ez.scale( h * 1.0e-6 ); // convert back to V/lu
+    comm.barrier();
+    return result;
+}
+
+// Largest deviation of the potential and the field from the exact profiles
+void Compare( const Utilities::MPI &comm, const PoissonResult &result, std::function<double( double )> psi,
+              std::function<double( double )> Ez, double &psi_error, double &field_error )
+{
+    int Nx = result.Psi.size( 0 );
+    int Ny = result.Psi.size( 1 );
+    int Nz = result.Psi.size( 2 );
+    psi_error = field_error = 0.0;
+    for ( int k = 1; k < Nz - 1; k++ ) {
+        for ( int j = 1; j < Ny - 1; j++ ) {
+            for ( int i = 1; i < Nx - 1; i++ ) {
+                double z = comm.getRank() * ( Nz - 2 ) + k;
+                psi_error = max( psi_error, fabs( result.Psi( i, j, k ) - psi( z ) ) );
+                field_error = max( field_error, fabs( result.Ez( i, j, k ) - Ez( z ) ) );
+            }
+        }
+    }
+    psi_error = comm.maxReduce( psi_error );
+    field_error = comm.maxReduce( field_error );
+}
+
+// Largest difference of the potential and the field from the same problem solved on rank 0 alone
+void CompareSerial( const Utilities::MPI &comm, const PoissonResult &result, const std::string &solver, int BC,
+                    std::function<double( double )> charge, double &psi_diff, double &field_diff )
+{
+    int rank = comm.getRank();
+    int Nx = result.Psi.size( 0 );
+    int Ny = result.Psi.size( 1 );
+    int Nz = result.Psi.size( 2 );
+    auto self = comm.split( rank );
+    PoissonResult serial;
+    if ( rank == 0 ) {
+        serial = SolvePoisson( self, solver, BC, charge );
+    } else {
+        serial.Psi.resize( Nx, Ny, Nglobal + 2 );
+        serial.Ez.resize( Nx, Ny, Nglobal + 2 );
+    }
+    comm.bcast( serial.Psi.data(), serial.Psi.length(), 0 );
+    comm.bcast( serial.Ez.data(), serial.Ez.length(), 0 );
+    psi_diff = field_diff = 0.0;
+    for ( int k = 1; k < Nz - 1; k++ ) {
+        for ( int j = 1; j < Ny - 1; j++ ) {
+            for ( int i = 1; i < Nx - 1; i++ ) {
+                int z = rank * ( Nz - 2 ) + k;
+                psi_diff = max( psi_diff, fabs( result.Psi( i, j, k ) - serial.Psi( i, j, z ) ) );
+                field_diff = max( field_diff, fabs( result.Ez( i, j, k ) - serial.Ez( i, j, z ) ) );
+            }
+        }
+    }
+    psi_diff = comm.maxReduce( psi_diff );
+    field_diff = comm.maxReduce( field_diff );
+}
+
+//***************************************************************************************
+int main( int argc, char **argv )
+{
+    // Initialize MPI
+    Utilities::startup( argc, argv );
+    Utilities::MPI comm( MPI_COMM_WORLD );
+    int error = 0;
+    { // Limit scope so variables that contain communicators will free before MPI_Finialize
+        int rank = comm.getRank();
+        if ( rank == 0 ) {
+            printf( "********************************************************\n" );
+            printf( "Running unit test: TestPoissonCG	\n" );
+            printf( "********************************************************\n" );
+        }
+        // Initialize compute device
+        int device = ScaLBL_SetDevice( rank );
+        NULL_USE( device );
+        ScaLBL_DeviceBarrier();
+        comm.barrier();
+
+        // The D3Q19 stencil solves -Laplacian(psi) = rho_e / epsilon exactly for profiles
+        // up to second order in z; the inlet/outlet values are imposed on the halo layers
+        double epsilon_LB = 8.85e-12 * 1.0e-6 * 78.4;
+        double L = Nglobal + 1;
+        double psi_error, field_error;
+
+        // Linear potential between the inlet and the outlet
+        auto linear = SolvePoisson( comm, "CG", 1, []( double ) { return 0.0; } );
+        Compare( comm, linear,
+            [L]( double z ) { return Vin + ( Vout - Vin ) * z / L; },
+            [L]( double ) { return -( Vout - Vin ) / L; },
+            psi_error, field_error );
+        if ( rank == 0 )
+            printf( "Dirichlet, uncharged (CG): max error psi = %.3g V, Ez = %.3g V/lu \n", psi_error, field_error );
+        if ( psi_error > 1.0e-9 || field_error > 1.0e-9 ) {
+            if ( rank == 0 )
+                printf( "CG solution does not match the linear profile \n" );
+            error++;
+        }
+        CompareSerial( comm, linear, "CG", 1, []( double ) { return 0.0; }, psi_error, field_error );
+        if ( rank == 0 )
+            printf( "Dirichlet, uncharged (CG vs 1 rank): max difference psi = %.3g V, Ez = %.3g V/lu \n",
+                    psi_error, field_error );
+        if ( psi_error > 1.0e-9 || field_error > 1.0e-9 ) {
+            if ( rank == 0 )
+                printf( "CG solution depends on the decomposition \n" );
+            error++;
+        }
+
+        // Uniform charge: parabolic potential
+        double charge = 10.0; // C/m^3
+        double source = charge * 1.0e-18 / epsilon_LB;
+        auto parabolic = SolvePoisson( comm, "CG", 1, [charge]( double ) { return charge; } );
+        Compare( comm, parabolic,
+            [L, source]( double z ) { return Vin + ( Vout - Vin ) * z / L + 0.5 * source * z * ( L - z ); },
+            [L, source]( double z ) { return -( Vout - Vin ) / L - 0.5 * source * ( L - 2.0 * z ); },
+            psi_error, field_error );
+        if ( rank == 0 )
+            printf( "Dirichlet, uniform charge (CG): max error psi = %.3g V, Ez = %.3g V/lu \n", psi_error, field_error );
+        if ( psi_error > 1.0e-9 || field_error > 1.0e-9 ) {
+            if ( rank == 0 )
+                printf( "CG solution does not match the parabolic profile \n" );
+            error++;
+        }
+        CompareSerial( comm, parabolic, "CG", 1, [charge]( double ) { return charge; }, psi_error, field_error );
+        if ( rank == 0 )
+            printf( "Dirichlet, uniform charge (CG vs 1 rank): max difference psi = %.3g V, Ez = %.3g V/lu \n",
+                    psi_error, field_error );
+        if ( psi_error > 1.0e-9 || field_error > 1.0e-9 ) {
+            if ( rank == 0 )
+                printf( "CG solution depends on the decomposition \n" );
+            error++;
+        }
+
+        // Periodic domain with a sinusoidal charge: compare with the LB solver
+        // (the potential is defined up to a constant, so the mean is removed)
+        double kz = 2.0 * M_PI / Nglobal;
+        auto wave = [charge, kz]( double z ) { return charge * sin( kz * z ); };
+        auto cg = SolvePoisson( comm, "CG", 0, wave );
+        double amplitude = source / ( 2.0 * ( 1.0 - cos( kz ) ) );
+        auto mean = [&comm]( const DoubleArray &Psi ) {
+            double sum = 0.0;
+            int count = 0;
+            for ( size_t k = 1; k < Psi.size( 2 ) - 1; k++ ) {
+                for ( size_t j = 1; j < Psi.size( 1 ) - 1; j++ ) {
+                    for ( size_t i = 1; i < Psi.size( 0 ) - 1; i++ ) {
+                        sum += Psi( i, j, k );
+                        count++;
+                    }
+                }
+            }
+            return comm.sumReduce( sum ) / comm.sumReduce( count );
+        };
+        double cg_mean = mean( cg.Psi );
+        Compare( comm, cg,
+            [cg_mean, amplitude, kz]( double z ) { return cg_mean + amplitude * sin( kz * z ); },
+            [amplitude, kz]( double z ) { return -amplitude * sin( kz ) * cos( kz * z ); },
+            psi_error, field_error );
+        if ( rank == 0 )
+            printf( "Periodic, sinusoidal charge (CG): max error psi = %.3g V, Ez = %.3g V/lu (amplitude = %.3g V) \n",
+                    psi_error, field_error, amplitude );
+        if ( psi_error > 1.0e-9 || field_error > 1.0e-9 ) {
+            if ( rank == 0 )
+                printf( "CG solution does not match the sinusoidal profile \n" );
+            error++;
+        }
+
+        // The D3Q19 solver computes the field from the first moment, which equals the central
+        // difference used by the CG solver (the D3Q7 scheme relaxes towards a tau-dependent
+        // potential and is not compared)
+        auto lb = SolvePoisson( comm, "LB", 0, wave );
+        double lb_mean = mean( lb.Psi );
+        double psi_diff = 0.0, field_diff = 0.0;
+        for ( size_t k = 1; k < cg.Psi.size( 2 ) - 1; k++ ) {
+            for ( size_t j = 1; j < cg.Psi.size( 1 ) - 1; j++ ) {
+                for ( size_t i = 1; i < cg.Psi.size( 0 ) - 1; i++ ) {
+                    double diff = ( cg.Psi( i, j, k ) - cg_mean ) - ( lb.Psi( i, j, k ) - lb_mean );
+                    psi_diff = max( psi_diff, fabs( diff ) );
+                    field_diff = max( field_diff, fabs( cg.Ez( i, j, k ) - lb.Ez( i, j, k ) ) );
+                }
+            }
+        }
+        psi_diff = comm.maxReduce( psi_diff );
+        field_diff = comm.maxReduce( field_diff );
+        double field_amplitude = amplitude * sin( kz );
+        if ( rank == 0 )
+            printf( "Periodic, sinusoidal charge (CG vs LB): max difference psi = %.3g V, Ez = %.3g V/lu \n",
+                    psi_diff, field_diff );
+        if ( psi_diff > 1.0e-4 * amplitude || field_diff > 1.0e-4 * field_amplitude ) {
+            if ( rank == 0 )
+                printf( "CG solution does not match the LB solver \n" );
+            error++;
+        }
+
+        error = comm.maxReduce( error );
+        if ( rank == 0 && error == 0 )
+            printf( "All tests passed \n" );
+    } // Limit scope so variables that contain communicators will free before MPI_Finialize
+    Utilities::shutdown();
+    return error;
+}
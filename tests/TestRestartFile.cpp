@@ -0,0 +1,294 @@
+//*************************************************************************
+// Check that the aggregated restart files can be read back by each rank,
+// that a single rank can read the data written by all ranks, that the
+// global restart files can be read with a different processor grid, and
+// that the compressed restart files are recovered exactly
+//*************************************************************************
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include "common/Array.h"
+#include "common/Communication.h"
+#include "common/MPI.h"
+#include "common/Utilities.h"
+#include "IO/RestartFile.h"
+
+using namespace std;
+
+// Value of component q at site n written by rank
+static inline double value( int rank, int q, size_t n )
+{
+	return rank + 0.01*q + 1e-7*n;
+}
+
+// The number of sites differs between ranks
+static inline size_t sites( int rank )
+{
+	return 1000 + 37*rank;
+}
+
+static void fill( int rank, size_t Np, std::vector<double> &Den, std::vector<double> &fq )
+{
+	Den.resize( 2*Np );
+	fq.resize( 19*Np );
+	for (int q=0; q<2; q++)
+		for (size_t n=0; n<Np; n++)
+			Den[q*Np+n] = value( rank, q, n );
+	for (int q=0; q<19; q++)
+		for (size_t n=0; n<Np; n++)
+			fq[q*Np+n] = value( rank, q+2, n );
+}
+
+static int check( int rank, size_t Np, const std::vector<double> &Den, const std::vector<double> &fq )
+{
+	std::vector<double> Den0, fq0;
+	fill( rank, Np, Den0, fq0 );
+	return ( Den == Den0 && fq == fq0 ) ? 0 : 1;
+}
+
+static int CheckRestart( int nfiles, const Utilities::MPI &comm )
+{
+	int rank = comm.getRank();
+	int nprocs = comm.getSize();
+	std::string prefix = "RestartTest" + std::to_string( nfiles );
+	size_t Np = sites( rank );
+	std::vector<int> map( Np );
+	for (size_t n=0; n<Np; n++)
+		map[n] = n;
+	uint64_t hash = IO::layoutHash( map.data(), Np );
+
+	// Write the restart file
+	std::vector<double> Den, fq;
+	fill( rank, Np, Den, fq );
+	IO::writeRestart( prefix, Np, hash, { Den.data(), fq.data() }, { 2, 19 }, nfiles, comm );
+	comm.barrier();
+
+	// Check the header
+	int error = 0;
+	auto info = IO::readRestartInfo( prefix );
+	int expected = std::max( 1, std::min( nfiles, nprocs ) );
+	if ( info.nprocs != nprocs || info.nfiles != expected || info.components != std::vector<int>( { 2, 19 } ) )
+		error++;
+
+	// Each rank reads its own data
+	std::fill( Den.begin(), Den.end(), 0 );
+	std::fill( fq.begin(), fq.end(), 0 );
+	IO::readRestart( prefix, rank, Np, hash, { Den.data(), fq.data() }, { 2, 19 } );
+	error += check( rank, Np, Den, fq );
+
+	// Read the data for every rank from the last rank
+	if ( rank == nprocs-1 ) {
+		for (int r=0; r<nprocs; r++){
+			size_t Np2 = sites( r );
+			std::vector<int> map2( Np2 );
+			for (size_t n=0; n<Np2; n++)
+				map2[n] = n;
+			std::vector<double> Den2( 2*Np2 ), fq2( 19*Np2 );
+			IO::readRestart( prefix, r, Np2, IO::layoutHash( map2.data(), Np2 ),
+				{ Den2.data(), fq2.data() }, { 2, 19 } );
+			error += check( r, Np2, Den2, fq2 );
+		}
+	}
+	error = comm.sumReduce( error );
+	if ( rank == 0 )
+		printf("%i files: %i errors \n", expected, error );
+	return error;
+}
+
+// Compress smooth distributions near equilibrium and random values
+static int CheckCompressed( const Utilities::MPI &comm )
+{
+	int rank = comm.getRank();
+	size_t Np = 200000;
+	const double w[19] = { 1.0/3.0, 1.0/18.0, 1.0/18.0, 1.0/18.0, 1.0/18.0, 1.0/18.0, 1.0/18.0,
+		1.0/36.0, 1.0/36.0, 1.0/36.0, 1.0/36.0, 1.0/36.0, 1.0/36.0,
+		1.0/36.0, 1.0/36.0, 1.0/36.0, 1.0/36.0, 1.0/36.0, 1.0/36.0 };
+	std::vector<double> Den( 2*Np ), fq( 19*Np );
+	for (size_t n=0; n<Np; n++){
+		double phi = tanh( sin( 0.001*n ) * 4.0 );
+		Den[n] = 0.5*(1.0+phi);
+		Den[Np+n] = 0.5*(1.0-phi);
+		for (int q=0; q<19; q++)
+			fq[q*Np+n] = w[q] * ( 1.0 + 0.01*sin( 0.002*n + q ) );
+	}
+	std::string filename = "RestartTest.z." + std::to_string( rank );
+	std::vector<std::vector<char>> blocks;
+	double t0 = Utilities::MPI::time();
+	for (int q=0; q<2; q++)
+		blocks.push_back( IO::compressValues( &Den[q*Np], Np ) );
+	for (int q=0; q<19; q++)
+		blocks.push_back( IO::compressValues( &fq[q*Np], Np ) );
+	IO::writeCompressedRestart( filename, Np, { 2, 19 }, blocks );
+	double t1 = Utilities::MPI::time();
+	size_t bytes = 0;
+	for ( auto &block : blocks )
+		bytes += block.size();
+
+	int error = 0;
+	if ( !IO::isCompressedRestart( filename ) )
+		error++;
+	std::vector<double> Den2( 2*Np ), fq2( 19*Np );
+	IO::readCompressedRestart( filename, Np, { Den2.data(), fq2.data() }, { 2, 19 } );
+	double t2 = Utilities::MPI::time();
+	if ( Den2 != Den || fq2 != fq )
+		error++;
+
+	// Random values do not compress but must still be recovered exactly
+	std::vector<double> x( 10000 ), y( 10000 );
+	for (size_t i=0; i<x.size(); i++)
+		x[i] = sin( 1e4*i*i + 0.1 ) * exp( 100.0*cos( 3.0*i ) );
+	auto data = IO::compressValues( x.data(), x.size(), 6 );
+	IO::decompressValues( data.data(), data.size(), y.data(), y.size() );
+	if ( x != y )
+		error++;
+
+	error = comm.sumReduce( error );
+	if ( rank == 0 ) {
+		double MB = 21.0*Np*sizeof(double)/1048576.0;
+		printf("compressed: %0.1f MB to %0.1f MB (ratio %0.2f), write %0.1f MB/s, read %0.1f MB/s, %i errors \n",
+			MB, bytes/1048576.0, 21.0*Np*sizeof(double)/bytes, MB/(t1-t0), MB/(t2-t1), error );
+	}
+	return error;
+}
+
+// Sparse layout for a sub-domain: solid sites are not stored and the order
+// depends on the decomposition (as for the AA layout)
+static size_t SparseMap( const RankInfoStruct &info, const int n[3], IntArray &map )
+{
+	map.resize( n[0]+2, n[1]+2, n[2]+2 );
+	map.fill( -1 );
+	size_t Np = 0;
+	for (int k=n[2]; k>=1; k--){
+		for (int j=1; j<=n[1]; j++){
+			for (int i=n[0]; i>=1; i--){
+				int x = info.ix*n[0] + i - 1;
+				int y = info.jy*n[1] + j - 1;
+				int z = info.kz*n[2] + k - 1;
+				if ( (x+2*y+3*z) % 7 == 0 ) continue;
+				map(i,j,k) = Np++;
+			}
+		}
+	}
+	return Np;
+}
+
+static inline double globalValue( int x, int y, int z, int q )
+{
+	return x + 100*y + 10000*z + 0.001*q;
+}
+
+static int CheckGlobalBlock( const std::string &filename, const RankInfoStruct &info, const int n[3] )
+{
+	IntArray map;
+	size_t Np = SparseMap( info, n, map );
+	std::vector<double> Den( 2*Np ), fq( 19*Np );
+	IO::readGlobalRestart( filename, map, info, Np, { Den.data(), fq.data() }, { 2, 19 } );
+	int error = 0;
+	for (int k=1; k<=n[2]; k++){
+		for (int j=1; j<=n[1]; j++){
+			for (int i=1; i<=n[0]; i++){
+				int idx = map(i,j,k);
+				if ( idx < 0 ) continue;
+				int x = info.ix*n[0] + i - 1;
+				int y = info.jy*n[1] + j - 1;
+				int z = info.kz*n[2] + k - 1;
+				for (int q=0; q<2; q++)
+					if ( Den[q*Np+idx] != globalValue(x,y,z,q) ) error++;
+				for (int q=0; q<19; q++)
+					if ( fq[q*Np+idx] != globalValue(x,y,z,q+2) ) error++;
+			}
+		}
+	}
+	return error;
+}
+
+// Write with one processor grid and read back with another
+static int CheckGlobalRestart( const std::array<int,3> &nproc, const Utilities::MPI &comm )
+{
+	int rank = comm.getRank();
+	int nprocs = comm.getSize();
+	const int N[3] = { 12, 10, 16 };
+	int n[3] = { N[0]/nproc[0], N[1]/nproc[1], N[2]/nproc[2] };
+	RankInfoStruct info( rank, nproc[0], nproc[1], nproc[2] );
+	IntArray map;
+	size_t Np = SparseMap( info, n, map );
+	std::vector<double> Den( 2*Np ), fq( 19*Np );
+	for (int k=1; k<=n[2]; k++){
+		for (int j=1; j<=n[1]; j++){
+			for (int i=1; i<=n[0]; i++){
+				int idx = map(i,j,k);
+				if ( idx < 0 ) continue;
+				int x = info.ix*n[0] + i - 1;
+				int y = info.jy*n[1] + j - 1;
+				int z = info.kz*n[2] + k - 1;
+				for (int q=0; q<2; q++)
+					Den[q*Np+idx] = globalValue(x,y,z,q);
+				for (int q=0; q<19; q++)
+					fq[q*Np+idx] = globalValue(x,y,z,q+2);
+			}
+		}
+	}
+	std::string filename = "RestartTest.global";
+	IO::writeGlobalRestart( filename, map, info, Np, { Den.data(), fq.data() }, { 2, 19 }, comm );
+
+	// Read the whole domain on one rank
+	int error = 0;
+	if ( rank == nprocs-1 ) {
+		int n1[3] = { N[0], N[1], N[2] };
+		error += CheckGlobalBlock( filename, RankInfoStruct( 0, 1, 1, 1 ), n1 );
+	}
+	// Read with a different processor grid on every rank
+	std::array<std::array<int,3>,3> grids = { { { 1, 1, nprocs }, { nprocs, 1, 1 }, { 1, nprocs, 1 } } };
+	for ( auto &grid : grids ) {
+		if ( N[0] % grid[0] != 0 || N[1] % grid[1] != 0 || N[2] % grid[2] != 0 )
+			continue;
+		int n2[3] = { N[0]/grid[0], N[1]/grid[1], N[2]/grid[2] };
+		error += CheckGlobalBlock( filename, RankInfoStruct( rank, grid[0], grid[1], grid[2] ), n2 );
+	}
+	error = comm.sumReduce( error );
+	if ( rank == 0 )
+		printf("global (%i,%i,%i): %i errors \n", nproc[0], nproc[1], nproc[2], error );
+	return error;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestRestartFile	\n");
+			printf("********************************************************\n");
+		}
+
+		// The layout hash must depend on the map
+		std::vector<int> map1 = { 0, 1, 2, -1 };
+		std::vector<int> map2 = { 0, 2, 1, -1 };
+		if ( IO::layoutHash( map1.data(), 4 ) == IO::layoutHash( map2.data(), 4 ) )
+			error++;
+
+		error += CheckRestart( 1, comm );
+		error += CheckRestart( 2, comm );
+		error += CheckRestart( nprocs, comm );
+
+		error += CheckCompressed( comm );
+
+		std::array<int,3> zslab = { 1, 1, nprocs };
+		std::array<int,3> blocks = zslab;
+		if (nprocs == 4) blocks = { 2, 2, 1 };
+		error += CheckGlobalRestart( zslab, comm );
+		error += CheckGlobalRestart( blocks, comm );
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All tests passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -0,0 +1,84 @@
+//*************************************************************************
+// Check the statistical steady-state detector with synthetic time series
+//*************************************************************************
+#include <stdio.h>
+#include <math.h>
+#include <random>
+
+#include "common/Utilities.h"
+#include "common/MPI.h"
+#include "analysis/SteadyState.h"
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running unit test: TestSteadyState	\n");
+			printf("********************************************************\n");
+		}
+		std::vector<std::string> names = {"saturation","flow.rate"};
+		std::mt19937 gen(42);
+		std::normal_distribution<double> noise(0.0,1.0);
+
+		// relaxation to a steady value with small fluctuations
+		SteadyState Relax(names, 20, 0.01, 0.95);
+		int detected = -1;
+		for (int t=0; t<400; t++){
+			double sw = 0.4 + 0.1*exp(-t/20.0) + 1.0e-4*noise(gen);
+			double q = 1.0e-3*(1.0 - exp(-t/30.0)) + 1.0e-7*noise(gen);
+			Relax.add({sw, q},{1.0, 1.0e-3});
+			if (Relax.steady()){
+				detected = t;
+				break;
+			}
+		}
+		if (rank==0) printf("  relaxation: steady after %i samples (%s) \n",detected,Relax.reason().c_str());
+		// the flow rate is within 1% of the final value after about 140 samples
+		if (detected < 100 || detected > 300){
+			if (rank==0) printf("Relaxation was not detected in the expected range \n");
+			error++;
+		}
+
+		// a steady drift is never steady
+		SteadyState Drift(names, 20, 0.01, 0.95);
+		bool steady = false;
+		for (int t=0; t<400; t++){
+			Drift.add({0.5 - 1.0e-3*t + 1.0e-5*noise(gen), 1.0e-3},{1.0, 1.0e-3});
+			steady = steady || Drift.steady();
+		}
+		if (rank==0) printf("  drift: %s \n",Drift.reason().c_str());
+		if (steady || Drift.reason().find("saturation is drifting") == std::string::npos){
+			if (rank==0) printf("Drifting series was reported as steady \n");
+			error++;
+		}
+
+		// large fluctuations around a constant mean are not steady
+		SteadyState Noise(names, 20, 0.01, 0.95);
+		steady = false;
+		for (int t=0; t<400; t++){
+			Noise.add({0.5, 1.0e-3*(1.0 + 0.2*noise(gen))},{1.0, 1.0e-3});
+			steady = steady || Noise.steady();
+		}
+		if (rank==0) printf("  noise: %s \n",Noise.reason().c_str());
+		if (steady || Noise.reason().find("flow.rate") == std::string::npos){
+			if (rank==0) printf("Fluctuating series was reported as steady \n");
+			error++;
+		}
+
+		// reset discards the window
+		Noise.reset();
+		if (Noise.samples() != 0 || Noise.steady()){
+			if (rank==0) printf("Reset did not discard the samples \n");
+			error++;
+		}
+		if (rank==0 && error==0) printf("TestSteadyState passed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
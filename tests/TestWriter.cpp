@@ -139,6 +139,16 @@ void testWriter(
     } else if ( format == "hdf5-float" ) {
         format2   = "hdf5";
         precision = IO::DataType::Float;
+    } else if ( format == "hdf5-collective-double" ) {
+        format2   = "hdf5-collective";
+        precision = IO::DataType::Double;
+    } else if ( format == "hdf5-collective-float" ) {
+        format2   = "hdf5-collective";
+        precision = IO::DataType::Float;
+    } else if ( format == "hdf5-collective-gzip" ) {
+        format2   = "hdf5-collective";
+        precision = IO::DataType::Double;
+        IO::setHDF5Options( true, "gzip" );
     }
 
 
@@ -239,6 +249,10 @@ void testWriter(
             }
         }
     }
+
+    // Restore the default HDF5 options
+    if ( format == "hdf5-collective-gzip" )
+        IO::setHDF5Options( false, "none" );
 }
 
 
@@ -409,6 +423,30 @@ int main( int argc, char **argv )
 #ifdef USE_HDF5
     testWriter( "hdf5-double", meshData, ut );
     testWriter( "hdf5-float", meshData, ut );
+    // The collective format stores the nodes shared by two domains once, so the
+    // domain node variables must match on the shared faces (global coordinates)
+    auto collectiveData     = meshData;
+    auto global_node_mag    = std::make_shared<IO::Variable>( 1, NodeVar, "Node_domain_mag" );
+    auto global_node_vec    = std::make_shared<IO::Variable>( 3, NodeVar, "Node_domain_vec" );
+    global_node_mag->data.resize( domain->nx + 1, domain->ny + 1, domain->nz + 1 );
+    global_node_vec->data.resize(
+        { (size_t) domain->nx + 1, (size_t) domain->ny + 1, (size_t) domain->nz + 1, 3 } );
+    for ( int i = 0; i < domain->nx + 1; i++ ) {
+        for ( int j = 0; j < domain->ny + 1; j++ ) {
+            for ( int k = 0; k < domain->nz + 1; k++ ) {
+                Point p( i + rank * domain->nx, j, k );
+                global_node_mag->data( i, j, k )    = distance( p );
+                global_node_vec->data( i, j, k, 0 ) = p.x;
+                global_node_vec->data( i, j, k, 1 ) = p.y;
+                global_node_vec->data( i, j, k, 2 ) = p.z;
+            }
+        }
+    }
+    collectiveData[3].vars[0] = global_node_mag;
+    collectiveData[3].vars[1] = global_node_vec;
+    testWriter( "hdf5-collective-double", collectiveData, ut );
+    testWriter( "hdf5-collective-float", collectiveData, ut );
+    testWriter( "hdf5-collective-gzip", collectiveData, ut );
 #endif
 
     // Finished
@@ -0,0 +1,54 @@
+# This script checks the summary and logs written by lbpm_color_ensemble for
+#    ensemble/ensemble.db, where each of the two members runs on its own group
+CMAKE_POLICY(SET CMP0007 NEW)
+
+IF ( NOT EXISTS "${SUMMARY}" )
+    MESSAGE(FATAL_ERROR "Did not find the ensemble summary ${SUMMARY}\n" )
+ENDIF()
+FILE(STRINGS "${SUMMARY}" rows )
+LIST( LENGTH rows N_rows )
+IF ( NOT N_rows EQUAL 3 )
+    MESSAGE(FATAL_ERROR "Expected a header and 2 rows in ${SUMMARY}, found ${N_rows} lines\n" )
+ENDIF()
+LIST( GET rows 0 header )
+IF ( NOT "${header}" STREQUAL "member input directory group reused timesteps time MLUPS sat.water vz.oil vz.water" )
+    MESSAGE(FATAL_ERROR "Unexpected header '${header}' in ${SUMMARY}\n" )
+ENDIF()
+
+# Check the rows: member m runs on group m, reads its own image and runs all time steps
+SET( names member_a member_b )
+FOREACH( m 0 1 )
+    MATH( EXPR index "${m}+1" )
+    LIST( GET rows ${index} row )
+    LIST( GET names ${m} name )
+    STRING( REGEX REPLACE " +" ";" fields "${row}" )
+    LIST( LENGTH fields N_fields )
+    IF ( NOT N_fields EQUAL 11 )
+        MESSAGE(FATAL_ERROR "Expected 11 fields in row '${row}'\n" )
+    ENDIF()
+    LIST( GET fields 0 member )
+    LIST( GET fields 1 input )
+    LIST( GET fields 2 directory )
+    LIST( GET fields 3 group )
+    LIST( GET fields 4 reused )
+    LIST( GET fields 5 timesteps )
+    IF ( NOT member EQUAL ${m} OR NOT input STREQUAL "ensemble/${name}.db" OR NOT group EQUAL ${m}
+         OR NOT reused EQUAL 0 OR NOT timesteps EQUAL ${TIMESTEPS} )
+        MESSAGE(FATAL_ERROR "Unexpected row '${row}' for member ${m}\n" )
+    ENDIF()
+    IF ( NOT directory MATCHES "/000${m}\\.${name}$" )
+        MESSAGE(FATAL_ERROR "Unexpected directory '${directory}' for member ${m}\n" )
+    ENDIF()
+    # Only the first rank of the group writes the log
+    SET( log "${directory}/lbpm_color_simulator.log" )
+    IF ( NOT EXISTS "${log}" )
+        MESSAGE(FATAL_ERROR "Did not find the log ${log}\n" )
+    ENDIF()
+    FILE( READ "${log}" output )
+    IF ( NOT output MATCHES "Lattice update rate" )
+        MESSAGE(FATAL_ERROR "Unexpected output in ${log}:\n${output}\n" )
+    ENDIF()
+ENDFOREACH()
+
+# Finished
+MESSAGE( "Found 2 members in ${SUMMARY}")
@@ -0,0 +1,240 @@
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "common/Utilities.h"
+#include "models/ColorModel.h"
+
+/*
+ * Run an ensemble of independent color simulations in one MPI job
+ *   - MPI_COMM_WORLD is split into groups of ranks_per_member processes
+ *   - each group runs its share of the members one after the other
+ *   - members in a group that use the same domain re-use the decomposed image
+ */
+
+//*************************************************************************
+// Helper functions for the member directories
+//*************************************************************************
+static std::string DirName( const std::string &path )
+{
+	size_t pos = path.find_last_of( '/' );
+	if ( pos == std::string::npos )
+		return ".";
+	return path.substr( 0, pos );
+}
+static std::string BaseName( const std::string &path )
+{
+	size_t pos = path.find_last_of( '/' );
+	std::string name = ( pos == std::string::npos ) ? path : path.substr( pos + 1 );
+	return name.substr( 0, name.find_last_of( '.' ) );
+}
+static std::string AbsolutePath( const std::string &dir, const std::string &path )
+{
+	if ( path.empty() )
+		return path;
+	std::string full = ( path[0] == '/' ) ? path : dir + "/" + path;
+	// use the canonical name for existing files so that members can share images
+	char *resolved = realpath( full.c_str(), nullptr );
+	if ( resolved != nullptr ) {
+		full = resolved;
+		free( resolved );
+	}
+	return full;
+}
+static void MakeDirectory( const std::string &path )
+{
+	if ( mkdir( path.c_str(), S_IRWXU | S_IRGRP | S_IXGRP ) != 0 && errno != EEXIST )
+		ERROR( "Unable to create directory " + path );
+}
+
+// quantities that are reported for each member in the summary
+enum { SUMMARY_GROUP, SUMMARY_REUSED, SUMMARY_TIMESTEP, SUMMARY_TIME, SUMMARY_MLUPS,
+	SUMMARY_SATURATION, SUMMARY_VELOCITY_A, SUMMARY_VELOCITY_B, SUMMARY_SIZE };
+
+//*************************************************************************
+// Ensemble of color simulations
+//*************************************************************************
+
+int main( int argc, char **argv )
+{
+
+	// Initialize
+	Utilities::startup( argc, argv, true );
+
+	{ // Limit scope so variables that contain communicators will free before MPI_Finialize
+
+		Utilities::MPI comm( MPI_COMM_WORLD );
+		int rank   = comm.getRank();
+		int nprocs = comm.getSize();
+		if ( argc < 2 )
+			ERROR( "Usage: lbpm_color_ensemble ensemble.db" );
+
+		auto db = std::make_shared<Database>( argv[1] );
+		auto ensemble_db = db->getDatabase( "Ensemble" );
+		auto members = ensemble_db->getVector<std::string>( "members" );
+		int ranks_per_member = ensemble_db->getWithDefault<int>( "ranks_per_member", nprocs );
+		auto output_directory = ensemble_db->getWithDefault<std::string>( "output_directory", "" );
+		auto summary = ensemble_db->getWithDefault<std::string>( "summary", "ensemble.csv" );
+		if ( ranks_per_member < 1 || nprocs % ranks_per_member != 0 )
+			ERROR( "ranks_per_member must divide the number of MPI processes" );
+		int ngroups = nprocs / ranks_per_member;
+		int nmembers = members.size();
+
+		if ( rank == 0 ) {
+			printf( "********************************************************\n" );
+			printf( "Running Color LBM ensemble	\n" );
+			printf( "********************************************************\n" );
+			printf( "   members: %i, groups: %i, ranks per member: %i \n", nmembers, ngroups, ranks_per_member );
+		}
+		// Initialize compute device
+		int device = ScaLBL_SetDevice( rank );
+		NULL_USE( device );
+		ScaLBL_DeviceBarrier();
+		comm.barrier();
+		Utilities::setErrorHandlers();
+
+		// Split the processes into groups that each run a member at a time
+		int group = rank / ranks_per_member;
+		auto group_comm = comm.split( group, rank );
+		int group_rank = group_comm.getRank();
+
+		char buffer[4096];
+		std::string launch_directory = getcwd( buffer, sizeof( buffer ) );
+		if ( !output_directory.empty() ) {
+			output_directory = AbsolutePath( launch_directory, output_directory );
+			if ( rank == 0 )
+				MakeDirectory( output_directory );
+			comm.barrier();
+		}
+		std::vector<std::string> run_directory( nmembers );
+		for ( int m = 0; m < nmembers; m++ ) {
+			if ( output_directory.empty() ) {
+				run_directory[m] = AbsolutePath( launch_directory, DirName( members[m] ) );
+			} else {
+				sprintf( buffer, "%s/%04i.%s", output_directory.c_str(), m, BaseName( members[m] ).c_str() );
+				run_directory[m] = buffer;
+			}
+		}
+
+		// Decomposed images that were read by this group
+		std::map<std::string, std::vector<signed char>> geometry;
+		std::vector<double> results( nmembers * SUMMARY_SIZE, 0.0 );
+		int stdout_fd = dup( fileno( stdout ) );
+		int stderr_fd = dup( fileno( stderr ) );
+		for ( int m = group; m < nmembers; m += ngroups ) {
+			double start = Utilities::MPI::time();
+			// Load the member database and resolve relative paths from its directory
+			std::string db_directory = AbsolutePath( launch_directory, DirName( members[m] ) );
+			auto member_db = std::make_shared<Database>( AbsolutePath( launch_directory, members[m] ) );
+			auto domain_db = member_db->getDatabase( "Domain" );
+			auto color_db = member_db->getDatabase( "Color" );
+			for ( auto key : { "Filename", "GridFile" } ) {
+				if ( domain_db->keyExists( key ) )
+					domain_db->putScalar<std::string>( key, AbsolutePath( db_directory, domain_db->getScalar<std::string>( key ) ) );
+			}
+			if ( color_db->keyExists( "image_sequence" ) ) {
+				auto ImageList = color_db->getVector<std::string>( "image_sequence" );
+				for ( auto &image : ImageList )
+					image = AbsolutePath( db_directory, image );
+				color_db->putVector<std::string>( "image_sequence", ImageList );
+			}
+
+			// Each member runs in its own directory and writes its own log
+			if ( group_rank == 0 )
+				MakeDirectory( run_directory[m] );
+			group_comm.barrier();
+			if ( chdir( run_directory[m].c_str() ) != 0 )
+				ERROR( "Unable to change to directory " + run_directory[m] );
+			// only the first rank of the group writes the log, the others are discarded
+			fflush( stdout );
+			fflush( stderr );
+			int log_fd;
+			if ( group_rank == 0 )
+				log_fd = open( "lbpm_color_simulator.log", O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+			else
+				log_fd = open( "/dev/null", O_WRONLY );
+			if ( log_fd < 0 )
+				ERROR( "Unable to open the log for member " + members[m] );
+			dup2( log_fd, fileno( stdout ) );
+			dup2( log_fd, fileno( stderr ) );
+			close( log_fd );
+			{
+				ScaLBL_ColorModel ColorModel( group_rank, ranks_per_member, group_comm );
+				ColorModel.ReadParams( member_db );
+				ColorModel.SetDomain();
+				// members with the same domain and first image share the decomposed labels
+				std::string key = ColorModel.domain_db->print();
+				if ( ColorModel.color_db->keyExists( "image_sequence" ) ) {
+					auto ImageList = ColorModel.color_db->getVector<std::string>( "image_sequence" );
+					key += ImageList[ColorModel.color_db->getWithDefault<int>( "image_index", 0 )];
+				}
+				bool reused = geometry.find( key ) != geometry.end();
+				if ( reused ) {
+					if ( group_rank == 0 )
+						printf( "Re-using decomposed image \n" );
+					ColorModel.ReadInput( geometry[key].data() );
+				} else {
+					ColorModel.ReadInput();
+					geometry[key].assign( ColorModel.id, ColorModel.id + ColorModel.N );
+				}
+				ColorModel.Create();
+				ColorModel.Initialize();
+				double MLUPS = ColorModel.RunProtocol();
+
+				auto &Averages = *ColorModel.Averages;
+				double *result = &results[m * SUMMARY_SIZE];
+				result[SUMMARY_GROUP] = group;
+				result[SUMMARY_REUSED] = reused ? 1 : 0;
+				result[SUMMARY_TIMESTEP] = ColorModel.timestep;
+				result[SUMMARY_TIME] = Utilities::MPI::time() - start;
+				result[SUMMARY_MLUPS] = MLUPS;
+				result[SUMMARY_SATURATION] = Averages.gwb.V / ( Averages.gnb.V + Averages.gwb.V );
+				result[SUMMARY_VELOCITY_A] = Averages.gnb.Pz / Averages.gnb.M;
+				result[SUMMARY_VELOCITY_B] = Averages.gwb.Pz / Averages.gwb.M;
+			} // free the model before the next member
+			fflush( stdout );
+			fflush( stderr );
+			cout << flush;
+			cerr << flush;
+			dup2( stdout_fd, fileno( stdout ) );
+			dup2( stderr_fd, fileno( stderr ) );
+			if ( chdir( launch_directory.c_str() ) != 0 )
+				ERROR( "Unable to change to directory " + launch_directory );
+			if ( group_rank == 0 )
+				printf( "   finished member %i (%s) on group %i in %f seconds \n", m, members[m].c_str(), group,
+					results[m * SUMMARY_SIZE + SUMMARY_TIME] );
+			// only the first rank of the group reports the results
+			if ( group_rank != 0 )
+				std::fill( &results[m * SUMMARY_SIZE], &results[( m + 1 ) * SUMMARY_SIZE], 0.0 );
+		}
+		close( stdout_fd );
+		close( stderr_fd );
+
+		// Combine the results from all groups
+		comm.sumReduce( results.data(), results.size() );
+		if ( rank == 0 ) {
+			FILE *SUMMARY = fopen( summary.c_str(), "w" );
+			fprintf( SUMMARY, "member input directory group reused timesteps time MLUPS sat.water vz.oil vz.water\n" );
+			for ( int m = 0; m < nmembers; m++ ) {
+				const double *result = &results[m * SUMMARY_SIZE];
+				fprintf( SUMMARY, "%i %s %s %i %i %i %.8g %.8g %.8g %.8g %.8g\n", m, members[m].c_str(),
+					run_directory[m].c_str(), (int) result[SUMMARY_GROUP], (int) result[SUMMARY_REUSED],
+					(int) result[SUMMARY_TIMESTEP], result[SUMMARY_TIME], result[SUMMARY_MLUPS],
+					result[SUMMARY_SATURATION], result[SUMMARY_VELOCITY_A], result[SUMMARY_VELOCITY_B] );
+			}
+			fclose( SUMMARY );
+			printf( "Wrote ensemble summary to %s \n", summary.c_str() );
+		}
+	} // Limit scope so variables that contain communicators will free before MPI_Finialize
+	cout << flush;
+	Utilities::shutdown();
+	return 0;
+}
@@ -0,0 +1,503 @@
+//*************************************************************************
+// Benchmark for the lattice Boltzmann kernels
+// Times each kernel family and the halo exchange on a synthetic porous
+// medium and compares the achieved memory bandwidth to a STREAM triad.
+//
+// usage: lbpm_kernel_benchmark [input.db]
+//   Domain section:     n, nproc, BC (defaults: 32^3 per rank, split in z)
+//   Benchmark section:  porosity (0.7), radius (4), timesteps (10), seed (1),
+//                       stream_size (doubles per array), kernels (list of
+//                       names to run), output (append the results to a file)
+//*************************************************************************
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/ScaLBL.h"
+#include "common/MPI.h"
+
+using namespace std;
+
+struct KernelBenchmark {
+	std::string name;
+	int doubles;  // values read and written per site per time step
+	int ints;     // map and neighbor list entries per site per time step (averaged over odd / even)
+	double *check; // distributions checked for non-finite values after the run
+	int Nq;
+	std::function<void(bool odd, int start, int finish)> step;
+	std::function<void()> init = nullptr; // optional model-specific initialization
+};
+
+std::shared_ptr<Database> loadInputs( int argc, char **argv, int nprocs )
+{
+	std::shared_ptr<Database> db;
+	if ( argc > 1 ) {
+		db = std::make_shared<Database>( argv[1] );
+	} else {
+		db = std::make_shared<Database>();
+		auto domain_db = std::make_shared<Database>();
+		domain_db->putScalar<int>( "BC", 0 );
+		domain_db->putVector<int>( "nproc", { 1, 1, nprocs } );
+		domain_db->putVector<int>( "n", { 32, 32, 32 } );
+		domain_db->putVector<double>( "L", { 1, 1, 1 } );
+		db->putDatabase( "Domain", domain_db );
+	}
+	if ( !db->keyExists( "Benchmark" ) )
+		db->putDatabase( "Benchmark", std::make_shared<Database>() );
+	return db;
+}
+
+// Best time for the STREAM triad a = b + s*c (bytes per second)
+static double StreamTriad( size_t N )
+{
+	double *a = new double[N];
+	double *b = new double[N];
+	double *c = new double[N];
+	#pragma omp parallel for schedule(static)
+	for (size_t i=0; i<N; i++){
+		a[i] = 0.0;
+		b[i] = 1.0;
+		c[i] = 2.0;
+	}
+	double best = 1.0e300;
+	for (int rep=0; rep<5; rep++){
+		double t0 = Utilities::MPI::time();
+		#pragma omp parallel for schedule(static)
+		for (size_t i=0; i<N; i++)
+			a[i] = b[i] + 3.0*c[i];
+		double t1 = Utilities::MPI::time();
+		if (t1-t0 < best) best = t1-t0;
+	}
+	if (a[N/2] != 7.0) printf("STREAM triad produced a wrong result \n");
+	delete [] a;
+	delete [] b;
+	delete [] c;
+	return 3.0*8.0*N/best;
+}
+
+//***************************************************************************************
+int main(int argc, char **argv)
+{
+	// Initialize MPI
+	Utilities::startup( argc, argv );
+	Utilities::MPI comm( MPI_COMM_WORLD );
+	int error=0;
+	{
+		int rank = comm.getRank();
+		int nprocs = comm.getSize();
+		if (rank == 0){
+			printf("********************************************************\n");
+			printf("Running kernel benchmark	\n");
+			printf("********************************************************\n");
+		}
+
+		auto db = loadInputs( argc, argv, nprocs );
+		auto domain_db = db->getDatabase( "Domain" );
+		auto bench_db = db->getDatabase( "Benchmark" );
+		double porosity = bench_db->getWithDefault<double>( "porosity", 0.7 );
+		double radius = bench_db->getWithDefault<double>( "radius", 4.0 );
+		int timesteps = bench_db->getWithDefault<int>( "timesteps", 10 );
+		int seed = bench_db->getWithDefault<int>( "seed", 1 );
+		std::vector<std::string> kernels;
+		if ( bench_db->keyExists( "kernels" ) )
+			kernels = bench_db->getVector<std::string>( "kernels" );
+
+		auto Dm = std::make_shared<Domain>(domain_db,comm);
+		int Nx = Dm->Nx;
+		int Ny = Dm->Ny;
+		int Nz = Dm->Nz;
+		int N = Nx*Ny*Nz;
+
+		// Overlapping spheres at random positions, the same on every rank. For a
+		// Poisson distribution of centers the porosity is exp(-n*V_sphere/V)
+		double Gx = double(Dm->nprocx()*(Nx-2));
+		double Gy = double(Dm->nprocy()*(Ny-2));
+		double Gz = double(Dm->nprocz()*(Nz-2));
+		double Vsphere = 4.0/3.0*M_PI*radius*radius*radius;
+		int nspheres = int(-log(porosity)*Gx*Gy*Gz/Vsphere + 0.5);
+		std::mt19937 generator( seed );
+		std::uniform_real_distribution<double> uniform( 0.0, 1.0 );
+		std::vector<double> cx(nspheres), cy(nspheres), cz(nspheres);
+		for (int s=0; s<nspheres; s++){
+			cx[s] = uniform(generator)*Gx;
+			cy[s] = uniform(generator)*Gy;
+			cz[s] = uniform(generator)*Gz;
+		}
+		int Np = 0;
+		for (int n=0; n<N; n++) Dm->id[n] = 0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					double x = double(Dm->iproc()*(Nx-2) + i-1) + 0.5;
+					double y = double(Dm->jproc()*(Ny-2) + j-1) + 0.5;
+					double z = double(Dm->kproc()*(Nz-2) + k-1) + 0.5;
+					bool solid = false;
+					for (int s=0; s<nspheres && !solid; s++){
+						// periodic distance
+						double dx = fabs(x-cx[s]); dx = min(dx, Gx-dx);
+						double dy = fabs(y-cy[s]); dy = min(dy, Gy-dy);
+						double dz = fabs(z-cz[s]); dz = min(dz, Gz-dz);
+						if (dx*dx+dy*dy+dz*dz < radius*radius) solid = true;
+					}
+					if (!solid){
+						Dm->id[k*Nx*Ny+j*Nx+i] = 1;
+						Np++;
+					}
+				}
+			}
+		}
+		Dm->CommInit();
+		double total_sites = comm.sumReduce( double(Np) );
+		if (rank == 0){
+			printf("Sub-domain size = %i x %i x %i on %i ranks \n",Nx-2,Ny-2,Nz-2,nprocs);
+			printf("%i spheres of radius %g, porosity = %f \n",nspheres,radius,total_sites/(Gx*Gy*Gz));
+		}
+
+		// Build the AA layout
+		std::shared_ptr<ScaLBL_Communicator> ScaLBL_Comm(new ScaLBL_Communicator(Dm));
+		IntArray Map(Nx,Ny,Nz);
+		int *neighborList = new int[18*(Np+64)];
+		Np = ScaLBL_Comm->MemoryOptimizedLayoutAA(Map,neighborList,Dm->id.data(),Np,1);
+		int Nsites = comm.sumReduce( ScaLBL_Comm->LastExterior() + ScaLBL_Comm->LastInterior() - ScaLBL_Comm->FirstInterior() );
+
+		// Map into the regular layout (and into the wide halo layout for the free energy model)
+		int Nxh = Nx+2;
+		int Nyh = Ny+2;
+		int Nzh = Nz+2;
+		int *TmpMap = new int[Np];
+		int *TmpMapWide = new int[Np];
+		for (int idx=0; idx<Np; idx++) TmpMap[idx] = TmpMapWide[idx] = 0;
+		for (int k=1;k<Nz-1;k++){
+			for (int j=1;j<Ny-1;j++){
+				for (int i=1;i<Nx-1;i++){
+					int idx = Map(i,j,k);
+					if (!(idx < 0)){
+						TmpMap[idx] = k*Nx*Ny+j*Nx+i;
+						TmpMapWide[idx] = (k+1)*Nxh*Nyh+(j+1)*Nxh+i+1;
+					}
+				}
+			}
+		}
+
+		int *NeighborList, *dvcMap, *dvcMapWide;
+		double *fq, *Aq, *Bq, *Den, *Phi, *Vel, *Pressure, *Grad, *Aux, *Grey;
+		ScaLBL_AllocateDistributionMemory((void **) &NeighborList, 18*Np*sizeof(int), 18);
+		ScaLBL_AllocateDeviceMemory((void **) &dvcMap, Np*sizeof(int));
+		ScaLBL_AllocateDeviceMemory((void **) &dvcMapWide, Np*sizeof(int));
+		ScaLBL_AllocateDistributionMemory((void **) &fq, 19*Np*sizeof(double), 19);
+		ScaLBL_AllocateDistributionMemory((void **) &Aq, 7*Np*sizeof(double), 7);
+		ScaLBL_AllocateDistributionMemory((void **) &Bq, 7*Np*sizeof(double), 7);
+		ScaLBL_AllocateDistributionMemory((void **) &Den, 2*Np*sizeof(double), 2);
+		ScaLBL_AllocateDistributionMemory((void **) &Vel, 3*Np*sizeof(double), 3);
+		ScaLBL_AllocateDistributionMemory((void **) &Pressure, Np*sizeof(double), 1);
+		ScaLBL_AllocateDistributionMemory((void **) &Grad, 3*Np*sizeof(double), 3);
+		ScaLBL_AllocateDistributionMemory((void **) &Aux, 9*Np*sizeof(double), 9);
+		ScaLBL_AllocateDistributionMemory((void **) &Grey, 8*Np*sizeof(double), 8);
+		ScaLBL_AllocateDeviceMemory((void **) &Phi, Nxh*Nyh*Nzh*sizeof(double));
+		ScaLBL_CopyToDevice(NeighborList, neighborList, 18*Np*sizeof(int));
+		ScaLBL_CopyToDevice(dvcMap, TmpMap, Np*sizeof(int));
+		ScaLBL_CopyToDevice(dvcMapWide, TmpMapWide, Np*sizeof(int));
+
+		// Two fluids split at the middle of the domain
+		double *PhiHost = new double[Nxh*Nyh*Nzh];
+		double *PhiWideHost = new double[Nxh*Nyh*Nzh];
+		for (int n=0; n<Nxh*Nyh*Nzh; n++) PhiHost[n] = PhiWideHost[n] = 0.0;
+		for (int k=0;k<Nz;k++){
+			for (int j=0;j<Ny;j++){
+				for (int i=0;i<Nx;i++){
+					double phi = (Dm->kproc()*(Nz-2) + k < Gz/2) ? 1.0 : -1.0;
+					if (Dm->id[k*Nx*Ny+j*Nx+i] == 0) phi = 0.0;
+					PhiHost[k*Nx*Ny+j*Nx+i] = phi;
+					PhiWideHost[(k+1)*Nxh*Nyh+(j+1)*Nxh+i+1] = phi;
+				}
+			}
+		}
+		// Greyscale parameters: porosity, permeability, affinity, Sn, Sw, Kn, Kw and the
+		// mobility ratio, set to the values the models assign to open (non-grey) sites
+		double *GreyHost = new double[8*Np];
+		for (int n=0; n<Np; n++){
+			GreyHost[0*Np+n] = 1.0;
+			GreyHost[1*Np+n] = 1.0;
+			GreyHost[2*Np+n] = 0.0;
+			GreyHost[3*Np+n] = 99.0;
+			GreyHost[4*Np+n] = -99.0;
+			GreyHost[5*Np+n] = 0.0;
+			GreyHost[6*Np+n] = 0.0;
+			GreyHost[7*Np+n] = 1.0;
+		}
+		ScaLBL_CopyToDevice(Grey, GreyHost, 8*Np*sizeof(double));
+		double *Zero = new double[9*Np];
+		for (int n=0; n<9*Np; n++) Zero[n] = 0.0;
+		double *Poros = &Grey[0*Np];
+		double *Perm = &Grey[1*Np];
+
+		// Reset the state of all fields before each kernel family
+		auto initialize = [&](){
+			ScaLBL_CopyToDevice(Phi, PhiHost, Nxh*Nyh*Nzh*sizeof(double));
+			ScaLBL_D3Q19_Init(fq, Np);
+			ScaLBL_PhaseField_Init(dvcMap, Phi, Den, Aq, Bq, 0, ScaLBL_Comm->LastExterior(), Np);
+			ScaLBL_PhaseField_Init(dvcMap, Phi, Den, Aq, Bq, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+			ScaLBL_CopyToDevice(Vel, Zero, 3*Np*sizeof(double));
+			ScaLBL_CopyToDevice(Pressure, Zero, Np*sizeof(double));
+			ScaLBL_CopyToDevice(Grad, Zero, 3*Np*sizeof(double));
+			ScaLBL_CopyToDevice(Aux, Zero, 9*Np*sizeof(double));
+		};
+
+		double tau = 1.0;
+		double rlx = 1.0/tau;
+		double rlx_setA = 1.0/tau;
+		double rlx_setB = 8.f*(2.f-rlx_setA)/(8.f-rlx_setA);
+		double Fx = 0.0, Fy = 0.0, Fz = 1.0e-5;
+		double rhoA = 1.0, rhoB = 1.0, tauA = 1.0, tauB = 1.0;
+		double alpha = 0.005, beta = 0.95;
+		// free energy model defaults (surface tension 1e-3, interface width 5)
+		double W = 5.0, tauM = 1.0;
+		double beta_lee = 0.75*1.0e-3/W, kappa = 0.375*1.0e-3*W;
+
+		std::vector<KernelBenchmark> benchmarks;
+		benchmarks.push_back( { "BGK", 38, 9, fq, 19, [&](bool odd, int start, int finish){
+			if (odd) ScaLBL_D3Q19_AAodd_BGK(NeighborList, fq, start, finish, Np, rlx, Fx, Fy, Fz);
+			else ScaLBL_D3Q19_AAeven_BGK(fq, start, finish, Np, rlx, Fx, Fy, Fz);
+		} } );
+		benchmarks.push_back( { "MRT", 38, 9, fq, 19, [&](bool odd, int start, int finish){
+			if (odd) ScaLBL_D3Q19_AAodd_MRT(NeighborList, fq, start, finish, Np, rlx_setA, rlx_setB, Fx, Fy, Fz);
+			else ScaLBL_D3Q19_AAeven_MRT(fq, start, finish, Np, rlx_setA, rlx_setB, Fx, Fy, Fz);
+		} } );
+		benchmarks.push_back( { "Greyscale", 44, 9, fq, 19, [&](bool odd, int start, int finish){
+			if (odd) ScaLBL_D3Q19_AAodd_Greyscale(NeighborList, fq, start, finish, Np, rlx, rlx, Fx, Fy, Fz, Poros, Perm, Vel, Pressure);
+			else ScaLBL_D3Q19_AAeven_Greyscale(fq, start, finish, Np, rlx, rlx, Fx, Fy, Fz, Poros, Perm, Vel, Pressure);
+		} } );
+		// phase field (17 values, 4 ints) followed by the D3Q19 collision (58 values, 10 ints)
+		benchmarks.push_back( { "Color", 75, 14, fq, 19, [&](bool odd, int start, int finish){
+			if (odd){
+				ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi, start, finish, Np);
+				ScaLBL_D3Q19_AAodd_Color(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB,
+						alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, start, finish, Np);
+			}
+			else {
+				ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi, start, finish, Np);
+				ScaLBL_D3Q19_AAeven_Color(dvcMap, fq, Aq, Bq, Den, Phi, Vel, rhoA, rhoB, tauA, tauB,
+						alpha, beta, Fx, Fy, Fz, Nx, Nx*Ny, start, finish, Np);
+			}
+		} } );
+		// phase field (17, 3), gradient (4, 18) and collision (61, 9)
+		benchmarks.push_back( { "DFH", 82, 30, fq, 19, [&](bool odd, int start, int finish){
+			double *SolidForce = Aux;
+			if (odd){
+				ScaLBL_D3Q7_AAodd_DFH(NeighborList, Aq, Bq, Den, Phi, start, finish, Np);
+				ScaLBL_D3Q19_Gradient_DFH(NeighborList, Phi, Grad, start, finish, Np);
+				ScaLBL_D3Q19_AAodd_DFH(NeighborList, fq, Aq, Bq, Den, Phi, Grad, SolidForce, rhoA, rhoB, tauA, tauB,
+						alpha, beta, Fx, Fy, Fz, start, finish, Np);
+			}
+			else {
+				ScaLBL_D3Q7_AAeven_DFH(Aq, Bq, Den, Phi, start, finish, Np);
+				ScaLBL_D3Q19_Gradient_DFH(NeighborList, Phi, Grad, start, finish, Np);
+				ScaLBL_D3Q19_AAeven_DFH(NeighborList, fq, Aq, Bq, Den, Phi, Grad, SolidForce, rhoA, rhoB, tauA, tauB,
+						alpha, beta, Fx, Fy, Fz, start, finish, Np);
+			}
+		} } );
+		// phase field (9, 4) and combined collision (55, 10) on the wide halo layout
+		benchmarks.push_back( { "FreeLee", 64, 14, fq, 19, [&](bool odd, int start, int finish){
+			double *hq = Aq;
+			double *mu_phi = Aux;
+			if (odd){
+				ScaLBL_D3Q7_AAodd_FreeLeeModel_PhaseField(NeighborList, dvcMapWide, hq, Den, Phi, rhoA, rhoB, start, finish, Np);
+				ScaLBL_D3Q19_AAodd_FreeLeeModel_Combined(NeighborList, dvcMapWide, fq, hq, Den, Phi, mu_phi, Vel, Pressure, Grad,
+						rhoA, rhoB, tauA, tauB, tauM, kappa, beta_lee, W, Fx, Fy, Fz, Nxh, Nxh*Nyh, start, finish, Np);
+			}
+			else {
+				ScaLBL_D3Q7_AAeven_FreeLeeModel_PhaseField(dvcMapWide, hq, Den, Phi, rhoA, rhoB, start, finish, Np);
+				ScaLBL_D3Q19_AAeven_FreeLeeModel_Combined(dvcMapWide, fq, hq, Den, Phi, mu_phi, Vel, Pressure, Grad,
+						rhoA, rhoB, tauA, tauB, tauM, kappa, beta_lee, W, Fx, Fy, Fz, Nxh, Nxh*Nyh, start, finish, Np);
+			}
+		}, [&](){
+			// the phase field is stored with a halo of width two
+			double *hq = Aq;
+			double *mu_phi = Aux;
+			ScaLBL_CopyToDevice(Phi, PhiWideHost, Nxh*Nyh*Nzh*sizeof(double));
+			ScaLBL_D3Q19_FreeLeeModel_TwoFluid_Init(fq, mu_phi, Grad, Fx, Fy, Fz, Np);
+			ScaLBL_FreeLeeModel_PhaseField_Init(dvcMapWide, Phi, Den, hq, Grad, rhoA, rhoB, tauM, W, 0, ScaLBL_Comm->LastExterior(), Np);
+			ScaLBL_FreeLeeModel_PhaseField_Init(dvcMapWide, Phi, Den, hq, Grad, rhoA, rhoB, tauM, W, ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior(), Np);
+		} } );
+		// phase field (17, 4) and collision (67, 10)
+		benchmarks.push_back( { "GreyscaleColor", 84, 14, fq, 19, [&](bool odd, int start, int finish){
+			double *GreySolidW = &Grey[2*Np], *GreySn = &Grey[3*Np], *GreySw = &Grey[4*Np];
+			double *GreyKn = &Grey[5*Np], *GreyKw = &Grey[6*Np], *MobilityRatio = &Grey[7*Np];
+			if (odd){
+				ScaLBL_D3Q7_AAodd_PhaseField(NeighborList, dvcMap, Aq, Bq, Den, Phi, start, finish, Np);
+				ScaLBL_D3Q19_AAodd_GreyscaleColor_CP(NeighborList, dvcMap, fq, Aq, Bq, Den, Phi, GreySolidW, GreySn,
+						GreySw, GreyKn, GreyKw, Poros, Perm, Vel, MobilityRatio, Pressure, rhoA, rhoB, tauA, tauB,
+						tauA, tauB, alpha, beta, Fx, Fy, Fz, false, Nx, Nx*Ny, start, finish, Np);
+			}
+			else {
+				ScaLBL_D3Q7_AAeven_PhaseField(dvcMap, Aq, Bq, Den, Phi, start, finish, Np);
+				ScaLBL_D3Q19_AAeven_GreyscaleColor_CP(dvcMap, fq, Aq, Bq, Den, Phi, GreySolidW, GreySn,
+						GreySw, GreyKn, GreyKw, Poros, Perm, Vel, MobilityRatio, Pressure, rhoA, rhoB, tauA, tauB,
+						tauA, tauB, alpha, beta, Fx, Fy, Fz, false, Nx, Nx*Ny, start, finish, Np);
+			}
+		} } );
+		// one ion species
+		benchmarks.push_back( { "Ion", 30, 3, Aq, 7, [&](bool odd, int start, int finish){
+			double *Ci = Pressure;
+			double *FluxDiffusive = &Aux[0], *FluxAdvective = &Aux[3*Np], *FluxElectrical = &Aux[6*Np];
+			double *ElectricField = Grad;
+			if (odd) ScaLBL_D3Q7_AAodd_Ion(NeighborList, Aq, Ci, FluxDiffusive, FluxAdvective, FluxElectrical,
+						Vel, ElectricField, 1.0e-9, 1, rlx, 0.0253, start, finish, Np);
+			else ScaLBL_D3Q7_AAeven_Ion(Aq, Ci, FluxDiffusive, FluxAdvective, FluxElectrical,
+						Vel, ElectricField, 1.0e-9, 1, rlx, 0.0253, start, finish, Np);
+		} } );
+		// electric potential (8, 4) and D3Q7 Poisson collision (19, 4)
+		benchmarks.push_back( { "Poisson", 27, 8, Aq, 7, [&](bool odd, int start, int finish){
+			double *ChargeDensity = Pressure;
+			double *ElectricField = Grad;
+			if (odd){
+				ScaLBL_D3Q7_AAodd_Poisson_ElectricPotential(NeighborList, dvcMap, Aq, Phi, start, finish, Np);
+				ScaLBL_D3Q7_AAodd_Poisson(NeighborList, dvcMap, Aq, ChargeDensity, Phi, ElectricField, tau, 1.0, false, start, finish, Np);
+			}
+			else {
+				ScaLBL_D3Q7_AAeven_Poisson_ElectricPotential(dvcMap, Aq, Phi, start, finish, Np);
+				ScaLBL_D3Q7_AAeven_Poisson(dvcMap, Aq, ChargeDensity, Phi, ElectricField, tau, 1.0, false, start, finish, Np);
+			}
+		} } );
+		benchmarks.push_back( { "Stokes", 45, 9, fq, 19, [&](bool odd, int start, int finish){
+			double *ChargeDensity = Pressure;
+			double *ElectricField = Grad;
+			if (odd) ScaLBL_D3Q19_AAodd_StokesMRT(NeighborList, fq, Vel, ChargeDensity, ElectricField, rlx_setA, rlx_setB,
+						Fx, Fy, Fz, 1.0, 1.0, 1.0e-6, 1.0, false, start, finish, Np);
+			else ScaLBL_D3Q19_AAeven_StokesMRT(fq, Vel, ChargeDensity, ElectricField, rlx_setA, rlx_setB,
+						Fx, Fy, Fz, 1.0, 1.0, 1.0e-6, 1.0, false, start, finish, Np);
+		} } );
+
+		// STREAM triad reference (per rank, concurrently on all ranks)
+		size_t stream_size = bench_db->getWithDefault<int>( "stream_size", max(19*Np, 4*1024*1024) );
+		comm.barrier();
+		double stream_bandwidth = comm.sumReduce( StreamTriad( stream_size ) ) / nprocs;
+		if (rank == 0){
+			printf("STREAM triad bandwidth = %.2f GB/s per rank (%zu doubles per array) \n",stream_bandwidth*1.0e-9,stream_size);
+			printf("%-16s %12s %12s %14s %10s \n","kernel","time (s)","MLUPS","GB/s per rank","% STREAM");
+		}
+
+		FILE *OUTPUT = NULL;
+		if (rank == 0 && bench_db->keyExists( "output" ))
+			OUTPUT = fopen( bench_db->getScalar<std::string>( "output" ).c_str(), "a" );
+		auto report = [&](const std::string &name, double time, double mlups, double bandwidth){
+			if (rank != 0) return;
+			printf("%-16s %12.4f %12.2f %14.2f %10.1f \n",name.c_str(),time,mlups,bandwidth*1.0e-9,100.0*bandwidth/stream_bandwidth);
+			if (OUTPUT) fprintf(OUTPUT,"%s %i %i %.6g %.6g %.6g \n",name.c_str(),nprocs,Nsites,time,mlups,bandwidth);
+		};
+		auto selected = [&](const std::string &name){
+			if (kernels.empty()) return true;
+			for (auto &kernel : kernels)
+				if (kernel == name) return true;
+			return false;
+		};
+
+		// Kernel families (no communication)
+		int ranges[2][2] = { { ScaLBL_Comm->FirstInterior(), ScaLBL_Comm->LastInterior() }, { 0, ScaLBL_Comm->LastExterior() } };
+		for (auto &bench : benchmarks){
+			if (!selected(bench.name)) continue;
+			initialize();
+			if (bench.init) bench.init();
+			// warm up
+			for (int r=0; r<2; r++) bench.step( true, ranges[r][0], ranges[r][1] );
+			for (int r=0; r<2; r++) bench.step( false, ranges[r][0], ranges[r][1] );
+			ScaLBL_DeviceBarrier();
+			comm.barrier();
+			double starttime = Utilities::MPI::time();
+			for (int timestep=0; timestep<timesteps; timestep++){
+				for (int r=0; r<2; r++) bench.step( timestep%2==0, ranges[r][0], ranges[r][1] );
+			}
+			ScaLBL_DeviceBarrier();
+			double time = comm.maxReduce( Utilities::MPI::time() - starttime );
+			double mlups = double(Nsites)*timesteps/time/1.0e6;
+			double bandwidth = double(Nsites)/nprocs*timesteps*(8.0*bench.doubles + 4.0*bench.ints)/time;
+			report( bench.name, time, mlups, bandwidth );
+
+			// the benchmark also serves as a smoke test for the kernels
+			double *dist = new double[bench.Nq*Np];
+			ScaLBL_CopyToHost(dist, bench.check, bench.Nq*Np*sizeof(double));
+			int nonfinite = 0;
+			for (int r=0; r<2; r++){
+				for (int q=0; q<bench.Nq; q++){
+					for (int n=ranges[r][0]; n<ranges[r][1]; n++){
+						if (!std::isfinite(dist[q*Np+n])) nonfinite++;
+					}
+				}
+			}
+			delete [] dist;
+			nonfinite = comm.sumReduce( nonfinite );
+			if (nonfinite > 0){
+				if (rank == 0) printf("   %s produced %i non-finite distributions \n",bench.name.c_str(),nonfinite);
+				error++;
+			}
+		}
+
+		// Halo exchange (pack, MPI and unpack)
+		int faces = ScaLBL_Comm->sendCount_x + ScaLBL_Comm->sendCount_y + ScaLBL_Comm->sendCount_z
+				+ ScaLBL_Comm->sendCount_X + ScaLBL_Comm->sendCount_Y + ScaLBL_Comm->sendCount_Z;
+		int edges = ScaLBL_Comm->sendCount_xy + ScaLBL_Comm->sendCount_yz + ScaLBL_Comm->sendCount_xz
+				+ ScaLBL_Comm->sendCount_Xy + ScaLBL_Comm->sendCount_Yz + ScaLBL_Comm->sendCount_xZ
+				+ ScaLBL_Comm->sendCount_xY + ScaLBL_Comm->sendCount_yZ + ScaLBL_Comm->sendCount_Xz
+				+ ScaLBL_Comm->sendCount_XY + ScaLBL_Comm->sendCount_YZ + ScaLBL_Comm->sendCount_XZ;
+		struct HaloBenchmark {
+			std::string name;
+			int values;
+			std::function<void()> exchange;
+		};
+		std::vector<HaloBenchmark> halos;
+		halos.push_back( { "Halo_D3Q19", 5*faces + edges, [&](){
+			ScaLBL_Comm->SendD3Q19AA(fq);
+			ScaLBL_Comm->RecvD3Q19AA(fq);
+		} } );
+		halos.push_back( { "Halo_D3Q7", faces, [&](){
+			ScaLBL_Comm->SendD3Q7AA(Aq, 0);
+			ScaLBL_Comm->RecvD3Q7AA(Aq, 0);
+		} } );
+		for (auto &halo : halos){
+			if (!selected(halo.name)) continue;
+			initialize();
+			halo.exchange();
+			comm.barrier();
+			double starttime = Utilities::MPI::time();
+			for (int timestep=0; timestep<timesteps; timestep++)
+				halo.exchange();
+			ScaLBL_DeviceBarrier();
+			double time = comm.maxReduce( Utilities::MPI::time() - starttime );
+			double mlups = double(Nsites)*timesteps/time/1.0e6;
+			// each value is read and written with its list entry when packing and again when unpacking
+			double values = comm.sumReduce( double(halo.values) ) / nprocs;
+			double bandwidth = values*timesteps*2.0*(2.0*8.0 + 4.0)/time;
+			report( halo.name, time, mlups, bandwidth );
+		}
+		if (OUTPUT) fclose(OUTPUT);
+
+		ScaLBL_FreeDeviceMemory(NeighborList);
+		ScaLBL_FreeDeviceMemory(dvcMap);
+		ScaLBL_FreeDeviceMemory(dvcMapWide);
+		ScaLBL_FreeDeviceMemory(fq);
+		ScaLBL_FreeDeviceMemory(Aq);
+		ScaLBL_FreeDeviceMemory(Bq);
+		ScaLBL_FreeDeviceMemory(Den);
+		ScaLBL_FreeDeviceMemory(Phi);
+		ScaLBL_FreeDeviceMemory(Vel);
+		ScaLBL_FreeDeviceMemory(Pressure);
+		ScaLBL_FreeDeviceMemory(Grad);
+		ScaLBL_FreeDeviceMemory(Aux);
+		ScaLBL_FreeDeviceMemory(Grey);
+		delete [] neighborList;
+		delete [] TmpMap;
+		delete [] TmpMapWide;
+		delete [] PhiHost;
+		delete [] PhiWideHost;
+		delete [] GreyHost;
+		delete [] Zero;
+
+		error = comm.maxReduce(error);
+		if (rank==0 && error==0) printf("All kernels completed \n");
+	}
+	Utilities::shutdown();
+	return error;
+}
@@ -123,7 +123,22 @@ int main(int argc, char **argv)
 		comm.barrier();
 
 		// Run the morphological opening
-		MorphDrain(SignDist, id, Dm, SW, MORPH_RADIUS);
+		if (domain_db->getWithDefault<bool>( "MorphCurve", false )){
+			// Compute the whole drainage curve, then select the target saturation
+			MorphologyCurve Curve;
+			Curve.Drain(Dm, SignDist, MORPH_RADIUS);
+			Curve.Write("morphdrain.csv");
+			for (int k=1;k<nz-1;k++){
+				for (int j=1;j<ny-1;j++){
+					for (int i=1;i<nx-1;i++){
+						if (SignDist(i,j,k) > 0.0) id[k*nx*ny+j*nx+i] = 2;
+					}
+				}
+			}
+			Curve.Apply(id, SW, 1);
+		}
+		else
+			MorphDrain(SignDist, id, Dm, SW, MORPH_RADIUS);
 	
 		// calculate distance to non-wetting fluid
 		if (domain_db->keyExists( "HistoryLabels" )){
@@ -124,7 +124,15 @@ int main(int argc, char **argv)
 		comm.barrier();
 
 		// Run the morphological opening
-		MorphOpen(SignDist, id, Dm, SW, ErodeLabel, OpenLabel);
+		if (domain_db->getWithDefault<bool>( "MorphCurve", false )){
+			// Compute the whole opening curve, then select the target saturation
+			MorphologyCurve Curve;
+			Curve.Open(Dm, SignDist, id, ErodeLabel);
+			Curve.Write("morphopen.csv");
+			Curve.Apply(id, (ErodeLabel == 1) ? 1.0 - SW : SW, OpenLabel);
+		}
+		else
+			MorphOpen(SignDist, id, Dm, SW, ErodeLabel, OpenLabel);
 		
 		// calculate distance to non-wetting fluid
 		if (domain_db->keyExists( "HistoryLabels" )){